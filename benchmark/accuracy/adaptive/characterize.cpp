@@ -14,7 +14,7 @@
 // Usage: characterize [maxDepth=3] [reps=3]
 //   maxDepth  highest elreal depth to sweep (2..maxDepth); ereal sweeps a fixed
 //             limb list {2,4,8,12,16}. Raise for a full characterization run.
-//   reps      timing repeats (median).
+//   reps      timing samples (median), each at least 20 ms of repeated evaluations.
 //
 // This is a MEASUREMENT tool only -- it does not optimize the implementations.
 // Resolves issue #1040.
@@ -26,7 +26,6 @@
 #include <universal/utility/directives.hpp>
 #include <algorithm>
 #include <utility>
-#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
@@ -40,30 +39,21 @@
 #include <universal/number/ereal/ereal.hpp>
 #include <universal/verification/elreal_reference_digits.hpp>  // dyadic, zbcl_to_dyadic, agreed_decimal_digits
 #include <math/constants/reference_constants.hpp>              // s_pi, s_e, s_ln2, s_sqrt2, s_sin_half, ...
+#include <universal/benchmark/benchmark_harness.hpp>
 
 namespace {
 
 	using namespace sw::universal;
 
 	// ------------------------------------------------------------------ timing
-	double median(std::vector<double>& v) {
-		if (v.empty()) return 0.0;
-		std::sort(v.begin(), v.end());
-		const size_t n = v.size();
-		return (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
-	}
-
+	// median nanoseconds per call of f() over `reps` samples of the benchmark harness; each sample
+	// batches calls up to the minimum sample time, so a fast evaluation is not timed at clock resolution
 	template<typename F>
-	double time_ns(F&& f, int reps) {
-		std::vector<double> t;
-		t.reserve(static_cast<size_t>(reps));
-		for (int i = 0; i < reps; ++i) {
-			auto a = std::chrono::steady_clock::now();
-			f();
-			auto b = std::chrono::steady_clock::now();
-			t.push_back(std::chrono::duration<double, std::nano>(b - a).count());
-		}
-		return median(t);
+	double time_ns(const std::string& tag, F&& f, int reps) {
+		benchmark_options options = benchmark_options::from_environment();
+		options.minSamples = options.maxSamples = static_cast<unsigned>(reps);
+		options.timeBudget = 0.0;
+		return 1.0e9 * RunBenchmark(tag, [&](std::size_t) { f(); }, 1, options).secondsPerCall();
 	}
 
 	// ---------------------------------------------------------------- accuracy
@@ -175,7 +165,8 @@ namespace {
 					elreal<FpType> x(c.arg);
 					x.precision(static_cast<std::size_t>(d));
 					volatile double sink = 0.0;
-					double t = time_ns([&] {
+					std::string tag = std::string("elreal<") + host + "> " + c.name + " depth=" + std::to_string(d);
+					double t = time_ns(tag, [&] {
 						elreal<FpType> r = apply(c.op, x);
 						sink = r.template approx<double>(static_cast<std::size_t>(d));  // force materialization to depth d
 					}, reps);
@@ -202,7 +193,8 @@ namespace {
 		for (const auto& c : cases()) {
 			ereal<N> x(c.arg), r;
 			volatile double sink = 0.0;
-			double t = time_ns([&] { r = apply(c.op, x); sink = sink_limb(r); }, reps);
+			std::string tag = "ereal<" + std::to_string(N) + "> " + c.name;
+			double t = time_ns(tag, [&] { r = apply(c.op, x); sink = sink_limb(r); }, reps);
 			(void)sink;
 			int digits = agreed_decimal_digits(ereal_to_dyadic(r), c.ref);
 			emit({ "ereal", "double", c.name, static_cast<long>(N), t, digits });
@@ -225,12 +217,13 @@ namespace {
 				a.precision(static_cast<std::size_t>(d));
 				b.precision(static_cast<std::size_t>(d));
 				volatile double sink = 0.0;
-				auto timeOp = [&](auto fn) {
-					return time_ns([&] { elreal<FpType> r = fn(); sink = r.template approx<double>(static_cast<std::size_t>(d)); }, reps);
+				auto timeOp = [&](const char* op, auto fn) {
+					std::string tag = std::string("elreal<") + host + "> " + op + " depth=" + std::to_string(d);
+					return time_ns(tag, [&] { elreal<FpType> r = fn(); sink = r.template approx<double>(static_cast<std::size_t>(d)); }, reps);
 				};
-				emit({ "elreal", host, "add", d, timeOp([&] { return a + b; }), -1 });
-				emit({ "elreal", host, "mul", d, timeOp([&] { return a * b; }), -1 });
-				emit({ "elreal", host, "div", d, timeOp([&] { return a / b; }), -1 });
+				emit({ "elreal", host, "add", d, timeOp("add", [&] { return a + b; }), -1 });
+				emit({ "elreal", host, "mul", d, timeOp("mul", [&] { return a * b; }), -1 });
+				emit({ "elreal", host, "div", d, timeOp("div", [&] { return a / b; }), -1 });
 				(void)sink;
 			}
 		}
@@ -241,10 +234,12 @@ namespace {
 		const double A = 1.4142135623730951, B = 2.7182818284590452;
 		ereal<N> a(A), b(B), r;
 		volatile double sink = 0.0;
-		auto timeOp = [&](auto fn) { return time_ns([&] { r = fn(); sink = sink_limb(r); }, reps); };
-		emit({ "ereal", "double", "add", static_cast<long>(N), timeOp([&] { return a + b; }), -1 });
-		emit({ "ereal", "double", "mul", static_cast<long>(N), timeOp([&] { return a * b; }), -1 });
-		emit({ "ereal", "double", "div", static_cast<long>(N), timeOp([&] { return a / b; }), -1 });
+		auto timeOp = [&](const char* op, auto fn) {
+			return time_ns("ereal<" + std::to_string(N) + "> " + op, [&] { r = fn(); sink = sink_limb(r); }, reps);
+		};
+		emit({ "ereal", "double", "add", static_cast<long>(N), timeOp("add", [&] { return a + b; }), -1 });
+		emit({ "ereal", "double", "mul", static_cast<long>(N), timeOp("mul", [&] { return a * b; }), -1 });
+		emit({ "ereal", "double", "div", static_cast<long>(N), timeOp("div", [&] { return a / b; }), -1 });
 		(void)sink;
 	}
 
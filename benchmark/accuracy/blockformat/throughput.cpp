@@ -5,17 +5,22 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
-#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdio>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <universal/number/mxfloat/mxfloat.hpp>
 #include <universal/number/nvblock/nvblock.hpp>
+#include <universal/number/microfloat/packed_array.hpp>
 #include <universal/number/zfpblock/zfparray.hpp>
+#include <universal/number/zfpblock/zfparray_stream.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
 
 constexpr size_t NR_OPS = 100000;
 
@@ -23,16 +28,20 @@ constexpr size_t NR_OPS = 100000;
 // timing harness
 // ---------------------------------------------------------------------------
 
-static void report(const std::string& label, size_t ops, double elapsed) {
-	double ops_per_sec = static_cast<double>(ops) / elapsed;
+// sample ops operations of f() through RunBenchmark, and report the median time and rate
+template<typename Workload>
+static void measure(const std::string& label, size_t ops, Workload&& f) {
+	sw::universal::benchmark_result r = sw::universal::RunBenchmark(label, [&](size_t) { f(); }, ops);
+	double elapsed = r.secondsPerCall();
 	const char* scales[] = { " ", "K", "M", "G", "T" };
-	double v = ops_per_sec;
+	double v = r.median;
 	int si = 0;
 	while (v >= 1000.0 && si < 4) { v /= 1000.0; si++; }
 	std::cout << std::left  << std::setw(20) << label
 	          << std::right << std::setw(10) << ops
 	          << std::setw(14) << std::fixed << std::setprecision(6) << elapsed
 	          << std::setw(10) << std::setprecision(0) << v << ' ' << scales[si] << "ops/sec"
+	          << "  +-" << std::setw(4) << std::setprecision(1) << 100.0 * r.relativeMad() << '%'
 	          << '\n';
 }
 
@@ -50,18 +59,13 @@ static void bench_mxblock(const std::string& label) {
 	}
 
 	MXBlockType blk;
-	auto t0 = std::chrono::steady_clock::now();
-	for (size_t i = 0; i < NR_OPS; ++i) {
-		blk.quantize(src);
-		blk.dequantize(dst);
-	}
-	auto t1 = std::chrono::steady_clock::now();
-	double elapsed = std::chrono::duration<double>(t1 - t0).count();
-
-	// prevent optimization
-	if (dst[0] == -999.0f) std::cout << "dummy\n";
-
-	report(label, NR_OPS, elapsed);
+	measure(label, NR_OPS, [&] {
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			blk.quantize(src);
+			blk.dequantize(dst);
+		}
+		sw::universal::DoNotOptimize(dst);
+	});
 }
 
 // ---------------------------------------------------------------------------
@@ -77,17 +81,39 @@ static void bench_nvblock(const std::string& label) {
 	}
 
 	NVBlockType blk;
-	auto t0 = std::chrono::steady_clock::now();
-	for (size_t i = 0; i < NR_OPS; ++i) {
-		blk.quantize(src, 1.0f);
-		blk.dequantize(dst, 1.0f);
-	}
-	auto t1 = std::chrono::steady_clock::now();
-	double elapsed = std::chrono::duration<double>(t1 - t0).count();
+	measure(label, NR_OPS, [&] {
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			blk.quantize(src, 1.0f);
+			blk.dequantize(dst, 1.0f);
+		}
+		sw::universal::DoNotOptimize(dst);
+	});
+}
 
-	if (dst[0] == -999.0f) std::cout << "dummy\n";
+// ---------------------------------------------------------------------------
+// packed microfloat tensors: decode to float of one byte per element through
+// to_float(), against the bulk decode of packed_array; ops are elements
+// ---------------------------------------------------------------------------
 
-	report(label, NR_OPS, elapsed);
+template<typename ElementType>
+static void bench_packed_decode(const std::string& label) {
+	using namespace sw::universal;
+	constexpr size_t N = 1 << 16;
+	std::vector<ElementType> elements(N);
+	for (size_t i = 0; i < N; ++i) elements[i] = ElementType(static_cast<float>(std::sin(0.01 * static_cast<double>(i)) * 4.0));
+	packed_array<ElementType> packed{ std::span<const ElementType>(elements) };
+	std::vector<float> dst(N);
+
+	measure(label + " bytes", N, [&] {
+		for (size_t i = 0; i < N; ++i) dst[i] = elements[i].to_float();
+		sw::universal::DoNotOptimize(dst.data());
+		sw::universal::ClobberMemory();
+	});
+	measure(label + " packed", N, [&] {
+		packed.decode(std::span<float>(dst));
+		sw::universal::DoNotOptimize(dst.data());
+		sw::universal::ClobberMemory();
+	});
 }
 
 // ---------------------------------------------------------------------------
@@ -104,17 +130,80 @@ static void bench_zfp(const std::string& label, double rate) {
 		src[i] = static_cast<float>(std::sin(6.283185 * static_cast<double>(i) / static_cast<double>(N)));
 	}
 
-	auto t0 = std::chrono::steady_clock::now();
-	for (size_t i = 0; i < NR_OPS; ++i) {
-		zfparray1f arr(N, rate, src);
-		arr.decompress(dst);
+	measure(label, NR_OPS, [&] {
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			zfparray1f arr(N, rate, src);
+			arr.decompress(dst);
+		}
+		DoNotOptimize(dst);
+	});
+}
+
+// ---------------------------------------------------------------------------
+// zfp block codec: the constexpr reference codec against the runtime fast
+// codec, encode+decode of a smooth field at a fixed rate; ops are elements
+// ---------------------------------------------------------------------------
+
+template<typename Real, unsigned Dim>
+static void bench_zfp_codec(const std::string& label, double rate) {
+	using namespace sw::universal;
+	constexpr size_t BLOCK_SIZE = zfp_block_size<Dim>::value;
+	constexpr size_t N          = 1 << 16;
+	constexpr size_t NBLOCKS    = N / BLOCK_SIZE;
+	constexpr unsigned maxprec  = zfp_type_traits<Real>::precision_bits;
+	size_t maxbits = static_cast<size_t>(rate * BLOCK_SIZE);
+	size_t bpb     = (maxbits + 7) / 8;
+
+	std::vector<Real> src(N), dst(N);
+	for (size_t i = 0; i < N; ++i) {
+		src[i] = static_cast<Real>(std::sin(0.001 * static_cast<double>(i)) + 0.25 * std::cos(0.03 * static_cast<double>(i)));
 	}
-	auto t1 = std::chrono::steady_clock::now();
-	double elapsed = std::chrono::duration<double>(t1 - t0).count();
+	std::vector<uint8_t> code(NBLOCKS * bpb);
+
+	measure(label + " ref", N, [&] {
+		for (size_t b = 0; b < NBLOCKS; ++b) encode_block<Real, Dim>(src.data() + b * BLOCK_SIZE, code.data() + b * bpb, bpb, maxprec, maxbits);
+		for (size_t b = 0; b < NBLOCKS; ++b) decode_block<Real, Dim>(code.data() + b * bpb, bpb, dst.data() + b * BLOCK_SIZE, maxprec, maxbits);
+		DoNotOptimize(dst.data());
+		ClobberMemory();
+	});
+	measure(label + " fast", N, [&] {
+		encode_blocks_fast<Real, Dim>(src.data(), NBLOCKS, code.data(), bpb, maxprec, maxbits);
+		decode_blocks_fast<Real, Dim>(code.data(), NBLOCKS, bpb, dst.data(), maxprec, maxbits);
+		DoNotOptimize(dst.data());
+		ClobberMemory();
+	});
+}
 
-	if (dst[0] == -999.0f) std::cout << "dummy\n";
+// ---------------------------------------------------------------------------
+// out-of-core zfparray: chunked compression to a file, and sequential sweeps
+// of the mapped file with and without the prefetch thread; ops are elements
+// ---------------------------------------------------------------------------
 
-	report(label, NR_OPS, elapsed);
+static void bench_zfp_stream(double rate) {
+	using namespace sw::universal;
+	constexpr size_t N     = 1 << 20;
+	constexpr size_t CHUNK = 1 << 14;
+	std::string path = (std::filesystem::temp_directory_path() / "throughput_zfp_stream.zfp").string();
+
+	std::vector<float> src(CHUNK);
+	for (size_t i = 0; i < CHUNK; ++i) {
+		src[i] = static_cast<float>(std::sin(6.283185 * static_cast<double>(i) / static_cast<double>(CHUNK)));
+	}
+
+	measure("zfp1f  write file", N, [&] {
+		zfparray_writer<float, 1> out(path, rate);
+		for (size_t done = 0; done < N; done += CHUNK) out.append(src.data(), CHUNK);
+	});
+
+	zfparray_reader<float, 1> in(path);
+	for (unsigned prefetch : { 0u, 2u }) {
+		measure(prefetch == 0 ? "zfp1f  sweep" : "zfp1f  sweep prefetch", N, [&] {
+			double sum = 0.0;
+			for (const auto& block : in.sweep(prefetch)) sum += block.values[0];
+			DoNotOptimize(sum);
+		});
+	}
+	std::remove(path.c_str());
 }
 
 int main(int argc, char** argv)
@@ -126,15 +215,24 @@ try {
 	          << std::right << std::setw(10) << "Ops"
 	          << std::setw(14) << "Time(s)"
 	          << std::setw(16) << "Throughput"
+	          << std::setw(8) << "MAD"
 	          << '\n';
-	std::cout << std::string(60, '-') << '\n';
+	std::cout << std::string(68, '-') << '\n';
 
 	bench_mxblock<mxfp4, 32>("mxfp4  (e2m1,32)");
 	bench_mxblock<mxfp8, 32>("mxfp8  (e4m3,32)");
 	bench_nvblock<nvfp4, 16>("nvfp4  (e2m1,16)");
+	bench_packed_decode<e2m1>("e2m1  ");
+	bench_packed_decode<e3m2>("e3m2  ");
+	bench_packed_decode<e4m3>("e4m3  ");
 	bench_zfp("zfp1f  rate=4",   4.0);
 	bench_zfp("zfp1f  rate=8",   8.0);
 	bench_zfp("zfp1f  rate=16", 16.0);
+	bench_zfp_codec<float, 1>("zfp1f  codec", 16.0);
+	bench_zfp_codec<float, 2>("zfp2f  codec", 16.0);
+	bench_zfp_codec<float, 3>("zfp3f  codec", 16.0);
+	bench_zfp_codec<double, 3>("zfp3d  codec", 32.0);
+	bench_zfp_stream(16.0);
 
 	return EXIT_SUCCESS;
 }
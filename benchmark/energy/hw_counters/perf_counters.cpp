@@ -0,0 +1,151 @@
+// perf_counters.cpp: demonstration of performance counter measurement per number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project.
+//
+// This benchmark reads the performance monitoring unit through Linux perf_event_open
+// while a dot product runs in different number systems, and reports cycles and
+// instructions per operation, IPC, and cache misses per operation.
+//
+// Requirements for the hardware events:
+//   - Linux with perf_event support, on bare metal or a VM that exposes the PMU
+//   - /proc/sys/kernel/perf_event_paranoid <= 2 (the default)
+//
+// Where the PMU is not exposed the software events (task clock, page faults) are
+// reported instead; on non-Linux platforms counters are reported as unavailable.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdint>
+
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/energy/energy.hpp>
+#include <universal/utility/pareto_explorer.hpp>
+
+using namespace sw::universal;
+using namespace sw::universal::energy;
+
+constexpr size_t N = 4096;   // 4096 elements: the operands of the 16-bit types fit in L1
+
+template<typename Real>
+Real dot(const std::vector<Real>& x, const std::vector<Real>& y) {
+    Real sum(0);
+    for (size_t i = 0; i < x.size(); ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+template<typename Real>
+PerfCounts measureDot(size_t repetitions) {
+    std::vector<Real> x(N), y(N);
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = Real(1.0 + 0.001 * static_cast<double>(i % 97));
+        y[i] = Real(1.0 - 0.001 * static_cast<double>(i % 89));
+    }
+    volatile double sink = double(dot(x, y));   // warm up
+    PerfCounterReader counters;
+    counters.start();
+    for (size_t r = 0; r < repetitions; ++r) sink = double(dot(x, y));
+    (void)sink;
+    return counters.stop();
+}
+
+template<typename Real>
+void reportDot(const std::string& label, size_t repetitions) {
+    PerfCounts c = measureDot<Real>(repetitions);
+    double ops = 2.0 * static_cast<double>(N) * static_cast<double>(repetitions);
+    std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(2);
+    if (c.hasHardware()) {
+        std::cout << std::setw(12) << c.cyclesPerOp(static_cast<uint64_t>(ops))
+                  << std::setw(12) << c.instructionsPerOp(static_cast<uint64_t>(ops))
+                  << std::setw(8) << c.ipc()
+                  << std::setw(14) << std::scientific << std::setprecision(2) << c.branch_misses / ops
+                  << std::setw(14) << c.l1d_misses / ops << '\n';
+    }
+    else {
+        std::cout << std::setw(12) << c.task_clock_ns / ops << " ns/op (" << counterSourceName(c.source) << ")\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+void demonstrateAvailability() {
+    std::cout << "========================================\n";
+    std::cout << "Performance Counter Availability\n";
+    std::cout << "========================================\n\n";
+    PerfCounterReader counters;
+    std::cout << counters.systemInfo();
+    if (!PerfCounterReader::hasHardwareCounters()) {
+        std::cout << "\nThe PMU is not readable; possible reasons:\n";
+        std::cout << "  - running in a VM or container that does not expose the PMU\n";
+        std::cout << "  - /proc/sys/kernel/perf_event_paranoid > 2\n";
+        std::cout << "  - not running on Linux\n";
+    }
+}
+
+void demonstrateNumberSystems() {
+    std::cout << "\n========================================\n";
+    std::cout << "Dot Product per Number System (" << N << " elements)\n";
+    std::cout << "========================================\n\n";
+    std::cout << std::left << std::setw(16) << "type" << std::right
+              << std::setw(12) << "cycles/op" << std::setw(12) << "instr/op" << std::setw(8) << "IPC"
+              << std::setw(14) << "br miss/op" << std::setw(14) << "L1D miss/op" << '\n';
+    reportDot<float>("float", 200);
+    reportDot<half>("cfloat<16,5>", 20);
+    reportDot<posit<16, 1>>("posit<16,1>", 20);
+    reportDot<posit<32, 2>>("posit<32,2>", 20);
+    reportDot<lns<16, 8>>("lns<16,8>", 5);
+}
+
+void demonstrateScopedMeasurement() {
+    std::cout << "\n========================================\n";
+    std::cout << "Scoped Counter Measurement (RAII)\n";
+    std::cout << "========================================\n\n";
+    {
+        ScopedPerfCounters measure("posit<16,1> dot x10");
+        measureDot<posit<16, 1>>(10);
+    }  // counts printed on destruction
+}
+
+void demonstrateProfilerIntegration() {
+    std::cout << "\n========================================\n";
+    std::cout << "Algorithm Profiler and Pareto Explorer\n";
+    std::cout << "========================================\n\n";
+
+    std::vector<float> x(N, 1.0f), y(N, 0.5f);
+    volatile float sink = 0.0f;
+    auto profile = AlgorithmProfiler::profileDotProduct(N, "float", 32);
+    AlgorithmProfiler::measureCounters(profile, [&] { sink = dot(x, y); }, 100);
+    std::cout << profile.summary() << "\n";
+
+    std::vector<half> xh(N, half(1.0f)), yh(N, half(0.5f));
+    ParetoExplorer explorer;
+    explorer.measureConfiguration("FP32 (float)", [&] { sink = dot(x, y); }, 2 * N, 100);
+    explorer.measureConfiguration("FP16 (half)", [&] { sink = float(dot(xh, yh)); }, 2 * N, 10);
+    (void)sink;
+    explorer.report(std::cout);
+}
+
+int main()
+try {
+    std::cout << "Universal Numbers Library: Performance Counter Measurement\n";
+    std::cout << "==========================================================\n\n";
+
+    demonstrateAvailability();
+    demonstrateNumberSystems();
+    demonstrateScopedMeasurement();
+    demonstrateProfilerIntegration();
+
+    return EXIT_SUCCESS;
+}
+catch (const char* msg) {
+    std::cerr << "Error: " << msg << std::endl;
+    return EXIT_FAILURE;
+}
+catch (const std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,191 @@
+// fast_arithmetic.cpp : latency of the cfloat fast paths against the blocktriple path
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// Dependent add, multiply and divide chains, once through the cfloat operators, which take the native or
+// integer fast path of fast_arithmetic.hpp, and once through blocktriple arithmetic and convert(), the
+// path the operators take without it (minus their special-value tests, so the ratio is conservative).
+//
+// Measured with gcc -O2 on a single x86-64 core (a VM, so expect 10-20% noise), Mops/sec:
+//                                  add fast  blocktriple    mul fast  blocktriple    div fast  blocktriple
+//   cfloat<8,2,ttf>   integer            70           24           73           16          63         1.84
+//   cfloat<16,5>      integer            55           31           57           14          45         0.90
+//   bfloat16          integer            53           31           60           27          47           10
+//   cfloat<32,8>      native            232           48          287           11         141         0.48
+//   cfloat<32,8,fff>  integer            80           44          144         8.31          67         0.45
+//   cfloat<64,11>     native            202           30          210         1.23         110         0.14
+//   cfloat<64,11,fff> integer            67           22           83         1.20           -            -
+// cfloat<16,5> is native only where the compiler provides _Float16 with hardware conversion (F16C).
+// The native path runs at the speed of the FPU; the integer path removes the blocktriple expansion
+// and the block-wise rounding, which pays off most for multiplication and division.
+#include <universal/utility/directives.hpp>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
+
+namespace sw { namespace universal {
+
+	// the operators without the fast path
+	template<typename Cfloat>
+	Cfloat BlocktripleAdd(const Cfloat& a, const Cfloat& b) {
+		blocktriple<Cfloat::fbits, BlockTripleOperator::ADD, typename Cfloat::BlockType> ta, tb, sum;
+		a.normalizeAddition(ta);
+		b.normalizeAddition(tb);
+		sum.add(ta, tb);
+		Cfloat c;
+		convert(sum, c);
+		return c;
+	}
+	template<typename Cfloat>
+	Cfloat BlocktripleMul(const Cfloat& a, const Cfloat& b) {
+		blocktriple<Cfloat::fbits, BlockTripleOperator::MUL, typename Cfloat::BlockType> ta, tb, product;
+		a.normalizeMultiplication(ta);
+		b.normalizeMultiplication(tb);
+		product.mul(ta, tb);
+		Cfloat c;
+		convert(product, c);
+		return c;
+	}
+	template<typename Cfloat>
+	Cfloat BlocktripleDiv(const Cfloat& a, const Cfloat& b) {
+		blocktriple<Cfloat::fbits, BlockTripleOperator::DIV, typename Cfloat::BlockType> ta, tb, quotient;
+		a.normalizeDivision(ta);
+		b.normalizeDivision(tb);
+		quotient.div(ta, tb);
+		Cfloat c;
+		convert(quotient, c);
+		return c;
+	}
+
+	// a dependent chain of alternating operands whose effects cancel
+	template<typename Cfloat, typename Op>
+	void Chain(std::size_t NR_OPS, double ca, double cb, Op op) {
+		Cfloat x(1.0), a(ca), b(cb);
+		DoNotOptimize(a);
+		DoNotOptimize(b);
+		for (std::size_t i = 0; i < NR_OPS; i += 2) {
+			x = op(x, a); DoNotOptimize(x);
+			x = op(x, b); DoNotOptimize(x);
+		}
+		DoNotOptimize(x);
+	}
+
+	// Mops/sec, with two decimals below 10 Mops/sec
+	std::string Mops(double rate) {
+		std::stringstream s;
+		s << std::fixed << std::setprecision(rate < 10.0e6 ? 2 : 0) << rate / 1.0e6;
+		return s.str();
+	}
+
+	template<typename Cfloat>
+	void CompareFastPath(const std::string& label, std::size_t NR_OPS) {
+		using Fast = cfloat_fast_arithmetic<Cfloat>;
+		benchmark_options options = benchmark_options::from_environment();
+		options.timeBudget = 0.1;
+		auto rate = [&](const std::string& tag, auto&& f) {
+			return RunBenchmark(label + ' ' + tag, f, NR_OPS, options).median;
+		};
+		double addFast = rate("add", [](std::size_t n) { Chain<Cfloat>(n, 0.375, -0.375, [](const Cfloat& x, const Cfloat& y) { return x + y; }); });
+		double addRef  = rate("add blocktriple", [](std::size_t n) { Chain<Cfloat>(n, 0.375, -0.375, BlocktripleAdd<Cfloat>); });
+		double mulFast = rate("mul", [](std::size_t n) { Chain<Cfloat>(n, 1.25, 0.8, [](const Cfloat& x, const Cfloat& y) { return x * y; }); });
+		double mulRef  = rate("mul blocktriple", [](std::size_t n) { Chain<Cfloat>(n, 1.25, 0.8, BlocktripleMul<Cfloat>); });
+		std::cout << std::left << std::setw(18) << label << std::setw(8) << (Fast::native ? "native" : "integer") << std::right
+		          << std::setw(12) << Mops(addFast) << std::setw(13) << Mops(addRef)
+		          << std::setw(12) << Mops(mulFast) << std::setw(13) << Mops(mulRef);
+		if constexpr (Fast::native || Fast::integerDivision) {
+			double divFast = rate("div", [](std::size_t n) { Chain<Cfloat>(n, 1.25, 0.8, [](const Cfloat& x, const Cfloat& y) { return x / y; }); });
+			double divRef  = rate("div blocktriple", [](std::size_t n) { Chain<Cfloat>(n, 1.25, 0.8, BlocktripleDiv<Cfloat>); });
+			std::cout << std::setw(12) << Mops(divFast) << std::setw(13) << Mops(divRef);
+		}
+		else {
+			std::cout << std::setw(12) << '-' << std::setw(13) << '-';
+		}
+		std::cout << '\n';
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat fast path latency";
+	std::string test_tag    = "fast path";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	constexpr std::size_t NR_OPS = 4096;
+	std::cout << std::left << std::setw(26) << "Mops/sec" << std::right
+	          << std::setw(12) << "add fast" << std::setw(13) << "blocktriple"
+	          << std::setw(12) << "mul fast" << std::setw(13) << "blocktriple"
+	          << std::setw(12) << "div fast" << std::setw(13) << "blocktriple" << '\n';
+
+#if MANUAL_TESTING
+
+	CompareFastPath<single>("cfloat<32,8>", NR_OPS);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	CompareFastPath<cfloat<8, 2, std::uint8_t, true, true, false>>("cfloat<8,2,ttf>", NR_OPS);
+	CompareFastPath<half>("cfloat<16,5>", NR_OPS);
+	CompareFastPath<bfloat_t>("bfloat16", NR_OPS);
+	CompareFastPath<single>("cfloat<32,8>", NR_OPS);
+	CompareFastPath<cfloat<32, 8, std::uint32_t, false, false, false>>("cfloat<32,8,fff>", NR_OPS);
+	CompareFastPath<duble>("cfloat<64,11>", NR_OPS);
+	CompareFastPath<cfloat<64, 11, std::uint32_t, false, false, false>>("cfloat<64,11,fff>", NR_OPS);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,169 @@
+// conversion.cpp : throughput of bulk cross-type conversion, per strategy, for the common pairs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// convert_span<Src, Dst> (number/convert/convert_span.hpp) converts arrays with a lookup table
+// when the source has at most 16 bits, with an integer field remap between the IEEE-754 binary
+// layouts, posits and fixed-points of at most 64 bits, and element by element otherwise. Each row converts a 4096-element
+// array repeatedly and reports elements per second; the 'element' row of a pair is the per-value
+// conversion a caller would write by hand, so the ratio between the rows is the gain.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/bfloat16/bfloat16.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/convert/convert_span.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace {
+
+	constexpr std::size_t NR_ELEMENTS = 4096;
+
+	// values spread over a few binades around one, in the source type
+	template<typename Src>
+	const std::vector<Src>& sourceData() {
+		static const std::vector<Src> data = [] {
+			std::mt19937_64 rng(0x5eed);
+			std::uniform_real_distribution<double> dist(-4.0, 4.0);
+			std::vector<Src> v(NR_ELEMENTS);
+			for (auto& x : v) x = Src(dist(rng));
+			return v;
+		}();
+		return data;
+	}
+
+	template<typename Src, typename Dst, sw::universal::conversion_strategy strategy>
+	void ConversionWorkload(std::size_t NR_OPS) {
+		const std::vector<Src>& src = sourceData<Src>();
+		std::vector<Dst> dst(src.size());
+		for (std::size_t i = 0; i < NR_OPS; i += src.size()) {
+			sw::universal::convert_span<Src, Dst, strategy>(std::span<const Src>(src), std::span<Dst>(dst));
+		}
+		if (double(dst[0]) == 1234.5) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// the element-wise row, then the row of the strategy convert_span selects for the pair
+	template<typename Src, typename Dst>
+	void MeasurePair(const std::string& label, std::size_t NR_OPS) {
+		using namespace sw::universal;
+		constexpr conversion_strategy selected = default_conversion_strategy_v<Src, Dst>;
+		PerformanceRunner(label + " element ", ConversionWorkload<Src, Dst, conversion_strategy::element>, NR_OPS);
+		if constexpr (selected == conversion_strategy::table) {
+			conversion_table<Src, Dst>::instance();   // build the table outside the timed region
+			PerformanceRunner(label + " table   ", ConversionWorkload<Src, Dst, conversion_strategy::table>, NR_OPS);
+		}
+		if constexpr (conversion_remap_available_v<Src, Dst>) {
+			PerformanceRunner(label + " remap   ", ConversionWorkload<Src, Dst, conversion_strategy::remap>, NR_OPS);
+		}
+	}
+
+	void TestConversionMatrix(std::size_t NR_OPS) {
+		using namespace sw::universal;
+		using bf16 = cfloat<16, 8, std::uint16_t, true, false, false>;
+		using e5m2 = cfloat<8, 5, std::uint8_t, true, false, false>;
+
+		std::cout << "narrow sources: tabulated\n";
+		MeasurePair<posit<8, 0>,   single>      ("posit<8,0>   -> fp32       ", NR_OPS);
+		MeasurePair<posit<16, 1>,  single>      ("posit<16,1>  -> fp32       ", NR_OPS);
+		MeasurePair<posit<16, 1>,  posit<32, 2>>("posit<16,1>  -> posit<32,2>", NR_OPS);
+		MeasurePair<half,          single>      ("fp16         -> fp32       ", NR_OPS);
+		MeasurePair<bf16,          float>       ("bf16         -> float      ", NR_OPS);
+		MeasurePair<e5m2,          float>       ("fp8 e5m2     -> float      ", NR_OPS);
+		MeasurePair<bfloat16,      float>       ("bfloat16     -> float      ", NR_OPS);
+		MeasurePair<lns<16, 8>,    single>      ("lns<16,8>    -> fp32       ", NR_OPS);
+		MeasurePair<half,          posit<16, 1>>("fp16         -> posit<16,1>", NR_OPS);
+
+		std::cout << "IEEE layouts: field remap\n";
+		MeasurePair<float,         half>        ("float        -> fp16       ", NR_OPS);
+		MeasurePair<float,         bf16>        ("float        -> bf16       ", NR_OPS);
+		MeasurePair<single,        e5m2>        ("fp32         -> fp8 e5m2   ", NR_OPS);
+		MeasurePair<double,        single>      ("double       -> fp32       ", NR_OPS);
+
+		std::cout << "posit and fixpnt words: field remap\n";
+		MeasurePair<posit<32, 2>,  single>      ("posit<32,2>  -> fp32       ", NR_OPS);
+		MeasurePair<posit<64, 2>,  posit<32, 2>>("posit<64,2>  -> posit<32,2>", NR_OPS);
+		MeasurePair<single,        posit<16, 1>>("fp32         -> posit<16,1>", NR_OPS);
+		MeasurePair<fixpnt<32, 16>, single>     ("fixpnt<32,16>-> fp32       ", NR_OPS);
+		MeasurePair<fixpnt<32, 16>, posit<32, 2>>("fixpnt<32,16>-> posit<32,2>", NR_OPS);
+
+		std::cout << "element-wise\n";
+		MeasurePair<duble,         float>       ("fp64         -> float      ", NR_OPS);
+		MeasurePair<fixpnt<64, 32>, posit<32, 2>>("fixpnt<64,32>-> posit<32,2>", NR_OPS);
+	}
+
+} // namespace
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "bulk conversion performance";
+	std::string test_tag    = "conversion";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	MeasurePair<float, half>("float -> fp16 ", 1'000'000);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	TestConversionMatrix(1'000'000);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
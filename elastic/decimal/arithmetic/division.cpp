@@ -89,6 +89,39 @@ namespace sw { namespace universal {
 			return nrOfFailedTests;
 		}
 
+		// multi-limb operands: a = q * b + r with |r| < |b| and r carrying the sign of a
+		inline int VerifyLargeOperandDivision(bool reportTestCases) {
+			int nrOfFailedTests = 0;
+			std::uint32_t state = 0x9E3779B9u;
+			auto operand = [&state](size_t nrDigits, bool negative) {
+				std::string digits(nrDigits, '9');
+				for (size_t i = 1; i < nrDigits; ++i) {
+					state = state * 1664525u + 1013904223u;
+					if (state & 0x80000000u) digits[i] = static_cast<char>('0' + (state >> 8) % 10);
+				}
+				edecimal v;
+				v.parse(digits);
+				v.setsign(negative);
+				return v;
+			};
+			for (size_t lhsDigits : { 10, 19, 100, 450, 1000 }) {
+				for (size_t rhsDigits : { 1, 9, 10, 18, 99, 450 }) {
+					for (int signs = 0; signs < 4; ++signs) {
+						edecimal a = operand(lhsDigits, signs & 1), b = operand(rhsDigits, signs & 2);
+						edecimal q = a / b, r = a % b;
+						edecimal absr(r), absb(b);
+						absr.setpos();
+						absb.setpos();
+						if (q * b + r != a || !(absr < absb) || (!r.iszero() && r.sign() != a.sign())) {
+							++nrOfFailedTests;
+							if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, q, a);
+						}
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 }} // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -150,6 +183,7 @@ try {
 
 #if REGRESSION_LEVEL_1
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalDivision<3>(reportTestCases), "decimal division 2^3 test cases", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeOperandDivision(reportTestCases), "decimal division large operands", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -10,6 +10,7 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/edecimal/edecimal.hpp>
@@ -68,6 +69,36 @@ namespace sw { namespace universal {
 			return nrOfFailedTests;
 		}
 
+		// multi-limb operands: the Karatsuba product must match the schoolbook product limb for limb
+		inline int VerifyLargeOperandMultiplication(bool reportTestCases) {
+			int nrOfFailedTests = 0;
+			std::uint32_t state = 0x2545F491u;
+			auto operand = [&state](size_t nrDigits) {
+				std::string digits(nrDigits, '9');
+				for (size_t i = 1; i < nrDigits; ++i) {
+					state = state * 1664525u + 1013904223u;
+					if (state & 0x80000000u) digits[i] = static_cast<char>('0' + (state >> 8) % 10);
+				}
+				edecimal v;
+				v.parse(digits);
+				return v;
+			};
+			for (size_t lhsDigits : { 300, 361, 1000, 2500 }) {
+				for (size_t rhsDigits : { 9, 360, 361, 999, 2500 }) {
+					edecimal a = operand(lhsDigits), b = operand(rhsDigits);
+					std::vector<edecimal::limb> ref(a.size() + b.size());
+					decimal_limbs::mul_schoolbook(a.data(), a.size(), b.data(), b.size(), ref.data());
+					edecimal c = a * b;
+					c.resize(ref.size(), 0);
+					if (!std::equal(ref.begin(), ref.end(), c.begin())) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: " << lhsDigits << " by " << rhsDigits << " digit product\n";
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 } } // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -130,6 +161,7 @@ try {
 
 #if REGRESSION_LEVEL_1
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalMultiplication<3>(reportTestCases), "decimal multiplication 2^3 test cases", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeOperandMultiplication(reportTestCases), "decimal multiplication large operands", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -9,6 +9,7 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/edecimal/edecimal.hpp>
@@ -86,6 +87,83 @@ namespace sw::universal::internal {
 			std::cout << "-";
 	}
 
+	// an n-digit operand with a fixed pseudo-random digit pattern
+	inline sw::universal::edecimal LargeOperand(size_t nrDigits, unsigned seed) {
+		std::string digits(nrDigits, '0');
+		unsigned state = seed;
+		for (auto& c : digits) {
+			state = state * 1103515245u + 12345u;
+			c = static_cast<char>('0' + (state >> 16) % 10);
+		}
+		digits[0] = '9';
+		sw::universal::edecimal v;
+		v.parse(digits);
+		return v;
+	}
+
+	template<size_t nrDigits>
+	void LargeMultiplicationWorkload(size_t NR_OPS) {
+		using sw::universal::edecimal;
+		edecimal a = LargeOperand(nrDigits, 1), b = LargeOperand(nrDigits, 2), c;
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c = a * b;
+		}
+		if (c.nrDigits() < 2 * nrDigits - 1)
+			std::cout << "-";
+		else
+			std::cout << " ";
+	}
+
+	// 2n-digit by n-digit division
+	template<size_t nrDigits>
+	void LargeDivisionWorkload(size_t NR_OPS) {
+		using sw::universal::edecimal;
+		edecimal a = LargeOperand(2 * nrDigits, 3), b = LargeOperand(nrDigits, 4), c;
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c = a / b;
+		}
+		if (c.nrDigits() < nrDigits)
+			std::cout << "-";
+		else
+			std::cout << " ";
+	}
+
+	// the limb kernels by themselves: schoolbook against the Karatsuba dispatch
+	template<size_t nrDigits, bool karatsuba>
+	void LimbMultiplicationWorkload(size_t NR_OPS) {
+		using sw::universal::edecimal;
+		edecimal a = LargeOperand(nrDigits, 5), b = LargeOperand(nrDigits, 6);
+		std::vector<edecimal::limb> r(a.size() + b.size());
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			if constexpr (karatsuba)
+				decimal_limbs::mul(a.data(), a.size(), b.data(), b.size(), r.data());
+			else
+				decimal_limbs::mul_schoolbook(a.data(), a.size(), b.data(), b.size(), r.data());
+		}
+		if (r.back() == 0 && r[r.size() - 2] == 0)
+			std::cout << "-";
+		else
+			std::cout << " ";
+	}
+
+	void TestLargeOperandPerformance() {
+		using namespace sw::universal;
+		std::cout << "\nLarge operand performance\n";
+
+		PerformanceRunner("edecimal 100 digits   multiplication", LargeMultiplicationWorkload<100>, 64ull * 1024ull);
+		PerformanceRunner("edecimal 1000 digits  multiplication", LargeMultiplicationWorkload<1000>, 2ull * 1024ull);
+		PerformanceRunner("edecimal 10000 digits multiplication", LargeMultiplicationWorkload<10000>, 64ull);
+
+		PerformanceRunner("edecimal 200/100 digits    division ", LargeDivisionWorkload<100>, 64ull * 1024ull);
+		PerformanceRunner("edecimal 2000/1000 digits  division ", LargeDivisionWorkload<1000>, 2ull * 1024ull);
+		PerformanceRunner("edecimal 20000/10000 digits division", LargeDivisionWorkload<10000>, 32ull);
+
+		PerformanceRunner("limbs 1000 digits  schoolbook       ", LimbMultiplicationWorkload<1000, false>, 2ull * 1024ull);
+		PerformanceRunner("limbs 1000 digits  karatsuba        ", LimbMultiplicationWorkload<1000, true>, 2ull * 1024ull);
+		PerformanceRunner("limbs 10000 digits schoolbook       ", LimbMultiplicationWorkload<10000, false>, 64ull);
+		PerformanceRunner("limbs 10000 digits karatsuba        ", LimbMultiplicationWorkload<10000, true>, 64ull);
+	}
+
 	void TestArithmeticOperatorPerformance() {
 	    using namespace sw::universal;
 	    std::cout << "\nArithmetic operator performance\n";
@@ -135,6 +213,7 @@ try {
 #if MANUAL_TESTING
 
 	internal::TestArithmeticOperatorPerformance();
+	internal::TestLargeOperandPerformance();
 
 #else
 
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <random>
 
 // minimum set of include files to reflect source code dependencies
 #define EINTEGER_THROW_ARITHMETIC_EXCEPTION 1
@@ -219,6 +220,46 @@ int RegressionIssue842() {
 	return fails;
 }
 
+// Multi-limb operands of either sign, with limbs biased towards 0 and all-ones so that the
+// divisor is frequently already normalized and the qhat correction runs: verify
+// a = q*b + r with |r| < |b|, r carrying the sign of a, and sign(q) = sign(a) ^ sign(b)
+template<typename BlockType>
+int VerifyMultiLimbDivision(bool reportTestCases) {
+	using namespace sw::universal;
+	using Integer = einteger<BlockType>;
+	int fails = 0;
+	std::mt19937_64 rng(842);
+	auto randomInteger = [&rng](unsigned nrLimbs) {
+		Integer v;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			std::uint64_t w = rng();
+			std::uint32_t limb = ((w & 3) == 0) ? 0xFFFF'FFFFu : ((w & 3) == 1) ? 0u : static_cast<std::uint32_t>(w >> 8);
+			v <<= 32;
+			v += static_cast<long long>(limb);
+		}
+		return v;
+	};
+	for (int i = 0; i < 1000; ++i) {
+		Integer a = randomInteger(1 + static_cast<unsigned>(rng() % 10));
+		Integer b = randomInteger(1 + static_cast<unsigned>(rng() % 5));
+		if (b.iszero()) continue;
+		if (rng() & 1) a = -a;
+		if (rng() & 1) b = -b;
+		Integer q, r;
+		q.reduce(a, b, r);
+		Integer absB(b), absR(r);
+		absB.setsign(false);
+		absR.setsign(false);
+		bool signOk = (q.iszero() ? !q.sign() : (q.sign() == (a.sign() ^ b.sign())))
+		           && (r.iszero() ? !r.sign() : (r.sign() == a.sign()));
+		if (q * b + r != a || !(absR < absB) || !signOk) {
+			++fails;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, q, r);
+		}
+	}
+	return fails;
+}
+
 template<typename BlockType>
 void PrintPowersOfTwo(unsigned exponent = 100) {
 	constexpr size_t COLUMN_WIDTH = 35;
@@ -343,6 +384,9 @@ try {
 	nrOfFailedTestCases += ReportTestResult(RegressionIssue842<uint8_t>(),  "issue 842 (uint8_t)",  test_tag);
 	nrOfFailedTestCases += ReportTestResult(RegressionIssue842<uint16_t>(), "issue 842 (uint16_t)", test_tag);
 	nrOfFailedTestCases += ReportTestResult(RegressionIssue842<uint32_t>(), "issue 842 (uint32_t)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbDivision<uint8_t>(reportTestCases),  "multi-limb signed (uint8_t)",  test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbDivision<uint16_t>(reportTestCases), "multi-limb signed (uint16_t)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbDivision<uint32_t>(reportTestCases), "multi-limb signed (uint32_t)", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticDivision<16, uint8_t>(reportTestCases), "einteger<uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticDivision<16, uint16_t>(reportTestCases), "einteger<uint16_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticDivision<32, uint32_t>(reportTestCases), "einteger<uint32_t>", test_tag);
@@ -51,6 +51,25 @@ namespace sw { namespace universal {
 		return nrOfFailedTests;
 	}
 
+	// subtraction with operands of either sign
+	template<typename BlockType>
+	int VerifySignedSubtraction(bool reportTestCases) {
+		using Integer = einteger<BlockType>;
+		int nrOfFailedTests = 0;
+		for (long long a = -300; a <= 300; a += 7) {
+			for (long long b = -300; b <= 300; b += 11) {
+				Integer ia(a), ib(b), ic, iref(a - b);
+				ic = ia - ib;
+				if (ic != iref) {
+					nrOfFailedTests++;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "-", ia, ib, ic, iref);
+				}
+				if (nrOfFailedTests > 100) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
 } } // namespace sw::univeral
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -132,6 +151,8 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticSubtraction<16, uint16_t>(reportTestCases), "einteger<uint16_t> 2word", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticSubtraction<16, uint32_t>(reportTestCases), "einteger<uint32_t> 1word", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyElasticSubtraction<32, uint32_t>(reportTestCases), "einteger<uint32_t> 2word", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySignedSubtraction<uint8_t>(reportTestCases), "einteger<uint8_t> signed", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySignedSubtraction<uint32_t>(reportTestCases), "einteger<uint32_t> signed", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
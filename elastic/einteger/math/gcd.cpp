@@ -0,0 +1,178 @@
+// gcd.cpp: test suite runner for gcd and lcm on adaptive precision binary integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+//  SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <random>
+#include <numeric>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/einteger/einteger.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// reference: Euclid's algorithm with multi-precision remainders
+	template<typename BlockType>
+	einteger<BlockType> EuclidGcd(einteger<BlockType> a, einteger<BlockType> b) {
+		a.setsign(false);
+		b.setsign(false);
+		while (!b.iszero()) {
+			einteger<BlockType> r = a % b;
+			a = b;
+			b = r;
+		}
+		return a;
+	}
+
+	template<typename BlockType>
+	einteger<BlockType> RandomInteger(std::mt19937_64& rng, unsigned nrBits) {
+		einteger<BlockType> v;
+		for (unsigned i = 0; i < nrBits; i += 32) {
+			v <<= 32;
+			v += static_cast<long long>(rng() & 0xFFFF'FFFFull);
+		}
+		return v;
+	}
+
+	// gcd against native std::gcd on 64-bit operands
+	template<typename BlockType>
+	int VerifyNativeGcd(bool reportTestCases) {
+		using Integer = einteger<BlockType>;
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(0x5eed);
+		for (int i = 0; i < 1000; ++i) {
+			std::uint64_t a = rng() >> (i % 40);
+			std::uint64_t b = rng() >> (i % 23);
+			if (i % 7 == 0) b = 0;
+			Integer ia(a), ib(b), ic, iref(std::gcd(a, b));
+			ic = gcd(ia, ib);
+			if (ic != iref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "gcd", ia, ib, ic, iref);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// Lehmer gcd against Euclid on multi-limb operands that share a known common factor
+	template<typename BlockType>
+	int VerifyMultiLimbGcd(bool reportTestCases, unsigned nrBits, int nrTests) {
+		using Integer = einteger<BlockType>;
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(nrBits);
+		for (int i = 0; i < nrTests; ++i) {
+			Integer g = RandomInteger<BlockType>(rng, nrBits / 2);
+			Integer a = g * RandomInteger<BlockType>(rng, nrBits);
+			Integer b = g * RandomInteger<BlockType>(rng, nrBits - 32 * (i % 3));
+			if (i % 2) a = -a;
+			Integer ic = gcd(a, b);
+			Integer iref = EuclidGcd(a, b);
+			if (ic != iref || !(a % ic).iszero() || !(b % ic).iszero()) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "gcd", a, b, ic, iref);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename BlockType>
+	int VerifyLcm(bool reportTestCases) {
+		using Integer = einteger<BlockType>;
+		int nrOfFailedTests = 0;
+		for (long long a = -60; a <= 60; a += 7) {
+			for (long long b = 0; b <= 90; b += 9) {
+				Integer ia(a), ib(b), ic, iref(std::lcm(a, b));
+				ic = lcm(ia, ib);
+				if (ic != iref) {
+					++nrOfFailedTests;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "lcm", ia, ib, ic, iref);
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "einteger gcd/lcm validation";
+	std::string test_tag    = "gcd";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	{
+		einteger<std::uint32_t> a, b;
+		parse("1234567890123456789012345678901234567890", a);
+		parse("9876543210987654321098765432109876543210", b);
+		std::cout << "gcd(" << a << ", " << b << ") = " << gcd(a, b) << '\n';
+		std::cout << "lcm(" << a << ", " << b << ") = " << lcm(a, b) << '\n';
+	}
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeGcd<std::uint8_t>(reportTestCases), "einteger<uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeGcd<std::uint32_t>(reportTestCases), "einteger<uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbGcd<std::uint32_t>(reportTestCases, 256, 100), "einteger<uint32_t> 256 bits", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLcm<std::uint32_t>(reportTestCases), "einteger<uint32_t>", "lcm");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbGcd<std::uint16_t>(reportTestCases, 256, 100), "einteger<uint16_t> 256 bits", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbGcd<std::uint32_t>(reportTestCases, 1024, 50), "einteger<uint32_t> 1024 bits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbGcd<std::uint8_t>(reportTestCases, 512, 50), "einteger<uint8_t> 512 bits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiLimbGcd<std::uint32_t>(reportTestCases, 4096, 10), "einteger<uint32_t> 4096 bits", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -7,7 +7,7 @@
 #include <universal/utility/directives.hpp>
 #include <iostream>
 #include <string>
-#include <universal/number/erational/erational.hpp>   // TODO: currently just a decimal rational
+#include <universal/number/erational/ebinratio.hpp>
 #include <universal/verification/test_suite.hpp>
 
 /*
@@ -35,7 +35,7 @@ int main()
 try {
 	using namespace sw::universal;
 
-	std::string test_suite  = "erational class API ";
+	std::string test_suite  = "ebinratio class API ";
 	std::string test_tag    = "API";
 	bool reportTestCases    = false;
 	int nrOfFailedTestCases = 0;
@@ -44,7 +44,7 @@ try {
 
 #if MANUAL_TESTING
 
-	using Rational = sw::universal::erational;
+	using Rational = sw::universal::ebinratio<>;
 
 	Rational a, b, c, d;
 	a = -1;
@@ -72,14 +72,17 @@ try {
 	std::cout << a << " * " << b << " = " << d << '\n';
 
 	{
-		edecimal a, b, remainder;
+		einteger<std::uint32_t> a, b;
 		a = 3; b = 9;
-		while (a % b > 0) {
-			remainder = a % b;
-			a = b;
-			b = remainder;
-		}
-		std::cout << "gcd of (3, 9) = " << remainder << '\n';
+		std::cout << "gcd of (3, 9) = " << gcd(a, b) << '\n';
+	}
+
+	{
+		// the Lazy policy defers the gcd until the value is observed
+		using LazyRational = sw::universal::ebinratio<RationalReduction::Lazy>;
+		LazyRational sum(0);
+		for (int k = 1; k <= 10; ++k) sum += LazyRational(1) / LazyRational(k);
+		std::cout << "H(10) = " << sum << " : " << double(sum) << '\n';
 	}
 
 	a = 1;
@@ -0,0 +1,190 @@
+//  arithmetic.cpp : test suite for arithmetic of adaptive precision binary rational numbers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <numeric>
+#include <random>
+#include <universal/number/erational/ebinratio.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// reference fraction in lowest terms with a positive denominator
+	struct NativeFraction {
+		long long n, d;
+		NativeFraction(long long _n, long long _d) : n{ _n }, d{ _d } {
+			if (d < 0) { n = -n; d = -d; }
+			long long g = std::gcd(n, d);
+			if (g > 1) { n /= g; d /= g; }
+		}
+		std::string str() const {
+			std::stringstream s;
+			s << n << '/' << d;
+			return s.str();
+		}
+	};
+
+	template<typename Rational>
+	Rational MakeRational(long long n, long long d) {
+		using Integer = typename Rational::Integer;
+		return Rational(Integer(n), Integer(d));
+	}
+
+	template<typename Rational>
+	int Check(bool reportTestCases, const char* op, const Rational& a, const Rational& b, const Rational& c, const NativeFraction& ref) {
+		std::stringstream s;
+		s << c;
+		if (s.str() == ref.str() && c.top() == typename Rational::Integer(ref.n < 0 ? -ref.n : ref.n)) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << a << ' ' << op << ' ' << b << " = " << c << " reference " << ref.str() << '\n';
+		return 1;
+	}
+
+	// arithmetic and ordering of random small fractions against a native reference
+	template<typename Rational>
+	int VerifyRationalArithmetic(bool reportTestCases, int nrTests) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(0x5eed);
+		for (int i = 0; i < nrTests; ++i) {
+			long long an = static_cast<long long>(rng() % 2001) - 1000, ad = 1 + static_cast<long long>(rng() % 1000);
+			long long cn = static_cast<long long>(rng() % 2001) - 1000, cd = 1 + static_cast<long long>(rng() % 1000);
+			Rational a = MakeRational<Rational>(an, ad), c = MakeRational<Rational>(cn, cd);
+			nrOfFailedTests += Check(reportTestCases, "+", a, c, a + c, NativeFraction(an * cd + cn * ad, ad * cd));
+			nrOfFailedTests += Check(reportTestCases, "-", a, c, a - c, NativeFraction(an * cd - cn * ad, ad * cd));
+			nrOfFailedTests += Check(reportTestCases, "*", a, c, a * c, NativeFraction(an * cn, ad * cd));
+			if (cn != 0) nrOfFailedTests += Check(reportTestCases, "/", a, c, a / c, NativeFraction(an * cd, ad * cn));
+			bool lt = an * cd < cn * ad;
+			bool eq = an * cd == cn * ad;
+			if ((a < c) != lt || (a == c) != eq || (a > c) != (!lt && !eq)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: ordering of " << a << " and " << c << '\n';
+			}
+			if (nrOfFailedTests > 25) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// long accumulations grow the operands well past a single limb: sum_{k=1}^{n} 1/(k(k+1)) = n/(n+1)
+	// and the harmonic numbers, which the Eager and Lazy policies must agree on
+	template<typename Rational>
+	int VerifyTelescopingSum(bool reportTestCases, long long n) {
+		int nrOfFailedTests = 0;
+		Rational sum(0), harmonic(0);
+		for (long long k = 1; k <= n; ++k) {
+			sum += MakeRational<Rational>(1, k * (k + 1));
+			harmonic += MakeRational<Rational>(1, k);
+		}
+		if (sum != MakeRational<Rational>(n, n + 1)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: telescoping sum " << sum << '\n';
+		}
+		using Reference = ebinratio<RationalReduction::Eager, typename Rational::Integer::bt>;
+		Reference reference(0);
+		for (long long k = 1; k <= n; ++k) reference += Reference(1) / Reference(k);
+		if (to_string(harmonic) != to_string(reference)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: harmonic number " << harmonic << " != " << reference << '\n';
+		}
+		// x * (1/x) == 1 and x - x == 0 on the large operands
+		Rational one = harmonic * (Rational(1) / harmonic);
+		Rational zero = harmonic - harmonic;
+		if (!one.isone() || !zero.iszero() || zero.isneg()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: identities " << one << ' ' << zero << '\n';
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "ebinratio arithmetic ";
+	std::string test_tag    = "arithmetic";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using Eager = ebinratio<RationalReduction::Eager>;
+	using Lazy  = ebinratio<RationalReduction::Lazy>;
+
+#if MANUAL_TESTING
+
+	Eager a(Eager::Integer(355), Eager::Integer(113)), b(0.125);
+	std::cout << a << " + " << b << " = " << a + b << " : " << double(a + b) << '\n';
+	std::cout << a << " * " << b << " = " << a * b << " : " << double(a * b) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<Eager>(reportTestCases, 1000), "ebinratio<Eager>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<Lazy>(reportTestCases, 1000), "ebinratio<Lazy>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTelescopingSum<Eager>(reportTestCases, 100), "ebinratio<Eager>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyTelescopingSum<Lazy>(reportTestCases, 100), "ebinratio<Lazy>", "accumulation");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<ebinratio<RationalReduction::Eager, std::uint8_t>>(reportTestCases, 1000), "ebinratio<Eager, uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<ebinratio<RationalReduction::Lazy, std::uint16_t>>(reportTestCases, 1000), "ebinratio<Lazy, uint16_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<Eager>(reportTestCases, 20000), "ebinratio<Eager>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRationalArithmetic<Lazy>(reportTestCases, 20000), "ebinratio<Lazy>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyTelescopingSum<Eager>(reportTestCases, 1000), "ebinratio<Eager>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyTelescopingSum<Lazy>(reportTestCases, 1000), "ebinratio<Lazy>", "accumulation");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_arithmetic_exception& err) {
+	std::cerr << "Uncaught arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_internal_exception& err) {
+	std::cerr << "Uncaught internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,179 @@
+//  ieee754.cpp : test suite for conversions between adaptive precision binary rationals and IEEE-754 floats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <bit>
+#include <universal/number/erational/ebinratio.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// every finite double is a dyadic rational: the round trip must be exact
+	template<typename Rational>
+	int VerifyDoubleRoundTrip(bool reportTestCases, int nrTests) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(754);
+		auto check = [&](double v) {
+			Rational r(v);
+			double w = double(r);
+			if (w != v || (v != 0.0 && std::signbit(w) != std::signbit(v))) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << v << " -> " << r << " -> " << w << '\n';
+			}
+		};
+		check(1.0); check(-0.5); check(0.1); check(std::numeric_limits<double>::max());
+		check(std::numeric_limits<double>::min()); check(std::numeric_limits<double>::denorm_min());
+		for (int i = 0; i < nrTests; ++i) {
+			std::uint64_t bits = rng();
+			double v = std::bit_cast<double>(bits);
+			if (std::isnan(v) || std::isinf(v)) continue;
+			check(v);
+		}
+		return nrOfFailedTests;
+	}
+
+	// p/q rounds like the IEEE-754 division of the exactly representable p and q
+	template<typename Rational>
+	int VerifyCorrectRounding(bool reportTestCases, int nrTests) {
+		using Integer = typename Rational::Integer;
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(1985);
+		for (int i = 0; i < nrTests; ++i) {
+			long long p = static_cast<long long>(rng() >> (11 + rng() % 40)) * ((i & 1) ? -1 : 1);
+			long long q = static_cast<long long>(rng() >> (11 + rng() % 40)) + 1;
+			Rational r{ Integer(p), Integer(q) };
+			double d = double(r);
+			double dref = static_cast<double>(p) / static_cast<double>(q);
+			long long pf = p >> 40, qf = (q >> 40) + 1;
+			Rational rf{ Integer(pf), Integer(qf) };
+			float f = float(rf);
+			float fref = static_cast<float>(pf) / static_cast<float>(qf);
+			if (d != dref || f != fref) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << r << " : " << d << " vs " << dref << " : " << f << " vs " << fref << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// decimal literals are exact: 0.1 is 1/10, not the double nearest to it
+	template<typename Rational>
+	int VerifyParse(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		struct { const char* txt; const char* ratio; } cases[] = {
+			{ "42", "42/1" }, { "-1000", "-1000/1" }, { "22/7", "22/7" }, { "-6/4", "-3/2" }, { "6/-4", "-3/2" },
+			{ "3.14", "157/50" }, { "-0.5", "-1/2" }, { "0.25", "1/4" }, { "0.1", "1/10" },
+			{ "1.5e2", "150/1" }, { "1.5e-1", "3/20" }, { "-0.0", "0/1" }, { "2.5/0.5", "5/1" }
+		};
+		for (auto& c : cases) {
+			Rational r;
+			if (!r.parse(c.txt) || to_string(r) != c.ratio) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: parse(" << c.txt << ") = " << r << " expected " << c.ratio << '\n';
+			}
+		}
+		Rational r;
+		for (const char* bad : { "", "1/0", "abc", "1.2.3", "--1" }) {
+			if (r.parse(bad)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: parse(" << bad << ") accepted as " << r << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "ebinratio ieee754 conversion ";
+	std::string test_tag    = "conversion";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using Eager = ebinratio<RationalReduction::Eager>;
+	using Lazy  = ebinratio<RationalReduction::Lazy>;
+
+#if MANUAL_TESTING
+
+	Eager r(0.1);
+	std::cout << std::setprecision(17) << 0.1 << " = " << r << " -> " << double(r) << '\n';
+	r.parse("0.1");
+	std::cout << "0.1 = " << r << " -> " << double(r) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyParse<Eager>(reportTestCases), "ebinratio<Eager>", "parse");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse<Lazy>(reportTestCases), "ebinratio<Lazy>", "parse");
+	nrOfFailedTestCases += ReportTestResult(VerifyDoubleRoundTrip<Eager>(reportTestCases, 1000), "ebinratio<Eager>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectRounding<Eager>(reportTestCases, 1000), "ebinratio<Eager>", "rounding");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyDoubleRoundTrip<Lazy>(reportTestCases, 1000), "ebinratio<Lazy>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectRounding<Lazy>(reportTestCases, 1000), "ebinratio<Lazy>", "rounding");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyDoubleRoundTrip<Eager>(reportTestCases, 10000), "ebinratio<Eager>", "double round trip");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectRounding<Eager>(reportTestCases, 10000), "ebinratio<Eager>", "rounding");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_arithmetic_exception& err) {
+	std::cerr << "Uncaught arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_internal_exception& err) {
+	std::cerr << "Uncaught internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
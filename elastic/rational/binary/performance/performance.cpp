@@ -0,0 +1,221 @@
+// performance.cpp: exact linear system solves with adaptive precision binary rationals
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <utility>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/erational/erational.hpp>
+#include <universal/number/erational/ebinratio.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+   The workload is the one exact rationals are used for: reference solutions of small dense
+   linear systems. A random n x n system with entries in [-9, 9] is solved exactly, either by
+   Gaussian elimination over the rationals, where every update is a rational multiply-subtract,
+   or by Bareiss' fraction-free elimination, where every update is an exact integer division of
+   a 2x2 determinant by the previous pivot. Both are checked by substituting the solution back.
+ */
+
+namespace sw::universal::internal {
+
+	using IntegerMatrix = std::vector<std::vector<long long>>;
+
+	// augmented matrix [A | b] of a random system; it is nonsingular with overwhelming probability
+	inline IntegerMatrix RandomSystem(unsigned n) {
+		std::mt19937_64 rng(n);
+		IntegerMatrix Ab(n, std::vector<long long>(n + 1));
+		for (auto& row : Ab) {
+			for (auto& e : row) e = static_cast<long long>(rng() % 19) - 9;
+		}
+		return Ab;
+	}
+
+	template<typename Rational>
+	std::vector<std::vector<Rational>> ToRational(const IntegerMatrix& Ab) {
+		std::vector<std::vector<Rational>> M(Ab.size());
+		for (size_t i = 0; i < Ab.size(); ++i) {
+			for (long long e : Ab[i]) M[i].push_back(Rational(e));
+		}
+		return M;
+	}
+
+	// row reduce to upper triangular form over the rationals
+	template<typename Rational>
+	void GaussianElimination(std::vector<std::vector<Rational>>& M) {
+		size_t n = M.size();
+		for (size_t k = 0; k < n; ++k) {
+			size_t p = k;
+			while (p < n && M[p][k].iszero()) ++p;
+			if (p == n) continue;  // singular
+			std::swap(M[p], M[k]);
+			for (size_t i = k + 1; i < n; ++i) {
+				if (M[i][k].iszero()) continue;
+				Rational f = M[i][k] / M[k][k];
+				for (size_t j = k; j <= n; ++j) M[i][j] -= f * M[k][j];
+			}
+		}
+	}
+
+	// Bareiss: every entry stays an integer, M[i][j] = (M[k][k]*M[i][j] - M[i][k]*M[k][j]) / previous pivot
+	template<typename Rational>
+	void FractionFreeElimination(std::vector<std::vector<Rational>>& M) {
+		size_t n = M.size();
+		Rational previous(1);
+		for (size_t k = 0; k < n; ++k) {
+			size_t p = k;
+			while (p < n && M[p][k].iszero()) ++p;
+			if (p == n) continue;  // singular
+			std::swap(M[p], M[k]);
+			for (size_t i = k + 1; i < n; ++i) {
+				for (size_t j = k + 1; j <= n; ++j) {
+					M[i][j] = (M[k][k] * M[i][j] - M[i][k] * M[k][j]) / previous;
+				}
+				M[i][k] = 0;
+			}
+			previous = M[k][k];
+		}
+	}
+
+	template<typename Rational>
+	std::vector<Rational> BackSubstitution(const std::vector<std::vector<Rational>>& U) {
+		size_t n = U.size();
+		std::vector<Rational> x(n);
+		for (size_t i = n; i-- > 0; ) {
+			Rational s = U[i][n];
+			for (size_t j = i + 1; j < n; ++j) s -= U[i][j] * x[j];
+			x[i] = s / U[i][i];
+		}
+		return x;
+	}
+
+	// A x == b, exactly
+	template<typename Rational>
+	bool IsSolution(const IntegerMatrix& Ab, const std::vector<Rational>& x) {
+		size_t n = Ab.size();
+		for (size_t i = 0; i < n; ++i) {
+			Rational s(0);
+			for (size_t j = 0; j < n; ++j) s += Rational(Ab[i][j]) * x[j];
+			if (s != Rational(Ab[i][n])) return false;
+		}
+		return true;
+	}
+
+	// solve a random n x n system, report the time of the elimination and back substitution, and return 1 if the solution is wrong
+	template<typename Rational>
+	int SolveExactly(const std::string& tag, unsigned n, bool fractionFree) {
+		IntegerMatrix Ab = RandomSystem(n);
+		auto M = ToRational<Rational>(Ab);
+		auto begin = std::chrono::steady_clock::now();
+		if (fractionFree) FractionFreeElimination(M); else GaussianElimination(M);
+		std::vector<Rational> x = BackSubstitution(M);
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		bool exact = IsSolution(Ab, x);
+		std::cout << std::setw(40) << tag << std::setw(5) << n << 'x' << std::left << std::setw(5) << n << std::right
+		          << (fractionFree ? " fraction-free " : " gaussian      ")
+		          << std::setw(10) << std::fixed << std::setprecision(3) << elapsed << " sec"
+		          << (exact ? "" : "  FAIL: A*x != b") << '\n' << std::defaultfloat;
+		return exact ? 0 : 1;
+	}
+
+	template<typename Rational>
+	int SolveExactly(const std::string& tag, unsigned n) {
+		return SolveExactly<Rational>(tag, n, false) + SolveExactly<Rational>(tag, n, true);
+	}
+
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 0
+#define REGRESSION_LEVEL_4 0
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::universal::internal;
+
+	std::string test_suite  = "ebinratio exact linear solver performance";
+	std::string test_tag    = "performance";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using Eager = ebinratio<RationalReduction::Eager>;
+	using Lazy  = ebinratio<RationalReduction::Lazy>;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += SolveExactly<erational>("erational (decimal)", 20);
+	nrOfFailedTestCases += SolveExactly<Eager>("ebinratio<Eager>", 100);
+	nrOfFailedTestCases += SolveExactly<Lazy>("ebinratio<Lazy>", 100);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += SolveExactly<erational>("erational (decimal)", 10);
+	nrOfFailedTestCases += SolveExactly<Eager>("ebinratio<Eager>", 20);
+	nrOfFailedTestCases += SolveExactly<Lazy>("ebinratio<Lazy>", 20);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += SolveExactly<Eager>("ebinratio<Eager>", 40);
+	nrOfFailedTestCases += SolveExactly<Lazy>("ebinratio<Lazy>", 40);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += SolveExactly<erational>("erational (decimal)", 20);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += SolveExactly<Eager>("ebinratio<Eager>", 100);
+	nrOfFailedTestCases += SolveExactly<Lazy>("ebinratio<Lazy>", 100);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_arithmetic_exception& err) {
+	std::cerr << "Uncaught arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::erational_internal_exception& err) {
+	std::cerr << "Uncaught internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,528 @@
+#pragma once
+//  benchmark_harness.hpp : repeated, calibrated measurement of a workload with robust statistics
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// A single timed run of a workload says little: the first call pays for page faults, cold caches
+// and frequency ramp-up, and the next run can differ by tens of percent. RunBenchmark() measures a
+// workload f(NR_OPS) the way the numbers in a commit message deserve:
+//
+//   - one warmup call, which also calibrates how many calls make up a sample of at least
+//     minSampleTime, so that short workloads are not measured at the resolution of the clock
+//   - as many samples as fit the time budget, between minSamples and maxSamples
+//   - the median rate, its median absolute deviation, and a distribution-free 95% confidence
+//     interval of the median taken from the order statistics of the samples
+//   - optionally pinned to one cpu, so the scheduler does not migrate the measurement
+//
+// DoNotOptimize(value) and ClobberMemory() keep the compiler from discarding or hoisting work.
+//
+// Every measurement is recorded in benchmark_report, which writes the results of the process at
+// exit when UNIVERSAL_BENCHMARK_OUTPUT names a file: a .csv or .jsonl file is appended to, any
+// other name receives a JSON document. CompareBenchmarkResults() reads two such files and flags
+// the measurements whose confidence intervals separate by more than a threshold; tools/cmd/benchcmp
+// is its command line.
+//
+// Environment overrides of the default benchmark_options:
+//   UNIVERSAL_BENCHMARK_SAMPLES   number of samples, fixes minSamples and maxSamples
+//   UNIVERSAL_BENCHMARK_BUDGET    time budget of one measurement, in seconds
+//   UNIVERSAL_BENCHMARK_CPU       cpu to pin the measuring thread to (Linux)
+//   UNIVERSAL_BENCHMARK_COUNTERS  1 to read the performance counters over the samples (Linux),
+//                                 which adds cycles, instructions and misses per op to the results
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <universal/energy/hw_counters/perf_counters.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sw { namespace universal {
+
+	////////////////////////////////////////////////////////////////////
+	// optimization barriers
+
+	// the value is assumed to be read, so the computation that produced it cannot be removed
+	template<typename T>
+	inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+			asm volatile("" : : "r,m"(value) : "memory");
+		}
+		else {
+			asm volatile("" : : "m"(value) : "memory");
+		}
+#else
+		const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+		(void)*sink;
+		_ReadWriteBarrier();
+#endif
+	}
+
+	// the variable is also assumed to be modified, so its value cannot be propagated past the barrier
+	template<typename T>
+	inline void DoNotOptimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		// a single in-out constraint: gcc mishandles multi-alternative ones such as "+m,r"
+		if constexpr ((std::is_arithmetic_v<T> || std::is_pointer_v<T>) && sizeof(T) <= sizeof(void*)) {
+			asm volatile("" : "+r"(value) : : "memory");
+		}
+		else {
+			asm volatile("" : "+m"(value) : : "memory");
+		}
+#else
+		volatile char* sink = reinterpret_cast<volatile char*>(&value);
+		(void)*sink;
+		_ReadWriteBarrier();
+#endif
+	}
+
+	// all memory is assumed to be read and written, so stores cannot be sunk out of the timed region
+	inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#else
+		_ReadWriteBarrier();
+#endif
+	}
+
+	////////////////////////////////////////////////////////////////////
+	// measurement policy and results
+
+	struct benchmark_options {
+		unsigned warmupCalls   = 1;
+		unsigned minSamples    = 3;
+		unsigned maxSamples    = 31;
+		double   minSampleTime = 0.020;  // seconds
+		double   timeBudget    = 0.250;  // seconds of sampling per measurement, after the warmup
+		int      cpu           = -1;     // pin the measuring thread to this cpu; -1 leaves it to the scheduler
+		bool     counters      = false;  // read the performance counters over the samples
+
+		static benchmark_options from_environment() {
+			benchmark_options options;
+			if (const char* s = std::getenv("UNIVERSAL_BENCHMARK_SAMPLES")) {
+				unsigned n = static_cast<unsigned>(std::strtoul(s, nullptr, 10));
+				if (n > 0) options.minSamples = options.maxSamples = n;
+			}
+			if (const char* s = std::getenv("UNIVERSAL_BENCHMARK_BUDGET")) {
+				double budget = std::strtod(s, nullptr);
+				if (budget > 0.0) options.timeBudget = budget;
+			}
+			if (const char* s = std::getenv("UNIVERSAL_BENCHMARK_CPU")) {
+				options.cpu = std::atoi(s);
+			}
+			if (const char* s = std::getenv("UNIVERSAL_BENCHMARK_COUNTERS")) {
+				options.counters = (std::atoi(s) != 0);
+			}
+			return options;
+		}
+	};
+
+	struct benchmark_result {
+		std::string suite;            // program that ran the measurement
+		std::string tag;
+		std::size_t opsPerCall  = 0;  // NR_OPS of the workload
+		std::size_t callsPerSample = 0;
+		std::size_t samples     = 0;
+		double      median      = 0.0;  // ops/sec
+		double      mad         = 0.0;  // ops/sec, scaled to estimate a standard deviation
+		double      ciLow       = 0.0;  // 95% confidence interval of the median, ops/sec
+		double      ciHigh      = 0.0;
+		double      minimum     = 0.0;
+		double      maximum     = 0.0;
+		bool        pinned      = false;
+		// performance counters over all samples, per op; empty source when not measured
+		std::string counterSource;
+		double      cyclesPerOp       = 0.0;
+		double      instructionsPerOp = 0.0;
+		double      branchMissesPerOp = 0.0;
+		double      l1dMissesPerOp    = 0.0;
+		double      llcMissesPerOp    = 0.0;
+
+		// instructions per cycle, 0 without hardware counts
+		double ipc() const { return cyclesPerOp > 0.0 ? instructionsPerOp / cyclesPerOp : 0.0; }
+		// seconds per call of the workload at the median rate
+		double secondsPerCall() const { return median > 0.0 ? double(opsPerCall) / median : 0.0; }
+		// relative dispersion
+		double relativeMad() const { return median > 0.0 ? mad / median : 0.0; }
+		std::string key() const { return suite + '/' + tag; }
+	};
+
+	namespace benchmark_detail {
+
+		inline double median_of(std::vector<double> v) {
+			if (v.empty()) return 0.0;
+			std::sort(v.begin(), v.end());
+			std::size_t n = v.size();
+			return (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+		}
+
+		// median, MAD and order-statistic confidence interval of a set of rates
+		inline void summarize(std::vector<double> rates, benchmark_result& r) {
+			std::sort(rates.begin(), rates.end());
+			const std::size_t n = rates.size();
+			r.samples = n;
+			if (n == 0) return;
+			r.median  = median_of(rates);
+			r.minimum = rates.front();
+			r.maximum = rates.back();
+			std::vector<double> deviations(n);
+			for (std::size_t i = 0; i < n; ++i) deviations[i] = std::fabs(rates[i] - r.median);
+			r.mad = 1.4826 * median_of(deviations);
+			// the ranks n/2 -+ 1.96 sqrt(n)/2 bracket the median with 95% probability (binomial approximation)
+			double halfWidth = 0.98 * std::sqrt(double(n));
+			long lo = static_cast<long>(std::floor(0.5 * double(n) - halfWidth));
+			long hi = static_cast<long>(std::ceil(0.5 * double(n) + halfWidth));
+			r.ciLow  = rates[static_cast<std::size_t>(std::clamp(lo, 0l, long(n) - 1))];
+			r.ciHigh = rates[static_cast<std::size_t>(std::clamp(hi, 0l, long(n) - 1))];
+		}
+
+		inline bool pin_to_cpu(int cpu) {
+#if defined(__linux__)
+			if (cpu < 0) return false;
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+			(void)cpu;
+			return false;
+#endif
+		}
+
+		inline std::string program_name() {
+#if defined(__linux__)
+			std::error_code ec;
+			std::filesystem::path exe = std::filesystem::read_symlink("/proc/self/exe", ec);
+			if (!ec && !exe.filename().empty()) return exe.filename().string();
+#endif
+			return "benchmark";
+		}
+
+		inline std::string csv_field(const std::string& s) {
+			if (s.find_first_of(",\"") == std::string::npos) return s;
+			std::string quoted = "\"";
+			for (char c : s) { if (c == '"') quoted += '"'; quoted += c; }
+			return quoted + '"';
+		}
+
+		inline std::string json_string(const std::string& s) {
+			std::string quoted = "\"";
+			for (char c : s) {
+				if (c == '"' || c == '\\') quoted += '\\';
+				quoted += c;
+			}
+			return quoted + '"';
+		}
+
+	} // namespace benchmark_detail
+
+	////////////////////////////////////////////////////////////////////
+	// benchmark_report: the measurements of this process, written at exit
+
+	class benchmark_report {
+	public:
+		static benchmark_report& instance() {
+			static benchmark_report report;
+			return report;
+		}
+		benchmark_report(const benchmark_report&) = delete;
+		benchmark_report& operator=(const benchmark_report&) = delete;
+		~benchmark_report() {
+			if (!_output.empty() && !_results.empty()) write(_output);
+		}
+
+		const std::string& suite() const noexcept { return _suite; }
+		void suite(const std::string& name) { _suite = name; }
+		// an empty path disables the output at exit
+		void output(const std::string& path) { _output = path; }
+
+		void record(const benchmark_result& r) { _results.push_back(r); }
+		const std::vector<benchmark_result>& results() const noexcept { return _results; }
+
+		// .csv and .jsonl files are appended to, so several programs can share one file
+		void write(const std::string& path) const {
+			auto endsWith = [&](const char* ext) { std::string e(ext); return path.size() >= e.size() && path.compare(path.size() - e.size(), e.size(), e) == 0; };
+			if (endsWith(".csv")) {
+				bool fresh = !std::ifstream(path).good() || std::ifstream(path, std::ios::ate).tellg() == 0;
+				std::ofstream out(path, std::ios::app);
+				if (fresh) out << "suite,tag,ops_per_call,calls_per_sample,samples,median,mad,ci_low,ci_high,min,max,pinned,"
+				                  "counter_source,cycles_per_op,instructions_per_op,branch_misses_per_op,l1d_misses_per_op,llc_misses_per_op\n";
+				for (const auto& r : _results) write_csv(out, r);
+			}
+			else if (endsWith(".jsonl")) {
+				std::ofstream out(path, std::ios::app);
+				for (const auto& r : _results) { write_json(out, r); out << '\n'; }
+			}
+			else {
+				std::ofstream out(path);
+				out << "{\n  \"benchmarks\": [\n";
+				for (std::size_t i = 0; i < _results.size(); ++i) {
+					out << "    ";
+					write_json(out, _results[i]);
+					out << (i + 1 < _results.size() ? ",\n" : "\n");
+				}
+				out << "  ]\n}\n";
+			}
+		}
+
+		static void write_csv(std::ostream& out, const benchmark_result& r) {
+			out << std::setprecision(9)
+				<< benchmark_detail::csv_field(r.suite) << ',' << benchmark_detail::csv_field(r.tag) << ',' << r.opsPerCall << ',' << r.callsPerSample << ','
+				<< r.samples << ',' << r.median << ',' << r.mad << ',' << r.ciLow << ',' << r.ciHigh << ','
+				<< r.minimum << ',' << r.maximum << ',' << (r.pinned ? 1 : 0) << ','
+				<< r.counterSource << ',' << r.cyclesPerOp << ',' << r.instructionsPerOp << ',' << r.branchMissesPerOp << ','
+				<< r.l1dMissesPerOp << ',' << r.llcMissesPerOp << '\n';
+		}
+
+		static void write_json(std::ostream& out, const benchmark_result& r) {
+			out << std::setprecision(9)
+				<< "{\"suite\": " << benchmark_detail::json_string(r.suite) << ", \"tag\": " << benchmark_detail::json_string(r.tag)
+				<< ", \"ops_per_call\": " << r.opsPerCall << ", \"calls_per_sample\": " << r.callsPerSample << ", \"samples\": " << r.samples
+				<< ", \"median\": " << r.median << ", \"mad\": " << r.mad << ", \"ci_low\": " << r.ciLow << ", \"ci_high\": " << r.ciHigh
+				<< ", \"min\": " << r.minimum << ", \"max\": " << r.maximum << ", \"pinned\": " << (r.pinned ? "true" : "false");
+			if (!r.counterSource.empty()) {
+				out << ", \"counter_source\": " << benchmark_detail::json_string(r.counterSource)
+					<< ", \"cycles_per_op\": " << r.cyclesPerOp << ", \"instructions_per_op\": " << r.instructionsPerOp
+					<< ", \"branch_misses_per_op\": " << r.branchMissesPerOp << ", \"l1d_misses_per_op\": " << r.l1dMissesPerOp
+					<< ", \"llc_misses_per_op\": " << r.llcMissesPerOp;
+			}
+			out << '}';
+		}
+
+	private:
+		benchmark_report() : _suite(benchmark_detail::program_name()) {
+			if (const char* path = std::getenv("UNIVERSAL_BENCHMARK_OUTPUT")) _output = path;
+		}
+
+		std::string                   _suite;
+		std::string                   _output;
+		std::vector<benchmark_result> _results;
+	};
+
+	////////////////////////////////////////////////////////////////////
+	// RunBenchmark: calibrate, warm up, sample and summarize f(NR_OPS)
+
+	template<typename Workload>
+	benchmark_result RunBenchmark(const std::string& tag, Workload&& f, std::size_t NR_OPS, const benchmark_options& options = benchmark_options::from_environment()) {
+		using clock = std::chrono::steady_clock;
+		benchmark_result r;
+		r.suite = benchmark_report::instance().suite();
+		std::size_t first = tag.find_first_not_of(' '), last = tag.find_last_not_of(' ');
+		r.tag = (first == std::string::npos) ? std::string() : tag.substr(first, last - first + 1);
+		r.opsPerCall = NR_OPS;
+		r.pinned = benchmark_detail::pin_to_cpu(options.cpu);
+
+		// warmup, and the cost of one call
+		double callTime = 0.0;
+		for (unsigned i = 0; i < std::max(options.warmupCalls, 1u); ++i) {
+			clock::time_point begin = clock::now();
+			f(NR_OPS);
+			ClobberMemory();
+			callTime = std::chrono::duration<double>(clock::now() - begin).count();
+		}
+		callTime = std::max(callTime, 1.0e-9);
+		std::size_t callsPerSample = static_cast<std::size_t>(std::ceil(options.minSampleTime / callTime));
+		callsPerSample = std::clamp<std::size_t>(callsPerSample, 1, 1'000'000);
+		std::size_t nrSamples = static_cast<std::size_t>(options.timeBudget / (callTime * double(callsPerSample)));
+		nrSamples = std::clamp<std::size_t>(nrSamples, options.minSamples, std::max(options.minSamples, options.maxSamples));
+		r.callsPerSample = callsPerSample;
+
+		std::vector<double> rates;
+		rates.reserve(nrSamples);
+		// the reader opens its perf events on construction, so only build it when it is asked for
+		std::optional<energy::PerfCounterReader> counters;
+		if (options.counters) counters.emplace().start();
+		for (std::size_t s = 0; s < nrSamples; ++s) {
+			clock::time_point begin = clock::now();
+			for (std::size_t c = 0; c < callsPerSample; ++c) f(NR_OPS);
+			ClobberMemory();
+			double elapsed = std::max(std::chrono::duration<double>(clock::now() - begin).count(), 1.0e-9);
+			rates.push_back(double(NR_OPS) * double(callsPerSample) / elapsed);
+		}
+		if (options.counters) {
+			energy::PerfCounts counts = counters->stop();
+			if (counts.valid) {
+				double ops = double(NR_OPS) * double(callsPerSample) * double(nrSamples);
+				r.counterSource     = energy::counterSourceName(counts.source);
+				r.cyclesPerOp       = counts.cycles / ops;
+				r.instructionsPerOp = counts.instructions / ops;
+				r.branchMissesPerOp = counts.branch_misses / ops;
+				r.l1dMissesPerOp    = counts.l1d_misses / ops;
+				r.llcMissesPerOp    = counts.llc_misses / ops;
+			}
+		}
+		benchmark_detail::summarize(std::move(rates), r);
+		benchmark_report::instance().record(r);
+		return r;
+	}
+
+	////////////////////////////////////////////////////////////////////
+	// comparing two result files
+
+	struct benchmark_delta {
+		enum class verdict { same, improvement, regression, missing };
+		std::string key;
+		double      baseline = 0.0;  // median ops/sec
+		double      current  = 0.0;
+		verdict     outcome  = verdict::same;
+		double ratio() const { return baseline > 0.0 ? current / baseline : 0.0; }
+	};
+
+	// read the results written by benchmark_report, in any of its formats; unreadable files yield nothing
+	inline std::vector<benchmark_result> ReadBenchmarkResults(const std::string& path) {
+		std::vector<benchmark_result> results;
+		std::ifstream in(path);
+		if (!in) return results;
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		const std::string text = buffer.str();
+
+		if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0) {
+			std::istringstream lines(text);
+			std::string line;
+			std::getline(lines, line);  // header
+			while (std::getline(lines, line)) {
+				std::vector<std::string> fields;
+				std::string field;
+				bool quoted = false;
+				for (std::size_t i = 0; i < line.size(); ++i) {
+					char c = line[i];
+					if (quoted) {
+						if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') { field += '"'; ++i; }
+						else if (c == '"') quoted = false;
+						else field += c;
+					}
+					else if (c == '"') quoted = true;
+					else if (c == ',') { fields.push_back(field); field.clear(); }
+					else field += c;
+				}
+				fields.push_back(field);
+				if (fields.size() < 12) continue;
+				benchmark_result r;
+				r.suite = fields[0];
+				r.tag = fields[1];
+				r.opsPerCall = std::stoull(fields[2]);
+				r.callsPerSample = std::stoull(fields[3]);
+				r.samples = std::stoull(fields[4]);
+				r.median = std::stod(fields[5]);
+				r.mad = std::stod(fields[6]);
+				r.ciLow = std::stod(fields[7]);
+				r.ciHigh = std::stod(fields[8]);
+				r.minimum = std::stod(fields[9]);
+				r.maximum = std::stod(fields[10]);
+				r.pinned = (fields[11] == "1");
+				if (fields.size() >= 18) {
+					r.counterSource = fields[12];
+					r.cyclesPerOp = std::stod(fields[13]);
+					r.instructionsPerOp = std::stod(fields[14]);
+					r.branchMissesPerOp = std::stod(fields[15]);
+					r.l1dMissesPerOp = std::stod(fields[16]);
+					r.llcMissesPerOp = std::stod(fields[17]);
+				}
+				results.push_back(r);
+			}
+			return results;
+		}
+
+		// JSON and JSON lines: every object that starts with "suite" is one result
+		auto stringField = [&](std::size_t from, std::size_t to, const std::string& name) {
+			std::size_t p = text.find("\"" + name + "\": \"", from);
+			if (p == std::string::npos || p > to) return std::string();
+			p += name.size() + 5;
+			std::string value;
+			for (; p < to && text[p] != '"'; ++p) {
+				if (text[p] == '\\' && p + 1 < to) ++p;
+				value += text[p];
+			}
+			return value;
+		};
+		auto numberField = [&](std::size_t from, std::size_t to, const std::string& name) {
+			std::size_t p = text.find("\"" + name + "\": ", from);
+			if (p == std::string::npos || p > to) return 0.0;
+			return std::strtod(text.c_str() + p + name.size() + 4, nullptr);
+		};
+		for (std::size_t begin = text.find("{\"suite\""); begin != std::string::npos; begin = text.find("{\"suite\"", begin + 1)) {
+			std::size_t end = text.find('}', begin);
+			if (end == std::string::npos) break;
+			benchmark_result r;
+			r.suite = stringField(begin, end, "suite");
+			r.tag = stringField(begin, end, "tag");
+			r.opsPerCall = static_cast<std::size_t>(numberField(begin, end, "ops_per_call"));
+			r.callsPerSample = static_cast<std::size_t>(numberField(begin, end, "calls_per_sample"));
+			r.samples = static_cast<std::size_t>(numberField(begin, end, "samples"));
+			r.median = numberField(begin, end, "median");
+			r.mad = numberField(begin, end, "mad");
+			r.ciLow = numberField(begin, end, "ci_low");
+			r.ciHigh = numberField(begin, end, "ci_high");
+			r.minimum = numberField(begin, end, "min");
+			r.maximum = numberField(begin, end, "max");
+			r.pinned = text.find("\"pinned\": true", begin) < end;
+			r.counterSource = stringField(begin, end, "counter_source");
+			r.cyclesPerOp = numberField(begin, end, "cycles_per_op");
+			r.instructionsPerOp = numberField(begin, end, "instructions_per_op");
+			r.branchMissesPerOp = numberField(begin, end, "branch_misses_per_op");
+			r.l1dMissesPerOp = numberField(begin, end, "l1d_misses_per_op");
+			r.llcMissesPerOp = numberField(begin, end, "llc_misses_per_op");
+			results.push_back(r);
+		}
+		return results;
+	}
+
+	// a measurement regressed when its confidence interval lies entirely below the baseline's and its
+	// median dropped by more than the threshold; an improvement is the mirror image. When a key was
+	// measured more than once in a file, the last measurement counts.
+	inline std::vector<benchmark_delta> CompareBenchmarkResults(const std::vector<benchmark_result>& baseline, const std::vector<benchmark_result>& current, double threshold = 0.05) {
+		std::map<std::string, benchmark_result> before, after;
+		for (const auto& r : baseline) before[r.key()] = r;
+		for (const auto& r : current) after[r.key()] = r;
+		std::vector<benchmark_delta> deltas;
+		for (const auto& [key, b] : before) {
+			benchmark_delta d;
+			d.key = key;
+			d.baseline = b.median;
+			auto it = after.find(key);
+			if (it == after.end()) {
+				d.outcome = benchmark_delta::verdict::missing;
+				deltas.push_back(d);
+				continue;
+			}
+			const benchmark_result& c = it->second;
+			d.current = c.median;
+			if (c.ciHigh < b.ciLow && c.median < b.median * (1.0 - threshold)) d.outcome = benchmark_delta::verdict::regression;
+			else if (c.ciLow > b.ciHigh && c.median > b.median * (1.0 + threshold)) d.outcome = benchmark_delta::verdict::improvement;
+			deltas.push_back(d);
+		}
+		return deltas;
+	}
+
+	inline const char* to_string(benchmark_delta::verdict v) {
+		switch (v) {
+		case benchmark_delta::verdict::same:        return "same";
+		case benchmark_delta::verdict::improvement: return "improvement";
+		case benchmark_delta::verdict::regression:  return "REGRESSION";
+		case benchmark_delta::verdict::missing:     return "missing";
+		}
+		return "unknown";
+	}
+
+}} // namespace sw::universal
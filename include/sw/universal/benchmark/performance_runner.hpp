@@ -5,13 +5,16 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// PerformanceRunner measures a workload through RunBenchmark (benchmark_harness.hpp): a warmup call,
+// calibrated samples, and the median rate with its dispersion. The results of a program are written
+// to UNIVERSAL_BENCHMARK_OUTPUT at exit, and tools/cmd/benchcmp compares two such files.
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <string>
-#include <sstream>
 #include <vector>
-#include <chrono>
+#include <universal/benchmark/benchmark_harness.hpp>
 
 namespace sw { namespace universal {
 
@@ -24,7 +27,8 @@ namespace sw { namespace universal {
 			a.setbits(i);
 			if (a.sign()) ++positives; else ++negatives;
 		}
-		if (positives == negatives) std::cout << "positives and negatives are identical (unlikely event to select)\n";
+		DoNotOptimize(positives);
+		DoNotOptimize(negatives);
 	}
 
 	// Generic workload for testing shift operations on a given number system type that supports operator>> and operator<<
@@ -36,6 +40,7 @@ namespace sw { namespace universal {
 			a >>= 13;
 			a <<= 37;
 		}
+		DoNotOptimize(a);
 	}
 
 	// Generic set of adds and subtracts for a given number system type
@@ -47,9 +52,7 @@ namespace sw { namespace universal {
 			a = data[i % 2];
 			b = b + a;
 		}
-		if (b == Scalar(0.0f)) {
-			std::cout << "dummy case to fool the optimizer\n";
-		}
+		DoNotOptimize(b);
 	}
 
 	// Generic set of multiplies for a given number system type
@@ -61,15 +64,7 @@ namespace sw { namespace universal {
 			a = data[i % 2];
 			b = b * a;
 		}
-		if (b == Scalar(-1.0f)) {
-			a = 0, b = 1.0625f;
-			for (size_t i = 1; i < 10; ++i) {
-				a = data[i % 2];
-				std::cout << a << " : " << b << '\n';
-				b = b * a;
-			}
-			std::cout << "dummy case to fool the optimizer\n";
-		}
+		DoNotOptimize(b);
 	}
 
 	// Generic set of divides for a given number system type
@@ -82,9 +77,7 @@ namespace sw { namespace universal {
 			a = data[i % 2];
 			b = b / a;
 		}
-		if (b == Scalar(-1.0f)) {
-			std::cout << "dummy case to fool the optimizer\n";
-		}
+		DoNotOptimize(b);
 	}
 
 	// Generic set of remainder calculations for a given number system type that supports the % operator
@@ -94,7 +87,9 @@ namespace sw { namespace universal {
 		d.setbits(0xFFFF'FFFF'FFFF'FFFFull);
 		a = b = c = d;
 		for (size_t i = 0; i < NR_OPS; ++i) {
+			DoNotOptimize(a);  // the operands are loop invariant: keep the remainder inside the loop
 			c = a % b;
+			DoNotOptimize(c);
 			c.clear(); // reset to zero so d = c is fast
 			d = c;
 		}
@@ -108,7 +103,7 @@ namespace sw { namespace universal {
 		Ty scale_factor = 1.0;
 		int integer_value = 0;
 		size_t scale = 0;
-		for (size_t i = 0; i < sizeof(scales); ++i) {
+		for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); ++i) {
 			if (value > lower_bound && value < 1000 * lower_bound) {
 				integer_value = static_cast<int>(value / scale_factor);
 				scale = i;
@@ -122,18 +117,16 @@ namespace sw { namespace universal {
 		return ss.str();
 	}
 
-	// generic test runner, takes a function that enumerates an operator NR_OPS time, and measures elapsed time
-	void PerformanceRunner(const std::string& tag, void (f)(size_t), size_t NR_OPS) {
+	// generic test runner, takes a function that enumerates an operator NR_OPS times, and reports the median
+	// rate over calibrated samples, with the median absolute deviation relative to it
+	inline benchmark_result PerformanceRunner(const std::string& tag, void (f)(size_t), size_t NR_OPS) {
 		using namespace std;
-		using namespace std::chrono;
-
-		steady_clock::time_point begin = steady_clock::now();
-		f(NR_OPS);
-		steady_clock::time_point end = steady_clock::now();
-		duration<double> time_span = duration_cast<duration<double>> (end - begin);
-		double elapsed_time = time_span.count();
-
-		cout << tag << ' ' << setw(10) << NR_OPS << " per " << setw(15) << elapsed_time << "sec -> " << toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
+		benchmark_result r = RunBenchmark(tag, f, NR_OPS);
+		cout << tag << ' ' << setw(10) << NR_OPS << " per " << setw(15) << r.secondsPerCall() << "sec -> " << toPowerOfTen(r.median) << "ops/sec"
+		     << "  +-" << fixed << setprecision(1) << setw(4) << 100.0 * r.relativeMad() << "% (" << r.samples << " samples)";
+		if (r.cyclesPerOp > 0.0) cout << "  " << setprecision(2) << r.cyclesPerOp << " cycles/op, IPC " << r.ipc();
+		cout << defaultfloat << setprecision(6) << endl;
+		return r;
 	}
 
 }} // namespace sw::universal
@@ -0,0 +1,327 @@
+#pragma once
+//  throughput_matrix.hpp : the same latency- and throughput-bound kernels measured across number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// Choosing a number system for a kernel needs the cost of its operations measured the same way for
+// every candidate. ThroughputMatrix runs one fixed set of kernels over every type registered with
+// add<Real>(name), each through RunBenchmark (benchmark_harness.hpp), and collects the median rates
+// into one table:
+//
+//   add/mul/div/sqrt lat   a chain of dependent operations, each waiting for the previous result;
+//                          the sqrt chain is x = sqrt(x + c), counted as one operation per step
+//   add/mul tput           independent element-wise operations over arrays, c[i] = a[i] op b[i]
+//   dot, axpy              a reduction and an update over arrays, two operations per element
+//   cvt in, cvt out        conversion from and to double, one conversion per element
+//
+// The arrays hold 1024 elements, so the operands stay in L1 and the rows compare arithmetic, not
+// memory. Integer types get integer operands in [1, 1000] and chains that multiply and divide by
+// -1; they have no sqrt column. Operations a type does not provide are left empty. Every cell is
+// also recorded in benchmark_report under the tag "<type> <kernel>", so UNIVERSAL_BENCHMARK_OUTPUT
+// captures the matrix as well, for tools/cmd/benchcmp.
+//
+// Usage:
+//   ThroughputMatrix matrix;
+//   matrix.add<float>("float");
+//   matrix.add<posit<16,1>>("posit<16,1>");
+//   matrix.report(std::cout);         // table of Mops/sec
+//   matrix.write_json(jsonFile);      // {"kernels": [...], "types": [{"type": ..., "rates": {...}}]}
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <universal/benchmark/benchmark_harness.hpp>
+
+namespace sw { namespace universal {
+
+	namespace throughput_kernels {
+
+		constexpr std::size_t NR_ELEMENTS = 1024;
+
+		template<typename Real>
+		constexpr bool integral = std::numeric_limits<Real>::is_integer;
+
+		// operands in [0.5, 1.5), away from the special cases of every number system; [1, 1000] for integers
+		template<typename Real>
+		const std::vector<Real>& operands(unsigned stream) {
+			static const std::array<std::vector<Real>, 3> data = [] {
+				std::array<std::vector<Real>, 3> d;
+				for (unsigned s = 0; s < 3; ++s) {
+					d[s].resize(NR_ELEMENTS);
+					for (std::size_t i = 0; i < NR_ELEMENTS; ++i) {
+						std::size_t k = (i * (2 * s + 7) + 3 * s) % 1000;
+						d[s][i] = integral<Real> ? Real(int(k + 1)) : Real(0.5 + double(k) / 1000.0);
+					}
+				}
+				return d;
+			}();
+			return data[stream];
+		}
+
+		// the same values as double, the source of the conversion kernel
+		template<typename Real>
+		const std::vector<double>& doubles() {
+			static const std::vector<double> data = [] {
+				std::vector<double> d(NR_ELEMENTS);
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) {
+					std::size_t k = (i * 7) % 1000;
+					d[i] = integral<Real> ? double(k + 1) : 0.5 + double(k) / 1000.0;
+				}
+				return d;
+			}();
+			return data;
+		}
+
+		// dependent chains: alternating operands whose effects cancel, so the value stays in range;
+		// the barriers keep the compiler from folding, strength-reducing or reassociating the chain
+		template<typename Real>
+		void AddLatency(std::size_t NR_OPS) {
+			Real x(integral<Real> ? 12345.0 : 1.0), a(integral<Real> ? 377.0 : 0.375), b(integral<Real> ? -377.0 : -0.375);
+			DoNotOptimize(a);
+			DoNotOptimize(b);
+			for (std::size_t i = 0; i < NR_OPS; i += 2) {
+				x = x + a; DoNotOptimize(x);
+				x = x + b; DoNotOptimize(x);
+			}
+			DoNotOptimize(x);
+		}
+
+		template<typename Real>
+		void MulLatency(std::size_t NR_OPS) {
+			Real x(integral<Real> ? 12345.0 : 1.0), a(integral<Real> ? -1.0 : 1.25), b(integral<Real> ? -1.0 : 0.8);
+			DoNotOptimize(a);
+			DoNotOptimize(b);
+			for (std::size_t i = 0; i < NR_OPS; i += 2) {
+				x = x * a; DoNotOptimize(x);
+				x = x * b; DoNotOptimize(x);
+			}
+			DoNotOptimize(x);
+		}
+
+		template<typename Real>
+		void DivLatency(std::size_t NR_OPS) {
+			Real x(integral<Real> ? 12345.0 : 1.0), a(integral<Real> ? -1.0 : 1.25), b(integral<Real> ? -1.0 : 0.8);
+			DoNotOptimize(a);
+			DoNotOptimize(b);
+			for (std::size_t i = 0; i < NR_OPS; i += 2) {
+				x = x / a; DoNotOptimize(x);
+				x = x / b; DoNotOptimize(x);
+			}
+			DoNotOptimize(x);
+		}
+
+		template<typename Real>
+		void SqrtLatency(std::size_t NR_OPS) {
+			using std::sqrt;
+			Real x(1.0), c(0.5);   // converges to (1 + sqrt(3)) / 2, which no type represents exactly
+			DoNotOptimize(c);
+			for (std::size_t i = 0; i < NR_OPS; ++i) {
+				x = sqrt(x + c);
+				DoNotOptimize(x);
+			}
+		}
+
+		// independent operations over arrays
+		template<typename Real>
+		void AddThroughput(std::size_t NR_OPS) {
+			const std::vector<Real>& a = operands<Real>(0);
+			const std::vector<Real>& b = operands<Real>(1);
+			std::vector<Real> c(NR_ELEMENTS);
+			for (std::size_t n = 0; n < NR_OPS; n += NR_ELEMENTS) {
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) c[i] = a[i] + b[i];
+				ClobberMemory();
+			}
+			DoNotOptimize(c[0]);
+		}
+
+		template<typename Real>
+		void MulThroughput(std::size_t NR_OPS) {
+			const std::vector<Real>& a = operands<Real>(0);
+			const std::vector<Real>& b = operands<Real>(1);
+			std::vector<Real> c(NR_ELEMENTS);
+			for (std::size_t n = 0; n < NR_OPS; n += NR_ELEMENTS) {
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) c[i] = a[i] * b[i];
+				ClobberMemory();
+			}
+			DoNotOptimize(c[0]);
+		}
+
+		template<typename Real>
+		void Dot(std::size_t NR_OPS) {
+			const std::vector<Real>& x = operands<Real>(0);
+			const std::vector<Real>& y = operands<Real>(1);
+			Real sum(0);
+			for (std::size_t n = 0; n < NR_OPS; n += 2 * NR_ELEMENTS) {
+				sum = Real(0);
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) sum += x[i] * y[i];
+				DoNotOptimize(sum);
+				ClobberMemory();
+			}
+		}
+
+		template<typename Real>
+		void Axpy(std::size_t NR_OPS) {
+			const std::vector<Real>& x = operands<Real>(0);
+			std::vector<Real> y = operands<Real>(1);
+			Real a(integral<Real> ? 1.0 : 0.5), b(integral<Real> ? -1.0 : -0.5);   // alternate the sign of a so that y stays in range
+			for (std::size_t n = 0; n < NR_OPS; n += 2 * NR_ELEMENTS) {
+				const Real& alpha = ((n / (2 * NR_ELEMENTS)) % 2) ? b : a;
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) y[i] = alpha * x[i] + y[i];
+				ClobberMemory();
+			}
+			DoNotOptimize(y[0]);
+		}
+
+		template<typename Real>
+		void ConvertIn(std::size_t NR_OPS) {
+			const std::vector<double>& d = doubles<Real>();
+			std::vector<Real> r(NR_ELEMENTS);
+			for (std::size_t n = 0; n < NR_OPS; n += NR_ELEMENTS) {
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) r[i] = Real(d[i]);
+				ClobberMemory();
+			}
+			DoNotOptimize(r[0]);
+		}
+
+		template<typename Real>
+		void ConvertOut(std::size_t NR_OPS) {
+			const std::vector<Real>& r = operands<Real>(2);
+			std::vector<double> d(NR_ELEMENTS);
+			for (std::size_t n = 0; n < NR_OPS; n += NR_ELEMENTS) {
+				for (std::size_t i = 0; i < NR_ELEMENTS; ++i) d[i] = double(r[i]);
+				ClobberMemory();
+			}
+			DoNotOptimize(d[0]);
+		}
+
+		template<typename Real>
+		concept has_division = requires(Real a, Real b) { a / b; };
+
+		template<typename Real>
+		concept has_sqrt = requires(Real a) { { sqrt(a) }; } || requires(Real a) { { std::sqrt(a) }; };
+
+	} // namespace throughput_kernels
+
+	class ThroughputMatrix {
+	public:
+		enum kernel : unsigned { AddLat, MulLat, DivLat, SqrtLat, AddTput, MulTput, DotKernel, AxpyKernel, CvtIn, CvtOut, NrKernels };
+
+		static constexpr std::array<const char*, NrKernels> kernelNames = {
+			"add lat", "mul lat", "div lat", "sqrt lat", "add tput", "mul tput", "dot", "axpy", "cvt in", "cvt out"
+		};
+
+		struct row {
+			std::string                   type;
+			std::size_t                   nbits = 0;
+			std::array<double, NrKernels> rate{};       // median ops/sec, 0 when the type lacks the operation
+			std::array<double, NrKernels> relativeMad{};
+		};
+
+		// a cell needs only a few samples; UNIVERSAL_BENCHMARK_* still override
+		static benchmark_options default_options() {
+			benchmark_options options;
+			options.minSamples = 5;
+			options.maxSamples = 15;
+			options.minSampleTime = 0.005;
+			options.timeBudget = 0.050;
+			benchmark_options env = benchmark_options::from_environment();
+			if (std::getenv("UNIVERSAL_BENCHMARK_SAMPLES")) { options.minSamples = env.minSamples; options.maxSamples = env.maxSamples; }
+			if (std::getenv("UNIVERSAL_BENCHMARK_BUDGET")) options.timeBudget = env.timeBudget;
+			options.cpu = env.cpu;
+			options.counters = env.counters;
+			return options;
+		}
+
+		explicit ThroughputMatrix(std::size_t nrOps = 16'384, const benchmark_options& options = default_options())
+			: _nrOps(nrOps), _options(options), _progress(nullptr) {}
+
+		// print each cell to ostr as it is measured
+		void progress(std::ostream* ostr) { _progress = ostr; }
+
+		// measure every kernel for Real and append its row
+		template<typename Real>
+		const row& add(const std::string& name) {
+			using namespace throughput_kernels;
+			row r;
+			r.type = name;
+			r.nbits = 8 * sizeof(Real);
+			if constexpr (requires { Real::nbits; }) r.nbits = Real::nbits;
+			if (_progress) *_progress << name << std::flush;
+			measure(r, AddLat,  AddLatency<Real>);
+			measure(r, MulLat,  MulLatency<Real>);
+			if constexpr (has_division<Real>) measure(r, DivLat, DivLatency<Real>);
+			if constexpr (has_sqrt<Real> && !integral<Real>) measure(r, SqrtLat, SqrtLatency<Real>);
+			measure(r, AddTput, AddThroughput<Real>);
+			measure(r, MulTput, MulThroughput<Real>);
+			measure(r, DotKernel, Dot<Real>);
+			measure(r, AxpyKernel, Axpy<Real>);
+			measure(r, CvtIn,  ConvertIn<Real>);
+			measure(r, CvtOut, ConvertOut<Real>);
+			if (_progress) *_progress << '\n';
+			_rows.push_back(r);
+			return _rows.back();
+		}
+
+		const std::vector<row>& rows() const noexcept { return _rows; }
+
+		// table of Mops/sec, one row per type, one column per kernel
+		void report(std::ostream& ostr) const {
+			std::size_t width = 12;
+			for (const auto& r : _rows) width = std::max(width, r.type.size() + 2);
+			ostr << std::left << std::setw(int(width)) << "Mops/sec" << std::right;
+			for (const char* k : kernelNames) ostr << std::setw(10) << k;
+			ostr << '\n';
+			for (const auto& r : _rows) {
+				ostr << std::left << std::setw(int(width)) << r.type << std::right;
+				for (unsigned k = 0; k < NrKernels; ++k) {
+					if (r.rate[k] > 0.0) ostr << std::setw(10) << std::fixed << std::setprecision(r.rate[k] < 10.0e6 ? 2 : 0) << r.rate[k] / 1.0e6;
+					else ostr << std::setw(10) << '-';
+				}
+				ostr << '\n';
+			}
+			ostr << std::defaultfloat << std::setprecision(6);
+		}
+
+		// the matrix as one JSON document, rates in ops/sec
+		void write_json(std::ostream& ostr) const {
+			ostr << std::setprecision(6) << "{\n  \"suite\": " << benchmark_detail::json_string(benchmark_report::instance().suite())
+			     << ",\n  \"ops_per_call\": " << _nrOps << ",\n  \"kernels\": [";
+			for (unsigned k = 0; k < NrKernels; ++k) ostr << (k ? ", " : "") << benchmark_detail::json_string(kernelNames[k]);
+			ostr << "],\n  \"types\": [\n";
+			for (std::size_t i = 0; i < _rows.size(); ++i) {
+				const row& r = _rows[i];
+				ostr << "    {\"type\": " << benchmark_detail::json_string(r.type) << ", \"nbits\": " << r.nbits << ", \"rates\": {";
+				bool first = true;
+				for (unsigned k = 0; k < NrKernels; ++k) {
+					if (r.rate[k] <= 0.0) continue;
+					ostr << (first ? "" : ", ") << benchmark_detail::json_string(kernelNames[k]) << ": " << r.rate[k];
+					first = false;
+				}
+				ostr << "}}" << (i + 1 < _rows.size() ? ",\n" : "\n");
+			}
+			ostr << "  ]\n}\n";
+		}
+
+	private:
+		std::size_t       _nrOps;
+		benchmark_options _options;
+		std::ostream*     _progress;
+		std::vector<row>  _rows;
+
+		template<typename Workload>
+		void measure(row& r, kernel k, Workload&& f) {
+			benchmark_result result = RunBenchmark(r.type + ' ' + kernelNames[k], f, _nrOps, _options);
+			r.rate[k] = result.median;
+			r.relativeMad[k] = result.relativeMad();
+			if (_progress) *_progress << '.' << std::flush;
+		}
+	};
+
+}} // namespace sw::universal
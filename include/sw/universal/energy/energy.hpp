@@ -193,5 +193,6 @@ inline void printModelSummary(std::ostream& os, const EnergyCostModel& model) {
 // Include occurrence_energy after getDefaultModel() is declared
 #include "occurrence_energy.hpp"
 
-// Include hardware energy counters (platform-specific)
+// Include hardware energy and performance counters (platform-specific)
 #include "hw_counters/rapl.hpp"
+#include "hw_counters/perf_counters.hpp"
@@ -0,0 +1,406 @@
+#pragma once
+// perf_counters.hpp: hardware performance counters via Linux perf_event_open
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project.
+//
+// RAPL tells how much energy a kernel used, not why. The performance monitoring
+// unit (PMU) counts what the core did: cycles, retired instructions, branch
+// misses, and L1 data and last-level cache misses. Their ratios, instructions
+// per cycle and misses per operation, separate a number system that is slow
+// because it executes many instructions from one that waits on memory.
+//
+// The counters are opened for the calling thread and the threads it creates
+// while measuring, user space only, so they work at the default
+// perf_event_paranoid level of 2. Three sources, in order of preference:
+//   Hardware  the PMU events, plus the software events below
+//   Software  kernel software events (task clock, page faults, context switches,
+//             cpu migrations), where the PMU is not exposed, as in most VMs
+//   Rusage    getrusage(), where perf_event_open is not permitted at all
+// Counters the PMU multiplexes are scaled by the time they were enabled over
+// the time they were running.
+//
+// Supported platforms: Linux; elsewhere isAvailable() is false and stop()
+// returns an invalid result.
+//
+// Usage:
+//   #include <universal/energy/hw_counters/perf_counters.hpp>
+//
+//   using namespace sw::universal::energy;
+//
+//   PerfCounterReader counters;
+//   counters.start();
+//   // ... computation ...
+//   auto result = counters.stop();
+//   std::cout << "IPC: " << result.ipc() << '\n';
+//
+//   {
+//       ScopedPerfCounters measure("gemm 256");   // reports when it leaves scope
+//       gemm(...);
+//   }
+
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__) || defined(__linux) || defined(linux)
+    #define UNIVERSAL_PERF_EVENT_LINUX 1
+#endif
+
+#ifdef UNIVERSAL_PERF_EVENT_LINUX
+#include <cstring>
+#include <ctime>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace sw { namespace universal { namespace energy {
+
+/// Where the counts of a measurement came from
+enum class CounterSource : uint8_t {
+    None,       // no counters available
+    Hardware,   // PMU events through perf_event_open
+    Software,   // kernel software events through perf_event_open
+    Rusage      // getrusage() deltas
+};
+
+inline const char* counterSourceName(CounterSource source) {
+    switch (source) {
+        case CounterSource::Hardware: return "hardware";
+        case CounterSource::Software: return "software";
+        case CounterSource::Rusage:   return "rusage";
+        case CounterSource::None:
+        default:                      return "none";
+    }
+}
+
+/// Counter deltas of one measurement; counters that could not be opened stay 0 and their has_ flag false
+struct PerfCounts {
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t branch_misses;
+    uint64_t l1d_misses;          // L1 data cache read misses
+    uint64_t llc_misses;          // last-level cache read misses
+    uint64_t task_clock_ns;       // cpu time of the measured threads
+    uint64_t page_faults;
+    uint64_t context_switches;
+    uint64_t cpu_migrations;
+    bool     has_cycles;
+    bool     has_instructions;
+    bool     has_branch_misses;
+    bool     has_l1d_misses;
+    bool     has_llc_misses;
+    double   elapsed_ms;          // wall-clock time
+    CounterSource source;
+    bool     valid;               // True if measurement succeeded
+
+    PerfCounts() : cycles(0), instructions(0), branch_misses(0), l1d_misses(0), llc_misses(0),
+                   task_clock_ns(0), page_faults(0), context_switches(0), cpu_migrations(0),
+                   has_cycles(false), has_instructions(false), has_branch_misses(false),
+                   has_l1d_misses(false), has_llc_misses(false),
+                   elapsed_ms(0.0), source(CounterSource::None), valid(false) {}
+
+    /// True if the PMU counted cycles and instructions
+    bool hasHardware() const { return has_cycles && has_instructions; }
+
+    /// Instructions per cycle
+    double ipc() const { return (cycles > 0) ? static_cast<double>(instructions) / cycles : 0.0; }
+
+    /// Effective clock rate in GHz while the measured threads ran
+    double ghz() const { return (task_clock_ns > 0) ? static_cast<double>(cycles) / task_clock_ns : 0.0; }
+
+    /// Counts per operation, for kernels that perform a known number of operations
+    double cyclesPerOp(uint64_t ops) const       { return ops ? static_cast<double>(cycles) / ops : 0.0; }
+    double instructionsPerOp(uint64_t ops) const { return ops ? static_cast<double>(instructions) / ops : 0.0; }
+    double branchMissesPerOp(uint64_t ops) const { return ops ? static_cast<double>(branch_misses) / ops : 0.0; }
+    double l1dMissesPerOp(uint64_t ops) const    { return ops ? static_cast<double>(l1d_misses) / ops : 0.0; }
+    double llcMissesPerOp(uint64_t ops) const    { return ops ? static_cast<double>(llc_misses) / ops : 0.0; }
+
+    /// Accumulate another measurement
+    PerfCounts& operator+=(const PerfCounts& rhs) {
+        cycles += rhs.cycles; instructions += rhs.instructions; branch_misses += rhs.branch_misses;
+        l1d_misses += rhs.l1d_misses; llc_misses += rhs.llc_misses; task_clock_ns += rhs.task_clock_ns;
+        page_faults += rhs.page_faults; context_switches += rhs.context_switches; cpu_migrations += rhs.cpu_migrations;
+        elapsed_ms += rhs.elapsed_ms;
+        return *this;
+    }
+
+    /// Report counter measurement
+    void report(std::ostream& os = std::cout) const {
+        if (!valid) {
+            os << "Performance counters: invalid/unavailable\n";
+            return;
+        }
+        os << "Performance Counters (" << counterSourceName(source) << "):\n";
+        if (has_cycles)        os << "  Cycles:         " << cycles << "\n";
+        if (has_instructions)  os << "  Instructions:   " << instructions << "\n";
+        if (hasHardware())     os << "  IPC:            " << ipc() << "\n";
+        if (has_branch_misses) os << "  Branch misses:  " << branch_misses << "\n";
+        if (has_l1d_misses)    os << "  L1D misses:     " << l1d_misses << "\n";
+        if (has_llc_misses)    os << "  LLC misses:     " << llc_misses << "\n";
+        os << "  Task clock:     " << task_clock_ns / 1.0e6 << " ms\n";
+        os << "  Page faults:    " << page_faults << "\n";
+        os << "  Ctx switches:   " << context_switches << "\n";
+        os << "  Elapsed:        " << elapsed_ms << " ms\n";
+    }
+};
+
+#ifdef UNIVERSAL_PERF_EVENT_LINUX
+// ============================================================================
+// Linux implementation using perf_event_open, with a getrusage fallback
+// ============================================================================
+
+class PerfCounterReader {
+public:
+    PerfCounterReader() : source_(CounterSource::None), start_time_ns_(0), started_(false) {
+        for (auto& fd : fds_) fd = -1;
+        openCounters();
+    }
+    ~PerfCounterReader() {
+        for (auto& fd : fds_) if (fd >= 0) close(fd);
+    }
+    PerfCounterReader(const PerfCounterReader&) = delete;
+    PerfCounterReader& operator=(const PerfCounterReader&) = delete;
+
+    /// Check if any counter source works on this system
+    static bool isAvailable() { return true; }   // getrusage is the last resort
+
+    /// Check if the PMU can be read
+    static bool hasHardwareCounters() {
+        static const bool available = [] {
+            int fd = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            if (fd < 0) return false;
+            close(fd);
+            return true;
+        }();
+        return available;
+    }
+
+    /// Source of the counts this reader delivers
+    CounterSource source() const { return source_; }
+
+    /// Start counting
+    void start() {
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        }
+        if (source_ == CounterSource::Rusage) start_usage_ = readUsage();
+        start_time_ns_ = getTimeNs();
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        started_ = true;
+    }
+
+    /// Stop counting and return the deltas
+    PerfCounts stop() {
+        PerfCounts result;
+        if (!started_) return result;
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        result.elapsed_ms = (getTimeNs() - start_time_ns_) / 1000000.0;
+        result.source = source_;
+
+        if (source_ == CounterSource::Rusage) {
+            Usage end = readUsage();
+            result.task_clock_ns    = end.cpu_ns - start_usage_.cpu_ns;
+            result.page_faults      = end.faults - start_usage_.faults;
+            result.context_switches = end.switches - start_usage_.switches;
+        }
+        else {
+            result.cycles           = readCounter(fds_[Cycles],        result.has_cycles);
+            result.instructions     = readCounter(fds_[Instructions],  result.has_instructions);
+            result.branch_misses    = readCounter(fds_[BranchMisses],  result.has_branch_misses);
+            result.l1d_misses       = readCounter(fds_[L1DMisses],     result.has_l1d_misses);
+            result.llc_misses       = readCounter(fds_[LLCMisses],     result.has_llc_misses);
+            bool present = false;
+            result.task_clock_ns    = readCounter(fds_[TaskClock],       present);
+            result.page_faults      = readCounter(fds_[PageFaults],      present);
+            result.context_switches = readCounter(fds_[ContextSwitches], present);
+            result.cpu_migrations   = readCounter(fds_[CpuMigrations],   present);
+        }
+        result.valid = (source_ != CounterSource::None);
+        started_ = false;
+        return result;
+    }
+
+    /// Get system information
+    std::string systemInfo() const {
+        std::stringstream ss;
+        ss << "Performance counter source: " << counterSourceName(source_) << "\n";
+        const char* names[] = { "cycles", "instructions", "branch-misses", "L1-dcache-load-misses", "LLC-load-misses",
+                                "task-clock", "page-faults", "context-switches", "cpu-migrations" };
+        for (int i = 0; i < NrEvents; ++i) {
+            ss << "  " << names[i] << ": " << (fds_[i] >= 0 ? "available" : "unavailable") << "\n";
+        }
+        return ss.str();
+    }
+
+private:
+    enum Event { Cycles, Instructions, BranchMisses, L1DMisses, LLCMisses, TaskClock, PageFaults, ContextSwitches, CpuMigrations, NrEvents };
+
+    struct Usage {
+        uint64_t cpu_ns = 0;
+        uint64_t faults = 0;
+        uint64_t switches = 0;
+    };
+
+    int           fds_[NrEvents];
+    CounterSource source_;
+    Usage         start_usage_;
+    uint64_t      start_time_ns_;
+    bool          started_;
+
+    static constexpr uint64_t cacheReadMiss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    static int openEvent(uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = type;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;          // count the threads a kernel spawns while measuring
+        attr.exclude_kernel = 1;   // user space only: permitted at perf_event_paranoid 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        return static_cast<int>(fd);
+    }
+
+    void openCounters() {
+        fds_[Cycles]        = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds_[Instructions]  = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds_[BranchMisses]  = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds_[L1DMisses]     = openEvent(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D));
+        fds_[LLCMisses]     = openEvent(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL));
+        fds_[TaskClock]       = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+        fds_[PageFaults]      = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+        fds_[ContextSwitches] = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+        fds_[CpuMigrations]   = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS);
+
+        if (fds_[Cycles] >= 0 || fds_[Instructions] >= 0) source_ = CounterSource::Hardware;
+        else if (fds_[TaskClock] >= 0)                     source_ = CounterSource::Software;
+        else                                               source_ = CounterSource::Rusage;
+    }
+
+    // the count scaled up for the time the PMU multiplexed the event away
+    static uint64_t readCounter(int fd, bool& present) {
+        if (fd < 0) return 0;
+        uint64_t values[3] = { 0, 0, 0 };   // value, time enabled, time running
+        if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) return 0;
+        present = true;
+        if (values[2] == 0) return 0;
+        if (values[2] >= values[1]) return values[0];
+        return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+    }
+
+    static Usage readUsage() {
+        Usage u;
+        struct rusage ru;
+#ifdef RUSAGE_THREAD
+        if (getrusage(RUSAGE_THREAD, &ru) != 0) return u;
+#else
+        if (getrusage(RUSAGE_SELF, &ru) != 0) return u;
+#endif
+        u.cpu_ns = (static_cast<uint64_t>(ru.ru_utime.tv_sec) + ru.ru_stime.tv_sec) * 1000000000ULL
+                 + (static_cast<uint64_t>(ru.ru_utime.tv_usec) + ru.ru_stime.tv_usec) * 1000ULL;
+        u.faults = static_cast<uint64_t>(ru.ru_minflt + ru.ru_majflt);
+        u.switches = static_cast<uint64_t>(ru.ru_nvcsw + ru.ru_nivcsw);
+        return u;
+    }
+
+    static uint64_t getTimeNs() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    }
+};
+
+#else
+// ============================================================================
+// Stub implementation for non-Linux platforms (MacOS, Windows, etc.)
+// ============================================================================
+
+class PerfCounterReader {
+public:
+    PerfCounterReader() {}
+
+    /// Performance counters are not available on this platform
+    static bool isAvailable() { return false; }
+    static bool hasHardwareCounters() { return false; }
+    CounterSource source() const { return CounterSource::None; }
+
+    void start() {
+        // No-op on unsupported platforms
+    }
+
+    PerfCounts stop() {
+        PerfCounts result;
+        result.valid = false;
+        return result;
+    }
+
+    std::string systemInfo() const {
+        return "Performance counters not available: requires Linux perf_event_open\n";
+    }
+};
+
+#endif // UNIVERSAL_PERF_EVENT_LINUX
+
+/// RAII wrapper for a counter measurement; reports on destruction, or hands the counts to the caller
+class ScopedPerfCounters {
+public:
+    explicit ScopedPerfCounters(const std::string& label = "", PerfCounts* result = nullptr)
+        : label_(label), result_(result), reader_() {
+        if (PerfCounterReader::isAvailable()) {
+            reader_.start();
+            active_ = true;
+        }
+    }
+
+    ~ScopedPerfCounters() {
+        if (active_) {
+            auto counts = reader_.stop();
+            if (result_ != nullptr) {
+                *result_ = counts;
+            }
+            else if (counts.valid) {
+                std::cout << "perf [" << label_ << "]: ";
+                if (counts.hasHardware()) {
+                    std::cout << counts.cycles << " cycles, " << counts.instructions << " instructions, IPC " << counts.ipc();
+                    if (counts.has_llc_misses) std::cout << ", " << counts.llc_misses << " LLC misses";
+                }
+                else {
+                    std::cout << counts.task_clock_ns / 1.0e6 << " ms cpu, " << counts.page_faults << " page faults ("
+                              << counterSourceName(counts.source) << ")";
+                }
+                std::cout << '\n';
+            }
+        }
+    }
+
+    // Non-copyable
+    ScopedPerfCounters(const ScopedPerfCounters&) = delete;
+    ScopedPerfCounters& operator=(const ScopedPerfCounters&) = delete;
+
+private:
+    std::string label_;
+    PerfCounts* result_;
+    PerfCounterReader reader_;
+    bool active_ = false;
+};
+
+}}} // namespace sw::universal::energy
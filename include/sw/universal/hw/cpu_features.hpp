@@ -0,0 +1,204 @@
+#pragma once
+// cpu_features.hpp: runtime detection of the SIMD instruction set extensions of the host processor
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The UNIVERSAL_USE_SSE3/AVX/AVX2 build options select the ISA at compile time, which ties a binary
+// to the oldest machine it has to run on. This header answers the question at run time instead:
+// cpuid reports what the processor implements, xgetbv reports which register state the operating
+// system saves on a context switch, and an extension is only usable when both agree.
+//
+// The extensions are summarized as an ordered isa level, which is what the kernel tables in
+// dispatch.hpp select on:
+//
+//   scalar        no SIMD assumptions beyond the baseline of the target
+//   sse4_2        SSE4.2 (x86-64-v2)
+//   avx2          AVX2 and FMA (x86-64-v3)
+//   avx512        AVX-512 F, BW, DQ and VL (x86-64-v4)
+//   avx512_bf16   avx512 plus AVX512-BF16 (Cooper Lake, Zen 4)
+//   avx512_fp16   avx512_bf16 plus AVX512-FP16 (Sapphire Rapids)
+//
+// BF16 and FP16 are independent cpuid bits; every processor shipping AVX512-FP16 also implements
+// AVX512-BF16, so the chain is linear in practice and a processor that breaks it is reported at the
+// highest level whose prerequisites it does meet. On other architectures every level above scalar
+// is reported absent.
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <universal/utility/architecture.hpp>
+
+#if defined(UNIVERSAL_ARCH_X86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+#endif
+#endif
+
+namespace sw { namespace universal {
+
+enum class isa : int {
+	scalar = 0,
+	sse4_2,
+	avx2,
+	avx512,
+	avx512_bf16,
+	avx512_fp16
+};
+constexpr int nrOfIsaLevels = static_cast<int>(isa::avx512_fp16) + 1;
+
+inline const char* to_string(isa level) {
+	switch (level) {
+	case isa::scalar:      return "scalar";
+	case isa::sse4_2:      return "sse4.2";
+	case isa::avx2:        return "avx2";
+	case isa::avx512:      return "avx512";
+	case isa::avx512_bf16: return "avx512-bf16";
+	case isa::avx512_fp16: return "avx512-fp16";
+	}
+	return "unknown";
+}
+
+inline std::ostream& operator<<(std::ostream& ostr, isa level) {
+	return ostr << to_string(level);
+}
+
+// parse the names produced by to_string, and the underscore spelling of the enumerators
+inline bool parse(const std::string& name, isa& level) {
+	for (int i = 0; i < nrOfIsaLevels; ++i) {
+		isa candidate = static_cast<isa>(i);
+		std::string s = to_string(candidate);
+		std::string alt = s;
+		for (auto& c : alt) if (c == '.' || c == '-') c = '_';
+		if (name == s || name == alt) {
+			level = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+struct cpu_features {
+	bool sse4_2{ false };
+	bool avx{ false };
+	bool avx2{ false };
+	bool fma{ false };
+	bool avx512f{ false };
+	bool avx512bw{ false };
+	bool avx512dq{ false };
+	bool avx512vl{ false };
+	bool avx512_bf16{ false };
+	bool avx512_fp16{ false };
+
+	// the highest level whose prerequisites are all present
+	isa level() const noexcept {
+		if (!sse4_2) return isa::scalar;
+		if (!(avx && avx2 && fma)) return isa::sse4_2;
+		if (!(avx512f && avx512bw && avx512dq && avx512vl)) return isa::avx2;
+		if (!avx512_bf16) return isa::avx512;
+		if (!avx512_fp16) return isa::avx512_bf16;
+		return isa::avx512_fp16;
+	}
+};
+
+namespace detail {
+
+#if defined(UNIVERSAL_ARCH_X86_64) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+
+	inline void cpuid(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t regs[4]) noexcept {
+#if defined(_MSC_VER)
+		int r[4];
+		__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (int i = 0; i < 4; ++i) regs[i] = static_cast<std::uint32_t>(r[i]);
+#else
+		unsigned a{ 0 }, b{ 0 }, c{ 0 }, d{ 0 };
+		__cpuid_count(leaf, subleaf, a, b, c, d);
+		regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+#endif
+	}
+
+	// extended control register 0: the register state the OS saves and restores
+	inline std::uint64_t xgetbv0() noexcept {
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		std::uint32_t lo{ 0 }, hi{ 0 };
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+	}
+
+	inline cpu_features detect_cpu_features() noexcept {
+		cpu_features f;
+		std::uint32_t r[4];
+		cpuid(0, 0, r);
+		const std::uint32_t maxLeaf = r[0];
+		if (maxLeaf < 1) return f;
+
+		cpuid(1, 0, r);
+		const std::uint32_t ecx1 = r[2];
+		f.sse4_2 = (ecx1 >> 20) & 1u;
+		const bool osxsave = (ecx1 >> 27) & 1u;
+		const bool avxBit  = (ecx1 >> 28) & 1u;
+		const bool fmaBit  = (ecx1 >> 12) & 1u;
+
+		// XMM and YMM state (bits 1, 2), and the AVX-512 opmask and ZMM state (bits 5, 6, 7)
+		const std::uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+		const bool osYmm = (xcr0 & 0x06u) == 0x06u;
+		const bool osZmm = (xcr0 & 0xE6u) == 0xE6u;
+
+		f.avx = avxBit && osYmm;
+		f.fma = fmaBit && osYmm;
+		if (maxLeaf < 7) return f;
+
+		cpuid(7, 0, r);
+		const std::uint32_t maxSubleaf = r[0];
+		const std::uint32_t ebx7 = r[1];
+		const std::uint32_t edx7 = r[3];
+		f.avx2        = ((ebx7 >>  5) & 1u) && osYmm;
+		f.avx512f     = ((ebx7 >> 16) & 1u) && osZmm;
+		f.avx512dq    = ((ebx7 >> 17) & 1u) && osZmm;
+		f.avx512bw    = ((ebx7 >> 30) & 1u) && osZmm;
+		f.avx512vl    = ((ebx7 >> 31) & 1u) && osZmm;
+		f.avx512_fp16 = ((edx7 >> 23) & 1u) && osZmm;
+		if (maxSubleaf >= 1) {
+			cpuid(7, 1, r);
+			f.avx512_bf16 = ((r[0] >> 5) & 1u) && osZmm;
+		}
+		return f;
+	}
+
+#else
+
+	inline cpu_features detect_cpu_features() noexcept { return cpu_features{}; }
+
+#endif
+
+} // namespace detail
+
+// the features of the host, detected once
+inline const cpu_features& host_cpu_features() noexcept {
+	static const cpu_features features = detail::detect_cpu_features();
+	return features;
+}
+
+inline std::ostream& operator<<(std::ostream& ostr, const cpu_features& f) {
+	ostr << "sse4.2 "       << (f.sse4_2 ? "yes" : "no")
+	     << ", avx "         << (f.avx ? "yes" : "no")
+	     << ", avx2 "        << (f.avx2 ? "yes" : "no")
+	     << ", fma "         << (f.fma ? "yes" : "no")
+	     << ", avx512f "     << (f.avx512f ? "yes" : "no")
+	     << ", avx512bw "    << (f.avx512bw ? "yes" : "no")
+	     << ", avx512dq "    << (f.avx512dq ? "yes" : "no")
+	     << ", avx512vl "    << (f.avx512vl ? "yes" : "no")
+	     << ", avx512-bf16 " << (f.avx512_bf16 ? "yes" : "no")
+	     << ", avx512-fp16 " << (f.avx512_fp16 ? "yes" : "no");
+	return ostr;
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,153 @@
+#pragma once
+// dispatch.hpp: runtime selection of ISA-specific kernels
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// A bulk kernel is compiled several times in the same translation unit, once per isa level, by
+// wrapping a common body in functions carrying a target attribute (function multiversioning):
+//
+//   template<size_t N> UNIVERSAL_TARGET_AVX2 void add_avx2(...) { add_body<N>(...); }
+//
+// The body is ordinary C++ with no intrinsics; the attribute lets the compiler vectorize it for
+// that ISA without raising the baseline of the rest of the binary. Each variant is registered in a
+// kernel_table, and the call site asks the table for the best variant the host supports:
+//
+//   static const kernel_table<void(const double*, double*, size_t)> table = [] {
+//       kernel_table<void(const double*, double*, size_t)> t(scale_scalar);
+//       t.register_kernel(isa::avx2, scale_avx2);
+//       return t;
+//   }();
+//   table.resolve()(x, y, n);
+//
+// The active level is the detected level of the host (cpu_features.hpp), lowered by an optional
+// override so a benchmark can time every variant on one machine:
+//
+//   set_isa_override(isa::avx2);   // or UNIVERSAL_ISA=avx2 in the environment
+//   clear_isa_override();
+//
+// An override can only lower the level: raising it above the host would execute illegal instructions.
+// Compilers without target attributes (MSVC) define the UNIVERSAL_TARGET_* macros empty and
+// UNIVERSAL_HAS_TARGET_ATTRIBUTES as 0; tables then only register their scalar kernel.
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#include <universal/hw/cpu_features.hpp>
+
+#if defined(UNIVERSAL_ARCH_X86_64) && (defined(__GNUC__) || defined(__clang__)) && !defined(__INTEL_COMPILER)
+#define UNIVERSAL_HAS_TARGET_ATTRIBUTES 1
+#define UNIVERSAL_TARGET_SSE4_2      __attribute__((target("sse4.2")))
+#define UNIVERSAL_TARGET_AVX2        __attribute__((target("avx2,fma")))
+#define UNIVERSAL_TARGET_AVX512      __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,fma")))
+#define UNIVERSAL_TARGET_AVX512_BF16 __attribute__((target("avx512bf16,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma")))
+#define UNIVERSAL_TARGET_AVX512_FP16 __attribute__((target("avx512fp16,avx512bf16,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma")))
+#else
+#define UNIVERSAL_HAS_TARGET_ATTRIBUTES 0
+#define UNIVERSAL_TARGET_SSE4_2
+#define UNIVERSAL_TARGET_AVX2
+#define UNIVERSAL_TARGET_AVX512
+#define UNIVERSAL_TARGET_AVX512_BF16
+#define UNIVERSAL_TARGET_AVX512_FP16
+#endif
+
+// the common body of a multiversioned kernel must be inlined into each variant, or the variants
+// all call the one baseline copy of it
+#if defined(_MSC_VER)
+#define UNIVERSAL_KERNEL_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define UNIVERSAL_KERNEL_INLINE inline __attribute__((always_inline))
+#else
+#define UNIVERSAL_KERNEL_INLINE inline
+#endif
+
+namespace sw { namespace universal {
+
+namespace detail {
+
+	// -1: no override
+	inline std::atomic<int>& isa_override_slot() noexcept {
+		static std::atomic<int> slot{ -1 };
+		return slot;
+	}
+
+	// the UNIVERSAL_ISA environment variable seeds the override once, before the first query
+	inline void seed_isa_override_from_environment() noexcept {
+		static const bool seeded = [] {
+			const char* env = std::getenv("UNIVERSAL_ISA");
+			isa level{ isa::scalar };
+			if (env != nullptr && parse(std::string(env), level)) {
+				int expected = -1;
+				isa_override_slot().compare_exchange_strong(expected, static_cast<int>(level));
+			}
+			return true;
+		}();
+		(void)seeded;
+	}
+
+} // namespace detail
+
+// the level of the host, as detected
+inline isa detected_isa() noexcept {
+	static const isa level = host_cpu_features().level();
+	return level;
+}
+
+// cap the active level at 'level'; a cap above the detected level has no effect
+inline void set_isa_override(isa level) noexcept {
+	detail::seed_isa_override_from_environment();
+	detail::isa_override_slot().store(static_cast<int>(level));
+}
+
+inline void clear_isa_override() noexcept {
+	detail::seed_isa_override_from_environment();
+	detail::isa_override_slot().store(-1);
+}
+
+// the level kernels are selected for: the detected level, lowered by the override if one is set
+inline isa active_isa() noexcept {
+	detail::seed_isa_override_from_environment();
+	int cap = detail::isa_override_slot().load(std::memory_order_relaxed);
+	int host = static_cast<int>(detected_isa());
+	return static_cast<isa>((cap >= 0 && cap < host) ? cap : host);
+}
+
+// One kernel per isa level, the scalar kernel mandatory. Resolution picks the highest registered
+// level not above the requested one, so a table with scalar and avx2 variants runs the avx2 kernel
+// on an avx512 host.
+template<typename Signature>
+class kernel_table {
+public:
+	using function_type = Signature*;
+
+	explicit kernel_table(function_type scalarKernel) noexcept {
+		_kernels[0] = scalarKernel;
+	}
+
+	// variants for levels the compiler cannot target are skipped, so registration needs no #if
+	kernel_table& register_kernel(isa level, function_type kernel) noexcept {
+		if (UNIVERSAL_HAS_TARGET_ATTRIBUTES || level == isa::scalar) {
+			_kernels[static_cast<int>(level)] = kernel;
+		}
+		return *this;
+	}
+
+	bool has(isa level) const noexcept { return _kernels[static_cast<int>(level)] != nullptr; }
+
+	// the level resolve() would select for a host running at 'level'
+	isa selected(isa level) const noexcept {
+		int i = static_cast<int>(level);
+		while (i > 0 && _kernels[i] == nullptr) --i;
+		return static_cast<isa>(i);
+	}
+
+	function_type resolve(isa level) const noexcept { return _kernels[static_cast<int>(selected(level))]; }
+	function_type resolve() const noexcept { return resolve(active_isa()); }
+
+private:
+	function_type _kernels[nrOfIsaLevels]{};
+};
+
+}} // namespace sw::universal
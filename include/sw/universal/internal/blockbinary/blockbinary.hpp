@@ -28,6 +28,21 @@ template<unsigned nbits, typename BlockType, BinaryNumberType NumberType> class
 template<unsigned nbits, typename BlockType, BinaryNumberType NumberType> constexpr blockbinary<nbits, BlockType, NumberType> twosComplement(const blockbinary<nbits, BlockType, NumberType>&);
 template<unsigned nbits, typename BlockType, BinaryNumberType NumberType> struct quorem;
 template<unsigned nbits, typename BlockType, BinaryNumberType NumberType> constexpr quorem<nbits, BlockType, NumberType> longdivision(const blockbinary<nbits, BlockType, NumberType>&, const blockbinary<nbits, BlockType, NumberType>&);
+template<unsigned nbits, typename BlockType, BinaryNumberType NumberType> constexpr quorem<nbits, BlockType, NumberType> nativedivision(const blockbinary<nbits, BlockType, NumberType>&, const blockbinary<nbits, BlockType, NumberType>&);
+
+// native integer that is wide enough to hold nbits, or void when there is none.
+// blockbinary configurations that fit map their multiply and divide directly onto the hardware instructions
+template<unsigned nbits>
+struct native_word {
+#if defined(__SIZEOF_INT128__)
+	using type        = std::conditional_t<(nbits <= 32), std::uint32_t, std::conditional_t<(nbits <= 64), std::uint64_t, std::conditional_t<(nbits <= 128), uint128_t, void>>>;
+	using signed_type = std::conditional_t<(nbits <= 32), std::int32_t,  std::conditional_t<(nbits <= 64), std::int64_t,  std::conditional_t<(nbits <= 128), int128_t,  void>>>;
+#else
+	using type        = std::conditional_t<(nbits <= 32), std::uint32_t, std::conditional_t<(nbits <= 64), std::uint64_t, void>>;
+	using signed_type = std::conditional_t<(nbits <= 32), std::int32_t,  std::conditional_t<(nbits <= 64), std::int64_t,  void>>;
+#endif
+};
+template<unsigned nbits> using native_word_t = typename native_word<nbits>::type;
 
 // idiv_t for blockbinary<nbits> to capture quotient and remainder during long division
 template<unsigned nbits, typename BlockType, BinaryNumberType NumberType>
@@ -282,11 +297,18 @@ public:
 #define BLOCKBINARY_FAST_MUL
 #ifdef BLOCKBINARY_FAST_MUL
 	constexpr blockbinary& operator*=(const blockbinary& rhs) {
-		if constexpr (NumberType == BinaryNumberType::Signed) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(static_cast<std::uint64_t>(_block[0]) * static_cast<std::uint64_t>(rhs.block(0)));
-			}
-			else if constexpr (bitsInBlock == 64) {
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(static_cast<std::uint64_t>(_block[0]) * static_cast<std::uint64_t>(rhs.block(0)));
+		}
+		else if constexpr (!std::is_void_v<native_word_t<nbits>>) {
+			// nbits <= 64, or <= 128 with __int128: a single native multiply.
+			// The lower nbits of the product are the same for the signed and unsigned encodings
+			using Word = native_word_t<nbits>;
+			set_native_bits(to_native_bits<Word>() * rhs.template to_native_bits<Word>());
+			return *this;
+		}
+		else if constexpr (NumberType == BinaryNumberType::Signed) {
+			if constexpr (bitsInBlock == 64) {
 				// uint64_t limbs: mul128/addcarry use platform intrinsics that are not
 				// constexpr on MSVC. In a constant-evaluated context, fall back to a
 				// portable __uint128_t-based carry-propagation loop (gcc/clang only).
@@ -373,10 +395,7 @@ public:
 			}
 		}
 		else {  // unsigned
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(static_cast<std::uint64_t>(_block[0]) * static_cast<std::uint64_t>(rhs.block(0)));
-			}
-			else if constexpr (bitsInBlock == 64) {
+			if constexpr (bitsInBlock == 64) {
 				// uint64_t limbs: same is_constant_evaluated dispatch as the signed path.
 				blockbinary base(*this);
 				blockbinary multiplicant(rhs);
@@ -460,24 +479,8 @@ public:
 	}
 #endif
 	constexpr blockbinary& operator/=(const blockbinary& rhs) {
-		if constexpr (nbits == (sizeof(BlockType) * 8)) {
-			if (rhs.iszero()) {
-				*this = 0;
-				return *this;
-			}
-			if constexpr (sizeof(BlockType) == 1) {
-				_block[0] = static_cast<bt>(std::int8_t(_block[0]) / std::int8_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 2) {
-				_block[0] = static_cast<bt>(std::int16_t(_block[0]) / std::int16_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 4) {
-				_block[0] = static_cast<bt>(std::int32_t(_block[0]) / std::int32_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 8) {
-				_block[0] = static_cast<bt>(std::int64_t(_block[0]) / std::int64_t(rhs._block[0]));
-			}
-			_block[0] = static_cast<bt>(MSU_MASK & _block[0]);
+		if constexpr (!std::is_void_v<native_word_t<nbits>>) {
+			*this = nativedivision(*this, rhs).quo;
 		}
 		else {
 			quorem<nbits, BlockType, NumberType> result = longdivision(*this, rhs);
@@ -486,24 +489,8 @@ public:
 		return *this;
 	}
 	constexpr blockbinary& operator%=(const blockbinary& rhs) {
-		if constexpr (nbits == (sizeof(BlockType) * 8)) {
-			if (rhs.iszero()) {
-				*this = 0;
-				return *this;
-			}
-			if constexpr (sizeof(BlockType) == 1) {
-				_block[0] = static_cast<bt>(std::int8_t(_block[0]) % std::int8_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 2) {
-				_block[0] = static_cast<bt>(std::int16_t(_block[0]) % std::int16_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 4) {
-				_block[0] = static_cast<bt>(std::int32_t(_block[0]) % std::int32_t(rhs._block[0]));
-			}
-			else if constexpr (sizeof(BlockType) == 8) {
-				_block[0] = static_cast<bt>(std::int64_t(_block[0]) % std::int64_t(rhs._block[0]));
-			}
-			_block[0] = static_cast<bt>(MSU_MASK & _block[0]);
+		if constexpr (!std::is_void_v<native_word_t<nbits>>) {
+			*this = nativedivision(*this, rhs).rem;
 		}
 		else {
 			quorem<nbits, BlockType, NumberType> result = longdivision(*this, rhs);
@@ -940,6 +927,35 @@ public:
 		}
 		return ull;
 	}
+	// gather the blocks into a native unsigned integer of at least nbits, sign-extended for Signed types
+	template<typename Word>
+	constexpr Word to_native_bits() const noexcept {
+		constexpr unsigned wordBits = 8 * sizeof(Word);
+		static_assert(nbits <= wordBits, "to_native_bits: native word is too narrow for nbits");
+		Word raw{ 0 };
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			raw |= static_cast<Word>(_block[i]) << (i * bitsInBlock);
+		}
+		if constexpr (NumberType == BinaryNumberType::Signed && nbits < wordBits) {
+			if (sign()) raw |= static_cast<Word>(~Word(0)) << nbits;
+		}
+		return raw;
+	}
+	// scatter the lower nbits of a native unsigned integer into the blocks
+	template<typename Word>
+	constexpr void set_native_bits(Word raw) noexcept {
+		constexpr unsigned wordBits = 8 * sizeof(Word);
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			_block[i] = static_cast<bt>(raw);
+			if constexpr (bitsInBlock < wordBits) {
+				raw >>= bitsInBlock;
+			}
+			else {
+				raw = 0;
+			}
+		}
+		_block[MSU] &= MSU_MASK;
+	}
 	template<typename Real,
 		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
 	Real to_native() const {
@@ -1083,10 +1099,51 @@ blockbinary<N, B, T> operator>>(const blockbinary<N, B, T>& a, long b) {
 	return c >>= b;
 }
 
+// divide a by b using the native integer divide, for configurations with a native_word,
+// and return both quotient and remainder with the same semantics as longdivision:
+// truncation toward zero, the remainder takes the sign of the dividend, maxneg / -1 wraps to maxneg,
+// and division by zero returns zeros with exceptionId 1
+template<unsigned N, typename B, BinaryNumberType T>
+constexpr quorem<N, B, T> nativedivision(const blockbinary<N, B, T>& dividend, const blockbinary<N, B, T>& divisor) {
+	using Word = native_word_t<N>;
+	static_assert(!std::is_void_v<Word>, "nativedivision requires a configuration that fits a native integer");
+	quorem<N, B, T> result = { 0, 0, 0 };
+	if (divisor.iszero()) {
+		result.exceptionId = 1; // division by zero
+		return result;
+	}
+	Word a = dividend.template to_native_bits<Word>();
+	Word b = divisor.template to_native_bits<Word>();
+	if constexpr (T == BinaryNumberType::Signed && N < 8 * sizeof(Word)) {
+		// sign-extended operands are narrower than the word, so maxneg / -1 cannot overflow
+		using SignedWord = typename native_word<N>::signed_type;
+		result.quo.set_native_bits(Word(SignedWord(a) / SignedWord(b)));
+		result.rem.set_native_bits(Word(SignedWord(a) % SignedWord(b)));
+	}
+	else if constexpr (T == BinaryNumberType::Signed) {
+		// divide the magnitudes in unsigned arithmetic: the magnitude of maxneg is representable
+		// and the maxneg / -1 overflow of the signed divide cannot occur
+		bool a_sign = dividend.sign();
+		bool b_sign = divisor.sign();
+		Word quo = (a_sign ? Word(0) - a : a) / (b_sign ? Word(0) - b : b);
+		Word rem = (a_sign ? Word(0) - a : a) % (b_sign ? Word(0) - b : b);
+		result.quo.set_native_bits(a_sign ^ b_sign ? Word(0) - quo : quo);
+		result.rem.set_native_bits(a_sign ? Word(0) - rem : rem);
+	}
+	else {
+		result.quo.set_native_bits(Word(a / b));
+		result.rem.set_native_bits(Word(a % b));
+	}
+	return result;
+}
+
 // divide a by b and return both quotient and remainder
 template<unsigned N, typename B, BinaryNumberType T>
 constexpr quorem<N, B, T> longdivision(const blockbinary<N, B, T>& dividend, const blockbinary<N, B, T>& divisor) {
 	static_assert(T == BinaryNumberType::Signed, "longdivision requires signed blockbinary types");
+	if constexpr (!std::is_void_v<native_word_t<N>>) {
+		return nativedivision(dividend, divisor);
+	}
 	using BlockBinary = blockbinary<N + 1, B, T>;
 	quorem<N, B, T> result = { 0, 0, 0 };
 	if (divisor.iszero()) {
@@ -1197,6 +1254,19 @@ constexpr blockbinary<2*N, B, T> urmul(const blockbinary<N, B, T>& a, const bloc
 template<unsigned N, typename B, BinaryNumberType T>
 constexpr blockbinary<2 * N, B, T> urmul2(const blockbinary<N, B, T>& a, const blockbinary<N, B, T>& b) {
 	blockbinary<2 * N, B, T> result(0);
+	if constexpr (T == BinaryNumberType::Signed) {
+		// the full product of two sign-extended N-bit values fits in 2N bits, so the modulo 2^2N
+		// multiply is exact: a single native multiply when 2N fits a native word, the limb multiply otherwise
+		if constexpr (!std::is_void_v<native_word_t<2 * N>>) {
+			using Word = native_word_t<2 * N>;
+			result.set_native_bits(Word(a.template to_native_bits<Word>() * b.template to_native_bits<Word>()));
+		}
+		else {
+			result = a;  // sign-extends
+			result *= blockbinary<2 * N, B, T>(b);
+		}
+		return result;
+	}
 	if (a.iszero() || b.iszero()) return result;
 
 	// compute the result
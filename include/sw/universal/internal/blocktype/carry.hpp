@@ -25,6 +25,7 @@ namespace sw { namespace universal {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 using uint128_t = unsigned __int128;
+using int128_t  = __int128;
 #pragma GCC diagnostic pop
 #endif
 
@@ -0,0 +1,306 @@
+#pragma once
+// cascade_network.hpp: fixed-size, branch-free add/mul/renormalization networks for floatcascade<N>
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The operators of floatcascade<N> are written for latency of a single operation in a dependent
+// chain: volatile-hardened error-free transformations, a merge that checks its own precondition,
+// and a renormalization that branches on every cancelled component. That is the right trade for
+// scalar code, and the wrong one for bulk work: the volatiles force every intermediate through
+// memory and the data-dependent branches stop the compiler from vectorizing across elements.
+//
+// This header provides the bulk-friendly counterpart for N = 2, 3 and 4:
+//
+//   renormalize<N>(x)   two sweeps over M >= N terms, no branches: a VecSum from least to most
+//                       significant (exact), then a top-down sweep that emits N components,
+//                       skipping zeros with selects instead of branches
+//   sloppy_add<N>       component-wise two_sum, interleaved by order of magnitude, renormalized.
+//                       The Bailey/Hida 'sloppy' addition: full accuracy unless the operands
+//                       cancel in their leading components
+//   accurate_add<N>     the 2N components are sorted by magnitude with a Batcher odd-even
+//                       merge-sort network generated at compile time, summed with a VecSum and
+//                       renormalized. Accurate under cancellation, no data-dependent branches
+//   multiply<N>         partial products accumulated by order eps^k with the product errors and
+//                       the summation errors carried into order k+1, products beyond order N dropped
+//
+// All loops have trip counts that depend only on N, so the networks unroll completely; the compare
+// and exchange of the sorting network is written as selects, which compile to blends. Every network
+// is force-inlined, so a multiversioned kernel (hw/dispatch.hpp) compiles all of it for its own ISA.
+//
+// REQUIREMENT: the error-free transformations in this header are NOT volatile-hardened. They rely
+// on IEEE-754 semantics being honored: no -ffast-math, no /fp:fast, no reassociation. The library's
+// build already enforces /fp:precise and -ffp-contract=off (see floatcascade_volatile_hardening.md).
+// two_prod uses a fused multiply-add when the target has one (FP_FAST_FMA), and Dekker's split otherwise.
+//
+// The networks compute the same value as the floatcascade operators to within the last component:
+// cascade_network.cpp in internal/floatcascade/arithmetic validates the bound, and
+// benchmark/performance/arithmetic/highprecision/networks.cpp measures the speed.
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include <universal/hw/dispatch.hpp>
+#include <universal/internal/floatcascade/floatcascade.hpp>
+
+namespace sw::universal {
+
+namespace cascade_network {
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // error-free transformations, vectorizable form
+
+    // Knuth's TWO-SUM: a + b = s + e exactly, no precondition
+    UNIVERSAL_KERNEL_INLINE constexpr void two_sum(double a, double b, double& s, double& e) noexcept {
+        s = a + b;
+        double bb = s - a;
+        e = (a - (s - bb)) + (b - bb);
+    }
+
+    // Dekker's FAST-TWO-SUM: a + b = s + e exactly when |a| >= |b|
+    UNIVERSAL_KERNEL_INLINE constexpr void fast_two_sum(double a, double b, double& s, double& e) noexcept {
+        s = a + b;
+        e = b - (s - a);
+    }
+
+    // TWO-PROD: a * b = p + e exactly (for products that neither overflow nor underflow)
+    UNIVERSAL_KERNEL_INLINE void two_prod(double a, double b, double& p, double& e) noexcept {
+        p = a * b;
+#if defined(FP_FAST_FMA)
+        e = std::fma(a, b, -p);
+#else
+        constexpr double splitter = 134217729.0;  // 2^27 + 1
+        double t = splitter * a;
+        double ahi = t - (t - a);
+        double alo = a - ahi;
+        t = splitter * b;
+        double bhi = t - (t - b);
+        double blo = b - bhi;
+        e = ((ahi * bhi - p) + ahi * blo + alo * bhi) + alo * blo;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // compile-time sorting network
+
+    // Batcher's odd-even merge sort for P = 2^k inputs, as a list of compare-exchange pairs
+    template<size_t P>
+    struct batcher_network {
+        static_assert(P >= 2 && (P & (P - 1)) == 0, "batcher_network requires a power of two");
+
+        static constexpr size_t capacity = P * P;  // generous bound on the comparator count
+        std::array<unsigned char, capacity> lo{};
+        std::array<unsigned char, capacity> hi{};
+        size_t size{ 0 };
+
+        constexpr batcher_network() {
+            for (size_t p = 1; p < P; p <<= 1) {
+                for (size_t k = p; k >= 1; k >>= 1) {
+                    for (size_t j = k % p; j + k < P; j += 2 * k) {
+                        for (size_t i = 0; i < k && i + j + k < P; ++i) {
+                            if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                                lo[size] = static_cast<unsigned char>(i + j);
+                                hi[size] = static_cast<unsigned char>(i + j + k);
+                                ++size;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        static const batcher_network instance;
+    };
+
+    template<size_t P>
+    constexpr batcher_network<P> batcher_network<P>::instance{};
+
+    constexpr size_t next_power_of_two(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // compare-exchange by magnitude, larger first, as selects rather than branches
+    UNIVERSAL_KERNEL_INLINE constexpr void compare_exchange(double& p, double& q) noexcept {
+        double ap = p < 0.0 ? -p : p;
+        double aq = q < 0.0 ? -q : q;
+        bool swap = ap < aq;
+        double larger = swap ? q : p;
+        double smaller = swap ? p : q;
+        p = larger;
+        q = smaller;
+    }
+
+    template<size_t P, size_t... K>
+    UNIVERSAL_KERNEL_INLINE constexpr void apply_network(std::array<double, P>& v, std::index_sequence<K...>) noexcept {
+        (compare_exchange(v[batcher_network<P>::instance.lo[K]], v[batcher_network<P>::instance.hi[K]]), ...);
+    }
+
+    // sort P values by decreasing magnitude with the unrolled network
+    template<size_t P>
+    UNIVERSAL_KERNEL_INLINE constexpr void sort_by_magnitude(std::array<double, P>& v) noexcept {
+        apply_network(v, std::make_index_sequence<batcher_network<P>::instance.size>{});
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // renormalization
+
+    // Reduce M terms in (approximately) decreasing order of magnitude to an N-component cascade.
+    // Sweep 1 is a VecSum from least to most significant: it is exact, and leaves the sum in f[0]
+    // with the rounding errors below it. Sweep 2 is the VecSumErrBranch of Joldes, Muller and
+    // Popescu run top-down: a component is emitted whenever a two_sum leaves a nonzero error, so
+    // zeros and cancelled terms are skipped. The branch on the error is replaced by selects on the
+    // output slot, and whatever remains below the last component is folded into it.
+    template<size_t N, size_t M>
+    UNIVERSAL_KERNEL_INLINE constexpr floatcascade<N> renormalize(const std::array<double, M>& x) noexcept {
+        static_assert(M >= N, "renormalize needs at least as many terms as components");
+        std::array<double, M> f{};
+        double s = x[M - 1];
+        for (size_t i = M - 1; i-- > 0; ) {
+            two_sum(x[i], s, s, f[i + 1]);
+        }
+        f[0] = s;
+
+        floatcascade<N> r;
+        size_t slot = 0;
+        double e = f[0];
+        for (size_t i = 1; i < M; ++i) {
+            double c{}, t{};
+            two_sum(e, f[i], c, t);
+            for (size_t k = 0; k < N; ++k) r[k] = (k == slot) ? c : r[k];
+            bool advance = (t != 0.0) && (slot + 1 < N);
+            e = advance ? t : c;
+            slot += advance ? 1 : 0;
+        }
+        for (size_t k = 0; k < N; ++k) r[k] = (k == slot) ? e : r[k];
+        return r;
+    }
+
+    // non-finite results: the trailing components of an infinity or a NaN carry no information, and
+    // the error-free transformations turn them into NaNs. 'probe' is a leading term of the result,
+    // before or after renormalization; x - x is zero exactly when x is finite, which is a compare
+    // rather than a branch.
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE constexpr floatcascade<N> guard_nonfinite(const floatcascade<N>& r, double probe, double leading) noexcept {
+        const bool finite = (probe - probe) == 0.0;
+        floatcascade<N> g;
+        g[0] = finite ? r[0] : leading;
+        for (size_t i = 1; i < N; ++i) g[i] = finite ? r[i] : 0.0;
+        return g;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // addition
+
+    // Bailey/Hida sloppy addition: the component-wise sums s_i and their errors t_i are laid out
+    // as s0, s1, t0, s2, t1, ..., t_{N-1}, which is decreasing in magnitude unless the leading
+    // components cancel
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE floatcascade<N> sloppy_add(const floatcascade<N>& a, const floatcascade<N>& b) noexcept {
+        std::array<double, 2 * N> x{};
+        double s{}, t{}, carry{};
+        two_sum(a[0], b[0], s, carry);
+        x[0] = s;
+        for (size_t i = 1; i < N; ++i) {
+            two_sum(a[i], b[i], s, t);
+            x[2 * i - 1] = s;
+            x[2 * i] = carry;
+            carry = t;
+        }
+        x[2 * N - 1] = carry;
+        return guard_nonfinite(renormalize<N>(x), x[0], a[0] + b[0]);
+    }
+
+    // accurate addition: sort the 2N components by magnitude with the compile-time network
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE floatcascade<N> accurate_add(const floatcascade<N>& a, const floatcascade<N>& b) noexcept {
+        constexpr size_t P = next_power_of_two(2 * N);
+        std::array<double, P> v{};  // padding zeros sort to the end
+        for (size_t i = 0; i < N; ++i) {
+            v[2 * i] = a[i];
+            v[2 * i + 1] = b[i];
+        }
+        sort_by_magnitude(v);
+        std::array<double, 2 * N> x{};
+        for (size_t i = 0; i < 2 * N; ++i) x[i] = v[i];
+        // x[0] is the largest input, not the sum, so probe the renormalized leading term: two finite
+        // operands can overflow
+        floatcascade<N> r = renormalize<N>(x);
+        return guard_nonfinite(r, r[0], a[0] + b[0]);
+    }
+
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE floatcascade<N> accurate_sub(const floatcascade<N>& a, const floatcascade<N>& b) noexcept {
+        floatcascade<N> nb;
+        for (size_t i = 0; i < N; ++i) nb[i] = -b[i];
+        return accurate_add(a, nb);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // multiplication
+
+    // Partial products a_i*b_j are grouped by order k = i+j. Orders 0..N-2 are accumulated
+    // error-free: the product errors and the two_sum errors of order k move down to order k+1.
+    // Order N-1 keeps its product errors but sums in plain arithmetic, and order N (products and
+    // the errors of order N-1) is a plain sum: both only perturb the last component.
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE floatcascade<N> multiply(const floatcascade<N>& a, const floatcascade<N>& b) noexcept {
+        static_assert(N >= 2 && N <= 4, "cascade networks are derived for 2, 3 and 4 components");
+        // worst case terms per order for N = 4: order 3 has 4 products, 3 product errors, 6 sum errors
+        constexpr size_t CAPACITY = 2 * N * N;
+        std::array<std::array<double, CAPACITY>, N + 1> term{};
+        std::array<size_t, N + 1> count{};
+
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = 0; i + j < N; ++j) {
+                size_t k = i + j;
+                double p{}, e{};
+                two_prod(a[i], b[j], p, e);
+                term[k][count[k]++] = p;
+                term[k + 1][count[k + 1]++] = e;
+            }
+            if (i >= 1) {
+                size_t j = N - i;
+                term[N][count[N]++] = a[i] * b[j];
+            }
+        }
+
+        std::array<double, N + 1> order{};
+        for (size_t k = 0; k + 1 < N; ++k) {
+            double s = term[k][0];
+            for (size_t t = 1; t < count[k]; ++t) {
+                double e{};
+                two_sum(s, term[k][t], s, e);
+                term[k + 1][count[k + 1]++] = e;
+            }
+            order[k] = s;
+        }
+        for (size_t k = N - 1; k <= N; ++k) {
+            double s = term[k][0];
+            for (size_t t = 1; t < count[k]; ++t) s += term[k][t];
+            order[k] = s;
+        }
+
+        return guard_nonfinite(renormalize<N>(order), order[0], a[0] * b[0]);
+    }
+
+    // scale a cascade by a double: the N products and their errors, interleaved by magnitude
+    template<size_t N>
+    UNIVERSAL_KERNEL_INLINE floatcascade<N> multiply(const floatcascade<N>& a, double b) noexcept {
+        std::array<double, 2 * N> x{};
+        for (size_t i = 0; i < N; ++i) {
+            double p{}, e{};
+            two_prod(a[i], b, p, e);
+            x[2 * i] = p;
+            x[2 * i + 1] = e;
+        }
+        return guard_nonfinite(renormalize<N>(x), x[0], a[0] * b);
+    }
+
+} // namespace cascade_network
+
+} // namespace sw::universal
@@ -0,0 +1,223 @@
+#pragma once
+// cascade_vector.hpp: structure-of-arrays container and bulk kernels for floatcascade<N> based types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// A std::vector<td_cascade> interleaves the components of each element: c0 c1 c2 c0 c1 c2 ...
+// The bulk kernels below operate on the same component of consecutive elements, so the natural
+// layout is one contiguous array per component: c0 c0 c0 ... | c1 c1 c1 ... | c2 c2 c2 ...
+// That lets a compiler keep one element per vector lane through the unrolled cascade networks.
+//
+// cascade_vector<N> owns that layout. It converts to and from std::vector of any type that
+// wraps a floatcascade<N> (dd_cascade, td_cascade, qd_cascade) and offers the element-wise
+// kernels add, sub, mul, scale, axpy and a dot product, all built on cascade_network.hpp.
+// add, sloppy_add, sub and mul select an ISA-specific variant at run time (hw/dispatch.hpp).
+//
+// Usage:
+//   std::vector<td_cascade> x = ..., y = ...;
+//   cascade_vector<3> X(x), Y(y), Z(x.size());
+//   add(X, Y, Z);                        // Z = X + Y, accurate addition
+//   td_cascade d(dot(X, Y));             // floatcascade<3> -> td_cascade
+//   std::vector<td_cascade> z = Z.template to_vector<td_cascade>();
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <universal/hw/dispatch.hpp>
+#include <universal/internal/floatcascade/cascade_network.hpp>
+
+namespace sw::universal {
+
+template<size_t N>
+class cascade_vector {
+public:
+    cascade_vector() = default;
+    explicit cascade_vector(size_t n) { resize(n); }
+
+    // gather from a vector of cascade-based values: floatcascade<N>, dd_cascade, td_cascade, qd_cascade
+    template<typename CascadeType>
+    explicit cascade_vector(const std::vector<CascadeType>& v) {
+        resize(v.size());
+        for (size_t i = 0; i < v.size(); ++i) set(i, floatcascade<N>(v[i]));
+    }
+
+    void resize(size_t n) {
+        for (auto& limb : _limbs) limb.resize(n);
+    }
+
+    size_t size() const noexcept { return _limbs[0].size(); }
+
+    // component c of all elements, contiguous
+    double* limb(size_t c) noexcept { return _limbs[c].data(); }
+    const double* limb(size_t c) const noexcept { return _limbs[c].data(); }
+
+    floatcascade<N> get(size_t i) const noexcept {
+        floatcascade<N> v;
+        for (size_t c = 0; c < N; ++c) v[c] = _limbs[c][i];
+        return v;
+    }
+    void set(size_t i, const floatcascade<N>& v) noexcept {
+        for (size_t c = 0; c < N; ++c) _limbs[c][i] = v[c];
+    }
+    floatcascade<N> operator[](size_t i) const noexcept { return get(i); }
+
+    // scatter back into an array-of-structures vector
+    template<typename CascadeType>
+    std::vector<CascadeType> to_vector() const {
+        std::vector<CascadeType> v(size());
+        for (size_t i = 0; i < v.size(); ++i) v[i] = CascadeType(get(i));
+        return v;
+    }
+
+private:
+    std::array<std::vector<double>, N> _limbs;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// bulk kernels
+
+// the element loop body: load one element from each limb array, apply the network, store
+namespace cascade_network {
+
+    template<size_t N, typename Network>
+    UNIVERSAL_KERNEL_INLINE void elementwise(const double* const* xs, const double* const* ys, double* const* zs, size_t n, Network&& op) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            floatcascade<N> a, b;
+            for (size_t c = 0; c < N; ++c) {
+                a[c] = xs[c][i];
+                b[c] = ys[c][i];
+            }
+            floatcascade<N> r = op(a, b);
+            for (size_t c = 0; c < N; ++c) zs[c][i] = r[c];
+        }
+    }
+
+    template<size_t N, typename Network>
+    inline void transform(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z, Network&& op) noexcept {
+        assert(x.size() == y.size() && x.size() == z.size());
+        std::array<const double*, N> xs{}, ys{};
+        std::array<double*, N> zs{};
+        for (size_t c = 0; c < N; ++c) {
+            xs[c] = x.limb(c);
+            ys[c] = y.limb(c);
+            zs[c] = z.limb(c);
+        }
+        elementwise<N>(xs.data(), ys.data(), zs.data(), x.size(), op);
+    }
+
+    // The element-wise kernels are multiversioned (hw/dispatch.hpp): the same loop is compiled for
+    // the baseline, AVX2 and AVX-512, and the widest variant the host supports runs.
+    struct add_network {
+        template<size_t N>
+        UNIVERSAL_KERNEL_INLINE floatcascade<N> operator()(const floatcascade<N>& a, const floatcascade<N>& b) const noexcept { return accurate_add(a, b); }
+    };
+    struct sloppy_add_network {
+        template<size_t N>
+        UNIVERSAL_KERNEL_INLINE floatcascade<N> operator()(const floatcascade<N>& a, const floatcascade<N>& b) const noexcept { return sloppy_add(a, b); }
+    };
+    struct sub_network {
+        template<size_t N>
+        UNIVERSAL_KERNEL_INLINE floatcascade<N> operator()(const floatcascade<N>& a, const floatcascade<N>& b) const noexcept { return accurate_sub(a, b); }
+    };
+    struct mul_network {
+        template<size_t N>
+        UNIVERSAL_KERNEL_INLINE floatcascade<N> operator()(const floatcascade<N>& a, const floatcascade<N>& b) const noexcept { return multiply(a, b); }
+    };
+
+    using elementwise_kernel = void(const double* const*, const double* const*, double* const*, size_t);
+
+    template<size_t N, typename Network>
+    void elementwise_scalar(const double* const* xs, const double* const* ys, double* const* zs, size_t n) noexcept {
+        elementwise<N>(xs, ys, zs, n, Network{});
+    }
+    template<size_t N, typename Network>
+    UNIVERSAL_TARGET_AVX2 void elementwise_avx2(const double* const* xs, const double* const* ys, double* const* zs, size_t n) noexcept {
+        elementwise<N>(xs, ys, zs, n, Network{});
+    }
+    template<size_t N, typename Network>
+    UNIVERSAL_TARGET_AVX512 void elementwise_avx512(const double* const* xs, const double* const* ys, double* const* zs, size_t n) noexcept {
+        elementwise<N>(xs, ys, zs, n, Network{});
+    }
+
+    template<size_t N, typename Network>
+    const kernel_table<elementwise_kernel>& elementwise_kernels() noexcept {
+        static const kernel_table<elementwise_kernel> table = [] {
+            kernel_table<elementwise_kernel> t(elementwise_scalar<N, Network>);
+            t.register_kernel(isa::avx2, elementwise_avx2<N, Network>);
+            t.register_kernel(isa::avx512, elementwise_avx512<N, Network>);
+            return t;
+        }();
+        return table;
+    }
+
+    template<size_t N, typename Network>
+    inline void dispatch(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) noexcept {
+        assert(x.size() == y.size() && x.size() == z.size());
+        std::array<const double*, N> xs{}, ys{};
+        std::array<double*, N> zs{};
+        for (size_t c = 0; c < N; ++c) {
+            xs[c] = x.limb(c);
+            ys[c] = y.limb(c);
+            zs[c] = z.limb(c);
+        }
+        elementwise_kernels<N, Network>().resolve()(xs.data(), ys.data(), zs.data(), x.size());
+    }
+
+} // namespace cascade_network
+
+// z = x + y
+template<size_t N>
+inline void add(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) noexcept {
+    cascade_network::dispatch<N, cascade_network::add_network>(x, y, z);
+}
+
+// z = x + y, sloppy addition: faster, loses accuracy when elements cancel in their leading components
+template<size_t N>
+inline void sloppy_add(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) noexcept {
+    cascade_network::dispatch<N, cascade_network::sloppy_add_network>(x, y, z);
+}
+
+// z = x - y
+template<size_t N>
+inline void sub(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) noexcept {
+    cascade_network::dispatch<N, cascade_network::sub_network>(x, y, z);
+}
+
+// z = x * y
+template<size_t N>
+inline void mul(const cascade_vector<N>& x, const cascade_vector<N>& y, cascade_vector<N>& z) noexcept {
+    cascade_network::dispatch<N, cascade_network::mul_network>(x, y, z);
+}
+
+// y = alpha * x + y
+template<size_t N>
+inline void axpy(const floatcascade<N>& alpha, const cascade_vector<N>& x, cascade_vector<N>& y) noexcept {
+    cascade_network::transform(x, y, y, [&alpha](const floatcascade<N>& a, const floatcascade<N>& b) {
+        return cascade_network::accurate_add(cascade_network::multiply(alpha, a), b);
+    });
+}
+
+// x = alpha * x, alpha a double
+template<size_t N>
+inline void scale(double alpha, cascade_vector<N>& x) noexcept {
+    const size_t n = x.size();
+    for (size_t i = 0; i < n; ++i) x.set(i, cascade_network::multiply(x.get(i), alpha));
+}
+
+// dot product, accumulated in the cascade format
+template<size_t N>
+inline floatcascade<N> dot(const cascade_vector<N>& x, const cascade_vector<N>& y) noexcept {
+    assert(x.size() == y.size());
+    floatcascade<N> sum;
+    const size_t n = x.size();
+    for (size_t i = 0; i < n; ++i) {
+        sum = cascade_network::accurate_add(sum, cascade_network::multiply(x.get(i), y.get(i)));
+    }
+    return sum;
+}
+
+} // namespace sw::universal
@@ -0,0 +1,298 @@
+#pragma once
+// function_table.hpp: exhaustive, once-rounded function tables for narrow number types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The elementary functions of cfloat, posit, lns and takum convert the argument to double, call
+// libm and convert the result back. A type of at most 16 bits has at most 65536 arguments, so a
+// function over the whole domain fits in a table indexed by the encoding of the argument.
+// function_table<T, Fn> is that table:
+//
+//   - every entry is Fn evaluated in long double on the value of the encoding and rounded to T.
+//     A type that rounds a long double at long double precision, cfloat, posit and lns, converts
+//     the reference directly, so its own rounding decides every boundary, the geometric ones of
+//     posit regimes and lns included, and a result beyond double saturates by the type's rules.
+//     Other types convert the reference rounded to double, with the long double residual deciding
+//     the cases where that double is the midpoint of two values of T; a geometric boundary that
+//     falls between the reference and its double, as in takum, is misrounded. Where long double
+//     is double (MSVC, ARM64 macOS) the entries equal T(Fn(double(x))), which is what the scalar
+//     functions compute, except where a scalar function clamps an underflowing double to minpos:
+//     the table applies T's own rounding instead.
+//   - tables of types of at most 8 bits are held inline in a std::array; wider tables in a vector.
+//     Both are built on first use, thread-safe, and shared by all callers.
+//   - when the environment variable UNIVERSAL_FUNCTION_TABLE_CACHE names a directory, tables of
+//     types wider than 8 bits are read from, or written to, a number_array file in it, so a sweep
+//     over many processes builds each table once.
+//   - emit_function_table() writes a table as a constexpr array of encodings, for sources that
+//     need it at compile time.
+//
+// apply<Fn>(x, y) evaluates Fn over a whole array with one load per element.
+//
+// Usage:
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/math/function_table.hpp>
+//
+//   std::vector<posit<16,1>> x(n), y(n);
+//   apply<tabulated::tanh>(std::span<const posit<16,1>>(x), std::span<posit<16,1>>(y));
+//   posit<16,1> s = function_table<posit<16,1>, tabulated::sigmoid>::instance()(x[0]);
+//
+// A function tag is any type with a static name and a static long double eval(long double).
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <universal/number/convert/convert_span.hpp>
+#include <universal/utility/number_array.hpp>
+
+namespace sw { namespace universal {
+
+////////////////////////////////////////////////////////////////////
+// function tags
+
+namespace tabulated {
+
+	// functions that are positive everywhere: a result that underflows long double is kept nonzero,
+	// so types that do not round to zero, posit and lns, tabulate minpos as their scalar exp does
+	inline long double positive(long double v) { return v == 0.0L ? std::numeric_limits<long double>::denorm_min() : v; }
+
+	struct sin   { static constexpr const char* name = "sin";   static long double eval(long double x) { return std::sin(x); } };
+	struct cos   { static constexpr const char* name = "cos";   static long double eval(long double x) { return std::cos(x); } };
+	struct tan   { static constexpr const char* name = "tan";   static long double eval(long double x) { return std::tan(x); } };
+	struct asin  { static constexpr const char* name = "asin";  static long double eval(long double x) { return std::asin(x); } };
+	struct acos  { static constexpr const char* name = "acos";  static long double eval(long double x) { return std::acos(x); } };
+	struct atan  { static constexpr const char* name = "atan";  static long double eval(long double x) { return std::atan(x); } };
+	struct sinh  { static constexpr const char* name = "sinh";  static long double eval(long double x) { return std::sinh(x); } };
+	struct cosh  { static constexpr const char* name = "cosh";  static long double eval(long double x) { return std::cosh(x); } };
+	struct tanh  { static constexpr const char* name = "tanh";  static long double eval(long double x) { return std::tanh(x); } };
+	struct asinh { static constexpr const char* name = "asinh"; static long double eval(long double x) { return std::asinh(x); } };
+	struct acosh { static constexpr const char* name = "acosh"; static long double eval(long double x) { return std::acosh(x); } };
+	struct atanh { static constexpr const char* name = "atanh"; static long double eval(long double x) { return std::atanh(x); } };
+	struct exp   { static constexpr const char* name = "exp";   static long double eval(long double x) { return positive(std::exp(x)); } };
+	struct exp2  { static constexpr const char* name = "exp2";  static long double eval(long double x) { return positive(std::exp2(x)); } };
+	struct expm1 { static constexpr const char* name = "expm1"; static long double eval(long double x) { return std::expm1(x); } };
+	struct log   { static constexpr const char* name = "log";   static long double eval(long double x) { return std::log(x); } };
+	struct log2  { static constexpr const char* name = "log2";  static long double eval(long double x) { return std::log2(x); } };
+	struct log10 { static constexpr const char* name = "log10"; static long double eval(long double x) { return std::log10(x); } };
+	struct log1p { static constexpr const char* name = "log1p"; static long double eval(long double x) { return std::log1p(x); } };
+	struct sqrt  { static constexpr const char* name = "sqrt";  static long double eval(long double x) { return std::sqrt(x); } };
+	struct cbrt  { static constexpr const char* name = "cbrt";  static long double eval(long double x) { return std::cbrt(x); } };
+	struct erf   { static constexpr const char* name = "erf";   static long double eval(long double x) { return std::erf(x); } };
+	struct erfc  { static constexpr const char* name = "erfc";  static long double eval(long double x) { return positive(std::erfc(x)); } };
+
+	// activation functions
+	struct sigmoid  { static constexpr const char* name = "sigmoid";  static long double eval(long double x) { return positive(1.0L / (1.0L + std::exp(-x))); } };
+	struct silu     { static constexpr const char* name = "silu";     static long double eval(long double x) { return x / (1.0L + std::exp(-x)); } };
+	struct softplus { static constexpr const char* name = "softplus"; static long double eval(long double x) { return positive(x > 0.0L ? x + std::log1p(std::exp(-x)) : std::log1p(std::exp(x))); } };
+	struct gelu     { static constexpr const char* name = "gelu";     static long double eval(long double x) { return 0.5L * x * std::erfc(-x / std::sqrt(2.0L)); } };
+
+} // namespace tabulated
+
+template<typename Fn>
+concept TabulatedFunction = requires(long double x) {
+	{ Fn::name } -> std::convertible_to<const char*>;
+	{ Fn::eval(x) } -> std::convertible_to<long double>;
+};
+
+template<typename T>
+inline constexpr bool function_table_available_v = detail::NarrowEncodedNumber<T>;
+
+namespace detail {
+
+	// true when T rounds a long double at long double precision instead of narrowing it to double.
+	// Probed once at the boundary between one and the next value up, which is the arithmetic
+	// midpoint for cfloat and posit and the geometric one for lns: two long doubles straddling it
+	// that round to the same double convert to different values only when T sees the extra bits.
+	template<typename T>
+	bool converts_long_double() {
+		static const bool precise = [] {
+			if constexpr (std::numeric_limits<long double>::digits <= std::numeric_limits<double>::digits
+			              || !std::is_constructible_v<T, long double> || !std::is_constructible_v<long double, T>) {
+				return false;
+			}
+			else {
+				T one(1.0), next{};
+				next.setbits(encoding_of(one) + 1);
+				long double a = static_cast<long double>(one), b = static_cast<long double>(next);
+				if (!(b > a)) return false;
+				for (long double boundary : { (a + b) / 2.0L, std::sqrt(a * b) }) {
+					long double below = boundary - std::ldexp(boundary, -60), above = boundary + std::ldexp(boundary, -60);
+					if (static_cast<double>(below) != static_cast<double>(above)) continue;
+					if (encoding_of(T(below)) != encoding_of(T(above))) return true;
+				}
+				return false;
+			}
+		}();
+		return precise;
+	}
+
+	// Fn(x) rounded once to T. When T rounds a long double itself, the long double reference y is
+	// converted directly, so every boundary, arithmetic or geometric, is decided by T's own rounding.
+	// Otherwise y is rounded to double and converted. When that double yd is exactly the midpoint of
+	// two neighbouring values of T, its own tie rule may pick the wrong neighbour for y, which lies
+	// off the midpoint: the neighbour on the side of y is taken instead. A boundary that is not the
+	// midpoint of two doubles, such as the geometric ones of takum, is decided by yd, which may sit
+	// on the other side of it than y.
+	template<typename T, typename Fn>
+	T tabulate_entry(const T& x) {
+		long double y = Fn::eval(static_cast<long double>(double(x)));
+		if (converts_long_double<T>()) return T(y);
+		double yd = static_cast<double>(y);
+		if (yd == 0.0 && y != 0.0L) {  // underflows double: T's own rounding of the smallest double of that sign
+			return T(std::signbit(y) ? -std::numeric_limits<double>::denorm_min() : std::numeric_limits<double>::denorm_min());
+		}
+		T r(yd);
+		if (!std::isfinite(yd) || static_cast<long double>(yd) == y) return r;
+		double toward = (y > static_cast<long double>(yd)) ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+		T s(std::nextafter(yd, toward));
+		if (encoding_of(s) == encoding_of(r)) return r;
+		long double midpoint = (static_cast<long double>(double(r)) + static_cast<long double>(double(s))) / 2.0L;
+		return (midpoint == static_cast<long double>(yd)) ? s : r;
+	}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////
+// function_table: Fn over every encoding of a narrow T
+
+template<typename T, TabulatedFunction Fn>
+	requires function_table_available_v<T>
+class function_table {
+public:
+	static constexpr std::size_t nrEntries = std::size_t(1) << T::nbits;
+	static constexpr bool        inlineStorage = (T::nbits <= 8);
+
+	// the table for the pair, built, or read from the cache directory, on first use
+	static const function_table& instance() {
+		static const function_table table;
+		return table;
+	}
+
+	const T& operator[](std::uint64_t encoding) const noexcept { return _entries[encoding]; }
+	T operator()(const T& x) const noexcept { return _entries[detail::encoding_of(x)]; }
+	std::size_t size() const noexcept { return nrEntries; }
+	const T* data() const noexcept { return _entries.data(); }
+
+	// true when the entries came from a cache file instead of being evaluated
+	bool cached() const noexcept { return _cached; }
+
+	// write the table as a number_array file; throws number_array_error on I/O failure
+	void save(const std::string& path) const {
+		number_array_writer<T> out(path);
+		out.append(std::span<const T>(_entries.data(), nrEntries));
+	}
+
+	// cache file name that identifies the type and the function
+	static std::string cache_file_name() {
+		std::string name = number_array_detail::tag_of<T>() + '_' + Fn::name + ".unv";
+		for (char& c : name) {
+			if (c == '<' || c == '>' || c == ',' || c == ' ' || c == ':') c = '_';
+		}
+		return name;
+	}
+
+private:
+	using storage_type = std::conditional_t<inlineStorage, std::array<T, (inlineStorage ? nrEntries : 1)>, std::vector<T>>;
+
+	function_table() {
+		if constexpr (!inlineStorage) {
+			_entries.resize(nrEntries);
+			const char* dir = std::getenv("UNIVERSAL_FUNCTION_TABLE_CACHE");
+			if (dir != nullptr && *dir != '\0') {
+				std::string path(dir);
+				if (path.back() != '/' && path.back() != '\\') path += '/';
+				path += cache_file_name();
+				if (load(path)) return;
+				generate();
+				try { save(path); } catch (const number_array_error&) {}  // an unwritable cache is not an error
+				return;
+			}
+		}
+		generate();
+	}
+
+	void generate() {
+		T x{};
+		for (std::size_t i = 0; i < nrEntries; ++i) {
+			x.setbits(i);
+			_entries[i] = detail::tabulate_entry<T, Fn>(x);
+		}
+	}
+
+	bool load(const std::string& path) {
+		try {
+			number_array_reader in(path);
+			if (!in.holds<T>() || in.size() != nrEntries) return false;
+			std::vector<T> entries = in.read<T>();
+			for (std::size_t i = 0; i < nrEntries; ++i) _entries[i] = entries[i];
+			_cached = true;
+			return true;
+		}
+		catch (const number_array_error&) {
+			return false;
+		}
+	}
+
+	storage_type _entries{};
+	bool         _cached = false;
+};
+
+////////////////////////////////////////////////////////////////////
+// apply: y[i] = Fn(x[i]) for i < x.size()
+
+template<TabulatedFunction Fn, typename T>
+	requires function_table_available_v<T>
+inline void apply(std::span<const T> x, std::span<T> y) {
+	assert(y.size() >= x.size());
+	const function_table<T, Fn>& table = function_table<T, Fn>::instance();
+	const std::size_t n = x.size();
+	for (std::size_t i = 0; i < n; ++i) y[i] = table[detail::encoding_of(x[i])];
+}
+
+// in place
+template<TabulatedFunction Fn, typename T>
+	requires function_table_available_v<T>
+inline void apply(std::span<T> x) {
+	const function_table<T, Fn>& table = function_table<T, Fn>::instance();
+	for (T& v : x) v = table[detail::encoding_of(v)];
+}
+
+// convenience overload for std::vector, sizing the destination
+template<TabulatedFunction Fn, typename T>
+	requires function_table_available_v<T>
+inline void apply(const std::vector<T>& x, std::vector<T>& y) {
+	y.resize(x.size());
+	apply<Fn>(std::span<const T>(x), std::span<T>(y));
+}
+
+////////////////////////////////////////////////////////////////////
+// emit_function_table: the table as C++ source, a constexpr array of result encodings
+
+template<typename T, TabulatedFunction Fn>
+	requires function_table_available_v<T>
+void emit_function_table(std::ostream& os, const std::string& arrayName) {
+	using Word = std::conditional_t<(T::nbits <= 8), std::uint8_t, std::uint16_t>;
+	const function_table<T, Fn>& table = function_table<T, Fn>::instance();
+	os << "// " << Fn::name << " over every encoding of " << number_array_detail::tag_of<T>() << ", indexed by the argument encoding\n";
+	os << "constexpr std::" << (sizeof(Word) == 1 ? "uint8_t " : "uint16_t ") << arrayName << '[' << table.size() << "] = {";
+	for (std::size_t i = 0; i < table.size(); ++i) {
+		if (i % 16 == 0) os << "\n\t";
+		os << "0x" << std::hex << std::setw(2 * sizeof(Word)) << std::setfill('0') << detail::encoding_of(table[i]) << std::dec << std::setfill(' ');
+		if (i + 1 < table.size()) os << (i % 16 == 15 ? "," : ", ");
+	}
+	os << "\n};\n";
+}
+
+}} // namespace sw::universal
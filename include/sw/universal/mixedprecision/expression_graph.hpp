@@ -63,6 +63,71 @@ inline const char* to_string(OpKind op) {
 	}
 }
 
+// Forward transfer: nsb of the result of op given its operand precisions.
+// Leaves and unknown operators return the current value unchanged.
+inline int pop_forward_nsb(OpKind op, const precision_info& lp, const precision_info& rp, int ufp_z, int carry, int current) {
+	switch (op) {
+	case OpKind::Neg:
+	case OpKind::Abs:
+		return lp.nsb;
+	case OpKind::Sqrt:
+		return forward_sqrt(lp, ufp_z, carry).nsb;
+	case OpKind::Add:
+		return forward_add(lp, rp, ufp_z, carry).nsb;
+	case OpKind::Sub:
+		return forward_sub(lp, rp, ufp_z, carry).nsb;
+	case OpKind::Mul:
+		return forward_mul(lp, rp, ufp_z, carry).nsb;
+	case OpKind::Div:
+		return forward_div(lp, rp, ufp_z, carry).nsb;
+	default:
+		return current;
+	}
+}
+
+// Backward transfer: nsb demanded from an input of a consumer z = op(...)
+// that needs nsb_z significant bits
+inline int pop_backward_demand(OpKind op, int nsb_z, int ufp_z, int ufp_in, bool is_lhs, int carry) {
+	if (nsb_z <= 0) return 0;
+
+	switch (op) {
+	case OpKind::Add:
+		return is_lhs ? backward_add_lhs(nsb_z, ufp_z, ufp_in, carry) : backward_add_rhs(nsb_z, ufp_z, ufp_in, carry);
+	case OpKind::Sub:
+		return is_lhs ? backward_sub_lhs(nsb_z, ufp_z, ufp_in, carry) : backward_sub_rhs(nsb_z, ufp_z, ufp_in, carry);
+	case OpKind::Mul:
+		return is_lhs ? backward_mul_lhs(nsb_z, carry) : backward_mul_rhs(nsb_z, carry);
+	case OpKind::Div:
+		return is_lhs ? backward_div_lhs(nsb_z, carry) : backward_div_rhs(nsb_z, carry);
+	case OpKind::Neg:
+		return backward_neg(nsb_z);
+	case OpKind::Abs:
+		return backward_abs(nsb_z);
+	case OpKind::Sqrt:
+		return backward_sqrt(nsb_z, carry);
+	default:
+		return nsb_z;
+	}
+}
+
+// Finalize: combine the backward demand with the user requirement,
+// clamped by the forward-determined upper bound
+inline int pop_finalize_nsb(OpKind op, int nsb_forward, int nsb_backward, int nsb_required) {
+	int nsb = nsb_backward;
+	if (nsb_required > 0) {
+		nsb = std::max(nsb, nsb_required);
+	}
+	// Clamp: can't exceed the forward-determined upper bound
+	if (nsb_forward > 0 && nsb > nsb_forward) {
+		nsb = nsb_forward;
+	}
+	// Minimum 1 bit for any non-constant
+	if (nsb < 1 && op != OpKind::Constant) {
+		nsb = 1;
+	}
+	return nsb;
+}
+
 struct ExprNode {
 	OpKind op;
 	int id;
@@ -186,18 +251,7 @@ public:
 
 		// Finalize: nsb_final = max(nsb_forward_demand, nsb_backward)
 		for (auto& node : nodes_) {
-			node.nsb_final = node.nsb_backward;
-			if (node.nsb_required > 0) {
-				node.nsb_final = std::max(node.nsb_final, node.nsb_required);
-			}
-			// Clamp: can't exceed the forward-determined upper bound
-			if (node.nsb_forward > 0 && node.nsb_final > node.nsb_forward) {
-				node.nsb_final = node.nsb_forward;
-			}
-			// Minimum 1 bit for any non-constant
-			if (node.nsb_final < 1 && node.op != OpKind::Constant) {
-				node.nsb_final = 1;
-			}
+			node.nsb_final = pop_finalize_nsb(node.op, node.nsb_forward, node.nsb_backward, node.nsb_required);
 		}
 	}
 
@@ -410,56 +464,14 @@ private:
 
 		if (node.lhs < 0) return;
 
-		auto& l = nodes_[static_cast<size_t>(node.lhs)];
-
-		if (node.rhs < 0) {
-			// Unary operation
-			switch (node.op) {
-			case OpKind::Neg:
-			case OpKind::Abs:
-				node.nsb_forward = l.nsb_forward;
-				break;
-			case OpKind::Sqrt: {
-				auto pi = forward_sqrt({l.ufp, l.nsb_forward}, node.ufp, node.carry);
-				node.nsb_forward = pi.nsb;
-				break;
-			}
-			default:
-				node.nsb_forward = l.nsb_forward;
-				break;
-			}
-			return;
-		}
-
-		auto& r = nodes_[static_cast<size_t>(node.rhs)];
-
+		const auto& l = nodes_[static_cast<size_t>(node.lhs)];
 		precision_info lp{l.ufp, l.nsb_forward};
-		precision_info rp{r.ufp, r.nsb_forward};
-
-		switch (node.op) {
-		case OpKind::Add: {
-			auto pi = forward_add(lp, rp, node.ufp, node.carry);
-			node.nsb_forward = pi.nsb;
-			break;
-		}
-		case OpKind::Sub: {
-			auto pi = forward_sub(lp, rp, node.ufp, node.carry);
-			node.nsb_forward = pi.nsb;
-			break;
-		}
-		case OpKind::Mul: {
-			auto pi = forward_mul(lp, rp, node.ufp, node.carry);
-			node.nsb_forward = pi.nsb;
-			break;
-		}
-		case OpKind::Div: {
-			auto pi = forward_div(lp, rp, node.ufp, node.carry);
-			node.nsb_forward = pi.nsb;
-			break;
-		}
-		default:
-			break;
+		precision_info rp{0, 0};
+		if (node.rhs >= 0) {
+			const auto& r = nodes_[static_cast<size_t>(node.rhs)];
+			rp = precision_info{r.ufp, r.nsb_forward};
 		}
+		node.nsb_forward = pop_forward_nsb(node.op, lp, rp, node.ufp, node.carry, node.nsb_forward);
 	}
 
 	void compute_backward(ExprNode& node) {
@@ -480,45 +492,9 @@ private:
 	}
 
 	int compute_backward_demand(const ExprNode& consumer, int input_id) const {
-		int nsb_z = consumer.nsb_backward;
-		if (nsb_z <= 0) return 0;
-
 		bool is_lhs = (consumer.lhs == input_id);
-
-		switch (consumer.op) {
-		case OpKind::Add:
-			if (is_lhs) {
-				return backward_add_lhs(nsb_z, consumer.ufp, nodes_[static_cast<size_t>(input_id)].ufp, consumer.carry);
-			} else {
-				return backward_add_rhs(nsb_z, consumer.ufp, nodes_[static_cast<size_t>(input_id)].ufp, consumer.carry);
-			}
-		case OpKind::Sub:
-			if (is_lhs) {
-				return backward_sub_lhs(nsb_z, consumer.ufp, nodes_[static_cast<size_t>(input_id)].ufp, consumer.carry);
-			} else {
-				return backward_sub_rhs(nsb_z, consumer.ufp, nodes_[static_cast<size_t>(input_id)].ufp, consumer.carry);
-			}
-		case OpKind::Mul:
-			if (is_lhs) {
-				return backward_mul_lhs(nsb_z, consumer.carry);
-			} else {
-				return backward_mul_rhs(nsb_z, consumer.carry);
-			}
-		case OpKind::Div:
-			if (is_lhs) {
-				return backward_div_lhs(nsb_z, consumer.carry);
-			} else {
-				return backward_div_rhs(nsb_z, consumer.carry);
-			}
-		case OpKind::Neg:
-			return backward_neg(nsb_z);
-		case OpKind::Abs:
-			return backward_abs(nsb_z);
-		case OpKind::Sqrt:
-			return backward_sqrt(nsb_z, consumer.carry);
-		default:
-			return nsb_z;
-		}
+		return pop_backward_demand(consumer.op, consumer.nsb_backward, consumer.ufp,
+		                           nodes_[static_cast<size_t>(input_id)].ufp, is_lhs, consumer.carry);
 	}
 };
 
@@ -0,0 +1,388 @@
+#pragma once
+// incremental_analysis.hpp: worklist-driven incremental precision analysis for POP
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project.
+//
+// ExprGraph::analyze() recomputes the full forward/backward fixpoint every time
+// it is called. When a precision tuner explores alternatives it typically changes
+// a single output requirement or a single carry bit, and only the nodes that are
+// reachable from that change need to be re-evaluated:
+//
+//   - a requirement change at node k affects the backward nsb of k and of its
+//     transitive operands (the ancestors of k)
+//   - a carry change at node k affects the forward nsb of k and its transitive
+//     consumers, and the backward demand k places on its operands
+//
+// IncrementalPopAnalysis snapshots an ExprGraph into a struct-of-arrays layout
+// with CSR consumer lists. Node ids of an ExprGraph are in topological order
+// (operands are always created before their consumers), so the forward worklist
+// is processed in increasing id order and the backward worklist in decreasing
+// id order: every node is evaluated at most once per propagation.
+//
+// Weakly connected components of the DAG share no state, so full analysis and
+// propagation can evaluate independent subgraphs on separate threads.
+//
+// The transfer functions are the same as ExprGraph's (pop_forward_nsb,
+// pop_backward_demand, pop_finalize_nsb), so results are identical to analyze().
+//
+// Usage:
+//   IncrementalPopAnalysis ia(graph);
+//   ia.analyze();                 // full evaluation
+//   ia.require_nsb(out, 24);      // queue a change
+//   ia.propagate();               // re-evaluate only the affected nodes
+//   ia.write_back(graph);         // publish nsb values to the ExprGraph
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <cassert>
+
+#include <universal/mixedprecision/expression_graph.hpp>
+
+namespace sw { namespace universal {
+
+class IncrementalPopAnalysis {
+public:
+	// leaves start with double precision as the default source precision, as in ExprGraph::analyze()
+	static constexpr int default_source_nsb = 53;
+
+	IncrementalPopAnalysis() = default;
+	explicit IncrementalPopAnalysis(const ExprGraph& graph, int source_nsb = default_source_nsb) {
+		load(graph, source_nsb);
+	}
+
+	// ================================================================
+	// Graph snapshot
+	// ================================================================
+
+	// Build the struct-of-arrays snapshot of the graph: all analysis state is reset
+	void load(const ExprGraph& graph, int source_nsb = default_source_nsb) {
+		const auto& nodes = graph.nodes();
+		size_t n = nodes.size();
+		source_nsb_ = source_nsb;
+
+		op_.resize(n);
+		lhs_.resize(n);
+		rhs_.resize(n);
+		ufp_.resize(n);
+		carry_.resize(n);
+		required_.resize(n);
+		fwd_.assign(n, 0);
+		bwd_.assign(n, 0);
+		fin_.assign(n, 0);
+
+		consumer_offset_.assign(n + 1, 0);
+		for (size_t i = 0; i < n; ++i) {
+			const auto& node = nodes[i];
+			assert(node.lhs < static_cast<int>(i) && node.rhs < static_cast<int>(i));
+			op_[i] = node.op;
+			lhs_[i] = node.lhs;
+			rhs_[i] = node.rhs;
+			ufp_[i] = node.ufp;
+			carry_[i] = node.carry;
+			required_[i] = node.nsb_required;
+			consumer_offset_[i + 1] = consumer_offset_[i] + static_cast<int>(node.consumers.size());
+		}
+		consumers_.resize(static_cast<size_t>(consumer_offset_[n]));
+		for (size_t i = 0; i < n; ++i) {
+			std::copy(nodes[i].consumers.begin(), nodes[i].consumers.end(),
+			          consumers_.begin() + consumer_offset_[i]);
+		}
+
+		build_components();
+
+		fwd_queued_.assign(n, 0);
+		bwd_queued_.assign(n, 0);
+		pending_fwd_.clear();
+		pending_bwd_.clear();
+		analyzed_ = false;
+	}
+
+	// ================================================================
+	// Analysis
+	// ================================================================
+
+	// Full evaluation of all nodes: independent subgraphs are distributed over nrThreads
+	void analyze(unsigned nrThreads = 1) {
+		for_each_component(nrThreads, [this](int c) {
+			const int* first = component_nodes_.data() + component_offset_[static_cast<size_t>(c)];
+			const int* last  = component_nodes_.data() + component_offset_[static_cast<size_t>(c) + 1];
+			for (const int* p = first; p != last; ++p) {
+				size_t i = static_cast<size_t>(*p);
+				fwd_[i] = is_leaf(i) ? source_nsb_ : evaluate_forward(i);
+			}
+			for (const int* p = last; p != first; ) {
+				--p;
+				bwd_[static_cast<size_t>(*p)] = evaluate_backward(static_cast<size_t>(*p));
+			}
+			for (const int* p = first; p != last; ++p) {
+				size_t i = static_cast<size_t>(*p);
+				fin_[i] = pop_finalize_nsb(op_[i], fwd_[i], bwd_[i], required_[i]);
+			}
+		});
+		pending_fwd_.clear();
+		pending_bwd_.clear();
+		analyzed_ = true;
+	}
+
+	// Change the requirement of a node: the ancestors of the node are re-evaluated on propagate()
+	void require_nsb(int node_id, int nsb) {
+		assert(node_id >= 0 && node_id < size());
+		size_t i = static_cast<size_t>(node_id);
+		if (required_[i] == nsb) return;
+		required_[i] = nsb;
+		pending_bwd_.push_back(node_id);
+	}
+
+	// Change the carry bit of a node: its consumers (forward) and operands (backward) are re-evaluated
+	void set_carry(int node_id, int carry) {
+		assert(node_id >= 0 && node_id < size());
+		size_t i = static_cast<size_t>(node_id);
+		if (carry_[i] == carry) return;
+		carry_[i] = carry;
+		pending_fwd_.push_back(node_id);
+		if (lhs_[i] >= 0) pending_bwd_.push_back(lhs_[i]);
+		if (rhs_[i] >= 0) pending_bwd_.push_back(rhs_[i]);
+	}
+
+	// Re-propagate the queued changes, returns the number of node evaluations performed
+	size_t propagate(unsigned nrThreads = 1) {
+		if (!analyzed_) {
+			analyze(nrThreads);
+			return static_cast<size_t>(size());
+		}
+		if (pending_fwd_.empty() && pending_bwd_.empty()) return 0;
+
+		// bucket the seeds per component
+		std::vector<std::vector<int>> fwd_seeds(static_cast<size_t>(nrOfComponents_));
+		std::vector<std::vector<int>> bwd_seeds(static_cast<size_t>(nrOfComponents_));
+		std::vector<int> dirty;
+		for (int id : pending_fwd_) fwd_seeds[static_cast<size_t>(component_[static_cast<size_t>(id)])].push_back(id);
+		for (int id : pending_bwd_) bwd_seeds[static_cast<size_t>(component_[static_cast<size_t>(id)])].push_back(id);
+		for (int c = 0; c < nrOfComponents_; ++c) {
+			if (!fwd_seeds[static_cast<size_t>(c)].empty() || !bwd_seeds[static_cast<size_t>(c)].empty()) dirty.push_back(c);
+		}
+		pending_fwd_.clear();
+		pending_bwd_.clear();
+
+		std::vector<size_t> evaluations(static_cast<size_t>(nrOfComponents_), 0);
+		for_each_of(dirty, nrThreads, [&](int c) {
+			evaluations[static_cast<size_t>(c)] = propagate_component(fwd_seeds[static_cast<size_t>(c)], bwd_seeds[static_cast<size_t>(c)]);
+		});
+		return std::accumulate(evaluations.begin(), evaluations.end(), size_t(0));
+	}
+
+	// ================================================================
+	// Results
+	// ================================================================
+
+	int get_nsb(int node_id) const { return fin_[index(node_id)]; }
+	int get_nsb_forward(int node_id) const { return fwd_[index(node_id)]; }
+	int get_nsb_backward(int node_id) const { return bwd_[index(node_id)]; }
+	int get_required(int node_id) const { return required_[index(node_id)]; }
+	int get_carry(int node_id) const { return carry_[index(node_id)]; }
+
+	int size() const { return static_cast<int>(op_.size()); }
+	int components() const { return nrOfComponents_; }
+	int component(int node_id) const { return component_[index(node_id)]; }
+
+	// Publish the analysis state back to the graph so the LP solver, carry analysis
+	// and code generator see the same values
+	void write_back(ExprGraph& graph) const {
+		auto& nodes = graph.nodes();
+		assert(nodes.size() == op_.size());
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			nodes[i].nsb_forward  = fwd_[i];
+			nodes[i].nsb_backward = bwd_[i];
+			nodes[i].nsb_final    = fin_[i];
+			nodes[i].nsb_required = required_[i];
+			nodes[i].carry        = carry_[i];
+		}
+	}
+
+private:
+	int source_nsb_{default_source_nsb};
+	bool analyzed_{false};
+
+	// struct-of-arrays node state, indexed by node id (= topological order)
+	std::vector<OpKind> op_;
+	std::vector<int> lhs_, rhs_, ufp_, carry_, required_;
+	std::vector<int> fwd_, bwd_, fin_;
+
+	// CSR consumer lists
+	std::vector<int> consumer_offset_;
+	std::vector<int> consumers_;
+
+	// weakly connected components, node lists sorted in topological order
+	int nrOfComponents_{0};
+	std::vector<int> component_;
+	std::vector<int> component_offset_;
+	std::vector<int> component_nodes_;
+
+	// worklist membership flags: one byte per node, not a std::vector<bool>, because distinct
+	// bytes are distinct memory locations in C++: threads working on different components may
+	// write flags in the same word without a data race, where bits of a shared word would race
+	std::vector<uint8_t> fwd_queued_, bwd_queued_;
+	std::vector<int> pending_fwd_, pending_bwd_;
+
+	size_t index(int node_id) const {
+		assert(node_id >= 0 && node_id < size());
+		return static_cast<size_t>(node_id);
+	}
+
+	bool is_leaf(size_t i) const {
+		return op_[i] == OpKind::Constant || op_[i] == OpKind::Variable;
+	}
+
+	int evaluate_forward(size_t i) const {
+		if (is_leaf(i)) return fwd_[i];
+		if (lhs_[i] < 0) return fwd_[i];
+		size_t l = static_cast<size_t>(lhs_[i]);
+		precision_info lp{ ufp_[l], fwd_[l] };
+		precision_info rp{ 0, 0 };
+		if (rhs_[i] >= 0) {
+			size_t r = static_cast<size_t>(rhs_[i]);
+			rp = precision_info{ ufp_[r], fwd_[r] };
+		}
+		return pop_forward_nsb(op_[i], lp, rp, ufp_[i], carry_[i], fwd_[i]);
+	}
+
+	int evaluate_backward(size_t i) const {
+		int nsb = (required_[i] > 0) ? required_[i] : 0;
+		int id = static_cast<int>(i);
+		for (int k = consumer_offset_[i]; k < consumer_offset_[i + 1]; ++k) {
+			size_t c = static_cast<size_t>(consumers_[static_cast<size_t>(k)]);
+			if (bwd_[c] <= 0) continue;
+			nsb = std::max(nsb, pop_backward_demand(op_[c], bwd_[c], ufp_[c], ufp_[i], lhs_[c] == id, carry_[c]));
+		}
+		return nsb;
+	}
+
+	// Worklist propagation confined to a single component
+	size_t propagate_component(const std::vector<int>& fwd_seeds, const std::vector<int>& bwd_seeds) {
+		size_t evaluations = 0;
+		std::vector<int> touched;
+
+		// forward: smallest id first, so operands settle before their consumers
+		std::priority_queue<int, std::vector<int>, std::greater<int>> fwd_worklist;
+		for (int id : fwd_seeds) enqueue(fwd_worklist, fwd_queued_, id);
+		while (!fwd_worklist.empty()) {
+			size_t i = static_cast<size_t>(fwd_worklist.top());
+			fwd_worklist.pop();
+			fwd_queued_[i] = 0;
+			++evaluations;
+			int nsb = evaluate_forward(i);
+			if (nsb == fwd_[i]) continue;
+			fwd_[i] = nsb;
+			touched.push_back(static_cast<int>(i));
+			for (int k = consumer_offset_[i]; k < consumer_offset_[i + 1]; ++k) {
+				enqueue(fwd_worklist, fwd_queued_, consumers_[static_cast<size_t>(k)]);
+			}
+		}
+
+		// backward: largest id first, so consumers settle before their operands
+		std::priority_queue<int> bwd_worklist;
+		for (int id : bwd_seeds) enqueue(bwd_worklist, bwd_queued_, id);
+		while (!bwd_worklist.empty()) {
+			size_t i = static_cast<size_t>(bwd_worklist.top());
+			bwd_worklist.pop();
+			bwd_queued_[i] = 0;
+			++evaluations;
+			touched.push_back(static_cast<int>(i));
+			int nsb = evaluate_backward(i);
+			if (nsb == bwd_[i]) continue;
+			bwd_[i] = nsb;
+			if (lhs_[i] >= 0) enqueue(bwd_worklist, bwd_queued_, lhs_[i]);
+			if (rhs_[i] >= 0) enqueue(bwd_worklist, bwd_queued_, rhs_[i]);
+		}
+
+		for (int id : touched) {
+			size_t i = static_cast<size_t>(id);
+			fin_[i] = pop_finalize_nsb(op_[i], fwd_[i], bwd_[i], required_[i]);
+		}
+		return evaluations;
+	}
+
+	template<typename Worklist>
+	static void enqueue(Worklist& worklist, std::vector<uint8_t>& queued, int id) {
+		if (queued[static_cast<size_t>(id)]) return;
+		queued[static_cast<size_t>(id)] = 1;
+		worklist.push(id);
+	}
+
+	// union-find over the operand edges
+	void build_components() {
+		size_t n = op_.size();
+		std::vector<int> parent(n);
+		std::iota(parent.begin(), parent.end(), 0);
+		auto find = [&parent](int x) {
+			while (parent[static_cast<size_t>(x)] != x) {
+				parent[static_cast<size_t>(x)] = parent[static_cast<size_t>(parent[static_cast<size_t>(x)])];
+				x = parent[static_cast<size_t>(x)];
+			}
+			return x;
+		};
+		auto unite = [&](int a, int b) {
+			a = find(a);
+			b = find(b);
+			if (a != b) parent[static_cast<size_t>(std::max(a, b))] = std::min(a, b);
+		};
+		for (size_t i = 0; i < n; ++i) {
+			if (lhs_[i] >= 0) unite(static_cast<int>(i), lhs_[i]);
+			if (rhs_[i] >= 0) unite(static_cast<int>(i), rhs_[i]);
+		}
+
+		component_.assign(n, -1);
+		std::vector<int> label(n, -1);
+		nrOfComponents_ = 0;
+		for (size_t i = 0; i < n; ++i) {
+			int root = find(static_cast<int>(i));
+			if (label[static_cast<size_t>(root)] < 0) label[static_cast<size_t>(root)] = nrOfComponents_++;
+			component_[i] = label[static_cast<size_t>(root)];
+		}
+
+		// counting sort by component keeps the topological order within each component
+		component_offset_.assign(static_cast<size_t>(nrOfComponents_) + 1, 0);
+		for (size_t i = 0; i < n; ++i) ++component_offset_[static_cast<size_t>(component_[i]) + 1];
+		std::partial_sum(component_offset_.begin(), component_offset_.end(), component_offset_.begin());
+		component_nodes_.resize(n);
+		std::vector<int> cursor(component_offset_.begin(), component_offset_.end() - 1);
+		for (size_t i = 0; i < n; ++i) {
+			component_nodes_[static_cast<size_t>(cursor[static_cast<size_t>(component_[i])]++)] = static_cast<int>(i);
+		}
+	}
+
+	template<typename Function>
+	void for_each_component(unsigned nrThreads, Function&& f) const {
+		std::vector<int> all(static_cast<size_t>(nrOfComponents_));
+		std::iota(all.begin(), all.end(), 0);
+		for_each_of(all, nrThreads, std::forward<Function>(f));
+	}
+
+	// Distribute components over threads: components are handed out round-robin
+	// so that large and small subgraphs are mixed within each thread
+	template<typename Function>
+	static void for_each_of(const std::vector<int>& components, unsigned nrThreads, Function&& f) {
+		unsigned workers = std::max(1u, std::min<unsigned>(nrThreads, static_cast<unsigned>(components.size())));
+		if (workers == 1) {
+			for (int c : components) f(c);
+			return;
+		}
+		std::vector<std::thread> pool;
+		pool.reserve(workers);
+		for (unsigned t = 0; t < workers; ++t) {
+			pool.emplace_back([&, t]() {
+				for (size_t k = t; k < components.size(); k += workers) f(components[k]);
+			});
+		}
+		for (auto& th : pool) th.join();
+	}
+};
+
+}} // namespace sw::universal
@@ -26,6 +26,13 @@
 //   // Step 2a: Iterative fixpoint analysis (no LP solver)
 //   g.analyze();
 //
+//   // Step 2a': incremental re-analysis when exploring requirement changes
+//   IncrementalPopAnalysis ia(g);
+//   ia.analyze();
+//   ia.require_nsb(c, 20);
+//   ia.propagate();     // only re-evaluates the ancestors of c
+//   ia.write_back(g);
+//
 //   // Step 2b: OR use LP solver for optimal assignment
 //   PopSolver solver;
 //   solver.solve(g);
@@ -51,6 +58,7 @@
 
 // Phase 2: Expression graph and iterative fixpoint analysis
 #include <universal/mixedprecision/expression_graph.hpp>
+#include <universal/mixedprecision/incremental_analysis.hpp>
 
 // Phase 3: LP solver and optimal bit assignment
 #include <universal/mixedprecision/simplex.hpp>
@@ -66,6 +66,7 @@
 #include <universal/number/cfloat/exceptions.hpp>
 #include <universal/number/cfloat/cfloat_fwd.hpp>
 #include <universal/number/cfloat/cfloat_impl.hpp>
+#include <universal/number/cfloat/from_chars.hpp>
 #include <universal/traits/cfloat_traits.hpp>
 #include <universal/number/cfloat/numeric_limits.hpp>
 
@@ -5,6 +5,8 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <charconv>
+#include <string>
 
 namespace sw { namespace universal {
 
@@ -24,6 +26,8 @@ template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasM
 // parsing
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasMaxExpValues, bool isSaturating>
 		bool parse(const std::string& number, cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>& v);
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasMaxExpValues, bool isSaturating>
+		std::from_chars_result from_chars(const char* first, const char* last, cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>& v);
 
 #ifdef CFLOAT_QUIRE
 
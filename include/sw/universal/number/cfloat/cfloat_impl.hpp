@@ -42,6 +42,8 @@
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/blocktriple/blocktriple.hpp>
 #include <universal/number/support/decimal.hpp>
+// machine-word fast paths for configurations of at most 64 bits
+#include <universal/number/cfloat/fast_arithmetic.hpp>
 
 #ifndef CFLOAT_THROW_ARITHMETIC_EXCEPTION
 #define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
@@ -640,6 +642,9 @@ public:
 
 	constexpr cfloat& operator+=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_add) std::cout << "---------------------- ADD -------------------" << std::endl;
+		if constexpr (cfloat_fast_arithmetic<cfloat>::enabled && !_trace_add) {
+			if (!std::is_constant_evaluated() && cfloat_fast_arithmetic<cfloat>::add(*this, rhs)) return *this;
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -714,6 +719,9 @@ public:
 	}
 	constexpr cfloat& operator*=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_mul) std::cout << "---------------------- MUL -------------------\n";
+		if constexpr (cfloat_fast_arithmetic<cfloat>::enabled && !_trace_mul) {
+			if (!std::is_constant_evaluated() && cfloat_fast_arithmetic<cfloat>::mul(*this, rhs)) return *this;
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -780,6 +788,9 @@ public:
 	}
 	constexpr cfloat& operator/=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_div) std::cout << "---------------------- DIV -------------------" << std::endl;
+		if constexpr (cfloat_fast_arithmetic<cfloat>::enabled && !_trace_div) {
+			if (!std::is_constant_evaluated() && cfloat_fast_arithmetic<cfloat>::div(*this, rhs)) return *this;
+		}
 
 		// special case handling of the inputs
 		// qnan / qnan = qnan
@@ -1914,7 +1925,9 @@ public:
 			}
 			else if constexpr (3 == nrBlocks) {
 				uint64_t fbitMask = 0xFFFF'FFFF'FFFF'FFFF >> (64 - fbits);
-				raw = fbitMask & ((uint64_t(_block[2]) << (2 * bitsInBlock)) | (uint64_t(_block[1]) << bitsInBlock) | uint64_t(_block[0]));
+				// with 32-bit blocks the third block lies above bit 63 and holds no fraction bits
+				uint64_t upper = (2 * bitsInBlock < 64) ? (uint64_t(_block[2]) << ((2 * bitsInBlock) & 63u)) : 0;
+				raw = fbitMask & (upper | (uint64_t(_block[1]) << bitsInBlock) | uint64_t(_block[0]));
 			}
 			else if constexpr (4 == nrBlocks) {
 				uint64_t fbitMask = 0xFFFF'FFFF'FFFF'FFFF >> (64 - fbits);
@@ -2829,14 +2842,19 @@ public:
 						std::cout << "fraction bits     : " << to_binary(rawFraction, ieee754_parameter<Real>::nbits, true) << '\n';
 						std::cout << "lsb mask bits     : " << to_binary(mask, ieee754_parameter<Real>::nbits, true) << '\n';
 #endif
-						mask = (1ull << (rightShift + adjustment)); // bit mask for the lsb bit
+						// the 64-bit significand of long double can put the lsb of a subnormal target at bit 64, past the word
+						const int lsbPosition = rightShift + adjustment;
+						mask = (lsbPosition < 64) ? (1ull << lsbPosition) : 0; // bit mask for the lsb bit
 						bool lsb = (mask & rawFraction);
-						mask >>= 1;
+						mask = (lsbPosition < 65) ? (1ull << (lsbPosition - 1)) : 0;
 						bool guard = (mask & rawFraction);
 						mask >>= 1;
 						bool round = (mask & rawFraction);
-						if ((rightShift + adjustment) > 1) {
-							mask = (0xFFFF'FFFF'FFFF'FFFFull << (rightShift + adjustment - 2));
+						if (lsbPosition > 65) {
+							mask = 0xFFFF'FFFF'FFFF'FFFFull;
+						}
+						else if (lsbPosition > 1) {
+							mask = (0xFFFF'FFFF'FFFF'FFFFull << (lsbPosition - 2));
 							mask = ~mask;
 						}
 						else {
@@ -2850,7 +2868,7 @@ public:
 						std::cout << "sticky mask bits  : " << to_binary(mask, ieee754_parameter<Real>::nbits, true) << '\n';
 #endif
 						bool sticky = (mask & rawFraction);
-						rawFraction >>= (static_cast<int64_t>(rightShift) + static_cast<int64_t>(adjustment));
+						rawFraction = (lsbPosition < 64) ? (rawFraction >> lsbPosition) : 0;
 
 						// execute rounding operation
 						if (guard) {
@@ -3575,65 +3593,15 @@ bool parse(const std::string& txt, cfloat<nbits,es,bt,hasSubnormals,hasMaxExpVal
 		return true;
 	}
 	else {
-		// Decimal floating-point representation.
-		// Route through the high-precision decimal_to_binary utility so that
-		// wide cfloat configurations (nbits > 64, including IEEE quad and
-		// posit-killer formats) don't lose precision through an intermediate
-		// double. The utility delivers a normalized mantissa with
-		// target_mantissa_bits bits plus guard/sticky; we package that as a
-		// blocktriple and hand it to convert(blocktriple, cfloat), which
-		// handles all IEEE-754 edge cases (subnormals, saturation, etc.).
+		// Decimal floating-point representation: from_chars rounds once, to
+		// nearest even, for any nbits (cfloat/from_chars.hpp).
 		// Special-value tokens (nan / inf in any common spelling) are
-		// recognised directly so callers don't depend on locale-sensitive
-		// std::istringstream parsing of those literals.
-		using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>;
-		{
-			std::string t; t.reserve(txt.size());
-			for (char c : txt) t.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
-			bool negative = !t.empty() && t.front() == '-';
-			std::string body = t;
-			if (!body.empty() && (body.front() == '+' || body.front() == '-')) body.erase(0, 1);
-			if (body == "nan") {
-				v.setnan(NAN_TYPE_QUIET);
-				return true;
-			}
-			if (body == "inf" || body == "infinity") {
-				v.setinf(negative);
-				return true;
-			}
-		}
-		// We pack the d2b result into a blocktriple<fbits, MUL, bt>. The MUL
-		// layout has bfbits = 2*fbits + 2 and radix = 2*fbits, which gives us
-		// exactly fbits of headroom below the cfloat fraction for guard/
-		// sticky -- enough room for cfloat's convert() to make a correct
-		// round-to-nearest-even decision. (The REP layout has no such
-		// headroom: its fraction is exactly cfloat::fbits wide.)
-		using BT = blocktriple<Cfloat::fbits, BlockTripleOperator::MUL, bt>;
-		constexpr unsigned radix_pos          = static_cast<unsigned>(BT::radix);
-		constexpr unsigned target_mantissa_bits = radix_pos + 1u;
-		auto d = ::sw::universal::decimal_to_binary::convert(
-			std::string_view{txt}, target_mantissa_bits);
-		if (!d.valid) return false;
-		if (d.is_zero) {
-			v.setzero();
-			v.setsign(d.negative);
-			return true;
-		}
-		BT bt_val;
-		bt_val.setnormal();
-		bt_val.setsign(d.negative);
-		bt_val.setscale(static_cast<int>(d.binary_scale));
-		// d2b mantissa has its MSB at position radix_pos (the hidden bit);
-		// below it are radix_pos extra precision bits. Copy bit-for-bit
-		// into the blocktriple significand aligned to the same radix.
-		for (unsigned i = 0; i <= radix_pos; ++i) {
-			if (d.mantissa.at(i)) bt_val.setbit(i, true);
-		}
-		// Fold d2b's residual guard/sticky into the lowest bit so cfloat's
-		// own rounding decision picks them up as sticky tail.
-		if (d.guard_bit || d.sticky_bit) bt_val.setbit(0, true);
-		convert(bt_val, v);
-		return true;
+		// recognised by the scanner, independent of the stream locale.
+		const char* first = txt.data();
+		const char* last  = txt.data() + txt.size();
+		if (first != last && *first == '+') ++first;
+		auto [ptr, ec] = from_chars(first, last, v);
+		return ec == std::errc{} && ptr == last;
 	}
 }
 
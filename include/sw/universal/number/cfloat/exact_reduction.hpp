@@ -0,0 +1,445 @@
+#pragma once
+// exact_reduction.hpp: exact, reproducible, parallel sum, dot and norm2 for IEEE-754 cfloat arrays
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// fdp.hpp accumulates cfloat products in the generalized quire one blocktriple at a time. That is
+// exact for every cfloat configuration, and serial. This header is the production engine for the two
+// configurations that carry most array data, cfloat<32,8> and cfloat<64,11> in their IEEE-754 form
+// (subnormals, no max-exponent values, not saturating):
+//
+//   exact_sum(x)        sum of the elements, rounded once
+//   exact_dot(x, y)     sum of the products, rounded once
+//   exact_norm2(x)      sqrt of the sum of squares; the sum is exact and rounded once at a scale
+//                       that keeps it in range, the square root adds one more rounding
+//
+// All three take an optional thread count and return the same bits for every thread count, because
+// the accumulation is exact: no rounding ever happens before the final one, so the order in which
+// partial sums are combined cannot matter.
+//
+// The accumulator is a Kulisch-style fixed-point register wide enough for every product of two
+// values of the format plus 64 bits of carry headroom, held in carry-save form: 32-bit digits in
+// int64_t limbs, so a limb absorbs 2^26 products before its carries have to be propagated. Products
+// are split vectorizably: a block of elements is decoded into sign, exponent and a 53-bit (24-bit)
+// significand held as two 32-bit halves, and the three partial products lo*lo, lo*hi + hi*lo and
+// hi*hi are formed with 32x32->64 multiplies, which compilers map onto vector multiplies. Only the
+// deposit of those partial products into the register is scalar. Merging two accumulators is a
+// limb-wise integer addition, which is what makes the threaded reduction exact.
+//
+// Non-finite inputs follow IEEE-754: a NaN, or infinities of both signs, produce NaN; otherwise an
+// infinity wins; inf * 0 is NaN.
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <universal/number/cfloat/cfloat.hpp>
+
+namespace sw { namespace universal {
+
+// the cfloat configurations whose finite values share their encoding with IEEE-754 binary32 and binary64
+template<typename Scalar>
+struct is_ieee754_binary_cfloat : std::false_type {};
+template<typename bt>
+struct is_ieee754_binary_cfloat<cfloat<32, 8, bt, true, false, false>> : std::true_type {};
+template<typename bt>
+struct is_ieee754_binary_cfloat<cfloat<64, 11, bt, true, false, false>> : std::true_type {};
+
+namespace detail {
+
+	// encoding parameters of the binary interchange formats
+	template<unsigned nbits> struct ieee754_binary;
+	template<> struct ieee754_binary<32> {
+		using native = float;
+		static constexpr int fbits = 23;
+		static constexpr int es = 8;
+		static constexpr int bias = 127;
+	};
+	template<> struct ieee754_binary<64> {
+		using native = double;
+		static constexpr int fbits = 52;
+		static constexpr int es = 11;
+		static constexpr int bias = 1023;
+	};
+
+	// raw encoding of a cfloat of any block type
+	template<unsigned nbits, unsigned es, typename bt, bool sub, bool sup, bool sat>
+	inline std::uint64_t raw_bits(const cfloat<nbits, es, bt, sub, sup, sat>& v) noexcept {
+		constexpr unsigned bitsInBlock = sizeof(bt) * 8;
+		constexpr unsigned nrBlocks = (nbits + bitsInBlock - 1) / bitsInBlock;
+		std::uint64_t raw{ 0 };
+		for (unsigned b = 0; b < nrBlocks; ++b) raw |= std::uint64_t(v.block(b)) << (b * bitsInBlock);
+		return raw;
+	}
+
+} // namespace detail
+
+template<typename Scalar>
+class exact_accumulator {
+	static_assert(is_ieee754_binary_cfloat<Scalar>::value,
+		"exact_accumulator: only the IEEE-754 configurations cfloat<32,8> and cfloat<64,11> with subnormals are supported; use fdp/quire for other cfloats");
+	static constexpr unsigned nbits = Scalar::nbits;
+	using format = detail::ieee754_binary<nbits>;
+
+	static constexpr int fbits = format::fbits;
+	static constexpr int emax = (1 << format::es) - 1;
+	// weight of the least significant bit of a subnormal, and of a product of two of them
+	static constexpr int lsbScale = 1 - format::bias - fbits;
+	static constexpr int productLsbScale = 2 * lsbScale;
+	// register bit 0 has weight 2^productLsbScale; the largest product has its msb below topScale
+	static constexpr int topScale = 2 * (format::bias + 1);
+	static constexpr int headroom = 64;
+	static constexpr int registerBits = topScale - productLsbScale + headroom;
+	static constexpr int nrLimbs = (registerBits + 31) / 32 + 2;  // +2: a deposit may spill past the top digit
+	// a product adds less than 2^35 to any limb, so 2^26 of them stay clear of int64 overflow
+	static constexpr std::uint32_t depositsBeforeCarry = 1u << 26;
+	static constexpr std::size_t blockSize = 256;
+
+public:
+	exact_accumulator() { clear(); }
+
+	void clear() noexcept {
+		_limb.fill(0);
+		_deposits = 0;
+		_nan = false;
+		_posInf = false;
+		_negInf = false;
+	}
+
+	// accumulate x[0..n)
+	void add(const Scalar* x, std::size_t n) {
+		std::array<std::uint64_t, blockSize> raw;
+		for (std::size_t base = 0; base < n; base += blockSize) {
+			std::size_t m = std::min(blockSize, n - base);
+			for (std::size_t i = 0; i < m; ++i) raw[i] = detail::raw_bits(x[base + i]);
+			addBlock(raw.data(), m);
+		}
+	}
+
+	// accumulate the products x[i]*y[i], i in [0..n)
+	void add_products(const Scalar* x, const Scalar* y, std::size_t n) {
+		std::array<std::uint64_t, blockSize> rx, ry;
+		for (std::size_t base = 0; base < n; base += blockSize) {
+			std::size_t m = std::min(blockSize, n - base);
+			for (std::size_t i = 0; i < m; ++i) {
+				rx[i] = detail::raw_bits(x[base + i]);
+				ry[i] = detail::raw_bits(y[base + i]);
+			}
+			addProductBlock(rx.data(), ry.data(), m);
+		}
+	}
+
+	exact_accumulator& operator+=(const Scalar& v) { add(&v, 1); return *this; }
+
+	// exact merge: limb-wise integer addition, the reason the threaded reduction is reproducible
+	exact_accumulator& operator+=(const exact_accumulator& rhs) noexcept {
+		propagate();
+		exact_accumulator other(rhs);
+		other.propagate();
+		for (int i = 0; i < nrLimbs; ++i) _limb[i] += other._limb[i];
+		_deposits = 1;  // every limb is below 2^33 after the addition
+		_nan = _nan || rhs._nan;
+		_posInf = _posInf || rhs._posInf;
+		_negInf = _negInf || rhs._negInf;
+		return *this;
+	}
+
+	bool iszero() const noexcept {
+		if (_nan || _posInf || _negInf) return false;
+		for (int i = 0; i < nrLimbs; ++i) if (_limb[i] != 0) return false;
+		return true;
+	}
+
+	// the accumulated value, correctly rounded to nearest, ties to even
+	Scalar value() const {
+		Scalar result;
+		if (_nan || (_posInf && _negInf)) { result.setnan(); return result; }
+		if (_posInf || _negInf) { result.setinf(_negInf); return result; }
+		exact_accumulator n(*this);
+		bool negative = n.normalize();
+		int msb = n.leadingBit();
+		if (msb < 0) { result.setzero(); return result; }
+		return encode(n.rounded(msb, 0), negative);
+	}
+
+	// the square root of the accumulated value. The value is rounded once at a scale of an even
+	// power of two that puts it in [1, 4), so neither it nor its root can overflow or underflow
+	// before the root is rescaled; the square root adds one more rounding
+	Scalar sqrt_value() const {
+		Scalar result;
+		if (_nan || _negInf) { result.setnan(); return result; }
+		if (_posInf) { result.setinf(false); return result; }
+		exact_accumulator n(*this);
+		if (n.normalize()) { result.setnan(); return result; }
+		int msb = n.leadingBit();
+		if (msb < 0) { result.setzero(); return result; }
+		int scale = msb + productLsbScale;
+		int half = (scale >= 0) ? scale / 2 : -((1 - scale) / 2);  // floor(scale / 2)
+		using native = typename format::native;
+		native root = std::ldexp(std::sqrt(n.rounded(msb, 2 * half)), half);
+		return encode(root, false);
+	}
+
+private:
+	std::array<std::int64_t, nrLimbs> _limb;
+	std::uint32_t _deposits;
+	bool _nan, _posInf, _negInf;
+
+	static int countl_zero32(std::uint32_t v) noexcept {
+		int n = 0;
+		while (n < 32 && !(v & (0x8000'0000u >> n))) ++n;
+		return n;
+	}
+
+	// carry-propagate and take the magnitude; returns whether the value was negative
+	bool normalize() noexcept {
+		propagate();
+		bool negative = _limb[nrLimbs - 1] < 0;
+		if (negative) {
+			for (int i = 0; i < nrLimbs; ++i) _limb[i] = -_limb[i];
+			_deposits = 1;
+			propagate();
+		}
+		return negative;
+	}
+
+	// position of the most significant bit of the normalized register, -1 when it is zero
+	int leadingBit() const noexcept {
+		int h = nrLimbs - 1;
+		while (h >= 0 && _limb[h] == 0) --h;
+		if (h < 0) return -1;
+		return 32 * h + 31 - countl_zero32(static_cast<std::uint32_t>(_limb[h]));
+	}
+
+	// the normalized register times 2^-shift, correctly rounded to the native format, or infinity
+	typename format::native rounded(int msb, int shift) const {
+		// the 64 bits below and including the msb
+		std::uint64_t top = (std::uint64_t(digits(msb - 31)) << 32) | digits(msb - 63);
+		bool sticky = anyBelow(msb - 63);
+
+		// precision available at this scale: full above the normal range, reduced in the subnormals
+		int scale = msb + productLsbScale - shift;
+		constexpr int emin = 1 - format::bias;
+		int precision = fbits + 1 - std::max(0, emin - scale);
+		std::uint64_t significand{ 0 };
+		if (precision > 0) {
+			int rshift = 64 - precision;
+			significand = top >> rshift;
+			std::uint64_t rest = top & ((std::uint64_t(1) << rshift) - 1);
+			std::uint64_t half = std::uint64_t(1) << (rshift - 1);
+			if (rest > half || (rest == half && (sticky || (significand & 1u)))) ++significand;
+		}
+		else if (precision == 0) {
+			// the value is in [denorm_min/2, denorm_min): round up when strictly above the half
+			bool aboveHalf = (top << 1) != 0 || sticky;
+			significand = aboveHalf ? 1u : 0u;
+			precision = 1;
+			++scale;
+		}
+		double d = std::ldexp(static_cast<double>(significand), scale - precision + 1);
+		return static_cast<typename format::native>(d);  // exact, or overflow to infinity
+	}
+
+	// the cfloat of a native magnitude
+	static Scalar encode(typename format::native v, bool negative) {
+		Scalar result;
+		if (std::isinf(v)) { result.setinf(negative); return result; }
+		if (negative) v = -v;
+		std::uint64_t bits{ 0 };
+		std::memcpy(&bits, &v, sizeof(v));
+		result.setbits(bits);
+		return result;
+	}
+
+	// 32 bits of the (normalized, non-negative) register starting at bit position pos
+	std::uint32_t digits(int pos) const noexcept {
+		auto digit = [this](int k) -> std::uint64_t {
+			return (k >= 0 && k < nrLimbs) ? static_cast<std::uint32_t>(_limb[k]) : 0u;
+		};
+		int k = (pos >= 0) ? pos / 32 : -((31 - pos) / 32);
+		int s = pos - 32 * k;
+		std::uint64_t window = digit(k) | (digit(k + 1) << 32);
+		return static_cast<std::uint32_t>(window >> s);
+	}
+
+	// any bit set strictly below position pos
+	bool anyBelow(int pos) const noexcept {
+		if (pos <= 0) return false;
+		int k = pos / 32;
+		for (int i = 0; i < k && i < nrLimbs; ++i) if (_limb[i] != 0) return true;
+		int s = pos - 32 * k;
+		return s > 0 && k < nrLimbs && (static_cast<std::uint32_t>(_limb[k]) & ((1u << s) - 1u)) != 0;
+	}
+
+	// carry propagation: every digit to [0, 2^32), the sign in the top limb
+	void propagate() noexcept {
+		for (int i = 0; i < nrLimbs - 1; ++i) {
+			std::int64_t carry = _limb[i] >> 32;  // arithmetic shift: floor division
+			_limb[i] -= carry * (std::int64_t(1) << 32);
+			_limb[i + 1] += carry;
+		}
+		_deposits = 0;
+	}
+
+	// add sign * v * 2^pos, v < 2^64
+	void deposit(std::int64_t sign, std::uint64_t v, int pos) noexcept {
+		int k = pos >> 5;
+		int s = pos & 31;
+		std::uint64_t lo = (v & 0xFFFF'FFFFu) << s;
+		std::uint64_t hi = (v >> 32) << s;
+		_limb[k]     += sign * static_cast<std::int64_t>(lo & 0xFFFF'FFFFu);
+		_limb[k + 1] += sign * static_cast<std::int64_t>((lo >> 32) + (hi & 0xFFFF'FFFFu));
+		_limb[k + 2] += sign * static_cast<std::int64_t>(hi >> 32);
+	}
+
+	void countDeposit() noexcept {
+		if (++_deposits == depositsBeforeCarry) propagate();
+	}
+
+	// decoded operands of one block: significand halves, exponent and sign as SoA arrays
+	struct decoded {
+		std::array<std::uint64_t, blockSize> lo, hi;
+		std::array<int, blockSize> scale;
+		std::array<std::int64_t, blockSize> sign;
+		std::array<unsigned char, blockSize> special;  // 0 finite, 1 inf, 2 nan
+	};
+
+	static void decode(const std::uint64_t* raw, std::size_t m, decoded& d) noexcept {
+		constexpr std::uint64_t fractionMask = (std::uint64_t(1) << fbits) - 1;
+		// cfloat encodes infinity as the all-ones exponent with fraction 1...10; every other
+		// max-exponent encoding is a NaN (without max-exponent values, see cfloat::isinf)
+		constexpr std::uint64_t infFraction = fractionMask ^ 1u;
+		for (std::size_t i = 0; i < m; ++i) {
+			std::uint64_t r = raw[i];
+			int e = static_cast<int>((r >> fbits) & static_cast<std::uint64_t>(emax));
+			std::uint64_t f = r & fractionMask;
+			std::uint64_t significand = (e == 0) ? f : (f | (fractionMask + 1));
+			d.lo[i] = significand & 0xFFFF'FFFFu;
+			d.hi[i] = significand >> 32;
+			d.scale[i] = (e == 0 ? 1 : e) - format::bias - fbits;
+			d.sign[i] = ((r >> (nbits - 1)) & 1u) ? -1 : 1;
+			d.special[i] = (e == emax) ? (f == infFraction ? 1 : 2) : 0;
+		}
+	}
+
+	void recordSpecial(unsigned char special, std::int64_t sign) noexcept {
+		if (special == 2) _nan = true;
+		else if (sign < 0) _negInf = true;
+		else _posInf = true;
+	}
+
+	void addBlock(const std::uint64_t* raw, std::size_t m) {
+		decoded d;
+		decode(raw, m, d);
+		for (std::size_t i = 0; i < m; ++i) {
+			if (d.special[i]) { recordSpecial(d.special[i], d.sign[i]); continue; }
+			std::uint64_t significand = d.lo[i] | (d.hi[i] << 32);
+			deposit(d.sign[i], significand, d.scale[i] - productLsbScale);
+			countDeposit();
+		}
+	}
+
+	void addProductBlock(const std::uint64_t* rx, const std::uint64_t* ry, std::size_t m) {
+		decoded a, b;
+		decode(rx, m, a);
+		decode(ry, m, b);
+		// the partial products, formed with 32x32->64 multiplies across the block
+		// the high halves are at most 21 bits, so the middle sum cannot overflow
+		std::array<std::uint64_t, blockSize> ll, mid, hh;
+		for (std::size_t i = 0; i < m; ++i) {
+			ll[i] = a.lo[i] * b.lo[i];
+			mid[i] = a.lo[i] * b.hi[i] + a.hi[i] * b.lo[i];
+			hh[i] = a.hi[i] * b.hi[i];
+		}
+		for (std::size_t i = 0; i < m; ++i) {
+			std::int64_t sign = a.sign[i] * b.sign[i];
+			if (a.special[i] | b.special[i]) {
+				// inf * 0 is NaN, anything else with a non-finite operand takes its class
+				bool zeroA = !a.special[i] && (a.lo[i] | a.hi[i]) == 0;
+				bool zeroB = !b.special[i] && (b.lo[i] | b.hi[i]) == 0;
+				unsigned char special = (zeroA || zeroB) ? 2 : std::max(a.special[i], b.special[i]);
+				recordSpecial(special, sign);
+				continue;
+			}
+			int pos = a.scale[i] + b.scale[i] - productLsbScale;
+			deposit(sign, ll[i], pos);
+			deposit(sign, mid[i], pos + 32);
+			deposit(sign, hh[i], pos + 64);
+			countDeposit();
+		}
+	}
+};
+
+namespace detail {
+
+	// split [0, n) into nrThreads contiguous ranges, run 'work' on each, and merge the partial
+	// accumulators; the merge is exact, so the result does not depend on nrThreads
+	template<typename Scalar, typename Work>
+	exact_accumulator<Scalar> parallel_reduce(std::size_t n, unsigned nrThreads, Work&& work) {
+		if (nrThreads == 0) nrThreads = 1;
+		if (nrThreads > n / 1024 + 1) nrThreads = static_cast<unsigned>(n / 1024 + 1);
+		std::vector<exact_accumulator<Scalar>> partial(nrThreads);
+		if (nrThreads == 1) {
+			work(partial[0], std::size_t(0), n);
+			return partial[0];
+		}
+		std::vector<std::thread> workers;
+		workers.reserve(nrThreads);
+		std::size_t chunk = (n + nrThreads - 1) / nrThreads;
+		for (unsigned t = 0; t < nrThreads; ++t) {
+			std::size_t begin = std::min(n, t * chunk);
+			std::size_t end = std::min(n, begin + chunk);
+			workers.emplace_back([&partial, &work, t, begin, end] { work(partial[t], begin, end); });
+		}
+		for (auto& w : workers) w.join();
+		for (unsigned t = 1; t < nrThreads; ++t) partial[0] += partial[t];
+		return partial[0];
+	}
+
+} // namespace detail
+
+/// exact sum of x, rounded once; identical for every thread count
+template<typename Vector>
+std::enable_if_t<is_ieee754_binary_cfloat<typename Vector::value_type>::value, typename Vector::value_type>
+exact_sum(const Vector& x, unsigned nrThreads = 1) {
+	using Scalar = typename Vector::value_type;
+	const Scalar* px = x.data();
+	return detail::parallel_reduce<Scalar>(x.size(), nrThreads, [px](exact_accumulator<Scalar>& acc, std::size_t begin, std::size_t end) {
+		acc.add(px + begin, end - begin);
+	}).value();
+}
+
+/// exact dot product of x and y, rounded once; identical for every thread count
+template<typename Vector>
+std::enable_if_t<is_ieee754_binary_cfloat<typename Vector::value_type>::value, typename Vector::value_type>
+exact_dot(const Vector& x, const Vector& y, unsigned nrThreads = 1) {
+	using Scalar = typename Vector::value_type;
+	assert(x.size() <= y.size() && "exact_dot: y vector must be at least as long as x");
+	const Scalar* px = x.data();
+	const Scalar* py = y.data();
+	return detail::parallel_reduce<Scalar>(x.size(), nrThreads, [px, py](exact_accumulator<Scalar>& acc, std::size_t begin, std::size_t end) {
+		acc.add_products(px + begin, py + begin, end - begin);
+	}).value();
+}
+
+/// Euclidean norm of x: the square root is taken of the exact sum of squares, rounded once at a scale
+/// where it cannot overflow or underflow, so the norm is finite whenever it fits the format
+template<typename Vector>
+std::enable_if_t<is_ieee754_binary_cfloat<typename Vector::value_type>::value, typename Vector::value_type>
+exact_norm2(const Vector& x, unsigned nrThreads = 1) {
+	using Scalar = typename Vector::value_type;
+	const Scalar* px = x.data();
+	return detail::parallel_reduce<Scalar>(x.size(), nrThreads, [px](exact_accumulator<Scalar>& acc, std::size_t begin, std::size_t end) {
+		acc.add_products(px + begin, px + begin, end - begin);
+	}).sqrt_value();
+}
+
+}} // namespace sw::universal
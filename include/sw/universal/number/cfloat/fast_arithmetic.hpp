@@ -0,0 +1,281 @@
+#pragma once
+// fast_arithmetic.hpp: latency-optimized add, multiply, and divide for cfloat configurations of at most 64 bits
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The generic cfloat operators expand both operands into blocktriples, run the block arithmetic, and
+// round the result back through convert(). When the encoding fits in 64 bits, two shorter paths compute
+// the same encoding, bit for bit:
+//
+//   native  : cfloat<32,8> and cfloat<64,11> with subnormals, without max-exponent values, and not
+//             saturating, share their finite encodings with float and double, and cfloat<16,5> with
+//             _Float16 where the target converts half precision in hardware. The operation runs on
+//             the FPU, which rounds to nearest even just like convert().
+//   integer : every other configuration with at most 59 fraction bits decodes its operands into
+//             (sign, scale, significand) machine words, computes the exact result with guard and sticky
+//             bits in support/word_triple.hpp, and rounds it with the rules of convert(). Division takes
+//             this path up to 30 fraction bits, where the dividend still fits a 64-bit word.
+//
+// Only finite, nonzero operands are taken, and the native path also hands back NaN, infinite and
+// zero results: these go through the generic operators, so cfloat's own encodings of inf and NaN,
+// and its signed-zero and saturation rules, are unchanged. The native path assumes the default
+// floating-point environment (round to nearest even, no flush-to-zero), and is disabled when the
+// compiler evaluates float expressions in excess precision or is asked for fast-math.
+//
+// Set CFLOAT_FAST_ARITHMETIC to 0 to route all arithmetic through blocktriple.
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <universal/number/support/word_triple.hpp>
+
+#if !defined(CFLOAT_FAST_ARITHMETIC)
+#define CFLOAT_FAST_ARITHMETIC 1
+#endif
+
+// the FPU produces the correctly rounded result only when it evaluates in the precision of the type
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0) && !defined(__FAST_MATH__)
+#define CFLOAT_NATIVE_FAST_PATH 1
+#else
+#define CFLOAT_NATIVE_FAST_PATH 0
+#endif
+
+// _Float16 arithmetic is correctly rounded: without FP16 arithmetic it runs in float, which is wide enough.
+// Without hardware conversions between the two, the integer path is faster.
+#if defined(__FLT16_MANT_DIG__) && (defined(__F16C__) || defined(__aarch64__)) && !defined(__FAST_MATH__)
+#define CFLOAT_NATIVE_FLOAT16 1
+#else
+#define CFLOAT_NATIVE_FLOAT16 0
+#endif
+
+namespace sw { namespace universal {
+
+/// <summary>
+/// cfloat_fast_arithmetic picks the native or the integer path of a cfloat configuration at compile
+/// time. An operation returns false for zero, infinite, and NaN operands, for native results that
+/// are not finite and nonzero, and for divisions wider than the integer path supports; the operator
+/// then falls back to blocktriple.
+/// </summary>
+/// <typeparam name="Cfloat">the cfloat configuration</typeparam>
+template<typename Cfloat>
+struct cfloat_fast_arithmetic {
+	static constexpr unsigned nbits = Cfloat::nbits;
+	static constexpr unsigned es    = Cfloat::es;
+	static constexpr unsigned fbits = Cfloat::fbits;
+	static constexpr bool hasSubnormals   = Cfloat::hasSubnormals;
+	static constexpr bool hasMaxExpValues = Cfloat::hasMaxExpValues;
+	static constexpr bool isSaturating    = Cfloat::isSaturating;
+
+	static constexpr bool ieee754Layout = hasSubnormals && !hasMaxExpValues && !isSaturating;
+	static constexpr bool nativeHalf    = CFLOAT_NATIVE_FLOAT16 && ieee754Layout && nbits == 16 && es == 5;
+	static constexpr bool nativeSingle  = CFLOAT_NATIVE_FAST_PATH && ieee754Layout && nbits == 32 && es == 8;
+	static constexpr bool nativeDouble  = CFLOAT_NATIVE_FAST_PATH && ieee754Layout && nbits == 64 && es == 11;
+	static constexpr bool native   = nativeHalf || nativeSingle || nativeDouble;
+	static constexpr bool integer  = !native && nbits <= 64 && fbits >= 1 && fbits <= 59;
+	static constexpr bool integerDivision = integer && fbits <= 30;
+	static constexpr bool enabled  = CFLOAT_FAST_ARITHMETIC && (native || integer);
+
+	using triple = support::word_triple;
+	using triple_arithmetic = support::word_triple_arithmetic<(integer ? fbits : 1u)>;
+
+	static bool add(Cfloat& lhs, const Cfloat& rhs) noexcept {
+		if constexpr (native) {
+			return nativeOp(lhs, rhs, [](auto a, auto b) { return a + b; });
+		}
+		else {
+			triple x, y;
+			if (!decode(bits(lhs), x) || !decode(bits(rhs), y)) return false;
+			triple sum = triple_arithmetic::add(x, y);
+			if (sum.significand == 0) {
+				lhs.setbits(0);  // exact cancellation yields +0
+				return true;
+			}
+			round(lhs, sum);
+			return true;
+		}
+	}
+
+	static bool mul(Cfloat& lhs, const Cfloat& rhs) noexcept {
+		if constexpr (native) {
+			return nativeOp(lhs, rhs, [](auto a, auto b) { return a * b; });
+		}
+		else {
+			triple x, y;
+			if (!decode(bits(lhs), x) || !decode(bits(rhs), y)) return false;
+			normalize(x);
+			normalize(y);
+			round(lhs, triple_arithmetic::mul(x, y));
+			return true;
+		}
+	}
+
+	static bool div(Cfloat& lhs, const Cfloat& rhs) noexcept {
+		if constexpr (native) {
+			return nativeOp(lhs, rhs, [](auto a, auto b) { return a / b; });
+		}
+		else if constexpr (integerDivision) {
+			triple x, y;
+			if (!decode(bits(lhs), x) || !decode(bits(rhs), y)) return false;
+			normalize(x);
+			normalize(y);
+			round(lhs, triple_arithmetic::div(x, y));
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	// the blocks of v concatenated into one word, least significant block first
+	static uint64_t bits(const Cfloat& v) noexcept {
+		constexpr unsigned bitsInBlock = Cfloat::bitsInBlock;
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) {
+			raw |= static_cast<uint64_t>(v.block(b)) << (b * bitsInBlock);
+		}
+		return raw;
+	}
+
+private:
+	static constexpr uint64_t SIGN_BIT = 1ull << (nbits - 1u);
+
+	template<typename Native, typename Raw, typename Op>
+	static bool nativeOp(Cfloat& lhs, Raw a, Raw b, Op op) noexcept {
+		constexpr Raw EXP_MASK = static_cast<Raw>(static_cast<uint64_t>(Cfloat::ALL_ONES_ES) << fbits);
+		constexpr Raw MAGNITUDE = static_cast<Raw>(SIGN_BIT - 1ull);
+		// the inf and NaN encodings of cfloat differ from IEEE-754, and zeros keep the generic sign rules
+		if ((a & EXP_MASK) == EXP_MASK || (b & EXP_MASK) == EXP_MASK) return false;
+		if ((a & MAGNITUDE) == 0 || (b & MAGNITUDE) == 0) return false;
+		Native r = op(std::bit_cast<Native>(a), std::bit_cast<Native>(b));
+		Raw raw = std::bit_cast<Raw>(r);
+		if ((raw & EXP_MASK) == EXP_MASK || (raw & MAGNITUDE) == 0) return false;
+		lhs.setbits(raw);
+		return true;
+	}
+	template<typename Op>
+	static bool nativeOp(Cfloat& lhs, const Cfloat& rhs, Op op) noexcept {
+		if constexpr (nativeDouble) {
+			return nativeOp<double, uint64_t>(lhs, bits(lhs), bits(rhs), op);
+		}
+		else if constexpr (nativeSingle) {
+			return nativeOp<float, uint32_t>(lhs, static_cast<uint32_t>(bits(lhs)), static_cast<uint32_t>(bits(rhs)), op);
+		}
+		else {
+#if CFLOAT_NATIVE_FLOAT16
+			return nativeOp<_Float16, uint16_t>(lhs, static_cast<uint16_t>(bits(lhs)), static_cast<uint16_t>(bits(rhs)), op);
+#else
+			return false;
+#endif
+		}
+	}
+
+	// decode a finite, nonzero encoding into value = significand * 2^(scale - fbits)
+	static bool decode(uint64_t raw, triple& t) noexcept {
+		t.sign = (raw & SIGN_BIT) != 0;
+		uint64_t e = (raw >> fbits) & Cfloat::ALL_ONES_ES;
+		uint64_t f = raw & Cfloat::ALL_ONES_FR;
+		if (e == 0) {
+			// configurations without subnormals read these encodings as zero
+			if constexpr (!hasSubnormals) return false;
+			if (f == 0) return false;
+			t.scale = Cfloat::MIN_EXP_NORMAL;
+			t.significand = f;
+			return true;
+		}
+		if (e == Cfloat::ALL_ONES_ES) {
+			if constexpr (!hasMaxExpValues) return false;  // inf and NaN
+			if (f >= Cfloat::INF_ENCODING) return false;
+		}
+		t.scale = static_cast<int>(e) - Cfloat::EXP_BIAS;
+		t.significand = f | (1ull << fbits);
+		return true;
+	}
+
+	// move the leading one of a subnormal significand to the hidden bit position
+	static void normalize(triple& t) noexcept {
+		int shift = static_cast<int>(fbits + 1u) - static_cast<int>(std::bit_width(t.significand));
+		t.significand <<= shift;
+		t.scale -= shift;
+	}
+
+	// round the value with its leading one at 2^scale, and all its bits in significand, into tgt.
+	// This mirrors convert(blocktriple, cfloat) so that both paths produce the same encoding.
+	static void round(Cfloat& tgt, const triple& t) noexcept {
+		const bool sign = t.sign;
+		const int exponent = t.scale;
+		const uint64_t significand = t.significand;
+		unsigned msb = static_cast<unsigned>(std::bit_width(significand)) - 1u;
+		uint64_t raw = sign ? SIGN_BIT : 0ull;
+		if constexpr (hasSubnormals) {
+			if (exponent < Cfloat::MIN_EXP_SUBNORMAL) {
+				// the half-way value below minpos rounds up when anything trails the leading one
+				if (exponent == Cfloat::MIN_EXP_SUBNORMAL - 1 && (significand & ~(1ull << msb)) != 0) raw |= 1ull;
+				tgt.setbits(raw);
+				return;
+			}
+		}
+		else {
+			if (exponent + Cfloat::EXP_BIAS <= 0) {
+				tgt.setbits(raw);
+				return;
+			}
+		}
+		if (exponent > Cfloat::MAX_EXP) {
+			if constexpr (isSaturating) {
+				if (sign) tgt.maxneg(); else tgt.maxpos();
+			}
+			else {
+				tgt.setinf(sign);
+			}
+			return;
+		}
+
+		uint64_t biasedExponent;
+		int adjustment{ 0 };
+		if (hasSubnormals && exponent < Cfloat::MIN_EXP_NORMAL) {
+			biasedExponent = 0;
+			adjustment = Cfloat::MIN_EXP_NORMAL - exponent;
+		}
+		else {
+			biasedExponent = static_cast<uint64_t>(exponent + Cfloat::EXP_BIAS);
+		}
+		int rightShift = static_cast<int>(msb) - static_cast<int>(fbits) + adjustment;
+		uint64_t fracbits;
+		bool roundup{ false };
+		if (rightShift <= 0) {
+			fracbits = significand << -rightShift;
+		}
+		else {
+			fracbits = significand >> rightShift;
+			bool guard = ((significand >> (rightShift - 1)) & 1ull) != 0;
+			bool sticky = (significand & ((1ull << (rightShift - 1)) - 1ull)) != 0;
+			roundup = guard && ((fracbits & 1ull) != 0 || sticky);
+		}
+		fracbits &= Cfloat::ALL_ONES_FR;
+		if (roundup) ++fracbits;
+		if (fracbits == (1ull << fbits)) {
+			if (biasedExponent == Cfloat::ALL_ONES_ES) {
+				fracbits = Cfloat::INF_ENCODING;
+			}
+			else {
+				++biasedExponent;
+				fracbits = 0;
+			}
+		}
+		raw |= (biasedExponent << fbits) | fracbits;
+		tgt.setbits(raw);
+		if (biasedExponent == Cfloat::ALL_ONES_ES && tgt.isnan()) {
+			if constexpr (isSaturating) {
+				if (sign) tgt.maxneg(); else tgt.maxpos();
+			}
+			else {
+				tgt.setinf(sign);
+			}
+		}
+	}
+};
+
+}} // namespace sw::universal
@@ -0,0 +1,56 @@
+#pragma once
+// from_chars.hpp: correctly rounded decimal to cfloat conversion
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// from_chars(first, last, v) reads a decimal with the syntax of std::from_chars and rounds it
+// once, to nearest even, without going through double; from_chars(first, last, values) reads a
+// column of them. For an IEEE-layout cfloat the result is the one std::from_chars gives for float
+// or double. Overflow produces infinity, or maxpos for a saturating cfloat, and underflow
+// produces a subnormal or zero, as in arithmetic, so the result is never result_out_of_range.
+//
+// Usage:
+//   #include <universal/number/cfloat/cfloat.hpp>
+//   #include <universal/number/cfloat/from_chars.hpp>
+//
+//   cfloat<16,5,uint16_t,true> h;
+//   std::string_view txt = "0.1";
+//   auto [ptr, ec] = from_chars(txt.data(), txt.data() + txt.size(), h);
+#include <charconv>
+#include <universal/number/support/eisel_lemire.hpp>
+
+namespace sw { namespace universal {
+
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasMaxExpValues, bool isSaturating>
+std::from_chars_result from_chars(const char* first, const char* last, cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>& v) {
+	eisel_lemire::decimal_number d;
+	std::from_chars_result result = eisel_lemire::scan(first, last, d);
+	if (result.ec != std::errc{}) return result;
+	if (d.type == eisel_lemire::kind::nan) {
+		v.setnan(NAN_TYPE_QUIET);
+		return result;
+	}
+	if (d.type == eisel_lemire::kind::infinite) {
+		v.setinf(d.negative);
+		return result;
+	}
+	constexpr unsigned P = eisel_lemire::precision_for(nbits);
+	eisel_lemire::rounded_to_odd<P> r;
+	if (!eisel_lemire::to_binary(d, r)) {
+		v.setzero();
+		v.setsign(d.negative);
+		return result;
+	}
+	// convert() rounds to the fraction width of the triple's type, so the extra bits go below
+	// the radix point of the ADD layout: guard, round and sticky
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>;
+	blocktriple<Cfloat::fbits, BlockTripleOperator::ADD, bt> t;
+	eisel_lemire::to_triple(d.negative, r, t);
+	convert(t, v);
+	return result;
+}
+
+}} // namespace sw::universal
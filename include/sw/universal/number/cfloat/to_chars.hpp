@@ -0,0 +1,53 @@
+#pragma once
+// to_chars.hpp: shortest round-trip decimal representation of cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// to_chars(first, last, v) writes the shortest decimal that converts back to v, in the format
+// std::to_chars uses for float and double, so cfloat<32,8,uint32_t,true,false,false> prints the
+// same characters as float; to_chars(span, out) does the same for an array.
+//
+// A cfloat rounds to nearest, ties to even. The rounding boundaries of v are the cfloats with one
+// more fraction bit and encodings 2*v - 1 and 2*v + 1: half an ulp on either side, a quarter ulp
+// below the bottom of a binade, and half a subnormal ulp in the subnormal range.
+//
+// Usage:
+//   #include <universal/number/cfloat/cfloat.hpp>
+//   #include <universal/number/cfloat/to_chars.hpp>
+//
+//   char buf[64];
+//   auto [end, ec] = to_chars(buf, buf + sizeof(buf), cfloat<16,5,uint16_t,true>(0.1));  // "0.1"
+#include <charconv>
+#include <universal/number/support/shortest.hpp>
+
+namespace sw { namespace universal {
+
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasMaxExpValues, bool isSaturating>
+std::to_chars_result to_chars(char* first, char* last, const cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>& v,
+                              shortest::strategy strategy = shortest::strategy::automatic) {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>;
+	using Wider  = cfloat<nbits + 1, es, bt, hasSubnormals, hasMaxExpValues, isSaturating>;
+	if (v.isnan()) return shortest::format(first, last, v.sign() ? "-nan" : "nan");
+	if (v.isinf()) return shortest::format(first, last, v.sign() ? "-inf" : "inf");
+	if (v.iszero()) return shortest::format(first, last, v.sign() ? "-0" : "0");
+
+	Cfloat a = v.sign() ? -v : v;
+	Wider high{};
+	for (unsigned i = 0; i < nbits; ++i) high.setbit(i + 1, a.at(i));
+	high.setbit(0);
+	Wider low = high;
+	--low;
+	--low;
+	blocktriple<Cfloat::fbits, BlockTripleOperator::REP, bt> tv;
+	blocktriple<Wider::fbits, BlockTripleOperator::REP, bt> tl, th;
+	a.normalize(tv);
+	low.normalize(tl);
+	high.normalize(th);
+	return shortest::to_chars(first, last, v.sign(),
+		shortest::dyadic_of(tv), shortest::dyadic_of(tl), shortest::dyadic_of(th), !a.at(0), strategy);
+}
+
+}} // namespace sw::universal
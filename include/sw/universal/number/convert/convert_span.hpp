@@ -0,0 +1,406 @@
+#pragma once
+// convert_span.hpp: bulk conversion of arrays between Universal number types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// universal_cast converts one value at a time, through a double or a blocktriple. A mixed-precision
+// pipeline that hands whole tensors from one stage to the next pays that cost per element.
+// convert_span<Src, Dst> converts an array in one call and picks one of three strategies at compile
+// time:
+//
+//   table    the source is at most 16 bits: every source encoding is converted once, the results
+//            are cached in a table indexed by encoding, and each element becomes a load.
+//            The table is built on first use, thread-safe, and shared by all calls for the pair.
+//   remap    the source fields are decoded into a (sign, scale, significand) word triple and encoded
+//            into the destination with its own rounding, all in integer operations. Sources are the
+//            IEEE-754 binary interchange layouts (float, double, and cfloat with subnormals, without
+//            max-exponent values, non-saturating), posits of at most 64 bits on the decoder of
+//            their word arithmetic, and fixed-points of at most 64 bits. Destinations are the IEEE
+//            layouts, rounded to nearest even, and posits of at most 64 bits, rounded as their
+//            conversion from a native float. Zeros, non-finite values and NaR, and IEEE results that
+//            overflow or underflow to zero are rare, and are handed to the element-wise conversion.
+//            A pair remaps only when the element-wise conversion rounds the exact value once:
+//            universal_cast's double or long double holds every source value, or, for a native
+//            destination, the source's own conversion is exact or, for posit, rounds once from long
+//            double. cfloat narrowing to float, for example, stays element-wise.
+//   element  anything else: universal_cast, or a plain construction when one side is native. Other
+//            number systems, takum and lns among them, and fixed-point destinations take this path.
+//
+// All three produce the same bits as the element-wise conversion, so the strategy is purely a
+// performance decision. The third template argument forces a strategy, for benchmarking.
+//
+// Usage:
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/number/cfloat/cfloat.hpp>
+//   #include <universal/number/convert/convert_span.hpp>
+//
+//   std::vector<posit<16,1>> p(n);
+//   std::vector<cfloat<32,8,uint32_t,true,false,false>> c(n);
+//   convert_span<posit<16,1>, cfloat<32,8,uint32_t,true,false,false>>(p, c);   // table
+//
+//   std::vector<float> x(n);
+//   std::vector<cfloat<16,5,uint16_t,true,false,false>> h(n);
+//   convert_span<float, cfloat<16,5,uint16_t,true,false,false>>(x, h);            // remap
+//
+//   std::vector<posit<32,2>> q(n);
+//   convert_span<posit<32,2>, cfloat<32,8,uint32_t,true,false,false>>(q, c);      // remap
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <universal/utility/bit_cast.hpp>
+#include <universal/number/convert/universal_convert.hpp>
+#include <universal/number/posit/fast_arithmetic.hpp>
+
+namespace sw { namespace universal {
+
+// the remap decodes posits and fixed-points when their headers are included
+template<unsigned nbits, unsigned es, typename bt> class posit;
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt> class fixpnt;
+
+enum class conversion_strategy { element, table, remap };
+
+////////////////////////////////////////////////////////////////////
+// detail: encodings, layouts and the element-wise reference
+
+namespace detail {
+
+	// the value of one element, converted the way a caller would convert it by hand
+	template<typename Dst, typename Src>
+	inline Dst convert_element(const Src& src) {
+		if constexpr (UniversalNumber<Src> && UniversalNumber<Dst>) {
+			return universal_cast<Dst>(src);
+		}
+		else if constexpr (std::is_arithmetic_v<Dst>) {
+			return static_cast<Dst>(src);
+		}
+		else {
+			return Dst(src);
+		}
+	}
+
+	// types whose bit pattern can be read as an unsigned integer: the blocked types (cfloat, lns,
+	// takum) expose their storage blocks, posit and fixpnt return their blockbinary from bits(),
+	// and the single-word types (bfloat16, microfloat) return an integer from bits()
+	template<typename T>
+	concept HasBlocks = requires(const T& v) {
+		{ v.block(0u) } -> std::convertible_to<std::uint64_t>;
+		T::nrBlocks;
+		T::bitsInBlock;
+	};
+	template<typename T>
+	concept HasBlockedBits = requires(const T& v) {
+		{ v.bits().block(0u) } -> std::convertible_to<std::uint64_t>;
+		std::remove_cvref_t<decltype(v.bits())>::nrBlocks;
+		std::remove_cvref_t<decltype(v.bits())>::bitsInBlock;
+	};
+	template<typename T>
+	concept HasBitsWord = requires(const T& v) { { v.bits() } -> std::integral; };
+
+	template<typename T>
+	concept EncodedNumber = UniversalNumber<T> && requires(T& v) { T::nbits; v.setbits(0u); }
+		&& (HasBlocks<T> || HasBlockedBits<T> || HasBitsWord<T>);
+
+	// few enough encodings to tabulate
+	template<typename T>
+	concept NarrowEncodedNumber = EncodedNumber<T> && (T::nbits <= 16);
+
+	template<typename Blocks>
+	inline std::uint64_t assemble_blocks(const Blocks& v) noexcept {
+		std::uint64_t raw{ 0 };
+		for (unsigned b = 0; b < Blocks::nrBlocks && b * Blocks::bitsInBlock < 64; ++b) {
+			raw |= static_cast<std::uint64_t>(v.block(b)) << (b * Blocks::bitsInBlock);
+		}
+		return raw;
+	}
+
+	template<typename T>
+	inline std::uint64_t encoding_of(const T& v) noexcept {
+		constexpr std::uint64_t mask = (T::nbits >= 64) ? ~0ull : ((1ull << T::nbits) - 1ull);
+		if constexpr (HasBlocks<T>) {
+			return assemble_blocks(v) & mask;
+		}
+		else if constexpr (HasBlockedBits<T>) {
+			return assemble_blocks(v.bits()) & mask;
+		}
+		else {
+			return static_cast<std::uint64_t>(v.bits()) & mask;
+		}
+	}
+
+	// The IEEE-754 binary interchange layout: sign, es exponent bits with bias 2^(es-1) - 1, fbits
+	// fraction bits, subnormals at exponent field zero, and the all-ones exponent field reserved.
+	template<typename T>
+	struct ieee_binary_layout : std::false_type {};
+
+	template<>
+	struct ieee_binary_layout<float> : std::true_type {
+		static constexpr unsigned nbits = 32, es = 8, fbits = 23;
+		static std::uint64_t get(float v) noexcept { return sw::bit_cast<std::uint32_t>(v); }
+		static void set(float& v, std::uint64_t raw) noexcept { v = sw::bit_cast<float>(static_cast<std::uint32_t>(raw)); }
+	};
+
+	template<>
+	struct ieee_binary_layout<double> : std::true_type {
+		static constexpr unsigned nbits = 64, es = 11, fbits = 52;
+		static std::uint64_t get(double v) noexcept { return sw::bit_cast<std::uint64_t>(v); }
+		static void set(double& v, std::uint64_t raw) noexcept { v = sw::bit_cast<double>(raw); }
+	};
+
+	// cfloat matches the layout for finite values when it has subnormals, no max-exponent values
+	// and does not saturate; it encodes infinity differently, which the remap never produces
+	template<typename T>
+	concept IeeeLikeCfloat = HasBlocks<T> && requires(T& v) {
+		v.setbits(std::uint64_t{ 0 });
+		requires T::hasSubnormals;
+		requires !T::hasMaxExpValues;
+		requires !T::isSaturating;
+		requires T::nbits <= 64;
+		requires T::es >= 2;
+		requires T::fbits + T::es + 1 == T::nbits;
+	};
+
+	template<IeeeLikeCfloat T>
+	struct ieee_binary_layout<T> : std::true_type {
+		static constexpr unsigned nbits = T::nbits, es = T::es, fbits = T::fbits;
+		static std::uint64_t get(const T& v) noexcept { return encoding_of(v); }
+		static void set(T& v, std::uint64_t raw) noexcept { v.setbits(raw); }
+	};
+
+	// The fields of a value as a word_triple, value = significand * 2^(scale - msb(significand)), for
+	// the types the remap decodes or encodes with integer operations. digits, maxScale and minLsb bound
+	// the finite values: the widest significand, the largest scale, and the scale of the smallest lsb.
+	template<typename T>
+	struct word_fields {
+		static constexpr bool decodes = false;
+		static constexpr bool encodes = false;
+	};
+
+	template<typename T>
+		requires ieee_binary_layout<T>::value
+	struct word_fields<T> {
+		using L = ieee_binary_layout<T>;
+		static constexpr bool decodes = true;
+		static constexpr bool encodes = true;
+		static constexpr bool nativeThroughLongDouble = false;
+		static constexpr int bias = (1 << (L::es - 1)) - 1;
+		static constexpr int digits = static_cast<int>(L::fbits) + 1;
+		static constexpr int maxScale = bias;
+		static constexpr int minLsb = 1 - bias - static_cast<int>(L::fbits);
+		static constexpr std::uint64_t expMax = (1ull << L::es) - 1ull;
+
+		// zero and non-finite values return false
+		static bool decode(const T& v, support::word_triple& t) noexcept {
+			const std::uint64_t raw = L::get(v);
+			const std::uint64_t e = (raw >> L::fbits) & expMax;
+			const std::uint64_t f = raw & ((1ull << L::fbits) - 1ull);
+			if (e == expMax || (e == 0 && f == 0)) return false;
+			// the hidden bit made explicit
+			t.sign = ((raw >> (L::nbits - 1)) & 1ull) != 0;
+			t.significand = (e == 0) ? f : (f | (1ull << L::fbits));
+			int lsb = (e == 0 ? 1 : static_cast<int>(e)) - bias - static_cast<int>(L::fbits);
+			t.scale = lsb + static_cast<int>(std::bit_width(t.significand)) - 1;
+			return true;
+		}
+
+		// rounds to nearest even; results that are zero or overflow return false
+		static bool encode(const support::word_triple& t, T& v) noexcept {
+			const std::uint64_t m = t.significand;
+			const int lsb = t.scale - (static_cast<int>(std::bit_width(m)) - 1);
+
+			// the scale of the lsb of the destination significand, and the bits to drop to reach it
+			int qlsb = t.scale - static_cast<int>(L::fbits);
+			if (qlsb < minLsb) qlsb = minLsb;
+			int shift = qlsb - lsb;
+			std::uint64_t r;
+			if (shift <= 0) {
+				r = m << (-shift);
+			}
+			else if (shift < 64) {
+				r = m >> shift;
+				std::uint64_t rem = m & ((1ull << shift) - 1ull);
+				std::uint64_t half = 1ull << (shift - 1);
+				if (rem > half || (rem == half && (r & 1ull))) ++r;
+			}
+			else {
+				return false;
+			}
+			if (r == 0) return false;
+
+			// r = 2^fbits + fraction for normals, r < 2^fbits for subnormals; adding the exponent field
+			// one below the target lets a rounding carry out of the fraction bump the exponent
+			std::uint64_t biased = static_cast<std::uint64_t>(qlsb - minLsb);
+			std::uint64_t enc = (biased << L::fbits) + r;
+			if ((enc >> L::fbits) >= expMax) return false;
+			L::set(v, enc | (static_cast<std::uint64_t>(t.sign) << (L::nbits - 1)));
+			return true;
+		}
+	};
+
+	// posits of at most 64 bits run on the decoder and the rounding of their word arithmetic
+	template<unsigned nbits, unsigned es, typename bt>
+		requires posit_fast_arithmetic<posit<nbits, es, bt>>::integer
+	struct word_fields<posit<nbits, es, bt>> {
+		using P    = posit<nbits, es, bt>;
+		using Fast = posit_fast_arithmetic<P>;
+		static constexpr bool decodes = true;
+		static constexpr bool encodes = true;
+		static constexpr bool nativeThroughLongDouble = true;  // to_native() scales the exact value in long double
+		static constexpr int digits = static_cast<int>(P::fbits) + 1;
+		static constexpr int maxScale = static_cast<int>(nbits - 2u) * (1 << es);
+		static constexpr int minLsb = -maxScale;
+
+		// zero and NaR return false
+		static bool decode(const P& v, support::word_triple& t) noexcept { return Fast::decode(Fast::bits(v), t); }
+
+		// rounds to nearest even, and projects onto minpos and maxpos like the conversion from a native float
+		static bool encode(const support::word_triple& t, P& v) noexcept {
+			v.setbits(Fast::round(t));
+			return true;
+		}
+	};
+
+	// fixed-points of at most 64 bits decode the magnitude of their two's complement word
+	template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+		requires (nbits <= 64)
+	struct word_fields<fixpnt<nbits, rbits, arithmetic, bt>> {
+		using F = fixpnt<nbits, rbits, arithmetic, bt>;
+		static constexpr bool decodes = true;
+		static constexpr bool encodes = false;
+		static constexpr bool nativeThroughLongDouble = false;
+		static constexpr int digits = static_cast<int>(nbits) - 1;
+		static constexpr int maxScale = static_cast<int>(nbits) - 1 - static_cast<int>(rbits);
+		static constexpr int minLsb = -static_cast<int>(rbits);
+
+		// zero returns false
+		static bool decode(const F& v, support::word_triple& t) noexcept {
+			constexpr std::uint64_t mask = (nbits >= 64) ? ~0ull : ((1ull << nbits) - 1ull);
+			const std::uint64_t raw = encoding_of(v);
+			t.sign = ((raw >> (nbits - 1)) & 1ull) != 0;
+			t.significand = t.sign ? ((0ull - raw) & mask) : raw;
+			if (t.significand == 0) return false;
+			t.scale = static_cast<int>(std::bit_width(t.significand)) - 1 - static_cast<int>(rbits);
+			return true;
+		}
+	};
+
+	// every finite value of T is a value of the native Real
+	template<typename Real, typename T>
+	inline constexpr bool holds_exactly_v = word_fields<T>::digits <= std::numeric_limits<Real>::digits
+		&& word_fields<T>::maxScale < std::numeric_limits<Real>::max_exponent
+		&& word_fields<T>::minLsb >= std::numeric_limits<Real>::min_exponent - std::numeric_limits<Real>::digits;
+
+	// The remap rounds the exact source value once, so it reproduces the element-wise conversion where
+	// that rounds once too. Dst(src) of a native source does. universal_cast passes the value through
+	// a double or a long double, which has to hold it exactly. A native destination is reached through
+	// the source's own conversion, which is exact when the destination holds every source value, and
+	// for posit is a single rounding of the exact value in long double.
+	template<typename Src, typename Dst>
+	constexpr bool remap_reproduces_element() {
+		if constexpr (std::is_same_v<Src, Dst> || !word_fields<Src>::decodes || !word_fields<Dst>::encodes) {
+			return false;
+		}
+		else if constexpr (!UniversalNumber<Src>) {
+			return true;
+		}
+		else if constexpr (UniversalNumber<Dst>) {
+			constexpr unsigned maxPrec = (precision_bits_v<Src> > precision_bits_v<Dst>) ? precision_bits_v<Src> : precision_bits_v<Dst>;
+			using Real = std::conditional_t<(maxPrec <= 52u), double, long double>;
+			return holds_exactly_v<Real, Src>;
+		}
+		else {
+			return holds_exactly_v<Dst, Src> || (word_fields<Src>::nativeThroughLongDouble && holds_exactly_v<long double, Src>);
+		}
+	}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////
+// strategy selection
+
+template<typename Src, typename Dst>
+inline constexpr bool conversion_table_available_v = detail::NarrowEncodedNumber<Src>;
+
+template<typename Src, typename Dst>
+inline constexpr bool conversion_remap_available_v = detail::remap_reproduces_element<Src, Dst>();
+
+template<typename Src, typename Dst>
+inline constexpr conversion_strategy default_conversion_strategy_v =
+	conversion_table_available_v<Src, Dst> ? conversion_strategy::table
+	: (conversion_remap_available_v<Src, Dst> ? conversion_strategy::remap : conversion_strategy::element);
+
+////////////////////////////////////////////////////////////////////
+// conversion_table: every encoding of a narrow Src, converted to Dst
+
+template<typename Src, typename Dst>
+	requires conversion_table_available_v<Src, Dst>
+class conversion_table {
+public:
+	static constexpr std::size_t nrEntries = std::size_t(1) << Src::nbits;
+
+	// the table for the pair, built on first use
+	static const conversion_table& instance() {
+		static const conversion_table table;
+		return table;
+	}
+
+	const Dst& operator[](std::uint64_t encoding) const noexcept { return _entries[encoding]; }
+	std::size_t size() const noexcept { return nrEntries; }
+
+private:
+	conversion_table() : _entries(nrEntries) {
+		Src s{};
+		for (std::size_t i = 0; i < nrEntries; ++i) {
+			s.setbits(i);
+			_entries[i] = detail::convert_element<Dst>(s);
+		}
+	}
+
+	std::vector<Dst> _entries;
+};
+
+////////////////////////////////////////////////////////////////////
+// convert_span: dst[i] = Src -> Dst conversion of src[i], for i < src.size()
+
+template<typename Src, typename Dst, conversion_strategy strategy = default_conversion_strategy_v<Src, Dst>>
+inline void convert_span(std::span<const Src> src, std::span<Dst> dst) {
+	assert(dst.size() >= src.size());
+	const std::size_t n = src.size();
+	if constexpr (strategy == conversion_strategy::table) {
+		static_assert(conversion_table_available_v<Src, Dst>, "convert_span: table strategy requires a source of at most 16 bits with an accessible encoding");
+		const conversion_table<Src, Dst>& table = conversion_table<Src, Dst>::instance();
+		for (std::size_t i = 0; i < n; ++i) dst[i] = table[detail::encoding_of(src[i])];
+	}
+	else if constexpr (strategy == conversion_strategy::remap) {
+		static_assert(conversion_remap_available_v<Src, Dst>, "convert_span: remap strategy requires a source with word fields, a destination that encodes them, and an element-wise conversion that rounds once");
+		using S = detail::word_fields<Src>;
+		using D = detail::word_fields<Dst>;
+		for (std::size_t i = 0; i < n; ++i) {
+			support::word_triple t;
+			if (!S::decode(src[i], t) || !D::encode(t, dst[i])) {
+				dst[i] = detail::convert_element<Dst>(src[i]);
+			}
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) dst[i] = detail::convert_element<Dst>(src[i]);
+	}
+}
+
+// convenience overload for std::vector, sizing the destination
+template<typename Src, typename Dst, conversion_strategy strategy = default_conversion_strategy_v<Src, Dst>>
+inline void convert_span(const std::vector<Src>& src, std::vector<Dst>& dst) {
+	dst.resize(src.size());
+	convert_span<Src, Dst, strategy>(std::span<const Src>(src), std::span<Dst>(dst));
+}
+
+}} // namespace sw::universal
@@ -16,18 +16,226 @@
 
 namespace sw { namespace universal {
 
+/////////////////////////////////////////////////////////////////////////////////////
+// magnitude arithmetic on little-endian arrays of base 10^9 limbs
+//
+// A limb holds nine decimal digits, so a limb product fits in 60 bits and a product plus two
+// limbs of carry still fits a uint64_t. The functions do not allocate unless noted and accept
+// operands with leading zero limbs.
+namespace decimal_limbs {
+
+	using limb = std::uint32_t;
+	constexpr limb     radix = 1'000'000'000u;
+	constexpr unsigned digitsPerLimb = 9;
+	// below this many limbs in the shorter operand schoolbook multiplication is faster
+	constexpr std::size_t karatsubaThreshold = 40;
+
+	// number of limbs without the leading zero limbs
+	inline std::size_t significant(const limb* a, std::size_t n) noexcept {
+		while (n > 0 && a[n - 1] == 0) --n;
+		return n;
+	}
+
+	// -1, 0, +1 as |a| <, ==, > |b|
+	inline int compare(const limb* a, std::size_t an, const limb* b, std::size_t bn) noexcept {
+		an = significant(a, an);
+		bn = significant(b, bn);
+		if (an != bn) return an < bn ? -1 : 1;
+		for (std::size_t i = an; i-- > 0; ) {
+			if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	// a[0..an) += b[0..bn), an >= bn; returns the carry out of a[an-1]
+	inline limb add_in_place(limb* a, std::size_t an, const limb* b, std::size_t bn) noexcept {
+		limb carry = 0;
+		std::size_t i = 0;
+		for (; i < bn; ++i) {
+			limb s = a[i] + b[i] + carry;   // < 2 * radix, no overflow of 32 bits
+			carry = (s >= radix) ? 1u : 0u;
+			a[i] = carry ? s - radix : s;
+		}
+		for (; carry && i < an; ++i) {
+			limb s = a[i] + carry;
+			carry = (s >= radix) ? 1u : 0u;
+			a[i] = carry ? s - radix : s;
+		}
+		return carry;
+	}
+
+	// a[0..an) -= b[0..bn), |a| >= |b|, an >= bn
+	inline void sub_in_place(limb* a, std::size_t an, const limb* b, std::size_t bn) noexcept {
+		limb borrow = 0;
+		std::size_t i = 0;
+		for (; i < bn; ++i) {
+			limb sub = b[i] + borrow;
+			borrow = (a[i] < sub) ? 1u : 0u;
+			a[i] = borrow ? a[i] + radix - sub : a[i] - sub;
+		}
+		for (; borrow && i < an; ++i) {
+			borrow = (a[i] == 0) ? 1u : 0u;
+			a[i] = borrow ? radix - 1 : a[i] - 1;
+		}
+	}
+
+	// a[0..an) *= m, m < radix; returns the carry limb
+	inline limb mul_small(limb* a, std::size_t an, limb m) noexcept {
+		std::uint64_t carry = 0;
+		for (std::size_t i = 0; i < an; ++i) {
+			std::uint64_t t = std::uint64_t(a[i]) * m + carry;
+			a[i] = static_cast<limb>(t % radix);
+			carry = t / radix;
+		}
+		return static_cast<limb>(carry);
+	}
+
+	// a[0..an) /= d, 0 < d < radix; returns the remainder
+	inline limb divmod_small(limb* a, std::size_t an, limb d) noexcept {
+		std::uint64_t rem = 0;
+		for (std::size_t i = an; i-- > 0; ) {
+			std::uint64_t cur = rem * radix + a[i];
+			a[i] = static_cast<limb>(cur / d);
+			rem = cur % d;
+		}
+		return static_cast<limb>(rem);
+	}
+
+	// r[0..an+bn) = a * b
+	inline void mul_schoolbook(const limb* a, std::size_t an, const limb* b, std::size_t bn, limb* r) noexcept {
+		std::fill(r, r + an + bn, limb(0));
+		for (std::size_t i = 0; i < an; ++i) {
+			const std::uint64_t ai = a[i];
+			if (ai == 0) continue;
+			std::uint64_t carry = 0;
+			for (std::size_t j = 0; j < bn; ++j) {
+				std::uint64_t t = ai * b[j] + r[i + j] + carry;
+				r[i + j] = static_cast<limb>(t % radix);
+				carry = t / radix;
+			}
+			r[i + bn] = static_cast<limb>(carry);
+		}
+	}
+
+	// r[0..an+bn) = a * b, Karatsuba above the threshold; allocates its temporaries
+	inline void mul(const limb* a, std::size_t an, const limb* b, std::size_t bn, limb* r) {
+		if (an < bn) {
+			std::swap(a, b);
+			std::swap(an, bn);
+		}
+		if (bn < karatsubaThreshold) {
+			mul_schoolbook(a, an, b, bn, r);
+			return;
+		}
+		if (an >= 2 * bn) {
+			// unbalanced: multiply b by slices of a of its own length
+			std::fill(r, r + an + bn, limb(0));
+			std::vector<limb> t(2 * bn);
+			for (std::size_t off = 0; off < an; off += bn) {
+				std::size_t len = std::min(bn, an - off);
+				mul(a + off, len, b, bn, t.data());
+				add_in_place(r + off, an + bn - off, t.data(), len + bn);
+			}
+			return;
+		}
+		// a = a1 B^m + a0, b = b1 B^m + b0, and bn > m
+		const std::size_t m = an / 2;
+		const limb* a0 = a;     const std::size_t a0n = m;
+		const limb* a1 = a + m; const std::size_t a1n = an - m;
+		const limb* b0 = b;     const std::size_t b0n = m;
+		const limb* b1 = b + m; const std::size_t b1n = bn - m;
+
+		std::vector<limb> sa(a1n + 1, 0), sb(std::max(b0n, b1n) + 1, 0);
+		std::copy(a1, a1 + a1n, sa.begin());
+		sa[a1n] = add_in_place(sa.data(), a1n, a0, a0n);
+		std::copy(b0, b0 + b0n, sb.begin());
+		sb[sb.size() - 1] = add_in_place(sb.data(), sb.size() - 1, b1, b1n);
+
+		std::vector<limb> z1(sa.size() + sb.size());
+		mul(sa.data(), sa.size(), sb.data(), sb.size(), z1.data());
+
+		// z0 and z2 land in place, z1 - z0 - z2 is added in at m
+		mul(a0, a0n, b0, b0n, r);
+		mul(a1, a1n, b1, b1n, r + 2 * m);
+		std::size_t z1n = significant(z1.data(), z1.size());
+		sub_in_place(z1.data(), z1n, r, significant(r, 2 * m));
+		sub_in_place(z1.data(), z1n, r + 2 * m, significant(r + 2 * m, a1n + b1n));
+		z1n = significant(z1.data(), z1n);
+		add_in_place(r + m, an + bn - m, z1.data(), z1n);
+	}
+
+	// q[0..an-bn+1) = a / b, r[0..bn) = a % b, with b[bn-1] != 0 and an >= bn >= 2
+	// Knuth, TAOCP vol. 2, 4.3.1, Algorithm D, in radix 10^9
+	inline void divmod(const limb* a, std::size_t an, const limb* b, std::size_t bn, limb* q, limb* r) {
+		// scale both operands so the leading divisor limb is at least radix/2
+		const limb d = radix / (b[bn - 1] + 1);
+		std::vector<limb> u(a, a + an), v(b, b + bn);
+		u.push_back(mul_small(u.data(), an, d));
+		mul_small(v.data(), bn, d);
+		const std::uint64_t vtop = v[bn - 1], vnext = v[bn - 2];
+
+		for (std::size_t j = an - bn + 1; j-- > 0; ) {
+			std::uint64_t num = std::uint64_t(u[j + bn]) * radix + u[j + bn - 1];
+			std::uint64_t qhat = num / vtop;
+			std::uint64_t rhat = num % vtop;
+			while (qhat >= radix || qhat * vnext > rhat * radix + u[j + bn - 2]) {
+				--qhat;
+				rhat += vtop;
+				if (rhat >= radix) break;
+			}
+			// u[j..j+bn] -= qhat * v
+			std::uint64_t carry = 0;
+			std::int64_t borrow = 0;
+			for (std::size_t i = 0; i < bn; ++i) {
+				std::uint64_t p = qhat * v[i] + carry;
+				carry = p / radix;
+				std::int64_t t = std::int64_t(u[i + j]) - std::int64_t(p % radix) - borrow;
+				borrow = (t < 0) ? 1 : 0;
+				u[i + j] = static_cast<limb>(t < 0 ? t + radix : t);
+			}
+			std::int64_t t = std::int64_t(u[j + bn]) - std::int64_t(carry) - borrow;
+			if (t < 0) {
+				// qhat was one too large: add v back
+				u[j + bn] = static_cast<limb>(t + radix);
+				--qhat;
+				limb c = add_in_place(u.data() + j, bn, v.data(), bn);
+				u[j + bn] = (u[j + bn] + c) % radix;
+			}
+			else {
+				u[j + bn] = static_cast<limb>(t);
+			}
+			q[j] = static_cast<limb>(qhat);
+		}
+		divmod_small(u.data(), bn, d);
+		std::copy(u.begin(), u.begin() + static_cast<std::ptrdiff_t>(bn), r);
+	}
+
+	// 10^k for k < digitsPerLimb
+	inline limb pow10(unsigned k) noexcept {
+		limb p = 1;
+		while (k-- > 0) p *= 10;
+		return p;
+	}
+
+} // namespace decimal_limbs
+
 /// <summary>
 /// Adaptive precision decimal integer number type
 /// </summary>
-/// The digits are managed as a vector with the digit for 10^0 stored at index 0, 10^1 stored at index 1, etc.
-class edecimal : public std::vector<uint8_t> {
+/// The magnitude is stored in base 10^9 limbs, the limb holding 10^0..10^8 at index 0, the limb holding
+/// 10^9..10^17 at index 1, etc. Use nrDigits() and digit() for the decimal digits.
+class edecimal : public std::vector<std::uint32_t> {
 #if EDECIMAL_OPERATIONS_COUNT
 	static bool enableAdd;
 	static occurrence<edecimal> ops;
 #endif
 public:
+	using limb = decimal_limbs::limb;
+	static constexpr limb     radix = decimal_limbs::radix;
+	static constexpr unsigned digitsPerLimb = decimal_limbs::digitsPerLimb;
+
 	// Partial-constexpr surface (issue #746): edecimal inherits from
-	// std::vector<uint8_t>, so any non-empty vector escapes constant
+	// std::vector<uint32_t>, so any non-empty vector escapes constant
 	// evaluation under C++20's transient-allocation rules.  The default
 	// ctor uses is_constant_evaluated() to keep two parallel invariants:
 	// at constant evaluation the vector is empty (canonical constexpr
@@ -35,9 +243,9 @@ public:
 	// runtime push_back(0) restores the historical "size() == 1, [0] == 0"
 	// representation that comparison and arithmetic operators rely on.
 	// Sign-only selectors/modifiers operate purely on the bool member and
-	// are constexpr-clean.  All digit-mutating paths (setzero, setdigit,
+	// are constexpr-clean.  All limb-mutating paths (setzero, setdigit,
 	// arithmetic, conversion-out) remain non-constexpr until C++23.
-	constexpr edecimal() noexcept : std::vector<uint8_t>(), negative{ false } {
+	constexpr edecimal() noexcept : std::vector<std::uint32_t>(), negative{ false } {
 		if (!std::is_constant_evaluated()) {
 			push_back(0);
 		}
@@ -89,84 +297,44 @@ public:
 
 	// arithmetic operators
 	edecimal& operator+=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
+		if (this == &rhs) {
+			edecimal _rhs(rhs);
+			return operator+=(_rhs);
+		}
 		if (negative != rhs.negative) {  // different signs
+			edecimal _rhs(rhs);
 			_rhs.setsign(!rhs.sign());
 			return operator-=(_rhs);
 		}
-		else {
-			// same sign implies this->negative is invariant
-		}
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
-		}
-		else {
-			_rhs.insert(_rhs.end(), l - r, 0);
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t carry = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			*lit += *rit + carry;
-			if (*lit > 9) {
-				carry = 1;
-				*lit -= 10;
-			}
-			else {
-				carry = 0;
-			}
-		}
-		if (carry) push_back(1);
+		// same sign implies this->negative is invariant
+		if (size() < rhs.size()) resize(rhs.size(), 0);
+		if (decimal_limbs::add_in_place(data(), size(), rhs.data(), rhs.size())) push_back(1);
 #if EDECIMAL_OPERATIONS_COUNT
 		if (enableAdd) ++ops.add;
 #endif
 		return *this;
 	}
 	edecimal& operator-=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
-		bool sign = this->sign();
+		if (this == &rhs) {
+			setzero();
+			return *this;
+		}
 		if (negative != rhs.negative) {
+			edecimal _rhs(rhs);
 			_rhs.setsign(!rhs.sign());
 			return operator+=(_rhs);
 		}
-		// largest value must be subtracted from
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
-			std::swap(*this, _rhs);
-			sign = !sign;
-		}
-		else if (r < l) {
-			_rhs.insert(_rhs.end(), l - r, 0);
+		// subtract the smaller magnitude from the larger one
+		bool sign = this->sign();
+		if (decimal_limbs::compare(data(), size(), rhs.data(), rhs.size()) >= 0) {
+			decimal_limbs::sub_in_place(data(), size(), rhs.data(), rhs.size());
 		}
 		else {
-			// the operands are the same size, thus we need to check their magnitude
-			this->setpos();
-			_rhs.setpos();
-			if (*this < _rhs) {
-				std::swap(*this, _rhs);
-				sign = !sign;
-			}
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t borrow = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			if (*rit > *lit - borrow) {
-				*lit = static_cast<uint8_t>(10 + *lit - borrow - *rit);
-				borrow = 1;
-			}
-			else {
-				*lit = static_cast<uint8_t>(*lit - borrow - *rit);
-				borrow = 0;
-			}
+			edecimal larger(rhs);
+			decimal_limbs::sub_in_place(larger.data(), larger.size(), data(), size());
+			swap(larger);
+			sign = !sign;
 		}
-		if (borrow) std::cout << "can this happen?" << std::endl;
 		unpad();
 		if (this->iszero()) { // special case of zero having positive sign
 			this->setpos();
@@ -190,54 +358,12 @@ public:
 		}
 		bool signOfFinalResult = (negative != rhs.negative) ? true : false;
 		edecimal product;
-#if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = false;
-#endif
-		// find the smallest edecimal to minimize the amount of work
-		size_t l = size();
-		size_t r = rhs.size();
-		edecimal::const_iterator sit, bit; // sit = smallest iterator, bit = biggest iterator
-		if (l < r) {
-			int64_t position = 0;
-			for (sit = begin(); sit != end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), r + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = rhs.begin(); bit != rhs.end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
-		else {
-			int64_t position = 0;
-			for (sit = rhs.begin(); sit != rhs.end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), l + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = begin(); bit != end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
+		product.resize(size() + rhs.size());
+		decimal_limbs::mul(data(), size(), rhs.data(), rhs.size(), product.data());
 		product.unpad();
-		*this = product;
+		swap(product);
 		setsign(signOfFinalResult);
 #if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = true;
 		++ops.mul;
 #endif
 		return *this;
@@ -256,28 +382,37 @@ public:
 #endif
 		return *this;
 	}
+	// shift by decimal digits: multiply by 10^shift
 	edecimal& operator<<=(int shift) {
 		if (shift == 0) return *this;
 		if (shift < 0) {
 			return operator>>=(-shift);
 		}
-		for (int i = 0; i < shift; ++i) {
-			this->insert(this->begin(), 0);
+		if (iszero()) return *this;
+		unsigned limbShift = static_cast<unsigned>(shift) / digitsPerLimb;
+		unsigned digitShift = static_cast<unsigned>(shift) % digitsPerLimb;
+		if (digitShift > 0) {
+			limb carry = decimal_limbs::mul_small(data(), size(), decimal_limbs::pow10(digitShift));
+			if (carry) push_back(carry);
 		}
+		insert(begin(), limbShift, 0);
 		return *this;
 	}
+	// shift by decimal digits: divide by 10^shift, truncating
 	edecimal& operator>>=(int shift) {
 		if (shift == 0) return *this;
 		if (shift < 0) {
 			return operator<<=(-shift);
 		}
-		if (signed(size()) <= shift) {
+		if (signed(nrDigits()) <= shift) {
 			this->setzero();
 		}
 		else {
-			for (int i = 0; i < shift; ++i) {
-				this->erase(this->begin());
-			}
+			unsigned limbShift = static_cast<unsigned>(shift) / digitsPerLimb;
+			unsigned digitShift = static_cast<unsigned>(shift) % digitsPerLimb;
+			erase(begin(), begin() + limbShift);
+			if (digitShift > 0) decimal_limbs::divmod_small(data(), size(), decimal_limbs::pow10(digitShift));
+			unpad();
 		}
 		return *this;
 	}
@@ -330,7 +465,7 @@ public:
 
 	// selectors
 	// iszero() is constexpr-callable on the default-constructed (empty) state;
-	// once any digit-mutating op runs, the vector heap-escapes and constexpr
+	// once any limb-mutating op runs, the vector heap-escapes and constexpr
 	// usage is no longer permitted on the resulting object (C++20).
 	constexpr bool iszero() const noexcept {
 		if (size() == 0) return true;
@@ -343,6 +478,21 @@ public:
 	constexpr bool isneg() const noexcept { return negative; }   // <  0
 	constexpr bool ispos() const noexcept { return !negative; }  // >= 0
 
+	// number of decimal digits of the magnitude, 1 for zero
+	std::size_t nrDigits() const noexcept {
+		std::size_t n = decimal_limbs::significant(data(), size());
+		if (n == 0) return 1;
+		std::size_t digits = (n - 1) * digitsPerLimb;
+		for (limb top = operator[](n - 1); top > 0; top /= 10) ++digits;
+		return digits;
+	}
+	// decimal digit i, the digit of 10^i
+	std::uint8_t digit(std::size_t i) const noexcept {
+		std::size_t l = i / digitsPerLimb;
+		if (l >= size()) return 0;
+		return static_cast<std::uint8_t>((operator[](l) / decimal_limbs::pow10(static_cast<unsigned>(i % digitsPerLimb))) % 10);
+	}
+
 	// modifiers
 	inline void setzero() { clear(); push_back(0); negative = false; }
 	constexpr void setsign(bool sign) noexcept { negative = sign; }
@@ -356,17 +506,10 @@ public:
 	}
 	inline void setbits(uint64_t v) { *this = v; } // API to be consistent with the other number systems
 
-	// remove any leading zeros from a edecimal representation
+	// remove any leading zero limbs from a edecimal representation
 	void unpad() {
-		int n = (int)size();
-		for (int i = n - 1; i > 0; --i) {
-			if (operator[](static_cast<size_t>(i)) == 0) {
-				pop_back();
-			}
-			else {
-				return;  // found the most significant digit
-			}
-		}
+		while (size() > 1 && back() == 0) pop_back();
+		if (empty()) push_back(0);
 	}
 
 	// read an ASCII decimal literal and make an edecimal value out of it.
@@ -383,11 +526,10 @@ public:
 	bool parse(const std::string& _digits) {
 		// Defensive cap on the resulting digit count.  scan_decimal_float
 		// returns an int32 exponent, so an input like "1e2000000000" would
-		// otherwise expand to two billion zeros (~2 GB of vector storage)
-		// inside a parse call.  This bound caps the post-expansion size at
-		// ~1 MiB of digit storage and keeps parse a cheap operation.  The
-		// limit is far above any practical decimal literal a user would
-		// type by hand or generate from a roundtrip.
+		// otherwise expand to two billion zeros inside a parse call.  This
+		// bound caps the post-expansion size at ~1M digits and keeps parse a
+		// cheap operation.  The limit is far above any practical decimal
+		// literal a user would type by hand or generate from a roundtrip.
 		constexpr std::size_t MAX_DIGITS = 1u << 20;  // 1,048,576
 
 		std::string digits(_digits);
@@ -411,27 +553,31 @@ public:
 		                           + static_cast<std::uint64_t>(eff_exp);
 		if (total_digits > MAX_DIGITS) return false;
 
+		// Significand digits, most significant first, packed nine to a limb
+		// from the least significant end.
+		std::string sig(scan.int_part);
+		sig.append(scan.frac_part);
 		clear();
-		reserve(static_cast<std::size_t>(total_digits));
-		// Push significand digits in high-to-low order (matches the
-		// pre-existing pattern), then reverse so _digits[0] holds 10^0.
-		for (char c : scan.int_part)  push_back(static_cast<std::uint8_t>(c - '0'));
-		for (char c : scan.frac_part) push_back(static_cast<std::uint8_t>(c - '0'));
-		// Trailing zeros from the exponent: "1.5e10" with eff_exp = 9
-		// becomes "15" + 9 zeros = "15000000000".
-		insert(end(), static_cast<std::size_t>(eff_exp), std::uint8_t{0});
-
+		reserve(sig.size() / digitsPerLimb + 1);
+		for (std::size_t end = sig.size(); end > 0; ) {
+			std::size_t start = (end > digitsPerLimb) ? end - digitsPerLimb : 0;
+			limb l = 0;
+			for (std::size_t i = start; i < end; ++i) l = l * 10 + static_cast<limb>(sig[i] - '0');
+			push_back(l);
+			end = start;
+		}
 		// Empty significand (defensive; scan_decimal_float requires at least
 		// one digit somewhere, so this shouldn't fire on valid output).
 		if (empty()) push_back(0);
-
-		std::reverse(begin(), end());
 		// Strip high-order zeros so "0042" / "0.0042e4" stay normalized,
 		// and any all-zero representation collapses to a single [0].
 		unpad();
+		// Trailing zeros from the exponent: "1.5e10" with eff_exp = 9
+		// becomes "15" + 9 zeros = "15000000000".
+		*this <<= static_cast<int>(eff_exp);
 		setsign(scan.negative);
 		// No negative zero: "-0", "-0.0e5", etc. all parse to +0.
-		if (size() == 1 && operator[](0) == 0) setpos();
+		if (iszero()) setpos();
 		return true;
 	}
 
@@ -453,12 +599,12 @@ protected:
 	inline int                to_int()         const noexcept { return short(to_long_long()); }
 	inline long               to_long()        const noexcept { return short(to_long_long()); }
 	inline long long          to_long_long()   const noexcept {
-		// Horner's method: accumulate from most-significant digit
-		long long v = 0;
+		// Horner's method: accumulate from most-significant limb, modulo 2^64
+		unsigned long long v = 0;
 		for (edecimal::const_reverse_iterator rit = this->rbegin(); rit != this->rend(); ++rit) {
-			v = v * 10 + *rit;
+			v = v * radix + *rit;
 		}
-		return sign() ? -v : v;
+		return sign() ? static_cast<long long>(0ull - v) : static_cast<long long>(v);
 	}
 	inline unsigned short     to_ushort()      const noexcept { return static_cast<unsigned short>(to_ulong_long()); }
 	inline unsigned int       to_uint()        const noexcept { return static_cast<unsigned int>(to_ulong_long()); }
@@ -473,100 +619,71 @@ protected:
 		return static_cast<double>(to_long_double());
 	}
 	inline long double        to_long_double() const noexcept {
-		// Horner's method: accumulate from most-significant digit
+		// Horner's method: accumulate from the most-significant digit, one digit per step,
+		// so every partial result rounds the same way independent of the limb size
 		long double ld = 0.0l;
-		for (edecimal::const_reverse_iterator rit = this->rbegin(); rit != this->rend(); ++rit) {
-			ld = ld * 10.0l + *rit;
+		for (std::size_t i = nrDigits(); i-- > 0; ) {
+			ld = ld * 10.0l + digit(i);
 		}
 		return sign() ? -ld : ld;
 	}
 
 	// Convert integer types to a edecimal representation
-// TODO: needs SFINAE enable_if to constrain it to native integer types
 	template<typename Ty>
 	edecimal& convert_integer(Ty v) {
-		using namespace std;
-		//cout << numeric_limits<Ty>::digits << " max value " << numeric_limits<Ty>::max() << endl;
-		bool sign = false;
+		static_assert(std::is_integral_v<Ty>, "convert_integer requires a native integer type");
 		setzero(); // initialize the edecimal value to 0
 		if (v == 0) return *this;
-		if (numeric_limits<Ty>::is_signed) {
+		bool sign = false;
+		unsigned long long magnitude = static_cast<unsigned long long>(v);
+		if constexpr (std::is_signed_v<Ty>) {
 			if (v < 0) {
-				sign = true; // negative number
-				// transform to sign-magnitude on positive side
-				v *= Ty(-1);
+				sign = true; // negative number, transform to sign-magnitude on positive side
+				magnitude = 0ull - magnitude;
 			}
 		}
-		uint64_t mask = 0x1;
-		// IMPORTANT: can't use initializer or assignment operator as it would yield 
-		// an infinite loop calling convert_integer. So we need to construct the
-		// edecimal from first principals
-		edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-		base.clear();
-		base.push_back(1);
-		while (v) { // minimum loop iterations; exits when no bits left
-			if (v & mask) {
-				*this += base;
-			}
-			base += base;
-			v >>= 1;
+		clear();
+		while (magnitude) {
+			push_back(static_cast<limb>(magnitude % radix));
+			magnitude /= radix;
 		}
 		// lastly, set the sign
 		setsign(sign);
 		return *this;
 	}
+	// truncate toward zero; |rhs| <= 0.5 converts to 0
 	template<typename Ty>
 	edecimal& convert_ieee754(Ty rhs) {
-		clear();
 		if (rhs <= 0.5 && rhs >= -0.5) {
 			return *this = 0;
 		}
-		else {
-			if (rhs < -0.5) negative = true; else negative = false;
-
-			bool s{ false };
-			uint64_t unbiasedExponent{ 0 };
-			uint64_t fraction{ 0 };
-			uint64_t bits{ 0 };
-			extractFields(rhs, s, unbiasedExponent, fraction, bits);
-			// TODO: subnormals
-
-			fraction |= (1ull << ieee754_parameter<Ty>::fbits); // add in the hidden bit
-			// scale up by fbits, convert, and then scale back
-			uint64_t mask = 0x1;
-			edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-			base[0] = 1;
-//			int i = 0;
-			while (fraction) { // minimum loop iterations; exits when no bits left
-//				std::cout << std::setw(3) << i++ << "  base : " << base << '\n';
-				if (fraction & mask) {
-					*this += base;
-				}
-				base += base;
-				fraction >>= 1;
-			}
-//			std::cout << "upconversion : " << *this << " : final bit value: " << base << '\n';
-			int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
-			int upScale = ieee754_parameter<Ty>::fbits;
-			int correction = upScale - scale;
-//			std::cout << "correction = " << correction << " scale = " << scale << " upscale = " << upScale << '\n';
-			if (correction >= 0) {
-				edecimal downConvert;
-				downConvert[0] = 1;
-				for (int i = 0; i < correction; ++i) downConvert += downConvert;
-//				std::cout << "downConvert : " << downConvert << '\n';
-				// divide the factor out
-				*this /= downConvert;
-			}
-			else {
-				edecimal upConvert;
-				upConvert[0] = 1;
-				for (int i = 0; i < -correction; ++i) upConvert += upConvert;
-//				std::cout << "upConvert : " << upConvert << '\n';
-				// multiply to add the missing factor
-				*this *= upConvert;
-			}
-		}
+		bool s{ false };
+		uint64_t unbiasedExponent{ 0 };
+		uint64_t fraction{ 0 };
+		uint64_t bits{ 0 };
+		extractFields(rhs, s, unbiasedExponent, fraction, bits);
+		// TODO: subnormals
+
+		fraction |= (1ull << ieee754_parameter<Ty>::fbits); // add in the hidden bit
+		int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
+		int correction = ieee754_parameter<Ty>::fbits - scale;
+		if (correction >= 64) {
+			fraction = 0;
+			correction = 0;
+		}
+		else if (correction > 0) {
+			fraction >>= correction;
+			correction = 0;
+		}
+		*this = fraction;
+		// multiply in the missing powers of two, 2^29 < radix at a time
+		for (int up = -correction; up > 0; up -= 29) {
+			limb factor = limb(1) << std::min(up, 29);
+			limb carry = decimal_limbs::mul_small(data(), size(), factor);
+			if (carry) push_back(carry);
+		}
+		// (0.5, 1) truncates to a positive zero
+		setsign(!iszero() && rhs < -0.5);
 		return *this;
 	}
 
@@ -590,10 +707,9 @@ private:
 
 // find the order of the most significant digit, precondition edecimal is unpadded
 inline int findMsd(const edecimal& v) {
-	int msd = int(v.size()) - 1;
-	if (msd == 0 && v == 0) return -1; // no significant digit found, all digits are zero
-	assert(v.at(static_cast<size_t>(msd)) != 0); // indicates the edecimal wasn't unpadded
-	return msd;
+	if (v.iszero()) return -1; // no significant digit found, all digits are zero
+	assert(v.back() != 0); // indicates the edecimal wasn't unpadded
+	return static_cast<int>(v.nrDigits()) - 1;
 }
 
 
@@ -601,40 +717,38 @@ inline int findMsd(const edecimal& v) {
 
 /// stream operators
 
-inline std::string to_binary(const edecimal& d) {
-	std::stringstream s;
-	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
+// the decimal digits of the magnitude, most significant first
+inline std::string to_digits(const edecimal& d) {
+	std::size_t n = decimal_limbs::significant(d.data(), d.size());
+	if (n == 0) return std::string("0");
+	std::string s = std::to_string(d[n - 1]);
+	s.reserve(n * edecimal::digitsPerLimb);
+	char buf[edecimal::digitsPerLimb];
+	for (std::size_t i = n - 1; i-- > 0; ) {
+		edecimal::limb l = d[i];
+		for (unsigned k = edecimal::digitsPerLimb; k-- > 0; ) {
+			buf[k] = static_cast<char>('0' + l % 10);
+			l /= 10;
+		}
+		s.append(buf, edecimal::digitsPerLimb);
 	}
-	return s.str();
+	return s;
+}
+
+inline std::string to_binary(const edecimal& d) {
+	return (d.isneg() ? std::string("-") : std::string()) + to_digits(d);
 }
 
 // generate an ASCII edecimal string
 inline std::string to_string(const edecimal& d) {
-	std::stringstream s;
-	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
-	}
-	return s.str();
+	return (d.isneg() ? std::string("-") : std::string()) + to_digits(d);
 }
 
 // generate an ASCII edecimal format and send to ostream
 inline std::ostream& operator<<(std::ostream& ostr, const edecimal& d) {
 	// to make certain that setw and left/right operators work properly
 	// we need to transform the integer into a string
-	std::stringstream ss;
-
-	//std::streamsize width = ostr.width();
-	std::ios_base::fmtflags ff;
-	ff = ostr.flags();
-	ss.flags(ff);
-	if (d.isneg()) ss << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		ss << (int)*rit;
-	}
-	return ostr << ss.str();
+	return ostr << to_string(d);
 }
 
 // read an ASCII edecimal format from an istream
@@ -697,48 +811,39 @@ inline edecimal operator>>(const edecimal& lhs, int shift) {
 
 	// edecimal - edecimal logic operators
 // equality test
-bool operator==(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator==(const edecimal& lhs, const edecimal& rhs) {
 	if (lhs.size() != rhs.size()) return false;
 	bool areEqual = std::equal(lhs.begin(), lhs.end(), rhs.begin()) && lhs.sign() == rhs.sign();
 	return areEqual;
 }
 // inequality test
-bool operator!=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator!=(const edecimal& lhs, const edecimal& rhs) {
 	return !operator==(lhs, rhs);
 }
 // less-than test
-bool operator<(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator<(const edecimal& lhs, const edecimal& rhs) {
 	if (lhs.sign() != rhs.sign()) {
 		return lhs.sign() ? true : false;
 	}
 
 	// signs are the same
 	// this logic assumes that there is no padding in the operands
-	size_t l = lhs.size();
-	size_t r = rhs.size();
-	if (l < r) return lhs.sign() ? false : true;
-	if (l > r) return lhs.sign() ? true : false;
-	// numbers are the same size, need to compare magnitude
-	edecimal::const_reverse_iterator ritl = lhs.rbegin();
-	edecimal::const_reverse_iterator ritr = rhs.rbegin();
-	for (; ritl != lhs.rend() || ritr != rhs.rend(); ++ritl, ++ritr) {
-		if (*ritl < *ritr) return lhs.sign() ? false : true;
-		if (*ritl > *ritr) return lhs.sign() ? true : false;
-		// if the digits are equal we need to check the next set
-	}
+	int cmp = decimal_limbs::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+	if (cmp < 0) return lhs.sign() ? false : true;
+	if (cmp > 0) return lhs.sign() ? true : false;
 	// at this point we know the two operands are the same
 	return false;
 }
 // greater-than test
-bool operator>(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator>(const edecimal& lhs, const edecimal& rhs) {
 	return operator<(rhs, lhs);
 }
 // less-or-equal test
-bool operator<=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator<=(const edecimal& lhs, const edecimal& rhs) {
 	return operator<(lhs, rhs) || operator==(lhs, rhs);
 }
 // greater-or-equal test
-bool operator>=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator>=(const edecimal& lhs, const edecimal& rhs) {
 	return !operator<(lhs, rhs);
 }
 
@@ -783,9 +888,9 @@ inline bool operator>=(long lhs, const edecimal& rhs) {
 }
 
 ///////////////////////////////////////////////////////////////////////
-// 
-// find largest multiplier of rhs being less or equal to lhs by subtraction; assumes 0*rhs <= lhs <= 9*rhs 
-edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
+//
+// find largest multiplier of rhs being less or equal to lhs by subtraction; assumes 0*rhs <= lhs <= 9*rhs
+inline edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
 	// check argument assumption	assert(0 <= lhs && lhs >= 9 * rhs);
 	edecimal remainder = lhs;
 	remainder.setpos();
@@ -800,7 +905,7 @@ edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
 			if (remainder < 0) {  // we went too far
 				--multiplier;
 			}
-			// else implies remainder is 0										
+			// else implies remainder is 0
 			break;
 		}
 	}
@@ -816,68 +921,53 @@ struct decintdiv {
 };
 
 // divide integer edecimal a and b and return result argument
-decintdiv decint_divide(const edecimal& _a, const edecimal& _b) {
+// the quotient truncates toward zero, the remainder carries the sign of the dividend
+inline decintdiv decint_divide(const edecimal& _a, const edecimal& _b) {
+	decintdiv divresult;
 	if (_b.iszero()) {
 #if EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 		throw edecimal_integer_divide_by_zero{};
 #else
 		std::cerr << "integer_divide_by_zero\n";
+		divresult.rem = _a;
+		return divresult;
 #endif // EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 	}
-	// generate the absolute values to do long division 
-	bool a_negative = _a.sign();
-	bool b_negative = _b.sign();
-	bool result_negative = (a_negative ^ b_negative);
-	edecimal a(_a); a.setpos();
-	edecimal b(_b); b.setpos();
-	decintdiv divresult;
-	if (a < b) {
+	bool result_negative = (_a.sign() ^ _b.sign());
+	const std::size_t an = decimal_limbs::significant(_a.data(), _a.size());
+	const std::size_t bn = decimal_limbs::significant(_b.data(), _b.size());
+	if (decimal_limbs::compare(_a.data(), an, _b.data(), bn) < 0) {
 		divresult.quot = 0;
 		divresult.rem = _a; // a % b = a when a / b = 0
 		return divresult; // a / b = 0 when b > a
 	}
-	// initialize the long division
-	edecimal accumulator = a;
-	// prepare the subtractand
-	edecimal subtractand = b;
-	int msd_b = findMsd(b);
-	int msd_a = findMsd(a);
-	int shift = msd_a - msd_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			edecimal multiple = findLargestMultiple(accumulator, subtractand);
-			accumulator -= multiple * subtractand;
-			uint8_t multiplier = static_cast<uint8_t>(int(multiple)); // TODO: fix the ugly
-			divresult.quot.insert(divresult.quot.begin(), multiplier);
-		}
-		else {
-			divresult.quot.insert(divresult.quot.begin(), 0);
-		}
-		subtractand >>= 1;
-		if (subtractand == 0) break;
-	}
-	if (result_negative) {
-		divresult.quot.setneg();
-	}
-	if (_a < 0) {
-		divresult.rem = -accumulator;
+	divresult.quot.assign(an - bn + 1, 0);
+	if (bn == 1) {
+		std::copy(_a.begin(), _a.begin() + static_cast<std::ptrdiff_t>(an), divresult.quot.begin());
+		edecimal::limb r = decimal_limbs::divmod_small(divresult.quot.data(), an, _b[0]);
+		divresult.rem = static_cast<unsigned long long>(r);
 	}
 	else {
-		divresult.rem = accumulator;
+		divresult.rem.assign(bn, 0);
+		decimal_limbs::divmod(_a.data(), an, _b.data(), bn, divresult.quot.data(), divresult.rem.data());
 	}
 	divresult.quot.unpad();
 	divresult.rem.unpad();
+	if (result_negative && !divresult.quot.iszero()) {
+		divresult.quot.setneg();
+	}
+	if (_a.sign() && !divresult.rem.iszero()) {
+		divresult.rem.setneg();
+	}
 	return divresult;
 }
 
 // return quotient of a edecimal integer division
-edecimal quotient(const edecimal& _a, const edecimal& _b) {
+inline edecimal quotient(const edecimal& _a, const edecimal& _b) {
 	return decint_divide(_a, _b).quot;
 }
 // return remainder of a edecimal integer division
-edecimal remainder(const edecimal& _a, const edecimal& _b) {
+inline edecimal remainder(const edecimal& _a, const edecimal& _b) {
 	return decint_divide(_a, _b).rem;
 }
 
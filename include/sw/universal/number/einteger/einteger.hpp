@@ -39,4 +39,4 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// math functions
-//#include <universal/number/einteger/math_functions.hpp>
+#include <universal/number/einteger/mathlib.hpp>
@@ -256,9 +256,10 @@ public:
 		return *this += einteger(rhs);
 	}
 	einteger& operator-=(const einteger& rhs) {
-		if (rhs.sign()) {
+		if (sign() != rhs.sign()) {
+			// a - (-b) = a + b and (-a) - b = -(a + b): add the magnitudes under the sign of *this
 			einteger negated(rhs);
-			negated.setsign(false);
+			negated.setsign(!rhs.sign());
 			return *this += negated;
 		}
 		auto lhsSize = _block.size();
@@ -266,6 +267,8 @@ public:
 			*this = -rhs;
 			return *this;
 		}
+		// same signs: subtract the magnitudes, the result flips sign when |rhs| > |*this|
+		bool negativeOperands = sign();
 		auto rhsSize = rhs._block.size();
 		int magnitude = compare_magnitude(*this, rhs); // if -1 result is going to be negative
 
@@ -299,7 +302,7 @@ public:
 			++i; ++aIter;
 		}
 		remove_leading_zeros();
-		setsign(magnitude == -1);
+		setsign(magnitude == 0 ? false : (negativeOperands ? magnitude == 1 : magnitude == -1));
 		return *this;
 	}
 	einteger& operator-=(long long rhs) {
@@ -310,33 +313,38 @@ public:
 			clear();
 			return *this;
 		}
-		einteger base(*this);
-		bool ls = sign();
-		unsigned ll = limbs();
+		if (this == &rhs) {
+			// squaring in place: the product overwrites the limbs the loop below reads from rhs
+			einteger square(rhs);
+			return *this *= square;
+		}
+		einteger base(std::move(*this));
+		bool ls = base.sign();
+		unsigned ll = base.limbs();
 		bool rs = rhs.sign();
 		unsigned rl = rhs.limbs();
 
-		clear();
-		// Schoolbook multiply with a per-row carry. block(k) reads 0 past the
-		// end and setblock(k, ...) grows storage, so reading/writing ahead of
-		// the current size is safe. The carry is reset for each outer limb and
-		// rippled into the higher limbs at the end of each row.
+		// Schoolbook multiply with a per-row carry into storage pre-sized to the
+		// full ll + rl limbs of the product. The carry is reset for each outer
+		// limb and rippled into the higher limbs at the end of each row.
 		// Fixes #991: the previous version kept a single carry accumulator
 		// across all rows and flushed it only once at block(ll+rl-1), which
 		// misplaced carries at the limb boundary -- e.g. (2^32)*(2^32) did not
 		// equal 2^64, and ~99.99% of 53-bit x 53-bit products were wrong.
+		_block.assign(static_cast<size_t>(ll) + rl, BlockType(0));
 		for (unsigned i = 0; i < ll; ++i) {
 			std::uint64_t carry = 0;
+			std::uint64_t bi = static_cast<std::uint64_t>(base._block[i]);
 			for (unsigned j = 0; j < rl; ++j) {
-				std::uint64_t segment = static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(rhs.block(j))
-				                      + static_cast<std::uint64_t>(block(i + j))
+				std::uint64_t segment = bi * static_cast<std::uint64_t>(rhs._block[j])
+				                      + static_cast<std::uint64_t>(_block[i + j])
 				                      + carry;
-				setblock(i + j, static_cast<bt>(segment));
+				_block[i + j] = static_cast<bt>(segment);
 				carry = segment >> bitsInBlock;
 			}
 			for (unsigned k = i + rl; carry != 0; ++k) {
-				std::uint64_t segment = static_cast<std::uint64_t>(block(k)) + carry;
-				setblock(k, static_cast<bt>(segment));
+				std::uint64_t segment = static_cast<std::uint64_t>(_block[k]) + carry;
+				_block[k] = static_cast<bt>(segment);
 				carry = segment >> bitsInBlock;
 			}
 		}
@@ -370,6 +378,7 @@ public:
 	}
 	
 	// reduce returns the ratio and remainder of a and b in *this and r
+	// truncated division, as for native integers: the remainder takes the sign of a
 	void reduce(const einteger& a, const einteger& b, einteger& r) {
 		if (b.iszero()) {
 #if EINTEGER_THROW_ARITHMETIC_EXCEPTION
@@ -450,6 +459,9 @@ public:
 				}
 				remove_leading_zeros();
 				r.setblock(0, static_cast<BlockType>(remainder));
+				r.remove_leading_zeros();
+				_sign = !iszero() && (a.sign() ^ b.sign());
+				r.setsign(!r.iszero() && a.sign());
 				return;
 			}
 
@@ -458,17 +470,22 @@ public:
 			// a requirement for the relationship: (qHat - 2) <= q <= qHat
 
 			int shift = nlz(b.block(n - 1));
+			// the bits carried in from the next lower limb are formed in 64 bits: when the divisor
+			// is already normalized (shift == 0) a BlockType-wide shift by bitsInBlock is undefined
+			auto carryIn = [shift](BlockType lower) {
+				return static_cast<BlockType>(static_cast<std::uint64_t>(lower) >> (bitsInBlock - shift));
+			};
 			einteger normalized_a;
-			normalized_a.setblock(m, static_cast<BlockType>((a.block(m - 1) >> (bitsInBlock - shift))));
+			normalized_a.setblock(m, carryIn(a.block(m - 1)));
 			for (unsigned i = m - 1; i > 0; --i) {
-				normalized_a.setblock(i, static_cast<BlockType>((a.block(i) << shift) | (a.block(i - 1) >> (bitsInBlock - shift))));
+				normalized_a.setblock(i, static_cast<BlockType>((a.block(i) << shift) | carryIn(a.block(i - 1))));
 			}
 			normalized_a.setblock(0, static_cast<BlockType>(a.block(0) << shift));
 			// normalize b
 			einteger normalized_b;
 			unsigned n_minus_1 = n - 1;
 			for (unsigned i = n_minus_1; i > 0; --i) {
-				normalized_b.setblock(i, static_cast<BlockType>((b.block(i) << shift) | (b.block(i - 1) >> (bitsInBlock - shift))));
+				normalized_b.setblock(i, static_cast<BlockType>((b.block(i) << shift) | carryIn(b.block(i - 1))));
 			}
 			normalized_b.setblock(0, static_cast<BlockType>(b.block(0) << shift));
 
@@ -486,7 +503,7 @@ public:
 				while (qhat >= BASE || qhat * v_nminus2 > BASE * rhat + normalized_a.block(j + n - 2)) {
 					--qhat;
 					rhat += divisor;
-					if (rhat < BASE) continue;
+					if (rhat >= BASE) break; // the test would overflow, and qhat is at most one too large now
 				}
 				// Knuth Algorithm D, step D4 (multi-precision subtraction
 				// with borrow propagation). `diff` MUST be signed so that
@@ -542,9 +559,13 @@ public:
 				r.setblock(i, static_cast<BlockType>(remainder));
 			}
 			r.setblock(n - 1, static_cast<BlockType>(normalized_a.block(n - 1) >> shift));
+			// the remainder is written limb by limb: trim it so comparisons and further
+			// divisions, which go by limb count, see a canonical value
+			r.remove_leading_zeros();
 		}
 		remove_leading_zeros();
-		_sign = a.sign() ^ b.sign();
+		_sign = !iszero() && (a.sign() ^ b.sign());
+		r.setsign(!r.iszero() && a.sign());
 	}
 
 	// modifiers (vector::clear is constexpr in C++20; on the empty
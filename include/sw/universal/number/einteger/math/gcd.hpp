@@ -0,0 +1,143 @@
+#pragma once
+// gcd.hpp: greatest common divisor and least common multiple of adaptive precision binary integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	namespace internal {
+
+		// binary gcd (Stein) on native magnitudes
+		inline std::uint64_t binary_gcd(std::uint64_t u, std::uint64_t v) noexcept {
+			if (u == 0) return v;
+			if (v == 0) return u;
+			int shift = std::countr_zero(u | v);
+			u >>= std::countr_zero(u);
+			do {
+				v >>= std::countr_zero(v);
+				if (u > v) std::swap(u, v);
+				v -= u;
+			} while (v != 0);
+			return u << shift;
+		}
+
+		// the magnitude of a non-negative einteger that fits in 64 bits
+		template<typename BlockType>
+		std::uint64_t to_uint64(const einteger<BlockType>& a) noexcept {
+			std::uint64_t v{ 0 };
+			for (unsigned i = a.limbs(); i-- > 0; ) {
+				v = (v << einteger<BlockType>::bitsInBlock) | static_cast<std::uint64_t>(a.block(i));
+			}
+			return v;
+		}
+
+		// bits [shift, shift + 32) of the magnitude of a
+		template<typename BlockType>
+		std::int64_t leading_bits(const einteger<BlockType>& a, int shift) {
+			constexpr unsigned bitsInBlock = einteger<BlockType>::bitsInBlock;
+			unsigned lsb    = static_cast<unsigned>(shift) / bitsInBlock;
+			unsigned offset = static_cast<unsigned>(shift) % bitsInBlock;
+			std::uint64_t bits{ 0 };
+			for (unsigned i = lsb, got = 0; i < a.limbs() && got < offset + 32; ++i, got += bitsInBlock) {
+				bits |= static_cast<std::uint64_t>(a.block(i)) << got;
+			}
+			return static_cast<std::int64_t>((bits >> offset) & 0xFFFF'FFFFull);
+		}
+
+		// x*u - y*v for single-word cofactors x, y < 2^32, when the caller knows the result is non-negative.
+		// One pass over the limbs, without the temporaries of the general multiply and subtract.
+		template<typename BlockType>
+		einteger<BlockType> lehmer_combine(std::uint64_t x, const einteger<BlockType>& u, std::uint64_t y, const einteger<BlockType>& v) {
+			constexpr unsigned      bitsInBlock = einteger<BlockType>::bitsInBlock;
+			constexpr std::uint64_t LOW_MASK    = einteger<BlockType>::BASE - 1u;
+			unsigned n = (u.limbs() > v.limbs() ? u.limbs() : v.limbs()) + 2;  // room for the cofactor carries
+			std::vector<BlockType> limbs(n);
+			std::uint64_t cu{ 0 }, cv{ 0 }, borrow{ 0 };
+			for (unsigned i = 0; i < n; ++i) {
+				std::uint64_t pu = x * static_cast<std::uint64_t>(u.block(i)) + cu;
+				std::uint64_t pv = y * static_cast<std::uint64_t>(v.block(i)) + cv;
+				cu = pu >> bitsInBlock;
+				cv = pv >> bitsInBlock;
+				std::uint64_t diff = (pu & LOW_MASK) - (pv & LOW_MASK) - borrow;
+				borrow = (diff >> 63);
+				limbs[i] = static_cast<BlockType>(diff & LOW_MASK);
+			}
+			while (n > 0 && limbs[n - 1] == 0) --n;
+			einteger<BlockType> r;
+			if (n > 0) r.setblock(n - 1, limbs[n - 1]);
+			for (unsigned i = 0; i + 1 < n; ++i) r.setblock(i, limbs[i]);
+			return r;
+		}
+
+		// A*u + B*v for the Lehmer cofactors A, B, which differ in sign, or one is zero, and keep the combination non-negative
+		template<typename BlockType>
+		einteger<BlockType> lehmer_combine(std::int64_t A, const einteger<BlockType>& u, std::int64_t B, const einteger<BlockType>& v) {
+			if (A >= 0 && B <= 0) return lehmer_combine(static_cast<std::uint64_t>(A), u, static_cast<std::uint64_t>(-B), v);
+			return lehmer_combine(static_cast<std::uint64_t>(B), v, static_cast<std::uint64_t>(-A), u);
+		}
+
+	} // namespace internal
+
+	// greatest common divisor of |a| and |b|, gcd(0, 0) = 0
+	// Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, Algorithm L): the quotient sequence of the
+	// leading 32 bits stands in for a run of multi-precision Euclid steps, so most iterations cost
+	// four single-limb multiplies instead of a long division. Operands of 64 bits or fewer finish
+	// with a binary gcd on native integers.
+	template<typename BlockType>
+	einteger<BlockType> gcd(const einteger<BlockType>& a, const einteger<BlockType>& b) {
+		using Integer = einteger<BlockType>;
+		Integer u(a), v(b);
+		u.setsign(false);
+		v.setsign(false);
+		if (u < v) std::swap(u, v);
+		while (!v.iszero()) {
+			int ubits = u.findMsb() + 1;
+			if (ubits <= 64) {
+				return Integer(internal::binary_gcd(internal::to_uint64(u), internal::to_uint64(v)));
+			}
+			int shift = ubits - 32;
+			std::int64_t uhat = internal::leading_bits(u, shift);
+			std::int64_t vhat = internal::leading_bits(v, shift);
+			std::int64_t A = 1, B = 0, C = 0, D = 1;
+			while (vhat + C != 0 && vhat + D != 0) {
+				std::int64_t q = (uhat + A) / (vhat + C);
+				if (q != (uhat + B) / (vhat + D)) break;
+				std::int64_t t;
+				t = A - q * C; A = C; C = t;
+				t = B - q * D; B = D; D = t;
+				t = uhat - q * vhat; uhat = vhat; vhat = t;
+			}
+			if (B == 0) {
+				// the leading bits did not determine a quotient: take one full Euclid step
+				Integer r = u % v;
+				u = std::move(v);
+				v = std::move(r);
+			}
+			else {
+				Integer nu = internal::lehmer_combine(A, u, B, v);
+				Integer nv = internal::lehmer_combine(C, u, D, v);
+				u = std::move(nu);
+				v = std::move(nv);
+			}
+		}
+		return u;
+	}
+
+	// least common multiple of |a| and |b|, lcm(0, b) = 0
+	template<typename BlockType>
+	einteger<BlockType> lcm(const einteger<BlockType>& a, const einteger<BlockType>& b) {
+		using Integer = einteger<BlockType>;
+		if (a.iszero() || b.iszero()) return Integer(0);
+		Integer l = (a / gcd(a, b)) * b;
+		l.setsign(false);
+		return l;
+	}
+
+}} // namespace sw::universal
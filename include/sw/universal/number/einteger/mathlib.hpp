@@ -0,0 +1,9 @@
+#pragma once
+// mathlib.hpp: definition of mathematical functions for adaptive precision binary integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <universal/number/einteger/math/gcd.hpp>
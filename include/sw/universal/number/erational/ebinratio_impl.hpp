@@ -0,0 +1,677 @@
+#pragma once
+// ebinratio_impl.hpp: implementation of adaptive precision binary rational arithmetic type
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cmath>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <universal/native/ieee754.hpp>
+#include <universal/string/strmanip.hpp>
+#include <universal/utility/string_parse.hpp>
+#include <universal/number/erational/exceptions.hpp>
+#include <universal/number/einteger/einteger.hpp>
+
+namespace sw { namespace universal {
+
+// when a rational is brought back to lowest terms
+enum class RationalReduction {
+	Eager,  // after every operation: numerator and denominator are always coprime
+	Lazy    // when the operands have grown past a threshold, or when the value is observed
+};
+
+/// <summary>
+/// Adaptive precision binary rational number system type
+/// </summary>
+/// The ebinratio is comprised of two adaptive precision binary integers, einteger<BlockType>,
+/// representing the numerator and denominator. It is the binary counterpart of the decimal
+/// erational: the gcd is Lehmer's algorithm on machine-word limbs, multiplication cancels
+/// the cross factors gcd(a,d) and gcd(c,b) before it multiplies, and addition uses Henrici's
+/// method so the intermediate products stay as small as the result allows.
+///
+/// With the Lazy policy the arithmetic operators skip the gcd and only reduce when the pair
+/// has doubled in size since the last reduction; fraction-free algorithms, such as Bareiss
+/// elimination, that produce many intermediate values and only observe a few, run
+/// substantially faster that way. Observing a lazy value (printing, converting, comparing,
+/// or reading the numerator or denominator) reduces it first, so the observable value is
+/// the same under both policies. The reduction mutates cached state, so a lazy ebinratio
+/// must not be read concurrently from multiple threads without synchronization.
+template<RationalReduction reduction = RationalReduction::Eager, typename BlockType = std::uint32_t>
+class ebinratio {
+public:
+	using Integer = einteger<BlockType>;
+	static constexpr RationalReduction policy = reduction;
+	// growth, in limbs, that a lazy value may accumulate beyond twice its last reduced size
+	static constexpr unsigned lazySlack = 16;
+
+	ebinratio() : negative{ false }, numerator{}, denominator{ 1 }, reduced{ true }, reducedLimbs{ 1 } {}
+
+	ebinratio(const ebinratio&) = default;
+	ebinratio(ebinratio&&) = default;
+
+	ebinratio& operator=(const ebinratio&) = default;
+	ebinratio& operator=(ebinratio&&) = default;
+
+	// construct n/d from a pair of integers, reduced to lowest terms
+	ebinratio(const Integer& n, const Integer& d) : negative{ n.sign() != d.sign() }, numerator{ n }, denominator{ d }, reduced{ false }, reducedLimbs{ 0 } {
+		numerator.setsign(false);
+		denominator.setsign(false);
+		normalize();
+	}
+
+	// initializers for native types
+	ebinratio(short initial_value)              { *this = initial_value; }
+	ebinratio(int initial_value)                { *this = initial_value; }
+	ebinratio(long initial_value)               { *this = initial_value; }
+	ebinratio(long long initial_value)          { *this = initial_value; }
+	ebinratio(unsigned short initial_value)     { *this = initial_value; }
+	ebinratio(unsigned int initial_value)       { *this = initial_value; }
+	ebinratio(unsigned long initial_value)      { *this = initial_value; }
+	ebinratio(unsigned long long initial_value) { *this = initial_value; }
+	ebinratio(float initial_value)              { *this = initial_value; }
+	ebinratio(double initial_value)             { *this = initial_value; }
+
+	// assignment operators for native types
+	ebinratio& operator=(const std::string& digits) {
+		if (!parse(digits)) std::cerr << "unable to parse -" << digits << "- into an ebinratio value\n";
+		return *this;
+	}
+	ebinratio& operator=(short rhs)              { return convert_signed(rhs); }
+	ebinratio& operator=(int rhs)                { return convert_signed(rhs); }
+	ebinratio& operator=(long rhs)               { return convert_signed(rhs); }
+	ebinratio& operator=(long long rhs)          { return convert_signed(rhs); }
+	ebinratio& operator=(unsigned short rhs)     { return convert_unsigned(rhs); }
+	ebinratio& operator=(unsigned int rhs)       { return convert_unsigned(rhs); }
+	ebinratio& operator=(unsigned long rhs)      { return convert_unsigned(rhs); }
+	ebinratio& operator=(unsigned long long rhs) { return convert_unsigned(rhs); }
+	ebinratio& operator=(float rhs)              { return convert_ieee754(rhs); }
+	ebinratio& operator=(double rhs)             { return convert_ieee754(rhs); }
+
+	// explicit conversion operators
+	explicit operator int()                const { return to_signed<int>(); }
+	explicit operator long()               const { return to_signed<long>(); }
+	explicit operator long long()          const { return to_signed<long long>(); }
+	explicit operator float()              const { return to_ieee754<float>(); }
+	explicit operator double()             const { return to_ieee754<double>(); }
+
+#if LONG_DOUBLE_SUPPORT
+	ebinratio(long double initial_value) { *this = initial_value; }
+	ebinratio& operator=(long double rhs) { return convert_ieee754(rhs); }
+	explicit operator long double()        const { return to_ieee754<long double>(); }
+#endif
+
+	// unitary operators
+	ebinratio operator-() const {
+		ebinratio tmp(*this);
+		if (!tmp.numerator.iszero()) tmp.negative = !tmp.negative;
+		return tmp;
+	}
+	ebinratio operator++(int) { // postfix
+		ebinratio tmp(*this);
+		operator++();
+		return tmp;
+	}
+	ebinratio& operator++() { // prefix
+		return *this += ebinratio(1);
+	}
+	ebinratio operator--(int) { // postfix
+		ebinratio tmp(*this);
+		operator--();
+		return tmp;
+	}
+	ebinratio& operator--() { // prefix
+		return *this -= ebinratio(1);
+	}
+
+	// arithmetic operators
+	ebinratio& operator+=(const ebinratio& rhs) {
+		return accumulate(rhs, rhs.negative);
+	}
+	ebinratio& operator-=(const ebinratio& rhs) {
+		return accumulate(rhs, !rhs.negative);
+	}
+	ebinratio& operator*=(const ebinratio& rhs) {
+		if (numerator.iszero() || rhs.numerator.iszero()) {
+			setzero();
+			return *this;
+		}
+		negative = (negative != rhs.negative);
+		if constexpr (reduction == RationalReduction::Eager) {
+			// (a/b)*(c/d) with gcd(a,b) = gcd(c,d) = 1: cancel the cross factors first, the
+			// products of the cofactors are then already in lowest terms
+			Integer g1 = gcd(numerator, rhs.denominator);
+			Integer g2 = gcd(rhs.numerator, denominator);
+			Integer c = rhs.numerator, d = rhs.denominator;
+			if (!isunit(g1)) { numerator /= g1; d /= g1; }
+			if (!isunit(g2)) { denominator /= g2; c /= g2; }
+			numerator   *= c;
+			denominator *= d;
+			mark_reduced();
+		}
+		else {
+			numerator   *= rhs.numerator;
+			denominator *= rhs.denominator;
+			reduce_if_grown();
+		}
+		return *this;
+	}
+	ebinratio& operator/=(const ebinratio& rhs) {
+		if (rhs.numerator.iszero()) {
+#if ERATIONAL_THROW_ARITHMETIC_EXCEPTION
+			throw erational_divide_by_zero();
+#else
+			std::cerr << "erational_divide_by_zero\n";
+			setzero();
+			return *this;
+#endif
+		}
+		ebinratio reciprocal;
+		reciprocal.negative     = rhs.negative;
+		reciprocal.numerator    = rhs.denominator;
+		reciprocal.denominator  = rhs.numerator;
+		reciprocal.reduced      = rhs.reduced;
+		reciprocal.reducedLimbs = rhs.reducedLimbs;
+		return *this *= reciprocal;
+	}
+
+	// selectors
+	bool iszero()               const noexcept { return numerator.iszero(); }
+	bool isone()                const          { normalize(); return !negative && isunit(numerator) && isunit(denominator); }
+	bool isneg()                const noexcept { return negative; }   // <  0
+	bool ispos()                const noexcept { return !negative; }  // >= 0
+	bool isinf()                const noexcept { return false; }
+	bool isnan()                const noexcept { return numerator.iszero() && denominator.iszero(); }
+	bool isinteger()            const          { normalize(); return isunit(denominator); }
+	bool sign()                 const noexcept { return negative; }
+	// numerator and denominator in lowest terms, the sign is carried by the ratio
+	const Integer& top()        const          { normalize(); return numerator; }
+	const Integer& bottom()     const          { normalize(); return denominator; }
+	// limbs held by numerator and denominator: the storage cost of the current, possibly unreduced, representation
+	unsigned limbs()            const noexcept { return numerator.limbs() + denominator.limbs(); }
+
+	// modifiers
+	void setzero() {
+		negative     = false;
+		numerator    = 0;
+		denominator  = 1;
+		mark_reduced();
+	}
+	void setsign(bool sign) noexcept { negative = sign && !numerator.iszero(); }
+	void setneg() noexcept { setsign(true); }
+	void setpos() noexcept { setsign(false); }
+	void setnumerator(const Integer& num) {
+		negative = num.sign() && !num.iszero();
+		numerator = num;
+		numerator.setsign(false);
+		normalize_if_eager();
+	}
+	void setdenominator(const Integer& denom) {
+		if (denom.sign()) negative = !negative;
+		denominator = denom;
+		denominator.setsign(false);
+		normalize_if_eager();
+	}
+	void setbits(std::uint64_t v) { *this = v; } // API to be consistent with the other number systems
+
+	// bring the ratio to lowest terms: a no-op under the Eager policy, which never leaves it
+	void normalize() const {
+		if (reduced) return;
+		if (denominator.iszero()) {
+#if ERATIONAL_THROW_ARITHMETIC_EXCEPTION
+			throw erational_divide_by_zero();
+#else
+			std::cerr << "erational_divide_by_zero\n";
+			numerator = 0;
+			mark_reduced();
+			return;
+#endif
+		}
+		if (numerator.iszero()) {
+			negative = false;
+			denominator = 1;
+		}
+		else {
+			Integer g = gcd(numerator, denominator);
+			if (!isunit(g)) {
+				numerator   /= g;
+				denominator /= g;
+			}
+		}
+		mark_reduced();
+	}
+
+	// Parse a rational literal in any of these forms:
+	//   integer:     "42",   "-1000"            -> 42/1, -1000/1
+	//   p/q:         "1/2",  "-22/7", "355/113" -> simplified to lowest terms
+	//   decimal:     "3.14", "-0.5"             -> 157/50, -1/2
+	//   scientific:  "1.5e2", "1.5e-1"          -> 150/1, 3/20
+	// Rejects malformed input and division by zero ("1/0").
+	bool parse(const std::string& _digits) {
+		std::string digits(_digits);
+		trim(digits);
+		if (digits.empty()) return false;
+
+		Integer num, den;
+		bool neg{ false };
+		auto slash = digits.find('/');
+		if (slash != std::string::npos) {
+			Integer pn, pd, qn, qd;
+			bool pneg{ false }, qneg{ false };
+			if (!parse_decimal_to_fraction(digits.substr(0, slash), pn, pd, pneg)) return false;
+			if (!parse_decimal_to_fraction(digits.substr(slash + 1), qn, qd, qneg)) return false;
+			if (qn.iszero()) return false;
+			num = pn * qd;
+			den = pd * qn;
+			neg = pneg != qneg;
+		}
+		else {
+			if (!parse_decimal_to_fraction(digits, num, den, neg)) return false;
+		}
+		negative     = neg;
+		numerator    = num;
+		denominator  = den;
+		reduced      = false;
+		normalize();
+		return true;
+	}
+
+protected:
+	// HELPER methods
+
+	static bool isunit(const Integer& v) noexcept { return v.limbs() == 1 && v.block(0) == BlockType(1); }
+
+	void mark_reduced() const noexcept {
+		reduced      = true;
+		reducedLimbs = limbs();
+	}
+	void normalize_if_eager() {
+		reduced = false;
+		if constexpr (reduction == RationalReduction::Eager) normalize();
+	}
+	// lazy policy: reduce once the pair has more than doubled since the last reduction
+	void reduce_if_grown() {
+		reduced = false;
+		if (limbs() > 2 * reducedLimbs + lazySlack) normalize();
+	}
+
+	// *this += (-1)^rhsNegative * |rhs|
+	ebinratio& accumulate(const ebinratio& rhs, bool rhsNegative) {
+		if (rhs.numerator.iszero()) return *this;
+		Integer a(numerator), c(rhs.numerator);
+		a.setsign(negative);
+		c.setsign(rhsNegative);
+		Integer t;
+		if (denominator == rhs.denominator) {
+			t = a + c;
+			if constexpr (reduction == RationalReduction::Eager) {
+				Integer g = gcd(t, denominator);
+				if (!isunit(g) && !t.iszero()) {
+					t /= g;
+					denominator /= g;
+				}
+			}
+		}
+		else if constexpr (reduction == RationalReduction::Eager) {
+			// Henrici: with g = gcd(b,d), a/b + c/d = (a*(d/g) + c*(b/g)) / (b*(d/g)), and only the
+			// factors of g can be shared between that numerator and denominator
+			Integer g = gcd(denominator, rhs.denominator);
+			if (isunit(g)) {
+				t = a * rhs.denominator + c * denominator;
+				denominator *= rhs.denominator;
+			}
+			else {
+				Integer bg = denominator / g;
+				Integer dg = rhs.denominator / g;
+				t = a * dg + c * bg;
+				Integer g2 = gcd(t, g);
+				if (!isunit(g2) && !t.iszero()) {
+					t /= g2;
+					denominator /= g2;
+				}
+				denominator *= dg;
+			}
+		}
+		else {
+			t = a * rhs.denominator + c * denominator;
+			denominator *= rhs.denominator;
+		}
+		negative = t.sign() && !t.iszero();
+		t.setsign(false);
+		numerator = std::move(t);
+		if (numerator.iszero()) {
+			setzero();
+			return *this;
+		}
+		if constexpr (reduction == RationalReduction::Eager) mark_reduced(); else reduce_if_grown();
+		return *this;
+	}
+
+	// value of a string of decimal digits, consumed nine digits at a time
+	static Integer decimal_digits(std::string_view digits) {
+		Integer v;
+		std::size_t i = 0;
+		while (i < digits.size()) {
+			std::size_t n = std::min<std::size_t>(9, digits.size() - i);
+			long long chunk{ 0 }, scale{ 1 };
+			for (std::size_t j = 0; j < n; ++j) {
+				chunk = chunk * 10 + (digits[i + j] - '0');
+				scale *= 10;
+			}
+			v *= scale;
+			v += chunk;
+			i += n;
+		}
+		return v;
+	}
+	static Integer pow10(std::uint64_t k) {
+		Integer result(1), base(10);
+		while (k > 0) {
+			if (k & 1) result *= base;
+			base *= base;
+			k >>= 1;
+		}
+		return result;
+	}
+	// Tokenize a decimal/scientific literal into an exact (numerator, denominator) pair
+	static bool parse_decimal_to_fraction(const std::string& s, Integer& num, Integer& den, bool& neg) {
+		constexpr std::int64_t MAX_DIGITS = 1 << 20;  // same defensive cap as erational
+
+		std::string trimmed = s;
+		trim(trimmed);
+		if (trimmed.empty()) return false;
+		auto scan = sw::universal::string_parse::scan_decimal_float(trimmed);
+		if (!scan.valid) return false;
+		neg = scan.negative;
+
+		std::int64_t effExp = static_cast<std::int64_t>(scan.exp10) - static_cast<std::int64_t>(scan.frac_part.size());
+		std::int64_t nrDigits = static_cast<std::int64_t>(scan.int_part.size() + scan.frac_part.size());
+		if (nrDigits + (effExp < 0 ? -effExp : effExp) > MAX_DIGITS) return false;
+		std::string sig(scan.int_part);
+		sig.append(scan.frac_part);
+		num = decimal_digits(sig);
+		if (effExp >= 0) {
+			num *= pow10(static_cast<std::uint64_t>(effExp));
+			den = 1;
+		}
+		else {
+			den = pow10(static_cast<std::uint64_t>(-effExp));
+		}
+		if (num.iszero()) neg = false;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////
+	// conversion helpers
+
+	// convert to signed int, truncating towards zero
+	template<typename SignedInt,
+		typename = typename std::enable_if< std::is_integral<SignedInt>::value, SignedInt >::type>
+	SignedInt to_signed() const {
+		if (denominator.iszero()) return SignedInt(0);
+		Integer q = numerator / denominator;
+		SignedInt v = static_cast<SignedInt>(static_cast<long long>(q));
+		return negative ? SignedInt(-v) : v;
+	}
+	// convert to ieee-754: correctly-rounded (round-half-to-even) conversion of the exact ratio
+	template<typename Real,
+		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
+	Real to_ieee754() const {
+		if (denominator.iszero()) {
+			if (numerator.iszero()) return std::numeric_limits<Real>::quiet_NaN();
+			return negative ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity();
+		}
+		if (numerator.iszero()) return negative ? -static_cast<Real>(0) : static_cast<Real>(0);
+
+		constexpr int bias  = ieee754_parameter<Real>::bias;
+		constexpr int fbits = ieee754_parameter<Real>::fbits;
+		const long minLSBexp = 1L - bias - fbits;   // exponent of the smallest subnormal's unit bit
+
+		// e2 = floor(log2(num/den)) is the difference of the leading bit positions, or one less
+		long e2 = static_cast<long>(numerator.findMsb()) - static_cast<long>(denominator.findMsb());
+		{
+			Integer num(numerator), den(denominator);
+			if (e2 >= 0) den <<= static_cast<int>(e2); else num <<= static_cast<int>(-e2);
+			if (num < den) --e2;
+		}
+		// exponent of the result's unit (LSB) bit, pinned to the subnormal floor
+		long targetExp = e2 - fbits;
+		if (targetExp < minLSBexp) targetExp = minLSBexp;
+		if (e2 > static_cast<long>(bias)) {
+			return negative ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity();
+		}
+		if (targetExp > e2 + 1) {
+			// below half of the smallest subnormal: rounds to zero
+			return negative ? -static_cast<Real>(0) : static_cast<Real>(0);
+		}
+
+		// mantissa = round( num/den * 2^-targetExp )
+		Integer scaled(numerator), divisor(denominator);
+		if (targetExp <= 0) scaled <<= static_cast<int>(-targetExp); else divisor <<= static_cast<int>(targetExp);
+		Integer q, rem;
+		q.reduce(scaled, divisor, rem);
+		rem <<= 1;
+		if (divisor < rem || (rem == divisor && q.isodd())) ++q;
+		if (q.iszero()) return negative ? -static_cast<Real>(0) : static_cast<Real>(0);
+
+		// q is in [0, 2^(fbits+1)] and thus exactly representable
+		Real value = std::ldexp(static_cast<Real>(q), static_cast<int>(targetExp));
+		return negative ? -value : value;
+	}
+
+	template<typename SignedInt,
+		typename = typename std::enable_if< std::is_integral<SignedInt>::value, SignedInt >::type>
+	ebinratio& convert_signed(SignedInt rhs) {
+		negative     = rhs < 0;
+		numerator    = static_cast<long long>(rhs);
+		numerator.setsign(false);
+		denominator  = 1;
+		mark_reduced();
+		return *this;
+	}
+
+	template<typename UnsignedInt,
+		typename = typename std::enable_if< std::is_integral<UnsignedInt>::value, UnsignedInt >::type >
+	ebinratio& convert_unsigned(UnsignedInt rhs) {
+		negative     = false;
+		numerator    = static_cast<unsigned long long>(rhs);
+		denominator  = 1;
+		mark_reduced();
+		return *this;
+	}
+
+	// a binary floating-point value is the exact dyadic rational significand * 2^exponent
+	template<typename Real,
+		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
+	ebinratio& convert_ieee754(Real rhs) {
+		setzero();
+		if (rhs == 0) return *this;
+		if (std::isinf(rhs) || std::isnan(rhs)) return *this;  // not representable; map to 0
+
+		std::uint64_t bits{ 0 }, e{ 0 }, f{ 0 };
+		bool s{ false };
+		extractFields(rhs, s, e, f, bits);
+
+		constexpr int bias  = ieee754_parameter<Real>::bias;
+		constexpr int fbits = ieee754_parameter<Real>::fbits;
+		std::uint64_t significand;
+		int exponent;
+		if (e == 0) { // subnormal: no hidden bit, exponent fixed at the minimum
+			significand = f;
+			exponent    = 1 - bias - fbits;
+		}
+		else {
+			significand = f | ieee754_parameter<Real>::hmask;
+			exponent    = static_cast<int>(e) - bias - fbits;
+		}
+		// the denominator is a power of two: lowest terms only need the trailing zeros removed
+		int tz = std::countr_zero(significand);
+		significand >>= tz;
+		exponent += tz;
+
+		negative  = s;
+		numerator = static_cast<unsigned long long>(significand);
+		if (exponent >= 0) {
+			numerator <<= exponent;
+		}
+		else {
+			denominator <<= -exponent;
+		}
+		mark_reduced();
+		return *this;
+	}
+
+private:
+	// sign-magnitude number: mutable so that a lazy value can be reduced when it is observed
+	mutable bool     negative;
+	mutable Integer  numerator;     // will be managed as a positive number
+	mutable Integer  denominator;   // will be managed as a positive number
+	mutable bool     reduced;       // numerator and denominator are known to be coprime
+	mutable unsigned reducedLimbs;  // limbs() when the ratio was last brought to lowest terms
+
+	template<RationalReduction R, typename B>
+	friend bool operator==(const ebinratio<R, B>& lhs, const ebinratio<R, B>& rhs);
+	template<RationalReduction R, typename B>
+	friend bool operator<(const ebinratio<R, B>& lhs, const ebinratio<R, B>& rhs);
+};
+
+////////////////// ebinratio operators
+
+/// stream operators
+
+// generate an ASCII ebinratio string
+template<RationalReduction reduction, typename BlockType>
+inline std::string to_string(const ebinratio<reduction, BlockType>& v) {
+	std::stringstream str;
+	if (v.isneg()) str << '-';
+	str << v.top() << '/' << v.bottom();
+	return str.str();
+}
+
+// generate an ASCII ebinratio format and send to ostream
+template<RationalReduction reduction, typename BlockType>
+inline std::ostream& operator<<(std::ostream& ostr, const ebinratio<reduction, BlockType>& v) {
+	// make certain that setw and left/right operators work properly
+	return ostr << to_string(v);
+}
+
+// read an ASCII ebinratio format from an istream
+template<RationalReduction reduction, typename BlockType>
+inline std::istream& operator>>(std::istream& istr, ebinratio<reduction, BlockType>& v) {
+	std::string txt;
+	if (!(istr >> txt)) return istr;
+	if (!v.parse(txt)) {
+		std::cerr << "unable to parse -" << txt << "- into an ebinratio value\n";
+		istr.setstate(std::ios::failbit);
+	}
+	return istr;
+}
+
+/// ebinratio binary arithmetic operators
+
+template<RationalReduction reduction, typename BlockType>
+inline ebinratio<reduction, BlockType> operator+(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	ebinratio<reduction, BlockType> sum(lhs);
+	sum += rhs;
+	return sum;
+}
+template<RationalReduction reduction, typename BlockType>
+inline ebinratio<reduction, BlockType> operator-(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	ebinratio<reduction, BlockType> diff(lhs);
+	diff -= rhs;
+	return diff;
+}
+template<RationalReduction reduction, typename BlockType>
+inline ebinratio<reduction, BlockType> operator*(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	ebinratio<reduction, BlockType> mul(lhs);
+	mul *= rhs;
+	return mul;
+}
+template<RationalReduction reduction, typename BlockType>
+inline ebinratio<reduction, BlockType> operator/(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	ebinratio<reduction, BlockType> ratio(lhs);
+	ratio /= rhs;
+	return ratio;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// logic operators
+
+// equality test: reduced ratios are unique, so compare the reduced pairs
+template<RationalReduction reduction, typename BlockType>
+inline bool operator==(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	lhs.normalize();
+	rhs.normalize();
+	return lhs.negative == rhs.negative && lhs.numerator == rhs.numerator && lhs.denominator == rhs.denominator;
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator!=(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	return !operator==(lhs, rhs);
+}
+// less-than test: a/b < c/d <=> a*d < c*b for positive denominators
+template<RationalReduction reduction, typename BlockType>
+inline bool operator<(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	if (lhs.negative != rhs.negative) return lhs.negative;
+	auto ad = lhs.numerator * rhs.denominator;
+	auto cb = rhs.numerator * lhs.denominator;
+	return lhs.negative ? (cb < ad) : (ad < cb);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator>(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	return operator<(rhs, lhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator<=(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	return !operator<(rhs, lhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator>=(const ebinratio<reduction, BlockType>& lhs, const ebinratio<reduction, BlockType>& rhs) {
+	return !operator<(lhs, rhs);
+}
+
+#if ERATIONAL_ENABLE_LITERALS
+// ebinratio - long long logic operators
+template<RationalReduction reduction, typename BlockType>
+inline bool operator==(const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs == ebinratio<reduction, BlockType>(rhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator!=(const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs != ebinratio<reduction, BlockType>(rhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator< (const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs < ebinratio<reduction, BlockType>(rhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator> (const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs > ebinratio<reduction, BlockType>(rhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator<=(const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs <= ebinratio<reduction, BlockType>(rhs);
+}
+template<RationalReduction reduction, typename BlockType>
+inline bool operator>=(const ebinratio<reduction, BlockType>& lhs, long long rhs) {
+	return lhs >= ebinratio<reduction, BlockType>(rhs);
+}
+#endif // ERATIONAL_ENABLE_LITERALS
+
+// absolute value
+template<RationalReduction reduction, typename BlockType>
+inline ebinratio<reduction, BlockType> abs(const ebinratio<reduction, BlockType>& v) {
+	return v.isneg() ? -v : v;
+}
+
+}} // namespace sw::universal
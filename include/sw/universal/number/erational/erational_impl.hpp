@@ -417,8 +417,8 @@ protected:
 
 		// e2 = floor(log2(num/den)): seed from decimal digit counts (log2(10) ~ 3.3219),
 		// then correct so that den*2^e2 <= num < den*2^(e2+1).
-		long Dn = static_cast<long>(num.size());
-		long Dd = static_cast<long>(den.size());
+		long Dn = static_cast<long>(num.nrDigits());
+		long Dd = static_cast<long>(den.nrDigits());
 		long e2 = static_cast<long>(std::floor(static_cast<double>(Dn - Dd) * 3.3219280948873623));
 		while ( den2p_le_num(e2 + 1)) ++e2;
 		while (!den2p_le_num(e2))     --e2;
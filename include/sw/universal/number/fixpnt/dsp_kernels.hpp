@@ -0,0 +1,370 @@
+#pragma once
+// dsp_kernels.hpp: blocked, multithreaded FIR, convolution and GEMM kernels for fixpnt and integer arrays
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// fixpnt::operator*= forms the 2*nbits product with urmul2 in a blockbinary, rounds it back to rbits and
+// wraps or saturates, one element at a time, and a filter written as a loop of *= and += rounds after
+// every tap. These kernels evaluate whole arrays of fixpnt<nbits, rbits> and integer<nbits>, nbits <= 32:
+//
+//   fir(h, x, y)                          y[n] = sum h[k] x[n-k], causal with zero initial state,
+//                                         one output per input sample
+//   conv1d(h, x, y)                       y[i] = sum h[k] x[i+K-1-k], the K-1 partial outputs at either
+//                                         end are not produced: x.size() - K + 1 outputs
+//   conv2d(kh, kw, h, xh, xw, x, y)       the same over a row-major xh x xw image and a kh x kw kernel,
+//                                         (xh - kh + 1) x (xw - kw + 1) outputs
+//   gemm(m, n, k, A, B, C)                C = A B for row-major A (m x k), B (k x n) and C (m x n)
+//
+// Every output is the exact sum of its products, rounded once: round-to-nearest-even at rbits, which is
+// how operator*= rounds a single product, followed by the wrap (Modulo) or clamp (Saturate) to nbits.
+// A single-tap kernel therefore reproduces operator*= bit for bit, and longer sums are correctly rounded.
+// integer<nbits> outputs are the exact sum modulo 2^nbits, which is what the wrapping scalar operators
+// compute as well.
+//
+// The operands are unpacked once into int16_t (nbits <= 16) or int32_t arrays. Sums are kept in int64_t
+// lanes: a 16-bit product is at most 2^30, so a single lane absorbs 2^33 of them; a 32-bit product is
+// split into its low 32 bits and its signed upper half, accumulated in two lanes that absorb 2^31
+// products each. The inner loop is one coefficient times a contiguous row of samples added into a row of
+// lanes, which compilers turn into packed multiplies (pmaddwd/pmuldq, or the VNNI forms when built for
+// such a target). Outputs are computed in tiles whose lanes stay in L1, gemm also blocks the inner
+// dimension so a panel of B is reused from L2, and the tiles are distributed over std::thread workers.
+// Each output is produced by one worker with exact arithmetic, so the results do not depend on the
+// thread count.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/integer/integer.hpp>
+
+namespace sw { namespace universal {
+
+/// operand layout of the number types the DSP kernels accept
+template<typename T>
+struct dsp_kernel_format {
+	static constexpr bool supported = false;
+};
+
+template<unsigned _nbits, unsigned _rbits, bool arithmetic, typename bt>
+struct dsp_kernel_format<fixpnt<_nbits, _rbits, arithmetic, bt>> {
+	static constexpr bool     supported     = (_nbits <= 32);
+	static constexpr unsigned nbits         = _nbits;
+	static constexpr unsigned fraction_bits = _rbits;   // bits a product has in excess of the result
+	static constexpr bool     saturating    = (arithmetic == Saturate);
+	using block_type = bt;
+};
+
+template<unsigned _nbits, typename bt>
+struct dsp_kernel_format<integer<_nbits, bt, IntegerNumberType::IntegerNumber>> {
+	static constexpr bool     supported     = (_nbits <= 32);
+	static constexpr unsigned nbits         = _nbits;
+	static constexpr unsigned fraction_bits = 0;
+	static constexpr bool     saturating    = false;
+	using block_type = bt;
+};
+
+namespace dsp_detail {
+
+	// outputs per tile: the lanes of a tile stay in L1
+	constexpr std::size_t output_tile = 1024;
+	// gemm tiles: rows of A sharing a panel of B, columns per tile, and depth of the panel
+	constexpr std::size_t gemm_rows   = 16;
+	constexpr std::size_t gemm_cols   = 256;
+	constexpr std::size_t gemm_depth  = 256;
+
+	template<typename T>
+	using raw_t = std::conditional_t<(dsp_kernel_format<T>::nbits <= 16), std::int16_t, std::int32_t>;
+
+	// two's complement value of an encoding, read from its blocks
+	template<typename T, typename Source>
+	inline raw_t<T> raw_from_blocks(const Source& blocks) noexcept {
+		using Format = dsp_kernel_format<T>;
+		constexpr unsigned bitsInBlock = sizeof(typename Format::block_type) * 8;
+		constexpr unsigned nrBlocks = (Format::nbits + bitsInBlock - 1) / bitsInBlock;
+		constexpr unsigned unused = 64 - Format::nbits;
+		std::uint64_t bits = 0;
+		for (unsigned i = 0; i < nrBlocks; ++i) bits |= static_cast<std::uint64_t>(blocks.block(i)) << (i * bitsInBlock);
+		return static_cast<raw_t<T>>(static_cast<std::int64_t>(bits << unused) >> unused);
+	}
+
+	template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+	inline raw_t<fixpnt<nbits, rbits, arithmetic, bt>> raw_value(const fixpnt<nbits, rbits, arithmetic, bt>& v) noexcept {
+		return raw_from_blocks<fixpnt<nbits, rbits, arithmetic, bt>>(v.bits());
+	}
+	template<unsigned nbits, typename bt>
+	inline raw_t<integer<nbits, bt, IntegerNumberType::IntegerNumber>> raw_value(const integer<nbits, bt, IntegerNumberType::IntegerNumber>& v) noexcept {
+		return raw_from_blocks<integer<nbits, bt, IntegerNumberType::IntegerNumber>>(v);
+	}
+
+	// unpack src into dst + offset
+	template<typename T>
+	void unpack(std::span<const T> src, std::vector<raw_t<T>>& dst, std::size_t offset = 0) {
+		for (std::size_t i = 0; i < src.size(); ++i) dst[offset + i] = raw_value(src[i]);
+	}
+
+	// a row of exact sums: lane j holds hi[j] * 2^32 + lo[j]; 16-bit operands only use lo
+	template<typename Raw>
+	class accumulator_row {
+	public:
+		static constexpr bool wide = (sizeof(Raw) > 2);
+
+		explicit accumulator_row(std::size_t n) : lo(n), hi(wide ? n : 0) {}
+
+		void clear(std::size_t n) noexcept {
+			std::fill_n(lo.data(), n, std::int64_t(0));
+			if constexpr (wide) std::fill_n(hi.data(), n, std::int64_t(0));
+		}
+
+		// lanes [0, n) += c * x[0, n)
+		void axpy(Raw c, const Raw* x, std::size_t n) noexcept {
+			std::int64_t* l = lo.data();
+			if constexpr (wide) {
+				std::int64_t* h = hi.data();
+				const std::int64_t cc = c;
+				for (std::size_t j = 0; j < n; ++j) {
+					std::int64_t p = cc * x[j];
+					l[j] += p & 0xFFFF'FFFF;
+					h[j] += p >> 32;
+				}
+			}
+			else {
+				const std::int32_t cc = c;
+				for (std::size_t j = 0; j < n; ++j) l[j] += cc * std::int32_t(x[j]);
+			}
+		}
+
+		std::int64_t low(std::size_t j) const noexcept { return lo[j]; }
+		std::int64_t high(std::size_t j) const noexcept { if constexpr (wide) return hi[j]; else return 0; }
+
+	private:
+		std::vector<std::int64_t> lo, hi;
+	};
+
+	// encoding of the exact sum hi * 2^32 + lo, with rbits fraction bits in excess, rounded to nearest
+	// even at rbits, then wrapped or saturated to nbits
+	template<typename T>
+	std::uint64_t round_sum(std::int64_t hi, std::int64_t lo) noexcept {
+		using Format = dsp_kernel_format<T>;
+		constexpr unsigned nbits = Format::nbits;
+		constexpr unsigned shift = Format::fraction_bits;   // <= nbits <= 32
+		constexpr unsigned s = 32 - shift;                   // weight of hi in the rounded result
+		constexpr std::uint64_t mask = (std::uint64_t(1) << nbits) - 1;
+
+		hi += lo >> 32;
+		std::uint64_t low = static_cast<std::uint64_t>(lo) & 0xFFFF'FFFF;
+		std::uint64_t kept = low >> shift;   // low bits of the truncated result
+		bool roundUp = false;
+		if constexpr (shift > 0) {
+			std::uint64_t rem  = low & ((std::uint64_t(1) << shift) - 1);
+			std::uint64_t half = std::uint64_t(1) << (shift - 1);
+			bool odd = (shift < 32 ? (kept & 1) : (hi & 1));
+			roundUp = (rem > half) || (rem == half && odd);
+		}
+		if constexpr (Format::saturating) {
+			constexpr std::int64_t maxpos = (std::int64_t(1) << (nbits - 1)) - 1;
+			constexpr std::int64_t maxneg = -maxpos - 1;
+			// the result lies in [hi * 2^s, (hi + 1) * 2^s]: decide overflow on hi alone so the
+			// products below cannot overflow
+			if (hi > (maxpos >> s)) return static_cast<std::uint64_t>(maxpos) & mask;
+			if (hi < (maxneg >> s)) return static_cast<std::uint64_t>(maxneg) & mask;
+			std::int64_t q = hi * (std::int64_t(1) << s) + static_cast<std::int64_t>(kept) + (roundUp ? 1 : 0);
+			q = std::clamp(q, maxneg, maxpos);
+			return static_cast<std::uint64_t>(q) & mask;
+		}
+		else {
+			std::uint64_t q = (static_cast<std::uint64_t>(hi) << s) + kept + (roundUp ? 1 : 0);
+			return q & mask;
+		}
+	}
+
+	template<typename T, typename Raw>
+	inline void store(T& v, const accumulator_row<Raw>& acc, std::size_t j) noexcept {
+		v.setbits(round_sum<T>(acc.high(j), acc.low(j)));
+	}
+
+	// run work(begin, end) over [0, nrTiles) split into nrThreads contiguous ranges
+	template<typename Work>
+	void parallel_tiles(std::size_t nrTiles, unsigned nrThreads, Work&& work) {
+		if (nrThreads == 0) nrThreads = 1;
+		if (nrThreads > nrTiles) nrThreads = static_cast<unsigned>(std::max<std::size_t>(nrTiles, 1));
+		if (nrThreads == 1) {
+			work(std::size_t(0), nrTiles);
+			return;
+		}
+		std::vector<std::thread> workers;
+		workers.reserve(nrThreads);
+		std::size_t chunk = (nrTiles + nrThreads - 1) / nrThreads;
+		for (unsigned t = 0; t < nrThreads; ++t) {
+			std::size_t begin = std::min(nrTiles, t * chunk);
+			std::size_t end = std::min(nrTiles, begin + chunk);
+			workers.emplace_back([&work, begin, end] { work(begin, end); });
+		}
+		for (auto& w : workers) w.join();
+	}
+
+	// y[i] = sum g[k] x[i + k] for i < y.size(): the correlation both 1D kernels reduce to
+	template<typename T>
+	void correlate(const std::vector<raw_t<T>>& g, const std::vector<raw_t<T>>& x, std::span<T> y, unsigned nrThreads) {
+		using Raw = raw_t<T>;
+		const std::size_t K = g.size();
+		const std::size_t N = y.size();
+		const std::size_t nrTiles = (N + output_tile - 1) / output_tile;
+		parallel_tiles(nrTiles, nrThreads, [&](std::size_t firstTile, std::size_t lastTile) {
+			accumulator_row<Raw> acc(output_tile);
+			for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+				std::size_t begin = tile * output_tile;
+				std::size_t len = std::min(output_tile, N - begin);
+				acc.clear(len);
+				for (std::size_t k = 0; k < K; ++k) acc.axpy(g[k], x.data() + begin + k, len);
+				for (std::size_t j = 0; j < len; ++j) store(y[begin + j], acc, j);
+			}
+		});
+	}
+
+	// the taps in reverse order, so that convolution becomes correlation
+	template<typename T>
+	std::vector<raw_t<T>> reversed(std::span<const T> h) {
+		std::vector<raw_t<T>> g(h.size());
+		for (std::size_t k = 0; k < h.size(); ++k) g[k] = raw_value(h[h.size() - 1 - k]);
+		return g;
+	}
+
+} // namespace dsp_detail
+
+/// causal FIR filter with zero initial state: y[n] = sum h[k] x[n-k], rounded once per output
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+fir(std::span<const T> h, std::span<const T> x, std::span<T> y, unsigned nrThreads = 1) {
+	using namespace dsp_detail;
+	assert(y.size() >= x.size() && "fir: y must hold one output per input sample");
+	if (x.empty()) return;
+	if (h.empty()) {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i].setzero();
+		return;
+	}
+	std::vector<raw_t<T>> g = reversed(h);
+	std::vector<raw_t<T>> xp(h.size() - 1 + x.size(), 0);   // history of zeros ahead of the first sample
+	unpack(x, xp, h.size() - 1);
+	correlate(g, xp, y.first(x.size()), nrThreads);
+}
+
+/// convolution of x with h, restricted to the outputs that overlap x completely: x.size() - h.size() + 1 of them
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+conv1d(std::span<const T> h, std::span<const T> x, std::span<T> y, unsigned nrThreads = 1) {
+	using namespace dsp_detail;
+	if (h.empty() || x.size() < h.size()) return;
+	const std::size_t N = x.size() - h.size() + 1;
+	assert(y.size() >= N && "conv1d: y must hold x.size() - h.size() + 1 outputs");
+	std::vector<raw_t<T>> g = reversed(h);
+	std::vector<raw_t<T>> xr(x.size());
+	unpack(x, xr);
+	correlate(g, xr, y.first(N), nrThreads);
+}
+
+/// 2D convolution of a row-major xh x xw image with a row-major kh x kw kernel, restricted to the
+/// (xh - kh + 1) x (xw - kw + 1) outputs that overlap the image completely
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+conv2d(std::size_t kh, std::size_t kw, std::span<const T> h, std::size_t xh, std::size_t xw, std::span<const T> x, std::span<T> y, unsigned nrThreads = 1) {
+	using namespace dsp_detail;
+	using Raw = raw_t<T>;
+	if (kh == 0 || kw == 0 || xh < kh || xw < kw) return;
+	assert(h.size() >= kh * kw && x.size() >= xh * xw && "conv2d: operand smaller than its dimensions");
+	const std::size_t oh = xh - kh + 1;
+	const std::size_t ow = xw - kw + 1;
+	assert(y.size() >= oh * ow && "conv2d: y must hold (xh - kh + 1) x (xw - kw + 1) outputs");
+	std::vector<Raw> g = reversed(h.first(kh * kw));   // kernel rotated by 180 degrees
+	std::vector<Raw> xr(xh * xw);
+	unpack(x.first(xh * xw), xr);
+	const std::size_t colTiles = (ow + output_tile - 1) / output_tile;
+	parallel_tiles(oh * colTiles, nrThreads, [&](std::size_t firstTile, std::size_t lastTile) {
+		accumulator_row<Raw> acc(output_tile);
+		for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+			std::size_t r = tile / colTiles;
+			std::size_t begin = (tile % colTiles) * output_tile;
+			std::size_t len = std::min(output_tile, ow - begin);
+			acc.clear(len);
+			for (std::size_t i = 0; i < kh; ++i) {
+				const Raw* row = xr.data() + (r + i) * xw + begin;
+				for (std::size_t j = 0; j < kw; ++j) acc.axpy(g[i * kw + j], row + j, len);
+			}
+			for (std::size_t j = 0; j < len; ++j) store(y[r * ow + begin + j], acc, j);
+		}
+	});
+}
+
+/// C = A B for row-major A (m x k), B (k x n) and C (m x n), every element rounded once
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+gemm(std::size_t m, std::size_t n, std::size_t k, std::span<const T> A, std::span<const T> B, std::span<T> C, unsigned nrThreads = 1) {
+	using namespace dsp_detail;
+	using Raw = raw_t<T>;
+	assert(A.size() >= m * k && B.size() >= k * n && C.size() >= m * n && "gemm: operand smaller than its dimensions");
+	if (m == 0 || n == 0) return;
+	std::vector<Raw> a(m * k), b(k * n);
+	unpack(A.first(m * k), a);
+	unpack(B.first(k * n), b);
+	const std::size_t rowTiles = (m + gemm_rows - 1) / gemm_rows;
+	const std::size_t colTiles = (n + gemm_cols - 1) / gemm_cols;
+	parallel_tiles(rowTiles * colTiles, nrThreads, [&](std::size_t firstTile, std::size_t lastTile) {
+		std::vector<accumulator_row<Raw>> acc(gemm_rows, accumulator_row<Raw>(gemm_cols));
+		for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+			std::size_t i0 = (tile / colTiles) * gemm_rows;
+			std::size_t j0 = (tile % colTiles) * gemm_cols;
+			std::size_t rows = std::min(gemm_rows, m - i0);
+			std::size_t cols = std::min(gemm_cols, n - j0);
+			for (std::size_t i = 0; i < rows; ++i) acc[i].clear(cols);
+			for (std::size_t p0 = 0; p0 < k; p0 += gemm_depth) {
+				std::size_t p1 = std::min(k, p0 + gemm_depth);
+				for (std::size_t i = 0; i < rows; ++i) {
+					const Raw* ai = a.data() + (i0 + i) * k;
+					for (std::size_t p = p0; p < p1; ++p) acc[i].axpy(ai[p], b.data() + p * n + j0, cols);
+				}
+			}
+			for (std::size_t i = 0; i < rows; ++i) {
+				for (std::size_t j = 0; j < cols; ++j) store(C[(i0 + i) * n + j0 + j], acc[i], j);
+			}
+		}
+	});
+}
+
+// std::vector convenience overloads: the output vector is resized to the number of outputs
+
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+fir(const std::vector<T>& h, const std::vector<T>& x, std::vector<T>& y, unsigned nrThreads = 1) {
+	y.resize(x.size());
+	fir<T>(std::span<const T>(h), std::span<const T>(x), std::span<T>(y), nrThreads);
+}
+
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+conv1d(const std::vector<T>& h, const std::vector<T>& x, std::vector<T>& y, unsigned nrThreads = 1) {
+	y.resize(h.empty() || x.size() < h.size() ? 0 : x.size() - h.size() + 1);
+	conv1d<T>(std::span<const T>(h), std::span<const T>(x), std::span<T>(y), nrThreads);
+}
+
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+conv2d(std::size_t kh, std::size_t kw, const std::vector<T>& h, std::size_t xh, std::size_t xw, const std::vector<T>& x, std::vector<T>& y, unsigned nrThreads = 1) {
+	y.resize(kh == 0 || kw == 0 || xh < kh || xw < kw ? 0 : (xh - kh + 1) * (xw - kw + 1));
+	conv2d<T>(kh, kw, std::span<const T>(h), xh, xw, std::span<const T>(x), std::span<T>(y), nrThreads);
+}
+
+template<typename T>
+std::enable_if_t<dsp_kernel_format<T>::supported>
+gemm(std::size_t m, std::size_t n, std::size_t k, const std::vector<T>& A, const std::vector<T>& B, std::vector<T>& C, unsigned nrThreads = 1) {
+	C.resize(m * n);
+	gemm<T>(m, n, k, std::span<const T>(A), std::span<const T>(B), std::span<T>(C), nrThreads);
+}
+
+}} // namespace sw::universal
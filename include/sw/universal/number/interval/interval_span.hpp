@@ -0,0 +1,292 @@
+#pragma once
+// interval_span.hpp: batched interval kernels with hardware directed rounding
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The interval<Scalar> operators round every endpoint of every operation on their own: TwoSum or
+// fma residuals decide whether nextafter has to widen the endpoint. That is Scalar-generic and
+// tight, but for float and double it costs several extra operations and a libm call per endpoint,
+// and the branches keep compilers from vectorizing array code. These kernels work on whole arrays:
+//
+//   interval_add(a, b, c)                   c[i] = a[i] + b[i]
+//   interval_sub(a, b, c)                   c[i] = a[i] - b[i]
+//   interval_mul(a, b, c)                   c[i] = a[i] * b[i]
+//   interval_dot(a, b)                      sum of a[i] * b[i]
+//   interval_matvec(m, n, A, x, y)          y = A x for a row-major m x n interval matrix
+//   interval_residual(m, n, A, x, b, r)     enclosure of b - A x for point data A, x and b
+//
+// For native floating-point Scalars they switch the hardware rounding mode once per block of
+// elements: all lower endpoints of the block are computed rounding toward -inf, then all upper
+// endpoints rounding toward +inf, and the mode is restored before returning. Each endpoint is then
+// one plain operation, or a min/max over the four corner products, which compilers vectorize.
+// A correctly rounded operation in the directed mode is exactly the optimal enclosure the scalar
+// operators compute with their residual tests, so add, sub and mul produce the same endpoints as
+// the element-wise operators for finite inputs. Sums in interval_dot, interval_matvec and
+// interval_residual are split over several accumulators; every partial sum is a valid bound, so
+// the result is an enclosure, although it may differ from a left-to-right loop in the last bits.
+//
+// Two passes with a fixed mode are used instead of the negation trick under round-up
+// (lo = -((-a) + (-b))): without -frounding-math, compilers treat -(-x op y) as x op y and fold
+// the negations away. The kernels only combine values loaded after a mode switch and store them
+// before the next one, so the opaque fesetround call orders them correctly.
+//
+// The rounding mode is per thread, so the kernels are safe to call from several threads. Other
+// Scalar types (cfloat, posit, ...) have no hardware rounding mode and use the element-wise
+// operators, with their nextafter-based outward rounding.
+#include <algorithm>
+#include <cassert>
+#include <cfenv>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <universal/number/interval/interval_impl.hpp>
+
+namespace sw { namespace universal {
+
+/// true when the span kernels for interval<Scalar> use hardware directed rounding
+template<typename Scalar>
+inline constexpr bool interval_directed_rounding_v =
+#if defined(FE_UPWARD) && defined(FE_DOWNWARD)
+	std::is_floating_point_v<Scalar>;
+#else
+	false;
+#endif
+
+namespace interval_detail {
+
+	// intervals processed per rounding-mode switch; two blocks of operands stay in L1
+	constexpr std::size_t span_block = 512;
+
+	// set the rounding mode for the lifetime of the guard, restoring the previous one on exit
+	class rounding_mode_guard {
+	public:
+		rounding_mode_guard() noexcept : _saved{ std::fegetround() } {}
+		~rounding_mode_guard() { std::fesetround(_saved); }
+		rounding_mode_guard(const rounding_mode_guard&) = delete;
+		rounding_mode_guard& operator=(const rounding_mode_guard&) = delete;
+		void downward() noexcept { std::fesetround(FE_DOWNWARD); }
+		void upward() noexcept { std::fesetround(FE_UPWARD); }
+	private:
+		int _saved;
+	};
+
+	// extreme corner products of [al, ah] * [bl, bh] in the current rounding mode
+	template<typename Scalar>
+	inline Scalar min_corner(Scalar al, Scalar ah, Scalar bl, Scalar bh) noexcept {
+		Scalar p0 = al * bl, p1 = al * bh, p2 = ah * bl, p3 = ah * bh;
+		return std::min(std::min(p0, p1), std::min(p2, p3));
+	}
+	template<typename Scalar>
+	inline Scalar max_corner(Scalar al, Scalar ah, Scalar bl, Scalar bh) noexcept {
+		Scalar p0 = al * bl, p1 = al * bh, p2 = ah * bl, p3 = ah * bh;
+		return std::max(std::max(p0, p1), std::max(p2, p3));
+	}
+
+	// number of independent partial sums in the reductions
+	constexpr std::size_t lanes = 8;
+
+	// sum of x[i] * y[i] in the current rounding mode
+	template<typename Scalar>
+	inline Scalar point_dot(const Scalar* x, const Scalar* y, std::size_t n) noexcept {
+		Scalar acc[lanes] = {};
+		std::size_t i = 0;
+		for (; i + lanes <= n; i += lanes) {
+			for (std::size_t k = 0; k < lanes; ++k) acc[k] += x[i + k] * y[i + k];
+		}
+		for (; i < n; ++i) acc[0] += x[i] * y[i];
+		for (std::size_t k = 1; k < lanes; ++k) acc[0] += acc[k];
+		return acc[0];
+	}
+
+	// lower (upper == false) or upper endpoint of the interval dot product in the current rounding mode
+	template<typename Scalar, bool upper>
+	inline Scalar bound_dot(const interval<Scalar>* a, const interval<Scalar>* b, std::size_t n) noexcept {
+		Scalar acc[lanes] = {};
+		std::size_t i = 0;
+		auto term = [&](std::size_t j) {
+			if constexpr (upper) return max_corner(a[j].lo(), a[j].hi(), b[j].lo(), b[j].hi());
+			else return min_corner(a[j].lo(), a[j].hi(), b[j].lo(), b[j].hi());
+		};
+		for (; i + lanes <= n; i += lanes) {
+			for (std::size_t k = 0; k < lanes; ++k) acc[k] += term(i + k);
+		}
+		for (; i < n; ++i) acc[0] += term(i);
+		for (std::size_t k = 1; k < lanes; ++k) acc[0] += acc[k];
+		return acc[0];
+	}
+
+	// the element-wise binary kernels: op(lo pass) and op(hi pass) over blocks
+	template<typename Scalar, typename LowerOp, typename UpperOp>
+	inline void directed_binary(const interval<Scalar>* a, const interval<Scalar>* b, interval<Scalar>* c, std::size_t n, LowerOp lower, UpperOp upper) noexcept {
+		rounding_mode_guard mode;
+		for (std::size_t first = 0; first < n; first += span_block) {
+			std::size_t last = std::min(n, first + span_block);
+			mode.downward();
+			for (std::size_t i = first; i < last; ++i) c[i].setlo(lower(a[i], b[i]));
+			mode.upward();
+			for (std::size_t i = first; i < last; ++i) c[i].sethi(upper(a[i], b[i]));
+		}
+	}
+
+} // namespace interval_detail
+
+/// c[i] = a[i] + b[i]
+template<typename Scalar>
+inline void interval_add(std::span<const interval<Scalar>> a, std::span<const interval<Scalar>> b, std::span<interval<Scalar>> c) {
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (interval_directed_rounding_v<Scalar>) {
+		// c may alias a or b: the lower pass reads only lower endpoints and writes lower endpoints
+		interval_detail::directed_binary(a.data(), b.data(), c.data(), a.size(),
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return x.lo() + y.lo(); },
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return x.hi() + y.hi(); });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] + b[i];
+	}
+}
+
+/// c[i] = a[i] - b[i]
+template<typename Scalar>
+inline void interval_sub(std::span<const interval<Scalar>> a, std::span<const interval<Scalar>> b, std::span<interval<Scalar>> c) {
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (interval_directed_rounding_v<Scalar>) {
+		// the lower pass reads upper endpoints of b, so stage the block when c aliases b
+		if (c.data() == b.data()) {
+			std::vector<interval<Scalar>> t(b.begin(), b.begin() + static_cast<std::ptrdiff_t>(a.size()));
+			interval_sub<Scalar>(a, std::span<const interval<Scalar>>(t), c);
+			return;
+		}
+		interval_detail::directed_binary(a.data(), b.data(), c.data(), a.size(),
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return x.lo() - y.hi(); },
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return x.hi() - y.lo(); });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] - b[i];
+	}
+}
+
+/// c[i] = a[i] * b[i]
+template<typename Scalar>
+inline void interval_mul(std::span<const interval<Scalar>> a, std::span<const interval<Scalar>> b, std::span<interval<Scalar>> c) {
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (interval_directed_rounding_v<Scalar>) {
+		// both passes read both endpoints, so stage the operands when c aliases one of them
+		if (c.data() == a.data() || c.data() == b.data()) {
+			std::vector<interval<Scalar>> ta(a.begin(), a.end()), tb(b.begin(), b.begin() + static_cast<std::ptrdiff_t>(a.size()));
+			interval_mul<Scalar>(std::span<const interval<Scalar>>(ta), std::span<const interval<Scalar>>(tb), c);
+			return;
+		}
+		interval_detail::directed_binary(a.data(), b.data(), c.data(), a.size(),
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return interval_detail::min_corner(x.lo(), x.hi(), y.lo(), y.hi()); },
+			[](const interval<Scalar>& x, const interval<Scalar>& y) { return interval_detail::max_corner(x.lo(), x.hi(), y.lo(), y.hi()); });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] * b[i];
+	}
+}
+
+/// enclosure of the dot product of a and b
+template<typename Scalar>
+inline interval<Scalar> interval_dot(std::span<const interval<Scalar>> a, std::span<const interval<Scalar>> b) {
+	assert(b.size() >= a.size());
+	interval<Scalar> result(Scalar(0));
+	if constexpr (interval_directed_rounding_v<Scalar>) {
+		interval_detail::rounding_mode_guard mode;
+		Scalar lo(0), hi(0);
+		for (std::size_t first = 0; first < a.size(); first += interval_detail::span_block) {
+			std::size_t count = std::min(a.size() - first, interval_detail::span_block);
+			mode.downward();
+			lo += interval_detail::bound_dot<Scalar, false>(a.data() + first, b.data() + first, count);
+			mode.upward();
+			hi += interval_detail::bound_dot<Scalar, true>(a.data() + first, b.data() + first, count);
+		}
+		result.setlo(lo);
+		result.sethi(hi);
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) result += a[i] * b[i];
+	}
+	return result;
+}
+
+/// y = A x, with A an m x n interval matrix in row-major order
+template<typename Scalar>
+inline void interval_matvec(std::size_t m, std::size_t n, std::span<const interval<Scalar>> A, std::span<const interval<Scalar>> x, std::span<interval<Scalar>> y) {
+	assert(A.size() >= m * n && x.size() >= n && y.size() >= m);
+	for (std::size_t i = 0; i < m; ++i) y[i] = interval_dot<Scalar>(A.subspan(i * n, n), x.first(n));
+}
+
+/// r = enclosure of b - A x for point data, with A an m x n matrix in row-major order.
+/// This is the residual of an approximate solution x of A x = b, validated by the enclosure.
+template<typename Scalar>
+inline void interval_residual(std::size_t m, std::size_t n, std::span<const Scalar> A, std::span<const Scalar> x, std::span<const Scalar> b, std::span<interval<Scalar>> r) {
+	assert(A.size() >= m * n && x.size() >= n && b.size() >= m && r.size() >= m);
+	if constexpr (interval_directed_rounding_v<Scalar>) {
+		constexpr std::size_t rows = 64;
+		Scalar axLo[rows], axHi[rows];
+		interval_detail::rounding_mode_guard mode;
+		for (std::size_t first = 0; first < m; first += rows) {
+			std::size_t count = std::min(m - first, rows);
+			mode.downward();
+			for (std::size_t k = 0; k < count; ++k) axLo[k] = interval_detail::point_dot(A.data() + (first + k) * n, x.data(), n);
+			mode.upward();
+			for (std::size_t k = 0; k < count; ++k) {
+				axHi[k] = interval_detail::point_dot(A.data() + (first + k) * n, x.data(), n);
+				r[first + k].sethi(b[first + k] - axLo[k]);
+			}
+			mode.downward();
+			for (std::size_t k = 0; k < count; ++k) r[first + k].setlo(b[first + k] - axHi[k]);
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < m; ++i) {
+			interval<Scalar> ax(Scalar(0));
+			for (std::size_t j = 0; j < n; ++j) ax += interval<Scalar>(A[i * n + j]) * interval<Scalar>(x[j]);
+			r[i] = interval<Scalar>(b[i]) - ax;
+		}
+	}
+}
+
+// std::vector conveniences; the output is resized to the length of the first operand
+
+template<typename Scalar>
+inline void interval_add(const std::vector<interval<Scalar>>& a, const std::vector<interval<Scalar>>& b, std::vector<interval<Scalar>>& c) {
+	c.resize(a.size());
+	interval_add<Scalar>(std::span<const interval<Scalar>>(a), std::span<const interval<Scalar>>(b), std::span<interval<Scalar>>(c));
+}
+
+template<typename Scalar>
+inline void interval_sub(const std::vector<interval<Scalar>>& a, const std::vector<interval<Scalar>>& b, std::vector<interval<Scalar>>& c) {
+	c.resize(a.size());
+	interval_sub<Scalar>(std::span<const interval<Scalar>>(a), std::span<const interval<Scalar>>(b), std::span<interval<Scalar>>(c));
+}
+
+template<typename Scalar>
+inline void interval_mul(const std::vector<interval<Scalar>>& a, const std::vector<interval<Scalar>>& b, std::vector<interval<Scalar>>& c) {
+	c.resize(a.size());
+	interval_mul<Scalar>(std::span<const interval<Scalar>>(a), std::span<const interval<Scalar>>(b), std::span<interval<Scalar>>(c));
+}
+
+template<typename Scalar>
+inline interval<Scalar> interval_dot(const std::vector<interval<Scalar>>& a, const std::vector<interval<Scalar>>& b) {
+	return interval_dot<Scalar>(std::span<const interval<Scalar>>(a), std::span<const interval<Scalar>>(b));
+}
+
+template<typename Scalar>
+inline void interval_matvec(std::size_t m, std::size_t n, const std::vector<interval<Scalar>>& A, const std::vector<interval<Scalar>>& x, std::vector<interval<Scalar>>& y) {
+	y.resize(m);
+	interval_matvec<Scalar>(m, n, std::span<const interval<Scalar>>(A), std::span<const interval<Scalar>>(x), std::span<interval<Scalar>>(y));
+}
+
+template<typename Scalar>
+inline void interval_residual(std::size_t m, std::size_t n, const std::vector<Scalar>& A, const std::vector<Scalar>& x, const std::vector<Scalar>& b, std::vector<interval<Scalar>>& r) {
+	r.resize(m);
+	interval_residual<Scalar>(m, n, std::span<const Scalar>(A), std::span<const Scalar>(x), std::span<const Scalar>(b), std::span<interval<Scalar>>(r));
+}
+
+}} // namespace sw::universal
@@ -683,8 +683,9 @@ protected:
 		// our fixed-point has its radixPoint at rbits
 		int shiftRight = radixPoint - int(rbits);
 		if (shiftRight > 0) {
-			if (shiftRight > 63) {
+			if (shiftRight > 64) {
 				// this shift degree would be undefined behavior, but the intended transformation is that we have no bits
+				// a shift of exactly 64 still rounds: the 64-bit significand of long double puts its hidden bit in the guard position
 				rawFraction = 0;
 			}
 			else {
@@ -707,7 +708,7 @@ protected:
 				}
 				bool sticky = (mask & rawFraction);
 
-				rawFraction >>= shiftRight;  // shift out the bits we are rounding away
+				rawFraction = (shiftRight < 64) ? (rawFraction >> shiftRight) : 0;  // shift out the bits we are rounding away
 				bool lsb = (rawFraction & 0x1ul);
 				//  ... lsb | guard  round sticky   round
 				//       x     0       x     x       down
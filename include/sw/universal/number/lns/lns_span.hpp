@@ -0,0 +1,235 @@
+#pragma once
+// lns_span.hpp: batched lns math functions over arrays
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The log-domain kernels of math/log_domain.hpp over whole arrays of an lns configuration of at most
+// 64 bits, for the elementwise stages of softmax and normalization kernels:
+//
+//   lns_sqrt(x, y)         y[i] = sqrt(x[i])
+//   lns_rsqrt(x, y)        y[i] = rsqrt(x[i])
+//   lns_pow(x, n, y)       y[i] = pow(x[i], n)
+//   lns_exp2(x, y)         y[i] = exp2(x[i])
+//   lns_exp(x, y)          y[i] = exp(x[i])
+//   lns_log2(x, y)         y[i] = log2(x[i])
+//   lns_log(x, y)          y[i] = log(x[i])
+//   lns_hypot(a, b, c)     c[i] = hypot(a[i], b[i])
+//
+// Each element is read as one 64-bit word, run through the raw-word kernel, and written back with
+// setbits, without the special-value dispatch and object copies of the scalar functions. sqrt, rsqrt,
+// and pow are a few integer operations per element with no dependency between elements; exp and log
+// are one libm call each, and hypot one Gauss correction. Elements that need the diagnostics or
+// exceptions of the scalar functions (a negative sqrt argument, a zero or negative rsqrt argument) are
+// finished by the scalar functions, so the results are those of the scalar functions, bit for bit.
+//
+// The output may alias an input: element i is written only after the operands of element i are read.
+// Configurations wider than 64 bits use the scalar functions.
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <universal/number/lns/lns.hpp>
+
+namespace sw { namespace universal {
+
+namespace lns_detail {
+
+	// y[i] = f(x[i]) with the raw-word kernel
+	template<typename Lns, typename Kernel>
+	inline void unary(const Lns* x, Lns* y, std::size_t n, Kernel kernel) {
+		for (std::size_t i = 0; i < n; ++i) y[i].setbits(kernel(lns_log_domain<Lns>::bits(x[i])));
+	}
+
+	// y[i] = f(x[i]) with the raw-word kernel where the arguments are positive, and the scalar function elsewhere
+	template<typename Lns, typename Kernel, typename Scalar>
+	inline void positive(const Lns* x, Lns* y, std::size_t n, Kernel kernel, Scalar scalar) {
+		using LogDomain = lns_log_domain<Lns>;
+		for (std::size_t i = 0; i < n; ++i) {
+			uint64_t raw = LogDomain::bits(x[i]);
+			if (LogDomain::negative(raw) || LogDomain::special(raw)) y[i] = scalar(x[i]);
+			else y[i].setbits(kernel(raw));
+		}
+	}
+
+} // namespace lns_detail
+
+/// y[i] = sqrt(x[i])
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_sqrt(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::positive(x.data(), y.data(), x.size(),
+			[](uint64_t r) { return LogDomain::sqrtBits(r); },
+			[](const Lns& v) { return sqrt(v); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = sqrt(x[i]);
+	}
+}
+
+/// y[i] = 1 / sqrt(x[i])
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_rsqrt(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::positive(x.data(), y.data(), x.size(),
+			[](uint64_t r) { return LogDomain::rsqrtBits(r); },
+			[](const Lns& v) { return rsqrt(v); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = rsqrt(x[i]);
+	}
+}
+
+/// y[i] = x[i]^n
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_pow(std::span<const lns<nbits, rbits, bt, xtra...>> x, int n, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::unary(x.data(), y.data(), x.size(), [n](uint64_t r) { return LogDomain::powBits(r, n); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = pow(x[i], n);
+	}
+}
+
+/// y[i] = 2^x[i]
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_exp2(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::unary(x.data(), y.data(), x.size(), [](uint64_t r) { return LogDomain::exp2Bits(r); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = exp2(x[i]);
+	}
+}
+
+/// y[i] = e^x[i]
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_exp(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::unary(x.data(), y.data(), x.size(), [](uint64_t r) { return LogDomain::expBits(r, LogDomain::LOG2_E); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = exp(x[i]);
+	}
+}
+
+/// y[i] = log2(x[i])
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_log2(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::unary(x.data(), y.data(), x.size(), [](uint64_t r) { return LogDomain::logBits(r, 1.0); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = log2(x[i]);
+	}
+}
+
+/// y[i] = ln(x[i])
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_log(std::span<const lns<nbits, rbits, bt, xtra...>> x, std::span<lns<nbits, rbits, bt, xtra...>> y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(y.size() >= x.size());
+	if constexpr (LogDomain::native) {
+		lns_detail::unary(x.data(), y.data(), x.size(), [](uint64_t r) { return LogDomain::logBits(r, LogDomain::LN_2); });
+	}
+	else {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = log(x[i]);
+	}
+}
+
+/// c[i] = hypot(a[i], b[i]), with the Gauss correction of the add/sub policy of the configuration
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_hypot(std::span<const lns<nbits, rbits, bt, xtra...>> a, std::span<const lns<nbits, rbits, bt, xtra...>> b, std::span<lns<nbits, rbits, bt, xtra...>> c) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<Lns>;
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (LogDomain::native) {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i].setbits(LogDomain::hypotBits(LogDomain::bits(a[i]), LogDomain::bits(b[i])));
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = hypot(a[i], b[i]);
+	}
+}
+
+// std::vector conveniences; the output is resized to the length of the input
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_sqrt(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_sqrt(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_rsqrt(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_rsqrt(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_pow(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, int n, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_pow(std::span<const Lns>(x), n, std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_exp2(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_exp2(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_exp(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_exp(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_log2(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_log2(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_log(const std::vector<lns<nbits, rbits, bt, xtra...>>& x, std::vector<lns<nbits, rbits, bt, xtra...>>& y) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	y.resize(x.size());
+	lns_log(std::span<const Lns>(x), std::span<Lns>(y));
+}
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+inline void lns_hypot(const std::vector<lns<nbits, rbits, bt, xtra...>>& a, const std::vector<lns<nbits, rbits, bt, xtra...>>& b, std::vector<lns<nbits, rbits, bt, xtra...>>& c) {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	c.resize(a.size());
+	lns_hypot(std::span<const Lns>(a), std::span<const Lns>(b), std::span<Lns>(c));
+}
+
+}} // namespace sw::universal
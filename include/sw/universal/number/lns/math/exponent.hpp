@@ -5,23 +5,33 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/lns/math/log_domain.hpp>
 
 namespace sw { namespace universal {
 
-// the current shims are NON-COMPLIANT with the Universal standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// exp2, exp, and exp10 are native to the log domain: the value of the argument, scaled by log2 of the
+// base, is the exponent of the result, which is rounded once. Configurations wider than 64 bits are
+// NON-COMPLIANT shims through double, as is expm1 for small arguments, and the Universal standard says
+// that every function must be correctly rounded for every input value.
 
 // Base-e exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp(lns<nbits, rbits, bt, xtra...> x) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
 	if (isnan(x)) return x;
-	lns<nbits, rbits, bt, xtra...> p;
-	double d = std::exp(double(x));
-	if (d == 0.0) {
-		p.minpos();
+	LnsType p;
+	if constexpr (LogDomain::native) {
+		p.setbits(LogDomain::expBits(LogDomain::bits(x), LogDomain::LOG2_E));
 	}
 	else {
-		p = d;
+		double d = std::exp(double(x));
+		if (d == 0.0) {
+			p.minpos();
+		}
+		else {
+			p = d;
+		}
 	}
 	return p;
 }
@@ -29,14 +39,21 @@ lns<nbits, rbits, bt, xtra...> exp(lns<nbits, rbits, bt, xtra...> x) {
 // Base-2 exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp2(lns<nbits, rbits, bt, xtra...> x) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
 	if (isnan(x)) return x;
-	lns<nbits, rbits, bt, xtra...> p;
-	double d = std::exp2(double(x));
-	if (d == 0.0) {
-		p.minpos();
+	LnsType p;
+	if constexpr (LogDomain::native) {
+		p.setbits(LogDomain::exp2Bits(LogDomain::bits(x)));
 	}
 	else {
-		p = d;
+		double d = std::exp2(double(x));
+		if (d == 0.0) {
+			p.minpos();
+		}
+		else {
+			p = d;
+		}
 	}
 	return p;
 }
@@ -44,14 +61,41 @@ lns<nbits, rbits, bt, xtra...> exp2(lns<nbits, rbits, bt, xtra...> x) {
 // Base-10 exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp10(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(10.0, double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType p;
+		p.setbits(LogDomain::exp10Bits(LogDomain::bits(x)));
+		return p;
+	}
+	else {
+		return LnsType(std::pow(10.0, double(x)));
+	}
 }
 		
-// Base-e exponential function exp(x)-1
+// Base-e exponential function exp(x)-1: the subtraction of one is a Gauss correction
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> expm1(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::expm1(double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		uint64_t raw = LogDomain::bits(x);
+		if (LogDomain::special(raw)) return x;
+		double v = LogDomain::value(raw);
+		if (std::fabs(v) < 0.5) return LnsType(std::expm1(v));
+		double E = v * LogDomain::LOG2_E;  // log2(e^x)
+		LnsType p;
+		if (v > 0.0) {
+			p.setbits(LogDomain::encodeLog2(false, E + detail::lns_sb_sub<LnsType>(-E)));  // 2^E - 1
+		}
+		else {
+			p.setbits(LogDomain::encodeLog2(true, detail::lns_sb_sub<LnsType>(E)));        // -(1 - 2^E)
+		}
+		return p;
+	}
+	else {
+		return LnsType(std::expm1(double(x)));
+	}
 }
 
-
 }} // namespace sw::universal
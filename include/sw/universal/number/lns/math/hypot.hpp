@@ -38,12 +38,24 @@ POSIX specifies that underflow may only occur when both arguments are subnormal
 
 hypot(INFINITY, NAN) returns +8, but sqrt(INFINITY*INFINITY+NAN*NAN) returns NaN.
 */
+#include <universal/number/lns/math/log_domain.hpp>
 
 namespace sw { namespace universal {
 
+// in the log domain, hypot is the larger exponent plus one Gauss correction of the squares, which
+// cannot overflow or underflow at an intermediate stage
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> hypot(lns<nbits, rbits, bt, xtra...> x, lns<nbits, rbits, bt, xtra...> y) {
-	return lns<nbits, rbits, bt, xtra...>(std::hypot(double(x),double(y)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::hypotBits(LogDomain::bits(x), LogDomain::bits(y)));
+		return r;
+	}
+	else {
+		return LnsType(std::hypot(double(x), double(y)));
+	}
 }
 
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
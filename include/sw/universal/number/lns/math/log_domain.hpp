@@ -0,0 +1,236 @@
+#pragma once
+// log_domain.hpp: native log-domain kernels for the lns math functions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// An lns encodes sign * 2^(e / 2^rbits), with e the two's complement fixed-point exponent held in the
+// lower nbits-1 bits. The functions that are linear in log2(x) reduce to integer operations on e:
+//
+//   sqrt(x)      e / 2, rounded to nearest even
+//   rsqrt(x)     -e / 2, rounded to nearest even
+//   pow(x, n)    e * n, exact
+//   pow(x, y)    e * y, rounded
+//   exp2(x)      the value of x becomes the exponent:  e = x * 2^rbits, rounded
+//   log2(x)      the exponent becomes the value:       log2(x) = e / 2^rbits, encoded
+//
+// exp, exp10, log, and log10 are the same operations with the constant scale log2(e), log2(10), ln(2),
+// or log10(2). The integer results saturate or wrap like the lns multiply; rounded real exponents
+// saturate onto maxpos and zero, except that exp and exp2, which are positive everywhere, saturate an
+// underflow onto minpos like their double reference does.
+//
+// The additive functions reduce to one Gauss correction, sb_add(d) = log2(1 + 2^d) or
+// sb_sub(d) = log2(1 - 2^d) for d <= 0, taken from the add/sub policy that lns_addsub_traits selects
+// for the configuration, so they share the accuracy and cost of lns addition:
+//
+//   hypot(x, y)  max(Lx, Ly) + sb_add(2 * (min - max)) / 2
+//   log1p(x)     ln(2) * (max(Lx, 0) + sb_add(-|Lx|)), or ln(2) * sb_sub(Lx) for x < 0
+//   expm1(x)     with E = x * log2(e): E + sb_sub(-E), or the negated sb_sub(E) for x < 0
+//
+// The Gauss correction has a bounded absolute error in the log domain, which log1p and expm1 cannot
+// afford when their result is much smaller than one: arguments below one half in magnitude take the
+// double functions instead. Policies without their own sb_add/sb_sub (DoubleTripAddSub) evaluate the
+// corrections directly.
+//
+// lns configurations of at most 64 bits take these kernels; the math headers keep the double
+// reference for wider ones. Set LNS_NATIVE_MATH to 0 to route all of them through double.
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <universal/number/lns/lns_addsub_algorithms.hpp>
+
+#if !defined(LNS_NATIVE_MATH)
+#define LNS_NATIVE_MATH 1
+#endif
+
+namespace sw { namespace universal {
+
+namespace detail {
+
+	// sb_add(d) = log2(1 + 2^d), d <= 0, from the add/sub policy of the configuration
+	template<typename Lns>
+	inline double lns_sb_add(double d) {
+		using Policy = lns_addsub_algorithm_t<Lns>;
+		if (d < -1024.0) d = -1024.0;  // far below any lns resolution, and keeps 2^d representable
+		if constexpr (requires { Policy::sb_add(d); }) return Policy::sb_add(d);
+		else return DirectEvaluationAddSub<Lns>::sb_add(d);
+	}
+
+	// sb_sub(d) = log2(1 - 2^d), d < 0, from the add/sub policy of the configuration
+	template<typename Lns>
+	inline double lns_sb_sub(double d) {
+		using Policy = lns_addsub_algorithm_t<Lns>;
+		if (d < -1024.0) d = -1024.0;
+		if constexpr (requires { Policy::sb_sub(d); }) return Policy::sb_sub(d);
+		else return DirectEvaluationAddSub<Lns>::sb_sub(d);
+	}
+
+} // namespace detail
+
+/// <summary>
+/// lns_log_domain gives access to the encoding of an lns of at most 64 bits as a machine word, and
+/// implements the log-domain kernels on it. The kernels take and return raw encodings and are shared
+/// between the scalar math functions and the span functions of lns_span.hpp.
+/// </summary>
+/// <typeparam name="Lns">the lns configuration</typeparam>
+template<typename Lns>
+struct lns_log_domain {
+	static constexpr unsigned nbits      = Lns::nbits;
+	static constexpr unsigned rbits      = Lns::rbits;
+	static constexpr bool     native     = LNS_NATIVE_MATH && nbits >= 3 && nbits <= 64;
+	static constexpr bool     saturating = (Lns::behavior == Behavior::Saturating);
+
+	static constexpr unsigned ebits        = (native ? nbits - 1 : 2);  // width of the exponent field
+	static constexpr uint64_t EXP_MASK     = (1ull << ebits) - 1ull;
+	static constexpr uint64_t SIGN         = 1ull << ebits;
+	static constexpr uint64_t ZERO         = 1ull << (ebits - 1);     // the reserved exponent 100..0
+	static constexpr uint64_t NaN          = SIGN | ZERO;
+	static constexpr uint64_t ONE          = 0;
+	static constexpr int64_t  MAX_EXPONENT = static_cast<int64_t>(ZERO - 1ull);
+	static constexpr int64_t  MIN_EXPONENT = -MAX_EXPONENT;
+	static constexpr double   scaling      = Lns::scaling;            // 2^rbits
+
+	static constexpr double LOG2_E  = 1.4426950408889634;   // log2(e)
+	static constexpr double LOG2_10 = 3.3219280948873622;   // log2(10)
+	static constexpr double LN_2    = 0.6931471805599453;   // ln(2)
+	static constexpr double LOG10_2 = 0.30102999566398120;  // log10(2)
+
+	// the encoding of v
+	static constexpr uint64_t bits(const Lns& v) noexcept {
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < Lns::nrBlocks; ++b) raw |= static_cast<uint64_t>(v.block(b)) << (b * Lns::bitsInBlock);
+		return raw;
+	}
+	static constexpr bool negative(uint64_t raw) noexcept { return (raw & SIGN) != 0; }
+	// zero or NaN
+	static constexpr bool special(uint64_t raw) noexcept { return (raw & EXP_MASK) == ZERO; }
+	// the sign-extended fixed-point exponent
+	static constexpr int64_t exponent(uint64_t raw) noexcept {
+		return static_cast<int64_t>(raw << (64u - ebits)) >> (64u - ebits);
+	}
+	// log2 of the magnitude
+	static constexpr double log2(uint64_t raw) noexcept { return static_cast<double>(exponent(raw)) / scaling; }
+	// the value of an encoding
+	static double value(uint64_t raw) noexcept {
+		if (special(raw)) return (raw == ZERO ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+		double magnitude = std::exp2(log2(raw));
+		return negative(raw) ? -magnitude : magnitude;
+	}
+
+	// sign * 2^(e / 2^rbits), with the overflow behavior of the lns multiply
+	static constexpr uint64_t encode(bool negative, int64_t e) noexcept {
+		if constexpr (saturating) {
+			if (e < MIN_EXPONENT) return ZERO;
+			if (e > MAX_EXPONENT) e = MAX_EXPONENT;
+		}
+		return (static_cast<uint64_t>(e) & EXP_MASK) | (negative ? SIGN : 0ull);
+	}
+	// sign * 2^(e / 2^rbits) for a real exponent e, rounded to nearest even and saturated
+	static uint64_t encodeExponent(bool negative, double e) noexcept {
+		if (e != e) return NaN;
+		if (e >= static_cast<double>(MAX_EXPONENT)) return encode(negative, MAX_EXPONENT);
+		if (e < static_cast<double>(MIN_EXPONENT) - 0.5) return ZERO;
+		int64_t rounded = static_cast<int64_t>(std::nearbyint(e));
+		if (rounded < MIN_EXPONENT) return ZERO;
+		return encode(negative, rounded);
+	}
+	// sign * 2^L
+	static uint64_t encodeLog2(bool negative, double L) noexcept { return encodeExponent(negative, L * scaling); }
+
+	// sqrt: half the exponent, the ties of odd exponents rounded to even
+	static constexpr uint64_t sqrtBits(uint64_t raw) noexcept {
+		if (special(raw) || negative(raw)) return (raw == ZERO ? ZERO : NaN);
+		int64_t e = exponent(raw);
+		int64_t h = e >> 1;
+		h += (e & h & 1);
+		return encode(false, h);
+	}
+	// rsqrt: the negated half exponent, rounded once
+	static constexpr uint64_t rsqrtBits(uint64_t raw) noexcept {
+		if (special(raw) || negative(raw)) return NaN;
+		int64_t e = -exponent(raw);
+		int64_t h = e >> 1;
+		h += (e & h & 1);
+		return encode(false, h);
+	}
+	// x^n: the exponent times n, and the sign of x for odd n
+	static constexpr uint64_t powBits(uint64_t raw, int n) noexcept {
+		if (n == 0) return ONE;
+		if (raw == NaN) return NaN;
+		if (raw == ZERO) return (n > 0 ? ZERO : encode(false, MAX_EXPONENT));  // x^-n is +inf, which lns saturates
+		int64_t e = exponent(raw);
+		int64_t p{ 0 };
+		if constexpr (saturating) {
+			uint64_t me = static_cast<uint64_t>(e < 0 ? -e : e);
+			uint64_t mn = (n < 0 ? 0ull - static_cast<uint64_t>(static_cast<int64_t>(n)) : static_cast<uint64_t>(n));
+			if (me != 0 && mn > static_cast<uint64_t>(MAX_EXPONENT) / me) {
+				p = ((e < 0) != (n < 0)) ? MIN_EXPONENT - 1 : MAX_EXPONENT;
+			}
+			else {
+				p = e * n;
+			}
+		}
+		else {
+			p = static_cast<int64_t>(static_cast<uint64_t>(e) * static_cast<uint64_t>(static_cast<int64_t>(n)));
+		}
+		return encode(negative(raw) && (n & 1), p);
+	}
+	// x^y: the exponent times y, rounded, with the special cases of std::pow
+	static uint64_t powBits(uint64_t raw, double y) noexcept {
+		if (y == 0.0 || raw == ONE) return ONE;
+		if (raw == NaN || y != y) return NaN;
+		if (raw == ZERO) return (y > 0.0 ? ZERO : encode(false, MAX_EXPONENT));
+		bool odd = false;
+		if (negative(raw)) {
+			if (y != std::trunc(y)) return NaN;                   // negative base and a fractional power
+			odd = (std::fabs(y) < 9007199254740992.0) && (std::fmod(y, 2.0) != 0.0);
+		}
+		if (exponent(raw) == 0) return encode(odd, 0);                 // (-1)^y, also for infinite y
+		return encodeExponent(odd, static_cast<double>(exponent(raw)) * y);
+	}
+	// 2^x: the value of x is the exponent of the result, and an underflow saturates onto minpos
+	static uint64_t exp2Bits(uint64_t raw) noexcept {
+		if (raw == NaN) return NaN;
+		if (raw == ZERO) return ONE;
+		return minposOnUnderflow(encodeLog2(false, value(raw)));
+	}
+	// e^x: a scaled exponent, and an underflow saturates onto minpos
+	static uint64_t expBits(uint64_t raw, double log2OfBase) noexcept {
+		if (raw == NaN) return NaN;
+		if (raw == ZERO) return ONE;
+		return minposOnUnderflow(encodeLog2(false, value(raw) * log2OfBase));
+	}
+	// 10^x: a scaled exponent, and an underflow rounds to zero like the conversion from double
+	static uint64_t exp10Bits(uint64_t raw) noexcept {
+		if (raw == NaN) return NaN;
+		if (raw == ZERO) return ONE;
+		return encodeLog2(false, value(raw) * LOG2_10);
+	}
+	// the positive result of an exponential never rounds to zero
+	static constexpr uint64_t minposOnUnderflow(uint64_t raw) noexcept { return raw == ZERO ? encode(false, MIN_EXPONENT) : raw; }
+	// log2(x) * scale, e.g. ln(x) for scale = ln(2): the exponent of x is the binary logarithm
+	static uint64_t logBits(uint64_t raw, double scale) noexcept {
+		if (raw == ZERO) return encode(true, MAX_EXPONENT);   // -inf, which lns saturates onto maxneg
+		if (negative(raw)) return NaN;
+		double v = log2(raw) * scale;
+		if (v == 0.0) return ZERO;
+		return encodeLog2(v < 0.0, std::log2(std::fabs(v)));
+	}
+	// hypot(x, y): the larger exponent and one Gauss correction of the squares
+	static uint64_t hypotBits(uint64_t x, uint64_t y) noexcept {
+		if (x == NaN || y == NaN) return NaN;
+		if (x == ZERO) return (y == ZERO ? ZERO : (y & ~SIGN));
+		if (y == ZERO) return x & ~SIGN;
+		int64_t ex = exponent(x), ey = exponent(y);
+		int64_t emax = (ex >= ey ? ex : ey);
+		int64_t emin = (ex >= ey ? ey : ex);
+		double correction = 0.5 * scaling * detail::lns_sb_add<Lns>(2.0 * static_cast<double>(emin - emax) / scaling);
+		int64_t c = static_cast<int64_t>(std::nearbyint(correction));
+		return encode(false, (emax > MAX_EXPONENT - c) ? MAX_EXPONENT : emax + c);
+	}
+};
+
+}} // namespace sw::universal
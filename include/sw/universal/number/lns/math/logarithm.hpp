@@ -4,31 +4,85 @@
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/lns/math/log_domain.hpp>
 
 namespace sw { namespace universal {
 
 // Natural logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log(double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::logBits(LogDomain::bits(x), LogDomain::LN_2));
+		return r;
+	}
+	else {
+		return LnsType(std::log(double(x)));
+	}
 }
 
 // Binary logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log2(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log2(double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::logBits(LogDomain::bits(x), 1.0));
+		return r;
+	}
+	else {
+		return LnsType(std::log2(double(x)));
+	}
 }
 
 // Decimal logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log10(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log10(double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::logBits(LogDomain::bits(x), LogDomain::LOG10_2));
+		return r;
+	}
+	else {
+		return LnsType(std::log10(double(x)));
+	}
 }
 		
-// Natural logarithm of 1+x
+// Natural logarithm of 1+x: the addition of one is a Gauss correction
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log1p(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log1p(double(x)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		uint64_t raw = LogDomain::bits(x);
+		if (LogDomain::special(raw)) return x;
+		double v = LogDomain::value(raw);
+		if (std::fabs(v) < 0.5) return LnsType(std::log1p(v));
+		double L = LogDomain::log2(raw);
+		LnsType r;
+		if (v > 0.0) {
+			double s = (L >= 0.0 ? L + detail::lns_sb_add<LnsType>(-L) : detail::lns_sb_add<LnsType>(L));  // log2(1 + x)
+			r = s * LogDomain::LN_2;
+		}
+		else if (L < 0.0) {
+			r = detail::lns_sb_sub<LnsType>(L) * LogDomain::LN_2;  // log2(1 - |x|)
+		}
+		else if (L == 0.0) {
+			r = -std::numeric_limits<double>::infinity();          // x = -1
+		}
+		else {
+			r.setnan();                                             // x < -1
+		}
+		return r;
+	}
+	else {
+		return LnsType(std::log1p(double(x)));
+	}
 }
 
 }} // namespace sw::universal
@@ -5,22 +5,52 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/lns/math/log_domain.hpp>
 
 namespace sw { namespace universal {
 
+// x^y: the exponent of x scaled by y, rounded once
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, lns<nbits, rbits, bt, xtra...> y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::powBits(LogDomain::bits(x), LogDomain::value(LogDomain::bits(y))));
+		return r;
+	}
+	else {
+		return LnsType(std::pow(double(x), double(y)));
+	}
 }
-		
+
+// x^n: the exponent of x times n, exact up to saturation
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, int y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::powBits(LogDomain::bits(x), y));
+		return r;
+	}
+	else {
+		return LnsType(std::pow(double(x), double(y)));
+	}
 }
-		
+
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, double y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), y));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	using LogDomain = lns_log_domain<LnsType>;
+	if constexpr (LogDomain::native) {
+		LnsType r;
+		r.setbits(LogDomain::powBits(LogDomain::bits(x), y));
+		return r;
+	}
+	else {
+		return LnsType(std::pow(double(x), y));
+	}
 }
 
 }} // namespace sw::universal
@@ -6,12 +6,9 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/native/ieee754.hpp>
+#include <universal/number/lns/math/log_domain.hpp>
 //#include <universal/number/lns/math/sqrt_tables.hpp>
 
-#ifndef LNS_NATIVE_SQRT
-#define LNS_NATIVE_SQRT 0
-#endif
-
 namespace sw { namespace universal {
 
 /*
@@ -76,36 +73,40 @@ namespace sw { namespace universal {
 	*/
 
 
-#if LNS_NATIVE_SQRT
-	// sqrt for arbitrary lns
-	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
-	inline lns<nbits, rbits, bt, xtra...> sqrt(const lns<nbits, rbits, bt, xtra...>& a) {
-#if LNS_THROW_ARITHMETIC_EXCEPTION
-		if (a.isneg()) throw lns_negative_sqrt_arg();
-#else
-		if (a.isneg()) std::cerr << "lns argument to sqrt is negative: " << a << std::endl;
-#endif
-		if (a.iszero()) return a;
-		return lns<nbits, rbits, bt, xtra...>(std::sqrt((double)a));  // TBD
-	}
-#else
+	// sqrt for arbitrary lns: half the fixed-point exponent, rounded to nearest even
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> sqrt(const lns<nbits, rbits, bt, xtra...>& a) {
+		using LnsType = lns<nbits, rbits, bt, xtra...>;
+		using LogDomain = lns_log_domain<LnsType>;
 #if LNS_THROW_ARITHMETIC_EXCEPTION
 		if (a.isneg()) throw lns_negative_sqrt_arg();
 #else
 		if (a.isneg()) std::cerr << "lns argument to sqrt is negative: " << a << std::endl;
 #endif
 		if (a.iszero()) return a;
-		return lns<nbits, rbits, bt, xtra...>(std::sqrt((double)a));
+		if constexpr (LogDomain::native) {
+			LnsType r;
+			r.setbits(LogDomain::sqrtBits(LogDomain::bits(a)));
+			return r;
+		}
+		else {
+			return LnsType(std::sqrt((double)a));
+		}
 	}
-#endif
 
-	// reciprocal sqrt
+	// reciprocal sqrt: the negated half exponent, rounded once
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> rsqrt(const lns<nbits, rbits, bt, xtra...>& a) {
-		lns<nbits, rbits, bt, xtra...> v = sqrt(a);
-		return v.reciprocate();
+		using LnsType = lns<nbits, rbits, bt, xtra...>;
+		using LogDomain = lns_log_domain<LnsType>;
+		if constexpr (LogDomain::native) {
+			if (!a.isneg() && !a.iszero()) {
+				LnsType r;
+				r.setbits(LogDomain::rsqrtBits(LogDomain::bits(a)));
+				return r;
+			}
+		}
+		return LnsType(1) / sqrt(a);
 	}
 
 	///////////////////////////////////////////////////////////////////
@@ -0,0 +1,599 @@
+#pragma once
+// packed_array.hpp: dense sub-byte storage for arrays of microfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// A microfloat occupies a byte whatever its width, so an array of FP4 elements takes twice the memory
+// of the format, and an array of FP6 elements a third more. packed_array stores the encodings back to
+// back, LSB first, so eight elements always fill nbits whole bytes:
+//
+//   e2m1                 two elements per byte, the even element in the low nibble
+//   e2m3, e3m2           four elements per three bytes
+//   e4m3, e5m2           one element per byte
+//
+//   packed_array<e2m1> w(4096);                 // 2048 bytes
+//   w[7] = e2m1(1.5f);                          // elements through a proxy reference
+//   e2m1 x = w[7];
+//   packed_decode(w.view(), std::span(dst));    // bulk decode to float, or to bfloat16
+//
+// packed_span<ElementType> is the non-owning view of packed elements and packed_span<const ElementType>
+// the read-only one, in the manner of std::span. A view of a block of a tensor is a subspan, without
+// a copy. mxblock and nvblock keep their microfloat elements packed in the same layout and expose
+// them as such views, so a block moves to and from a packed tensor with packed_copy.
+//
+// The bulk kernels work on groups of eight elements. A group is unpacked from its nbits bytes with
+// shifts, and the codes are converted with the integer field arithmetic of the format instead of
+// per-element calls of to_float: the magnitude is shifted into the fraction of a binary32 and the
+// exponent rebiased, subnormals go through an exact int-to-float conversion, and the NaN and infinity
+// encodings, taken from the element type, are selected in. The kernels are multiversioned
+// (hw/dispatch.hpp), so the compiler vectorizes the same loops for AVX2 and AVX-512.
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <universal/hw/dispatch.hpp>
+#include <universal/number/microfloat/microfloat.hpp>
+#include <universal/number/bfloat16/bfloat16.hpp>
+
+namespace sw { namespace universal {
+
+namespace packed_detail {
+
+	// elements per unpack/convert round of the bulk kernels; the codes of a round stay in L1
+	constexpr size_t span_block = 256;
+
+	// the first magnitude the element type decodes as NaN, or as infinity; past the magnitudes if none
+	template<typename ElementType>
+	constexpr uint32_t first_special_magnitude(bool nan) noexcept {
+		constexpr uint32_t magnitudes = 1u << (ElementType::nbits - 1u);
+		for (uint32_t m = 0; m < magnitudes; ++m) {
+			ElementType v{};
+			v.setbits(m);
+			if (nan ? v.isnan() : v.isinf()) return m;
+		}
+		return magnitudes;
+	}
+
+	// true if the NaN magnitudes of the element type are the run [first, last]
+	template<typename ElementType>
+	constexpr bool nan_magnitudes_are(uint32_t first, uint32_t last) noexcept {
+		constexpr uint32_t magnitudes = 1u << (ElementType::nbits - 1u);
+		for (uint32_t m = 0; m < magnitudes; ++m) {
+			ElementType v{};
+			v.setbits(m);
+			if (v.isnan() != (m >= first && m <= last)) return false;
+		}
+		return true;
+	}
+
+	// the last NaN magnitude of the run that starts at first
+	template<typename ElementType>
+	constexpr uint32_t last_nan_magnitude(uint32_t first) noexcept {
+		constexpr uint32_t magnitudes = 1u << (ElementType::nbits - 1u);
+		uint32_t last = first;
+		for (; last + 1u < magnitudes; ++last) {
+			ElementType v{};
+			v.setbits(last + 1u);
+			if (!v.isnan()) break;
+		}
+		return last;
+	}
+
+	// the bit layout of a microfloat, and its conversion to binary32 on the encoding
+	template<typename ElementType>
+	struct format {
+		static constexpr unsigned nbits          = ElementType::nbits;
+		static constexpr unsigned fbits          = ElementType::fbits;
+		static constexpr uint32_t mask           = (1u << nbits) - 1u;
+		static constexpr uint32_t sign_mask      = 1u << (nbits - 1u);
+		static constexpr uint32_t magnitude_mask = sign_mask - 1u;
+
+		// the magnitudes the element type decodes as infinity and as NaN
+		static constexpr uint32_t inf_magnitude = first_special_magnitude<ElementType>(false);
+		static constexpr uint32_t nan_first     = first_special_magnitude<ElementType>(true);
+		static constexpr uint32_t nan_last      = last_nan_magnitude<ElementType>(nan_first);
+		static constexpr bool     has_inf       = inf_magnitude <= magnitude_mask;
+		static constexpr bool     has_nan       = nan_first <= magnitude_mask;
+		static_assert(!has_nan || nan_magnitudes_are<ElementType>(nan_first, nan_last),
+			"packed_array: the NaN encodings of the element type are not one run of magnitudes");
+
+		// normal: the exponent field moves into the binary32 exponent and is rebiased
+		static constexpr uint32_t rebias = static_cast<uint32_t>(127 - ElementType::bias) << 23;
+		// subnormal: the magnitude is an integer multiple of 2^(1 - bias - fbits)
+		static constexpr float subnormal_scale = std::bit_cast<float>(static_cast<uint32_t>(127 + 1 - ElementType::bias - static_cast<int>(fbits)) << 23);
+
+		// the binary32 encoding of to_float() of the code: NaNs are the positive quiet NaN.
+		// The selections are masks, not branches, so the loops over codes vectorize
+		static constexpr uint32_t float_bits(uint32_t code) noexcept {
+			uint32_t m = code & magnitude_mask;
+			uint32_t s = (code & sign_mask) << (32u - nbits);
+			uint32_t normal = (m << (23u - fbits)) + rebias;
+			uint32_t subnormal = std::bit_cast<uint32_t>(static_cast<float>(static_cast<int32_t>(m)) * subnormal_scale);
+			uint32_t select = 0u - static_cast<uint32_t>(m < (1u << fbits));
+			uint32_t b = (subnormal & select) | (normal & ~select);
+			if constexpr (has_inf) {
+				select = 0u - static_cast<uint32_t>(m == inf_magnitude);
+				b = (0x7F80'0000u & select) | (b & ~select);
+			}
+			b |= s;
+			if constexpr (has_nan) {
+				select = 0u - static_cast<uint32_t>(m - nan_first <= nan_last - nan_first);
+				b = (0x7FC0'0000u & select) | (b & ~select);
+			}
+			return b;
+		}
+	};
+
+	// the eight codes of a group, from its nbits bytes. Four elements of an even width fill nbits/2
+	// bytes, so their codes come out of a 32-bit word, which vectorizes better than a 64-bit one
+	template<unsigned nbits>
+	UNIVERSAL_KERNEL_INLINE void unpack_group(const uint8_t* src, uint32_t* codes) noexcept {
+		constexpr uint32_t mask = (1u << nbits) - 1u;
+		if constexpr (nbits % 2 == 0) {
+			for (unsigned h = 0; h < 2; ++h) {
+				uint32_t w = 0;
+				for (unsigned b = 0; b < nbits / 2; ++b) w |= static_cast<uint32_t>(src[h * (nbits / 2) + b]) << (8u * b);
+				for (unsigned k = 0; k < 4; ++k) codes[4 * h + k] = (w >> (k * nbits)) & mask;
+			}
+		}
+		else {
+			uint64_t w = 0;
+			for (unsigned b = 0; b < nbits; ++b) w |= static_cast<uint64_t>(src[b]) << (8u * b);
+			for (unsigned k = 0; k < 8; ++k) codes[k] = static_cast<uint32_t>(w >> (k * nbits)) & mask;
+		}
+	}
+
+	// the codes of ngroups groups
+	template<unsigned nbits>
+	UNIVERSAL_KERNEL_INLINE void unpack_groups(const uint8_t* src, size_t ngroups, uint32_t* codes) noexcept {
+		if constexpr (nbits == 8) {
+			for (size_t i = 0; i < 8 * ngroups; ++i) codes[i] = src[i];
+		}
+		else if constexpr (nbits == 4) {
+			for (size_t i = 0; i < 4 * ngroups; ++i) {
+				codes[2 * i]     = src[i] & 0x0Fu;
+				codes[2 * i + 1] = src[i] >> 4u;
+			}
+		}
+		else {
+			for (size_t g = 0; g < ngroups; ++g) unpack_group<nbits>(src + g * nbits, codes + 8 * g);
+		}
+	}
+
+	// the nbits bytes of a group, from its eight codes
+	template<unsigned nbits>
+	UNIVERSAL_KERNEL_INLINE void pack_group(const uint32_t* codes, uint8_t* dst) noexcept {
+		uint64_t w = 0;
+		for (unsigned k = 0; k < 8; ++k) w |= static_cast<uint64_t>(codes[k] & ((1u << nbits) - 1u)) << (k * nbits);
+		for (unsigned b = 0; b < nbits; ++b) dst[b] = static_cast<uint8_t>(w >> (8u * b));
+	}
+
+	// decode ngroups whole groups: Out is float or the uint16_t encoding of bfloat16
+	template<typename ElementType, typename Out>
+	UNIVERSAL_KERNEL_INLINE void decode_body(const uint8_t* src, size_t ngroups, Out* dst) noexcept {
+		using Format = format<ElementType>;
+		constexpr unsigned nbits = Format::nbits;
+		constexpr size_t groups_per_round = span_block / 8;
+		uint32_t codes[span_block];
+		for (size_t first = 0; first < ngroups; first += groups_per_round) {
+			size_t count = std::min(ngroups - first, groups_per_round);
+			unpack_groups<nbits>(src + first * nbits, count, codes);
+			Out* out = dst + 8 * first;
+			for (size_t i = 0; i < 8 * count; ++i) {
+				uint32_t b = Format::float_bits(codes[i]);
+				if constexpr (std::is_same_v<Out, float>) out[i] = std::bit_cast<float>(b);
+				else out[i] = static_cast<uint16_t>(b >> 16);   // microfloat values are exact in bfloat16
+			}
+		}
+	}
+
+	// pack ngroups whole groups of elements
+	template<typename ElementType>
+	UNIVERSAL_KERNEL_INLINE void pack_body(const ElementType* src, size_t ngroups, uint8_t* dst) noexcept {
+		constexpr unsigned nbits = ElementType::nbits;
+		for (size_t g = 0; g < ngroups; ++g) {
+			uint32_t codes[8];
+			for (unsigned k = 0; k < 8; ++k) codes[k] = src[8 * g + k].bits();
+			pack_group<nbits>(codes, dst + g * nbits);
+		}
+	}
+
+	// unpack ngroups whole groups of elements
+	template<typename ElementType>
+	UNIVERSAL_KERNEL_INLINE void unpack_body(const uint8_t* src, size_t ngroups, ElementType* dst) noexcept {
+		constexpr unsigned nbits = ElementType::nbits;
+		for (size_t g = 0; g < ngroups; ++g) {
+			uint32_t codes[8];
+			unpack_group<nbits>(src + g * nbits, codes);
+			for (unsigned k = 0; k < 8; ++k) dst[8 * g + k].setbits(codes[k]);
+		}
+	}
+
+	template<typename ElementType, typename Out>
+	void decode_scalar(const uint8_t* src, size_t ngroups, Out* dst) noexcept { decode_body<ElementType, Out>(src, ngroups, dst); }
+	template<typename ElementType, typename Out>
+	UNIVERSAL_TARGET_AVX2 void decode_avx2(const uint8_t* src, size_t ngroups, Out* dst) noexcept { decode_body<ElementType, Out>(src, ngroups, dst); }
+	template<typename ElementType, typename Out>
+	UNIVERSAL_TARGET_AVX512 void decode_avx512(const uint8_t* src, size_t ngroups, Out* dst) noexcept { decode_body<ElementType, Out>(src, ngroups, dst); }
+
+	template<typename ElementType>
+	void pack_scalar(const ElementType* src, size_t ngroups, uint8_t* dst) noexcept { pack_body(src, ngroups, dst); }
+	template<typename ElementType>
+	UNIVERSAL_TARGET_AVX2 void pack_avx2(const ElementType* src, size_t ngroups, uint8_t* dst) noexcept { pack_body(src, ngroups, dst); }
+	template<typename ElementType>
+	UNIVERSAL_TARGET_AVX512 void pack_avx512(const ElementType* src, size_t ngroups, uint8_t* dst) noexcept { pack_body(src, ngroups, dst); }
+
+	template<typename ElementType>
+	void unpack_scalar(const uint8_t* src, size_t ngroups, ElementType* dst) noexcept { unpack_body(src, ngroups, dst); }
+	template<typename ElementType>
+	UNIVERSAL_TARGET_AVX2 void unpack_avx2(const uint8_t* src, size_t ngroups, ElementType* dst) noexcept { unpack_body(src, ngroups, dst); }
+	template<typename ElementType>
+	UNIVERSAL_TARGET_AVX512 void unpack_avx512(const uint8_t* src, size_t ngroups, ElementType* dst) noexcept { unpack_body(src, ngroups, dst); }
+
+	template<typename ElementType, typename Out>
+	const kernel_table<void(const uint8_t*, size_t, Out*)>& decode_kernels() noexcept {
+		static const kernel_table<void(const uint8_t*, size_t, Out*)> table = [] {
+			kernel_table<void(const uint8_t*, size_t, Out*)> t(decode_scalar<ElementType, Out>);
+			t.register_kernel(isa::avx2, decode_avx2<ElementType, Out>);
+			t.register_kernel(isa::avx512, decode_avx512<ElementType, Out>);
+			return t;
+		}();
+		return table;
+	}
+	template<typename ElementType>
+	const kernel_table<void(const ElementType*, size_t, uint8_t*)>& pack_kernels() noexcept {
+		static const kernel_table<void(const ElementType*, size_t, uint8_t*)> table = [] {
+			kernel_table<void(const ElementType*, size_t, uint8_t*)> t(pack_scalar<ElementType>);
+			t.register_kernel(isa::avx2, pack_avx2<ElementType>);
+			t.register_kernel(isa::avx512, pack_avx512<ElementType>);
+			return t;
+		}();
+		return table;
+	}
+	template<typename ElementType>
+	const kernel_table<void(const uint8_t*, size_t, ElementType*)>& unpack_kernels() noexcept {
+		static const kernel_table<void(const uint8_t*, size_t, ElementType*)> table = [] {
+			kernel_table<void(const uint8_t*, size_t, ElementType*)> t(unpack_scalar<ElementType>);
+			t.register_kernel(isa::avx2, unpack_avx2<ElementType>);
+			t.register_kernel(isa::avx512, unpack_avx512<ElementType>);
+			return t;
+		}();
+		return table;
+	}
+
+} // namespace packed_detail
+
+// bytes that hold n packed elements of nbits each
+constexpr size_t packed_bytes(size_t n, unsigned nbits) noexcept {
+	return (n * nbits + 7) / 8;
+}
+
+// A proxy for one packed element: it reads and writes the nbits of the element in place
+template<typename ElementType>
+class packed_reference {
+	static constexpr unsigned nbits = ElementType::nbits;
+	static constexpr uint32_t mask  = (1u << nbits) - 1u;
+public:
+	constexpr packed_reference(uint8_t* byte, unsigned shift) noexcept : _byte(byte), _shift(shift) {}
+	constexpr packed_reference(const packed_reference&) = default;
+
+	constexpr packed_reference& operator=(const ElementType& v) noexcept {
+		uint32_t word = load() & ~(mask << _shift);
+		word |= static_cast<uint32_t>(v.bits()) << _shift;
+		_byte[0] = static_cast<uint8_t>(word);
+		if (straddles()) _byte[1] = static_cast<uint8_t>(word >> 8);
+		return *this;
+	}
+	// assignment copies the element, not the reference
+	constexpr packed_reference& operator=(const packed_reference& rhs) noexcept { return *this = static_cast<ElementType>(rhs); }
+
+	constexpr operator ElementType() const noexcept {
+		ElementType v{};
+		v.setbits(bits());
+		return v;
+	}
+	constexpr explicit operator float() const noexcept { return static_cast<ElementType>(*this).to_float(); }
+
+	constexpr unsigned bits() const noexcept { return (load() >> _shift) & mask; }
+
+private:
+	uint8_t* _byte;
+	unsigned _shift;
+
+	constexpr bool straddles() const noexcept { return _shift + nbits > 8; }
+	constexpr uint32_t load() const noexcept {
+		return _byte[0] | (straddles() ? static_cast<uint32_t>(_byte[1]) << 8 : 0u);
+	}
+};
+
+template<typename ElementType>
+inline std::ostream& operator<<(std::ostream& ostr, const packed_reference<ElementType>& r) {
+	return ostr << static_cast<ElementType>(r);
+}
+
+// A random-access iterator over a packed_span, yielding proxies or, for a read-only span, values
+template<typename Span>
+class packed_iterator {
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type        = typename Span::value_type;
+	using difference_type   = std::ptrdiff_t;
+	using reference         = decltype(std::declval<const Span&>()[0]);
+	using pointer           = void;
+
+	packed_iterator() = default;
+	packed_iterator(const Span& span, size_t index) noexcept : _span(span), _index(index) {}
+
+	reference operator*() const noexcept { return _span[_index]; }
+	reference operator[](difference_type n) const noexcept { return _span[_index + n]; }
+
+	packed_iterator& operator++() noexcept { ++_index; return *this; }
+	packed_iterator  operator++(int) noexcept { packed_iterator t = *this; ++_index; return t; }
+	packed_iterator& operator--() noexcept { --_index; return *this; }
+	packed_iterator  operator--(int) noexcept { packed_iterator t = *this; --_index; return t; }
+	packed_iterator& operator+=(difference_type n) noexcept { _index += n; return *this; }
+	packed_iterator& operator-=(difference_type n) noexcept { _index -= n; return *this; }
+	packed_iterator  operator+(difference_type n) const noexcept { return packed_iterator(_span, _index + n); }
+	packed_iterator  operator-(difference_type n) const noexcept { return packed_iterator(_span, _index - n); }
+	difference_type  operator-(const packed_iterator& rhs) const noexcept { return static_cast<difference_type>(_index) - static_cast<difference_type>(rhs._index); }
+
+	bool operator==(const packed_iterator& rhs) const noexcept { return _index == rhs._index; }
+	auto operator<=>(const packed_iterator& rhs) const noexcept { return _index <=> rhs._index; }
+
+private:
+	Span   _span{};
+	size_t _index = 0;
+};
+
+// A non-owning view of packed elements: packed_span<const ElementType> is read-only.
+// The view starts at element 'first' of the group at 'data', so any subspan is a view.
+template<typename ElementType>
+class packed_span {
+public:
+	using element_type = ElementType;
+	using value_type   = std::remove_const_t<ElementType>;
+	using byte_type    = std::conditional_t<std::is_const_v<ElementType>, const uint8_t, uint8_t>;
+	using reference    = std::conditional_t<std::is_const_v<ElementType>, value_type, packed_reference<value_type>>;
+	using iterator     = packed_iterator<packed_span>;
+	static_assert(is_microfloat<value_type>, "packed_span: the element type must be a microfloat");
+
+	static constexpr unsigned nbits = value_type::nbits;
+
+	constexpr packed_span() = default;
+	constexpr packed_span(byte_type* data, size_t size, unsigned first = 0) noexcept
+		: _data(data + (first / 8) * nbits), _size(size), _first(first % 8) {}
+	// a mutable view converts to a read-only one
+	template<typename Other, typename = std::enable_if_t<std::is_const_v<ElementType> && std::is_same_v<Other, value_type>>>
+	constexpr packed_span(const packed_span<Other>& rhs) noexcept : _data(rhs.group_data()), _size(rhs.size()), _first(rhs.group_offset()) {}
+
+	constexpr size_t size() const noexcept { return _size; }
+	constexpr bool   empty() const noexcept { return _size == 0; }
+	// bytes spanned by the view, from the first byte it touches
+	constexpr size_t size_bytes() const noexcept { return packed_bytes(_first + _size, nbits) - (_first * nbits) / 8; }
+
+	constexpr reference operator[](size_t i) const noexcept {
+		size_t a = _first + i;
+		unsigned bit = static_cast<unsigned>(a % 8) * nbits;
+		byte_type* byte = _data + (a / 8) * nbits + bit / 8;
+		if constexpr (std::is_const_v<ElementType>) {
+			uint32_t word = byte[0] | ((bit % 8) + nbits > 8 ? static_cast<uint32_t>(byte[1]) << 8 : 0u);
+			value_type v{};
+			v.setbits((word >> (bit % 8)) & ((1u << nbits) - 1u));
+			return v;
+		}
+		else {
+			return reference(byte, bit % 8);
+		}
+	}
+
+	constexpr packed_span subspan(size_t offset, size_t count) const noexcept {
+		assert(offset + count <= _size);
+		return packed_span(_data, count, static_cast<unsigned>(_first + offset));
+	}
+	constexpr packed_span first(size_t count) const noexcept { return subspan(0, count); }
+
+	iterator begin() const noexcept { return iterator(*this, 0); }
+	iterator end() const noexcept { return iterator(*this, _size); }
+
+	// the group the view starts in, and the index of its first element within the group
+	constexpr byte_type* group_data() const noexcept { return _data; }
+	constexpr unsigned   group_offset() const noexcept { return _first; }
+
+private:
+	byte_type* _data  = nullptr;
+	size_t     _size  = 0;
+	unsigned   _first = 0;
+};
+
+namespace packed_detail {
+
+	// Run a group kernel over a span: the elements before the first group boundary and after the
+	// last one take the per-element path, and the whole groups in between take the kernel
+	template<typename Span, typename Single, typename Groups>
+	inline void for_groups(const Span& s, Single single, Groups groups) {
+		constexpr unsigned nbits = Span::nbits;
+		size_t n = s.size();
+		size_t head = std::min(n, static_cast<size_t>((8 - s.group_offset()) % 8));
+		for (size_t i = 0; i < head; ++i) single(i);
+		size_t ngroups = (n - head) / 8;
+		if (ngroups > 0) groups(s.group_data() + (head > 0 ? nbits : 0), head, ngroups);
+		for (size_t i = head + 8 * ngroups; i < n; ++i) single(i);
+	}
+
+} // namespace packed_detail
+
+/// pack elements into a view: dst[i] = src[i]
+template<typename ElementType>
+inline void packed_pack(std::type_identity_t<std::span<const ElementType>> src, packed_span<ElementType> dst) {
+	assert(dst.size() >= src.size());
+	packed_span<ElementType> d = dst.first(src.size());
+	packed_detail::for_groups(d,
+		[&](size_t i) { d[i] = src[i]; },
+		[&](uint8_t* bytes, size_t i, size_t ngroups) { packed_detail::pack_kernels<ElementType>().resolve()(src.data() + i, ngroups, bytes); });
+}
+
+/// unpack elements from a view: dst[i] = src[i]
+template<typename ElementType>
+inline void packed_unpack(std::type_identity_t<packed_span<const ElementType>> src, std::span<ElementType> dst) {
+	assert(dst.size() >= src.size());
+	packed_detail::for_groups(src,
+		[&](size_t i) { dst[i] = src[i]; },
+		[&](const uint8_t* bytes, size_t i, size_t ngroups) { packed_detail::unpack_kernels<ElementType>().resolve()(bytes, ngroups, dst.data() + i); });
+}
+
+/// copy packed elements between views: dst[i] = src[i]. Views that start at the same offset
+/// within their groups copy their whole bytes at once
+template<typename ElementType>
+inline void packed_copy(std::type_identity_t<packed_span<const ElementType>> src, packed_span<ElementType> dst) {
+	constexpr unsigned nbits = ElementType::nbits;
+	assert(dst.size() >= src.size());
+	packed_span<ElementType> d = dst.first(src.size());
+	if (src.group_offset() != d.group_offset()) {
+		for (size_t i = 0; i < src.size(); ++i) d[i] = src[i];
+		return;
+	}
+	packed_detail::for_groups(src,
+		[&](size_t i) { d[i] = src[i]; },
+		[&](const uint8_t* bytes, size_t, size_t ngroups) { std::memcpy(d.group_data() + (bytes - src.group_data()), bytes, ngroups * nbits); });
+}
+
+/// decode a view to float: dst[i] = float(src[i]), bit for bit as to_float()
+template<typename ElementType>
+inline void packed_decode(packed_span<const ElementType> src, std::span<float> dst) {
+	using Format = packed_detail::format<ElementType>;
+	assert(dst.size() >= src.size());
+	packed_detail::for_groups(src,
+		[&](size_t i) { dst[i] = std::bit_cast<float>(Format::float_bits(src[i].bits())); },
+		[&](const uint8_t* bytes, size_t i, size_t ngroups) { packed_detail::decode_kernels<ElementType, float>().resolve()(bytes, ngroups, dst.data() + i); });
+}
+
+/// decode a view to bfloat16, which represents every microfloat value exactly
+template<typename ElementType>
+inline void packed_decode(packed_span<const ElementType> src, std::span<bfloat16> dst) {
+	using Format = packed_detail::format<ElementType>;
+	static_assert(ElementType::fbits <= 7 && ElementType::bias <= 127, "packed_decode: the element type is not exact in bfloat16");
+	assert(dst.size() >= src.size());
+	uint16_t bits[packed_detail::span_block];
+	for (size_t first = 0; first < src.size(); first += packed_detail::span_block) {
+		packed_span<const ElementType> s = src.subspan(first, std::min(src.size() - first, packed_detail::span_block));
+		packed_detail::for_groups(s,
+			[&](size_t i) { bits[i] = static_cast<uint16_t>(Format::float_bits(s[i].bits()) >> 16); },
+			[&](const uint8_t* bytes, size_t i, size_t ngroups) { packed_detail::decode_kernels<ElementType, uint16_t>().resolve()(bytes, ngroups, bits + i); });
+		for (size_t i = 0; i < s.size(); ++i) dst[first + i].setbits(bits[i]);
+	}
+}
+
+// decode through a mutable view
+template<typename ElementType, typename Out>
+inline void packed_decode(packed_span<ElementType> src, std::span<Out> dst) requires (!std::is_const_v<ElementType>) {
+	packed_decode(packed_span<const ElementType>(src), dst);
+}
+
+/// round floats to the element type into a view: dst[i] = ElementType(src[i])
+template<typename ElementType>
+inline void packed_encode(std::span<const float> src, packed_span<ElementType> dst) {
+	assert(dst.size() >= src.size());
+	ElementType elements[packed_detail::span_block];
+	for (size_t first = 0; first < src.size(); first += packed_detail::span_block) {
+		size_t count = std::min(src.size() - first, packed_detail::span_block);
+		for (size_t i = 0; i < count; ++i) elements[i] = ElementType(src[first + i]);
+		packed_pack(std::span<const ElementType>(elements, count), dst.subspan(first, count));
+	}
+}
+
+// An array of microfloats stored at their real size: (n * nbits + 7) / 8 bytes
+template<typename ElementType>
+class packed_array {
+public:
+	static_assert(is_microfloat<ElementType>, "packed_array: the element type must be a microfloat");
+
+	using value_type      = ElementType;
+	using reference       = packed_reference<ElementType>;
+	using const_reference = ElementType;
+	using span_type       = packed_span<ElementType>;
+	using const_span_type = packed_span<const ElementType>;
+	using iterator        = typename span_type::iterator;
+	using const_iterator  = typename const_span_type::iterator;
+
+	static constexpr unsigned nbits = ElementType::nbits;
+
+	packed_array() = default;
+	explicit packed_array(size_t n) : _bytes(packed_bytes(n, nbits)), _size(n) {}
+	packed_array(size_t n, const ElementType& value) : packed_array(n) { fill(value); }
+	explicit packed_array(std::span<const ElementType> elements) : packed_array(elements.size()) { packed_pack(elements, view()); }
+	explicit packed_array(std::span<const float> values) : packed_array(values.size()) { packed_encode(values, view()); }
+
+	size_t size() const noexcept { return _size; }
+	bool   empty() const noexcept { return _size == 0; }
+	// bytes of storage: the footprint of the format
+	size_t size_bytes() const noexcept { return _bytes.size(); }
+	uint8_t*       data() noexcept { return _bytes.data(); }
+	const uint8_t* data() const noexcept { return _bytes.data(); }
+
+	reference       operator[](size_t i) noexcept { return view()[i]; }
+	const_reference operator[](size_t i) const noexcept { return view()[i]; }
+	reference at(size_t i) {
+		if (i >= _size) throw std::out_of_range("packed_array: index out of range");
+		return (*this)[i];
+	}
+	const_reference at(size_t i) const {
+		if (i >= _size) throw std::out_of_range("packed_array: index out of range");
+		return (*this)[i];
+	}
+
+	span_type       view() noexcept { return span_type(_bytes.data(), _size); }
+	const_span_type view() const noexcept { return const_span_type(_bytes.data(), _size); }
+	span_type       view(size_t offset, size_t count) noexcept { return view().subspan(offset, count); }
+	const_span_type view(size_t offset, size_t count) const noexcept { return view().subspan(offset, count); }
+
+	iterator       begin() noexcept { return view().begin(); }
+	iterator       end() noexcept { return view().end(); }
+	const_iterator begin() const noexcept { return view().begin(); }
+	const_iterator end() const noexcept { return view().end(); }
+
+	// new elements are zero
+	void resize(size_t n) {
+		_bytes.resize(packed_bytes(n, nbits), 0);
+		_size = n;
+		clear_tail();
+	}
+	void fill(const ElementType& value) {
+		ElementType group[8];
+		for (auto& e : group) e = value;
+		uint8_t bytes[nbits];
+		packed_pack(std::span<const ElementType>(group), span_type(bytes, 8));
+		for (size_t b = 0; b < _bytes.size(); ++b) _bytes[b] = bytes[b % nbits];
+		clear_tail();
+	}
+
+	// bulk conversions of the whole array
+	void decode(std::span<float> dst) const { packed_decode(view(), dst); }
+	void decode(std::span<bfloat16> dst) const { packed_decode(view(), dst); }
+
+	bool operator==(const packed_array& rhs) const noexcept { return _size == rhs._size && _bytes == rhs._bytes; }
+
+private:
+	std::vector<uint8_t> _bytes;
+	size_t               _size = 0;
+
+	// the bits of the last byte past the last element are zero, so equal arrays have equal bytes
+	void clear_tail() noexcept {
+		unsigned used = static_cast<unsigned>((_size * nbits) % 8);
+		if (used != 0) _bytes.back() &= static_cast<uint8_t>((1u << used) - 1u);
+	}
+};
+
+}} // namespace sw::universal
@@ -9,6 +9,8 @@
 // An mxblock pairs one shared e8m0 scale factor with BlockSize micro-float elements,
 // implementing the OCP Microscaling (MX) v1.0 block floating-point format.
 // Each MX block provides 4-8x compression vs FP32 with controlled quantization error.
+// Micro-float elements are stored packed at their width, in the layout of packed_array,
+// and are read and written through packed_span views of that storage.
 
 #include <string>
 #include <sstream>
@@ -19,11 +21,13 @@
 #include <cstring>
 #include <limits>
 #include <algorithm>
+#include <span>
 #include <type_traits>
 
 #include <universal/utility/bit_cast.hpp>
 #include <universal/number/e8m0/e8m0.hpp>
 #include <universal/number/microfloat/microfloat.hpp>
+#include <universal/number/microfloat/packed_array.hpp>
 #include <universal/number/mxfloat/mxfloat_fwd.hpp>
 #include <universal/number/mxfloat/exceptions.hpp>
 
@@ -130,6 +134,14 @@ public:
 		}
 
 		float s = _scale.to_float();
+		if constexpr (is_microfloat<ElementType>) {
+			if (!std::is_constant_evaluated()) {
+				// bulk decode of the packed elements, then scale
+				packed_decode(elements().first(n), std::span<float>(dst, n));
+				for (size_t i = 0; i < n; ++i) dst[i] *= s;
+				return;
+			}
+		}
 		for (size_t i = 0; i < n; ++i) {
 			dst[i] = s * get_element_float(i);
 		}
@@ -159,20 +171,41 @@ public:
 	constexpr const e8m0& scale() const noexcept { return _scale; }
 	constexpr e8m0& scale() noexcept { return _scale; }
 
-	constexpr const ElementType& element(size_t i) const noexcept { return _elements[i]; }
-	constexpr ElementType& element(size_t i) noexcept { return _elements[i]; }
+	// micro-float elements are packed: the const accessor returns the element by value,
+	// the mutable one a packed_reference proxy that writes it in place
+	constexpr decltype(auto) element(size_t i) const noexcept {
+		if constexpr (std::is_integral_v<ElementType>) return _elements[i]; else return elements()[i];
+	}
+	constexpr decltype(auto) element(size_t i) noexcept {
+		if constexpr (std::is_integral_v<ElementType>) return _elements[i]; else return elements()[i];
+	}
+
+	// views of the packed micro-float elements, without a copy
+	constexpr packed_span<ElementType> elements() noexcept requires is_microfloat<ElementType> {
+		return packed_span<ElementType>(_elements, BlockSize);
+	}
+	constexpr packed_span<const ElementType> elements() const noexcept requires is_microfloat<ElementType> {
+		return packed_span<const ElementType>(_elements, BlockSize);
+	}
 
 	static constexpr size_t size() noexcept { return BlockSize; }
 
-	// compute byte size: 1 byte for scale + BlockSize * element bytes
+	// compute byte size: 1 byte for scale + the element storage
 	static constexpr size_t byte_size() noexcept {
-		if constexpr (std::is_integral_v<ElementType>) {
-			return 1 + BlockSize; // int8_t = 1 byte each
-		} else {
-			// microfloat element: nbits bits each
-			// For simplicity, each element occupies 1 byte of storage
-			return 1 + BlockSize;
-		}
+		return 1 + storageBytes;
+	}
+
+	// byte size of the block in the format: 1 byte for scale + BlockSize packed elements
+	static constexpr size_t packed_byte_size() noexcept {
+		return 1 + storageBytes;
+	}
+
+	// copy the elements to and from a packed tensor, e.g. the view of this block in a packed_array
+	void pack(packed_span<ElementType> dst) const requires is_microfloat<ElementType> {
+		packed_copy<ElementType>(elements(), dst);
+	}
+	void unpack(packed_span<const ElementType> src) requires is_microfloat<ElementType> {
+		packed_copy<ElementType>(src.first(BlockSize), elements());
 	}
 
 	// modifiers
@@ -235,7 +268,7 @@ private:
 		if constexpr (std::is_integral_v<ElementType>) {
 			_elements[i] = 0;
 		} else {
-			_elements[i].clear();
+			elements()[i] = ElementType{};
 		}
 	}
 
@@ -244,7 +277,7 @@ private:
 		if constexpr (std::is_integral_v<ElementType>) {
 			return static_cast<float>(_elements[i]);
 		} else {
-			return _elements[i].to_float();
+			return elements()[i].to_float();
 		}
 	}
 
@@ -266,12 +299,24 @@ private:
 			if (rounded < -128.0f) rounded = -128.0f;
 			_elements[i] = static_cast<int8_t>(rounded);
 		} else {
-			_elements[i].from_float(v);
+			ElementType e{};
+			e.from_float(v);
+			elements()[i] = e;
 		}
 	}
 
-	e8m0        _scale;
-	ElementType _elements[BlockSize];
+	// int8_t elements are stored as they are, micro-float elements packed at their width
+	static constexpr size_t storageBytes = [] {
+		if constexpr (std::is_integral_v<ElementType>) {
+			return BlockSize;
+		} else {
+			return packed_bytes(BlockSize, ElementType::nbits);
+		}
+	}();
+	using storage_type = std::conditional_t<std::is_integral_v<ElementType>, ElementType, uint8_t>;
+
+	e8m0         _scale;
+	storage_type _elements[storageBytes];
 };
 
 ////////////////////////    functions   /////////////////////////////////
@@ -13,6 +13,8 @@
 //
 // Dequantize: dst[i] = tensor_scale * block_scale * element[i]
 // Quantize:   raw_scale = amax / elem_max, block_scale = round_to_e4m3(raw_scale)
+//
+// The elements are stored packed, two e2m1 per byte for NVFP4, and accessed through packed_span views.
 
 #include <string>
 #include <sstream>
@@ -22,8 +24,10 @@
 #include <cstring>
 #include <limits>
 #include <algorithm>
+#include <span>
 
 #include <universal/number/microfloat/microfloat.hpp>
+#include <universal/number/microfloat/packed_array.hpp>
 #include <universal/number/nvblock/nvblock_fwd.hpp>
 #include <universal/number/nvblock/exceptions.hpp>
 
@@ -120,6 +124,12 @@ public:
 		}
 
 		float s = tensor_scale * _block_scale.to_float();
+		if (!std::is_constant_evaluated()) {
+			// bulk decode of the packed elements, then scale
+			packed_decode(elements().first(n), std::span<float>(dst, n));
+			for (size_t i = 0; i < n; ++i) dst[i] *= s;
+			return;
+		}
 		for (size_t i = 0; i < n; ++i) {
 			dst[i] = s * get_element_float(i);
 		}
@@ -149,11 +159,29 @@ public:
 	constexpr const ScaleType& block_scale() const noexcept { return _block_scale; }
 	constexpr ScaleType& block_scale() noexcept { return _block_scale; }
 
-	constexpr const ElementType& element(size_t i) const noexcept { return _elements[i]; }
-	constexpr ElementType& element(size_t i) noexcept { return _elements[i]; }
+	// the elements are packed: by value, or through a proxy that writes the element in place
+	constexpr ElementType element(size_t i) const noexcept { return elements()[i]; }
+	constexpr packed_reference<ElementType> element(size_t i) noexcept { return elements()[i]; }
+
+	// views of the packed elements, without a copy
+	constexpr packed_span<ElementType> elements() noexcept { return packed_span<ElementType>(_elements, BlockSize); }
+	constexpr packed_span<const ElementType> elements() const noexcept { return packed_span<const ElementType>(_elements, BlockSize); }
 
 	static constexpr size_t size() noexcept { return BlockSize; }
 
+	// byte size of the block in the format: the block scale + BlockSize packed elements
+	static constexpr size_t packed_byte_size() noexcept {
+		return packed_bytes(1, ScaleType::nbits) + packed_bytes(BlockSize, ElementType::nbits);
+	}
+
+	// copy the elements to and from a packed tensor, e.g. the view of this block in a packed_array
+	void pack(packed_span<ElementType> dst) const {
+		packed_copy<ElementType>(elements(), dst);
+	}
+	void unpack(packed_span<const ElementType> src) {
+		packed_copy<ElementType>(src.first(BlockSize), elements());
+	}
+
 	// modifiers
 	constexpr void clear() noexcept {
 		_block_scale.clear();
@@ -176,21 +204,23 @@ private:
 
 	// helper: set element i to zero
 	constexpr void set_element_zero(size_t i) noexcept {
-		_elements[i].clear();
+		elements()[i] = ElementType{};
 	}
 
 	// helper: convert element i to float
 	constexpr float get_element_float(size_t i) const noexcept {
-		return _elements[i].to_float();
+		return elements()[i].to_float();
 	}
 
 	// helper: set element from float (in quantized space, no further scaling)
 	constexpr void set_element_from_float(size_t i, float v) noexcept {
-		_elements[i].from_float(v);
+		ElementType e{};
+		e.from_float(v);
+		elements()[i] = e;
 	}
 
-	ScaleType   _block_scale;
-	ElementType _elements[BlockSize];
+	ScaleType _block_scale;
+	uint8_t   _elements[packed_bytes(BlockSize, ElementType::nbits)];
 };
 
 ////////////////////////    functions   /////////////////////////////////
@@ -178,6 +178,9 @@ posit<nbits, es, bt> fma(const posit<nbits, es, bt>& a, const posit<nbits, es, b
 		result.setnar();
 		return result;
 	}
+	if constexpr (posit_fast_arithmetic<posit<nbits, es, bt>>::fusedMultiplyAdd) {
+		if (posit_fast_arithmetic<posit<nbits, es, bt>>::fma(result, a, b, c)) return result;
+	}
 
 	// Step 1: Multiply a * b
 	if (a.iszero() || b.iszero()) {
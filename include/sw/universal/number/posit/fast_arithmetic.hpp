@@ -0,0 +1,283 @@
+#pragma once
+// fast_arithmetic.hpp: machine-word add, multiply, divide, and fma for posit configurations of at most 64 bits
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The generic posit operators expand both operands into blocktriples, run the block arithmetic, and
+// round the result back through convert(). When the encoding fits in a 64-bit word, the operations
+// can run on the encodings directly and produce the same posit, bit for bit:
+//
+//   decode : the two's complement of a negative encoding is taken, the regime run length is one
+//            count-leading-zeros of the body, xor'ed with its leading bit, and the exponent and
+//            fraction fall out of a single shift: no loops over the regime bits
+//   compute: the exact sum, product, or quotient of the (sign, scale, significand) triples in a
+//            64-bit datapath with guard and sticky bits, shared with cfloat in support/word_triple.hpp,
+//            and a 128-bit datapath for fma
+//   encode : regime, exponent, and fraction are assembled in one word, which is rounded to nearest
+//            even in a single step, with the inward projection onto minpos and maxpos of convert()
+//
+// Addition takes this path up to 59 fraction bits (posit<64,2> and posit<64,3>), multiplication for
+// all configurations of at most 64 bits, division up to 30 fraction bits (posit<32,2>), and fma on
+// compilers with a 128-bit integer type. Zero and NaR operands take the generic operators, so their
+// semantics, including the arithmetic exceptions, are unchanged.
+//
+// The *Bits kernels work on raw encodings and are shared with the span kernels of posit_span.hpp;
+// decode and round are shared with the field remap of convert_span.hpp.
+// Set POSIT_FAST_ARITHMETIC to 0 to route all arithmetic through blocktriple.
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <universal/number/support/word_triple.hpp>
+
+#if !defined(POSIT_FAST_ARITHMETIC)
+#define POSIT_FAST_ARITHMETIC 1
+#endif
+
+namespace sw { namespace universal {
+
+/// <summary>
+/// posit_fast_arithmetic runs posit arithmetic on the encodings in a 64-bit word. An operation
+/// returns false, leaving the operator to blocktriple, for zero and NaR operands and for the
+/// configurations its flag below excludes.
+/// </summary>
+/// <typeparam name="Posit">the posit configuration</typeparam>
+template<typename Posit>
+struct posit_fast_arithmetic {
+	static constexpr unsigned nbits = Posit::nbits;
+	static constexpr unsigned es    = Posit::es;
+	static constexpr unsigned fbits = Posit::fbits;
+
+	static constexpr bool integer        = POSIT_FAST_ARITHMETIC && nbits >= es + 3u && nbits <= 64;
+	static constexpr bool addition       = integer && fbits <= 59;
+	static constexpr bool multiplication = integer;
+	static constexpr bool division       = integer && fbits <= 30;
+#if defined(__SIZEOF_INT128__)
+	static constexpr bool fusedMultiplyAdd = integer && fbits <= 59;
+#else
+	static constexpr bool fusedMultiplyAdd = false;
+#endif
+
+	static constexpr uint64_t SIGN_BIT = 1ull << (nbits - 1u);
+	static constexpr uint64_t MASK     = (nbits == 64 ? ~0ull : (1ull << (nbits % 64u)) - 1ull);
+
+	using triple = support::word_triple;
+	using triple_arithmetic = support::word_triple_arithmetic<fbits>;
+
+	static bool add(Posit& lhs, const Posit& rhs) noexcept {
+		uint64_t r;
+		if (!addBits(bits(lhs), bits(rhs), r)) return false;
+		lhs.setbits(r);
+		return true;
+	}
+	static bool mul(Posit& lhs, const Posit& rhs) noexcept {
+		uint64_t r;
+		if (!mulBits(bits(lhs), bits(rhs), r)) return false;
+		lhs.setbits(r);
+		return true;
+	}
+	static bool div(Posit& lhs, const Posit& rhs) noexcept {
+		uint64_t r;
+		if (!divBits(bits(lhs), bits(rhs), r)) return false;
+		lhs.setbits(r);
+		return true;
+	}
+	static bool fma(Posit& result, const Posit& a, const Posit& b, const Posit& c) noexcept {
+		uint64_t r;
+		if (!fmaBits(bits(a), bits(b), bits(c), r)) return false;
+		result.setbits(r);
+		return true;
+	}
+
+	// the raw posit bits, two's complement for negative values, zero-extended to 64 bits
+	static uint64_t bits(const Posit& v) noexcept {
+		return v.bits().template to_native_bits<uint64_t>() & MASK;
+	}
+
+	// the encoding of -v
+	static constexpr uint64_t negate(uint64_t raw) noexcept {
+		return (0ull - raw) & MASK;
+	}
+
+	// a + b for encodings other than zero and NaR
+	static bool addBits(uint64_t a, uint64_t b, uint64_t& r) noexcept {
+		if constexpr (addition) {
+			triple x, y;
+			if (!decode(a, x) || !decode(b, y)) return false;
+			triple sum = triple_arithmetic::add(x, y);
+			r = (sum.significand == 0) ? 0ull : round(sum);  // exact cancellation yields zero
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	// a * b for encodings other than zero and NaR
+	static bool mulBits(uint64_t a, uint64_t b, uint64_t& r) noexcept {
+		if constexpr (multiplication) {
+			triple x, y;
+			if (!decode(a, x) || !decode(b, y)) return false;
+			r = round(triple_arithmetic::mul(x, y));
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	// a / b for encodings other than zero and NaR
+	static bool divBits(uint64_t a, uint64_t b, uint64_t& r) noexcept {
+		if constexpr (division) {
+			triple x, y;
+			if (!decode(a, x) || !decode(b, y)) return false;
+			r = round(triple_arithmetic::div(x, y));
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	// a * b + c with a single rounding, for encodings other than zero and NaR
+	static bool fmaBits(uint64_t a, uint64_t b, uint64_t c, uint64_t& r) noexcept {
+#if defined(__SIZEOF_INT128__)
+		if constexpr (fusedMultiplyAdd) {
+			using u128 = __uint128_t;
+			triple x, y, z;
+			if (!decode(a, x) || !decode(b, y) || !decode(c, z)) return false;
+			bool sa = x.sign, sb = y.sign, sc = z.sign;
+			int ea = x.scale, eb = y.scale, ec = z.scale;
+			uint64_t ma = x.significand, mb = y.significand, mc = z.significand;
+			// align the exact product and the addend with their leading ones at bit 124:
+			// four guard bits below the 120-bit product, and two bits of headroom for the carry
+			constexpr int top = 124;
+			u128 product = static_cast<u128>(ma) * mb;
+			int productWidth = bitWidth(product);
+			int sp = ea + eb - 2 * static_cast<int>(fbits) + productWidth - 1;
+			u128 mp = product << (top - productWidth + 1);
+			bool signp = (sa != sb);
+			u128 maddend = static_cast<u128>(mc) << (top - static_cast<int>(fbits));
+			if (ec > sp || (ec == sp && maddend > mp)) {
+				std::swap(signp, sc);
+				std::swap(sp, ec);
+				std::swap(mp, maddend);
+			}
+			unsigned alignment = static_cast<unsigned>(sp - ec);
+			if (alignment > static_cast<unsigned>(top)) {
+				maddend = 1;  // only the sticky bit remains
+			}
+			else if (alignment > 0) {
+				u128 sticky = (maddend & ((static_cast<u128>(1) << alignment) - 1u)) != 0 ? 1u : 0u;
+				maddend = (maddend >> alignment) | sticky;
+			}
+			u128 sum = (signp == sc) ? mp + maddend : mp - maddend;
+			if (sum == 0) {
+				r = 0;  // exact cancellation
+				return true;
+			}
+			int width = bitWidth(sum);
+			uint64_t significand;
+			if (width > 64) {
+				unsigned shift = static_cast<unsigned>(width - 64);
+				uint64_t sticky = (sum & ((static_cast<u128>(1) << shift) - 1u)) != 0 ? 1ull : 0ull;
+				significand = static_cast<uint64_t>(sum >> shift) | sticky;
+			}
+			else {
+				significand = static_cast<uint64_t>(sum);
+			}
+			r = round(triple{ signp, sp + width - 1 - top, significand });
+			return true;
+		}
+		else {
+			return false;
+		}
+#else
+		(void)a; (void)b; (void)c; (void)r;
+		return false;
+#endif
+	}
+
+	// decode an encoding other than zero and NaR into value = significand * 2^(scale - fbits),
+	// with the hidden bit of the significand at fbits
+	static bool decode(uint64_t raw, triple& t) noexcept {
+		if ((raw & (SIGN_BIT - 1ull)) == 0) return false;  // zero and NaR
+		t.sign = (raw & SIGN_BIT) != 0;
+		if (t.sign) raw = negate(raw);
+		// regime, exponent, and fraction, left-aligned
+		uint64_t body = raw << (65u - nbits);
+		// a run of ones reads as a run of zeros after flipping the body
+		uint64_t runBits = body ^ (0ull - (body >> 63));
+		int run = std::countl_zero(runBits);
+		int k = (body >> 63) ? run - 1 : -run;
+		uint64_t rest = (body << run) << 1;  // drop the regime and its terminating bit
+		int exponent{ 0 };
+		if constexpr (es > 0) exponent = static_cast<int>(rest >> (64u - es));
+		t.scale = k * (1 << es) + exponent;
+		if constexpr (fbits > 0) {
+			t.significand = ((rest << es) >> (64u - fbits)) | (1ull << fbits);
+		}
+		else {
+			t.significand = 1ull;
+		}
+		return true;
+	}
+
+	// round the value with its leading one at 2^scale, and all its bits in significand, to the
+	// nearest posit encoding. Bits below the significand are folded into its least significant bit.
+	// This mirrors convert(blocktriple, posit) so that both paths produce the same encoding.
+	static uint64_t round(const triple& t) noexcept {
+		const bool sign = t.sign;
+		const int scale = t.scale;
+		const uint64_t significand = t.significand;
+		constexpr int maxScale = static_cast<int>(nbits - 2u) * (1 << es);
+		// inward projection onto maxpos and minpos
+		if (scale > maxScale) return sign ? negate(SIGN_BIT - 1ull) : SIGN_BIT - 1ull;
+		if (scale < -maxScale) return sign ? negate(1ull) : 1ull;
+		int k = scale >> es;  // floor(scale / 2^es)
+		// regime: k+1 ones and a terminating zero, or -k zeros and a terminating one
+		unsigned regimeLength = static_cast<unsigned>(k >= 0 ? k + 2 : 1 - k);
+		uint64_t regime = (k >= 0) ? (~0ull << (63 - k)) : (1ull << (63 + k));
+		// exponent and fraction, left-aligned, without the hidden bit
+		unsigned msb = static_cast<unsigned>(std::bit_width(significand)) - 1u;
+		uint64_t fraction = (significand << (63u - msb)) << 1;
+		uint64_t tail;
+		bool sticky;
+		if constexpr (es > 0) {
+			uint64_t exponent = static_cast<uint64_t>(scale) & ((1ull << es) - 1ull);
+			tail = (exponent << (64u - es)) | (fraction >> es);
+			sticky = (fraction & ((1ull << es) - 1ull)) != 0;
+		}
+		else {
+			tail = fraction;
+			sticky = false;
+		}
+		uint64_t body;
+		if (regimeLength < 64) {
+			body = regime | (tail >> regimeLength);
+			sticky |= (tail << (64u - regimeLength)) != 0;
+		}
+		else {
+			body = regime;
+			sticky |= tail != 0;
+		}
+		// keep nbits-1 bits, and round to nearest even on the bit after them
+		uint64_t kept = body >> (65u - nbits);
+		uint64_t guard = (body >> (64u - nbits)) & 1ull;
+		if constexpr (nbits < 64) sticky |= (body & ((1ull << (64u - nbits)) - 1ull)) != 0;
+		kept += guard & ((kept & 1ull) | (sticky ? 1ull : 0ull));
+		return sign ? negate(kept) : kept;
+	}
+
+private:
+#if defined(__SIZEOF_INT128__)
+	static int bitWidth(__uint128_t v) noexcept {
+		uint64_t hi = static_cast<uint64_t>(v >> 64);
+		return hi != 0 ? 64 + static_cast<int>(std::bit_width(hi)) : static_cast<int>(std::bit_width(static_cast<uint64_t>(v)));
+	}
+#endif
+};
+
+}} // namespace sw::universal
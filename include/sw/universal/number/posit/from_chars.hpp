@@ -0,0 +1,64 @@
+#pragma once
+// from_chars.hpp: correctly rounded decimal to posit conversion
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// from_chars(first, last, p) reads a decimal with the syntax of std::from_chars and rounds it
+// once, to the posit nearest on the bit string, without going through double; from_chars(first,
+// last, values) reads a column of them. inf, nan and nar read as NaR. Values beyond maxpos and
+// below minpos saturate as they do in arithmetic, so the result is never result_out_of_range.
+//
+// Usage:
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/number/posit/from_chars.hpp>
+//
+//   posit<32,2> p;
+//   std::string_view txt = "0.1";
+//   auto [ptr, ec] = from_chars(txt.data(), txt.data() + txt.size(), p);
+#include <charconv>
+#include <universal/number/support/eisel_lemire.hpp>
+
+namespace sw { namespace universal {
+
+template<unsigned nbits, unsigned es, typename bt>
+std::from_chars_result from_chars(const char* first, const char* last, posit<nbits, es, bt>& v) {
+	eisel_lemire::decimal_number d;
+	std::from_chars_result result = eisel_lemire::scan(first, last, d);
+	if (result.ec != std::errc{}) return result;
+	if (d.type != eisel_lemire::kind::finite) {
+		v.setnar();
+		return result;
+	}
+	constexpr unsigned P = eisel_lemire::precision_for(nbits);
+	eisel_lemire::rounded_to_odd<P> r;
+	if (!eisel_lemire::to_binary(d, r)) {
+		v.setzero();
+		return result;
+	}
+	if constexpr (nbits <= 64) {
+		// 63 fraction bits below the hidden bit, with the rest folded into the last one, through
+		// the uint64_t encoder the IEEE-754 conversions use
+		std::uint64_t fraction = r.sig[0] & ~(1ull << 63);
+		for (unsigned i = 1; i < r.words; ++i) fraction |= (r.sig[i] != 0 ? 1u : 0u);
+		bool saturated = false;
+		std::uint64_t encoded = posit<nbits, es, bt>::encode_positive_with_scale_and_fraction(r.scale, fraction, 63, saturated);
+		if (d.negative) {
+			if constexpr (nbits == 64) encoded = ~encoded + 1ull;
+			else encoded = (~encoded + 1ull) & ((1ull << nbits) - 1ull);
+		}
+		v.setbits(encoded);
+	}
+	else {
+		// the fraction bits below the hidden bit, with the rest folded into the last one
+		constexpr unsigned fbits = nbits + 4;
+		blocksignificand<fbits, bt> fraction;
+		eisel_lemire::to_fraction(r, fraction);
+		convert_<nbits, es, bt, fbits>(d.negative, r.scale, fraction, v);
+	}
+	return result;
+}
+
+}} // namespace sw::universal
@@ -6,6 +6,8 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstddef>  // for unsigned
+#include <charconv>
+#include <string>
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/blocktriple/blocktriple.hpp>
 
@@ -21,6 +23,8 @@ template<unsigned nbits, unsigned es, typename bt> posit<nbits, es, bt> sqrt(con
 // parsing
 template<unsigned nbits, unsigned es, typename bt>
 bool parse(const std::string& number, posit<nbits, es, bt>& v);
+template<unsigned nbits, unsigned es, typename bt>
+std::from_chars_result from_chars(const char* first, const char* last, posit<nbits, es, bt>& v);
 
 // helpers
 template<unsigned nbits, unsigned es, typename bt, unsigned fbits, BlockTripleOperator op> constexpr posit<nbits, es, bt>& convert(const blocktriple<fbits, op, bt>&, posit<nbits, es, bt>&);
@@ -44,6 +44,8 @@
 #include <universal/number/posit/posit_fraction.hpp>
 #include <universal/number/posit/posit_exponent.hpp>
 #include <universal/number/posit/posit_regime.hpp>
+// machine-word fast paths for configurations of at most 64 bits
+#include <universal/number/posit/fast_arithmetic.hpp>
 
 namespace sw { namespace universal {
 
@@ -672,6 +674,9 @@ public:
 	// we model a hw pipeline with register assignments, functional block, and conversion
 	constexpr posit& operator+=(const posit& rhs) {
 		if constexpr (_trace_add) std::cout << "---------------------- ADD -------------------" << std::endl;
+		if constexpr (posit_fast_arithmetic<posit>::addition && !_trace_add) {
+			if (!std::is_constant_evaluated() && posit_fast_arithmetic<posit>::add(*this, rhs)) return *this;
+		}
 		// special case handling of the inputs
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || rhs.isnar()) {
@@ -722,6 +727,9 @@ public:
 	constexpr posit& operator*=(const posit& rhs) {
 		static_assert(fhbits > 0, "posit configuration does not support multiplication");
 		if constexpr (_trace_mul) std::cout << "---------------------- MUL -------------------" << std::endl;
+		if constexpr (posit_fast_arithmetic<posit>::multiplication && !_trace_mul) {
+			if (!std::is_constant_evaluated() && posit_fast_arithmetic<posit>::mul(*this, rhs)) return *this;
+		}
 		// special case handling of the inputs
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || rhs.isnar()) {
@@ -763,6 +771,9 @@ public:
 	}
 	constexpr posit& operator/=(const posit& rhs) {
 		if constexpr (_trace_div) std::cout << "---------------------- DIV -------------------" << std::endl;
+		if constexpr (posit_fast_arithmetic<posit>::division && !_trace_div) {
+			if (!std::is_constant_evaluated() && posit_fast_arithmetic<posit>::div(*this, rhs)) return *this;
+		}
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (rhs.iszero()) {
 			throw posit_divide_by_zero{};    // not throwing is a quiet signalling NaR
@@ -1502,6 +1513,8 @@ private:
 	friend std::ostream& operator<< (std::ostream& ostr, const posit<nnbits, ees, bbt>& p);
 	template<unsigned nnbits, unsigned ees, typename bbt>
 	friend std::istream& operator>> (std::istream& istr, posit<nnbits, ees, bbt>& p);
+	template<unsigned nnbits, unsigned ees, typename bbt>
+	friend std::from_chars_result from_chars(const char* first, const char* last, posit<nnbits, ees, bbt>& v);
 
 	// posit - posit logic functions (constexpr to match implementations)
 	template<unsigned nnbits, unsigned ees, typename bbt>
@@ -2032,43 +2045,14 @@ bool parse(const std::string& txt, posit<nbits, es, bt>& p) {
 		return true;
 	}
 	else {
-		// Decimal floating-point representation.
-		// Route through the high-precision decimal_to_binary utility so that
-		// wide posit configurations (nbits > 64) don't lose precision through
-		// an intermediate double. The utility delivers a normalized mantissa
-		// with target_mantissa_bits bits plus guard/sticky; we feed that
-		// directly into convert_<>() so rounding is done once in the posit
-		// encoding step.
+		// Decimal floating-point representation: from_chars rounds once, on
+		// the posit encoding, for any nbits (posit/from_chars.hpp).
 		// Special-value literals (nan / inf in any common spelling) map to NaR.
-		{
-			std::string t; t.reserve(txt.size());
-			for (char c : txt) t.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
-			std::string body = t;
-			if (!body.empty() && (body.front() == '+' || body.front() == '-')) body.erase(0, 1);
-			if (body == "nan" || body == "inf" || body == "infinity") {
-				p.setnar();
-				return true;
-			}
-		}
-		constexpr unsigned extractBits         = nbits + 4;
-		constexpr unsigned target_mantissa_bits = extractBits + 1;
-		auto d = ::sw::universal::decimal_to_binary::convert(
-			std::string_view{txt}, target_mantissa_bits);
-		if (!d.valid) return false;
-		if (d.is_zero) {
-			p.setzero();
-			return true;
-		}
-		blocksignificand<extractBits, bt> frac;
-		for (unsigned i = 0; i < extractBits; ++i) {
-			if (d.mantissa.at(i)) frac.setbit(i, true);
-		}
-		// Fold d2b's residual guard/sticky into the lowest bit so convert_'s
-		// own sticky accumulator picks them up.
-		if (d.guard_bit || d.sticky_bit) frac.setbit(0, true);
-		convert_<nbits, es, bt, extractBits>(d.negative,
-			static_cast<int>(d.binary_scale), frac, p);
-		return true;
+		const char* first = txt.data();
+		const char* last  = txt.data() + txt.size();
+		if (first != last && *first == '+') ++first;
+		auto [ptr, ec] = from_chars(first, last, p);
+		return ec == std::errc{} && ptr == last;
 	}
 }
 
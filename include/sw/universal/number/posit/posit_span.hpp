@@ -0,0 +1,174 @@
+#pragma once
+// posit_span.hpp: batched posit add, sub, mul, and fma over arrays
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The posit operators decide per call whether the machine-word path of fast_arithmetic.hpp applies,
+// and copy the encodings in and out of the block storage of the posit each time. These kernels work
+// on whole arrays of a posit configuration of at most 64 bits:
+//
+//   posit_add(a, b, c)         c[i] = a[i] + b[i]
+//   posit_sub(a, b, c)         c[i] = a[i] - b[i]
+//   posit_mul(a, b, c)         c[i] = a[i] * b[i]
+//   posit_fma(a, b, c, d)      d[i] = fma(a[i], b[i], c[i]), rounded once
+//
+// Each block of elements is processed in three passes: the encodings are gathered into 64-bit words,
+// the raw-word kernels of posit_fast_arithmetic run over the block without touching the posits, and
+// the results are scattered back. The compute pass is a branch-minimized sequence of integer
+// operations per element (clz, shifts, one 64- or 128-bit add or multiply, and one rounding step),
+// so the loop carries no dependency between elements and keeps the integer units busy. Elements with
+// a zero or NaR operand are marked in the compute pass and take the scalar operators in the scatter
+// pass, so the results, including the arithmetic exceptions of NaR, are those of the operators.
+//
+// The output may alias an input: element i is written only after the operands of element i are read.
+// Configurations without a machine-word path for an operation use the scalar operators.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <universal/number/posit/posit.hpp>
+
+namespace sw { namespace universal {
+
+namespace posit_detail {
+
+	// elements per gather/compute/scatter round; the encodings of a block stay in L1
+	constexpr std::size_t span_block = 256;
+
+	// the encodings of x[0, n)
+	template<typename Posit>
+	inline void gather(const Posit* x, uint64_t* raw, std::size_t n) noexcept {
+		for (std::size_t i = 0; i < n; ++i) raw[i] = posit_fast_arithmetic<Posit>::bits(x[i]);
+	}
+
+	// c[i] = op(a[i], b[i]) with the raw-word kernel, or the scalar operator where the kernel declines
+	template<typename Posit, typename Kernel, typename Scalar>
+	inline void binary(const Posit* a, const Posit* b, Posit* c, std::size_t n, Kernel kernel, Scalar scalar) {
+		uint64_t ra[span_block], rb[span_block], rc[span_block];
+		bool fast[span_block];
+		for (std::size_t first = 0; first < n; first += span_block) {
+			std::size_t count = std::min(n - first, span_block);
+			gather(a + first, ra, count);
+			gather(b + first, rb, count);
+			for (std::size_t i = 0; i < count; ++i) fast[i] = kernel(ra[i], rb[i], rc[i]);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (fast[i]) c[first + i].setbits(rc[i]);
+				else c[first + i] = scalar(a[first + i], b[first + i]);
+			}
+		}
+	}
+
+} // namespace posit_detail
+
+/// c[i] = a[i] + b[i]
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_add(std::span<const posit<nbits, es, bt>> a, std::span<const posit<nbits, es, bt>> b, std::span<posit<nbits, es, bt>> c) {
+	using Posit = posit<nbits, es, bt>;
+	using Fast = posit_fast_arithmetic<Posit>;
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (Fast::addition) {
+		posit_detail::binary(a.data(), b.data(), c.data(), a.size(),
+			[](uint64_t x, uint64_t y, uint64_t& r) { return Fast::addBits(x, y, r); },
+			[](const Posit& x, const Posit& y) { return x + y; });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] + b[i];
+	}
+}
+
+/// c[i] = a[i] - b[i]
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_sub(std::span<const posit<nbits, es, bt>> a, std::span<const posit<nbits, es, bt>> b, std::span<posit<nbits, es, bt>> c) {
+	using Posit = posit<nbits, es, bt>;
+	using Fast = posit_fast_arithmetic<Posit>;
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (Fast::addition) {
+		// negation is exact on the encoding, and maps zero and NaR onto themselves
+		posit_detail::binary(a.data(), b.data(), c.data(), a.size(),
+			[](uint64_t x, uint64_t y, uint64_t& r) { return Fast::addBits(x, Fast::negate(y), r); },
+			[](const Posit& x, const Posit& y) { return x - y; });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] - b[i];
+	}
+}
+
+/// c[i] = a[i] * b[i]
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_mul(std::span<const posit<nbits, es, bt>> a, std::span<const posit<nbits, es, bt>> b, std::span<posit<nbits, es, bt>> c) {
+	using Posit = posit<nbits, es, bt>;
+	using Fast = posit_fast_arithmetic<Posit>;
+	assert(b.size() >= a.size() && c.size() >= a.size());
+	if constexpr (Fast::multiplication) {
+		posit_detail::binary(a.data(), b.data(), c.data(), a.size(),
+			[](uint64_t x, uint64_t y, uint64_t& r) { return Fast::mulBits(x, y, r); },
+			[](const Posit& x, const Posit& y) { return x * y; });
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) c[i] = a[i] * b[i];
+	}
+}
+
+/// d[i] = fma(a[i], b[i], c[i]): the product and the sum are rounded once
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_fma(std::span<const posit<nbits, es, bt>> a, std::span<const posit<nbits, es, bt>> b, std::span<const posit<nbits, es, bt>> c, std::span<posit<nbits, es, bt>> d) {
+	using Posit = posit<nbits, es, bt>;
+	using Fast = posit_fast_arithmetic<Posit>;
+	assert(b.size() >= a.size() && c.size() >= a.size() && d.size() >= a.size());
+	if constexpr (Fast::fusedMultiplyAdd) {
+		uint64_t ra[posit_detail::span_block], rb[posit_detail::span_block], rc[posit_detail::span_block], rd[posit_detail::span_block];
+		bool fast[posit_detail::span_block];
+		for (std::size_t first = 0; first < a.size(); first += posit_detail::span_block) {
+			std::size_t count = std::min(a.size() - first, posit_detail::span_block);
+			posit_detail::gather(a.data() + first, ra, count);
+			posit_detail::gather(b.data() + first, rb, count);
+			posit_detail::gather(c.data() + first, rc, count);
+			for (std::size_t i = 0; i < count; ++i) fast[i] = Fast::fmaBits(ra[i], rb[i], rc[i], rd[i]);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (fast[i]) d[first + i].setbits(rd[i]);
+				else d[first + i] = fma(a[first + i], b[first + i], c[first + i]);
+			}
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < a.size(); ++i) d[i] = fma(a[i], b[i], c[i]);
+	}
+}
+
+// std::vector conveniences; the output is resized to the length of the first operand
+
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_add(const std::vector<posit<nbits, es, bt>>& a, const std::vector<posit<nbits, es, bt>>& b, std::vector<posit<nbits, es, bt>>& c) {
+	using Posit = posit<nbits, es, bt>;
+	c.resize(a.size());
+	posit_add(std::span<const Posit>(a), std::span<const Posit>(b), std::span<Posit>(c));
+}
+
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_sub(const std::vector<posit<nbits, es, bt>>& a, const std::vector<posit<nbits, es, bt>>& b, std::vector<posit<nbits, es, bt>>& c) {
+	using Posit = posit<nbits, es, bt>;
+	c.resize(a.size());
+	posit_sub(std::span<const Posit>(a), std::span<const Posit>(b), std::span<Posit>(c));
+}
+
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_mul(const std::vector<posit<nbits, es, bt>>& a, const std::vector<posit<nbits, es, bt>>& b, std::vector<posit<nbits, es, bt>>& c) {
+	using Posit = posit<nbits, es, bt>;
+	c.resize(a.size());
+	posit_mul(std::span<const Posit>(a), std::span<const Posit>(b), std::span<Posit>(c));
+}
+
+template<unsigned nbits, unsigned es, typename bt>
+inline void posit_fma(const std::vector<posit<nbits, es, bt>>& a, const std::vector<posit<nbits, es, bt>>& b, const std::vector<posit<nbits, es, bt>>& c, std::vector<posit<nbits, es, bt>>& d) {
+	using Posit = posit<nbits, es, bt>;
+	d.resize(a.size());
+	posit_fma(std::span<const Posit>(a), std::span<const Posit>(b), std::span<const Posit>(c), std::span<Posit>(d));
+}
+
+}} // namespace sw::universal
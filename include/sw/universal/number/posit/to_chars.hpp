@@ -0,0 +1,53 @@
+#pragma once
+// to_chars.hpp: shortest round-trip decimal representation of posits
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// to_chars(first, last, p) writes the shortest decimal that converts back to p, in the format
+// std::to_chars uses for float and double; to_chars(span, out) does the same for an array.
+//
+// A posit rounds on its encoding: a value between two posits rounds to the one whose bit string is
+// nearest, ties to even. The rounding boundaries of p are therefore the posits one bit wider with
+// encodings 2*p - 1 and 2*p + 1. This is the arithmetic midpoint where the neighbors have fraction
+// bits, and the geometric one where the regime has crowded out exponent bits. Beyond maxpos and
+// below minpos posits saturate, so the bounds used there are tighter than the true interval, and
+// the digits of those two values are not always the shortest.
+//
+// Usage:
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/number/posit/to_chars.hpp>
+//
+//   char buf[64];
+//   auto [end, ec] = to_chars(buf, buf + sizeof(buf), posit<32,2>(0.1));  // "0.1"
+#include <charconv>
+#include <universal/number/support/shortest.hpp>
+
+namespace sw { namespace universal {
+
+template<unsigned nbits, unsigned es, typename bt>
+std::to_chars_result to_chars(char* first, char* last, const posit<nbits, es, bt>& v,
+                              shortest::strategy strategy = shortest::strategy::automatic) {
+	using Posit = posit<nbits, es, bt>;
+	using Wider = posit<nbits + 1, es, bt>;
+	if (v.isnar()) return shortest::format(first, last, "nar");
+	if (v.iszero()) return shortest::format(first, last, "0");
+
+	Posit a = v.sign() ? -v : v;
+	auto bits = a.bits();
+	Wider high{};
+	for (unsigned i = 0; i < nbits; ++i) high.setbit(i + 1, bits.test(i));
+	high.setbit(0);
+	Wider low = high;
+	--low;
+	--low;
+	return shortest::to_chars(first, last, v.sign(),
+		shortest::dyadic_of(a.template to_value<BlockTripleOperator::REP>()),
+		shortest::dyadic_of(low.template to_value<BlockTripleOperator::REP>()),
+		shortest::dyadic_of(high.template to_value<BlockTripleOperator::REP>()),
+		!bits.test(0), strategy);
+}
+
+}} // namespace sw::universal
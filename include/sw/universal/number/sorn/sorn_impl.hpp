@@ -7,24 +7,27 @@
 #include <cassert>
 #include <cstdint>
 #include <cmath>
+#include <array>
+#include <bit>
+#include <bitset>
 #include <iostream>
+#include <limits>
 #include <sstream>
-#include <vector>
-#include <bitset>
+#include <string>
 
 #include <universal/number/shared/specific_value_encoding.hpp>
 
 namespace sw { namespace universal {
 
 // struct sornInterval: a struct defining a SORN interval with two interval bound values and open/closed conditions.
-template<typename Real> 
+template<typename Real>
 struct sornInterval {
 	Real lowerBound;
 	Real upperBound;
 	bool lowerIsOpen;
 	bool upperIsOpen;
 
-	std::string getInt() {
+	std::string getInt() const {
 		std::stringstream configStream;
 		if ((this->lowerBound == this->upperBound) && (not this->lowerIsOpen && not this->upperIsOpen)) {
 			configStream << this->lowerBound;
@@ -35,116 +38,149 @@ struct sornInterval {
 		return configStream.str();
 	}
 
-	bool isZero() const noexcept {
-		if (this->lowerBound == 0 && this->upperBound == 0 && not this->lowerIsOpen && not this->upperIsOpen) {
-			return true;
-		} 
-		else {
-			return false;
-		}
+	constexpr bool isZero() const noexcept {
+		return (this->lowerBound == 0 && this->upperBound == 0 && not this->lowerIsOpen && not this->upperIsOpen);
+	}
+
+	// containsZero: true if 0 is an element of the interval
+	constexpr bool containsZero() const noexcept {
+		return (this->lowerBound < 0 || (this->lowerBound == 0 && not this->lowerIsOpen)) &&
+		       (this->upperBound > 0 || (this->upperBound == 0 && not this->upperIsOpen));
 	}
 
 };
 
-// setSornDT: function to create a SORN datatype
-template<typename Real>
-inline std::vector<sornInterval<Real>> setSornDT(signed int start, signed int stop, unsigned int steps, float stepSize,
-									bool flagNeg, bool flagInf, bool flagZero, bool flagLin,
-									bool flagLog, bool flagHalfopen, bool flagOpen, size_t sornBits ) {
+// sornPow2: 2^e for the bounds of the logarithmic lattice, usable in constant expressions
+constexpr float sornPow2(int e) noexcept {
+	float v = 1.0f;
+	for (; e > 0; --e) v *= 2.0f;
+	for (; e < 0; ++e) v *= 0.5f;
+	return v;
+}
+
+// setSornDT: function to create a SORN datatype, ordered from the most negative to the most positive interval
+template<typename Real, size_t sornBits>
+constexpr std::array<sornInterval<Real>, sornBits> setSornDT(signed int start, signed int stop, unsigned int steps, float stepSize,
+                                                             bool flagNeg, bool flagInf, bool flagZero, bool flagLin, bool flagLog) {
 	using SORN_INTERVAL = sornInterval<Real>;
-	using std::pow;
-	using std::fmax;
-
-	std::vector<SORN_INTERVAL> sornDT;
-	// 1. halfopen config
-	if (flagHalfopen) {
-		// 1.1. zero
-		if (flagZero) {
-			SORN_INTERVAL structInt;
-			structInt.lowerBound = 0;
-			structInt.upperBound = 0;
-			structInt.lowerIsOpen = false;
-			structInt.upperIsOpen = false;
-			sornDT.push_back(structInt);
-		}
-		// 1.2. positive part
-		if (flagLin) {
-			// 1.2.1 linear config
-			assert(start == 0 && "%% ERROR %% Start value has to be set to 0 for linear halfopen configuration.");
-			for (int b = 0; b < (int)steps; b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = b * stepSize;
-				structInt.upperBound = (b + 1) * stepSize;
-				structInt.lowerIsOpen = (b == 0 && not flagZero ? false : true);
-				structInt.upperIsOpen = false;
-				sornDT.push_back(structInt);
-			}
-		}
-		else if (flagLog) {
-			// 1.2.2 logarithmic config (Note: "steps" value is ignored for logarithmic configuration)
-			for (int b = start; b < (stop + 1); b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = (b == start ? 0 : (float)pow(2, (b - 1)));
-				structInt.upperBound = (float)pow(2, b);
-				structInt.lowerIsOpen = (b == 0 && not flagZero ? false : true);
-				structInt.upperIsOpen = false;
-				sornDT.push_back(structInt);
-			}
-		}
-		// 1.3. infinity
-		if (flagInf) {
-			SORN_INTERVAL structInt;
-			structInt.lowerBound = sornDT[sornDT.size() - 1].upperBound;
-			structInt.upperBound = std::numeric_limits<float>::infinity();
-			structInt.lowerIsOpen = true;
-			structInt.upperIsOpen = false;
-			sornDT.push_back(structInt);
+
+	// 1. non-negative half
+	std::array<SORN_INTERVAL, sornBits> posDT{};
+	size_t n = 0;
+	// 1.1. zero
+	if (flagZero) {
+		posDT[n++] = { 0, 0, false, false };
+	}
+	// 1.2. positive part
+	if (flagLin) {
+		// 1.2.1 linear config
+		assert(start == 0 && "%% ERROR %% Start value has to be set to 0 for linear halfopen configuration.");
+		for (int b = 0; b < (int)steps; b++) {
+			posDT[n++] = { b * stepSize, (b + 1) * stepSize, (b == 0 && not flagZero ? false : true), false };
 		}
-		// 1.4. negative intervals
-		if (flagNeg) {
-			std::vector<SORN_INTERVAL> negDT;
-			for (size_t b = (flagZero ? 1 : 0); b < sornDT.size(); b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = -sornDT[b].upperBound;
-				structInt.upperBound = (sornDT[b].lowerBound == 0 ? sornDT[b].lowerBound : -sornDT[b].lowerBound);
-				structInt.lowerIsOpen = false;
-				structInt.upperIsOpen = true;
-				negDT.insert(negDT.begin(), structInt);
-			}
-			sornDT.insert(sornDT.begin(), negDT.begin(), negDT.end());
+	}
+	else if (flagLog) {
+		// 1.2.2 logarithmic config (Note: "steps" value is ignored for logarithmic configuration)
+		for (int b = start; b < (stop + 1); b++) {
+			posDT[n++] = { (b == start ? 0 : sornPow2(b - 1)), sornPow2(b), (b == 0 && not flagZero ? false : true), false };
 		}
 	}
-	// 2. open config (TODO)
-	else if (flagOpen) {
-		assert(not flagOpen && "%% WARNING %% Open interval datatypes not implemented.");
+	// 1.3. infinity
+	if (flagInf) {
+		posDT[n] = { posDT[n - 1].upperBound, std::numeric_limits<Real>::infinity(), true, false };
+		++n;
+	}
+
+	// 2. negative intervals mirror the positive ones
+	std::array<SORN_INTERVAL, sornBits> sornDT{};
+	size_t nrNeg = (flagNeg ? n - (flagZero ? 1 : 0) : 0);
+	for (size_t b = 0; b < nrNeg; b++) {
+		const SORN_INTERVAL& p = posDT[n - 1 - b];
+		sornDT[b] = { -p.upperBound, (p.lowerBound == 0 ? p.lowerBound : -p.lowerBound), false, true };
+	}
+	for (size_t b = 0; b < n; b++) {
+		sornDT[nrNeg + b] = posDT[b];
 	}
 	// 3. check config
-	assert(sornDT.size() == sornBits && "Something is wrong with the Datatype size. Check sornDT and sornBits.");
-	// 4. return DT
+	assert(nrNeg + n == sornBits && "Something is wrong with the Datatype size. Check sornDT and sornBits.");
 	return sornDT;
 }
 
-// float2SORN: a function converting a single float input to a SORN interval
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// interval arithmetic on single lattice intervals
+//
+// These kernels fill the operator tables of the sorn class. The bounds follow the interval rules,
+// and a bound is closed only if a pair of closed operand bounds attains it.
+
+template<typename Real>
+constexpr sornInterval<Real> sornAdd(const sornInterval<Real>& a, const sornInterval<Real>& b) noexcept {
+	return { a.lowerBound + b.lowerBound, a.upperBound + b.upperBound, a.lowerIsOpen || b.lowerIsOpen, a.upperIsOpen || b.upperIsOpen };
+}
+
+template<typename Real>
+constexpr sornInterval<Real> sornSub(const sornInterval<Real>& a, const sornInterval<Real>& b) noexcept {
+	return { a.lowerBound - b.upperBound, a.upperBound - b.lowerBound, a.lowerIsOpen || b.upperIsOpen, a.upperIsOpen || b.lowerIsOpen };
+}
+
+template<typename Real>
+constexpr sornInterval<Real> sornNeg(const sornInterval<Real>& a) noexcept {
+	return { Real(0) - a.upperBound, Real(0) - a.lowerBound, a.upperIsOpen, a.lowerIsOpen };
+}
+
+template<typename Real>
+constexpr sornInterval<Real> sornAbs(const sornInterval<Real>& a) noexcept {
+	if (a.upperBound <= 0) return sornNeg(a);
+	if (a.lowerBound >= 0) return a;
+	// the interval straddles zero
+	Real magnitude = Real(0) - a.lowerBound;
+	if (magnitude > a.upperBound) return { 0, magnitude, false, a.lowerIsOpen };
+	if (magnitude < a.upperBound) return { 0, a.upperBound, false, a.upperIsOpen };
+	return { 0, a.upperBound, false, a.lowerIsOpen && a.upperIsOpen };
+}
+
 template<typename Real>
-sornInterval<Real> float2SORN(float operand, std::vector<sornInterval<Real>> sornDT, sornInterval<Real>& sornIntVal) {
-	for (size_t b = 0; b < sornDT.size(); b++) {
-		if (	( (operand > sornDT[b].lowerBound) || (operand == sornDT[b].lowerBound && not sornDT[b].lowerIsOpen) ) &&
-				( (operand < sornDT[b].upperBound) || (operand == sornDT[b].upperBound && not sornDT[b].upperIsOpen) )		) {
-			sornIntVal = sornDT[b];
+sornInterval<Real> sornMul(const sornInterval<Real>& a, const sornInterval<Real>& b) noexcept {
+	if (a.isZero() || b.isZero()) return { 0, 0, false, false };
+	const Real aBound[2] = { a.lowerBound, a.upperBound };
+	const Real bBound[2] = { b.lowerBound, b.upperBound };
+	const bool aOpen[2]  = { a.lowerIsOpen, a.upperIsOpen };
+	const bool bOpen[2]  = { b.lowerIsOpen, b.upperIsOpen };
+	sornInterval<Real> result{ std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity(), true, true };
+	for (int i = 0; i < 2; ++i) {
+		for (int j = 0; j < 2; ++j) {
+			Real v = aBound[i] * bBound[j];
+			if (v != v) continue;  // 0 * inf: the remaining corners bound the product
+			// a closed zero bound attains 0 against any value of the other operand
+			bool closed = (not aOpen[i] && not bOpen[j]) || (aBound[i] == 0 && not aOpen[i]) || (bBound[j] == 0 && not bOpen[j]);
+			if (v < result.lowerBound)       { result.lowerBound = v; result.lowerIsOpen = not closed; }
+			else if (v == result.lowerBound) { result.lowerIsOpen = result.lowerIsOpen && not closed; }
+			if (v > result.upperBound)       { result.upperBound = v; result.upperIsOpen = not closed; }
+			else if (v == result.upperBound) { result.upperIsOpen = result.upperIsOpen && not closed; }
 		}
 	}
-	return sornIntVal;
+	return result;
+}
+
+template<typename Real>
+sornInterval<Real> sornDiv(const sornInterval<Real>& a, const sornInterval<Real>& b) noexcept {
+	constexpr Real inf = std::numeric_limits<Real>::infinity();
+	if (b.containsZero()) return { -inf, inf, false, false };  // a divisor that can be zero yields every value
+	if (a.isZero()) return { 0, 0, false, false };
+	sornInterval<Real> reciprocal{ (b.upperBound == 0 ? -inf : Real(1) / b.upperBound),
+	                               (b.lowerBound == 0 ?  inf : Real(1) / b.lowerBound),
+	                               b.upperIsOpen, b.lowerIsOpen };
+	return sornMul(a, reciprocal);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
-// class sorn: a class for defining a SORN format:	sorn<start,stop,steps,lin,halfopen,neg,inf,zero>					 
-// 
-// -- Mandatory configuration parameters:	
-//		start:	lowest value in the SORN lattice // for "lin" start=0 // for "log" -inf<start<inf, lattice begins with 2^start 
+// class sorn: a class for defining a SORN format:	sorn<start,stop,steps,lin,halfopen,neg,inf,zero>
+//
+// -- Mandatory configuration parameters:
+//		start:	lowest value in the SORN lattice // for "lin" start=0 // for "log" -inf<start<inf, lattice begins with 2^start
 //		stop:	highest non-infinity value in the SORN lattice // for "lin" start<stop // for "log" start<stop, lattice ends with 2^stop
 //		steps:	number of intervals/steps within the SORN representation between "start" and "stop" for "lin" (positive part),
 //				not required for "log" distribution (any positve value allowed)
-// 
+//
 // -- Optional configuration parameters: (all "true" by default)
 //		lin:		set the SORN interval distribution to "linear" (true) or "logarithmic" (false)
 //		halfopen:	set the SORN interval distribution to "halfopen bounds, no exact values" (true) or "open bounds,
@@ -152,6 +188,10 @@ sornInterval<Real> float2SORN(float operand, std::vector<sornInterval<Real>> sor
 //		neg:		include negative values/intervals in the SORN datatype, symmetric to positive part
 //		inf:		inlcude infinity value/interval bounds to the SORN datatype
 //		zero:		inlcude the exact zero value in the SORN datatype
+//
+// A SORN value is a set of lattice intervals, stored as one bit per interval. The lattice is a
+// compile-time table shared by all values of a type, and the arithmetic operators OR together
+// precomputed results of every pair of lattice intervals, which are built on first use.
 //////////////////////////////////////////////////////////////////////////////////////////////////
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg=1, bool _inf=1, bool _zero=1>
 class sorn {
@@ -163,8 +203,8 @@ public:
 private:
 
 	// input configuration parameters
-	static constexpr signed int start	= _start;	// lowest non-zero value in the SORN lattice 
-	static constexpr signed int stop	= _stop;	// highest non-infinity value in the SORN lattice 
+	static constexpr signed int start	= _start;	// lowest non-zero value in the SORN lattice
+	static constexpr signed int stop	= _stop;	// highest non-infinity value in the SORN lattice
 	static constexpr unsigned int steps	= _steps;	// number of intervals/steps within the SORN representation between start and stop (only for positive part, only for linear distribution)
 	static constexpr float stepSize = (float)(stop - start) / (float)steps;
 
@@ -175,15 +215,14 @@ private:
 	static constexpr bool flagLin		= _lin;			// set the SORN interval distribution to "linear"										(default: true)
 	static constexpr bool flagLog		= not _lin;		// set the SORN interval distribution to "logarithmic"									(default: false)
 	static constexpr bool flagHalfopen	= _halfopen;	// set the SORN interval distribution to halfopen without exacts						(default: true)
-	static constexpr bool flagOpen		= not _halfopen;// set the SORN interval distribution to open with intermediate exacts					(default: false) 
+	static constexpr bool flagOpen		= not _halfopen;// set the SORN interval distribution to open with intermediate exacts					(default: false)
 
-public:
+	static_assert(flagHalfopen, "sorn: open interval datatypes with intermediate exact values are not implemented");
 
-	// SORN value with NaN initialisation
-	SORN_INTERVAL sornIntVal = { std::numeric_limits<Real>::quiet_NaN() , std::numeric_limits<Real>::quiet_NaN() , false , false };
+public:
 
-	// SORN bitwidth (redundant with sornDT.size())
-	static constexpr size_t sornBits =	( 
+	// SORN bitwidth
+	static constexpr size_t sornBits =	(
 											( (flagLin ? steps : stop - start + 1) + (flagInf ? 1 : 0) ) *		// determine number of intervals (either halfopen or open)
 											(flagOpen ? 2 : 1)													// double if open intervals with intermediate exact values are used
 										) *
@@ -191,44 +230,43 @@ public:
 										(flagZero ? 1 : 0) -													// consider the exact zero value
 										((flagOpen & flagInf & flagNeg) ? 1 : 0);									// for open intervals only one value for +-inf is used
 	static constexpr size_t nbits = sornBits;
+	using bits_type = std::bitset<sornBits>;
 
-	// SORN datatype
-	std::vector<SORN_INTERVAL> sornDT = setSornDT<Real>(start, stop, steps, stepSize, flagNeg, flagInf, flagZero, flagLin, flagLog, flagHalfopen, flagOpen, sornBits);
+	// SORN datatype: the interval lattice, shared by all values of this type
+	static constexpr std::array<SORN_INTERVAL, sornBits> sornDT = setSornDT<Real, sornBits>(start, stop, steps, stepSize, flagNeg, flagInf, flagZero, flagLin, flagLog);
 
 	// constructors
-	sorn() {}
+	sorn() = default;  // the empty set, which is the SORN NaN
 
 	// specific value constructor
-	constexpr sorn(const SpecificValue code) noexcept {
+	sorn(const SpecificValue code) noexcept {
 		switch (code) {
 		case SpecificValue::maxpos:
-			//maxpos();
+			_bits.set(sornBits - (flagInf ? 2 : 1));
 			break;
 		case SpecificValue::minpos:
-			//minpos();
+			_bits.set(nrNegative + (flagZero ? 1 : 0));
 			break;
 		case SpecificValue::zero:
 		default:
-			//zero();
+			setzero();
 			break;
 		case SpecificValue::minneg:
-			//minneg();
+			if constexpr (flagNeg) _bits.set(nrNegative - 1); else setzero();
 			break;
 		case SpecificValue::maxneg:
-			//maxneg();
+			if constexpr (flagNeg) _bits.set(flagInf ? 1 : 0); else setzero();
 			break;
 		case SpecificValue::infpos:
-			//setinf(false);
+			_bits.set(sornBits - 1);
 			break;
 		case SpecificValue::infneg:
-			//setinf(true);
+			if constexpr (flagNeg) _bits.set(0); else setzero();
 			break;
 		case SpecificValue::nar: // approximation as IEEE-754 SORNs don't have a NaR
 		case SpecificValue::qnan:
-			//setnan(NAN_TYPE_QUIET);
-			break;
 		case SpecificValue::snan:
-			//setnan(NAN_TYPE_SIGNALLING);
+			_bits.reset();
 			break;
 		}
 	}
@@ -248,246 +286,92 @@ public:
 	sorn(double initial_value)				{ *this = initial_value; }
 	sorn(long double initial_value)			{ *this = initial_value; }
 
-	// assignment operators for native types
-	sorn operator=(signed char rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(short rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(int rhs)					{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long long rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(char rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned short rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned int rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned long rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned long long rhs)	{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(float rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(double rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long double rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
+	// assignment operators for native types: select the lattice interval that holds the value
+	sorn& operator=(signed char rhs)		{ return assign((float)rhs); }
+	sorn& operator=(short rhs)				{ return assign((float)rhs); }
+	sorn& operator=(int rhs)				{ return assign((float)rhs); }
+	sorn& operator=(long rhs)				{ return assign((float)rhs); }
+	sorn& operator=(long long rhs)			{ return assign((float)rhs); }
+	sorn& operator=(char rhs)				{ return assign((float)rhs); }
+	sorn& operator=(unsigned short rhs)		{ return assign((float)rhs); }
+	sorn& operator=(unsigned int rhs)		{ return assign((float)rhs); }
+	sorn& operator=(unsigned long rhs)		{ return assign((float)rhs); }
+	sorn& operator=(unsigned long long rhs)	{ return assign((float)rhs); }
+	sorn& operator=(float rhs)				{ return assign((float)rhs); }
+	sorn& operator=(double rhs)				{ return assign((float)rhs); }
+	sorn& operator=(long double rhs)		{ return assign((float)rhs); }
 
 	///////////////////////////////
 	////////// operators //////////
 	///////////////////////////////
 
-	// write to output
-	friend std::ostream& operator<< (std::ostream& ostr, sorn& s) {
-		return ostr << s.sornIntVal.getInt();
-	}
-
-	// arithmetics	(TODO: div, comparison?)
-
 	// negation operator
-	sorn operator-() {
-		if (iszero()) {
-			return *this;
-		}
-		else {
-			sorn negated;
-			negated.sornIntVal.lowerBound = (this->sornIntVal.upperBound == 0 ? this->sornIntVal.upperBound : -this->sornIntVal.upperBound);
-			negated.sornIntVal.upperBound = (this->sornIntVal.lowerBound == 0 ? this->sornIntVal.lowerBound : -this->sornIntVal.lowerBound);
-			negated.sornIntVal.lowerIsOpen = this->sornIntVal.upperIsOpen;
-			negated.sornIntVal.upperIsOpen = this->sornIntVal.lowerIsOpen;
-			return negated;
-		}
+	sorn operator-() const {
+		sorn negated;
+		negated._bits = map(tables().neg, _bits);
+		return negated;
 	}
 
-	// single operand addition 
-	
+	// single operand addition
+
 	// sorn + sorn
-	sorn& operator+=(sorn& rhs) {
-		if (rhs.iszero()) {
-			return *this;
-		}
-		else if (this->iszero()) {
-			*this = rhs;
-			return *this;
-		}
-		else {
-			this->sornIntVal.lowerBound += rhs.sornIntVal.lowerBound;
-			this->sornIntVal.upperBound += rhs.sornIntVal.upperBound;
-			this->sornIntVal.lowerIsOpen = (this->sornIntVal.lowerIsOpen || rhs.sornIntVal.lowerIsOpen);
-			this->sornIntVal.upperIsOpen = (this->sornIntVal.upperIsOpen || rhs.sornIntVal.upperIsOpen);
-			adaptToDT();
-			return *this;
-		}
-	}
+	sorn& operator+=(const sorn& rhs) { _bits = combine(tables().add, _bits, rhs._bits); return *this; }
 	// sorn + int
-	sorn& operator+=(int rhs) {
-		this->sornIntVal.lowerBound += rhs;
-		this->sornIntVal.upperBound += rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator+=(int rhs)         { return applyScalar(sornAdd<Real>, (float)rhs); }
 	// sorn + float
-	sorn& operator+=(float rhs) {
-		this->sornIntVal.lowerBound += rhs;
-		this->sornIntVal.upperBound += rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator+=(float rhs)       { return applyScalar(sornAdd<Real>, rhs); }
 	// sorn + double
-	sorn& operator+=(double rhs) {
-		this->sornIntVal.lowerBound += (float)rhs;
-		this->sornIntVal.upperBound += (float)rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator+=(double rhs)      { return applyScalar(sornAdd<Real>, (float)rhs); }
 
 	// single operand subtraction
 
 	// sorn - sorn
-	sorn& operator-=(sorn& rhs) {
-		if (rhs.iszero()) {
-			return *this;
-		}
-		else if (this->iszero()) {
-			*this = -rhs;
-			return *this;
-		}
-		else {
-			this->sornIntVal.lowerBound -= rhs.sornIntVal.upperBound;
-			this->sornIntVal.upperBound -= rhs.sornIntVal.lowerBound;
-			this->sornIntVal.lowerIsOpen = (this->sornIntVal.lowerIsOpen || rhs.sornIntVal.upperIsOpen);
-			this->sornIntVal.upperIsOpen = (this->sornIntVal.upperIsOpen || rhs.sornIntVal.lowerIsOpen);
-			adaptToDT();
-			return *this;
-		}
-	}
+	sorn& operator-=(const sorn& rhs) { _bits = combine(tables().sub, _bits, rhs._bits); return *this; }
 	// sorn - int
-	sorn& operator-=(int rhs) {
-		this->sornIntVal.lowerBound -= rhs;
-		this->sornIntVal.upperBound -= rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator-=(int rhs)         { return applyScalar(sornSub<Real>, (float)rhs); }
 	// sorn - float
-	sorn& operator-=(float rhs) {
-		this->sornIntVal.lowerBound -= rhs;
-		this->sornIntVal.upperBound -= rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator-=(float rhs)       { return applyScalar(sornSub<Real>, rhs); }
 	// sorn - double
-	sorn& operator-=(double rhs) {
-		this->sornIntVal.lowerBound -= (float)rhs;
-		this->sornIntVal.upperBound -= (float)rhs;
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator-=(double rhs)      { return applyScalar(sornSub<Real>, (float)rhs); }
 
 	// single operand multiplication
 
 	// sorn * sorn
-	sorn& operator*=(sorn& rhs) {
-		// 1. create references and intermediate values for the bounds
-		float &lhsLOW	= this->sornIntVal.lowerBound;
-		float &lhsUP	= this->sornIntVal.upperBound;
-		float &rhsLOW	= rhs.sornIntVal.lowerBound;
-		float &rhsUP	= rhs.sornIntVal.upperBound;
-		float resLOW;
-		float resUP;
-		// 2. create references and intermediate values for the conditions
-		bool &lhsLOWc	= this->sornIntVal.lowerIsOpen;
-		bool &lhsUPc	= this->sornIntVal.upperIsOpen;
-		bool &rhsLOWc	= rhs.sornIntVal.lowerIsOpen;
-		bool &rhsUPc	= rhs.sornIntVal.upperIsOpen;
-		bool resLOWc;
-		bool resUPc;
-		// 3. check zero case
-		if (rhs.iszero() || this->iszero()) {
-			setzero();
-			return *this;
-		}
-		else { // 4. follow interval arithmetic rules for multiplication
-			if (lhsLOW >= 0) { //					  lower bound					upper bound					lower condition					upper condition
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsLOW;		resUP = lhsUP  * rhsUP;		resLOWc = lhsLOWc || rhsLOWc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = lhsUP  * rhsLOW;		resUP = lhsUP  * rhsUP;		resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsLOW;		resUP = lhsLOW * rhsUP;		resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsLOWc || rhsUPc; }
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			else if (lhsLOW < 0 && lhsUP >= 0) {
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsUP;		resUP = lhsUP  * rhsUP;		resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = fmin(lhsLOW * rhsUP  , lhsUP * rhsLOW);			resLOWc = (lhsLOW * rhsUP  < lhsUP*rhsLOW ? lhsLOWc || rhsUPc  : lhsUPc || rhsLOWc);	// lower bound & condition
-													  resUP  = fmax(lhsLOW * rhsLOW , lhsUP * rhsUP );			resUPc  = (lhsLOW * rhsLOW > lhsUP*rhsUP  ? lhsLOWc || rhsLOWc : lhsUPc || rhsUPc ); }	// upper bound & condition
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsLOW;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsLOWc || rhsLOWc;}
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added 
-			}
-			else if (lhsUP < 0) {
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsUP;		resUP = lhsUP  * rhsLOW;	resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsUPc  || rhsLOWc;}
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = lhsLOW * rhsUP;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsLOWc || rhsLOWc;}
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsUP;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsUPc  || rhsUPc;	resUPc = lhsLOWc || rhsLOWc;}
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			else {
-				{ resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			// 5. set results
-			if (resLOW == -0) { resLOW = 0; } // remove -0
-			if (resUP  == -0) { resUP  = 0; } // remove -0
-			this->sornIntVal.lowerBound	 = resLOW;
-			this->sornIntVal.upperBound	 = resUP;
-			this->sornIntVal.lowerIsOpen = resLOWc;
-			this->sornIntVal.upperIsOpen = resUPc;
-			// 6. return
-			adaptToDT();
-			return *this;
-		}
-	}
+	sorn& operator*=(const sorn& rhs) { _bits = combine(tables().mul, _bits, rhs._bits); return *this; }
 	// sorn * int
-	sorn& operator*=(int rhs) {
-		this->sornIntVal.lowerBound *= rhs;
-		this->sornIntVal.upperBound *= rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator*=(int rhs)         { return applyScalar(sornMul<Real>, (float)rhs); }
 	// sorn * float
-	sorn& operator*=(float rhs) {
-		this->sornIntVal.lowerBound *= rhs;
-		this->sornIntVal.upperBound *= rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator*=(float rhs)       { return applyScalar(sornMul<Real>, rhs); }
 	// sorn * double
-	sorn& operator*=(double rhs) {
-		this->sornIntVal.lowerBound *= (float)rhs;
-		this->sornIntVal.upperBound *= (float)rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
-	}
+	sorn& operator*=(double rhs)      { return applyScalar(sornMul<Real>, (float)rhs); }
+
+	// single operand division: a divisor set that holds zero yields every lattice interval
+
+	// sorn / sorn
+	sorn& operator/=(const sorn& rhs) { _bits = combine(tables().div, _bits, rhs._bits); return *this; }
+	// sorn / int
+	sorn& operator/=(int rhs)         { return applyScalar(sornDiv<Real>, (float)rhs); }
+	// sorn / float
+	sorn& operator/=(float rhs)       { return applyScalar(sornDiv<Real>, rhs); }
+	// sorn / double
+	sorn& operator/=(double rhs)      { return applyScalar(sornDiv<Real>, (float)rhs); }
 
 	//////////////////////////////////////////
 	////////// arithmetic functions //////////
 	//////////////////////////////////////////
 
 	// absolute value
-	sorn abs() {
+	sorn abs() const {
 		sorn absVal;
-		if (this->sornIntVal.upperBound <= 0) {
-			absVal = -*this;
-		}
-		else if (this->sornIntVal.lowerBound < 0) {
-			absVal.sornIntVal.lowerBound = 0;
-			absVal.sornIntVal.lowerIsOpen = false;
-			if (std::abs(this->sornIntVal.lowerBound) > std::abs(this->sornIntVal.upperBound)) {
-				absVal.sornIntVal.upperBound = std::abs(this->sornIntVal.lowerBound);
-				absVal.sornIntVal.upperIsOpen = this->sornIntVal.lowerIsOpen;
-			}
-			else {
-				absVal.sornIntVal.upperBound = this->sornIntVal.upperBound;
-				absVal.sornIntVal.upperIsOpen = this->sornIntVal.upperIsOpen;
-			}
-		}
-		else {
-			absVal = *this;
-		};
-		absVal.adaptToDT();
+		absVal._bits = map(tables().abs, _bits);
 		return absVal;
 	}
 
-	template<typename Real>
-	Real to_native() const noexcept {
-		return Real(0.0f);
+	// to_native: the midpoint of the interval hull of the set
+	template<typename NativeReal>
+	NativeReal to_native() const noexcept {
+		SORN_INTERVAL hull = interval();
+		return NativeReal(hull.lowerBound) / 2 + NativeReal(hull.upperBound) / 2;
 	}
 	// make conversions to native types explicit
 	//explicit operator int()       const noexcept { return to_int(); }
@@ -501,129 +385,49 @@ public:
 	///////////////////////////////////////
 
 	// special value functions
-	bool iszero() const noexcept { return this->sornIntVal.isZero(); }
-	bool isnan() const noexcept { return false; }
-
-	sorn& setzero() { this->sornIntVal = { 0,0,0,0 }; return *this; }
+	bool iszero() const noexcept { return _bits.count() == 1 && sornDT[lowestBit()].isZero(); }
+	bool isnan() const noexcept { return _bits.none(); }
 
-	Real minVal() const noexcept { return sornDT[0].lowerBound; }
-	Real maxVal() const noexcept { return sornDT[sornDT.size() - 1].upperBound; }
+	sorn& setzero() { _bits = cover({ 0, 0, false, false }); return *this; }
 
-	// adaptToDT: adapt the variable sornIntVal to the defined datatype
-	SORN_INTERVAL& adaptToDT() {
-		// 1. lower bound
-		bool lowerExists = false;
-		// 1.1. check if lower bound already exisits in DT
-		for (size_t b = 0; b < sornDT.size(); b++) {
-			if (this->sornIntVal.lowerBound == sornDT[b].lowerBound && this->sornIntVal.lowerIsOpen == sornDT[b].lowerIsOpen) {
-				lowerExists = true;
-			}
-		}
-		// 1.2. adapt lower bound to DT
-		if (not lowerExists) {
-			// 1.2.1. lower bound < min value
-			if (this->sornIntVal.lowerBound < minVal()) {
-				this->sornIntVal.lowerBound = minVal();
-				this->sornIntVal.lowerIsOpen = this->sornDT[0].lowerIsOpen;
-			}
-			else {
-				for (size_t b = 0; b < sornDT.size(); b++) {
-					// 1.2.2. lower bound value between two possible values (from DT)
-					if (this->sornIntVal.lowerBound > sornDT[b].lowerBound && this->sornIntVal.lowerBound < sornDT[b].upperBound) {
-						this->sornIntVal.lowerBound = sornDT[b].lowerBound;
-						this->sornIntVal.lowerIsOpen = sornDT[b].lowerIsOpen;
-					} // 1.2.3. lower bound in DT but open/close condition does not match
-					else if (this->sornIntVal.lowerBound == sornDT[b].lowerBound && this->sornIntVal.lowerIsOpen != sornDT[b].lowerIsOpen) {
-						// cond. is "open" but has to be "closed"
-						if (this->sornIntVal.lowerIsOpen) {
-							this->sornIntVal.lowerBound = sornDT[b].lowerBound;
-							this->sornIntVal.lowerIsOpen = sornDT[b].lowerIsOpen;
-						}
-						// cond. is "closed" but has to be "open" --> utilize prevoius interval
-						else if (not this->sornIntVal.lowerIsOpen) {
-							this->sornIntVal.lowerBound = sornDT[b - 1].lowerBound;
-							this->sornIntVal.lowerIsOpen = sornDT[b - 1].lowerIsOpen;
-						}
-					}
-				}
-			}
-		}
-		// 2. upper bound
-		bool upperExists = false;
-		// 2.1.check if upper bound already exisits in DT
-		for (size_t b = 0; b < sornDT.size(); b++) {
-			if (this->sornIntVal.upperBound == sornDT[b].upperBound && this->sornIntVal.upperIsOpen == sornDT[b].upperIsOpen) {
-				upperExists = true;
-			}
-		}
-		// 2.2. adapt upper bound to DT
-		if (not upperExists) {
-			// 2.2.1 upper bound > max value
-			if (this->sornIntVal.upperBound > maxVal()) {
-				this->sornIntVal.upperBound = maxVal();
-				this->sornIntVal.upperIsOpen = this->sornDT[sornDT.size() - 1].upperIsOpen;
-			}
-			else {
-				for (size_t b = 0; b < sornDT.size(); b++) {
-					// 2.2.2. upper bound value between two possible values (from DT)
-					if (this->sornIntVal.upperBound > sornDT[b].lowerBound && this->sornIntVal.upperBound < sornDT[b].upperBound) {
-						this->sornIntVal.upperBound = sornDT[b].upperBound;
-						this->sornIntVal.upperIsOpen = sornDT[b].upperIsOpen;
-						break; // when the upper bound it set to open zero the next iteration would set it to closed zero
-					} // 2.2.3. upper bound in DT but open/close condition does not match
-					else if (this->sornIntVal.upperBound == sornDT[b].upperBound && this->sornIntVal.upperIsOpen != sornDT[b].upperIsOpen) {
-						// cond. is "open" but has to be "closed"
-						if (this->sornIntVal.upperIsOpen) {
-							this->sornIntVal.upperBound = sornDT[b].upperBound;
-							this->sornIntVal.upperIsOpen = sornDT[b].upperIsOpen;
-						} // cond. is "closed" but has to be "open" --> utilize next interval
-						else if (not this->sornIntVal.upperIsOpen) {
-							this->sornIntVal.upperBound = sornDT[b+1].upperBound;
-							this->sornIntVal.upperIsOpen = sornDT[b+1].upperIsOpen;
-						}
-						break;
-					}
-				}
-			}
-		}
-		// 3. return value
-		return this->sornIntVal;
-	}
+	static constexpr Real minVal() noexcept { return sornDT[0].lowerBound; }
+	static constexpr Real maxVal() noexcept { return sornDT[sornBits - 1].upperBound; }
 
-	// switchBounds: switch Boundaries of sornIntVal
-	SORN_INTERVAL& switchBounds() {
-		float newLow  = this->sornIntVal.upperBound;
-		float newUp   = this->sornIntVal.lowerBound;
-		bool  newLowC = this->sornIntVal.upperIsOpen;
-		bool  newUpC  = this->sornIntVal.lowerIsOpen;
-		this->sornIntVal = { newLow,newUp,newLowC,newUpC };
-		return this->sornIntVal;
+	// interval: the interval hull of the set, NaN bounds for the empty set
+	SORN_INTERVAL interval() const noexcept {
+		if (_bits.none()) return { std::numeric_limits<Real>::quiet_NaN(), std::numeric_limits<Real>::quiet_NaN(), false, false };
+		const SORN_INTERVAL& lower = sornDT[lowestBit()];
+		const SORN_INTERVAL& upper = sornDT[highestBit()];
+		return { lower.lowerBound, upper.upperBound, lower.lowerIsOpen, upper.upperIsOpen };
 	}
 
-	void setbits(std::uint64_t v) noexcept {}
-
-	// setBits: set the sornIntVal parameter via binary input (input type: bitset)
-	SORN_INTERVAL& setBits(std::bitset<sornBits> bin) {
-		bool lowerSet = false;
+	// cover: the set of lattice intervals that intersect interval v; parts of v beyond the lattice saturate to the outermost intervals
+	static bits_type cover(const SORN_INTERVAL& v) noexcept {
+		bits_type raw_bits;
+		if (v.lowerBound != v.lowerBound || v.upperBound != v.upperBound) return raw_bits;
 		for (size_t b = 0; b < sornBits; b++) {
-			if (bin[b] == 1 && not lowerSet) {
-				this->sornIntVal = this->sornDT[b];
-				lowerSet = true;
-			}
-			else if (bin[b] == 1 && lowerSet) {
-				this->sornIntVal.upperBound = this->sornDT[b].upperBound;
-				this->sornIntVal.upperIsOpen = this->sornDT[b].upperIsOpen;
-			}
+			const SORN_INTERVAL& d = sornDT[b];
+			bool belowUpper = (v.lowerBound < d.upperBound) || (v.lowerBound == d.upperBound && not v.lowerIsOpen && not d.upperIsOpen);
+			bool aboveLower = (d.lowerBound < v.upperBound) || (d.lowerBound == v.upperBound && not d.lowerIsOpen && not v.upperIsOpen);
+			if (belowUpper && aboveLower) raw_bits.set(b);
 		}
-		return this->sornIntVal;
+		if (v.lowerBound < minVal()) raw_bits.set(0);
+		if (v.upperBound > maxVal()) raw_bits.set(sornBits - 1);
+		return raw_bits;
 	}
 
+	// setbits: set the SORN value from the raw bits of an unsigned integer
+	void setbits(std::uint64_t v) noexcept { _bits = bits_type(v); }
+
+	// setBits: set the SORN value via binary input (input type: bitset)
+	sorn& setBits(const bits_type& bin) noexcept { _bits = bin; return *this; }
+
 	//////////////////////////////////////
 	////////// getter functions //////////
 	//////////////////////////////////////
 
 	// getConfig: writes all configuration parameters and flags to a string
-	std::string getConfig() {
+	std::string getConfig() const {
 		std::stringstream configStream;
 		configStream << "-- configuration parameters:" << '\t' << "start: " << start << ", stop: " << stop << ", steps: " << steps << ", stepSize: " << stepSize << '\n';
 		configStream << "-- configuration flags:" << "\t\t";
@@ -637,7 +441,7 @@ public:
 	}
 
 	// getDT: writes the SORN datatype configuration to a string
-	std::string getDT() {
+	std::string getDT() const {
 		std::stringstream DTstream;
 		DTstream << "-- SORN datatype:" << "\t\t";
 		for (size_t b = 0; b < sornDT.size(); b++) {
@@ -648,39 +452,137 @@ public:
 	}
 
 	// getBits: returns the binary representation of a SORN value using bitset class (note: displayed from max downto 0 when using << operator)
-	std::bitset<sornBits> getBits() {
-		std::bitset<sornBits> raw_bits;
-		for (size_t b = 0; b < sornBits; b++) {
-			if ((sornIntVal.lowerBound == sornDT[b].lowerBound && sornIntVal.lowerIsOpen == sornDT[b].lowerIsOpen) ||
-				(sornIntVal.upperBound == sornDT[b].upperBound && sornIntVal.upperIsOpen == sornDT[b].upperIsOpen)) {
-				raw_bits[b] = 0b1;
+	bits_type getBits() const noexcept { return _bits; }
+
+private:
+	bits_type _bits;
+
+	static constexpr size_t nrNegative = (flagNeg ? (sornBits - (flagZero ? 1 : 0)) / 2 : 0);
+
+	// precomputed results of every pair of lattice intervals: entry [i * sornBits + j] is the set that covers interval i op interval j
+	struct OpTables {
+		std::array<bits_type, sornBits * sornBits> add, sub, mul, div;
+		std::array<bits_type, sornBits> neg, abs;
+	};
+
+	static const OpTables& tables() {
+		static OpTables t;
+		static const bool initialized = buildTables(t);
+		(void)initialized;
+		return t;
+	}
+
+	static bool buildTables(OpTables& t) {
+		for (size_t i = 0; i < sornBits; ++i) {
+			t.neg[i] = cover(sornNeg(sornDT[i]));
+			t.abs[i] = cover(sornAbs(sornDT[i]));
+			for (size_t j = 0; j < sornBits; ++j) {
+				t.add[i * sornBits + j] = cover(sornAdd(sornDT[i], sornDT[j]));
+				t.sub[i * sornBits + j] = cover(sornSub(sornDT[i], sornDT[j]));
+				t.mul[i * sornBits + j] = cover(sornMul(sornDT[i], sornDT[j]));
+				t.div[i * sornBits + j] = cover(sornDiv(sornDT[i], sornDT[j]));
 			}
-			else {
-				raw_bits[b] = 0b0;
+		}
+		return true;
+	}
+
+	// visit the index of every set bit
+	template<typename Visitor>
+	static void forEachBit(const bits_type& bits, Visitor&& visit) {
+		if constexpr (sornBits <= 64) {
+			for (std::uint64_t w = bits.to_ullong(); w != 0; w &= w - 1) visit(static_cast<size_t>(std::countr_zero(w)));
+		}
+		else {
+			const bits_type word(~std::uint64_t(0));
+			for (size_t base = 0; base < sornBits; base += 64) {
+				for (std::uint64_t w = ((bits >> base) & word).to_ullong(); w != 0; w &= w - 1) visit(base + static_cast<size_t>(std::countr_zero(w)));
 			}
 		}
-		return raw_bits;
 	}
 
-private:
-	template<signed int _sstart, signed int _sstop, unsigned int _ssteps, bool _llin, bool _hhalfopen, bool _nneg, bool _iinf, bool _zzero>
-	friend bool operator!=(const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>& lhs, const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>&);
+	// union of the table rows of all pairs of set bits
+	static bits_type combine(const std::array<bits_type, sornBits * sornBits>& table, const bits_type& a, const bits_type& b) {
+		bits_type result;
+		forEachBit(a, [&](size_t i) {
+			const bits_type* row = &table[i * sornBits];
+			forEachBit(b, [&](size_t j) { result |= row[j]; });
+		});
+		return result;
+	}
+
+	// union of the table entries of all set bits
+	static bits_type map(const std::array<bits_type, sornBits>& table, const bits_type& a) {
+		bits_type result;
+		forEachBit(a, [&](size_t i) { result |= table[i]; });
+		return result;
+	}
+
+	// operations with a native scalar use the exact scalar, not its lattice interval
+	template<typename Kernel>
+	sorn& applyScalar(Kernel kernel, Real rhs) {
+		SORN_INTERVAL point{ rhs, rhs, false, false };
+		bits_type result;
+		forEachBit(_bits, [&](size_t i) { result |= cover(kernel(sornDT[i], point)); });
+		_bits = result;
+		return *this;
+	}
+
+	// assign: binary search for the lattice interval that holds rhs, saturating to the outermost intervals
+	sorn& assign(float rhs) {
+		_bits.reset();
+		if (rhs != rhs) return *this;
+		size_t lo = 0, hi = sornBits - 1;
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			const SORN_INTERVAL& d = sornDT[mid];
+			if (rhs < d.upperBound || (rhs == d.upperBound && not d.upperIsOpen)) hi = mid; else lo = mid + 1;
+		}
+		const SORN_INTERVAL& d = sornDT[lo];
+		if (rhs > d.lowerBound || (rhs == d.lowerBound && not d.lowerIsOpen) || lo == 0) _bits.set(lo);
+		return *this;
+	}
 
-	template<signed int _sstart, signed int _sstop, unsigned int _ssteps, bool _llin, bool _hhalfopen, bool _nneg, bool _iinf, bool _zzero>
-	friend std::ostream& operator<<(std::ostream&, const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>&);
+	size_t lowestBit() const noexcept {
+		for (size_t b = 0; b < sornBits; ++b) if (_bits.test(b)) return b;
+		return 0;
+	}
+	size_t highestBit() const noexcept {
+		for (size_t b = sornBits; b-- > 0; ) if (_bits.test(b)) return b;
+		return 0;
+	}
 
 }; // end class sorn
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
-inline bool operator!=(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) { 
-	return false; 
+inline bool operator==(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return lhs.getBits() == rhs.getBits();
+}
+
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+inline bool operator!=(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return !operator==(lhs, rhs);
 }
 
+// write to output: every run of consecutive lattice intervals prints as one interval
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
-inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs) { 
-	return ostr << "[ " << lhs.minVal() << ", " << lhs.maxVal() << "]";
+inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& s) {
+	using Sorn = sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>;
+	auto bits = s.getBits();
+	if (bits.none()) return ostr << "{}";
+	std::stringstream str;
+	bool first = true;
+	for (size_t b = 0; b < Sorn::sornBits; ++b) {
+		if (!bits.test(b)) continue;
+		size_t e = b;
+		while (e + 1 < Sorn::sornBits && bits.test(e + 1)) ++e;
+		typename Sorn::SORN_INTERVAL run{ Sorn::sornDT[b].lowerBound, Sorn::sornDT[e].upperBound, Sorn::sornDT[b].lowerIsOpen, Sorn::sornDT[e].upperIsOpen };
+		str << (first ? "" : " U ") << run.getInt();
+		first = false;
+		b = e;
+	}
+	return ostr << str.str();
 }
 
 
@@ -690,44 +592,44 @@ inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _
 
 // sorn + sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-																		   sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+                                                                           const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + int
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + float
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + double
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // int + sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
 // float + sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
 // double + sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
@@ -738,44 +640,44 @@ sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (doubl
 
 // sorn - sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+                                                                           const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - int
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - float
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - double
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // int - sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
 	return dif += lhs;
 }
 // float - sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
 	return dif += lhs;
 }
 // double - sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
 	return dif += lhs;
 }
@@ -786,48 +688,78 @@ sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (doubl
 
 // sorn * sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+                                                                           const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * int
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * float
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * double
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // int * sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 // float * sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 // double * sorn
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 
+//////////////////////////////////////////
+////////// two operand division //////////
+//////////////////////////////////////////
+
+// sorn / sorn
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+                                                                           const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / int
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / float
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / double
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+
 ///////////////////////////////////////////
 ////////// arithmetic operations //////////
 ///////////////////////////////////////////
@@ -843,17 +775,18 @@ template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1
 sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> hypot(sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> lhs,
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> rhs) {
 	using std::sqrt;
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> res, lhsAbs, rhsAbs;
+	using Sorn = sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>;
 	// take abs value of inputs
-	lhsAbs = lhs.abs();
-	rhsAbs = rhs.abs();
+	typename Sorn::SORN_INTERVAL lhsAbs = lhs.abs().interval();
+	typename Sorn::SORN_INTERVAL rhsAbs = rhs.abs().interval();
 	// carry out hypot on the abs values of the inputs
-	res.sornIntVal.lowerBound = sqrt(lhsAbs.sornIntVal.lowerBound * lhsAbs.sornIntVal.lowerBound + rhsAbs.sornIntVal.lowerBound * rhsAbs.sornIntVal.lowerBound);
-	res.sornIntVal.upperBound = sqrt(lhsAbs.sornIntVal.upperBound * lhsAbs.sornIntVal.upperBound + rhsAbs.sornIntVal.upperBound * rhsAbs.sornIntVal.upperBound);
-	res.sornIntVal.lowerIsOpen = lhsAbs.sornIntVal.lowerIsOpen || rhsAbs.sornIntVal.lowerIsOpen;
-	res.sornIntVal.upperIsOpen = lhsAbs.sornIntVal.upperIsOpen || rhsAbs.sornIntVal.upperIsOpen;
-	res.adaptToDT();
-	return res;
+	typename Sorn::SORN_INTERVAL h;
+	h.lowerBound  = sqrt(lhsAbs.lowerBound * lhsAbs.lowerBound + rhsAbs.lowerBound * rhsAbs.lowerBound);
+	h.upperBound  = sqrt(lhsAbs.upperBound * lhsAbs.upperBound + rhsAbs.upperBound * rhsAbs.upperBound);
+	h.lowerIsOpen = lhsAbs.lowerIsOpen || rhsAbs.lowerIsOpen;
+	h.upperIsOpen = lhsAbs.upperIsOpen || rhsAbs.upperIsOpen;
+	Sorn res;
+	return res.setBits(Sorn::cover(h));
 }
 
 }} // end namespace sw::universal
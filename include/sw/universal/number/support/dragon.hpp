@@ -25,7 +25,10 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 #include <universal/number/support/decimal.hpp>
 
 namespace sw { namespace universal {
@@ -457,6 +460,246 @@ inline std::string to_decimal_string(bool sign, int scale, const support::decima
 	return format_decimal_string(sign, digits, decimal_exp, ctx);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// Shortest round-trip digits for an explicit rounding interval
+//
+// The routines above work on support::decimal and assume the rounding interval of an
+// IEEE-like format. shortest() takes the value and both boundaries of its rounding
+// interval as dyadic numbers, so tapered and other irregular encodings are handled
+// exactly, and runs the free-format algorithm of Steele & White (as refined by Burger &
+// Dybvig) on binary limbs. It is the exact fallback of support/shortest.hpp.
+
+// m * 2^exponent, with m = hi * 2^64 + lo
+struct dyadic {
+	std::uint64_t hi{ 0 };
+	std::uint64_t lo{ 0 };
+	int           exponent{ 0 };
+};
+
+// d[0].d[1]...d[length-1] * 10^exponent, digits as characters
+struct decimal_digits {
+	char     digits[48]{};
+	unsigned length{ 0 };
+	int      exponent{ 0 };
+};
+
+// unsigned integer in base 2^32 limbs, least significant limb first
+class bignum {
+public:
+	bignum() = default;
+	bignum(std::uint64_t hi, std::uint64_t lo) {
+		_limb = { static_cast<std::uint32_t>(lo), static_cast<std::uint32_t>(lo >> 32),
+		          static_cast<std::uint32_t>(hi), static_cast<std::uint32_t>(hi >> 32) };
+		trim();
+	}
+
+	bool iszero() const noexcept { return _limb.empty(); }
+	unsigned bit_length() const noexcept {
+		if (_limb.empty()) return 0;
+		unsigned top = 32;
+		while (!(_limb.back() >> (top - 1))) --top;
+		return static_cast<unsigned>(_limb.size() - 1) * 32 + top;
+	}
+
+	void shift_left(unsigned n) {
+		if (_limb.empty() || n == 0) return;
+		unsigned words = n / 32, bits = n % 32;
+		if (bits) {
+			std::uint32_t carry = 0;
+			for (auto& l : _limb) {
+				std::uint32_t next = l >> (32 - bits);
+				l = (l << bits) | carry;
+				carry = next;
+			}
+			if (carry) _limb.push_back(carry);
+		}
+		_limb.insert(_limb.begin(), words, 0u);
+	}
+
+	void mul_small(std::uint32_t m) {
+		std::uint64_t carry = 0;
+		for (auto& l : _limb) {
+			std::uint64_t p = static_cast<std::uint64_t>(l) * m + carry;
+			l = static_cast<std::uint32_t>(p);
+			carry = p >> 32;
+		}
+		if (carry) _limb.push_back(static_cast<std::uint32_t>(carry));
+	}
+
+	void mul_pow10(unsigned n) {
+		constexpr std::uint32_t pow10[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u };
+		for (; n >= 9; n -= 9) mul_small(pow10[9]);
+		if (n) mul_small(pow10[n]);
+	}
+
+	void add(const bignum& rhs) {
+		if (_limb.size() < rhs._limb.size()) _limb.resize(rhs._limb.size(), 0u);
+		std::uint64_t carry = 0;
+		for (std::size_t i = 0; i < _limb.size(); ++i) {
+			std::uint64_t s = static_cast<std::uint64_t>(_limb[i]) + (i < rhs._limb.size() ? rhs._limb[i] : 0u) + carry;
+			_limb[i] = static_cast<std::uint32_t>(s);
+			carry = s >> 32;
+			if (!carry && i >= rhs._limb.size()) break;
+		}
+		if (carry) _limb.push_back(1u);
+	}
+
+	// requires *this >= rhs
+	void sub(const bignum& rhs) {
+		std::int64_t borrow = 0;
+		for (std::size_t i = 0; i < _limb.size(); ++i) {
+			std::int64_t d = static_cast<std::int64_t>(_limb[i]) - (i < rhs._limb.size() ? rhs._limb[i] : 0u) - borrow;
+			borrow = d < 0 ? 1 : 0;
+			_limb[i] = static_cast<std::uint32_t>(d + (borrow << 32));
+			if (!borrow && i >= rhs._limb.size()) break;
+		}
+		trim();
+	}
+
+	friend int compare(const bignum& a, const bignum& b) noexcept {
+		if (a._limb.size() != b._limb.size()) return a._limb.size() < b._limb.size() ? -1 : 1;
+		for (std::size_t i = a._limb.size(); i-- > 0;) {
+			if (a._limb[i] != b._limb[i]) return a._limb[i] < b._limb[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	// divide by d in place and return the remainder
+	std::uint32_t div_small(std::uint32_t d) noexcept {
+		std::uint64_t rem = 0;
+		for (std::size_t i = _limb.size(); i-- > 0;) {
+			std::uint64_t cur = (rem << 32) | _limb[i];
+			_limb[i] = static_cast<std::uint32_t>(cur / d);
+			rem = cur % d;
+		}
+		trim();
+		return static_cast<std::uint32_t>(rem);
+	}
+
+	// replace *this by *this mod s and return the quotient, which must be less than 2^32
+	std::uint32_t divmod(const bignum& s) {
+		if (compare(*this, s) < 0) return 0;
+		// estimate the quotient from the leading 64 bits, never above the true quotient; when both
+		// fit in 64 bits the estimate is exact
+		unsigned shift = bit_length() > 64 ? bit_length() - 64 : 0;
+		std::uint64_t r64 = top_bits(shift), s64 = s.top_bits(shift) + (shift > 0 ? 1 : 0);
+		std::uint32_t q = static_cast<std::uint32_t>(r64 / s64);
+		if (q > 0) {
+			bignum qs = s;
+			qs.mul_small(q);
+			sub(qs);
+		}
+		while (compare(*this, s) >= 0) {
+			sub(s);
+			++q;
+		}
+		return q;
+	}
+
+private:
+	std::vector<std::uint32_t> _limb;
+
+	void trim() noexcept { while (!_limb.empty() && _limb.back() == 0) _limb.pop_back(); }
+
+	// bits [shift, shift + 64) as an integer
+	std::uint64_t top_bits(unsigned shift) const noexcept {
+		std::uint64_t v = 0;
+		for (unsigned i = 0; i < 64; i += 32) {
+			unsigned bit = shift + i;
+			std::size_t w = bit / 32;
+			std::uint64_t chunk = 0;
+			if (w < _limb.size()) chunk = _limb[w] >> (bit % 32);
+			if (bit % 32 && w + 1 < _limb.size()) chunk |= static_cast<std::uint64_t>(_limb[w + 1]) << (32 - bit % 32);
+			v |= (chunk & 0xFFFF'FFFFull) << i;
+		}
+		return v;
+	}
+};
+
+// Shortest decimal in the rounding interval [low, high] of v, closest to v among the shortest,
+// ties to an even last digit. The boundaries are included when inclusive is set, which is the
+// case when a tie rounds to v. Requires 0 < low < v < high.
+inline decimal_digits shortest(const dyadic& v, const dyadic& low, const dyadic& high, bool inclusive) {
+	int e = std::min(v.exponent, std::min(low.exponent, high.exponent));
+	bignum r(v.hi, v.lo), lo(low.hi, low.lo), hi(high.hi, high.lo);
+	r.shift_left(static_cast<unsigned>(v.exponent - e));
+	lo.shift_left(static_cast<unsigned>(low.exponent - e));
+	hi.shift_left(static_cast<unsigned>(high.exponent - e));
+
+	// r/s is the value, mm/s and mp/s the distances to the boundaries
+	bignum mm = r; mm.sub(lo);
+	bignum mp = hi; mp.sub(r);
+	bignum s(0, 1);
+	if (e >= 0) {
+		r.shift_left(static_cast<unsigned>(e));
+		mm.shift_left(static_cast<unsigned>(e));
+		mp.shift_left(static_cast<unsigned>(e));
+	}
+	else {
+		s.shift_left(static_cast<unsigned>(-e));
+	}
+
+	// k is the smallest integer with high < 10^k (high <= 10^k when the boundary is excluded)
+	int k = static_cast<int>(std::ceil((static_cast<int>(hi.bit_length()) - 1 + e) * 0.30102999566398114)) - 1;
+	if (k >= 0) s.mul_pow10(static_cast<unsigned>(k));
+	else {
+		r.mul_pow10(static_cast<unsigned>(-k));
+		mm.mul_pow10(static_cast<unsigned>(-k));
+		mp.mul_pow10(static_cast<unsigned>(-k));
+	}
+	auto above = [&](const bignum& x, const bignum& y, const bignum& z) {
+		bignum sum = x; sum.add(y);
+		int c = compare(sum, z);
+		return inclusive ? c >= 0 : c > 0;
+	};
+	while (above(r, mp, s)) {
+		s.mul_small(10);
+		++k;
+	}
+
+	decimal_digits result;
+	result.exponent = k - 1;
+	for (;;) {
+		r.mul_small(10);
+		mm.mul_small(10);
+		mp.mul_small(10);
+		std::uint32_t d = r.divmod(s);
+		int cmpLow = compare(r, mm);
+		bool low_ok = inclusive ? cmpLow <= 0 : cmpLow < 0;
+		bool high_ok = above(r, mp, s);
+		// a 128-bit significand needs at most 40 digits; should the buffer still fill up,
+		// its last slot takes a final digit rounded to nearest
+		bool full = result.length + 1 == sizeof(result.digits);
+		if (!low_ok && !high_ok && !full) {
+			result.digits[result.length++] = static_cast<char>('0' + d);
+			continue;
+		}
+		if (low_ok == high_ok) {
+			bignum twice = r; twice.add(r);
+			int c = compare(twice, s);
+			if (c > 0 || (c == 0 && (d & 1u))) ++d;
+		}
+		else if (high_ok) {
+			++d;
+		}
+		result.digits[result.length++] = static_cast<char>('0' + d);
+		break;
+	}
+	// a final digit rounded up to ten carries into the prefix
+	for (unsigned i = result.length; i-- > 0 && result.digits[i] > '9';) {
+		result.digits[i] = '0';
+		if (i == 0) {
+			result.digits[0] = '1';
+			++result.exponent;
+		}
+		else {
+			++result.digits[i - 1];
+		}
+	}
+	while (result.length > 1 && result.digits[result.length - 1] == '0') --result.length;
+	return result;
+}
+
 } // namespace dragon
 
 }} // namespace sw::universal
@@ -0,0 +1,464 @@
+#pragma once
+// eisel_lemire.hpp: correctly rounded decimal to binary conversion for Universal number encodings
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The per-type parse() functions used to build the decimal as an exact rational in a 2048-bit
+// integer (utility/decimal_to_binary.hpp) for every input. This engine does what std::from_chars
+// does for double: the first 19 significant digits w and the decimal exponent q are multiplied
+// by a 128-bit approximation of 5^q (Daniel Lemire, "Number Parsing at a Gigabyte per Second",
+// after Michael Eisel), and the product fixes the leading bits of w * 10^q unless it lands
+// within the approximation error of a carry. Those rare inputs, digit strings whose truncation
+// matters, and exponents beyond the table take an exact path on dragon::bignum.
+//
+// The engine does not round to the target. It delivers w * 10^q rounded to odd at P or more
+// bits: the leading bits, with the last one set when anything nonzero was cut off. Rounding such
+// a value once more, to a format with at most P - 2 significand bits, gives the same result as
+// rounding the exact decimal, for round-to-nearest-even and for the bit-string rounding of
+// posits, whose decision points are also dyadic numbers of at most P - 2 bits. The number type
+// then rounds with its own convert(blocktriple, v); see number/posit/from_chars.hpp and
+// number/cfloat/from_chars.hpp. Because only P bits have to be right, the approximation error
+// of 5^q sends an input to the exact path only when it carries into those P bits; P up to 128
+// takes the fast path.
+//
+// Accepted syntax is that of std::from_chars with chars_format::general: an optional '-', digits
+// with an optional decimal point, an optional exponent, and inf, infinity, nan and nan(...) in
+// any case. nar is accepted as a spelling of NaN.
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <universal/internal/blocktype/carry.hpp>
+#include <universal/internal/blocktriple/blocktriple.hpp>
+#include <universal/number/support/dragon.hpp>
+
+namespace sw { namespace universal {
+
+namespace eisel_lemire {
+
+	enum class kind { finite, infinite, nan };
+
+	// (-1)^negative * w * 10^q; w holds the first 19 significant digits and truncated is set when
+	// nonzero digits followed. mantissa spans the digits and decimal point for the exact path.
+	struct decimal_number {
+		bool          negative{ false };
+		kind          type{ kind::finite };
+		std::uint64_t w{ 0 };
+		int           q{ 0 };
+		bool          truncated{ false };
+		const char*   mantissa_first{ nullptr };
+		const char*   mantissa_last{ nullptr };
+		int           exponent{ 0 };    // the explicit exponent, for the exact path
+	};
+
+	// The value rounded to odd at P or more bits: sig[0] holds the most significant bits, its MSB
+	// is set, and value = 1.xxx * 2^scale
+	template<unsigned P>
+	struct rounded_to_odd {
+		static constexpr unsigned words = (P + 63) / 64;
+		std::array<std::uint64_t, words> sig{};
+		int scale{ 0 };
+	};
+
+	// decimal exponents beyond this make every Universal type overflow or underflow
+	constexpr int max_decimal_exponent = 1'000'000;
+
+	namespace detail {
+
+		inline bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+		inline bool match(const char*& p, const char* last, const char* word) noexcept {
+			const char* s = p;
+			for (; *word != 0; ++word, ++s) {
+				if (s == last || (*s | 0x20) != *word) return false;
+			}
+			p = s;
+			return true;
+		}
+
+		// floor(n / m * 2^(bits - 1 - scale)) in 32-bit chunks, most significant first, with the
+		// binary exponent scale of its leading bit; returns whether the remainder is nonzero
+		inline bool leading_bits(dragon::bignum n, dragon::bignum m, std::uint32_t* chunks, unsigned nrChunks, int& scale) {
+			int shift = static_cast<int>(n.bit_length()) - static_cast<int>(m.bit_length());
+			if (shift > 0) m.shift_left(static_cast<unsigned>(shift));
+			else n.shift_left(static_cast<unsigned>(-shift));
+			if (compare(n, m) < 0) {
+				n.shift_left(1);
+				--shift;
+			}
+			scale = shift;
+			n.sub(m);                          // the leading 1
+			n.shift_left(31);
+			chunks[0] = 0x8000'0000u | n.divmod(m);
+			for (unsigned i = 1; i < nrChunks; ++i) {
+				n.shift_left(32);
+				chunks[i] = n.divmod(m);
+			}
+			return !n.iszero();
+		}
+
+		// 5^q ~ (hi * 2^64 + lo) * 2^exponent, truncated, with the MSB of hi set
+		struct power_of_five {
+			std::uint64_t hi, lo;
+			int           exponent;
+		};
+		constexpr int min_table_exponent = -400;
+		constexpr int max_table_exponent = 400;
+
+		inline const power_of_five& pow5(int q) {
+			static const std::vector<power_of_five> table = [] {
+				std::vector<power_of_five> t;
+				t.reserve(max_table_exponent - min_table_exponent + 1);
+				dragon::bignum one(0, 1);
+				dragon::bignum p5(0, 1);
+				std::vector<dragon::bignum> negative(static_cast<std::size_t>(-min_table_exponent) + 1);
+				std::vector<dragon::bignum> positive(static_cast<std::size_t>(max_table_exponent) + 1);
+				for (int i = 0; i <= std::max(-min_table_exponent, max_table_exponent); ++i) {
+					if (i <= -min_table_exponent) negative[static_cast<std::size_t>(i)] = p5;
+					if (i <= max_table_exponent) positive[static_cast<std::size_t>(i)] = p5;
+					p5.mul_small(5);
+				}
+				for (int q = min_table_exponent; q <= max_table_exponent; ++q) {
+					std::uint32_t c[4];
+					int scale;
+					if (q >= 0) leading_bits(positive[static_cast<std::size_t>(q)], one, c, 4, scale);
+					else leading_bits(one, negative[static_cast<std::size_t>(-q)], c, 4, scale);
+					t.push_back({ (std::uint64_t(c[0]) << 32) | c[1], (std::uint64_t(c[2]) << 32) | c[3], scale - 127 });
+				}
+				return t;
+			}();
+			return table[static_cast<std::size_t>(q - min_table_exponent)];
+		}
+
+		struct u128 {
+			std::uint64_t hi, lo;
+		};
+		inline u128 mul64(std::uint64_t a, std::uint64_t b) noexcept {
+			u128 p;
+			mul128(a, b, p.lo, p.hi);
+			return p;
+		}
+
+		constexpr std::uint64_t pow5_u64[28] = {
+			1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull, 390625ull, 1953125ull, 9765625ull,
+			48828125ull, 244140625ull, 1220703125ull, 6103515625ull, 30517578125ull, 152587890625ull,
+			762939453125ull, 3814697265625ull, 19073486328125ull, 95367431640625ull, 476837158203125ull,
+			2384185791015625ull, 11920928955078125ull, 59604644775390625ull, 298023223876953125ull,
+			1490116119384765625ull, 7450580596923828125ull
+		};
+
+		// The leading 128 bits of w * 10^q for w != 0, normalized, and whether nonzero bits follow.
+		// The table truncates 5^q, so unless the product is exact the true leading bits exceed sig
+		// by up to slack units in the last place.
+		inline void product(std::uint64_t w, int q, u128& sig, bool& sticky, unsigned& slack, int& scale) {
+			if (q < 0 && -q < 28 && w % pow5_u64[-q] == 0) {
+				// w / 5^-q is an integer: the value is exact
+				std::uint64_t m = w / pow5_u64[-q];
+				int lz = std::countl_zero(m);
+				sig = { m << lz, 0 };
+				sticky = false;
+				slack = 0;
+				scale = q + 63 - lz;
+				return;
+			}
+			int lz = std::countl_zero(w);
+			std::uint64_t wn = w << lz;
+			const power_of_five& t = pow5(q);
+			u128 low = mul64(wn, t.lo), high = mul64(wn, t.hi);
+			std::uint64_t b0 = low.lo;
+			std::uint64_t b1 = low.hi + high.lo;
+			std::uint64_t b2 = high.hi + (b1 < low.hi ? 1 : 0);
+			bool exact = q >= 0 && q <= 55;    // the table holds 5^q itself
+			int top = 191;
+			if ((b2 >> 63) == 0) {
+				b2 = (b2 << 1) | (b1 >> 63);
+				b1 = (b1 << 1) | (b0 >> 63);
+				b0 <<= 1;
+				top = 190;
+			}
+			// the error is below 2 * wn < 2^65 units of b0, so at most 2 in the last place of sig;
+			// w * 5^q for q < 0 or q > 55 has more than 128 significant bits, so bits beyond sig are set
+			sig = { b2, b1 };
+			sticky = exact ? b0 != 0 : true;
+			slack = exact ? 0 : 2;
+			scale = top + t.exponent + q - lz;
+		}
+
+		// sig rounded to odd at bits <= 128 places; false when adding slack to sig could change it
+		inline bool round_to_odd(u128& sig, bool sticky, unsigned slack, unsigned bits) {
+			unsigned drop = 128 - bits;
+			// the result is floor(sig / 2^(drop + 1)) and a last bit that sticky, or any of the
+			// dropped bits, sets: it is certain unless slack carries out of the low drop + 1 bits
+			unsigned m = drop + 1;
+			if (slack > 0) {
+				if (m <= 64) {
+					std::uint64_t mask = m == 64 ? ~0ull : (1ull << m) - 1;
+					if ((sig.lo & mask) + slack > mask) return false;
+				}
+				else {
+					std::uint64_t mask = (1ull << (m - 64)) - 1;
+					if (sig.lo + slack < sig.lo && (sig.hi & mask) == mask) return false;
+				}
+			}
+			if (drop == 0) {
+				if (sticky) sig.lo |= 1;
+			}
+			else if (drop < 64) {
+				std::uint64_t cut = sig.lo & ((1ull << drop) - 1);
+				sig.lo &= ~((1ull << drop) - 1);
+				if (sticky || cut != 0) sig.lo |= 1ull << drop;
+			}
+			else {
+				std::uint64_t mask = (1ull << (drop - 64)) - 1;
+				bool cut = (sig.hi & mask) != 0 || sig.lo != 0;
+				sig.hi &= ~mask;
+				sig.lo = 0;
+				if (sticky || cut) sig.hi |= 1ull << (drop - 64);
+			}
+			return true;
+		}
+
+		inline bool fast_path(const decimal_number& d, unsigned bits, u128& sig, int& scale) {
+			if (d.q < min_table_exponent || d.q > max_table_exponent) return false;
+			bool sticky;
+			unsigned slack;
+			product(d.w, d.q, sig, sticky, slack, scale);
+			if (!round_to_odd(sig, sticky, slack, bits)) return false;
+			if (d.truncated) {
+				// the value lies strictly between w and w + 1 times 10^q, so it is the common
+				// rounding of both with the last bit set, when they have one
+				u128 upper;
+				int upperScale;
+				product(d.w + 1, d.q, upper, sticky, slack, upperScale);
+				if (!round_to_odd(upper, sticky, slack, bits)) return false;
+				unsigned drop = 128 - bits;
+				u128 last = drop < 64 ? u128{ 0, 1ull << drop } : u128{ 1ull << (drop - 64), 0 };
+				sig.hi |= last.hi;
+				sig.lo |= last.lo;
+				if (upperScale != scale || (upper.hi | last.hi) != sig.hi || (upper.lo | last.lo) != sig.lo) return false;
+			}
+			return true;
+		}
+
+		// exact conversion of all digits
+		template<unsigned P>
+		void exact_path(const decimal_number& d, rounded_to_odd<P>& r) {
+			dragon::bignum n;
+			int fractionDigits = 0;
+			bool fraction = false;
+			std::uint32_t chunk = 0;
+			unsigned chunkDigits = 0;
+			for (const char* p = d.mantissa_first; p != d.mantissa_last; ++p) {
+				if (*p == '.') {
+					fraction = true;
+					continue;
+				}
+				if (fraction) ++fractionDigits;
+				chunk = chunk * 10 + static_cast<std::uint32_t>(*p - '0');
+				if (++chunkDigits == 9) {
+					n.mul_pow10(9);
+					n.add(dragon::bignum(0, chunk));
+					chunk = 0;
+					chunkDigits = 0;
+				}
+			}
+			if (chunkDigits) {
+				n.mul_pow10(chunkDigits);
+				n.add(dragon::bignum(0, chunk));
+			}
+			int q = d.exponent - fractionDigits;
+			dragon::bignum m(0, 1);
+			if (q >= 0) n.mul_pow10(static_cast<unsigned>(q));
+			else m.mul_pow10(static_cast<unsigned>(-q));
+			constexpr unsigned words = rounded_to_odd<P>::words;
+			std::array<std::uint32_t, 2 * words> chunks{};
+			bool sticky = leading_bits(n, m, chunks.data(), 2 * words, r.scale);
+			for (unsigned i = 0; i < words; ++i) r.sig[i] = (std::uint64_t(chunks[2 * i]) << 32) | chunks[2 * i + 1];
+			if (sticky) r.sig[words - 1] |= 1;
+		}
+
+	} // namespace detail
+
+	// Scan a decimal the way std::from_chars does; ec is invalid_argument when no number starts
+	// at first, and ptr points past the last character used.
+	inline std::from_chars_result scan(const char* first, const char* last, decimal_number& d) noexcept {
+		d = decimal_number{};
+		const char* p = first;
+		if (p != last && *p == '-') {
+			d.negative = true;
+			++p;
+		}
+		if (p != last && !detail::is_digit(*p) && *p != '.') {
+			if (detail::match(p, last, "inf")) {
+				detail::match(p, last, "inity");
+				d.type = kind::infinite;
+				return { p, std::errc{} };
+			}
+			if (detail::match(p, last, "nan")) {
+				d.type = kind::nan;
+				if (p != last && *p == '(') {
+					const char* s = p + 1;
+					while (s != last && (detail::is_digit(*s) || ((*s | 0x20) >= 'a' && (*s | 0x20) <= 'z') || *s == '_')) ++s;
+					if (s != last && *s == ')') p = s + 1;
+				}
+				return { p, std::errc{} };
+			}
+			if (detail::match(p, last, "nar")) {
+				d.type = kind::nan;
+				return { p, std::errc{} };
+			}
+			return { first, std::errc::invalid_argument };
+		}
+
+		d.mantissa_first = p;
+		int significant = 0;       // significant digits seen
+		int adjust = 0;            // decimal exponent of the last digit kept in w
+		bool anyDigit = false;
+		bool fraction = false;
+		for (; p != last; ++p) {
+			char c = *p;
+			if (c == '.') {
+				if (fraction) break;
+				fraction = true;
+				continue;
+			}
+			if (!detail::is_digit(c)) break;
+			anyDigit = true;
+			if (significant == 0 && c == '0') {
+				if (fraction) --adjust;
+				continue;
+			}
+			if (significant < 19) {
+				d.w = d.w * 10 + static_cast<std::uint64_t>(c - '0');
+				++significant;
+				if (fraction) --adjust;
+			}
+			else {
+				if (c != '0') d.truncated = true;
+				if (!fraction) ++adjust;
+			}
+		}
+		if (!anyDigit) return { first, std::errc::invalid_argument };
+		d.mantissa_last = p;
+
+		if (p != last && (*p | 0x20) == 'e') {
+			const char* s = p + 1;
+			bool negativeExponent = false;
+			if (s != last && (*s == '+' || *s == '-')) {
+				negativeExponent = *s == '-';
+				++s;
+			}
+			if (s != last && detail::is_digit(*s)) {
+				int e = 0;
+				for (; s != last && detail::is_digit(*s); ++s) {
+					if (e < max_decimal_exponent * 10) e = e * 10 + (*s - '0');
+				}
+				d.exponent = negativeExponent ? -e : e;
+				p = s;
+			}
+		}
+		d.q = d.exponent + adjust;
+		return { p, std::errc{} };
+	}
+
+	// P bits of the nonzero finite value d rounded to odd; false when d is zero
+	template<unsigned P>
+	bool to_binary(const decimal_number& d, rounded_to_odd<P>& r) {
+		if (d.w == 0) return false;
+		if (d.q > max_decimal_exponent || d.q < -max_decimal_exponent) {
+			// far outside the range of any type: 1 * 2^(+-large)
+			r.sig = {};
+			r.sig[0] = 1ull << 63;
+			r.sig[rounded_to_odd<P>::words - 1] |= 1;
+			r.scale = d.q > 0 ? 4 * max_decimal_exponent : -4 * max_decimal_exponent;
+			return true;
+		}
+		if constexpr (P <= 128) {
+			detail::u128 sig;
+			int scale;
+			if (detail::fast_path(d, P, sig, scale)) {
+				r.sig[0] = sig.hi;
+				if constexpr (P > 64) r.sig[1] = sig.lo;
+				r.scale = scale;
+				return true;
+			}
+		}
+		detail::exact_path(d, r);
+		return true;
+	}
+
+	// Load the value into a blocktriple whose radix bits below the hidden bit the number type
+	// rounds from. Bits beyond the triple are folded into its last bit, which keeps the rounding
+	// to odd intact as long as the triple holds at least two bits more than the target.
+	template<typename Triple, unsigned P>
+	void to_triple(bool negative, const rounded_to_odd<P>& r, Triple& t) {
+		constexpr unsigned radix = static_cast<unsigned>(Triple::radix);
+		if constexpr (radix < 64) {
+			std::uint64_t raw = r.sig[0] >> (63 - radix);
+			bool sticky = (r.sig[0] << radix << 1) != 0;
+			for (unsigned i = 1; i < r.words; ++i) sticky = sticky || r.sig[i] != 0;
+			t.set(negative, r.scale, raw | (sticky ? 1u : 0u));
+		}
+		else {
+			t.set(negative, r.scale, 1);
+			for (unsigned i = 0; i <= radix; ++i) {
+				t.setbit(radix - i, i < 64 * r.words && ((r.sig[i / 64] >> (63 - i % 64)) & 1) != 0);
+			}
+			if constexpr (64 * rounded_to_odd<P>::words > radix + 1) {
+				bool sticky = false;
+				for (unsigned i = radix + 1; i < 64 * r.words; ++i) sticky = sticky || ((r.sig[i / 64] >> (63 - i % 64)) & 1) != 0;
+				if (sticky) t.setbit(0);
+			}
+		}
+	}
+
+	// The fbits bits that follow the hidden bit, with the bits beyond folded into the last one.
+	template<typename Significand, unsigned P>
+	void to_fraction(const rounded_to_odd<P>& r, Significand& fraction) {
+		constexpr unsigned fbits = Significand::nbits;
+		fraction.clear();
+		bool sticky = false;
+		for (unsigned i = 1; i < 64 * r.words; ++i) {
+			bool bit = ((r.sig[i / 64] >> (63 - i % 64)) & 1) != 0;
+			if (i <= fbits) fraction.setbit(fbits - i, bit);
+			else sticky = sticky || bit;
+		}
+		if (sticky) fraction.setbit(0);
+	}
+
+	// the precision a type with nbits of encoding needs from the engine
+	constexpr unsigned precision_for(unsigned nbits) noexcept {
+		return nbits + 2;
+	}
+
+} // namespace eisel_lemire
+
+// Parse a column of numbers separated by whitespace, commas or separator into values, which is
+// appended to. Stops at the first token that is not a number, and returns its position with
+// std::errc::invalid_argument; a number followed by other characters is such a token.
+template<typename Number>
+std::from_chars_result from_chars(const char* first, const char* last, std::vector<Number>& values, char separator = ',') {
+	auto isSeparator = [separator](char c) {
+		return c == separator || c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	};
+	const char* p = first;
+	while (true) {
+		while (p != last && isSeparator(*p)) ++p;
+		if (p == last) return { p, std::errc{} };
+		Number v;
+		auto [end, ec] = from_chars(p, last, v);
+		if (ec == std::errc::invalid_argument || (end != last && !isSeparator(*end))) return { p, std::errc::invalid_argument };
+		values.push_back(v);
+		p = end;
+	}
+}
+
+}} // namespace sw::universal
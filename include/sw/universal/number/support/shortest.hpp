@@ -0,0 +1,282 @@
+#pragma once
+// shortest.hpp: shortest round-trip decimal digits for Universal number encodings
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// operator<< prints a blocktriple through the arbitrary-precision support::decimal converter, digit
+// by digit, to a requested precision. This engine produces the shortest decimal that reads back to
+// the same encoding instead, the way std::to_chars does for float and double.
+//
+// Input is the value v and both boundaries of its rounding interval, as dyadic numbers m * 2^e with
+// m up to 128 bits. A number type supplies these from its (sign, scale, significand) triple and its
+// rounding rule; see number/posit/to_chars.hpp and number/cfloat/to_chars.hpp. Two algorithms:
+//
+//   teju    the interval has the shape of a p-bit binary format, p <= 53: half an ulp on both
+//           sides, or a quarter ulp below a power of two, with the tie behavior of round-to-
+//           nearest-even. Cassio Neri's Teju Jagua (support/teju.hpp) produces the digits with
+//           two 128-bit multiplications. This covers the normal and most subnormal cfloats of up
+//           to 53 significand bits, and posits wherever they still have fraction bits.
+//   exact   anything else, including significands wider than 53 bits and the geometric rounding
+//           intervals of posits: the free-format algorithm of Steele & White on binary limbs
+//           (dragon::shortest in support/dragon.hpp).
+//
+// strategy::automatic picks teju when it applies, strategy::exact always runs the exact algorithm.
+// Both return the shortest digit string in the interval and, among those, the one closest to v,
+// ties to an even last digit, so the strategy only affects speed.
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <universal/internal/blocktriple/blocktriple.hpp>
+#include <universal/number/support/teju.hpp>
+#include <universal/number/support/dragon.hpp>
+
+namespace sw { namespace universal {
+
+namespace shortest {
+
+	using dragon::dyadic;
+	using dragon::decimal_digits;
+
+	enum class strategy { automatic, exact };
+
+	// the exact value of a REP blocktriple: significand * 2^(scale - fbits)
+	template<unsigned fbits, typename bt>
+	dyadic dyadic_of(const blocktriple<fbits, BlockTripleOperator::REP, bt>& t) {
+		static_assert(fbits < 128, "shortest supports significands of up to 128 bits");
+		dyadic d;
+		if constexpr (fbits < 64) {
+			d.lo = t.significand_ull();
+		}
+		else {
+			for (unsigned i = 0; i <= fbits; ++i) {
+				if (!t.at(i)) continue;
+				if (i < 64) d.lo |= 1ull << i;
+				else d.hi |= 1ull << (i - 64);
+			}
+		}
+		d.exponent = t.scale() - static_cast<int>(fbits);
+		return d;
+	}
+
+	namespace detail {
+
+		// Express the interval as Teju Jagua's m * 2^e in a p-bit format. Returns false when the
+		// interval does not have that shape or is out of range of the 64-bit tables.
+		inline bool teju_interval(const dyadic& v, const dyadic& low, const dyadic& high, bool inclusive,
+		                          std::uint64_t& m, int& e, unsigned& p) noexcept {
+			if ((v.hi | low.hi | high.hi) != 0) return false;
+			int base = std::min(v.exponent, std::min(low.exponent, high.exponent));
+			unsigned sv = static_cast<unsigned>(v.exponent - base);
+			unsigned sl = static_cast<unsigned>(low.exponent - base);
+			unsigned sh = static_cast<unsigned>(high.exponent - base);
+			if (std::bit_width(v.lo) + sv > 62 || std::bit_width(low.lo) + sl > 62 || std::bit_width(high.lo) + sh > 62) return false;
+			std::uint64_t r = v.lo << sv, l = low.lo << sl, h = high.lo << sh;
+			std::uint64_t up = h - r, down = r - l;
+			unsigned shift;
+			bool centred;
+			if (up == down && std::has_single_bit(up)) {
+				shift = static_cast<unsigned>(std::countr_zero(up)) + 1;   // half an ulp on both sides
+				centred = true;
+			}
+			else if (up == 2 * down && std::has_single_bit(down)) {
+				shift = static_cast<unsigned>(std::countr_zero(down)) + 2; // a quarter ulp below
+				centred = false;
+			}
+			else {
+				return false;
+			}
+			if (r & ((1ull << shift) - 1)) return false;
+			m = r >> shift;
+			e = base + static_cast<int>(shift);
+			p = static_cast<unsigned>(std::bit_width(m));
+			// Teju treats m == 2^(p-1) as the bottom of a binade, and breaks ties toward even m
+			if (std::has_single_bit(m) == centred) return false;
+			if (p > 53 || inclusive != ((m & 1) == 0)) return false;
+			return e > teju::detail::ieee64_config::exponent_min && e <= 971;
+		}
+
+	} // namespace detail
+
+	// Shortest decimal in the rounding interval [low, high] of v, which must satisfy 0 < low < v < high.
+	// The boundaries belong to the interval when inclusive is set.
+	inline decimal_digits to_decimal(const dyadic& v, const dyadic& low, const dyadic& high, bool inclusive,
+	                                 strategy s = strategy::automatic) {
+		std::uint64_t m;
+		int e;
+		unsigned p;
+		if (s == strategy::automatic && detail::teju_interval(v, low, high, inclusive, m, e, p)) {
+			teju::decimal_fp dec = teju::detail::convert64(m, e, p);
+			decimal_digits d;
+			char buf[20];
+			auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), dec.mantissa);
+			d.length = static_cast<unsigned>(end - buf);
+			std::memcpy(d.digits, buf, d.length);
+			d.exponent = dec.exponent + static_cast<int>(d.length) - 1;
+			return d;
+		}
+		return dragon::shortest(v, low, high, inclusive);
+	}
+
+	namespace detail {
+
+		inline int exponent_digits(int x) noexcept {
+			int ax = x < 0 ? -x : x;
+			return ax >= 100 ? (ax >= 1000 ? (ax >= 10000 ? 5 : 4) : 3) : 2;
+		}
+		inline int scientific_length(const decimal_digits& d) noexcept {
+			int n = static_cast<int>(d.length);
+			return n + (n > 1 ? 1 : 0) + 2 + exponent_digits(d.exponent);
+		}
+		inline int plain_length(const decimal_digits& d) noexcept {
+			int n = static_cast<int>(d.length);
+			int x = d.exponent;
+			return x >= n - 1 ? x + 1 : (x >= 0 ? n + 1 : n + 1 - x);
+		}
+
+	} // namespace detail
+
+	// Write the digits the way std::to_chars writes a float or double without a format: plain
+	// notation or scientific with at least two exponent digits, whichever is shorter, plain on a tie.
+	inline std::to_chars_result format(char* first, char* last, bool negative, const decimal_digits& d) noexcept {
+		int n = static_cast<int>(d.length);
+		int x = d.exponent;
+		int ax = x < 0 ? -x : x;
+		int expDigits = detail::exponent_digits(x);
+		int sciLength = detail::scientific_length(d);
+		int fixedLength = detail::plain_length(d);
+		bool fixed = fixedLength <= sciLength;
+		std::ptrdiff_t length = (negative ? 1 : 0) + (fixed ? fixedLength : sciLength);
+		if (last - first < length) return { last, std::errc::value_too_large };
+
+		char* p = first;
+		if (negative) *p++ = '-';
+		if (fixed) {
+			if (x >= n - 1) {
+				std::memcpy(p, d.digits, d.length);
+				p += n;
+				std::memset(p, '0', static_cast<std::size_t>(x - (n - 1)));
+				p += x - (n - 1);
+			}
+			else if (x >= 0) {
+				std::memcpy(p, d.digits, static_cast<std::size_t>(x + 1));
+				p += x + 1;
+				*p++ = '.';
+				std::memcpy(p, d.digits + x + 1, static_cast<std::size_t>(n - x - 1));
+				p += n - x - 1;
+			}
+			else {
+				*p++ = '0';
+				*p++ = '.';
+				std::memset(p, '0', static_cast<std::size_t>(-x - 1));
+				p += -x - 1;
+				std::memcpy(p, d.digits, d.length);
+				p += n;
+			}
+		}
+		else {
+			*p++ = d.digits[0];
+			if (n > 1) {
+				*p++ = '.';
+				std::memcpy(p, d.digits + 1, static_cast<std::size_t>(n - 1));
+				p += n - 1;
+			}
+			*p++ = 'e';
+			*p++ = x < 0 ? '-' : '+';
+			for (int i = expDigits - 1; i >= 0; --i) {
+				p[i] = static_cast<char>('0' + ax % 10);
+				ax /= 10;
+			}
+			p += expDigits;
+		}
+		return { p, std::errc{} };
+	}
+
+	// the decimal digits of v if it is an integer
+	inline bool integer_digits(const dyadic& v, decimal_digits& d) {
+		dragon::bignum n(v.hi, v.lo);
+		if (v.exponent >= 0) {
+			n.shift_left(static_cast<unsigned>(v.exponent));
+		}
+		else {
+			unsigned shift = static_cast<unsigned>(-v.exponent);
+			if (shift >= 128) return false;
+			std::uint64_t lowMask = shift >= 64 ? v.lo : (v.lo & ((1ull << shift) - 1));
+			std::uint64_t highMask = shift > 64 ? (v.hi & ((1ull << (shift - 64)) - 1)) : 0;
+			if (lowMask | highMask) return false;
+			std::uint64_t hi = shift >= 64 ? 0 : (shift == 0 ? v.hi : v.hi >> shift);
+			std::uint64_t lo = shift >= 64 ? v.hi >> (shift - 64) : (shift == 0 ? v.lo : (v.lo >> shift) | (v.hi << (64 - shift)));
+			n = dragon::bignum(hi, lo);
+		}
+		char buf[sizeof(d.digits)];
+		unsigned length = 0;
+		while (!n.iszero()) {
+			if (length + 9 > sizeof(buf)) return false;
+			std::uint32_t chunk = n.div_small(1000000000u);
+			for (int i = 0; i < 9; ++i, chunk /= 10) buf[length++] = static_cast<char>('0' + chunk % 10);
+		}
+		while (length > 1 && buf[length - 1] == '0') --length;
+		for (unsigned i = 0; i < length; ++i) d.digits[i] = buf[length - 1 - i];
+		d.length = length;
+		d.exponent = static_cast<int>(length) - 1;
+		return true;
+	}
+
+	// Shortest representation of the value v with rounding interval [low, high]. Like std::to_chars,
+	// an integer printed in plain notation shows all of its digits rather than padding the shortest
+	// digits with zeros: both are equally short, and the former is exact.
+	inline std::to_chars_result to_chars(char* first, char* last, bool negative, const dyadic& v, const dyadic& low,
+	                                     const dyadic& high, bool inclusive, strategy s = strategy::automatic) {
+		decimal_digits d = to_decimal(v, low, high, inclusive, s);
+		if (d.exponent > static_cast<int>(d.length) - 1 && detail::plain_length(d) <= detail::scientific_length(d)) {
+			// more digits never make scientific notation shorter, so the choice of plain stands
+			decimal_digits exact;
+			if (integer_digits(v, exact) && exact.exponent == d.exponent) d = exact;
+		}
+		return format(first, last, negative, d);
+	}
+
+	// the fixed spellings of the non-finite values and zero
+	inline std::to_chars_result format(char* first, char* last, const char* text) noexcept {
+		std::size_t length = std::strlen(text);
+		if (static_cast<std::size_t>(last - first) < length) return { last, std::errc::value_too_large };
+		std::memcpy(first, text, length);
+		return { first + length, std::errc{} };
+	}
+
+	// no shortest representation is longer than this
+	constexpr std::size_t max_chars = 64;
+
+} // namespace shortest
+
+// Append the shortest round-trip representation of every element to out, each followed by
+// separator. Returns the number of characters appended.
+template<typename Number>
+std::size_t to_chars(std::span<const Number> values, std::string& out, char separator = '\n') {
+	std::size_t start = out.size();
+	out.resize(start + values.size() * (shortest::max_chars + 1));
+	char* p = out.data() + start;
+	char* end = out.data() + out.size();
+	for (const Number& v : values) {
+		p = to_chars(p, end, v).ptr;
+		*p++ = separator;
+	}
+	out.resize(static_cast<std::size_t>(p - out.data()));
+	return out.size() - start;
+}
+
+template<typename Number>
+std::size_t to_chars(const std::vector<Number>& values, std::string& out, char separator = '\n') {
+	return to_chars(std::span<const Number>(values), out, separator);
+}
+
+}} // namespace sw::universal
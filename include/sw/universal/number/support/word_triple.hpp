@@ -0,0 +1,89 @@
+#pragma once
+// word_triple.hpp: exact add, multiply, and divide of (sign, scale, significand) triples in machine words
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The fast paths of cfloat and posit decode their operands into a sign, a binary scale, and a
+// significand with its hidden bit at fbits, all in machine words, and encode the result with their
+// own rounding rule. The arithmetic in between is the same for both and lives here. Every operation
+// returns the result with its leading one at 2^scale and enough bits below the target fraction for
+// rounding: at least a guard and a round bit, with everything further down folded into the least
+// significant bit as a sticky bit.
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <universal/internal/blocktype/carry.hpp>
+
+namespace sw { namespace universal { namespace support {
+
+// the value (-1)^sign * significand * 2^(scale - fbits)
+struct word_triple {
+	bool     sign{ false };
+	int      scale{ 0 };
+	uint64_t significand{ 0 };
+};
+
+template<unsigned fbits>
+struct word_triple_arithmetic {
+	static_assert(fbits <= 61, "the product of two significands must normalize into a 64-bit word");
+
+	// Operands may carry significands below 2^fbits, such as subnormals at the minimum scale.
+	// An exact cancellation returns a zero significand. Requires fbits <= 59.
+	static word_triple add(word_triple a, word_triple b) noexcept {
+		static_assert(fbits <= 59, "the significand, its three guard bits, and the carry of the sum must fit a 64-bit word");
+		if (a.scale < b.scale || (a.scale == b.scale && a.significand < b.significand)) std::swap(a, b);
+		// three guard bits: guard, round, and sticky
+		uint64_t ma = a.significand << 3;
+		uint64_t mb = b.significand << 3;
+		unsigned alignment = static_cast<unsigned>(a.scale - b.scale);
+		if (alignment >= fbits + 4u) {
+			mb = 1;  // only the sticky bit remains
+		}
+		else if (alignment > 0) {
+			uint64_t sticky = (mb & ((1ull << alignment) - 1ull)) != 0 ? 1ull : 0ull;
+			mb = (mb >> alignment) | sticky;
+		}
+		uint64_t sum = (a.sign == b.sign) ? ma + mb : ma - mb;
+		if (sum == 0) return word_triple{ false, 0, 0 };
+		int msb = static_cast<int>(std::bit_width(sum)) - 1;
+		return word_triple{ a.sign, a.scale + msb - static_cast<int>(fbits + 3u), sum };
+	}
+
+	// Operands must be normalized, with the hidden bit of the significand set.
+	static word_triple mul(const word_triple& a, const word_triple& b) noexcept {
+		// the product of two (fbits+1)-bit significands has its leading one at 2*fbits or 2*fbits+1
+		uint64_t product;
+		int scale = a.scale + b.scale - 2 * static_cast<int>(fbits);
+		if constexpr (2 * fbits + 2 <= 64) {
+			product = a.significand * b.significand;
+		}
+		else {
+			uint64_t lo, hi;
+			mul128(a.significand, b.significand, lo, hi);
+			// keep the leading 64 bits, and fold the rest into the sticky bit
+			unsigned shift = static_cast<unsigned>(std::bit_width(hi));
+			uint64_t sticky = (lo & ((1ull << shift) - 1ull)) != 0 ? 1ull : 0ull;
+			product = (hi << (64 - shift)) | (lo >> shift) | sticky;
+			scale += static_cast<int>(shift);
+		}
+		int msb = static_cast<int>(std::bit_width(product)) - 1;
+		return word_triple{ a.sign != b.sign, scale + msb, product };
+	}
+
+	// Operands must be normalized, and the dividend must fit a word: fbits <= 30.
+	static word_triple div(const word_triple& a, const word_triple& b) noexcept {
+		static_assert(fbits <= 30, "the shifted dividend must fit a 64-bit word");
+		// fbits+3 quotient bits below the leading one: the target fraction, guard, and round bit
+		constexpr unsigned shift = fbits + 3u;
+		uint64_t dividend = a.significand << shift;
+		uint64_t quotient = dividend / b.significand;
+		if (dividend % b.significand != 0) quotient |= 1ull;  // sticky
+		int msb = static_cast<int>(std::bit_width(quotient)) - 1;
+		return word_triple{ a.sign != b.sign, a.scale - b.scale - static_cast<int>(shift) + msb, quotient };
+	}
+};
+
+}}} // namespace sw::universal::support
@@ -152,6 +152,8 @@ public:
 
     static op_matrix<lattice>& op_matrix_instance() {
         static op_matrix<lattice> _op_mat = op_matrix<lattice>(sizeof... (exacts) << 3);
+        static const bool _attached = (_op_mat.attach_from_environment(), true);
+        (void)_attached;
         return _op_mat;
     }
 };
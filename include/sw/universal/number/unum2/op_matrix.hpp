@@ -5,8 +5,43 @@
 
 #pragma once
 
+// The table stores, for every pair of lattice points (i, j), the SORN of i op j. Every such result
+// is a single arc on the projective circle of SORN bits: a point, a bounded run, a run that wraps
+// through infinity, or everything. An entry is therefore packed into 32 bits, the first SORN bit
+// of the arc in the low half and its length in the high half, instead of a full unum2<T> with its
+// lattice reference and N-bit bitset. Presence is a bitmap, so a lazily filled table costs
+// 4.125 bytes per pair and a 256-point lattice needs 264KB per operator instead of 2.6MB.
+//
+// Entries are computed on first use, or all at once with generate(), which splits the rows over
+// std::thread workers. save() writes a generated table to a cache file and load() maps it back
+// with mmap on POSIX systems (read into memory elsewhere), so later runs skip the generation.
+// When the UNIVERSAL_UNUM2_CACHE environment variable names a directory, the per-lattice table
+// returned by lattice<...>::op_matrix_instance() is loaded from, or generated into, that directory.
+//
+// The lazy path is not thread-safe, as before; generate() and load() must not race with lookups.
+
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UNUM2_OP_MATRIX_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define UNUM2_OP_MATRIX_MMAP 0
+#endif
 
 #include <universal/number/unum2/common.hpp>
 #include <universal/number/unum2/unum2_impl.hpp>
@@ -15,33 +50,15 @@ namespace sw { namespace universal {
 
 template <typename T>
 class op_matrix final {
-private:
-    // Buffer of op matrices.
-    unum2<T> *_matrices[OP_MATRIX_TOTAL_SUPPORTED_OPS];
-    bool *_present_flags[OP_MATRIX_TOTAL_SUPPORTED_OPS];
-    size_t _N;
-
 public:
-    op_matrix(size_t N) : _N { N } {
-        for(size_t i = 0; i < OP_MATRIX_TOTAL_SUPPORTED_OPS; i++) {
-            _matrices[i] = nullptr;
-            _present_flags[i] = nullptr;
-        }
+    using entry_type = std::uint32_t;
 
-        try {
-            for(size_t i = 0; i < OP_MATRIX_TOTAL_SUPPORTED_OPS; i++) {
-                _matrices[i] = new unum2<T>[N * N];
-                _present_flags[i] = new bool[N * N];
-            }
-        } catch(const std::bad_alloc& e) {
-            cleanup();
-            throw;  // rethrow
-        }
-        
-        for(size_t i = 0; i < OP_MATRIX_TOTAL_SUPPORTED_OPS; i++) {
-            for(size_t j = 0; j < N * N; j++)
-                _present_flags[i][j] = false;
-        }
+    static constexpr std::uint32_t file_version = 1;
+
+    op_matrix(size_t N) : _N{ N } {
+        if(N == 0 || N > 0x8000)
+            throw std::invalid_argument("op_matrix supports lattices of 1 to 32768 points");
+        for(size_t t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; t++) _table[t] = nullptr;
     }
 
     op_matrix(const op_matrix&) = delete;
@@ -50,39 +67,306 @@ public:
     op_matrix& operator=(op_matrix&&) = delete;
 
     ~op_matrix() {
-        cleanup();
+        unmap();
     }
 
     // Check if op_matrix has an operation
-    bool has(uint64_t i, uint64_t j, op_matrix_type type) {
-        return _present_flags[type][i * _N + j];
+    bool has(uint64_t i, uint64_t j, op_matrix_type type) const {
+        const auto& present = _present[type];
+        if(present.empty()) return false;
+        uint64_t k = i * _N + j;
+        return (present[k >> 6] >> (k & 63)) & 1u;
     }
 
     // Set a op_matrix operation
-    void set(uint64_t i, uint64_t j, op_matrix_type type, unum2<T> num) {
-        if(has(i, j, type)) 
+    void set(uint64_t i, uint64_t j, op_matrix_type type, const unum2<T>& num) {
+        if(has(i, j, type))
             return;
 
-        _matrices[type][i * _N + j] = num;
-        _present_flags[type][i * _N + j] = true;
+        allocate(type);
+        uint64_t k = i * _N + j;
+        _entries[type][k] = pack(num._sorn);
+        _present[type][k >> 6] |= std::uint64_t(1) << (k & 63);
     }
 
-    unum2<T> get(uint64_t i, uint64_t j, op_matrix_type type) {
-        if(!has(i, j, type)) 
+    unum2<T> get(uint64_t i, uint64_t j, op_matrix_type type) const {
+        if(!has(i, j, type))
             throw std::runtime_error("The given operation has to been set/interned yet!");
 
-        return _matrices[type][i * _N + j];
+        unum2<T> res;
+        res._sorn = unpack(_table[type][i * _N + j]);
+        return res;
+    }
+
+    // SORN of a op b: the union over all pairs of points of the cached arcs. The union is formed
+    // by counting arc starts and ends over the circle of SORN bits, so each pair costs two
+    // increments rather than an N-bit OR. Missing entries are computed and interned.
+    unum2<T> evaluate(const unum2<T>& a, const unum2<T>& b, op_matrix_type type) {
+        constexpr size_t nbits = unum2<T>::sorn_length;
+        uint64_t lhs[nbits], rhs[nbits];
+        uint64_t nl = a._points(lhs), nr = b._points(rhs);
+        int cover[nbits + 1] = {};
+        unum2<T> res;
+        for(uint64_t p = 0; p < nl; p++) {
+            for(uint64_t q = 0; q < nr; q++) {
+                uint64_t k = lhs[p] * _N + rhs[q];
+                if(!has(lhs[p], rhs[q], type))
+                    set(lhs[p], rhs[q], type, compute(lhs[p], rhs[q], type));
+                entry_type e = _table[type][k];
+                size_t start = e & 0xFFFFu;
+                size_t end = start + (e >> 16);
+                if(end == start) continue;
+                if(end - start == nbits) {
+                    res._sorn.set();
+                    return res;
+                }
+                cover[start]++;
+                if(end <= nbits) {
+                    cover[end]--;
+                } else {
+                    cover[nbits]--;
+                    cover[0]++;
+                    cover[end - nbits]--;
+                }
+            }
+        }
+        int depth = 0;
+        for(size_t i = 0; i < nbits; i++) {
+            depth += cover[i];
+            if(depth > 0) res._sorn.set(i);
+        }
+        return res;
+    }
+
+    // Compute every missing entry of every operator, rows split over nrThreads workers
+    // (0 selects the hardware concurrency)
+    void generate(unsigned nrThreads = 0) {
+        if(nrThreads == 0) nrThreads = std::max(1u, std::thread::hardware_concurrency());
+        nrThreads = static_cast<unsigned>(std::min<size_t>(nrThreads, _N));
+        for(size_t t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; t++) {
+            op_matrix_type type = static_cast<op_matrix_type>(t);
+            if(complete(type)) continue;
+            allocate(type);
+            // workers only read the presence bitmap and write disjoint entries
+            auto fill = [this, type](size_t first, size_t last) {
+                for(size_t i = first; i < last; i++) {
+                    for(size_t j = 0; j < _N; j++) {
+                        if(!has(i, j, type)) _entries[type][i * _N + j] = pack(compute(i, j, type)._sorn);
+                    }
+                }
+            };
+            if(nrThreads == 1) {
+                fill(0, _N);
+            } else {
+                std::vector<std::thread> workers;
+                size_t rows = (_N + nrThreads - 1) / nrThreads;
+                for(size_t first = 0; first < _N; first += rows)
+                    workers.emplace_back(fill, first, std::min(_N, first + rows));
+                for(auto& w : workers) w.join();
+            }
+            std::fill(_present[type].begin(), _present[type].end(), ~std::uint64_t(0));
+        }
+    }
+
+    bool complete(op_matrix_type type) const {
+        for(uint64_t i = 0; i < _N; i++)
+            for(uint64_t j = 0; j < _N; j++)
+                if(!has(i, j, type)) return false;
+        return true;
+    }
+
+    // true when the tables are served from a mapped cache file
+    bool mapped() const { return _mapping != nullptr; }
+
+    // bytes of table storage currently held in memory (a mapping counts as its file size)
+    size_t footprint() const {
+        size_t bytes = _mapping_size;
+        for(size_t t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; t++)
+            bytes += _entries[t].capacity() * sizeof(entry_type) + _present[t].capacity() * sizeof(std::uint64_t);
+        return bytes;
+    }
+
+    // Generate the full table and write it to path; returns false if the file cannot be written
+    bool save(const std::string& path) {
+        generate();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+        header h = make_header();
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        for(size_t t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; t++)
+            out.write(reinterpret_cast<const char*>(_table[t]), static_cast<std::streamsize>(_N * _N * sizeof(entry_type)));
+        return static_cast<bool>(out);
+    }
+
+    // Replace the tables with the contents of a cache file written by save(). Returns false,
+    // leaving the table untouched, if the file is missing or was written for another lattice,
+    // format version, or byte order.
+    bool load(const std::string& path) {
+        const size_t expected = sizeof(header) + OP_MATRIX_TOTAL_SUPPORTED_OPS * _N * _N * sizeof(entry_type);
+#if UNUM2_OP_MATRIX_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) return false;
+        struct stat st;
+        if(::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != expected) {
+            ::close(fd);
+            return false;
+        }
+        void* base = ::mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(base == MAP_FAILED) return false;
+        if(!valid(static_cast<const unsigned char*>(base))) {
+            ::munmap(base, expected);
+            return false;
+        }
+        adopt(static_cast<const unsigned char*>(base), expected, true);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if(!in || static_cast<size_t>(in.tellg()) != expected) return false;
+        in.seekg(0);
+        unsigned char* base = static_cast<unsigned char*>(std::malloc(expected));
+        if(base == nullptr) return false;
+        if(!in.read(reinterpret_cast<char*>(base), static_cast<std::streamsize>(expected)) || !valid(base)) {
+            std::free(base);
+            return false;
+        }
+        adopt(base, expected, false);
+#endif
+        return true;
+    }
+
+    // Load the cache file if it matches, otherwise generate the table and write the file
+    bool attach(const std::string& path) {
+        if(load(path)) return true;
+        if(!save(path)) return false;
+        return load(path);
+    }
+
+    // cache file name that identifies the lattice
+    static std::string cache_file_name() {
+        std::ostringstream oss;
+        oss << "unum2_" << T::instance()._N << '_' << std::hex << std::setw(16) << std::setfill('0') << fingerprint() << ".opm";
+        return oss.str();
+    }
+
+    // attach to UNIVERSAL_UNUM2_CACHE/cache_file_name() when the environment variable is set
+    void attach_from_environment() {
+        const char* dir = std::getenv("UNIVERSAL_UNUM2_CACHE");
+        if(dir == nullptr || *dir == '\0') return;
+        std::string path(dir);
+        if(path.back() != '/' && path.back() != '\\') path += '/';
+        attach(path + cache_file_name());
     }
 
 private:
-    void cleanup() {
-        for(size_t i = 0; i < OP_MATRIX_TOTAL_SUPPORTED_OPS; i++) {
-            delete[] _matrices[i];
-            delete[] _present_flags[i];
+    struct header {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t points;
+        std::uint64_t fingerprint;
+    };
+    static_assert(sizeof(header) == 32, "op_matrix cache header must stay 32 bytes");
+
+    size_t _N;
+    // lookups go through _table, which points into _entries or into the cache file
+    const entry_type* _table[OP_MATRIX_TOTAL_SUPPORTED_OPS];
+    std::vector<entry_type> _entries[OP_MATRIX_TOTAL_SUPPORTED_OPS];
+    std::vector<std::uint64_t> _present[OP_MATRIX_TOTAL_SUPPORTED_OPS];
+    const unsigned char* _mapping = nullptr;
+    size_t _mapping_size = 0;
+    bool _mmapped = false;
+
+    void allocate(op_matrix_type type) {
+        if(!_present[type].empty()) return;
+        _entries[type].assign(_N * _N, 0);
+        _present[type].assign((_N * _N + 63) / 64, 0);
+        _table[type] = _entries[type].data();
+    }
+
+    static unum2<T> compute(uint64_t i, uint64_t j, op_matrix_type type) {
+        const T& lattice = T::instance();
+        return type == OP_MATRIX_TYPE_ADD ? unum2<T>::_sumpoint(i, j, lattice) : unum2<T>::_mulpoint(i, j, lattice);
+    }
 
-            _matrices[i] = nullptr;
-            _present_flags[i] = nullptr;
+    template<size_t nbits>
+    static entry_type pack(const std::bitset<nbits>& sorn) {
+        size_t count = sorn.count();
+        if(count == 0) return 0;
+        if(count == nbits) return entry_type(nbits) << 16;
+        // the arc starts at a set bit whose predecessor on the circle is clear
+        size_t start = 0;
+        while(!(sorn[start] && !sorn[(start + nbits - 1) % nbits])) start++;
+        for(size_t k = 0; k < count; k++) {
+            if(!sorn[(start + k) % nbits])
+                throw std::runtime_error("op_matrix: operation result is not a single SORN arc");
         }
+        return entry_type(start) | (entry_type(count) << 16);
+    }
+
+    static std::bitset<unum2<T>::sorn_length> unpack(entry_type e) {
+        constexpr size_t nbits = unum2<T>::sorn_length;
+        size_t start = e & 0xFFFFu;
+        size_t length = e >> 16;
+        if(length == 0) return {};
+        std::bitset<nbits> run;
+        run.set();
+        run >>= nbits - length;
+        return start == 0 ? run : (run << start) | (run >> (nbits - start));
+    }
+
+    // FNV-1a over the exact values of the lattice
+    static std::uint64_t fingerprint() {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for(int e : T::instance()._exacts) {
+            std::uint32_t v = static_cast<std::uint32_t>(e);
+            for(int b = 0; b < 4; b++) {
+                h ^= (v >> (8 * b)) & 0xFFu;
+                h *= 0x100000001b3ull;
+            }
+        }
+        return h;
+    }
+
+    header make_header() const {
+        header h{};
+        std::memcpy(h.magic, "UNUM2OPM", 8);
+        h.version = file_version;
+        h.byte_order = 0x01020304u;
+        h.points = _N;
+        h.fingerprint = fingerprint();
+        return h;
+    }
+
+    bool valid(const unsigned char* base) const {
+        header h;
+        std::memcpy(&h, base, sizeof(h));
+        header e = make_header();
+        return std::memcmp(h.magic, e.magic, 8) == 0 && h.version == e.version && h.byte_order == e.byte_order
+            && h.points == e.points && h.fingerprint == e.fingerprint;
+    }
+
+    void adopt(const unsigned char* base, size_t size, bool mmapped) {
+        unmap();
+        _mapping = base;
+        _mapping_size = size;
+        _mmapped = mmapped;
+        for(size_t t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; t++) {
+            _table[t] = reinterpret_cast<const entry_type*>(base + sizeof(header)) + t * _N * _N;
+            std::vector<entry_type>().swap(_entries[t]);
+            _present[t].assign((_N * _N + 63) / 64, ~std::uint64_t(0));
+        }
+    }
+
+    void unmap() {
+        if(_mapping == nullptr) return;
+#if UNUM2_OP_MATRIX_MMAP
+        if(_mmapped) ::munmap(const_cast<unsigned char*>(_mapping), _mapping_size);
+        else std::free(const_cast<unsigned char*>(_mapping));
+#else
+        std::free(const_cast<unsigned char*>(_mapping));
+#endif
+        _mapping = nullptr;
+        _mapping_size = 0;
     }
 };
 
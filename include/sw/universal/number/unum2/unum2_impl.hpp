@@ -44,6 +44,9 @@ private:
     constexpr static uint64_t sorn_length = sizeof... (exacts) << 3;
     std::bitset<sorn_length> _sorn;  // empty
 
+    // The op matrix packs, unpacks and computes table entries
+    friend class op_matrix<T>;
+
 public:
     unum2(uint64_t index) : _lattice(T::instance()) {
         //uint64_tDo bitwise or with with half the lattice size. SORN index starts from 2's compliment. That is
@@ -212,15 +215,19 @@ public:
 
     // Addition
     unum2<T> operator + (const unum2<T>& other) const {
+#if UNUM2_USE_OP_MATRIX
+        return T::op_matrix_instance().evaluate(*this, other, OP_MATRIX_TYPE_ADD);
+#else
         auto res = unum2<T>::empty();
-        for(uint64_t i = 0; i < sorn_length; i++) {
-            for(uint64_t j = 0; j < sorn_length; j++) {
-                if(_sorn[i] == 1 && other._sorn[j] == 1)
-                    res._sorn |= unum2<T>::_sumpoint(_conv_idx(i), _conv_idx(j), _lattice)._sorn;
-            }
+        uint64_t lhs[sorn_length], rhs[sorn_length];
+        uint64_t nl = _points(lhs), nr = other._points(rhs);
+        for(uint64_t i = 0; i < nl; i++) {
+            for(uint64_t j = 0; j < nr; j++)
+                res._sorn |= unum2<T>::_sumpoint(lhs[i], rhs[j], _lattice)._sorn;
         }
 
         return res;
+#endif
     }
 
     // SORN Concatenation or Union
@@ -232,15 +239,19 @@ public:
 
     // Multiplication
     unum2<T> operator * (const unum2<T>& other) const {
+#if UNUM2_USE_OP_MATRIX
+        return T::op_matrix_instance().evaluate(*this, other, OP_MATRIX_TYPE_MUL);
+#else
         auto res = unum2<T>::empty();
-        for(uint64_t i = 0; i < sorn_length; i++) {
-            for(uint64_t j = 0; j < sorn_length; j++) {
-                if(_sorn[i] == 1 && other._sorn[j] == 1)
-                    res._sorn |= unum2<T>::_mulpoint(_conv_idx(i), _conv_idx(j), _lattice)._sorn;
-            }
+        uint64_t lhs[sorn_length], rhs[sorn_length];
+        uint64_t nl = _points(lhs), nr = other._points(rhs);
+        for(uint64_t i = 0; i < nl; i++) {
+            for(uint64_t j = 0; j < nr; j++)
+                res._sorn |= unum2<T>::_mulpoint(lhs[i], rhs[j], _lattice)._sorn;
         }
 
         return res;
+#endif
     }
 
     // Negation
@@ -331,9 +342,18 @@ public:
     }
 
 private:
+    // lattice indices of the set SORN bits; returns their count
+    uint64_t _points(uint64_t* idx) const {
+        uint64_t n = 0;
+        for(uint64_t i = 0; i < sorn_length; i++) {
+            if(_sorn[i]) idx[n++] = _conv_idx(i);
+        }
+        return n;
+    }
+
     template<typename TT>
     static uint64_t _from_index(TT value) {
-        T lattice = T();
+        const T& lattice = T::instance();
     
         if(!std::isfinite(value))
             return lattice._N >> 1;
@@ -440,34 +460,24 @@ private:
         return res;
     }
 
+    // Sum of lattice points i and j. This is the kernel the op matrix caches, so it does not
+    // consult the matrix itself.
     static unum2<T> _sumpoint(uint64_t i, uint64_t j, const T& lattice) {
-        op_matrix<T>* op_mat;
-
-        if(UNUM2_USE_OP_MATRIX) {
-            op_mat = &T::op_matrix_instance();
-
-            if(op_mat->has(i, j, OP_MATRIX_TYPE_ADD))
-                return op_mat->get(i, j, OP_MATRIX_TYPE_ADD);
-        }
-
         unum2<T> res;
 
         // i and j both represent infinity
         if(i == lattice._N_half && j == lattice._N_half) {
             res = unum2<T>::everything();
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
             return res;
         }
         // i or j represent infinity
         else if(i == lattice._N_half || j == lattice._N_half) {
             res = unum2<T>(lattice._N_half);  // inf
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
             return res;
         }
         // i represents 0
         else if(i == 0 || j == 0) {
             res = unum2<T>(j);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
             return res;
         }
 
@@ -482,7 +492,6 @@ private:
 
         if(ie && je) {
             res = unum2<T>::from(lattice.exactvalue(i & lattice._MASK) + lattice.exactvalue(j & lattice._MASK));
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
             return res;
         } else {
             j_left = lattice.exactvalue((j - 1) & lattice._MASK);
@@ -496,7 +505,6 @@ private:
         // only j is exact
         else if(je) {
             res = _sumpoint(j, i, lattice);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
             return res;
         } else {
             // None is exact
@@ -508,51 +516,36 @@ private:
         uint64_t res_right_idx = unum2<T>::_from_index(i_right + j_right);
 
         res = unum2<T>::_bound(res_left_idx, res_right_idx);
-        if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_ADD, res);
         return res;
     }
 
+    // Product of lattice points i and j, the multiplication kernel of the op matrix
     static unum2<T> _mulpoint(uint64_t i, uint64_t j, const T& lattice) {
-        op_matrix<T>* op_mat;
-
-        if(UNUM2_USE_OP_MATRIX) {
-            op_mat = &T::op_matrix_instance();
-
-            if(op_mat->has(i, j, OP_MATRIX_TYPE_MUL)) {
-                return op_mat->get(i, j, OP_MATRIX_TYPE_MUL);
-            }
-        }
-
         unum2<T> res;
 
         // inf * 0 = everything
         if((i == lattice._N_half && j == 0) || (i == 0 && j == lattice._N_half)) {
             res = unum2<T>::everything();
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         }
         // inf * 1 = inf
         else if((i == lattice._N_half && j == lattice._N_quarter) || (i == lattice._N_quarter && j == lattice._N_half)) {
             res = unum2<T>(lattice._N_half);  // inf
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         } 
         // i represents 1
         else if(i == lattice._N_quarter) {
             res = unum2<T>(j);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         }
         // j represents 1
         else if(j == lattice._N_quarter) {
             res = unum2<T>(i);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         } 
         // i represents 0
         else if(i == 0 || j == 0) {
             res = unum2<T>(0);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         } 
 
@@ -567,7 +560,6 @@ private:
 
         if(ie && je) {
             res = unum2<T>::from(lattice.exactvalue(i & lattice._MASK) * lattice.exactvalue(j & lattice._MASK));
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         }
         else {
@@ -582,7 +574,6 @@ private:
         // only j is exact
         else if(je) {
             res = _mulpoint(j, i, lattice);
-            if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
             return res;
         } else {
             // None is exact
@@ -595,11 +586,10 @@ private:
 
         // check for NaNs. That should occur only when we encounter things like inf * 0. Return everything
         // in this case.
-        for(int i = 0; i < 4; i++) {
-            if(std::isnan(candidates[i])) {
+        for(int k = 0; k < 4; k++) {
+            if(std::isnan(candidates[k])) {
                 res = unum2<T>::everything();
-                if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
-                return res;
+                    return res;
             }    
         }
 
@@ -614,7 +604,6 @@ private:
             res_right_idx = (res_right_idx - 1) & lattice._MASK;
 
         res = unum2<T>::_bound(res_left_idx, res_right_idx);
-        if(UNUM2_USE_OP_MATRIX) op_mat->set(i, j, OP_MATRIX_TYPE_MUL, res);
         return res;
     }
 
@@ -0,0 +1,787 @@
+#pragma once
+// zfp_codec_fast.hpp: runtime ZFP block codec -- interleaved lifting and word-at-a-time bit-plane coding
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// The codec of zfp_codec.hpp is constexpr, which keeps it to one scalar lane and one bit per call of
+// zfp_bitstream::write_bits. It stays the reference. This header implements the same codec for run
+// time, producing and consuming exactly the same bits:
+//
+//   transform    the blocks of a batch are interleaved, coefficient-major, so each lifting step
+//                is one operation across the blocks of the batch. Block-float conversion scales by
+//                a power of two instead of calling std::ldexp per element. The batch kernels are
+//                multiversioned (hw/dispatch.hpp): the compiler vectorizes the same loops for
+//                AVX2 and AVX-512, and the widest variant the host supports runs.
+//   bit planes   the planes of a block are extracted at once by a bit-matrix transpose. A plane of
+//                significant coefficients goes out in one word write. The group tests of a plane
+//                are encoded from one mask computation and a precomputed table of the interleaved
+//                test and value bits. The decoder reads the group tests, which are short runs,
+//                a bit at a time.
+//   bit stream   a 64-bit accumulator that stores whole words, truncating the code at maxbits
+//                exactly where the reference coder stops.
+//
+// Non-finite blocks, and blocks whose scale factor is not a normal number, take the reference
+// block-float conversion. The entry points mirror encode_block and decode_block, for one block or
+// for a run of consecutive blocks:
+//
+//   encode_block_fast<Real, Dim>(fblock, buffer, max_bytes, maxprec, maxbits)
+//   decode_block_fast<Real, Dim>(buffer, max_bytes, fblock, maxprec, maxbits)
+//   encode_blocks_fast<Real, Dim>(src, nblocks, dst, stride_bytes, maxprec, maxbits)
+//   decode_blocks_fast<Real, Dim>(src, nblocks, stride_bytes, dst, maxprec, maxbits)
+//
+// zfpblock, zfparray, and the zfparray storage classes take this codec at run time. Set
+// ZFPBLOCK_FAST_CODEC to 0 to run the reference codec everywhere.
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <climits>
+#include <array>
+#include <limits>
+#include <type_traits>
+
+#include <universal/hw/dispatch.hpp>
+#include <universal/number/zfpblock/zfp_codec.hpp>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#if !defined(ZFPBLOCK_FAST_CODEC)
+#define ZFPBLOCK_FAST_CODEC 1
+#endif
+
+namespace sw { namespace universal {
+
+namespace zfp_fast {
+
+	// blocks per batch of the interleaved transform: one 512-bit vector of coefficients
+	template<typename Real>
+	constexpr size_t lanes = 64 / sizeof(typename zfp_type_traits<Real>::Int);
+
+	constexpr uint64_t lowmask(unsigned n) noexcept { return n >= 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1); }
+
+	// std::popcount is a library call without POPCNT; the masks here are mostly sparse
+	inline unsigned bit_count(uint64_t v) noexcept {
+#if defined(__POPCNT__) || defined(_MSC_VER)
+		return static_cast<unsigned>(std::popcount(v));
+#else
+		unsigned n = 0;
+		for (; v != 0; v &= v - 1) ++n;
+		return n;
+#endif
+	}
+
+	// the bits of v at the positions of mask, packed into the low bits
+	inline uint64_t compact(uint64_t v, uint64_t mask) noexcept {
+#if defined(__BMI2__)
+		return _pext_u64(v, mask);
+#else
+		uint64_t r = 0;
+		for (unsigned t = 0; mask != 0; ++t, mask &= mask - 1) r |= ((v >> std::countr_zero(mask)) & 1u) << t;
+		return r;
+#endif
+	}
+	// the low bits of v deposited at the positions of mask
+	inline uint64_t deposit(uint64_t v, uint64_t mask) noexcept {
+#if defined(__BMI2__)
+		return _pdep_u64(v, mask);
+#else
+		uint64_t r = 0;
+		for (unsigned t = 0; mask != 0 && (v >> t) != 0; ++t, mask &= mask - 1) r |= ((v >> t) & 1u) << std::countr_zero(mask);
+		return r;
+#endif
+	}
+
+	// group-test codes: for eight tested coefficients with values c, the bits 1 c0 1 c1 ... 1 c7
+	constexpr std::array<uint16_t, 256> group_test_codes = [] {
+		std::array<uint16_t, 256> t{};
+		for (unsigned c = 0; c < 256; ++c) {
+			unsigned code = 0;
+			for (unsigned b = 0; b < 8; ++b) code |= (1u | (((c >> b) & 1u) << 1)) << (2 * b);
+			t[c] = static_cast<uint16_t>(code);
+		}
+		return t;
+	}();
+
+	inline uint64_t load_word(const uint8_t* p, size_t available) noexcept {
+		uint64_t w{ 0 };
+		if (available >= 8 && std::endian::native == std::endian::little) {
+			std::memcpy(&w, p, 8);
+		}
+		else {
+			size_t n = available < 8 ? available : 8;
+			for (size_t i = 0; i < n; ++i) w |= static_cast<uint64_t>(p[i]) << (8 * i);
+		}
+		return w;
+	}
+	inline void store_word(uint8_t* p, uint64_t w, size_t available) noexcept {
+		if (available >= 8 && std::endian::native == std::endian::little) {
+			std::memcpy(p, &w, 8);
+		}
+		else {
+			size_t n = available < 8 ? available : 8;
+			for (size_t i = 0; i < n; ++i) p[i] = static_cast<uint8_t>(w >> (8 * i));
+		}
+	}
+
+	// LSB-first bit writer with the byte layout of zfp_bitstream; bytes past max_bytes are dropped
+	class word_writer {
+	public:
+		word_writer(uint8_t* buffer, size_t max_bytes) noexcept : _buffer(buffer), _max_bytes(max_bytes) {}
+
+		// append the low n bits of v, n <= 64, v without bits above n
+		void put(uint64_t v, unsigned n) noexcept {
+			if (n == 0) return;
+			_acc |= v << _fill;
+			if (_fill + n >= 64) {
+				store();
+				_acc = (_fill == 0) ? 0 : v >> (64 - _fill);
+				_fill = _fill + n - 64;
+			}
+			else {
+				_fill += n;
+			}
+			_bits += n;
+		}
+		// zeros up to a total of nbits
+		void pad_to(size_t nbits) noexcept {
+			while (_bits < nbits) {
+				size_t n = nbits - _bits;
+				put(0, static_cast<unsigned>(n < 64 ? n : 64));
+			}
+		}
+		// store the partial word
+		void flush() noexcept {
+			if (_fill > 0) {
+				size_t avail = (_byte < _max_bytes) ? _max_bytes - _byte : 0;
+				size_t n = (_fill + 7) / 8;
+				store_word(_buffer + (_byte < _max_bytes ? _byte : 0), _acc, avail < n ? avail : n);
+			}
+		}
+		size_t bits() const noexcept { return _bits; }
+
+	private:
+		uint8_t* _buffer;
+		size_t   _max_bytes;
+		size_t   _byte = 0;   // byte offset of the accumulator
+		size_t   _bits = 0;
+		uint64_t _acc  = 0;
+		unsigned _fill = 0;   // bits in the accumulator
+
+		void store() noexcept {
+			if (_byte < _max_bytes) store_word(_buffer + _byte, _acc, _max_bytes - _byte);
+			_byte += 8;
+		}
+	};
+
+	// LSB-first bit reader over a buffer that extends 16 bytes past the last bit read
+	class word_reader {
+	public:
+		explicit word_reader(const uint8_t* buffer) noexcept : _next(buffer) {}
+
+		// at least the next 56 bits, not consumed
+		uint64_t peek() noexcept {
+			if (_avail < 56) {
+				_acc |= load_word(_next, 8) << _avail;
+				_next += (63 - _avail) / 8;
+				_avail |= 56;
+			}
+			return _acc;
+		}
+		// consume n <= 56 bits of a peek
+		void skip(unsigned n) noexcept {
+			_acc >>= n;
+			_avail -= n;
+		}
+		// the next n bits, n <= 64
+		uint64_t get(unsigned n) noexcept {
+			uint64_t v;
+			if (n > 56) {
+				v = peek() & lowmask(32);
+				skip(32);
+				v |= (peek() & lowmask(n - 32)) << 32;
+				skip(n - 32);
+			}
+			else {
+				v = peek() & lowmask(n);
+				skip(n);
+			}
+			return v;
+		}
+
+	private:
+		const uint8_t* _next;        // next byte to load
+		uint64_t       _acc   = 0;   // the stream from the read position on
+		unsigned       _avail = 0;   // bits of _acc loaded
+	};
+
+	// transpose a 64x64 bit matrix in place: bit c of row r moves to bit r of row c
+	inline void transpose64(uint64_t* a) noexcept {
+		uint64_t m = 0x00000000FFFFFFFFull;
+		for (unsigned j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+			for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+				uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+				a[k] ^= t << j;
+				a[k | j] ^= t;
+			}
+		}
+	}
+
+	// bit k of the N coefficients; 64-coefficient blocks extract all their planes at once with transpose64
+	template<typename UInt, size_t N>
+	inline uint64_t plane_of(const UInt* u, unsigned k) noexcept {
+		uint64_t p = 0;
+		for (size_t i = 0; i < N; ++i) p |= static_cast<uint64_t>((u[i] >> k) & 1u) << i;
+		return p;
+	}
+
+	// the code of the reference bit-plane coder, truncated to maxbits, one plane at a time
+	template<typename UInt, size_t N>
+	inline void encode_planes(word_writer& out, const UInt* ublock, unsigned maxprec, size_t maxbits) noexcept {
+		constexpr unsigned intprec = CHAR_BIT * sizeof(UInt);
+		constexpr uint64_t full = lowmask(N);
+		unsigned K = maxprec < intprec ? maxprec : intprec;
+		uint64_t planes[N == 64 ? 64 : 1];
+		if constexpr (N == 64) {
+			for (size_t i = 0; i < 64; ++i) planes[i] = static_cast<uint64_t>(ublock[i]);
+			transpose64(planes);
+		}
+
+		size_t budget = maxbits;
+		// emit n bits, or the part of them the budget allows; false once the budget is spent
+		auto emit = [&](uint64_t v, unsigned n) noexcept {
+			if (n >= budget) {
+				out.put(v & lowmask(static_cast<unsigned>(budget)), static_cast<unsigned>(budget));
+				budget = 0;
+				return false;
+			}
+			out.put(v, n);
+			budget -= n;
+			return true;
+		};
+
+		// the planes above the highest coefficient bit code one negative group test each
+		UInt any = 0;
+		for (size_t i = 0; i < N; ++i) any |= ublock[i];
+		unsigned top = static_cast<unsigned>(std::bit_width(any));
+		if (top < K) {
+			if (!emit(0, K - top)) return;
+			K = top;
+		}
+
+		uint64_t sig = 0;
+		unsigned nsig = 0;   // popcount of sig
+		for (unsigned k = K; k-- > 0 && budget > 0; ) {
+			uint64_t plane;
+			if constexpr (N == 64) plane = planes[k]; else plane = plane_of<UInt, N>(ublock, k);
+			if (sig == full) {
+				emit(plane, static_cast<unsigned>(N));
+				continue;
+			}
+			// the previously significant coefficients, in index order
+			if (sig != 0 && !emit(compact(plane, sig), nsig)) break;
+			// group tests over the others, up to the last one that becomes significant on this plane
+			uint64_t remaining = ~sig & full;
+			uint64_t fresh = plane & remaining;
+			if (fresh == 0) {
+				emit(0, 1);
+				continue;
+			}
+			unsigned h = static_cast<unsigned>(std::bit_width(fresh));    // tests cover indices < h
+			uint64_t tested = remaining & lowmask(h);
+			uint64_t values = compact(plane, tested);
+			unsigned m = bit_count(tested);
+			bool more = true;
+			for (unsigned t = 0; t < m && more; t += 8) {
+				unsigned nb = (m - t < 8) ? m - t : 8;
+				more = emit(group_test_codes[(values >> t) & 0xFFu] & lowmask(2 * nb), 2 * nb);
+			}
+			if (!more) break;
+			if ((remaining & ~lowmask(h)) != 0) emit(0, 1);
+			sig |= fresh;
+			nsig += bit_count(fresh);
+		}
+	}
+
+	// the inverse of encode_planes, reading the code the reference decoder reads
+	template<typename UInt, size_t N>
+	inline void decode_planes(word_reader& stream, UInt* ublock, unsigned maxprec, size_t maxbits) noexcept {
+		word_reader in = stream;   // a local copy, which the stores to ublock cannot alias
+		constexpr unsigned intprec = CHAR_BIT * sizeof(UInt);
+		constexpr uint64_t full = lowmask(N);
+		unsigned K = maxprec < intprec ? maxprec : intprec;
+		// 64-coefficient blocks decode into planes and transpose; smaller blocks set coefficient bits directly
+		uint64_t planes[N == 64 ? 64 : 1]{};
+		if constexpr (N != 64) {
+			for (size_t i = 0; i < N; ++i) ublock[i] = 0;
+		}
+		// set bit k of the coefficients at the positions of bits
+		auto set_plane_bits = [&](uint64_t bits, unsigned k) noexcept {
+			if constexpr (N == 64) {
+				planes[k] |= bits;
+			}
+			else {
+				for (; bits != 0; bits &= bits - 1) ublock[std::countr_zero(bits)] |= UInt(1) << k;
+			}
+		};
+
+		size_t budget = maxbits;
+		uint64_t sig = 0;
+		unsigned nsig = 0;   // popcount of sig
+		for (unsigned k = K; k-- > 0 && budget > 0; ) {
+			if (sig != 0) {
+				unsigned r = static_cast<unsigned>(budget < nsig ? budget : nsig);
+				uint64_t bits = in.get(r);
+				if constexpr (N == 64) {
+					planes[k] = deposit(bits, sig);
+				}
+				else if (sig == full) {
+					for (size_t i = 0; i < N; ++i) ublock[i] |= static_cast<UInt>((bits >> i) & 1u) << k;
+				}
+				else {
+					for (uint64_t m = sig; m != 0; m &= m - 1, bits >>= 1) ublock[std::countr_zero(m)] |= static_cast<UInt>(bits & 1u) << k;
+				}
+				budget -= r;
+			}
+			// group tests: a coefficient becomes significant on a 1 after a positive test, and runs
+			// of tests are short, so they are read a bit at a time
+			uint64_t remaining = ~sig & full;
+			while (remaining != 0 && budget > 0) {
+				--budget;
+				if (!in.get(1)) break;
+				if (budget == 0) break;
+				--budget;
+				uint64_t bit = remaining & (0 - remaining);
+				if (in.get(1)) {
+					sig |= bit;
+					++nsig;
+					set_plane_bits(bit, k);
+				}
+				remaining ^= bit;
+			}
+		}
+		if constexpr (N == 64) {
+			transpose64(planes);
+			for (size_t i = 0; i < 64; ++i) ublock[i] = static_cast<UInt>(planes[i]);
+		}
+		stream = in;
+	}
+
+	// power-of-two scale factors: 2^e as a normal Real, or 0 when it is not one
+	template<typename Real>
+	inline Real exp2_normal(int e) noexcept {
+		if constexpr (std::is_same_v<Real, float>) {
+			if (e < -126 || e > 127) return 0.0f;
+			return std::bit_cast<float>(static_cast<uint32_t>(e + 127) << 23);
+		}
+		else {
+			if (e < -1022 || e > 1023) return 0.0;
+			return std::bit_cast<double>(static_cast<uint64_t>(e + 1023) << 52);
+		}
+	}
+
+	// the frexp exponent of a positive finite value
+	template<typename Real>
+	inline int frexp_exponent(Real v) noexcept {
+		if constexpr (std::is_same_v<Real, float>) {
+			int raw = static_cast<int>((std::bit_cast<uint32_t>(v) >> 23) & 0xFFu);
+			if (raw != 0) return raw - 126;
+		}
+		else {
+			int raw = static_cast<int>((std::bit_cast<uint64_t>(v) >> 52) & 0x7FFu);
+			if (raw != 0) return raw - 1022;
+		}
+		int e{ 0 };
+		std::frexp(v, &e);
+		return e;
+	}
+
+	// per-block state of the forward transform
+	enum class block_kind : uint8_t { zero, fast, reference };
+
+	// lifting steps across the G blocks of a batch: coefficient c of block g is v[c * G + g]
+	template<typename Int, size_t G>
+	UNIVERSAL_KERNEL_INLINE void fwd_lift_lanes(Int* v, unsigned base, unsigned s) noexcept {
+		Int* px = v + (base + 0 * s) * G;
+		Int* py = v + (base + 1 * s) * G;
+		Int* pz = v + (base + 2 * s) * G;
+		Int* pw = v + (base + 3 * s) * G;
+		for (size_t l = 0; l < G; ++l) {
+			Int x = px[l], y = py[l], z = pz[l], w = pw[l];
+			x += w; x >>= 1; w -= x;
+			z += y; z >>= 1; y -= z;
+			x += z; x >>= 1; z -= x;
+			w += y; w >>= 1; y -= w;
+			w += y >> 1; y -= w >> 1;
+			px[l] = x; py[l] = y; pz[l] = z; pw[l] = w;
+		}
+	}
+	template<typename Int, size_t G>
+	UNIVERSAL_KERNEL_INLINE void inv_lift_lanes(Int* v, unsigned base, unsigned s) noexcept {
+		Int* px = v + (base + 0 * s) * G;
+		Int* py = v + (base + 1 * s) * G;
+		Int* pz = v + (base + 2 * s) * G;
+		Int* pw = v + (base + 3 * s) * G;
+		for (size_t l = 0; l < G; ++l) {
+			Int x = px[l], y = py[l], z = pz[l], w = pw[l];
+			y += w >> 1; w -= y >> 1;
+			y += w; w -= y - w;
+			z += x; x -= z - x;
+			y += z; z -= y - z;
+			w += x; x -= w - x;
+			px[l] = x; py[l] = y; pz[l] = z; pw[l] = w;
+		}
+	}
+
+	// the separable transforms of fwd_xform and inv_xform, in the same order
+	template<typename Int, unsigned Dim, size_t G>
+	UNIVERSAL_KERNEL_INLINE void fwd_xform_lanes(Int* v) noexcept {
+		if constexpr (Dim == 1) {
+			fwd_lift_lanes<Int, G>(v, 0, 1);
+		}
+		else if constexpr (Dim == 2) {
+			for (unsigned y = 0; y < 4; ++y) fwd_lift_lanes<Int, G>(v, 4 * y, 1);
+			for (unsigned x = 0; x < 4; ++x) fwd_lift_lanes<Int, G>(v, x, 4);
+		}
+		else {
+			for (unsigned z = 0; z < 4; ++z)
+				for (unsigned y = 0; y < 4; ++y) fwd_lift_lanes<Int, G>(v, 4 * y + 16 * z, 1);
+			for (unsigned z = 0; z < 4; ++z)
+				for (unsigned x = 0; x < 4; ++x) fwd_lift_lanes<Int, G>(v, x + 16 * z, 4);
+			for (unsigned y = 0; y < 4; ++y)
+				for (unsigned x = 0; x < 4; ++x) fwd_lift_lanes<Int, G>(v, x + 4 * y, 16);
+		}
+	}
+	template<typename Int, unsigned Dim, size_t G>
+	UNIVERSAL_KERNEL_INLINE void inv_xform_lanes(Int* v) noexcept {
+		if constexpr (Dim == 1) {
+			inv_lift_lanes<Int, G>(v, 0, 1);
+		}
+		else if constexpr (Dim == 2) {
+			for (unsigned x = 0; x < 4; ++x) inv_lift_lanes<Int, G>(v, x, 4);
+			for (unsigned y = 0; y < 4; ++y) inv_lift_lanes<Int, G>(v, 4 * y, 1);
+		}
+		else {
+			for (unsigned y = 0; y < 4; ++y)
+				for (unsigned x = 0; x < 4; ++x) inv_lift_lanes<Int, G>(v, x + 4 * y, 16);
+			for (unsigned z = 0; z < 4; ++z)
+				for (unsigned x = 0; x < 4; ++x) inv_lift_lanes<Int, G>(v, x + 16 * z, 4);
+			for (unsigned z = 0; z < 4; ++z)
+				for (unsigned y = 0; y < 4; ++y) inv_lift_lanes<Int, G>(v, 4 * y + 16 * z, 1);
+		}
+	}
+
+	// Forward transform of G blocks: block-float conversion, lifting, reordering, and negabinary.
+	// fblocks holds G consecutive blocks; ublocks receives G blocks of ordered negabinary coefficients.
+	template<typename Real, unsigned Dim, size_t G>
+	UNIVERSAL_KERNEL_INLINE void forward_body(const Real* fblocks, typename zfp_type_traits<Real>::UInt* ublocks, int* emax, block_kind* kind) noexcept {
+		using Traits = zfp_type_traits<Real>;
+		using Int = typename Traits::Int;
+		using UInt = typename Traits::UInt;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		const auto& perm = zfp_perm<Dim>();
+
+		Real scale[G];
+		for (size_t g = 0; g < G; ++g) {
+			const Real* f = fblocks + g * N;
+			Real amax = 0;
+			bool finite = true;
+			for (size_t i = 0; i < N; ++i) {
+				Real a = std::fabs(f[i]);
+				finite = finite && (a <= std::numeric_limits<Real>::max());
+				amax = (a > amax) ? a : amax;
+			}
+			scale[g] = 0;
+			emax[g] = 0;
+			if (!finite) {
+				kind[g] = block_kind::reference;
+			}
+			else if (amax == 0) {
+				kind[g] = block_kind::zero;
+			}
+			else {
+				emax[g] = frexp_exponent(amax);
+				scale[g] = exp2_normal<Real>(Traits::frac_bits - emax[g]);
+				kind[g] = (scale[g] != 0) ? block_kind::fast : block_kind::reference;
+			}
+		}
+
+		alignas(64) Int v[N * G];
+		for (size_t i = 0; i < N; ++i) {
+			for (size_t g = 0; g < G; ++g) v[i * G + g] = static_cast<Int>(fblocks[g * N + i] * scale[g]);
+		}
+		fwd_xform_lanes<Int, Dim, G>(v);
+		for (size_t g = 0; g < G; ++g) {
+			UInt* u = ublocks + g * N;
+			for (size_t j = 0; j < N; ++j) u[j] = int2uint<Int, UInt>(v[perm[j] * G + g]);
+		}
+	}
+
+	// Inverse transform of G blocks; blocks whose kind is zero decode to zeros
+	template<typename Real, unsigned Dim, size_t G>
+	UNIVERSAL_KERNEL_INLINE void inverse_body(const typename zfp_type_traits<Real>::UInt* ublocks, const int* emax, const block_kind* kind, Real* fblocks) noexcept {
+		using Traits = zfp_type_traits<Real>;
+		using Int = typename Traits::Int;
+		using UInt = typename Traits::UInt;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		const auto& perm = zfp_perm<Dim>();
+
+		alignas(64) Int v[N * G];
+		for (size_t g = 0; g < G; ++g) {
+			const UInt* u = ublocks + g * N;
+			for (size_t j = 0; j < N; ++j) v[perm[j] * G + g] = uint2int<Int, UInt>(u[j]);
+		}
+		inv_xform_lanes<Int, Dim, G>(v);
+		for (size_t g = 0; g < G; ++g) {
+			Real* f = fblocks + g * N;
+			if (kind[g] == block_kind::zero) {
+				for (size_t i = 0; i < N; ++i) f[i] = Real(0);
+				continue;
+			}
+			Real s = exp2_normal<Real>(emax[g] - Traits::frac_bits);
+			if (s != 0) {
+				for (size_t i = 0; i < N; ++i) f[i] = static_cast<Real>(v[i * G + g]) * s;
+			}
+			else {
+				for (size_t i = 0; i < N; ++i) f[i] = std::ldexp(static_cast<Real>(v[i * G + g]), emax[g] - Traits::frac_bits);
+			}
+		}
+	}
+
+	template<typename Real>
+	using forward_kernel = void(const Real*, typename zfp_type_traits<Real>::UInt*, int*, block_kind*);
+	template<typename Real>
+	using inverse_kernel = void(const typename zfp_type_traits<Real>::UInt*, const int*, const block_kind*, Real*);
+
+	template<typename Real, unsigned Dim>
+	void forward_scalar(const Real* f, typename zfp_type_traits<Real>::UInt* u, int* e, block_kind* k) noexcept {
+		forward_body<Real, Dim, lanes<Real>>(f, u, e, k);
+	}
+	template<typename Real, unsigned Dim>
+	UNIVERSAL_TARGET_AVX2 void forward_avx2(const Real* f, typename zfp_type_traits<Real>::UInt* u, int* e, block_kind* k) noexcept {
+		forward_body<Real, Dim, lanes<Real>>(f, u, e, k);
+	}
+	template<typename Real, unsigned Dim>
+	UNIVERSAL_TARGET_AVX512 void forward_avx512(const Real* f, typename zfp_type_traits<Real>::UInt* u, int* e, block_kind* k) noexcept {
+		forward_body<Real, Dim, lanes<Real>>(f, u, e, k);
+	}
+	template<typename Real, unsigned Dim>
+	void inverse_scalar(const typename zfp_type_traits<Real>::UInt* u, const int* e, const block_kind* k, Real* f) noexcept {
+		inverse_body<Real, Dim, lanes<Real>>(u, e, k, f);
+	}
+	template<typename Real, unsigned Dim>
+	UNIVERSAL_TARGET_AVX2 void inverse_avx2(const typename zfp_type_traits<Real>::UInt* u, const int* e, const block_kind* k, Real* f) noexcept {
+		inverse_body<Real, Dim, lanes<Real>>(u, e, k, f);
+	}
+	template<typename Real, unsigned Dim>
+	UNIVERSAL_TARGET_AVX512 void inverse_avx512(const typename zfp_type_traits<Real>::UInt* u, const int* e, const block_kind* k, Real* f) noexcept {
+		inverse_body<Real, Dim, lanes<Real>>(u, e, k, f);
+	}
+
+	template<typename Real, unsigned Dim>
+	const kernel_table<forward_kernel<Real>>& forward_kernels() noexcept {
+		static const kernel_table<forward_kernel<Real>> table = [] {
+			kernel_table<forward_kernel<Real>> t(forward_scalar<Real, Dim>);
+			t.register_kernel(isa::avx2, forward_avx2<Real, Dim>);
+			t.register_kernel(isa::avx512, forward_avx512<Real, Dim>);
+			return t;
+		}();
+		return table;
+	}
+	template<typename Real, unsigned Dim>
+	const kernel_table<inverse_kernel<Real>>& inverse_kernels() noexcept {
+		static const kernel_table<inverse_kernel<Real>> table = [] {
+			kernel_table<inverse_kernel<Real>> t(inverse_scalar<Real, Dim>);
+			t.register_kernel(isa::avx2, inverse_avx2<Real, Dim>);
+			t.register_kernel(isa::avx512, inverse_avx512<Real, Dim>);
+			return t;
+		}();
+		return table;
+	}
+
+	// the reference forward transform of one block, for the blocks the fast conversion declines
+	template<typename Real, unsigned Dim>
+	inline bool reference_forward(const Real* fblock, typename zfp_type_traits<Real>::UInt* ublock, int& emax) {
+		using Int = typename zfp_type_traits<Real>::Int;
+		using UInt = typename zfp_type_traits<Real>::UInt;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		Int iblock[N]{};
+		emax = fwd_cast<Real, N>(fblock, iblock);
+		bool all_zero = true;
+		for (size_t i = 0; i < N; ++i) all_zero = all_zero && (iblock[i] == 0);
+		fwd_xform<Int, Dim>(iblock);
+		const auto& perm = zfp_perm<Dim>();
+		for (size_t j = 0; j < N; ++j) ublock[j] = int2uint<Int, UInt>(iblock[perm[j]]);
+		return !all_zero;
+	}
+
+	// bytes of the longest code, and two words of slack: the header, every bit plane, a group test per
+	// coefficient and a closing test per plane. Codes are staged in a local buffer of this size, so the
+	// bit stream loads and stores whole words
+	template<typename Real, unsigned Dim>
+	constexpr size_t staging_bytes = (1 + zfp_type_traits<Real>::ebits + (zfp_block_size<Dim>::value + 1) * (CHAR_BIT * sizeof(typename zfp_type_traits<Real>::UInt) + 1) + 7) / 8 + 16;
+
+	// the code of one transformed block: the layout of encode_block
+	template<typename Real, unsigned Dim>
+	inline size_t encode_code(const typename zfp_type_traits<Real>::UInt* ublock, int emax, bool nonzero,
+	                          uint8_t* buffer, size_t max_bytes, unsigned maxprec, size_t maxbits) noexcept {
+		using Traits = zfp_type_traits<Real>;
+		using UInt = typename Traits::UInt;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		constexpr size_t header_bits = 1 + Traits::ebits;
+		constexpr size_t capacity = staging_bytes<Real, Dim>;
+
+		auto encode_into = [&](uint8_t* dst, size_t dst_bytes) noexcept {
+			word_writer out(dst, dst_bytes);
+			if (!nonzero || maxbits < header_bits) {
+				out.put(0, 1);
+			}
+			else {
+				// the biased exponent is cut to ebits, as zfp_bitstream::write_bits cuts it
+				uint64_t biased = static_cast<unsigned>(emax + Traits::ebias) & lowmask(Traits::ebits);
+				out.put(1u | (biased << 1), 1 + Traits::ebits);
+				encode_planes<UInt, N>(out, ublock, maxprec, maxbits - header_bits);
+			}
+			out.pad_to(maxbits);
+			out.flush();
+			return out.bits();
+		};
+
+		// every code is padded to maxbits, and a zero block takes one bit
+		size_t code_bytes = ((maxbits > 0 ? maxbits : 1) + 7) / 8;
+		size_t bytes = code_bytes < max_bytes ? code_bytes : max_bytes;
+		if (bytes + 16 > capacity) return encode_into(buffer, max_bytes);
+		uint8_t local[capacity];
+		size_t bits = encode_into(local, capacity);
+		std::memcpy(buffer, local, bytes);
+		return bits;
+	}
+
+	// the coefficients of one block code; false for a zero block
+	template<typename Real, unsigned Dim>
+	inline bool decode_code(const uint8_t* buffer, size_t max_bytes, typename zfp_type_traits<Real>::UInt* ublock,
+	                        int& emax, unsigned maxprec, size_t maxbits) noexcept {
+		using Traits = zfp_type_traits<Real>;
+		using UInt = typename Traits::UInt;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		constexpr size_t header_bits = 1 + Traits::ebits;
+		constexpr size_t capacity = staging_bytes<Real, Dim>;
+
+		// the decoder reads the header, and no further than maxbits or the last bit plane
+		size_t reach = maxbits > header_bits ? maxbits : header_bits;
+		if (reach > (capacity - 16) * 8) reach = (capacity - 16) * 8;
+		size_t bytes = (reach + 7) / 8 < max_bytes ? (reach + 7) / 8 : max_bytes;
+		uint8_t local[capacity];
+		std::memcpy(local, buffer, bytes);
+		std::memset(local + bytes, 0, (reach + 7) / 8 + 16 - bytes);   // past the buffer the code reads as zeros
+
+		word_reader in(local);
+		uint64_t header = in.get(1 + Traits::ebits);
+		if ((header & 1u) == 0) {
+			emax = 0;
+			return false;
+		}
+		emax = static_cast<int>(header >> 1) - Traits::ebias;
+		decode_planes<UInt, N>(in, ublock, maxprec, maxbits > header_bits ? maxbits - header_bits : 0);
+		return true;
+	}
+
+} // namespace zfp_fast
+
+// Encode nblocks consecutive blocks of 4^Dim values; the code of block b goes to dst + b * stride_bytes,
+// truncated to stride_bytes like encode_block truncates to max_bytes
+template<typename Real, unsigned Dim>
+inline void encode_blocks_fast(const Real* src, size_t nblocks, uint8_t* dst, size_t stride_bytes,
+                               unsigned maxprec, size_t maxbits) {
+	using UInt = typename zfp_type_traits<Real>::UInt;
+	using zfp_fast::block_kind;
+	constexpr size_t N = zfp_block_size<Dim>::value;
+	constexpr size_t G = zfp_fast::lanes<Real>;
+
+	auto forward = zfp_fast::forward_kernels<Real, Dim>().resolve();
+	alignas(64) UInt ublocks[G * N];
+	int emax[G];
+	block_kind kind[G];
+	Real tail[G * N];
+	for (size_t b = 0; b < nblocks; b += G) {
+		size_t count = (nblocks - b < G) ? nblocks - b : G;
+		const Real* f = src + b * N;
+		if (count < G) {
+			for (size_t i = 0; i < G * N; ++i) tail[i] = (i < count * N) ? f[i] : Real(0);
+			f = tail;
+		}
+		forward(f, ublocks, emax, kind);
+		for (size_t g = 0; g < count; ++g) {
+			bool nonzero = (kind[g] == block_kind::fast);
+			if (kind[g] == block_kind::reference) nonzero = zfp_fast::reference_forward<Real, Dim>(f + g * N, ublocks + g * N, emax[g]);
+			zfp_fast::encode_code<Real, Dim>(ublocks + g * N, emax[g], nonzero, dst + (b + g) * stride_bytes, stride_bytes, maxprec, maxbits);
+		}
+	}
+}
+
+// Decode nblocks consecutive block codes, stride_bytes apart, into consecutive blocks of 4^Dim values
+template<typename Real, unsigned Dim>
+inline void decode_blocks_fast(const uint8_t* src, size_t nblocks, size_t stride_bytes, Real* dst,
+                               unsigned maxprec, size_t maxbits) {
+	using UInt = typename zfp_type_traits<Real>::UInt;
+	using zfp_fast::block_kind;
+	constexpr size_t N = zfp_block_size<Dim>::value;
+	constexpr size_t G = zfp_fast::lanes<Real>;
+
+	auto inverse = zfp_fast::inverse_kernels<Real, Dim>().resolve();
+	alignas(64) UInt ublocks[G * N];
+	int emax[G];
+	block_kind kind[G];
+	Real tail[G * N];
+	for (size_t b = 0; b < nblocks; b += G) {
+		size_t count = (nblocks - b < G) ? nblocks - b : G;
+		for (size_t g = 0; g < G; ++g) {
+			bool nonzero = (g < count) && zfp_fast::decode_code<Real, Dim>(src + (b + g) * stride_bytes, stride_bytes, ublocks + g * N, emax[g], maxprec, maxbits);
+			kind[g] = nonzero ? block_kind::fast : block_kind::zero;
+			if (!nonzero) for (size_t i = 0; i < N; ++i) ublocks[g * N + i] = 0;
+		}
+		Real* f = (count < G) ? tail : dst + b * N;
+		inverse(ublocks, emax, kind, f);
+		if (count < G) std::memcpy(dst + b * N, tail, count * N * sizeof(Real));
+	}
+}
+
+// Encode one block of 4^Dim values, with the result and the bytes of encode_block
+template<typename Real, unsigned Dim>
+inline size_t encode_block_fast(const Real* fblock, uint8_t* buffer, size_t max_bytes,
+                                unsigned maxprec, size_t maxbits) {
+	using UInt = typename zfp_type_traits<Real>::UInt;
+	using zfp_fast::block_kind;
+	constexpr size_t N = zfp_block_size<Dim>::value;
+
+	UInt ublock[N];
+	int emax{ 0 };
+	block_kind kind{ block_kind::zero };
+	zfp_fast::forward_body<Real, Dim, 1>(fblock, ublock, &emax, &kind);
+	bool nonzero = (kind == block_kind::fast);
+	if (kind == block_kind::reference) nonzero = zfp_fast::reference_forward<Real, Dim>(fblock, ublock, emax);
+	return zfp_fast::encode_code<Real, Dim>(ublock, emax, nonzero, buffer, max_bytes, maxprec, maxbits);
+}
+
+// Decode one block of 4^Dim values, with the result of decode_block
+template<typename Real, unsigned Dim>
+inline size_t decode_block_fast(const uint8_t* buffer, size_t max_bytes, Real* fblock,
+                                unsigned maxprec, size_t maxbits) {
+	using UInt = typename zfp_type_traits<Real>::UInt;
+	using zfp_fast::block_kind;
+	constexpr size_t N = zfp_block_size<Dim>::value;
+
+	UInt ublock[N]{};
+	int emax{ 0 };
+	bool nonzero = zfp_fast::decode_code<Real, Dim>(buffer, max_bytes, ublock, emax, maxprec, maxbits);
+	block_kind kind = nonzero ? block_kind::fast : block_kind::zero;
+	zfp_fast::inverse_body<Real, Dim, 1>(ublock, &emax, &kind, fblock);
+	return maxbits > 0 ? maxbits : (nonzero ? 1 + zfp_type_traits<Real>::ebits : 1);
+}
+
+}} // namespace sw::universal
@@ -18,6 +18,9 @@
 // C++20's rule that constexpr allocations not persist beyond the constant
 // expression.  Static-storage `constexpr zfparray` instances are not
 // supported (because their vector would persist).
+//
+// At run time the blocks go through the fast codec of zfp_codec_fast.hpp,
+// whole arrays in batches, which produces the bytes of the constexpr codec.
 
 #include <cstdint>
 #include <cstddef>
@@ -29,6 +32,7 @@
 #include <universal/number/zfpblock/zfparray_fwd.hpp>
 #include <universal/number/zfpblock/zfp_codec_traits.hpp>
 #include <universal/number/zfpblock/zfp_codec.hpp>
+#include <universal/number/zfpblock/zfp_codec_fast.hpp>
 
 namespace sw { namespace universal {
 
@@ -141,6 +145,19 @@ public:
 		size_t bpb = bytes_per_block();
 		size_t maxbits = static_cast<size_t>(_rate * BLOCK_SIZE);
 
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			// whole blocks straight from src, the partial last block zero-padded
+			unsigned maxprec = zfp_type_traits<Real>::precision_bits;
+			size_t whole = _n / BLOCK_SIZE;
+			encode_blocks_fast<Real, Dim>(src, whole, _store.data(), bpb, maxprec, maxbits);
+			if (whole < nblk) {
+				Real block_data[BLOCK_SIZE]{};
+				std::copy(src + whole * BLOCK_SIZE, src + _n, block_data);
+				encode_block_fast<Real, Dim>(block_data, _store.data() + whole * bpb, bpb, maxprec, maxbits);
+			}
+			return;
+		}
+
 		for (size_t b = 0; b < nblk; ++b) {
 			Real block_data[BLOCK_SIZE]{};
 
@@ -167,6 +184,19 @@ public:
 		size_t bpb = bytes_per_block();
 		size_t maxbits = static_cast<size_t>(_rate * BLOCK_SIZE);
 
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			// the fast decoder reads zeros past bpb, so the blocks decode in place
+			unsigned maxprec = zfp_type_traits<Real>::precision_bits;
+			size_t whole = _n / BLOCK_SIZE;
+			decode_blocks_fast<Real, Dim>(_store.data(), whole, bpb, dst, maxprec, maxbits);
+			if (whole < nblk) {
+				Real block_data[BLOCK_SIZE]{};
+				decode_block_fast<Real, Dim>(_store.data() + whole * bpb, bpb, block_data, maxprec, maxbits);
+				std::copy(block_data, block_data + (_n - whole * BLOCK_SIZE), dst + whole * BLOCK_SIZE);
+			}
+			return;
+		}
+
 		for (size_t b = 0; b < nblk; ++b) {
 			Real block_data[BLOCK_SIZE]{};
 			unsigned maxprec = zfp_type_traits<Real>::precision_bits;
@@ -291,9 +321,14 @@ private:
 		size_t maxbits = static_cast<size_t>(_rate * BLOCK_SIZE);
 		unsigned maxprec = zfp_type_traits<Real>::precision_bits;
 
-		uint8_t temp[MAX_BYTES]{};
-		for (size_t i = 0; i < bpb; ++i) temp[i] = _store[block_idx * bpb + i];
-		decode_block<Real, Dim>(temp, MAX_BYTES, _cache, maxprec, maxbits);
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			decode_block_fast<Real, Dim>(_store.data() + block_idx * bpb, bpb, _cache, maxprec, maxbits);
+		}
+		else {
+			uint8_t temp[MAX_BYTES]{};
+			for (size_t i = 0; i < bpb; ++i) temp[i] = _store[block_idx * bpb + i];
+			decode_block<Real, Dim>(temp, MAX_BYTES, _cache, maxprec, maxbits);
+		}
 
 		_cached_block = block_idx;
 		_dirty = false;
@@ -318,6 +353,11 @@ private:
 			}
 		}
 
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			encode_block_fast<Real, Dim>(padded, _store.data() + _cached_block * bpb, bpb, maxprec, maxbits);
+			return;
+		}
+
 		uint8_t temp[MAX_BYTES]{};
 		encode_block<Real, Dim>(padded, temp, MAX_BYTES, maxprec, maxbits);
 
@@ -0,0 +1,571 @@
+#pragma once
+// zfparray_stream.hpp: streaming, out-of-core storage for zfparray compressed blocks
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// zfparray holds its whole compressed store in memory and compresses or decompresses the full array
+// at once. The classes in this header keep the same fixed-rate blocks in a file or in a caller
+// provided memory region instead, so a field larger than memory can be compressed chunk by chunk as
+// it is produced, and decoded block by block where it is consumed:
+//
+//   zfparray_writer<Real, Dim>   appends elements, or the blocks of a zfparray, to a file or region
+//   zfparray_reader<Real, Dim>   maps a file, or views a region, and decodes blocks from the mapping
+//   zfparray_sweep<Real, Dim>    a range of decoded blocks, optionally filled by a prefetch thread
+//
+// The storage is a 48-byte header followed by the blocks, each bytes_per_block() bytes, exactly as
+// zfparray::data() lays them out, so block b starts at byte 48 + b * bytes_per_block():
+//
+//   offset  size  field
+//        0     8  magic "UNVZFPAR"
+//        8     4  format version
+//       12     4  sizeof(Real), 4 or 8
+//       16     4  Dim
+//       20     4  bytes per block
+//       24     8  rate in bits per value, IEEE double
+//       32     8  element count
+//       40     8  reserved, zero
+//
+// All fields are little-endian. Like zfparray, an array of Dim 2 or 3 is a sequence of 4^Dim element
+// blocks of consecutive elements. The writer updates the element count after every append(), to
+// the elements of the whole blocks written so far, and to the exact count in close(), which encodes
+// the zero-padded partial block. A reader of a file that is still being written sees every block
+// that was complete when it was mapped, and refresh() maps it again to see the blocks appended since.
+//
+// Usage:
+//   #include <universal/number/zfpblock/zfpblock.hpp>
+//   #include <universal/number/zfpblock/zfparray_stream.hpp>
+//
+//   zfparray_writer<double, 3> out("pressure.zfp", 16.0);
+//   for (auto& slab : simulation) out.append(slab.data(), slab.size());
+//   out.close();
+//
+//   zfparray_reader<double, 3> in("pressure.zfp");
+//   for (const auto& block : in.sweep()) consume(block.index, block.values);
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <universal/utility/bit_cast.hpp>
+#include <universal/utility/mapped_file.hpp>
+#include <universal/number/zfpblock/exceptions.hpp>
+#include <universal/number/zfpblock/zfparray.hpp>
+
+namespace sw { namespace universal {
+
+struct zfparray_io_error : public zfpblock_internal_exception {
+	explicit zfparray_io_error(const std::string& error = "zfparray storage error")
+		: zfpblock_internal_exception(error) {}
+};
+
+namespace zfparray_stream_detail {
+
+	constexpr char          magic[8]       = { 'U', 'N', 'V', 'Z', 'F', 'P', 'A', 'R' };
+	constexpr std::uint32_t format_version = 1;
+	constexpr std::size_t   header_size    = 48;
+	constexpr std::size_t   count_offset   = 32;
+
+	inline void store_le(std::uint8_t* p, std::uint64_t v, unsigned bytes) noexcept {
+		for (unsigned i = 0; i < bytes; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+	}
+	inline std::uint64_t load_le(const std::uint8_t* p, unsigned bytes) noexcept {
+		std::uint64_t v{ 0 };
+		for (unsigned i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+		return v;
+	}
+
+	// fixed-rate block geometry of a zfparray<Real, Dim> at a rate
+	template<typename Real, unsigned Dim>
+	struct geometry {
+		static constexpr std::size_t BLOCK_SIZE = zfp_block_size<Dim>::value;
+		static constexpr unsigned    maxprec    = zfp_type_traits<Real>::precision_bits;
+
+		double      rate    = 0.0;
+		std::size_t maxbits = 0;
+		std::size_t bpb     = 0;   // bytes per block
+
+		geometry() = default;
+		explicit geometry(double r)
+			: rate(r), maxbits(static_cast<std::size_t>(r * BLOCK_SIZE)), bpb((maxbits + 7) / 8) {}
+
+		// encode nblk blocks of BLOCK_SIZE values at src into bpb bytes each at dst
+		void encode(const Real* src, std::size_t nblk, std::uint8_t* dst) const {
+			if constexpr (ZFPBLOCK_FAST_CODEC) {
+				encode_blocks_fast<Real, Dim>(src, nblk, dst, bpb, maxprec, maxbits);
+			}
+			else {
+				for (std::size_t b = 0; b < nblk; ++b) encode_block<Real, Dim>(src + b * BLOCK_SIZE, dst + b * bpb, bpb, maxprec, maxbits);
+			}
+		}
+		// decode nblk blocks of bpb bytes at src into BLOCK_SIZE values each at dst; the codec reads zeros past bpb
+		void decode(const std::uint8_t* src, std::size_t nblk, Real* dst) const {
+			if constexpr (ZFPBLOCK_FAST_CODEC) {
+				decode_blocks_fast<Real, Dim>(src, nblk, bpb, dst, maxprec, maxbits);
+			}
+			else {
+				for (std::size_t b = 0; b < nblk; ++b) decode_block<Real, Dim>(src + b * bpb, bpb, dst + b * BLOCK_SIZE, maxprec, maxbits);
+			}
+		}
+		void encode(const Real* src, std::uint8_t* dst) const { encode(src, 1, dst); }
+		void decode(const std::uint8_t* src, Real* dst) const { decode(src, 1, dst); }
+	};
+
+	template<typename Real, unsigned Dim>
+	void write_header(std::uint8_t* p, const geometry<Real, Dim>& g, std::uint64_t count) {
+		std::memset(p, 0, header_size);
+		std::memcpy(p, magic, sizeof(magic));
+		store_le(p + 8, format_version, 4);
+		store_le(p + 12, sizeof(Real), 4);
+		store_le(p + 16, Dim, 4);
+		store_le(p + 20, g.bpb, 4);
+		store_le(p + 24, sw::bit_cast<std::uint64_t>(g.rate), 8);
+		store_le(p + count_offset, count, 8);
+	}
+
+	// validate the header against zfparray<Real, Dim>, and return the geometry and element count
+	template<typename Real, unsigned Dim>
+	geometry<Real, Dim> read_header(const std::uint8_t* p, std::size_t bytes, std::uint64_t& count) {
+		if (bytes < header_size || std::memcmp(p, magic, sizeof(magic)) != 0) {
+			throw zfparray_io_error("zfparray storage: missing header");
+		}
+		if (load_le(p + 8, 4) != format_version) {
+			throw zfparray_io_error("zfparray storage: unsupported format version " + std::to_string(load_le(p + 8, 4)));
+		}
+		if (load_le(p + 12, 4) != sizeof(Real) || load_le(p + 16, 4) != Dim) {
+			throw zfparray_io_error("zfparray storage: stored as " + std::to_string(load_le(p + 16, 4)) + "D blocks of "
+				+ std::to_string(8 * load_le(p + 12, 4)) + "-bit values, requested " + std::to_string(Dim) + "D blocks of "
+				+ std::to_string(8 * sizeof(Real)) + "-bit values");
+		}
+		geometry<Real, Dim> g(sw::bit_cast<double>(load_le(p + 24, 8)));
+		if (g.bpb == 0 || load_le(p + 20, 4) != g.bpb) {
+			throw zfparray_io_error("zfparray storage: block size does not match the rate");
+		}
+		count = load_le(p + count_offset, 8);
+		return g;
+	}
+
+} // namespace zfparray_stream_detail
+
+/// <summary>
+/// zfparray_writer compresses a stream of elements into fixed-rate ZFP blocks and appends them to a
+/// file or to a caller provided memory region, such as a writable mapping. Elements that do not
+/// fill a block wait for the next append(); close() encodes them zero-padded.
+/// </summary>
+template<typename Real, unsigned Dim>
+class zfparray_writer {
+	using geometry = zfparray_stream_detail::geometry<Real, Dim>;
+public:
+	static constexpr std::size_t BLOCK_SIZE = zfp_block_size<Dim>::value;
+
+	// create, or truncate, the file at path
+	zfparray_writer(const std::string& path, double rate)
+		: _g(check_rate(rate)), _file(path, std::ios::binary | std::ios::trunc) {
+		if (!_file) throw zfparray_io_error("zfparray_writer: cannot create " + path);
+		std::uint8_t header[zfparray_stream_detail::header_size];
+		zfparray_stream_detail::write_header(header, _g, 0);
+		_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		if (!_file.flush()) throw zfparray_io_error("zfparray_writer: cannot write " + path);
+	}
+	// write into region, which must hold required_bytes() for the elements that will be appended
+	zfparray_writer(std::span<std::uint8_t> region, double rate)
+		: _g(check_rate(rate)), _region(region) {
+		if (_region.size() < zfparray_stream_detail::header_size) throw zfparray_io_error("zfparray_writer: region too small for the header");
+		zfparray_stream_detail::write_header(_region.data(), _g, 0);
+	}
+	zfparray_writer(const zfparray_writer&) = delete;
+	zfparray_writer& operator=(const zfparray_writer&) = delete;
+	~zfparray_writer() {
+		try { close(); }
+		catch (...) {}
+	}
+
+	// bytes of storage for n elements at rate
+	static std::size_t required_bytes(std::size_t n, double rate) {
+		return zfparray_stream_detail::header_size + ((n + BLOCK_SIZE - 1) / BLOCK_SIZE) * geometry(rate).bpb;
+	}
+
+	// compress and append n elements
+	void append(const Real* src, std::size_t n) {
+		if (_closed) throw zfparray_io_error("zfparray_writer: append after close");
+		_size += n;
+		// complete a pending partial block first
+		if (_npending > 0) {
+			std::size_t take = std::min(n, BLOCK_SIZE - _npending);
+			std::copy(src, src + take, _pending + _npending);
+			_npending += take;
+			src += take;
+			n -= take;
+			if (_npending < BLOCK_SIZE) return;
+			emit_blocks(_pending, 1);
+			_npending = 0;
+		}
+		std::size_t nblk = n / BLOCK_SIZE;
+		if (nblk > 0) emit_blocks(src, nblk);
+		_npending = n - nblk * BLOCK_SIZE;
+		std::copy(src + nblk * BLOCK_SIZE, src + n, _pending);
+		publish_count(_nblocks * BLOCK_SIZE);
+	}
+	void append(std::span<const Real> src) { append(src.data(), src.size()); }
+
+	// append the elements of a zfparray: when the rates match and no partial block is pending, its
+	// whole blocks are copied without recompression and the elements of a partial last block become
+	// pending; otherwise all its elements are recompressed
+	void append(const zfparray<Real, Dim>& a) {
+		if (_closed) throw zfparray_io_error("zfparray_writer: append after close");
+		if (_npending == 0 && a.rate() == _g.rate) {
+			_size += a.size();
+			a.flush();
+			std::size_t whole = a.size() / BLOCK_SIZE;
+			if (whole > 0) emit_bytes(a.data(), whole);
+			if (whole * BLOCK_SIZE < a.size()) {
+				// the partial last block continues as pending elements
+				Real block[BLOCK_SIZE]{};
+				_g.decode(a.data() + whole * _g.bpb, block);
+				_npending = a.size() - whole * BLOCK_SIZE;
+				std::copy(block, block + _npending, _pending);
+			}
+			publish_count(_nblocks * BLOCK_SIZE);
+			return;
+		}
+		std::vector<Real> values(a.size());
+		a.decompress(values.data());
+		append(values.data(), values.size());
+	}
+
+	// encode the pending partial block, zero padded, and record the exact element count
+	void close() {
+		if (_closed) return;
+		_closed = true;
+		if (_npending > 0) {
+			for (std::size_t i = _npending; i < BLOCK_SIZE; ++i) _pending[i] = Real(0);
+			emit_blocks(_pending, 1);
+			_npending = 0;
+		}
+		publish_count(_size);
+		if (_file.is_open()) _file.close();
+	}
+
+	std::size_t size() const noexcept { return _size; }            // elements appended
+	std::size_t num_blocks() const noexcept { return _nblocks; }   // blocks written
+	double      rate() const noexcept { return _g.rate; }
+	std::size_t bytes_per_block() const noexcept { return _g.bpb; }
+	std::size_t bytes_written() const noexcept { return zfparray_stream_detail::header_size + _nblocks * _g.bpb; }
+
+private:
+	static constexpr std::size_t STAGING_BLOCKS = 256;   // blocks encoded per file write
+
+	geometry                 _g;
+	std::ofstream            _file;
+	std::span<std::uint8_t>  _region{};
+	std::vector<std::uint8_t> _staging{};
+	Real                     _pending[BLOCK_SIZE]{};
+	std::size_t              _npending = 0;
+	std::size_t              _nblocks  = 0;
+	std::size_t              _size     = 0;
+	bool                     _closed   = false;
+
+	static double check_rate(double rate) {
+		if (!(rate > 0.0) || static_cast<std::size_t>(rate * BLOCK_SIZE) == 0) {
+			throw zfparray_io_error("zfparray_writer: rate must give at least one bit per block");
+		}
+		return rate;
+	}
+
+	// the storage of the next nblk blocks: in the region, or in the staging buffer of the file
+	std::uint8_t* reserve(std::size_t nblk) {
+		if (_file.is_open()) {
+			_staging.resize(nblk * _g.bpb);
+			return _staging.data();
+		}
+		if (bytes_written() + nblk * _g.bpb > _region.size()) throw zfparray_io_error("zfparray_writer: region is full");
+		return _region.data() + bytes_written();
+	}
+	void commit(std::size_t nblk) {
+		if (_file.is_open()) {
+			_file.write(reinterpret_cast<const char*>(_staging.data()), static_cast<std::streamsize>(nblk * _g.bpb));
+			if (!_file) throw zfparray_io_error("zfparray_writer: write failed");
+		}
+		_nblocks += nblk;
+	}
+
+	void emit_blocks(const Real* src, std::size_t nblk) {
+		while (nblk > 0) {
+			std::size_t batch = std::min(nblk, STAGING_BLOCKS);
+			std::uint8_t* dst = reserve(batch);
+			_g.encode(src, batch, dst);
+			commit(batch);
+			src += batch * BLOCK_SIZE;
+			nblk -= batch;
+		}
+	}
+	void emit_bytes(const std::uint8_t* src, std::size_t nblk) {
+		while (nblk > 0) {
+			std::size_t batch = std::min(nblk, STAGING_BLOCKS);
+			std::memcpy(reserve(batch), src, batch * _g.bpb);
+			commit(batch);
+			src += batch * _g.bpb;
+			nblk -= batch;
+		}
+	}
+
+	// record count in the header once the blocks it covers are in the storage
+	void publish_count(std::uint64_t count) {
+		std::uint8_t field[8];
+		zfparray_stream_detail::store_le(field, count, 8);
+		if (_file.is_open()) {
+			_file.flush();
+			_file.seekp(static_cast<std::streamoff>(zfparray_stream_detail::count_offset));
+			_file.write(reinterpret_cast<const char*>(field), sizeof(field));
+			_file.seekp(0, std::ios::end);
+			if (!_file.flush()) throw zfparray_io_error("zfparray_writer: write failed");
+		}
+		else {
+			std::memcpy(_region.data() + zfparray_stream_detail::count_offset, field, sizeof(field));
+		}
+	}
+};
+
+/// <summary>
+/// zfparray_sweep is an input range over the decoded blocks [first, last) of a zfparray storage.
+/// Blocks are decoded in batches of about BATCH_ELEMENTS elements. With a prefetch depth, a
+/// background thread decodes up to that many batches ahead of the consumer and hands them over
+/// once per batch; with depth 0 each batch is decoded when the iterator reaches it. The storage
+/// must outlive the sweep, which can be iterated once.
+/// </summary>
+template<typename Real, unsigned Dim>
+class zfparray_sweep {
+	using geometry = zfparray_stream_detail::geometry<Real, Dim>;
+public:
+	static constexpr std::size_t BLOCK_SIZE     = zfp_block_size<Dim>::value;
+	static constexpr std::size_t BATCH_ELEMENTS = 1024;
+	static constexpr std::size_t BATCH_BLOCKS   = (BATCH_ELEMENTS + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	struct block {
+		std::size_t          index;    // block index in the array
+		std::span<const Real> values;  // its elements, fewer than BLOCK_SIZE for a partial last block
+	};
+
+	class iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type        = block;
+		using difference_type   = std::ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(zfparray_sweep* s) : _s(s) {}
+		block operator*() const { return _s->current(); }
+		iterator& operator++() { _s->advance(); return *this; }
+		void operator++(int) { _s->advance(); }
+		bool operator==(std::default_sentinel_t) const { return _s == nullptr || _s->done(); }
+	private:
+		zfparray_sweep* _s = nullptr;
+	};
+
+	zfparray_sweep(const std::uint8_t* blocks, const geometry& g, std::size_t n, std::size_t first, std::size_t last, unsigned prefetch)
+		: _blocks(blocks), _g(g), _n(n), _first(first), _count(last > first ? last - first : 0),
+		  _batches((_count + BATCH_BLOCKS - 1) / BATCH_BLOCKS), _slots(prefetch + 1u),
+		  _ring(static_cast<std::size_t>(prefetch + 1u) * BATCH_BLOCKS * BLOCK_SIZE) {
+		if (prefetch > 0 && _batches > 1) _worker = std::thread([this] { produce(); });
+	}
+	zfparray_sweep(const zfparray_sweep&) = delete;
+	zfparray_sweep& operator=(const zfparray_sweep&) = delete;
+	~zfparray_sweep() {
+		if (_worker.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_cv.notify_all();
+			_worker.join();
+		}
+	}
+
+	iterator begin() {
+		if (!_started) {
+			_started = true;
+			if (_count > 0) acquire(0);
+		}
+		return iterator(this);
+	}
+	std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+	std::size_t size() const noexcept { return _count; }
+
+private:
+	const std::uint8_t*     _blocks;
+	geometry                _g;
+	std::size_t             _n;        // elements in the array
+	std::size_t             _first;
+	std::size_t             _count;    // blocks in the sweep
+	std::size_t             _batches;  // batches in the sweep
+	std::size_t             _slots;    // decoded batches held in the ring
+	std::vector<Real>       _ring;
+	std::size_t             _current  = 0;  // sweep position of the consumer, in blocks
+	bool                    _started  = false;
+
+	// shared with the prefetch thread
+	std::thread             _worker;
+	std::mutex              _mutex;
+	std::condition_variable _cv;
+	std::size_t             _produced = 0;  // batches decoded into the ring
+	std::size_t             _released = 0;  // batches the consumer is done with
+	bool                    _stop     = false;
+
+	Real* slot(std::size_t batch) noexcept { return _ring.data() + (batch % _slots) * BATCH_BLOCKS * BLOCK_SIZE; }
+	void decode(std::size_t batch) {
+		std::size_t k = batch * BATCH_BLOCKS;
+		std::size_t last = std::min(_count, k + BATCH_BLOCKS);
+		_g.decode(_blocks + (_first + k) * _g.bpb, last - k, slot(batch));
+	}
+
+	void produce() {
+		for (std::size_t batch = 0; batch < _batches; ++batch) {
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [&] { return _stop || batch - _released < _slots; });
+				if (_stop) return;
+			}
+			decode(batch);
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_produced = batch + 1;
+			}
+			_cv.notify_all();
+		}
+	}
+
+	// make a batch available to the consumer
+	void acquire(std::size_t batch) {
+		if (!_worker.joinable()) {
+			decode(batch);
+			return;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [&] { return _produced > batch; });
+	}
+	void advance() {
+		std::size_t batch = _current / BATCH_BLOCKS;
+		if (++_current >= _count || _current % BATCH_BLOCKS != 0) return;
+		if (_worker.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_released = batch + 1;
+			}
+			_cv.notify_all();
+		}
+		acquire(batch + 1);
+	}
+	bool done() const noexcept { return _current >= _count; }
+
+	block current() {
+		std::size_t index = _first + _current;
+		std::size_t valid = std::min(BLOCK_SIZE, _n - index * BLOCK_SIZE);
+		const Real* values = slot(_current / BATCH_BLOCKS) + (_current % BATCH_BLOCKS) * BLOCK_SIZE;
+		return block{ index, std::span<const Real>(values, valid) };
+	}
+};
+
+/// <summary>
+/// zfparray_reader gives random and sequential access to the blocks of a zfparray storage. A file
+/// is memory mapped, so only the blocks that are decoded are ever read; a region is used in place.
+/// Element access goes through a single-block cache, like zfparray; the storage is read-only.
+/// </summary>
+template<typename Real, unsigned Dim>
+class zfparray_reader {
+	using geometry = zfparray_stream_detail::geometry<Real, Dim>;
+public:
+	static constexpr std::size_t BLOCK_SIZE = zfp_block_size<Dim>::value;
+
+	zfparray_reader() = default;
+	explicit zfparray_reader(const std::string& path) { open(path); }
+	explicit zfparray_reader(std::span<const std::uint8_t> region) { open(region); }
+
+	void open(const std::string& path) {
+		mapped_file file(path);
+		if (!file.is_open()) throw zfparray_io_error("zfparray_reader: cannot open " + path);
+		attach(reinterpret_cast<const std::uint8_t*>(file.data()), file.size());
+		_file = std::move(file);
+		_path = path;
+	}
+	void open(std::span<const std::uint8_t> region) {
+		attach(region.data(), region.size());
+		_file.close();
+		_path.clear();
+	}
+	// map the file again, to see the blocks a writer appended since it was opened; sweeps taken
+	// before the refresh refer to the old mapping and must be finished first
+	void refresh() {
+		if (!_path.empty()) open(std::string(_path));
+	}
+
+	std::size_t size() const noexcept { return _n; }
+	std::size_t num_blocks() const noexcept { return (_n + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+	double      rate() const noexcept { return _g.rate; }
+	std::size_t bytes_per_block() const noexcept { return _g.bpb; }
+	// the compressed bytes of block b, as zfparray::data() holds them
+	const std::uint8_t* block_data(std::size_t b) const noexcept { return _blocks + b * _g.bpb; }
+
+	// decode block b into BLOCK_SIZE values; the padding of a partial last block decodes to near zero
+	void decode(std::size_t b, Real* dst) const { _g.decode(block_data(b), dst); }
+
+	// element i
+	Real operator()(std::size_t i) const {
+		std::size_t b = i / BLOCK_SIZE;
+		if (b != _cached_block) {
+			decode(b, _cache);
+			_cached_block = b;
+		}
+		return _cache[i % BLOCK_SIZE];
+	}
+
+	// decode blocks [first, last) into dst, which receives their elements from first * BLOCK_SIZE on
+	void decompress(std::size_t first, std::size_t last, Real* dst) const {
+		std::size_t whole = std::max(first, std::min(last, _n / BLOCK_SIZE));
+		if (whole > first) _g.decode(block_data(first), whole - first, dst);
+		if (whole < last) {
+			Real block[BLOCK_SIZE]{};
+			decode(whole, block);
+			std::copy(block, block + (_n - whole * BLOCK_SIZE), dst + (whole - first) * BLOCK_SIZE);
+		}
+	}
+	void decompress(Real* dst) const { decompress(0, num_blocks(), dst); }
+
+	// the decoded blocks [first, last), decoded up to prefetch batches ahead by a background thread
+	zfparray_sweep<Real, Dim> sweep(std::size_t first, std::size_t last, unsigned prefetch = 2) const {
+		if (last > num_blocks()) last = num_blocks();
+		return zfparray_sweep<Real, Dim>(_blocks, _g, _n, first, last, prefetch);
+	}
+	zfparray_sweep<Real, Dim> sweep(unsigned prefetch = 2) const { return sweep(0, num_blocks(), prefetch); }
+
+private:
+	mapped_file         _file{};
+	std::string         _path{};
+	const std::uint8_t* _blocks = nullptr;
+	geometry            _g{};
+	std::size_t         _n = 0;
+
+	mutable Real        _cache[BLOCK_SIZE] = {};
+	mutable std::size_t _cached_block      = SIZE_MAX;
+
+	void attach(const std::uint8_t* base, std::size_t bytes) {
+		std::uint64_t count{ 0 };
+		_g = zfparray_stream_detail::read_header<Real, Dim>(base, bytes, count);
+		// the blocks present in the storage bound the count of a storage that is still being written
+		std::size_t available = (bytes - zfparray_stream_detail::header_size) / _g.bpb;
+		std::size_t blocks = static_cast<std::size_t>((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		_n = (blocks <= available) ? static_cast<std::size_t>(count) : available * BLOCK_SIZE;
+		_blocks = base + zfparray_stream_detail::header_size;
+		_cached_block = SIZE_MAX;
+	}
+};
+
+}} // namespace sw::universal
@@ -16,6 +16,7 @@
 #include <universal/number/zfpblock/zfpblock_fwd.hpp>
 #include <universal/number/zfpblock/zfp_codec_traits.hpp>
 #include <universal/number/zfpblock/zfp_codec.hpp>
+#include <universal/number/zfpblock/zfp_codec_fast.hpp>
 
 namespace sw { namespace universal {
 
@@ -45,13 +46,18 @@ public:
 	// Returns the number of bits in the compressed representation.
 	// constexpr-callable: encode_block dispatches std::frexp / std::ldexp /
 	// std::memset / __builtin_ctzll via std::is_constant_evaluated() to
-	// constexpr-safe replacements at compile time (PR #815).
+	// constexpr-safe replacements at compile time (PR #815). At run time the
+	// fast codec of zfp_codec_fast.hpp writes the same bits.
 	constexpr size_t compress(const Real* src, zfp_mode mode, double param) {
 		_mode = mode;
 		_param = param;
 		unsigned maxprec = 0;
 		size_t maxbits = 0;
 		compute_limits(mode, param, maxprec, maxbits);
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			_nbits = encode_block_fast<Real, Dim>(src, _buffer, MAX_BYTES, maxprec, maxbits);
+			return _nbits;
+		}
 		_nbits = encode_block<Real, Dim>(src, _buffer, MAX_BYTES, maxprec, maxbits);
 		return _nbits;
 	}
@@ -61,6 +67,10 @@ public:
 		unsigned maxprec = 0;
 		size_t maxbits = 0;
 		compute_limits(_mode, _param, maxprec, maxbits);
+		if (!std::is_constant_evaluated() && ZFPBLOCK_FAST_CODEC) {
+			decode_block_fast<Real, Dim>(_buffer, MAX_BYTES, dst, maxprec, maxbits);
+			return;
+		}
 		decode_block<Real, Dim>(_buffer, MAX_BYTES, dst, maxprec, maxbits);
 	}
 
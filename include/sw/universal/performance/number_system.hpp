@@ -10,9 +10,10 @@
 #include <typeinfo>
 #include <random>
 #include <limits>
-#include <chrono>
+#include <string>
 #include <universal/native/ieee754.hpp>
 #include <universal/utility/scientific.hpp>
+#include <universal/benchmark/benchmark_harness.hpp>
 
 namespace sw { namespace universal {
 
@@ -298,87 +299,33 @@ namespace sw { namespace universal {
 		return nrOfFailedTests;
 	}
 
+	// run one of the Measure*Performance functions through the benchmark harness and return its operations per second
+	template<typename Scalar, typename Measurement>
+	double MeasureOperatorPerformance(const std::string& op, Scalar& number, Measurement measure) {
+		int positives{ 0 }, negatives{ 0 };
+		size_t NR_OPS = static_cast<size_t>(measure(number, positives, negatives));
+		benchmark_result result = RunBenchmark(std::string(typeid(number).name()) + ' ' + op, [&](size_t) {
+			measure(number, positives, negatives);
+			DoNotOptimize(positives);
+			DoNotOptimize(negatives);
+		}, NR_OPS);
+		return result.median;
+	}
+
 	// run and measure performance tests and generate an operator performance report
 	// The number argument is just for ADL specialization
 	template<typename Scalar>
 	void GeneratePerformanceReport(Scalar& number, OperatorPerformance &report) {
-		using namespace std;
-		using namespace std::chrono;
-		int positives, negatives;
-
-		steady_clock::time_point begin, end;
-		duration<double> time_span;
-		double elapsed;
-
-		begin = steady_clock::now();
-		    MeasureIntegerConversionPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.intconvert = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-			MeasureIeeeConversionPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.ieeeconvert = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasurePrefixPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.prefix = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasurePostfixPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.postfix = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureNegationPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.neg = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureSqrtPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.sqrt = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureAdditionPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.add = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureSubtractionPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.sub = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureMultiplicationPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.mul = (double(positives) + double(negatives)) / elapsed;
-
-		begin = steady_clock::now();
-		    MeasureDivisionPerformance(number, positives, negatives);
-		end = steady_clock::now();
-		time_span = duration_cast<duration<double>>(end - begin);
-		elapsed = time_span.count();
-		report.div = (double(positives) + double(negatives)) / elapsed;
+		report.intconvert  = MeasureOperatorPerformance("int conversion",  number, MeasureIntegerConversionPerformance<Scalar>);
+		report.ieeeconvert = MeasureOperatorPerformance("ieee conversion", number, MeasureIeeeConversionPerformance<Scalar>);
+		report.prefix      = MeasureOperatorPerformance("prefix",          number, MeasurePrefixPerformance<Scalar>);
+		report.postfix     = MeasureOperatorPerformance("postfix",         number, MeasurePostfixPerformance<Scalar>);
+		report.neg         = MeasureOperatorPerformance("negation",        number, MeasureNegationPerformance<Scalar>);
+		report.sqrt        = MeasureOperatorPerformance("sqrt",            number, MeasureSqrtPerformance<Scalar>);
+		report.add         = MeasureOperatorPerformance("add",             number, MeasureAdditionPerformance<Scalar>);
+		report.sub         = MeasureOperatorPerformance("sub",             number, MeasureSubtractionPerformance<Scalar>);
+		report.mul         = MeasureOperatorPerformance("mul",             number, MeasureMultiplicationPerformance<Scalar>);
+		report.div         = MeasureOperatorPerformance("div",             number, MeasureDivisionPerformance<Scalar>);
 	}
 
 }} // namespace sw::universal
@@ -33,6 +33,7 @@
 #include "occurrence.hpp"
 #include "range_analyzer.hpp"
 #include "memory_profiler.hpp"
+#include <universal/energy/hw_counters/perf_counters.hpp>
 
 // Forward declare energy types if available
 namespace sw { namespace universal { namespace energy {
@@ -85,6 +86,9 @@ struct AlgorithmProfile {
     double ops_per_byte;                // Arithmetic intensity
     double energy_per_op_pj;            // Average energy per operation
 
+    // Measured counters of one execution of the kernel (see AlgorithmProfiler::measureCounters)
+    energy::PerfCounts counters;
+
     AlgorithmProfile()
         : name("unknown"), precision("unknown"), bit_width(32)
         , problem_size(0), size_description("")
@@ -147,6 +151,24 @@ struct AlgorithmProfile {
         ostr << "  Memory:      " << (memory_energy_pj / 1e6) << " uJ\n";
         ostr << "  Total:       " << (total_energy_pj / 1e6) << " uJ\n";
         ostr << "  Per-op avg:  " << energy_per_op_pj << " pJ/op\n";
+
+        if (counters.valid) {
+            ostr << "\nMeasured Counters (" << energy::counterSourceName(counters.source) << "):\n";
+            ostr << "  Elapsed:       " << counters.elapsed_ms << " ms\n";
+            if (counters.hasHardware()) {
+                ostr << "  IPC:           " << counters.ipc() << "\n";
+                ostr << "  Cycles/op:     " << counters.cyclesPerOp(total_ops) << "\n";
+                ostr << "  Instr/op:      " << counters.instructionsPerOp(total_ops) << "\n";
+            }
+            if (counters.has_branch_misses) ostr << "  Branch miss/op: " << counters.branchMissesPerOp(total_ops) << "\n";
+            if (counters.has_l1d_misses)    ostr << "  L1D miss/op:   " << counters.l1dMissesPerOp(total_ops) << "\n";
+            if (counters.has_llc_misses) {
+                uint64_t total_bytes = bytes_read + bytes_written;
+                ostr << "  LLC miss/op:   " << counters.llcMissesPerOp(total_ops) << "\n";
+                if (total_bytes > 0) ostr << "  LLC miss/KB:   " << 1024.0 * counters.llc_misses / total_bytes << " (estimated tier: " << primary_cache_tier << ")\n";
+            }
+            ostr << "  Page faults:   " << counters.page_faults << "\n";
+        }
     }
 
     /// Get one-line summary
@@ -157,6 +179,7 @@ struct AlgorithmProfile {
         ss << formatBytes(working_set_bytes) << " WS, ";
         ss << std::fixed << std::setprecision(2);
         ss << (total_energy_pj / 1e6) << " uJ";
+        if (counters.hasHardware()) ss << ", IPC " << counters.ipc();
         return ss.str();
     }
 
@@ -425,6 +448,33 @@ public:
         return profile;
     }
 
+    /// Run a kernel under the performance counters and attach the counts of one
+    /// execution to the profile. The kernel runs once to warm up, then repetitions
+    /// times, and the counts are averaged over the repetitions.
+    static void measureCounters(AlgorithmProfile& profile,
+                                const std::function<void()>& kernel,
+                                size_t repetitions = 1) {
+        if (repetitions == 0) repetitions = 1;
+        kernel();
+        energy::PerfCounterReader reader;
+        reader.start();
+        for (size_t i = 0; i < repetitions; ++i) kernel();
+        energy::PerfCounts counts = reader.stop();
+        if (repetitions > 1) {
+            counts.cycles /= repetitions;
+            counts.instructions /= repetitions;
+            counts.branch_misses /= repetitions;
+            counts.l1d_misses /= repetitions;
+            counts.llc_misses /= repetitions;
+            counts.task_clock_ns /= repetitions;
+            counts.page_faults /= repetitions;
+            counts.context_switches /= repetitions;
+            counts.cpu_migrations /= repetitions;
+            counts.elapsed_ms /= static_cast<double>(repetitions);
+        }
+        profile.counters = counts;
+    }
+
     /// Compare two profiles
     static PrecisionComparison compare(
             const AlgorithmProfile& baseline,
@@ -0,0 +1,127 @@
+#pragma once
+// mapped_file.hpp: read-only view of a whole file, memory mapped where the platform supports it
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// On POSIX systems the file is mapped with mmap(PROT_READ, MAP_PRIVATE), so the pages are shared
+// with the page cache and only the touched parts are ever read. Elsewhere the file is read into a
+// malloc'd buffer. Either way data() is aligned to at least 8 bytes. An empty file opens
+// successfully with size() == 0 and data() == nullptr.
+//
+// The view is a snapshot: bytes appended to the file after open() are not visible until the file
+// is opened again.
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UNIVERSAL_MAPPED_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define UNIVERSAL_MAPPED_FILE_MMAP 0
+#endif
+
+namespace sw { namespace universal {
+
+class mapped_file {
+public:
+	mapped_file() = default;
+	explicit mapped_file(const std::string& path) { open(path); }
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	mapped_file(mapped_file&& rhs) noexcept { swap(rhs); }
+	mapped_file& operator=(mapped_file&& rhs) noexcept {
+		if (this != &rhs) {
+			close();
+			swap(rhs);
+		}
+		return *this;
+	}
+	~mapped_file() { close(); }
+
+	// map the file, replacing any previous view; returns false, leaving the object closed, on failure
+	bool open(const std::string& path) {
+		close();
+#if UNIVERSAL_MAPPED_FILE_MMAP
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			return false;
+		}
+		std::size_t size = static_cast<std::size_t>(st.st_size);
+		if (size > 0) {
+			void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (base == MAP_FAILED) {
+				::close(fd);
+				return false;
+			}
+			_data = static_cast<const unsigned char*>(base);
+			_mmapped = true;
+		}
+		::close(fd);
+		_size = size;
+#else
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if (!in) return false;
+		std::size_t size = static_cast<std::size_t>(in.tellg());
+		if (size > 0) {
+			unsigned char* base = static_cast<unsigned char*>(std::malloc(size));
+			if (base == nullptr) return false;
+			in.seekg(0);
+			if (!in.read(reinterpret_cast<char*>(base), static_cast<std::streamsize>(size))) {
+				std::free(base);
+				return false;
+			}
+			_data = base;
+		}
+		_size = size;
+#endif
+		_open = true;
+		return true;
+	}
+
+	void close() noexcept {
+		if (_data != nullptr) {
+#if UNIVERSAL_MAPPED_FILE_MMAP
+			if (_mmapped) ::munmap(const_cast<unsigned char*>(_data), _size);
+			else std::free(const_cast<unsigned char*>(_data));
+#else
+			std::free(const_cast<unsigned char*>(_data));
+#endif
+		}
+		_data = nullptr;
+		_size = 0;
+		_open = false;
+		_mmapped = false;
+	}
+
+	const unsigned char* data() const noexcept { return _data; }
+	std::size_t size() const noexcept { return _size; }
+	bool is_open() const noexcept { return _open; }
+	bool mapped() const noexcept { return _mmapped; }
+
+	void swap(mapped_file& rhs) noexcept {
+		std::swap(_data, rhs._data);
+		std::swap(_size, rhs._size);
+		std::swap(_open, rhs._open);
+		std::swap(_mmapped, rhs._mmapped);
+	}
+
+private:
+	const unsigned char* _data = nullptr;
+	std::size_t          _size = 0;
+	bool                 _open = false;
+	bool                 _mmapped = false;
+};
+
+}} // namespace sw::universal
@@ -0,0 +1,486 @@
+#pragma once
+// number_array.hpp: self-describing binary container for arrays of Universal number encodings
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// Arrays of posits, cfloats, lns, microfloats and the other encoded types could only be saved as
+// text, through operator<< and parse(). A number_array file stores the raw encodings instead:
+//
+//   offset  size  field
+//        0     8  magic "UNVARRAY"
+//        8     4  format version
+//       12     4  nbits of the element type
+//       16     4  second type parameter: es for posit, cfloat and microfloat, rbits for lns, fixpnt
+//                 and takum, 0 otherwise
+//       20     4  bytes per element, 0 when the elements are bit-packed
+//       24     4  flags, bit 0 set when the elements are bit-packed
+//       28     4  length of the type tag
+//       32     .  type_tag() of the element type, zero padded to a multiple of 8 bytes
+//
+// followed by any number of chunks, each a 16-byte header, "UNVCHUNK" and the element count, and
+// the payload zero padded to a multiple of 8 bytes. All fields are little-endian. Element types
+// narrower than 8 bits, e2m1 and the other sub-byte microfloats, are bit-packed LSB first; wider
+// types take ceil(nbits/8) little-endian bytes each. Native float, double and integer arrays are
+// stored by their object representation under the tags "float", "double", "int32_t", and so on.
+//
+// number_array_writer<T> creates a file, or reopens one for append, and writes one chunk per call
+// to append(), flushed before it returns, so a producer can stream chunks to a consumer that polls
+// with number_array_reader::refresh(). A trailing chunk that is not completely written is ignored
+// by the reader and dropped when the file is reopened for append.
+//
+// number_array_reader maps the file (utility/mapped_file.hpp) and indexes its chunks. When the
+// in-memory representation of T is its little-endian encoding, which is verified once per type,
+// view<T>(chunk) returns a zero-copy std::span into the mapping; read<T>() decodes into a vector
+// for every element type, including the bit-packed ones.
+//
+// Usage:
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/utility/number_array.hpp>
+//
+//   number_array_writer<posit<32,2>> out("weights.unv");
+//   out.append(layer0);                                 // std::vector<posit<32,2>>
+//   out.append(layer1);
+//
+//   number_array_reader in("weights.unv");
+//   std::span<const posit<32,2>> w0 = in.view<posit<32,2>>(0);
+//   std::vector<posit<32,2>>     all = in.read<posit<32,2>>();
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <universal/utility/bit_cast.hpp>
+#include <universal/utility/mapped_file.hpp>
+#include <universal/number/convert/convert_span.hpp>
+
+namespace sw { namespace universal {
+
+class number_array_error : public std::runtime_error {
+public:
+	explicit number_array_error(const std::string& msg) : std::runtime_error(msg) {}
+};
+
+namespace number_array_detail {
+
+	constexpr char          file_magic[8]     = { 'U', 'N', 'V', 'A', 'R', 'R', 'A', 'Y' };
+	constexpr char          chunk_magic[8]    = { 'U', 'N', 'V', 'C', 'H', 'U', 'N', 'K' };
+	constexpr std::uint32_t format_version    = 1;
+	constexpr std::size_t   header_size       = 32;
+	constexpr std::size_t   chunk_header_size = 16;
+	constexpr std::uint32_t flag_packed       = 1;
+
+	constexpr std::size_t pad8(std::size_t n) noexcept { return (n + 7) & ~std::size_t(7); }
+
+	inline void store_le(unsigned char* p, std::uint64_t v, unsigned bytes) noexcept {
+		for (unsigned i = 0; i < bytes; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+	}
+	inline std::uint64_t load_le(const unsigned char* p, unsigned bytes) noexcept {
+		std::uint64_t v{ 0 };
+		for (unsigned i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+		return v;
+	}
+
+	template<typename T>
+	concept NativeElement = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double>;
+
+	template<typename T>
+	concept Element = NativeElement<T> || (detail::EncodedNumber<T> && T::nbits <= 64);
+
+	template<typename T>
+	constexpr unsigned nbits_of() noexcept {
+		if constexpr (NativeElement<T>) return static_cast<unsigned>(8 * sizeof(T));
+		else return static_cast<unsigned>(T::nbits);
+	}
+
+	template<typename T>
+	constexpr unsigned parameter_of() noexcept {
+		if constexpr (requires { T::es; }) return static_cast<unsigned>(T::es);
+		else if constexpr (requires { T::rbits; }) return static_cast<unsigned>(T::rbits);
+		else return 0;
+	}
+
+	template<typename T>
+	constexpr bool packed_v = nbits_of<T>() < 8;
+
+	template<typename T>
+	constexpr unsigned bytes_v = packed_v<T> ? 0u : (nbits_of<T>() + 7) / 8;
+
+	template<typename T>
+	std::string tag_of() {
+		if constexpr (std::is_same_v<T, float>) return "float";
+		else if constexpr (std::is_same_v<T, double>) return "double";
+		else if constexpr (std::is_integral_v<T>) {
+			return std::string(std::is_signed_v<T> ? "int" : "uint") + std::to_string(8 * sizeof(T)) + "_t";
+		}
+		else return type_tag(T{});
+	}
+
+	template<typename T>
+	using raw_word = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+	                 std::conditional_t<sizeof(T) == 2, std::uint16_t,
+	                 std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+	template<typename T>
+	inline std::uint64_t encode(const T& v) noexcept {
+		if constexpr (NativeElement<T>) return static_cast<std::uint64_t>(sw::bit_cast<raw_word<T>>(v));
+		else return detail::encoding_of(v);
+	}
+
+	template<typename T>
+	inline T decode(std::uint64_t raw) noexcept {
+		if constexpr (NativeElement<T>) return sw::bit_cast<T>(static_cast<raw_word<T>>(raw));
+		else {
+			T v;
+			v.setbits(raw);
+			return v;
+		}
+	}
+
+	// The object representation of T is its little-endian encoding, so arrays of T can be copied to
+	// and viewed in a file as bytes. Checked at run time, once per type, on all encodings of narrow
+	// types and on a spread of patterns for wider ones.
+	template<typename T>
+	bool representation_is_encoding() {
+		static const bool matches = [] {
+			if constexpr (std::endian::native != std::endian::little || !std::is_trivially_copyable_v<T> || packed_v<T>) {
+				return false;
+			}
+			else if constexpr (sizeof(T) != bytes_v<T>) {
+				return false;
+			}
+			else if constexpr (NativeElement<T>) {
+				return true;
+			}
+			else {
+				constexpr unsigned nbits = T::nbits;
+				constexpr std::uint64_t mask = (nbits >= 64) ? ~0ull : ((1ull << nbits) - 1ull);
+				auto check = [](std::uint64_t raw) {
+					T v = decode<T>(raw);
+					if (encode(v) != raw) return false;
+					unsigned char object[sizeof(T)], encoding[sizeof(T)];
+					std::memcpy(object, &v, sizeof(T));
+					store_le(encoding, raw, sizeof(T));
+					return std::memcmp(object, encoding, sizeof(T)) == 0;
+				};
+				if constexpr (nbits <= 16) {
+					for (std::uint64_t raw = 0; raw <= mask; ++raw) if (!check(raw)) return false;
+				}
+				else {
+					std::uint64_t patterns[] = { 0, 1, mask, mask >> 1, 1ull << (nbits - 1),
+						0xAAAA'AAAA'AAAA'AAAAull & mask, 0x5555'5555'5555'5555ull & mask };
+					for (std::uint64_t raw : patterns) if (!check(raw)) return false;
+					std::uint64_t state = 0x9E37'79B9'7F4A'7C15ull;
+					for (int i = 0; i < 256; ++i) {
+						state = state * 6364136223846793005ull + 1442695040888963407ull;
+						if (!check(state & mask)) return false;
+					}
+				}
+				return true;
+			}
+		}();
+		return matches;
+	}
+
+	template<typename T>
+	constexpr std::size_t payload_size(std::size_t count) noexcept {
+		if constexpr (packed_v<T>) return (count * nbits_of<T>() + 7) / 8;
+		else return count * bytes_v<T>;
+	}
+
+	// serialize the encodings of values into payload, which must hold payload_size<T>(values.size()) bytes
+	template<typename T>
+	void encode_payload(std::span<const T> values, unsigned char* payload) {
+		if constexpr (packed_v<T>) {
+			constexpr unsigned nbits = nbits_of<T>();
+			std::memset(payload, 0, payload_size<T>(values.size()));
+			std::size_t bit = 0;
+			for (const T& v : values) {
+				std::uint64_t raw = encode(v);
+				payload[bit / 8] |= static_cast<unsigned char>(raw << (bit % 8));
+				if (bit % 8 + nbits > 8) payload[bit / 8 + 1] |= static_cast<unsigned char>(raw >> (8 - bit % 8));
+				bit += nbits;
+			}
+		}
+		else {
+			if (representation_is_encoding<T>()) {
+				if (!values.empty()) std::memcpy(payload, values.data(), values.size() * sizeof(T));
+				return;
+			}
+			constexpr unsigned bytes = bytes_v<T>;
+			for (std::size_t i = 0; i < values.size(); ++i) store_le(payload + i * bytes, encode(values[i]), bytes);
+		}
+	}
+
+	template<typename T>
+	void decode_payload(const unsigned char* payload, std::span<T> values) {
+		if constexpr (packed_v<T>) {
+			constexpr unsigned nbits = nbits_of<T>();
+			constexpr unsigned mask = (1u << nbits) - 1u;
+			std::size_t bit = 0;
+			for (T& v : values) {
+				unsigned raw = payload[bit / 8] >> (bit % 8);
+				if (bit % 8 + nbits > 8) raw |= static_cast<unsigned>(payload[bit / 8 + 1]) << (8 - bit % 8);
+				v = decode<T>(raw & mask);
+				bit += nbits;
+			}
+		}
+		else {
+			if (representation_is_encoding<T>()) {
+				if (!values.empty()) std::memcpy(static_cast<void*>(values.data()), payload, values.size() * sizeof(T));
+				return;
+			}
+			constexpr unsigned bytes = bytes_v<T>;
+			for (std::size_t i = 0; i < values.size(); ++i) values[i] = decode<T>(load_le(payload + i * bytes, bytes));
+		}
+	}
+
+} // namespace number_array_detail
+
+// Read side: maps a number_array file and indexes its complete chunks
+class number_array_reader {
+public:
+	number_array_reader() = default;
+	explicit number_array_reader(const std::string& path) {
+		if (!open(path)) throw number_array_error("number_array: unable to open " + path);
+	}
+
+	// map the file and index its chunks; returns false if the file is missing or not a number_array
+	bool open(const std::string& path) {
+		_path = path;
+		_chunks.clear();
+		_elements = 0;
+		if (!_file.open(path) || !parse_header()) {
+			_file.close();
+			return false;
+		}
+		index_chunks();
+		return true;
+	}
+
+	// remap the file to pick up chunks appended since open(); spans returned by view() are invalidated
+	bool refresh() { return open(_path); }
+
+	void close() noexcept {
+		_file.close();
+		_chunks.clear();
+		_elements = 0;
+	}
+
+	bool              is_open() const noexcept { return _file.is_open(); }
+	const std::string& tag() const noexcept { return _tag; }
+	unsigned          nbits() const noexcept { return _nbits; }
+	unsigned          parameter() const noexcept { return _parameter; }
+	unsigned          element_bytes() const noexcept { return _bytes; }
+	bool              packed() const noexcept { return _packed; }
+	std::size_t       chunks() const noexcept { return _chunks.size(); }
+	std::size_t       chunk_size(std::size_t chunk) const { return at(chunk).count; }
+	std::size_t       size() const noexcept { return _elements; }
+	// offset just past the last complete chunk
+	std::size_t       end_of_data() const noexcept { return _end; }
+
+	// the file holds elements of type T
+	template<typename T>
+	bool holds() const {
+		using namespace number_array_detail;
+		static_assert(Element<T>, "number_array supports native arithmetic types and encoded Universal types of at most 64 bits");
+		return is_open() && _nbits == nbits_of<T>() && _parameter == parameter_of<T>() && _bytes == bytes_v<T>
+			&& _packed == packed_v<T> && _tag == tag_of<T>();
+	}
+
+	// view<T> can hand out spans into the mapping
+	template<typename T>
+	bool zero_copy() const {
+		return holds<T>() && number_array_detail::representation_is_encoding<T>();
+	}
+
+	// zero-copy view of a chunk; throws number_array_error unless zero_copy<T>()
+	template<typename T>
+	std::span<const T> view(std::size_t chunk) const {
+		if (!holds<T>()) throw number_array_error("number_array: file holds " + _tag + ", not " + number_array_detail::tag_of<T>());
+		if (!zero_copy<T>()) throw number_array_error("number_array: " + _tag + " cannot be viewed in place, use read()");
+		const chunk_info& c = at(chunk);
+		return std::span<const T>(reinterpret_cast<const T*>(_file.data() + c.offset), c.count);
+	}
+
+	// decode a chunk
+	template<typename T>
+	std::vector<T> read(std::size_t chunk) const {
+		check<T>();
+		const chunk_info& c = at(chunk);
+		std::vector<T> values(c.count);
+		number_array_detail::decode_payload<T>(_file.data() + c.offset, std::span<T>(values));
+		return values;
+	}
+
+	// decode all chunks into one array
+	template<typename T>
+	std::vector<T> read() const {
+		check<T>();
+		std::vector<T> values(_elements);
+		std::size_t next = 0;
+		for (const chunk_info& c : _chunks) {
+			number_array_detail::decode_payload<T>(_file.data() + c.offset, std::span<T>(values).subspan(next, c.count));
+			next += c.count;
+		}
+		return values;
+	}
+
+	// the stored encodings of a chunk, without padding
+	std::span<const unsigned char> raw(std::size_t chunk) const {
+		const chunk_info& c = at(chunk);
+		return std::span<const unsigned char>(_file.data() + c.offset, c.bytes);
+	}
+
+private:
+	struct chunk_info {
+		std::size_t offset; // of the payload
+		std::size_t count;
+		std::size_t bytes;
+	};
+
+	mapped_file             _file;
+	std::string             _path;
+	std::string             _tag;
+	unsigned                _nbits = 0;
+	unsigned                _parameter = 0;
+	unsigned                _bytes = 0;
+	bool                    _packed = false;
+	std::size_t             _data = 0;
+	std::size_t             _end = 0;
+	std::size_t             _elements = 0;
+	std::vector<chunk_info> _chunks;
+
+	bool parse_header() {
+		using namespace number_array_detail;
+		const unsigned char* p = _file.data();
+		if (_file.size() < header_size || std::memcmp(p, file_magic, 8) != 0) return false;
+		if (load_le(p + 8, 4) != format_version) return false;
+		_nbits     = static_cast<unsigned>(load_le(p + 12, 4));
+		_parameter = static_cast<unsigned>(load_le(p + 16, 4));
+		_bytes     = static_cast<unsigned>(load_le(p + 20, 4));
+		_packed    = (load_le(p + 24, 4) & flag_packed) != 0;
+		std::size_t tagLength = static_cast<std::size_t>(load_le(p + 28, 4));
+		if (_nbits == 0 || _nbits > 64 || (_packed ? _nbits >= 8 : _bytes != (_nbits + 7) / 8)) return false;
+		if (tagLength > _file.size() - header_size) return false;
+		_tag.assign(reinterpret_cast<const char*>(p + header_size), tagLength);
+		_data = header_size + pad8(tagLength);
+		return _data <= _file.size();
+	}
+
+	void index_chunks() {
+		using namespace number_array_detail;
+		const unsigned char* p = _file.data();
+		std::size_t offset = _data;
+		while (_file.size() - offset >= chunk_header_size && std::memcmp(p + offset, chunk_magic, 8) == 0) {
+			std::uint64_t count = load_le(p + offset + 8, 8);
+			std::size_t available = _file.size() - offset - chunk_header_size;
+			std::size_t limit = _packed ? available * 8 / _nbits : available / _bytes;
+			if (count > limit) break;
+			std::size_t bytes = _packed ? (static_cast<std::size_t>(count) * _nbits + 7) / 8 : static_cast<std::size_t>(count) * _bytes;
+			if (pad8(bytes) > available) break;
+			_chunks.push_back({ offset + chunk_header_size, static_cast<std::size_t>(count), bytes });
+			_elements += static_cast<std::size_t>(count);
+			offset += chunk_header_size + pad8(bytes);
+		}
+		_end = offset;
+	}
+
+	const chunk_info& at(std::size_t chunk) const {
+		if (chunk >= _chunks.size()) throw number_array_error("number_array: chunk index out of range");
+		return _chunks[chunk];
+	}
+
+	template<typename T>
+	void check() const {
+		if (!holds<T>()) throw number_array_error("number_array: file holds " + _tag + ", not " + number_array_detail::tag_of<T>());
+	}
+};
+
+// Write side: creates a number_array file, or appends chunks to an existing one
+template<typename T>
+class number_array_writer {
+public:
+	static_assert(number_array_detail::Element<T>, "number_array supports native arithmetic types and encoded Universal types of at most 64 bits");
+
+	// append == false truncates the file. append == true keeps the complete chunks of an existing
+	// file, which must hold T, and creates the file if it does not exist.
+	explicit number_array_writer(const std::string& path, bool append = false) : _path{ path } {
+		std::error_code ec;
+		if (append && std::filesystem::exists(path, ec)) {
+			std::size_t end{ 0 };
+			{
+				number_array_reader existing;
+				if (!existing.open(path)) throw number_array_error("number_array: " + path + " is not a number_array file");
+				if (!existing.holds<T>()) throw number_array_error("number_array: " + path + " holds " + existing.tag() + ", not " + number_array_detail::tag_of<T>());
+				_chunks = existing.chunks();
+				_elements = existing.size();
+				end = existing.end_of_data();
+			}
+			std::filesystem::resize_file(path, end, ec);
+			if (ec) throw number_array_error("number_array: unable to truncate " + path);
+			_out.open(path, std::ios::binary | std::ios::app);
+			if (!_out) throw number_array_error("number_array: unable to open " + path);
+		}
+		else {
+			_out.open(path, std::ios::binary | std::ios::trunc);
+			if (!_out) throw number_array_error("number_array: unable to create " + path);
+			write_header();
+		}
+	}
+
+	// write values as one chunk and flush it
+	void append(std::span<const T> values) {
+		using namespace number_array_detail;
+		std::size_t bytes = payload_size<T>(values.size());
+		_buffer.assign(chunk_header_size + pad8(bytes), 0);
+		std::memcpy(_buffer.data(), chunk_magic, 8);
+		store_le(_buffer.data() + 8, values.size(), 8);
+		encode_payload<T>(values, _buffer.data() + chunk_header_size);
+		_out.write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+		_out.flush();
+		if (!_out) throw number_array_error("number_array: write to " + _path + " failed");
+		++_chunks;
+		_elements += values.size();
+	}
+
+	void close() { _out.close(); }
+
+	std::size_t chunks() const noexcept { return _chunks; }
+	std::size_t size() const noexcept { return _elements; }
+
+private:
+	std::string                _path;
+	std::ofstream              _out;
+	std::vector<unsigned char> _buffer;
+	std::size_t                _chunks = 0;
+	std::size_t                _elements = 0;
+
+	void write_header() {
+		using namespace number_array_detail;
+		std::string tag = tag_of<T>();
+		std::vector<unsigned char> h(header_size + pad8(tag.size()), 0);
+		std::memcpy(h.data(), file_magic, 8);
+		store_le(h.data() + 8, format_version, 4);
+		store_le(h.data() + 12, nbits_of<T>(), 4);
+		store_le(h.data() + 16, parameter_of<T>(), 4);
+		store_le(h.data() + 20, bytes_v<T>, 4);
+		store_le(h.data() + 24, packed_v<T> ? flag_packed : 0u, 4);
+		store_le(h.data() + 28, tag.size(), 4);
+		std::memcpy(h.data() + header_size, tag.data(), tag.size());
+		_out.write(reinterpret_cast<const char*>(h.data()), static_cast<std::streamsize>(h.size()));
+		_out.flush();
+		if (!_out) throw number_array_error("number_array: write to " + _path + " failed");
+	}
+};
+
+}} // namespace sw::universal
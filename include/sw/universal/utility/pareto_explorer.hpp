@@ -66,12 +66,18 @@ struct PrecisionConfig {
     double ops_per_byte;        // Arithmetic intensity threshold where this type excels
     double roofline_crossover;  // AI where compute and memory energy are equal
 
+    // Measured on this machine by ParetoExplorer::measureConfiguration (0 = not measured)
+    double cycles_per_op;       // Core cycles per arithmetic operation
+    double ipc;                 // Instructions per cycle
+    double llc_misses_per_op;   // Last-level cache misses per arithmetic operation
+
     PrecisionConfig()
         : name("unknown"), bit_width(32)
         , relative_accuracy(1e-7), energy_factor(1.0), bandwidth_factor(1.0), memory_factor(1.0)
         , is_pareto_optimal(false), is_pareto_optimal_3d(false)
         , accuracy_rank(0), energy_rank(0), bandwidth_rank(0)
-        , ops_per_byte(0), roofline_crossover(0) {}
+        , ops_per_byte(0), roofline_crossover(0)
+        , cycles_per_op(0), ipc(0), llc_misses_per_op(0) {}
 
     PrecisionConfig(const std::string& n, int bits, double acc, double energy, double bandwidth = 0.0)
         : name(n), bit_width(bits)
@@ -80,7 +86,8 @@ struct PrecisionConfig {
         , memory_factor(bandwidth > 0 ? bandwidth : bits / 32.0)
         , is_pareto_optimal(false), is_pareto_optimal_3d(false)
         , accuracy_rank(0), energy_rank(0), bandwidth_rank(0)
-        , ops_per_byte(0), roofline_crossover(0) {
+        , ops_per_byte(0), roofline_crossover(0)
+        , cycles_per_op(0), ipc(0), llc_misses_per_op(0) {
         // Compute roofline crossover point
         // At this arithmetic intensity, compute energy = memory energy
         // Using typical DRAM energy of ~20 pJ/byte and FP32 FMA of ~1.5 pJ
@@ -232,6 +239,32 @@ public:
         configs_.emplace_back(name, bits, accuracy, energy_factor, memory_factor);
     }
 
+    /// Measure a kernel implemented in the named configuration with the hardware counters
+    /// The kernel performs ops arithmetic operations per call. report() lists the counts in a
+    /// separate Measured Counters table; the frontier and the rankings keep using the modeled
+    /// energy and bandwidth factors
+    /// @return false if no configuration has that name or no cycle count was obtained
+    bool measureConfiguration(const std::string& name, const std::function<void()>& kernel,
+                              uint64_t ops, size_t repetitions = 1) {
+        auto it = std::find_if(configs_.begin(), configs_.end(),
+                               [&](const PrecisionConfig& c) { return c.name == name; });
+        if (it == configs_.end() || ops == 0) return false;
+        if (repetitions == 0) repetitions = 1;
+
+        kernel();  // warm caches and page in the working set
+        energy::PerfCounterReader reader;
+        reader.start();
+        for (size_t i = 0; i < repetitions; ++i) kernel();
+        energy::PerfCounts counts = reader.stop();
+        if (!counts.has_cycles) return false;
+
+        double totalOps = static_cast<double>(ops) * static_cast<double>(repetitions);
+        it->cycles_per_op = counts.cycles / totalOps;
+        it->ipc = counts.ipc();
+        it->llc_misses_per_op = counts.has_llc_misses ? counts.llc_misses / totalOps : 0.0;
+        return true;
+    }
+
     /// Clear all configurations
     void clear() {
         configs_.clear();
@@ -463,6 +496,27 @@ public:
                  << std::setw(10) << (cfg.is_pareto_optimal_3d ? "YES" : "no") << "\n";
         }
 
+        bool measured = std::any_of(configs_.begin(), configs_.end(),
+                                    [](const PrecisionConfig& c) { return c.cycles_per_op > 0; });
+        if (measured) {
+            ostr << "\nMeasured Counters:\n";
+            ostr << std::string(60, '-') << "\n";
+            ostr << std::left << std::setw(18) << "Configuration"
+                 << std::right << std::setw(14) << "Cycles/op"
+                 << std::setw(10) << "IPC"
+                 << std::setw(16) << "LLC miss/op" << "\n";
+            for (const auto& cfg : configs_) {
+                if (cfg.cycles_per_op <= 0) continue;
+                ostr << std::left << std::setw(18) << cfg.name
+                     << std::right << std::fixed << std::setprecision(2)
+                     << std::setw(14) << cfg.cycles_per_op
+                     << std::setw(10) << cfg.ipc
+                     << std::scientific << std::setprecision(2)
+                     << std::setw(16) << cfg.llc_misses_per_op << "\n";
+            }
+            ostr << std::defaultfloat;
+        }
+
         ostr << "\n2D Pareto Frontier (accuracy vs energy):\n";
         ostr << std::string(60, '-') << "\n";
         for (const auto& cfg : result.frontier) {
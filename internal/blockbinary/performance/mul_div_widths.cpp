@@ -0,0 +1,217 @@
+//  mul_div_widths.cpp : multiply/divide/remainder throughput of blockbinary across widths and block types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+//
+// blockbinary<nbits, bt> configurations that fit a native integer (nbits <= 64, or nbits <= 128 with __int128)
+// map operator*=, operator/=, operator%=, urmul2 and longdivision onto the hardware multiply and divide;
+// wider configurations run the limb loops. This benchmark tracks every width so that regressions in
+// either regime show up. Operands are full-width pseudo-random bit patterns, divisors are about half width,
+// so the generic long division cannot take its early exit.
+//
+// Measured with gcc -O3 on a single x86-64 core, ops/sec, limb loops -> native paths:
+//   configuration               mul                div                urmul2
+//   blockbinary<16,uint8>     154 M -> 302 M      6 M -> 195 M      7 M -> 196 M
+//   blockbinary<32,uint8>      63 M -> 255 M      2 M -> 143 M      2 M -> 110 M
+//   blockbinary<32,uint32>    607 M -> 712 M    175 M -> 343 M      4 M -> 263 M
+//   blockbinary<64,uint8>      16 M -> 111 M    478 K ->  71 M    779 K ->  26 M
+//   blockbinary<64,uint64>    666 M -> 771 M    260 M -> 240 M      1 M -> 242 M
+//   blockbinary<96,uint32>     94 M -> 110 M      1 M ->  46 M    867 K ->   4 M
+//   blockbinary<128,uint8>      4 M ->  22 M    203 K ->  15 M    121 K -> 664 K
+//   blockbinary<128,uint64>   153 M -> 312 M    684 K -> 129 M    767 K ->  26 M
+//   blockbinary<256,uint64>    22 M ->  37 M    246 K -> 250 K    242 K ->   7 M
+// Single-block configurations whose width equals the block already used a native multiply and divide,
+// and 256+ bit multiply and divide still run the limb loops. urmul2 beyond 64 bits now reuses the
+// limb multiply on sign-extended operands instead of a bitwise shift-and-add.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp> // ReportTestSuiteHeader
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::bb {
+
+	constexpr size_t NR_OPERANDS = 1024;
+
+	// deterministic full-width operands: bits above significantBits are cleared, and the
+	// operand is forced to be nonzero so it can serve as a divisor
+	template<typename BlockbinaryConfiguration>
+	std::vector<BlockbinaryConfiguration> GenerateOperands(unsigned significantBits, std::uint64_t seed) {
+		using BlockType = typename BlockbinaryConfiguration::BlockType;
+		std::vector<BlockbinaryConfiguration> operands(NR_OPERANDS);
+		std::uint64_t state = seed;
+		for (auto& v : operands) {
+			v.clear();
+			for (unsigned b = 0; b < BlockbinaryConfiguration::nrBlocks; ++b) {
+				state = state * 6364136223846793005ull + 1442695040888963407ull;
+				v.setblock(b, static_cast<BlockType>(state >> 11));
+			}
+			for (unsigned i = significantBits; i < BlockbinaryConfiguration::nbits; ++i) v.setbit(i, false);
+			v.setbit(0);
+		}
+		return operands;
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void MulWorkload(size_t NR_OPS) {
+		constexpr unsigned nbits = BlockbinaryConfiguration::nbits;
+		auto a = GenerateOperands<BlockbinaryConfiguration>(nbits, 1);
+		auto b = GenerateOperands<BlockbinaryConfiguration>(nbits, 2);
+		BlockbinaryConfiguration c{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c += a[i % NR_OPERANDS] * b[(i + 3) % NR_OPERANDS];
+		}
+		if (c.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void DivWorkload(size_t NR_OPS) {
+		constexpr unsigned nbits = BlockbinaryConfiguration::nbits;
+		auto a = GenerateOperands<BlockbinaryConfiguration>(nbits, 3);
+		auto b = GenerateOperands<BlockbinaryConfiguration>((nbits + 1) / 2, 4);
+		BlockbinaryConfiguration c{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c += a[i % NR_OPERANDS] / b[(i + 5) % NR_OPERANDS];
+		}
+		if (c.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void RemWorkload(size_t NR_OPS) {
+		constexpr unsigned nbits = BlockbinaryConfiguration::nbits;
+		auto a = GenerateOperands<BlockbinaryConfiguration>(nbits, 5);
+		auto b = GenerateOperands<BlockbinaryConfiguration>((nbits + 1) / 2, 6);
+		BlockbinaryConfiguration c{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c += a[i % NR_OPERANDS] % b[(i + 7) % NR_OPERANDS];
+		}
+		if (c.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// the unrounded 2*nbits product that fixpnt::operator*= is built on
+	template<typename BlockbinaryConfiguration>
+	void UrmulWorkload(size_t NR_OPS) {
+		constexpr unsigned nbits = BlockbinaryConfiguration::nbits;
+		using BlockType = typename BlockbinaryConfiguration::BlockType;
+		auto a = GenerateOperands<BlockbinaryConfiguration>(nbits, 7);
+		auto b = GenerateOperands<BlockbinaryConfiguration>(nbits, 8);
+		blockbinary<2 * nbits, BlockType> c{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c += urmul2(a[i % NR_OPERANDS], b[(i + 9) % NR_OPERANDS]);
+		}
+		if (c.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// run all workloads for one configuration; NR_OPS is scaled down with the cost of the generic paths
+	template<unsigned nbits, typename BlockType>
+	void TrackWidth(const std::string& blockTypeName, size_t NR_OPS) {
+		using BlockBinary = blockbinary<nbits, BlockType>;
+		std::string config = "blockbinary<" + std::to_string(nbits) + ',' + blockTypeName + '>';
+		config.resize(25, ' ');
+		size_t nrDivs = NR_OPS / (nbits > 128 ? nbits : 16);
+		PerformanceRunner(config + "mul   ", MulWorkload<BlockBinary>, NR_OPS / (nbits > 128 ? nbits / 64 : 1));
+		PerformanceRunner(config + "div   ", DivWorkload<BlockBinary>, nrDivs);
+		PerformanceRunner(config + "rem   ", RemWorkload<BlockBinary>, nrDivs);
+		PerformanceRunner(config + "urmul2", UrmulWorkload<BlockBinary>, NR_OPS / (nbits > 64 ? nbits / 16 : 1));
+	}
+
+} // namespace sw::universal::bb
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "blockbinary multiply/divide throughput across widths";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	constexpr size_t NR_OPS = 4ull * 1024 * 1024;
+
+#if MANUAL_TESTING
+
+	bb::TrackWidth<64, std::uint8_t>("uint8 ", NR_OPS);
+	bb::TrackWidth<128, std::uint64_t>("uint64", NR_OPS);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;  // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	// native fast paths: a short run so the regression suite exercises the benchmark
+	bb::TrackWidth<32, std::uint8_t>("uint8 ", NR_OPS / 64);
+	bb::TrackWidth<128, std::uint64_t>("uint64", NR_OPS / 64);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+	std::cout << "\nnative word configurations\n";
+	bb::TrackWidth<  8, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 12, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 16, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 16, std::uint16_t>("uint16", NR_OPS);
+	bb::TrackWidth< 24, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 32, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 32, std::uint16_t>("uint16", NR_OPS);
+	bb::TrackWidth< 32, std::uint32_t>("uint32", NR_OPS);
+	bb::TrackWidth< 48, std::uint16_t>("uint16", NR_OPS);
+	bb::TrackWidth< 64, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth< 64, std::uint32_t>("uint32", NR_OPS);
+	bb::TrackWidth< 64, std::uint64_t>("uint64", NR_OPS);
+	bb::TrackWidth< 80, std::uint16_t>("uint16", NR_OPS);
+	bb::TrackWidth< 96, std::uint32_t>("uint32", NR_OPS);
+	bb::TrackWidth<128, std::uint8_t >("uint8 ", NR_OPS);
+	bb::TrackWidth<128, std::uint32_t>("uint32", NR_OPS);
+	bb::TrackWidth<128, std::uint64_t>("uint64", NR_OPS);
+
+	std::cout << "\nmulti-limb configurations\n";
+	bb::TrackWidth<256, std::uint32_t>("uint32", NR_OPS / 4);
+	bb::TrackWidth<256, std::uint64_t>("uint64", NR_OPS / 4);
+	bb::TrackWidth<512, std::uint32_t>("uint32", NR_OPS / 16);
+	bb::TrackWidth<512, std::uint64_t>("uint64", NR_OPS / 16);
+	bb::TrackWidth<1024, std::uint64_t>("uint64", NR_OPS / 64);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
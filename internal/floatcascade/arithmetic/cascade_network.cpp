@@ -0,0 +1,271 @@
+// cascade_network.cpp: validate the branch-free cascade networks and the cascade_vector bulk kernels
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project: https://github.com/stillwater-sc/universal
+
+#include <universal/utility/directives.hpp>
+#include <universal/number/dd_cascade/dd_cascade.hpp>
+#include <universal/number/td_cascade/td_cascade.hpp>
+#include <universal/number/qd_cascade/qd_cascade.hpp>
+#include <universal/internal/floatcascade/cascade_vector.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace sw {
+namespace universal {
+
+// widen a cascade to four components so that the reference arithmetic carries more precision than N
+template<size_t N>
+floatcascade<4> widen(const floatcascade<N>& a) {
+    floatcascade<4> w;
+    for (size_t i = 0; i < N; ++i) w[i] = a[i];
+    return w;
+}
+
+// relative difference |a - ref| / |ref|, in the 4-component format
+template<size_t N>
+double relative_error(const floatcascade<N>& a, const floatcascade<4>& ref) {
+    floatcascade<4> diff = widen(a);
+    diff -= ref;
+    double r = std::abs(ref[0]);
+    return (r == 0.0) ? std::abs(diff[0]) : std::abs(diff[0]) / r;
+}
+
+// a random cascade with N full-precision, non-overlapping components
+template<size_t N>
+floatcascade<N> random_cascade(std::mt19937_64& rng, int exponentRange) {
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-exponentRange, exponentRange);
+    floatcascade<N> a;
+    double scale = std::ldexp(1.0, exponent(rng));
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = mantissa(rng) * scale;
+        scale = std::ldexp(std::abs(a[i]), -53);
+    }
+    return a;
+}
+
+template<size_t N>
+int VerifyNetworkArithmetic(bool reportTestCases, int nrOfRandoms) {
+    int nrOfFailedTestCases = 0;
+    // N components carry about 53N bits; allow a few bits for the dropped products and last rounding
+    const double bound = std::ldexp(1.0, -(53 * static_cast<int>(N) - 8));
+    std::mt19937_64 rng(N);
+    for (int k = 0; k < nrOfRandoms; ++k) {
+        floatcascade<N> a = random_cascade<N>(rng, 8);
+        floatcascade<N> b = random_cascade<N>(rng, 8);
+
+        floatcascade<4> sum = widen(a);
+        sum += widen(b);
+        floatcascade<4> product = widen(a);
+        product *= widen(b);
+
+        double eadd = relative_error(cascade_network::accurate_add(a, b), sum);
+        double esub = relative_error(cascade_network::accurate_sub(a, b), [&] { floatcascade<4> d = widen(a); d -= widen(b); return d; }());
+        double emul = relative_error(cascade_network::multiply(a, b), product);
+        if (eadd > bound || esub > bound || emul > bound) {
+            ++nrOfFailedTestCases;
+            if (reportTestCases) std::cerr << "FAIL: N = " << N << " a = " << to_tuple(a) << " b = " << to_tuple(b)
+                                           << " add " << eadd << " sub " << esub << " mul " << emul << '\n';
+        }
+
+        // same-sign operands do not cancel, so the sloppy addition must be as accurate
+        floatcascade<N> c = b;
+        if ((a[0] < 0.0) != (c[0] < 0.0)) for (size_t i = 0; i < N; ++i) c[i] = -c[i];
+        floatcascade<4> same = widen(a);
+        same += widen(c);
+        double esloppy = relative_error(cascade_network::sloppy_add(a, c), same);
+        if (esloppy > bound) {
+            ++nrOfFailedTestCases;
+            if (reportTestCases) std::cerr << "FAIL: N = " << N << " sloppy_add " << esloppy << '\n';
+        }
+
+        // scaling by a double
+        double s = std::ldexp(std::uniform_real_distribution<double>(1.0, 2.0)(rng), 3);
+        floatcascade<4> scaled = widen(a);
+        scaled *= floatcascade<4>(s);
+        double escale = relative_error(cascade_network::multiply(a, s), scaled);
+        if (escale > bound) {
+            ++nrOfFailedTestCases;
+            if (reportTestCases) std::cerr << "FAIL: N = " << N << " multiply by double " << escale << '\n';
+        }
+    }
+    return nrOfFailedTestCases;
+}
+
+// operands that agree in their leading components: the accurate network must recover the tail exactly
+template<size_t N>
+int VerifyCancellation(bool reportTestCases) {
+    int nrOfFailedTestCases = 0;
+    floatcascade<N> a, b;
+    a[0] = 1.0;
+    b[0] = -1.0;
+    for (size_t i = 1; i < N; ++i) {
+        a[i] = std::ldexp(1.0, -60 * static_cast<int>(i));
+        b[i] = std::ldexp(-1.0, -60 * static_cast<int>(i) - 1);
+    }
+    // a + b = sum of the halved tails, representable exactly
+    floatcascade<N> r = cascade_network::accurate_add(a, b);
+    for (size_t i = 1; i < N; ++i) {
+        double expected = std::ldexp(1.0, -60 * static_cast<int>(i) - 1);
+        if (r[i - 1] != expected) {
+            ++nrOfFailedTestCases;
+            if (reportTestCases) std::cerr << "FAIL: cancellation N = " << N << " component " << i - 1 << " : " << r[i - 1] << " != " << expected << '\n';
+        }
+    }
+    // x - x must be exactly zero
+    floatcascade<N> z = cascade_network::accurate_sub(a, a);
+    for (size_t i = 0; i < N; ++i) if (z[i] != 0.0) ++nrOfFailedTestCases;
+    return nrOfFailedTestCases;
+}
+
+template<size_t N>
+int VerifyNonFinite(bool reportTestCases) {
+    int nrOfFailedTestCases = 0;
+    floatcascade<N> inf(std::numeric_limits<double>::infinity());
+    floatcascade<N> one(1.0);
+    floatcascade<N> huge(std::numeric_limits<double>::max());
+    if (!std::isinf(cascade_network::accurate_add(inf, one)[0])) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::sloppy_add(inf, one)[0])) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::multiply(inf, one)[0])) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::multiply(huge, huge)[0])) ++nrOfFailedTestCases;
+    // finite operands whose sum overflows
+    floatcascade<N> big(1.7e308), large(1e308), negbig(-1.7e308);
+    floatcascade<N> sum = cascade_network::accurate_add(big, big);
+    if (!std::isinf(sum[0]) || sum[0] < 0.0 || sum[1] != 0.0) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::accurate_add(large, large)[0])) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::sloppy_add(big, big)[0])) ++nrOfFailedTestCases;
+    if (!std::isinf(cascade_network::accurate_sub(negbig, big)[0]) || cascade_network::accurate_sub(negbig, big)[0] > 0.0) ++nrOfFailedTestCases;
+    if (!std::isnan(cascade_network::accurate_sub(inf, inf)[0])) ++nrOfFailedTestCases;
+    if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: non-finite handling for N = " << N << '\n';
+    return nrOfFailedTestCases;
+}
+
+// the bulk kernels must agree element by element with the scalar networks, and round-trip through td_cascade
+int VerifyCascadeVector(bool reportTestCases) {
+    int nrOfFailedTestCases = 0;
+    constexpr size_t n = 257;
+    std::mt19937_64 rng(7);
+    std::vector<td_cascade> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = td_cascade(random_cascade<3>(rng, 4));
+        y[i] = td_cascade(random_cascade<3>(rng, 4));
+    }
+    cascade_vector<3> X(x), Y(y), Z(n);
+    std::vector<td_cascade> back = X.to_vector<td_cascade>();
+    for (size_t i = 0; i < n; ++i) {
+        if (back[i] != x[i]) { ++nrOfFailedTestCases; break; }
+    }
+
+    add(X, Y, Z);
+    for (size_t i = 0; i < n; ++i) {
+        if (Z[i] != cascade_network::accurate_add(X[i], Y[i])) { ++nrOfFailedTestCases; break; }
+    }
+    mul(X, Y, Z);
+    for (size_t i = 0; i < n; ++i) {
+        if (Z[i] != cascade_network::multiply(X[i], Y[i])) { ++nrOfFailedTestCases; break; }
+    }
+
+    // the dot product against the scalar td_cascade operators
+    td_cascade ref(0.0);
+    for (size_t i = 0; i < n; ++i) ref += x[i] * y[i];
+    td_cascade d(dot(X, Y));
+    double err = std::abs(double(d - ref));
+    if (err > std::ldexp(std::abs(double(ref)), -150)) {
+        ++nrOfFailedTestCases;
+        if (reportTestCases) std::cerr << "FAIL: dot product differs by " << err << '\n';
+    }
+
+    // axpy with alpha = 1 is add, up to the renormalization of the product
+    cascade_vector<3> W(x);
+    axpy(floatcascade<3>(1.0), Y, W);
+    add(X, Y, Z);
+    for (size_t i = 0; i < n; ++i) {
+        if (relative_error(W[i], widen(Z[i])) > std::ldexp(1.0, -150)) { ++nrOfFailedTestCases; break; }
+    }
+    if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: cascade_vector kernels\n";
+    return nrOfFailedTestCases;
+}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "floatcascade branch-free networks";
+	std::string test_tag    = "cascade_network";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<2>(reportTestCases, 10), "dd network", "add/sub/mul");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<2>(reportTestCases, 1000), "floatcascade<2> network", "add/sub/mul");
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<3>(reportTestCases, 1000), "floatcascade<3> network", "add/sub/mul");
+	// for N = 4 the reference has no extra precision: this checks agreement with the floatcascade<4> operators
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<4>(reportTestCases, 1000), "floatcascade<4> network", "add/sub/mul");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation<2>(reportTestCases), "floatcascade<2> network", "cancellation");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation<3>(reportTestCases), "floatcascade<3> network", "cancellation");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation<4>(reportTestCases), "floatcascade<4> network", "cancellation");
+	nrOfFailedTestCases += ReportTestResult(VerifyNonFinite<2>(reportTestCases), "floatcascade<2> network", "non-finite");
+	nrOfFailedTestCases += ReportTestResult(VerifyNonFinite<3>(reportTestCases), "floatcascade<3> network", "non-finite");
+	nrOfFailedTestCases += ReportTestResult(VerifyNonFinite<4>(reportTestCases), "floatcascade<4> network", "non-finite");
+	nrOfFailedTestCases += ReportTestResult(VerifyCascadeVector(reportTestCases), "cascade_vector<3>", "bulk kernels");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<2>(reportTestCases, 100000), "floatcascade<2> network", "add/sub/mul");
+	nrOfFailedTestCases += ReportTestResult(VerifyNetworkArithmetic<3>(reportTestCases, 100000), "floatcascade<3> network", "add/sub/mul");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
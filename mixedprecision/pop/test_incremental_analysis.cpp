@@ -0,0 +1,212 @@
+// test_incremental_analysis.cpp: validate the worklist-driven incremental POP analysis
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project.
+//
+// Tests that IncrementalPopAnalysis produces the same nsb assignment as the
+// full ExprGraph::analyze() fixpoint, that requirement and carry changes only
+// re-evaluate the affected nodes, and that the threaded evaluation of
+// independent subgraphs matches the serial one.
+
+#include <universal/utility/directives.hpp>
+#include <universal/mixedprecision/incremental_analysis.hpp>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+
+#define VERIFY(cond, msg) do { if (!(cond)) { std::cerr << "FAIL: " << msg << std::endl; ++nrOfFailedTestCases; } } while(0)
+
+namespace sw { namespace universal {
+
+// Compare every node of the incremental analysis against a full analyze() of the graph
+int CompareWithFullAnalysis(ExprGraph& g, const IncrementalPopAnalysis& ia, const std::string& tag) {
+	int nrOfFailedTestCases = 0;
+	g.analyze();
+	for (int i = 0; i < g.size(); ++i) {
+		const auto& node = g.get_node(i);
+		if (node.nsb_forward != ia.get_nsb_forward(i) || node.nsb_backward != ia.get_nsb_backward(i) || node.nsb_final != ia.get_nsb(i)) {
+			VERIFY(false, tag << ": node " << i << " full (" << node.nsb_forward << ", " << node.nsb_backward << ", " << node.nsb_final
+			              << ") != incremental (" << ia.get_nsb_forward(i) << ", " << ia.get_nsb_backward(i) << ", " << ia.get_nsb(i) << ")");
+			break;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// Build a random layered DAG of independent subgraphs (one per output)
+ExprGraph RandomForest(int nrOfTrees, int nodesPerTree, unsigned seed) {
+	std::mt19937 rng(seed);
+	ExprGraph g;
+	for (int t = 0; t < nrOfTrees; ++t) {
+		int first = g.size();
+		g.variable("x" + std::to_string(t), 1.0, 8.0);
+		g.variable("y" + std::to_string(t), 0.5, 2.0);
+		for (int k = 2; k < nodesPerTree; ++k) {
+			std::uniform_int_distribution<int> pick(first, g.size() - 1);
+			int a = pick(rng);
+			int b = pick(rng);
+			switch (rng() % 6) {
+			case 0: g.add(a, b); break;
+			case 1: g.sub(a, b); break;
+			case 2: g.mul(a, b); break;
+			case 3: g.div(a, b); break;
+			case 4: g.abs(a); break;
+			default: g.neg(a); break;
+			}
+		}
+		g.require_nsb(g.size() - 1, 16);
+	}
+	return g;
+}
+
+// Full incremental analysis must agree with the fixpoint
+int TestFullAnalysisEquivalence() {
+	int nrOfFailedTestCases = 0;
+	ExprGraph g;
+	int a = g.variable("a", 8.0, 12.0);
+	int b = g.variable("b", 8.0, 12.0);
+	int c = g.variable("c", 8.0, 12.0);
+	int d = g.variable("d", 8.0, 12.0);
+	int ad = g.mul(a, d);
+	int bc = g.mul(b, c);
+	int det = g.sub(ad, bc);
+	int r = g.sqrt(g.abs(det));
+	g.require_nsb(det, 20);
+	g.require_nsb(r, 12);
+
+	IncrementalPopAnalysis ia(g);
+	ia.analyze();
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, ia, "determinant");
+	return nrOfFailedTestCases;
+}
+
+// Changing an output requirement re-evaluates only its ancestors
+int TestRequirementChange() {
+	int nrOfFailedTestCases = 0;
+	ExprGraph g;
+	// two independent outputs sharing no nodes
+	int x = g.variable("x", 1.0, 8.0);
+	int y = g.variable("y", 1.0, 8.0);
+	int z = g.mul(x, y);
+	int u = g.variable("u", 1.0, 8.0);
+	int v = g.variable("v", 1.0, 8.0);
+	int w = g.add(u, v);
+	g.require_nsb(z, 10);
+	g.require_nsb(w, 10);
+
+	IncrementalPopAnalysis ia(g);
+	ia.analyze();
+	VERIFY(ia.components() == 2, "expected 2 independent subgraphs, got " << ia.components());
+
+	ia.require_nsb(z, 20);
+	g.require_nsb(z, 20);
+	size_t evaluations = ia.propagate();
+	VERIFY(evaluations == 3, "requirement change on z should evaluate z, x, y: got " << evaluations);
+	VERIFY(ia.get_nsb(z) == 20, "z expected 20 bits, got " << ia.get_nsb(z));
+	VERIFY(ia.get_nsb(x) >= 21, "x expected >= 21 bits, got " << ia.get_nsb(x));
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, ia, "raise requirement");
+
+	// lowering the requirement must lower the demand again (no monotone accumulation)
+	ia.require_nsb(z, 8);
+	g.require_nsb(z, 8);
+	ia.propagate();
+	VERIFY(ia.get_nsb(x) == 9, "x expected 9 bits after lowering, got " << ia.get_nsb(x));
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, ia, "lower requirement");
+
+	// no pending changes: nothing to do
+	VERIFY(ia.propagate() == 0, "propagate without changes should be a no-op");
+	return nrOfFailedTestCases;
+}
+
+// Changing a carry bit re-propagates forward to consumers and backward to operands
+int TestCarryChange() {
+	int nrOfFailedTestCases = 0;
+	ExprGraph g;
+	int a = g.variable("a", 1.0, 10.0);
+	int b = g.variable("b", 1.0, 10.0);
+	int a2 = g.mul(a, a);
+	int b2 = g.mul(b, b);
+	int sum = g.add(a2, b2);
+	int result = g.sqrt(sum);
+	g.require_nsb(result, 16);
+
+	IncrementalPopAnalysis ia(g);
+	ia.analyze();
+	ia.set_carry(sum, 0);
+	g.nodes()[static_cast<size_t>(sum)].carry = 0;
+	ia.propagate();
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, ia, "carry change");
+
+	// write back publishes the state to the graph
+	ExprGraph copy = g;
+	ia.write_back(copy);
+	VERIFY(copy.get_node(sum).carry == 0, "carry not written back");
+	for (int i = 0; i < copy.size(); ++i) {
+		VERIFY(copy.get_nsb(i) == ia.get_nsb(i), "write back mismatch at node " << i);
+	}
+	return nrOfFailedTestCases;
+}
+
+// Randomized: a sequence of requirement changes on a large forest, serial and threaded
+int TestRandomizedForest(int nrOfTrees, int nodesPerTree, bool reportTiming) {
+	int nrOfFailedTestCases = 0;
+	ExprGraph g = RandomForest(nrOfTrees, nodesPerTree, 42);
+	IncrementalPopAnalysis serial(g), threaded(g);
+
+	auto begin = std::chrono::steady_clock::now();
+	serial.analyze(1);
+	auto full = std::chrono::steady_clock::now() - begin;
+	threaded.analyze(4);
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, serial, "random forest serial");
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, threaded, "random forest threaded");
+
+	std::mt19937 rng(7);
+	size_t evaluations = 0;
+	begin = std::chrono::steady_clock::now();
+	for (int k = 0; k < 32; ++k) {
+		int node = static_cast<int>(rng() % static_cast<unsigned>(g.size()));
+		int nsb = 4 + static_cast<int>(rng() % 40u);
+		serial.require_nsb(node, nsb);
+		threaded.require_nsb(node, nsb);
+		g.require_nsb(node, nsb);
+		evaluations += serial.propagate(1);
+		threaded.propagate(4);
+	}
+	auto incremental = std::chrono::steady_clock::now() - begin;
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, serial, "random forest incremental serial");
+	nrOfFailedTestCases += CompareWithFullAnalysis(g, threaded, "random forest incremental threaded");
+
+	if (reportTiming) {
+		using us = std::chrono::microseconds;
+		std::cout << "graph of " << g.size() << " nodes in " << serial.components() << " subgraphs\n"
+		          << "full analysis          : " << std::chrono::duration_cast<us>(full).count() << " us\n"
+		          << "32 incremental updates : " << std::chrono::duration_cast<us>(incremental).count() << " us, "
+		          << evaluations << " node evaluations\n";
+	}
+	return nrOfFailedTestCases;
+}
+
+}} // namespace sw::universal
+
+#define TEST_CASE(name, func) do { int f_ = func; if (f_) { std::cout << name << ": FAIL (" << f_ << " errors)\n"; nrOfFailedTestCases += f_; } else { std::cout << name << ": PASS\n"; } } while(0)
+
+int main()
+try {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	std::cout << "POP Incremental Analysis Tests\n" << std::string(40, '=') << "\n\n";
+
+	TEST_CASE("Full analysis equivalence", TestFullAnalysisEquivalence());
+	TEST_CASE("Requirement change", TestRequirementChange());
+	TEST_CASE("Carry change", TestCarryChange());
+	TEST_CASE("Randomized forest", TestRandomizedForest(16, 64, false));
+	TEST_CASE("Large randomized forest", TestRandomizedForest(100, 1000, true));
+
+	std::cout << "\n" << (nrOfFailedTestCases == 0 ? "All incremental analysis tests PASSED" : std::to_string(nrOfFailedTestCases) + " test(s) FAILED") << "\n";
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (const char* msg) { std::cerr << "Caught exception: " << msg << std::endl; return EXIT_FAILURE; }
+catch (...) { std::cerr << "Caught unknown exception" << std::endl; return EXIT_FAILURE; }
@@ -0,0 +1,272 @@
+// packed_array.cpp: dense sub-byte storage tests for arrays of microfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+
+#define MICROFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/microfloat/microfloat.hpp>
+#include <universal/number/microfloat/packed_array.hpp>
+#include <universal/number/mxfloat/mxfloat.hpp>
+#include <universal/number/nvblock/nvblock.hpp>
+#include <universal/verification/test_suite.hpp>
+
+#include <bit>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// every encoding, packed, decodes to the bits of to_float() and of the bfloat16 conversion
+	template<typename ElementType>
+	int VerifyExhaustiveDecode(const std::string& tag) {
+		constexpr unsigned nbits = ElementType::nbits;
+		constexpr size_t encodings = size_t(1) << nbits;
+		int nrOfFailedTests = 0;
+		// several copies of the encodings, so the bulk kernels see whole groups and a partial tail
+		std::vector<ElementType> elements(3 * encodings + 5);
+		for (size_t i = 0; i < elements.size(); ++i) elements[i].setbits(static_cast<unsigned>(i % encodings));
+		packed_array<ElementType> packed{ std::span<const ElementType>(elements) };
+
+		for (isa level : { isa::scalar, isa::avx2, isa::avx512 }) {
+			set_isa_override(level);
+			std::vector<float> f(elements.size());
+			std::vector<bfloat16> b(elements.size());
+			packed.decode(std::span<float>(f));
+			packed.decode(std::span<bfloat16>(b));
+			for (size_t i = 0; i < elements.size(); ++i) {
+				float expected = elements[i].to_float();
+				if (std::bit_cast<uint32_t>(f[i]) != std::bit_cast<uint32_t>(expected) ||
+				    b[i].bits() != bfloat16(expected).bits()) {
+					std::cerr << "FAIL: " << tag << " decode of " << to_binary(elements[i]) << " : " << f[i] << " != " << expected << '\n';
+					++nrOfFailedTests;
+					break;
+				}
+			}
+		}
+		clear_isa_override();
+		return nrOfFailedTests;
+	}
+
+	// proxy writes and reads, and pack/unpack through views at every alignment, against a plain vector
+	template<typename ElementType>
+	int VerifyElementAccess(const std::string& tag) {
+		constexpr unsigned nbits = ElementType::nbits;
+		constexpr size_t N = 203;
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(nbits);
+		std::vector<ElementType> model(N);
+		packed_array<ElementType> a(N);
+		if (a.size_bytes() != (N * nbits + 7) / 8) ++nrOfFailedTests;
+		for (int trial = 0; trial < 2000; ++trial) {
+			size_t i = rng() % N;
+			ElementType v{};
+			v.setbits(static_cast<unsigned>(rng()));
+			model[i] = v;
+			a[i] = v;
+		}
+		for (size_t i = 0; i < N; ++i) {
+			if (ElementType(a[i]).bits() != model[i].bits()) {
+				std::cerr << "FAIL: " << tag << " element " << i << '\n';
+				++nrOfFailedTests;
+				break;
+			}
+		}
+		// subspans at every offset and length, so the bulk paths see heads, whole groups, and tails
+		for (size_t offset = 0; offset < 17; ++offset) {
+			for (size_t count : { size_t(0), size_t(1), size_t(7), size_t(8), size_t(23), size_t(64), N - offset }) {
+				std::vector<ElementType> out(count);
+				packed_unpack(a.view(offset, count), std::span<ElementType>(out));
+				bool match = true;
+				for (size_t i = 0; i < count; ++i) if (out[i].bits() != model[offset + i].bits()) match = false;
+
+				// write the unpacked elements back shifted by one element, and compare the neighbors too
+				packed_array<ElementType> b(N);
+				packed_pack(std::span<const ElementType>(out), b.view(offset + 1 < N - count ? offset + 1 : 0, count));
+				size_t at = (offset + 1 < N - count) ? offset + 1 : 0;
+				for (size_t i = 0; i < N; ++i) {
+					unsigned expected = (i >= at && i < at + count) ? model[offset + i - at].bits() : 0u;
+					if (ElementType(b[i]).bits() != expected) match = false;
+				}
+				if (!match) {
+					std::cerr << "FAIL: " << tag << " view at offset " << offset << " of " << count << " elements\n";
+					++nrOfFailedTests;
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// a tensor of MX blocks keeps its elements packed, and the blocks pack and unpack through views
+	template<typename ElementType>
+	int VerifyPackedBlocks(const std::string& tag) {
+		constexpr size_t BlockSize = 32;
+		constexpr size_t nblocks = 5;
+		int nrOfFailedTests = 0;
+		std::vector<float> src(BlockSize * nblocks);
+		for (size_t i = 0; i < src.size(); ++i) src[i] = std::sin(0.37f * static_cast<float>(i)) * static_cast<float>(1 + i % 7);
+
+		packed_array<ElementType> elements(src.size());
+		std::vector<e8m0> scales(nblocks);
+		std::vector<float> expected(src.size()), dst(src.size());
+		for (size_t b = 0; b < nblocks; ++b) {
+			mxblock<ElementType, BlockSize> blk;
+			blk.quantize(src.data() + b * BlockSize);
+			blk.dequantize(expected.data() + b * BlockSize);
+			blk.pack(elements.view(b * BlockSize, BlockSize));
+			scales[b] = blk.scale();
+		}
+		for (size_t b = 0; b < nblocks; ++b) {
+			mxblock<ElementType, BlockSize> blk;
+			blk.scale() = scales[b];
+			blk.unpack(elements.view(b * BlockSize, BlockSize));
+			blk.dequantize(dst.data() + b * BlockSize);
+		}
+		// the block itself stores its elements packed
+		if (sizeof(mxblock<ElementType, BlockSize>) != mxblock<ElementType, BlockSize>::packed_byte_size()) {
+			std::cerr << "FAIL: " << tag << " mxblock footprint " << sizeof(mxblock<ElementType, BlockSize>) << '\n';
+			++nrOfFailedTests;
+		}
+		if (dst != expected || elements.size_bytes() != nblocks * (mxblock<ElementType, BlockSize>::packed_byte_size() - 1)) {
+			std::cerr << "FAIL: " << tag << " packed mxblock tensor\n";
+			++nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite = "microfloat packed_array tests";
+	int nrOfFailedTestCases = 0;
+
+	// test 1: storage at the real size of the format, in the documented layout
+	std::cout << "+---------    packed storage   --------+\n";
+	{
+		int fails = 0;
+		if (packed_array<e2m1>(4096).size_bytes() != 2048) ++fails;
+		if (packed_array<e2m3>(4096).size_bytes() != 3072) ++fails;
+		if (packed_array<e3m2>(4096).size_bytes() != 3072) ++fails;
+		if (packed_array<e4m3>(4096).size_bytes() != 4096) ++fails;
+		if (packed_array<e2m1>(5).size_bytes() != 3) ++fails;
+		packed_array<e2m1> a(4);
+		a[0] = e2m1(1.0f);    // 0b0010
+		a[1] = e2m1(-6.0f);   // 0b1111
+		a[3] = e2m1(0.5f);    // 0b0001
+		if (a.data()[0] != 0xF2u || a.data()[1] != 0x10u) ++fails;
+		packed_array<e3m2> b(4);
+		b[1] = e3m2(-0.0625f);   // 0b100001 at bits 6..11
+		if (b.data()[0] != 0x40u || b.data()[1] != 0x08u || b.data()[2] != 0x00u) ++fails;
+		if (fails == 0) std::cout << "packed storage: PASS\n";
+		else std::cerr << "FAIL: packed storage\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 2: bulk decode of every encoding, under every kernel variant
+	std::cout << "+---------    bulk decode   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyExhaustiveDecode<e2m1>("e2m1");
+		fails += VerifyExhaustiveDecode<e2m3>("e2m3");
+		fails += VerifyExhaustiveDecode<e3m2>("e3m2");
+		fails += VerifyExhaustiveDecode<e4m3>("e4m3");
+		fails += VerifyExhaustiveDecode<e4m3_saturating>("e4m3_saturating");
+		fails += VerifyExhaustiveDecode<e5m2>("e5m2");
+		if (fails == 0) std::cout << "bulk decode: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 3: proxy references and views
+	std::cout << "+---------    element access and views   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyElementAccess<e2m1>("e2m1");
+		fails += VerifyElementAccess<e2m3>("e2m3");
+		fails += VerifyElementAccess<e4m3>("e4m3");
+		if (fails == 0) std::cout << "element access and views: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 4: container behavior
+	std::cout << "+---------    container   --------+\n";
+	{
+		int fails = 0;
+		packed_array<e2m3> a(13, e2m3(1.5f));
+		for (e2m3 v : std::as_const(a)) if (v.to_float() != 1.5f) ++fails;
+		for (auto r : a) r = e2m3(-2.0f);
+		if (float(a[12]) != -2.0f) ++fails;
+		a.resize(5);
+		a.resize(13);   // the new elements are zero
+		if (float(a[4]) != -2.0f || float(a[5]) != 0.0f || float(a[12]) != 0.0f) ++fails;
+		packed_array<e2m3> b(13);
+		for (size_t i = 0; i < 5; ++i) b[i] = a[i];
+		if (!(a == b)) ++fails;
+		std::vector<float> values{ 0.3f, -7.9f, 2.6f, 100.0f };
+		packed_array<e2m1> c{ std::span<const float>(values) };
+		if (float(c[0]) != 0.5f || float(c[1]) != -6.0f || float(c[2]) != 3.0f || float(c[3]) != 6.0f) ++fails;
+		try {
+			c.at(4);
+			++fails;
+		}
+		catch (const std::out_of_range&) {}
+		if (fails == 0) std::cout << "container: PASS\n";
+		else std::cerr << "FAIL: container\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 5: block formats on packed element storage
+	std::cout << "+---------    packed block tensors   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyPackedBlocks<e2m1>("mxfp4");
+		fails += VerifyPackedBlocks<e3m2>("mxfp6");
+		fails += VerifyPackedBlocks<e4m3_saturating>("mxfp8");
+
+		// NVFP4: 16 e2m1 elements and an e4m3 block scale, 9 bytes per block
+		constexpr size_t nblocks = 3;
+		std::vector<float> src(16 * nblocks), expected(16 * nblocks), dst(16 * nblocks);
+		for (size_t i = 0; i < src.size(); ++i) src[i] = std::cos(0.21f * static_cast<float>(i)) * 3.0f;
+		packed_array<e2m1> elements(src.size());
+		for (size_t b = 0; b < nblocks; ++b) {
+			nvfp4 blk;
+			blk.quantize(src.data() + 16 * b);
+			blk.dequantize(expected.data() + 16 * b);
+			blk.pack(elements.view(16 * b, 16));
+			nvfp4 back;
+			back.block_scale() = blk.block_scale();
+			back.unpack(elements.view(16 * b, 16));
+			back.dequantize(dst.data() + 16 * b);
+		}
+		if (dst != expected || nvfp4::packed_byte_size() != 9 || sizeof(nvfp4) != 9) {
+			std::cerr << "FAIL: packed nvfp4 tensor\n";
+			++fails;
+		}
+		if (fails == 0) std::cout << "packed block tensors: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
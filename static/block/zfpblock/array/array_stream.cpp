@@ -0,0 +1,282 @@
+// array_stream.cpp: streaming and out-of-core storage tests for zfparray (ZFP compressed array container)
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+
+#define ZFPBLOCK_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/zfpblock/zfpblock.hpp>
+#include <universal/number/zfpblock/zfparray_stream.hpp>
+#include <universal/verification/test_suite.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	template<typename Real>
+	std::vector<Real> smooth_field(size_t n) {
+		std::vector<Real> v(n);
+		for (size_t i = 0; i < n; ++i) {
+			v[i] = static_cast<Real>(std::sin(static_cast<double>(i) * 0.01) + 0.5 * std::cos(static_cast<double>(i) * 0.03));
+		}
+		return v;
+	}
+
+	inline std::string scratch_file(const std::string& name) {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+
+	// a file written in uneven chunks must hold the blocks of the in-memory zfparray, byte for byte,
+	// and decode to the same values through every access path
+	template<typename Real, unsigned Dim>
+	int VerifyChunkedFile(const std::string& path, size_t n, double rate) {
+		constexpr size_t BLOCK_SIZE = zfparray<Real, Dim>::BLOCK_SIZE;
+		int nrOfFailedTests = 0;
+		std::vector<Real> src = smooth_field<Real>(n);
+		zfparray<Real, Dim> reference(n, rate, src.data());
+		std::vector<Real> expected(n);
+		reference.decompress(expected.data());
+
+		{
+			zfparray_writer<Real, Dim> out(path, rate);
+			size_t chunk = 1, done = 0;
+			while (done < n) {
+				size_t take = std::min(chunk, n - done);
+				out.append(src.data() + done, take);
+				done += take;
+				chunk = chunk * 3 + 1;
+			}
+			out.close();
+			if (out.size() != n || out.num_blocks() != reference.num_blocks()) ++nrOfFailedTests;
+		}
+
+		zfparray_reader<Real, Dim> in(path);
+		if (in.size() != n || in.num_blocks() != reference.num_blocks() || in.bytes_per_block() != reference.bytes_per_block()) {
+			std::cerr << "FAIL: reader geometry\n";
+			return ++nrOfFailedTests;
+		}
+		if (std::memcmp(in.block_data(0), reference.data(), reference.data_size()) != 0) {
+			std::cerr << "FAIL: stored blocks differ from zfparray::data()\n";
+			++nrOfFailedTests;
+		}
+		std::vector<Real> dst(n);
+		in.decompress(dst.data());
+		if (dst != expected) {
+			std::cerr << "FAIL: decompress differs from zfparray::decompress\n";
+			++nrOfFailedTests;
+		}
+		// random access, in a stride that crosses blocks
+		for (size_t i = 0; i < n; i += 7) {
+			if (in(i) != expected[i]) {
+				std::cerr << "FAIL: element " << i << '\n';
+				++nrOfFailedTests;
+				break;
+			}
+		}
+		// sequential sweeps, with and without prefetch, over all blocks and over a subrange
+		for (unsigned prefetch : { 0u, 1u, 4u }) {
+			size_t next = 0;
+			bool match = true;
+			for (const auto& block : in.sweep(prefetch)) {
+				if (block.index != next++) match = false;
+				size_t start = block.index * BLOCK_SIZE;
+				if (block.values.size() != std::min(BLOCK_SIZE, n - start)) match = false;
+				for (size_t i = 0; i < block.values.size(); ++i) if (block.values[i] != expected[start + i]) match = false;
+			}
+			if (next != in.num_blocks() || !match) {
+				std::cerr << "FAIL: sweep with prefetch " << prefetch << '\n';
+				++nrOfFailedTests;
+			}
+			size_t first = in.num_blocks() / 3, last = 2 * in.num_blocks() / 3;
+			next = first;
+			for (const auto& block : in.sweep(first, last, prefetch)) {
+				if (block.index != next++) match = false;
+			}
+			if (next != last || !match) {
+				std::cerr << "FAIL: subrange sweep with prefetch " << prefetch << '\n';
+				++nrOfFailedTests;
+			}
+		}
+		std::remove(path.c_str());
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite = "zfparray streaming storage tests";
+	int nrOfFailedTestCases = 0;
+
+	// test 1: chunked appends to a file reproduce the in-memory array
+	std::cout << "+---------    chunked file round-trip   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyChunkedFile<float, 1>(scratch_file("zfparray_stream_1f.zfp"), 5001, 16.0);
+		fails += VerifyChunkedFile<double, 1>(scratch_file("zfparray_stream_1d.zfp"), 3000, 12.0);
+		fails += VerifyChunkedFile<float, 2>(scratch_file("zfparray_stream_2f.zfp"), 16 * 300 + 5, 8.0);
+		fails += VerifyChunkedFile<double, 3>(scratch_file("zfparray_stream_3d.zfp"), 64 * 100 + 63, 10.5);
+		if (fails == 0) std::cout << "chunked file round-trip: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 2: a memory region as the backing store
+	std::cout << "+---------    memory region storage   --------+\n";
+	{
+		constexpr size_t N = 203;
+		constexpr double rate = 12.0;
+		std::vector<float> src = smooth_field<float>(N);
+		std::vector<uint8_t> region(zfparray_writer<float, 1>::required_bytes(N, rate));
+		{
+			zfparray_writer<float, 1> out(region, rate);
+			out.append(std::span<const float>(src));
+			out.close();
+			if (out.bytes_written() != region.size()) {
+				std::cerr << "FAIL: required_bytes does not match the bytes written\n";
+				++nrOfFailedTestCases;
+			}
+		}
+		zfparray1f reference(N, rate, src.data());
+		std::vector<float> expected(N), dst(N);
+		reference.decompress(expected.data());
+		zfparray_reader<float, 1> in{ std::span<const uint8_t>(region) };
+		in.decompress(dst.data());
+		if (in.size() != N || dst != expected) {
+			std::cerr << "FAIL: region round-trip\n";
+			++nrOfFailedTestCases;
+		}
+
+		// a region without room for the next block
+		bool caught = false;
+		std::vector<uint8_t> small(zfparray_writer<float, 1>::required_bytes(8, rate));
+		try {
+			zfparray_writer<float, 1> out(small, rate);
+			out.append(src.data(), 12);
+		}
+		catch (const zfparray_io_error&) {
+			caught = true;
+		}
+		if (!caught) {
+			std::cerr << "FAIL: overflowing region not reported\n";
+			++nrOfFailedTestCases;
+		}
+		else {
+			std::cout << "memory region storage: PASS\n";
+		}
+	}
+
+	// test 3: appending in-memory arrays, copied when the rates match and recompressed otherwise
+	std::cout << "+---------    append zfparray   --------+\n";
+	{
+		constexpr size_t N = 64;
+		std::vector<float> src = smooth_field<float>(2 * N + 2);
+		zfparray1f a(N, 16.0, src.data());
+		zfparray1f b(N + 2, 8.0, src.data() + N);
+		a.set(5, 0.25f);   // a dirty cache must be flushed before its blocks are copied
+
+		std::vector<uint8_t> region(zfparray_writer<float, 1>::required_bytes(2 * N + 2, 16.0));
+		zfparray_writer<float, 1> out(region, 16.0);
+		out.append(a);
+		out.append(b);
+		out.close();
+
+		std::vector<float> fromA(N), fromB(N + 2), dst(2 * N + 2);
+		a.decompress(fromA.data());
+		b.decompress(fromB.data());
+		zfparray_reader<float, 1> in{ std::span<const uint8_t>(region) };
+		in.decompress(dst.data());
+		bool pass = (in.size() == 2 * N + 2) && (std::memcmp(in.block_data(0), a.data(), a.data_size()) == 0);
+		for (size_t i = 0; i < N; ++i) if (dst[i] != fromA[i]) pass = false;
+		for (size_t i = 0; i < N + 2; ++i) if (std::abs(dst[N + i] - fromB[i]) > 1.0e-3f) pass = false;
+		if (pass) {
+			std::cout << "append zfparray: PASS\n";
+		}
+		else {
+			std::cerr << "FAIL: append zfparray\n";
+			++nrOfFailedTestCases;
+		}
+	}
+
+	// test 4: a reader follows a file that is still being written
+	std::cout << "+---------    streaming reader   --------+\n";
+	{
+		std::string path = scratch_file("zfparray_stream_live.zfp");
+		std::vector<float> src = smooth_field<float>(30);
+		bool pass = true;
+		{
+			zfparray_writer<float, 1> out(path, 16.0);
+			out.append(src.data(), 10);
+			zfparray_reader<float, 1> in(path);
+			if (in.size() != 8) pass = false;        // two whole blocks, the pending elements are not visible
+			out.append(src.data() + 10, 20);
+			if (in.size() != 8) pass = false;        // the mapping is a snapshot
+			in.refresh();
+			if (in.size() != 28) pass = false;
+			out.close();
+			in.refresh();
+			if (in.size() != 30 || in.num_blocks() != 8) pass = false;
+		}
+		std::remove(path.c_str());
+		if (pass) {
+			std::cout << "streaming reader: PASS\n";
+		}
+		else {
+			std::cerr << "FAIL: streaming reader\n";
+			++nrOfFailedTestCases;
+		}
+	}
+
+	// test 5: storage errors
+	std::cout << "+---------    storage errors   --------+\n";
+	{
+		int caught = 0;
+		std::vector<uint8_t> garbage(64, 0x5A);
+		try { zfparray_reader<float, 1> in{ std::span<const uint8_t>(garbage) }; }
+		catch (const zfparray_io_error&) { ++caught; }
+
+		std::vector<uint8_t> region(zfparray_writer<float, 1>::required_bytes(16, 8.0));
+		{
+			zfparray_writer<float, 1> out(region, 8.0);
+		}
+		try { zfparray_reader<double, 1> in{ std::span<const uint8_t>(region) }; }   // stored as float
+		catch (const zfparray_io_error&) { ++caught; }
+		try { zfparray_reader<float, 2> in{ std::span<const uint8_t>(region) }; }    // stored as 1D blocks
+		catch (const zfparray_io_error&) { ++caught; }
+		try { zfparray_reader<float, 1> in(scratch_file("zfparray_stream_missing.zfp")); }
+		catch (const zfparray_io_error&) { ++caught; }
+
+		if (caught == 4) {
+			std::cout << "storage errors: PASS\n";
+		}
+		else {
+			std::cerr << "FAIL: " << (4 - caught) << " storage errors not reported\n";
+			nrOfFailedTestCases += 4 - caught;
+		}
+	}
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,216 @@
+// fast_codec.cpp: the runtime ZFP codec must reproduce the constexpr reference codec bit for bit
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+
+#define ZFPBLOCK_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/zfpblock/zfpblock.hpp>
+#include <universal/number/zfpblock/zfp_codec_fast.hpp>
+#include <universal/verification/test_suite.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// blocks that exercise every path of the codec: smooth and random data, zeros, subnormals,
+	// extreme exponents, single coefficients, and non-finite values
+	template<typename Real, unsigned Dim>
+	std::vector<Real> codec_blocks() {
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		std::vector<Real> v;
+		std::mt19937_64 rng(7);
+		std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+		auto block = [&](auto&& gen) { for (size_t i = 0; i < N; ++i) v.push_back(static_cast<Real>(gen(i))); };
+		for (int b = 0; b < 8; ++b) block([&](size_t i) { return std::sin(0.1 * double(i + N * b)) * std::pow(10.0, b - 4); });
+		for (int b = 0; b < 8; ++b) block([&](size_t) { return uniform(rng) * std::pow(2.0, 3 * b); });
+		block([](size_t) { return 0.0; });
+		block([](size_t i) { return i == N / 2 ? -3.5 : 0.0; });
+		block([](size_t i) { return (i % 2) ? 1.0 : -1.0; });
+		block([](size_t i) { return double(i) * std::numeric_limits<Real>::denorm_min(); });
+		block([](size_t i) { return double(i) * std::numeric_limits<Real>::min(); });
+		block([&](size_t) { return uniform(rng) * std::numeric_limits<Real>::max(); });
+		block([&](size_t i) { return i == 1 ? std::numeric_limits<Real>::infinity() : uniform(rng); });
+		block([&](size_t i) { return i == 2 ? std::numeric_limits<Real>::quiet_NaN() : uniform(rng); });
+		block([](size_t) { return -0.0; });
+		for (int b = 0; b < 5; ++b) block([&](size_t) { return uniform(rng) * 1.0e-3; });
+		return v;
+	}
+
+	// compare the codes and the decoded values of one codec configuration over all blocks
+	template<typename Real, unsigned Dim>
+	int VerifyConfiguration(const std::vector<Real>& src, size_t max_bytes, unsigned maxprec, size_t maxbits) {
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		size_t nblocks = src.size() / N;
+		int nrOfFailedTests = 0;
+
+		std::vector<uint8_t> ref(nblocks * max_bytes, 0xCD), fast(nblocks * max_bytes, 0xCD), batch(nblocks * max_bytes, 0xCD);
+		std::vector<Real> rdec(src.size()), fdec(src.size()), bdec(src.size());
+		for (size_t b = 0; b < nblocks; ++b) {
+			size_t rbits = encode_block<Real, Dim>(src.data() + b * N, ref.data() + b * max_bytes, max_bytes, maxprec, maxbits);
+			size_t fbits = encode_block_fast<Real, Dim>(src.data() + b * N, fast.data() + b * max_bytes, max_bytes, maxprec, maxbits);
+			if (rbits != fbits) ++nrOfFailedTests;
+			rbits = decode_block<Real, Dim>(ref.data() + b * max_bytes, max_bytes, rdec.data() + b * N, maxprec, maxbits);
+			fbits = decode_block_fast<Real, Dim>(ref.data() + b * max_bytes, max_bytes, fdec.data() + b * N, maxprec, maxbits);
+			if (rbits != fbits) ++nrOfFailedTests;
+		}
+		encode_blocks_fast<Real, Dim>(src.data(), nblocks, batch.data(), max_bytes, maxprec, maxbits);
+		decode_blocks_fast<Real, Dim>(ref.data(), nblocks, max_bytes, bdec.data(), maxprec, maxbits);
+
+		if (ref != fast || ref != batch) {
+			std::cerr << "FAIL: codes differ, maxprec " << maxprec << " maxbits " << maxbits << '\n';
+			++nrOfFailedTests;
+		}
+		// bitwise comparison, so NaNs and signed zeros count
+		if (std::memcmp(rdec.data(), fdec.data(), rdec.size() * sizeof(Real)) != 0 ||
+		    std::memcmp(rdec.data(), bdec.data(), rdec.size() * sizeof(Real)) != 0) {
+			std::cerr << "FAIL: decoded values differ, maxprec " << maxprec << " maxbits " << maxbits << '\n';
+			++nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// fixed-rate, fixed-precision, and lossless configurations of the codec
+	template<typename Real, unsigned Dim>
+	int VerifyFastCodec() {
+		using Traits = zfp_type_traits<Real>;
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		constexpr unsigned precision = CHAR_BIT * sizeof(typename Traits::UInt);
+		constexpr size_t max_bytes = zfp_max_bytes<Real, Dim>::value;
+		constexpr size_t unbounded = 1 + Traits::ebits + N * precision;
+
+		std::vector<Real> src = codec_blocks<Real, Dim>();
+		int nrOfFailedTests = 0;
+		for (double rate : { 0.5, 1.0, 2.0, 4.0, 7.0, 8.0, 12.5, 16.0, 24.0, 32.0 }) {
+			size_t maxbits = static_cast<size_t>(rate * N);
+			nrOfFailedTests += VerifyConfiguration<Real, Dim>(src, (maxbits + 7) / 8, precision, maxbits);
+		}
+		for (unsigned maxprec : { 1u, 4u, 8u, 13u, 20u, 32u, precision }) {
+			nrOfFailedTests += VerifyConfiguration<Real, Dim>(src, max_bytes, maxprec, unbounded);
+		}
+		// a buffer shorter than the bit budget: the codes are cut at the buffer end
+		nrOfFailedTests += VerifyConfiguration<Real, Dim>(src, 5, precision, 16 * N);
+		return nrOfFailedTests;
+	}
+
+	// the codec under every kernel variant; an override above the host level runs the host kernels
+	template<typename Real, unsigned Dim>
+	int VerifyAllKernels() {
+		int nrOfFailedTests = 0;
+		for (isa level : { isa::scalar, isa::avx2, isa::avx512 }) {
+			set_isa_override(level);
+			nrOfFailedTests += VerifyFastCodec<Real, Dim>();
+		}
+		clear_isa_override();
+		return nrOfFailedTests;
+	}
+
+	// random bytes reach decoder states the encoder never produces
+	template<typename Real, unsigned Dim>
+	int VerifyArbitraryCodes() {
+		constexpr size_t N = zfp_block_size<Dim>::value;
+		constexpr size_t max_bytes = zfp_max_bytes<Real, Dim>::value;
+		std::mt19937_64 rng(11);
+		int nrOfFailedTests = 0;
+		for (int trial = 0; trial < 2000; ++trial) {
+			uint8_t code[max_bytes];
+			for (auto& c : code) c = static_cast<uint8_t>(rng());
+			code[0] |= 1u;   // a nonzero block
+			unsigned maxprec = 1 + static_cast<unsigned>(rng() % (CHAR_BIT * sizeof(Real)));
+			size_t maxbits = static_cast<size_t>(rng() % (8 * max_bytes));
+			Real r[N], f[N];
+			decode_block<Real, Dim>(code, max_bytes, r, maxprec, maxbits);
+			decode_block_fast<Real, Dim>(code, max_bytes, f, maxprec, maxbits);
+			if (std::memcmp(r, f, sizeof(r)) != 0) ++nrOfFailedTests;
+		}
+		if (nrOfFailedTests > 0) std::cerr << "FAIL: " << nrOfFailedTests << " arbitrary codes decode differently\n";
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite = "zfp fast codec tests";
+	int nrOfFailedTestCases = 0;
+
+	// test 1: the fast codec against the reference codec
+	std::cout << "+---------    fast codec bit-exactness   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyAllKernels<float, 1>();
+		fails += VerifyAllKernels<float, 2>();
+		fails += VerifyAllKernels<float, 3>();
+		fails += VerifyAllKernels<double, 1>();
+		fails += VerifyAllKernels<double, 2>();
+		fails += VerifyAllKernels<double, 3>();
+		if (fails == 0) std::cout << "fast codec bit-exactness: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 2: arbitrary bytes decode like the reference decodes them
+	std::cout << "+---------    arbitrary codes   --------+\n";
+	{
+		int fails = 0;
+		fails += VerifyArbitraryCodes<float, 1>();
+		fails += VerifyArbitraryCodes<float, 3>();
+		fails += VerifyArbitraryCodes<double, 2>();
+		fails += VerifyArbitraryCodes<double, 3>();
+		if (fails == 0) std::cout << "arbitrary codes: PASS\n";
+		nrOfFailedTestCases += fails;
+	}
+
+	// test 3: the containers produce the same blocks through either codec
+	std::cout << "+---------    container codes   --------+\n";
+	{
+		constexpr size_t n = 1000;
+		std::vector<double> src(n), dst(n);
+		for (size_t i = 0; i < n; ++i) src[i] = std::sin(0.01 * double(i)) * std::exp(0.001 * double(i));
+		zfparray1d a(n, 12.0, src.data());
+		std::vector<uint8_t> expected(a.data_size());
+		for (size_t b = 0; b < a.num_blocks(); ++b) {
+			double block[4]{};
+			for (size_t i = 0; i < 4 && 4 * b + i < n; ++i) block[i] = src[4 * b + i];
+			uint8_t code[zfp_max_bytes<double, 1>::value]{};
+			encode_block<double, 1>(block, code, a.bytes_per_block(), 64, 48);
+			std::memcpy(expected.data() + b * a.bytes_per_block(), code, a.bytes_per_block());
+		}
+		a.decompress(dst.data());
+		double maxerr = 0;
+		for (size_t i = 0; i < n; ++i) maxerr = std::max(maxerr, std::abs(dst[i] - src[i]));
+		if (std::memcmp(a.data(), expected.data(), expected.size()) == 0 && maxerr < 1.0e-2) {
+			std::cout << "container codes: PASS\n";
+		}
+		else {
+			std::cerr << "FAIL: zfparray blocks differ from the reference codec\n";
+			++nrOfFailedTestCases;
+		}
+	}
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
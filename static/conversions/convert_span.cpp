@@ -0,0 +1,227 @@
+// convert_span.cpp: test suite for bulk conversion of arrays between Universal number types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// number system includes
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/bfloat16/bfloat16.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+// bulk conversion infrastructure
+#include <universal/number/convert/convert_span.hpp>
+// test infrastructure
+#include <universal/verification/test_suite.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// the bit pattern of a converted value; NaN payloads compare as bits, not as values
+	template<typename T>
+	std::uint64_t bitsOf(const T& v) {
+		if constexpr (detail::ieee_binary_layout<T>::value) {
+			return detail::ieee_binary_layout<T>::get(v);
+		}
+		else {
+			return detail::encoding_of(v);
+		}
+	}
+
+	// a strategy must produce the same bits as converting each element by itself
+	template<typename Src, typename Dst, conversion_strategy strategy>
+	int VerifyAgainstElementwise(const std::vector<Src>& src, bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::vector<Dst> dst;
+		convert_span<Src, Dst, strategy>(src, dst);
+		for (std::size_t i = 0; i < src.size(); ++i) {
+			Dst ref = detail::convert_element<Dst>(src[i]);
+			if (bitsOf(dst[i]) != bitsOf(ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) {
+					std::cerr << "FAIL: " << to_binary(src[i]) << " : " << to_binary(dst[i]) << " != " << to_binary(ref) << '\n';
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// every encoding of a narrow type
+	template<typename Src>
+	std::vector<Src> allEncodings() {
+		std::vector<Src> v(std::size_t(1) << Src::nbits);
+		for (std::size_t i = 0; i < v.size(); ++i) v[i].setbits(i);
+		return v;
+	}
+
+	// random bit patterns of a native type, plus the patterns around zero, the subnormal boundary,
+	// the top of the range and the non-finite encodings
+	template<typename Native>
+	std::vector<Native> nativeSamples(std::size_t n, std::uint64_t seed) {
+		using Layout = detail::ieee_binary_layout<Native>;
+		std::mt19937_64 rng(seed);
+		std::vector<Native> v(n);
+		for (auto& x : v) Layout::set(x, rng() >> (64 - Layout::nbits));
+		for (Native special : { Native(0), -Native(0), std::numeric_limits<Native>::denorm_min(), std::numeric_limits<Native>::min(),
+		                        std::numeric_limits<Native>::max(), std::numeric_limits<Native>::infinity(),
+		                        -std::numeric_limits<Native>::infinity(), std::numeric_limits<Native>::quiet_NaN() }) {
+			v.push_back(special);
+		}
+		// every exponent with fraction patterns that sit on and around the rounding ties of narrower formats
+		for (int e = std::numeric_limits<Native>::min_exponent - std::numeric_limits<Native>::digits; e < std::numeric_limits<Native>::max_exponent; ++e) {
+			for (Native f : { Native(1), Native(1.5), Native(1.0009765625), Native(1.00048828125), Native(1.00146484375), Native(1.99951171875) }) {
+				Native x = std::ldexp(f, e);
+				v.push_back(x);
+				v.push_back(-x);
+				v.push_back(std::nextafter(x, Native(0)));
+				v.push_back(std::nextafter(x, std::numeric_limits<Native>::infinity()));
+			}
+		}
+		return v;
+	}
+
+	// random encodings of a type of at most 64 bits, each with its low bits also replaced by the
+	// patterns on and around a rounding tie at every width, so that narrower destinations see ties
+	template<typename Src>
+	std::vector<Src> wordSamples(std::size_t n, std::uint64_t seed) {
+		std::mt19937_64 rng(seed);
+		std::vector<Src> v;
+		Src x{};
+		for (std::size_t i = 0; i < n; ++i) {
+			std::uint64_t raw = rng() >> (64 - Src::nbits);
+			x.setbits(raw);
+			v.push_back(x);
+			unsigned k = 1u + static_cast<unsigned>(rng() % (Src::nbits - 2));
+			std::uint64_t tie = std::uint64_t(1) << (k - 1);
+			std::uint64_t high = raw & ~((tie << 1) - 1u);
+			for (std::uint64_t low : { tie, tie - 1u, tie + 1u }) {
+				x.setbits(high | (low & ((tie << 1) - 1u)));
+				v.push_back(x);
+			}
+		}
+		return v;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "convert_span: bulk cross-type conversion";
+	std::string test_tag    = "convert_span";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using bf16 = cfloat<16, 8, std::uint16_t, true, false, false>;
+	using e5m2 = cfloat<8, 5, std::uint8_t, true, false, false>;
+
+	// strategy selection
+	static_assert(default_conversion_strategy_v<posit<8, 0>, single> == conversion_strategy::table);
+	static_assert(default_conversion_strategy_v<half, posit<32, 2>> == conversion_strategy::table);
+	static_assert(default_conversion_strategy_v<bfloat16, float> == conversion_strategy::table);
+	static_assert(default_conversion_strategy_v<float, half> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<single, bf16> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<duble, single> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<posit<32, 2>, single> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<posit<64, 3>, double> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<single, posit<32, 2>> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<fixpnt<16, 8>, posit<16, 1>> == conversion_strategy::table);
+	static_assert(default_conversion_strategy_v<fixpnt<32, 16>, posit<16, 1>> == conversion_strategy::remap);
+	static_assert(default_conversion_strategy_v<posit<32, 2>, fixpnt<32, 16>> == conversion_strategy::element);   // fixed-points do not encode
+	static_assert(!conversion_remap_available_v<fp8e4m3, float>);   // max-exponent values are not IEEE
+	static_assert(!conversion_remap_available_v<duble, float>);     // cfloat's conversion to float rounds more than once
+	static_assert(!conversion_remap_available_v<fixpnt<32, 16>, float>);   // and so does fixpnt's
+	static_assert(!conversion_remap_available_v<fixpnt<64, 32>, posit<32, 2>>);   // universal_cast rounds it to double first
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, half, conversion_strategy::remap>(nativeSamples<float>(1000, 1), reportTestCases), "float -> half", "remap");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	// table: exhaustive over the source encodings
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<8, 0>, single, conversion_strategy::table>(allEncodings<posit<8, 0>>(), reportTestCases), "posit<8,0> -> single", "table");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<16, 1>, single, conversion_strategy::table>(allEncodings<posit<16, 1>>(), reportTestCases), "posit<16,1> -> single", "table");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<16, 1>, float, conversion_strategy::table>(allEncodings<posit<16, 1>>(), reportTestCases), "posit<16,1> -> float", "table");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<half, posit<32, 2>, conversion_strategy::table>(allEncodings<half>(), reportTestCases), "half -> posit<32,2>", "table");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<bfloat16, float, conversion_strategy::table>(allEncodings<bfloat16>(), reportTestCases), "bfloat16 -> float", "table");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<fixpnt<16, 8>, posit<16, 1>, conversion_strategy::table>(allEncodings<fixpnt<16, 8>>(), reportTestCases), "fixpnt<16,8> -> posit<16,1>", "table");
+
+	// remap: exhaustive for narrow sources, sampled for wide ones
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<e5m2, float, conversion_strategy::remap>(allEncodings<e5m2>(), reportTestCases), "e5m2 -> float", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<half, float, conversion_strategy::remap>(allEncodings<half>(), reportTestCases), "half -> float", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<half, bf16, conversion_strategy::remap>(allEncodings<half>(), reportTestCases), "half -> bf16", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<bf16, half, conversion_strategy::remap>(allEncodings<bf16>(), reportTestCases), "bf16 -> half", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, half, conversion_strategy::remap>(nativeSamples<float>(10000, 1), reportTestCases), "float -> half", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, bf16, conversion_strategy::remap>(nativeSamples<float>(10000, 2), reportTestCases), "float -> bf16", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, e5m2, conversion_strategy::remap>(nativeSamples<float>(10000, 3), reportTestCases), "float -> e5m2", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<double, single, conversion_strategy::remap>(nativeSamples<double>(10000, 4), reportTestCases), "double -> single", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<double, half, conversion_strategy::remap>(nativeSamples<double>(10000, 5), reportTestCases), "double -> half", "remap");
+
+	// remap of posit and fixpnt words, into and out of the IEEE layouts and posits
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<32, 2>, single, conversion_strategy::remap>(wordSamples<posit<32, 2>>(10000, 8), reportTestCases), "posit<32,2> -> single", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<32, 2>, half, conversion_strategy::remap>(wordSamples<posit<32, 2>>(10000, 9), reportTestCases), "posit<32,2> -> half", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<32, 2>, posit<16, 1>, conversion_strategy::remap>(wordSamples<posit<32, 2>>(10000, 10), reportTestCases), "posit<32,2> -> posit<16,1>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<64, 3>, single, conversion_strategy::remap>(wordSamples<posit<64, 3>>(10000, 11), reportTestCases), "posit<64,3> -> single", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<posit<64, 2>, posit<32, 2>, conversion_strategy::remap>(wordSamples<posit<64, 2>>(10000, 12), reportTestCases), "posit<64,2> -> posit<32,2>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<fixpnt<32, 16>, posit<16, 1>, conversion_strategy::remap>(wordSamples<fixpnt<32, 16>>(10000, 13), reportTestCases), "fixpnt<32,16> -> posit<16,1>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<fixpnt<64, 32>, posit<64, 2>, conversion_strategy::remap>(wordSamples<fixpnt<64, 32>>(10000, 14), reportTestCases), "fixpnt<64,32> -> posit<64,2>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<fixpnt<32, 16>, half, conversion_strategy::remap>(wordSamples<fixpnt<32, 16>>(10000, 15), reportTestCases), "fixpnt<32,16> -> half", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, posit<16, 1>, conversion_strategy::remap>(nativeSamples<float>(10000, 16), reportTestCases), "float -> posit<16,1>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<double, posit<32, 2>, conversion_strategy::remap>(nativeSamples<double>(10000, 17), reportTestCases), "double -> posit<32,2>", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<single, posit<32, 2>, conversion_strategy::remap>(wordSamples<single>(10000, 18), reportTestCases), "single -> posit<32,2>", "remap");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, half, conversion_strategy::remap>(nativeSamples<float>(1000000, 6), reportTestCases), "float -> half", "remap");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstElementwise<float, bf16, conversion_strategy::remap>(nativeSamples<float>(1000000, 7), reportTestCases), "float -> bf16", "remap");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,294 @@
+// from_chars.cpp: test suite for correctly rounded decimal parsing into posits and cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// number system includes
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+// shortest decimal formatting, for the round trip
+#include <universal/number/posit/to_chars.hpp>
+#include <universal/number/cfloat/to_chars.hpp>
+// test infrastructure
+#include <universal/verification/test_suite.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	template<typename Number>
+	std::from_chars_result fromString(const std::string& s, Number& v) {
+		return from_chars(s.data(), s.data() + s.size(), v);
+	}
+
+	// the exact decimal expansion of a double
+	inline std::string exactDecimal(double x) {
+		char buf[800];
+		std::snprintf(buf, sizeof(buf), "%.760g", x);
+		return buf;
+	}
+
+	// decimal strings of every shape: random digit strings, float midpoints and their neighbors,
+	// and doubles printed at 17 and 9 digits
+	inline std::vector<std::string> decimalSamples(std::size_t n, std::uint64_t seed) {
+		std::mt19937_64 rng(seed);
+		std::vector<std::string> v;
+		char buf[64];
+		while (v.size() < n) {
+			std::string s = (rng() & 1) ? "-" : "";
+			int nrDigits = 1 + static_cast<int>(rng() % 25);
+			for (int k = 0; k < nrDigits; ++k) {
+				s += static_cast<char>('0' + rng() % 10);
+				if (k == 0 && rng() % 3 == 0) s += '.';
+			}
+			s += 'e' + std::to_string(static_cast<int>(rng() % 700) - 350);
+			v.push_back(s);
+
+			std::uint32_t fb = static_cast<std::uint32_t>(rng()) & 0x7FFF'FFFFu;
+			float f;
+			std::memcpy(&f, &fb, sizeof(f));
+			if (std::isfinite(f) && std::isfinite(std::nextafter(f, 1.0e30f))) {
+				std::string mid = exactDecimal((double(f) + double(std::nextafter(f, 1.0e30f))) / 2.0);
+				v.push_back(mid);
+				if (mid.find('e') == std::string::npos && mid.find('.') != std::string::npos) v.push_back(mid + "000000000000000000000001");
+			}
+
+			std::uint64_t db = rng() >> 1;
+			double x;
+			std::memcpy(&x, &db, sizeof(x));
+			if (std::isfinite(x)) {
+				std::snprintf(buf, sizeof(buf), "%.17g", x);
+				v.push_back(buf);
+				std::snprintf(buf, sizeof(buf), "%.9g", x);
+				v.push_back(buf);
+			}
+		}
+		return v;
+	}
+
+	// A cfloat with the layout of float or double must read what std::from_chars reads; where
+	// std::from_chars reports result_out_of_range the cfloat holds infinity or zero.
+	template<typename Native, typename Cfloat>
+	int VerifyAgainstStdFromChars(const std::vector<std::string>& samples, bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		for (const std::string& s : samples) {
+			Native x{};
+			auto ref = std::from_chars(s.data(), s.data() + s.size(), x);
+			Cfloat v;
+			auto result = fromString(s, v);
+			bool pass = (result.ptr == ref.ptr);
+			if (ref.ec == std::errc{}) {
+				pass = pass && result.ec == std::errc{} && (std::isnan(x) ? v.isnan() : (v == Cfloat(x) && v.sign() == std::signbit(x)));
+			}
+			else if (ref.ec == std::errc::result_out_of_range) {
+				pass = pass && result.ec == std::errc{} && (v.isinf() || v.iszero());
+			}
+			else {
+				pass = pass && result.ec == ref.ec;
+			}
+			if (!pass) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << s << " -> " << to_binary(v) << " != " << x << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// Every pair of neighbors of a narrow type: the exact midpoint, which is a double, reads as the
+	// value the type's own rounding of that double gives, and the doubles just above and below the
+	// midpoint read as the neighbors.
+	template<typename Number>
+	int VerifyMidpoints(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		constexpr std::size_t NR_VALUES = std::size_t(1) << Number::nbits;
+		Number a, b;
+		for (std::size_t i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			b = a;
+			++b;
+			double da = double(a), db = double(b);
+			if (!std::isfinite(da) || !std::isfinite(db) || !(da < db)) continue;
+			double mid = (da + db) / 2.0;
+			for (double x : { mid, std::nextafter(mid, da), std::nextafter(mid, db) }) {
+				Number v;
+				auto [ptr, ec] = fromString(exactDecimal(x), v);
+				Number ref(x);
+				if (ec != std::errc{} || !(v == ref)) {
+					++nrOfFailedTestCases;
+					if (reportTestCases && nrOfFailedTestCases < 10) {
+						std::cerr << "FAIL: " << exactDecimal(x) << " -> " << to_binary(v) << " != " << to_binary(ref) << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// wide types: the shortest decimal of a random encoding reads back to that encoding
+	template<typename Number>
+	int VerifyRoundTrip(std::size_t n, bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::mt19937_64 rng(0x5eed);
+		Number v, w;
+		for (std::size_t i = 0; i < n; ++i) {
+			for (unsigned b = 0; b < Number::nbits; ++b) v.setbit(b, (rng() & 1) != 0);
+			char buf[shortest::max_chars];
+			auto [end, ec] = to_chars(buf, buf + sizeof(buf), v);
+			auto result = from_chars(buf, end, w);
+			bool same = (v == w) || (std::isnan(double(v)) && std::isnan(double(w)));
+			if (ec != std::errc{} || result.ec != std::errc{} || result.ptr != end || !same) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << to_binary(v) << " : " << std::string(buf, end) << " -> " << to_binary(w) << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number>
+	int VerifyParse(const std::string& txt, const Number& ref, std::ptrdiff_t length, bool reportTestCases) {
+		Number v;
+		auto [ptr, ec] = fromString(txt, v);
+		std::ptrdiff_t consumed = ptr - txt.data();
+		bool pass = (length < 0) ? (ec == std::errc::invalid_argument && consumed == 0)
+		                         : (ec == std::errc{} && consumed == length && (v == ref || (std::isnan(double(v)) && std::isnan(double(ref)))));
+		if (pass) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << txt << " -> " << to_binary(v) << " consumed " << consumed << '\n';
+		return 1;
+	}
+
+	template<typename Number>
+	int VerifyBulk(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::string column = "0.1, -2.5\n0\t1024;1.0e-3;";
+		std::vector<Number> values;
+		auto [ptr, ec] = from_chars(column.data(), column.data() + column.size(), values, ';');
+		std::vector<Number> ref{ Number(0.1), Number(-2.5), Number(0), Number(1024), Number(1.0e-3) };
+		if (ec != std::errc{} || ptr != column.data() + column.size() || values != ref) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: bulk parse of " << column << '\n';
+		}
+		std::string broken = "1, 2, 3x, 4";
+		values.clear();
+		auto stop = from_chars(broken.data(), broken.data() + broken.size(), values);
+		if (stop.ec != std::errc::invalid_argument || stop.ptr != broken.data() + 6 || values.size() != 2) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: bulk parse did not stop at 3x\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "correctly rounded from_chars";
+	std::string test_tag    = "from_chars";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using fp16 = cfloat<16, 5, std::uint16_t, true, false, false>;
+	using fp32 = cfloat<32, 8, std::uint32_t, true, false, false>;
+	using fp64 = cfloat<64, 11, std::uint32_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	posit<32, 2> p;
+	std::string txt = "0.1";
+	from_chars(txt.data(), txt.data() + txt.size(), p);
+	std::cout << to_binary(p) << " : " << p << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("0.1", posit<32, 2>(0.1), 3, reportTestCases), "posit<32,2>", "0.1");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("-1.5e20", posit<32, 2>(-1.5e20), 7, reportTestCases), "posit<32,2>", "-1.5e20");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("1e100000", posit<16, 1>(SpecificValue::maxpos), 8, reportTestCases), "posit<16,1>", "saturate to maxpos");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("1e-100000", posit<16, 1>(SpecificValue::minpos), 9, reportTestCases), "posit<16,1>", "saturate to minpos");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("nar", posit<16, 1>(NAR), 3, reportTestCases), "posit<16,1>", "nar");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("-Infinity", posit<16, 1>(NAR), 9, reportTestCases), "posit<16,1>", "-Infinity");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse(".5", fp32(0.5f), 2, reportTestCases), "cfloat<32,8>", ".5");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("5.", fp32(5.0f), 2, reportTestCases), "cfloat<32,8>", "5.");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("1.5e3x", fp32(1500.0f), 5, reportTestCases), "cfloat<32,8>", "stop at x");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("2e+", fp32(2.0f), 1, reportTestCases), "cfloat<32,8>", "incomplete exponent");
+	// exact integers whose bits beyond the engine's precision decide a tie
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("1099511693312", fp32(1099511693312.0f), 13, reportTestCases), "cfloat<32,8>", "2^40 + 2^16");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("1099511693313", fp32(1099511693313.0f), 13, reportTestCases), "cfloat<32,8>", "2^40 + 2^16 + 1");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("6812252851892478532e16", fp64(6812252851892478532e16), 22, reportTestCases), "cfloat<64,11>", "above a tie");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("+1", fp32(), -1, reportTestCases), "cfloat<32,8>", "leading +");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("abc", fp32(), -1, reportTestCases), "cfloat<32,8>", "abc");
+	nrOfFailedTestCases += ReportTestResult(VerifyParse("-", fp32(), -1, reportTestCases), "cfloat<32,8>", "lone sign");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyMidpoints< posit<8, 0> >(reportTestCases), "posit<8,0>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(VerifyMidpoints< cfloat<8, 4, std::uint8_t, true, false, false> >(reportTestCases), "cfloat<8,4>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(VerifyMidpoints< posit<16, 1> >(reportTestCases), "posit<16,1>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(VerifyMidpoints< fp16 >(reportTestCases), "cfloat<16,5>", "midpoints");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBulk< posit<32, 2> >(reportTestCases), "posit<32,2>", "bulk");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulk< fp32 >(reportTestCases), "cfloat<32,8>", "bulk");
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		auto samples = decimalSamples(20000, 1);
+		for (const char* s : { "inf", "-Infinity", "nan", "nan(123)", "-0", "00012.5000e-0003", "1e400", "1e-400" }) samples.push_back(s);
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdFromChars<float, fp32>(samples, reportTestCases), "cfloat<32,8>", "std::from_chars");
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdFromChars<double, fp64>(samples, reportTestCases), "cfloat<64,11>", "std::from_chars");
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< posit<32, 2> >(20000, reportTestCases), "posit<32,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< posit<64, 3> >(5000, reportTestCases), "posit<64,3>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< fp64 >(20000, reportTestCases), "cfloat<64,11>", "round trip");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< posit<128, 4> >(1000, reportTestCases), "posit<128,4>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< cfloat<128, 15, std::uint32_t, true, false, false> >(1000, reportTestCases), "cfloat<128,15>", "round trip");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,268 @@
+// to_chars.cpp: test suite for shortest round-trip decimal formatting of posits and cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// number system includes
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+// shortest decimal formatting
+#include <universal/number/posit/to_chars.hpp>
+#include <universal/number/cfloat/to_chars.hpp>
+// test infrastructure
+#include <universal/verification/test_suite.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	template<typename Number>
+	std::string shortestString(const Number& v, shortest::strategy strategy = shortest::strategy::automatic) {
+		char buf[shortest::max_chars];
+		auto [end, ec] = to_chars(buf, buf + sizeof(buf), v, strategy);
+		if (ec != std::errc{}) return "<error>";
+		return std::string(buf, end);
+	}
+
+	// the number of significant digits of a plain or scientific decimal
+	inline int significantDigits(const std::string& s) {
+		std::string mantissa = s.substr(0, s.find('e'));
+		std::string digits;
+		for (char c : mantissa) if (c >= '0' && c <= '9') digits += c;
+		std::size_t first = digits.find_first_not_of('0');
+		if (first == std::string::npos) return 0;
+		std::size_t last = digits.find_last_not_of('0');
+		return static_cast<int>(last - first + 1);
+	}
+
+	// A cfloat with the layout of float or double must print exactly what std::to_chars prints
+	template<typename Native, typename Cfloat>
+	int VerifyAgainstStdToChars(const std::vector<Native>& samples, shortest::strategy strategy, bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		for (Native x : samples) {
+			char buf[64];
+			auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), x);
+			std::string ref(buf, end);
+			std::string result = shortestString(Cfloat(x), strategy);
+			if (result != ref) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << result << " != " << ref << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// random finite bit patterns, integers, powers of two and the extremes of a native type
+	template<typename Native, typename Bits>
+	std::vector<Native> nativeSamples(std::size_t n, std::uint64_t seed) {
+		std::mt19937_64 rng(seed);
+		std::vector<Native> v;
+		while (v.size() < n) {
+			Bits b = static_cast<Bits>(rng());
+			Native x;
+			std::memcpy(&x, &b, sizeof(x));
+			if (std::isfinite(x)) v.push_back(x);
+		}
+		for (std::size_t i = 0; i < n / 4; ++i) {
+			v.push_back(static_cast<Native>(static_cast<std::int64_t>(rng() >> (rng() % 64))));
+		}
+		for (int e = std::numeric_limits<Native>::min_exponent - std::numeric_limits<Native>::digits; e < std::numeric_limits<Native>::max_exponent; ++e) {
+			v.push_back(std::ldexp(Native(1), e));
+			v.push_back(std::nextafter(std::ldexp(Native(1), e), Native(0)));
+		}
+		for (Native x : { std::numeric_limits<Native>::denorm_min(), std::numeric_limits<Native>::min(), std::numeric_limits<Native>::max(),
+		                  Native(0.1), Native(1) / Native(3), Native(123456), Native(1e-5), Native(1e-4) }) {
+			v.push_back(x);
+			v.push_back(-x);
+		}
+		return v;
+	}
+
+	// Every value of a narrow type: the digits read back to the same encoding, no decimal with one
+	// significant digit fewer does, and both strategies agree.
+	template<typename Number>
+	int VerifyExhaustive(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		constexpr std::size_t NR_VALUES = std::size_t(1) << Number::nbits;
+		Number v;
+		for (std::size_t i = 0; i < NR_VALUES; ++i) {
+			v.setbits(i);
+			if (!std::isfinite(double(v))) continue;   // nar, nan and inf have fixed spellings
+			std::string s = shortestString(v);
+			std::string exact = shortestString(v, shortest::strategy::exact);
+			double d{};
+			std::from_chars(s.data(), s.data() + s.size(), d);
+			bool roundTrips = (Number(d) == v) || (v.iszero() && d == 0.0);
+			bool shortestDigits = true;
+			int n = significantDigits(s);
+			if (n > 1 && s.find_first_of(".e") != std::string::npos) {
+				// the two decimals with n - 1 significant digits around v; integers in plain notation
+				// show all their digits, as std::to_chars does, so they are exempt
+				int x = static_cast<int>(std::floor(std::log10(std::fabs(d))));
+				double scale = std::pow(10.0, x - (n - 2));
+				for (double candidate : { std::floor(std::fabs(d) / scale) * scale, std::ceil(std::fabs(d) / scale) * scale }) {
+					Number c(v.sign() ? -candidate : candidate);
+					if (c == v) shortestDigits = false;
+				}
+			}
+			if (!roundTrips || !shortestDigits || s != exact) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) {
+					std::cerr << "FAIL: " << to_binary(v) << " : " << s << " (exact " << exact << ")"
+					          << (roundTrips ? "" : " does not round trip") << (shortestDigits ? "" : " is not shortest") << '\n';
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// wide types: the fast and the exact strategy agree on random encodings
+	template<typename Number>
+	int VerifyStrategiesAgree(std::size_t n, bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::mt19937_64 rng(0x5eed);
+		Number v;
+		for (std::size_t i = 0; i < n; ++i) {
+			for (unsigned b = 0; b < Number::nbits; ++b) v.setbit(b, (rng() & 1) != 0);
+			std::string s = shortestString(v);
+			std::string exact = shortestString(v, shortest::strategy::exact);
+			if (s != exact) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << to_binary(v) << " : " << s << " != " << exact << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number>
+	int VerifyString(const Number& v, const std::string& ref, bool reportTestCases) {
+		std::string s = shortestString(v);
+		if (s == ref) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << to_binary(v) << " : " << s << " != " << ref << '\n';
+		return 1;
+	}
+
+	template<typename Number>
+	int VerifyBulk(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::vector<Number> values{ Number(0.1), Number(-2.5), Number(0), Number(1024), Number(1.0e-3) };
+		std::string out = "values:";
+		std::size_t appended = to_chars(values, out, ' ');
+		std::string ref = "values:";
+		for (const Number& v : values) ref += shortestString(v) + ' ';
+		if (out != ref || appended != ref.size() - 7) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: bulk " << out << " != " << ref << '\n';
+		}
+		char small[2];
+		if (to_chars(small, small + sizeof(small), Number(0.1)).ec != std::errc::value_too_large) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: short buffer not reported\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "shortest round-trip to_chars";
+	std::string test_tag    = "to_chars";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using fp32 = cfloat<32, 8, std::uint32_t, true, false, false>;
+	using fp64 = cfloat<64, 11, std::uint32_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	std::cout << shortestString(posit<32, 2>(0.1)) << '\n';
+	std::cout << shortestString(fp32(0.1f)) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyString(posit<32, 2>(0.1), "0.1", reportTestCases), "posit<32,2>", "0.1");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(posit<16, 1>(3.14159), "3.1416", reportTestCases), "posit<16,1>", "pi");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(posit<8, 0>(0.1), "0.1", reportTestCases), "posit<8,0>", "0.1");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(-posit<32, 2>(1.5e20), "-1.5e+20", reportTestCases), "posit<32,2>", "-1.5e20");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(posit<16, 1>(), "0", reportTestCases), "posit<16,1>", "zero");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(posit<16, 1>(NAR), "nar", reportTestCases), "posit<16,1>", "nar");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(fp32(123456.0f), "123456", reportTestCases), "cfloat<32,8>", "123456");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(-fp32(0.0f), "-0", reportTestCases), "cfloat<32,8>", "-0");
+	nrOfFailedTestCases += ReportTestResult(VerifyString(fp32(std::numeric_limits<float>::infinity()), "inf", reportTestCases), "cfloat<32,8>", "inf");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustive< posit<8, 0> >(reportTestCases), "posit<8,0>", "exhaustive");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustive< cfloat<8, 4, std::uint8_t, true, false, false> >(reportTestCases), "cfloat<8,4>", "exhaustive");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustive< posit<16, 1> >(reportTestCases), "posit<16,1>", "exhaustive");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustive< cfloat<16, 5, std::uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5>", "exhaustive");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBulk< posit<32, 2> >(reportTestCases), "posit<32,2>", "bulk");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulk< fp32 >(reportTestCases), "cfloat<32,8>", "bulk");
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		auto floats  = nativeSamples<float, std::uint32_t>(20000, 1);
+		auto doubles = nativeSamples<double, std::uint64_t>(20000, 2);
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdToChars<float, fp32>(floats, shortest::strategy::automatic, reportTestCases), "cfloat<32,8>", "std::to_chars");
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdToChars<float, fp32>(floats, shortest::strategy::exact, reportTestCases), "cfloat<32,8>", "std::to_chars exact");
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdToChars<double, fp64>(doubles, shortest::strategy::automatic, reportTestCases), "cfloat<64,11>", "std::to_chars");
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstStdToChars<double, fp64>(doubles, shortest::strategy::exact, reportTestCases), "cfloat<64,11>", "std::to_chars exact");
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustive< posit<16, 2> >(reportTestCases), "posit<16,2>", "exhaustive");
+	nrOfFailedTestCases += ReportTestResult(VerifyStrategiesAgree< posit<32, 2> >(20000, reportTestCases), "posit<32,2>", "strategies agree");
+	nrOfFailedTestCases += ReportTestResult(VerifyStrategiesAgree< posit<64, 3> >(5000, reportTestCases), "posit<64,3>", "strategies agree");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyStrategiesAgree< posit<128, 4> >(1000, reportTestCases), "posit<128,4>", "strategies agree");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,317 @@
+// dsp_kernels.cpp: test suite runner for the blocked fixpnt and integer FIR, convolution and GEMM kernels
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/integer/integer.hpp>
+#include <universal/number/fixpnt/dsp_kernels.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// reference: the exact sum of a[i] * b[i] in a blockbinary, rounded and wrapped or saturated the way
+	// fixpnt::operator*= treats a single product. The tested sums fit in 64 bits once the rbits are
+	// shifted out, so the saturation bounds are compared on int64_t.
+	template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+	fixpnt<nbits, rbits, arithmetic, bt> ReferenceDot(const std::vector<fixpnt<nbits, rbits, arithmetic, bt>>& a, const std::vector<fixpnt<nbits, rbits, arithmetic, bt>>& b) {
+		using Accumulator = blockbinary<2 * nbits + 32, bt>;
+		Accumulator sum;
+		sum.clear();
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			blockbinary<2 * nbits, bt> p = urmul2(a[i].bits(), b[i].bits());
+			sum += Accumulator(p);
+		}
+		bool roundUp = sum.roundingMode(rbits);
+		sum >>= static_cast<int>(rbits);
+		std::int64_t q = sum.to_sll();
+		fixpnt<nbits, rbits, arithmetic, bt> result;
+		if constexpr (arithmetic == Saturate) {
+			constexpr std::int64_t maxpos = (std::int64_t(1) << (nbits - 1)) - 1;
+			if (q >= maxpos) return fixpnt<nbits, rbits, arithmetic, bt>(SpecificValue::maxpos);
+			if (q < -maxpos - 1) return fixpnt<nbits, rbits, arithmetic, bt>(SpecificValue::maxneg);
+		}
+		if (roundUp) ++q;
+		result.setbits(static_cast<std::uint64_t>(q));
+		return result;
+	}
+
+	// reference for integer: the wrapping scalar operators
+	template<unsigned nbits, typename bt>
+	integer<nbits, bt> ReferenceDot(const std::vector<integer<nbits, bt>>& a, const std::vector<integer<nbits, bt>>& b) {
+		integer<nbits, bt> sum{ 0 };
+		for (std::size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+		return sum;
+	}
+
+	// random encodings, with a share of the extreme values that stress the accumulators and saturation
+	template<typename Number>
+	std::vector<Number> RandomVector(std::size_t n, std::mt19937_64& rng) {
+		std::vector<Number> v(n);
+		for (auto& x : v) {
+			std::uint64_t r = rng();
+			switch (r % 16) {
+			case 0: x.setbits(std::uint64_t(1) << (dsp_kernel_format<Number>::nbits - 1)); break;   // maxneg
+			case 1: x.setbits((std::uint64_t(1) << (dsp_kernel_format<Number>::nbits - 1)) - 1); break;   // maxpos
+			default: x.setbits(r >> 8); break;
+			}
+		}
+		return v;
+	}
+
+	template<typename Number>
+	int Compare(const Number& result, const Number& ref, const std::string& kernel, std::size_t index, bool reportTestCases) {
+		if (result == ref) return 0;
+		if (reportTestCases) std::cerr << "FAIL " << kernel << '[' << index << "] : " << to_binary(result) << " != reference " << to_binary(ref) << '\n';
+		return 1;
+	}
+
+	// a single product through gemm(m, n, 1) must match operator*, for every pair of encodings
+	template<typename Number>
+	int VerifySingleProducts(bool reportTestCases) {
+		constexpr unsigned nbits = dsp_kernel_format<Number>::nbits;
+		constexpr std::size_t NR_VALUES = std::size_t(1) << nbits;
+		std::vector<Number> a(NR_VALUES), b(NR_VALUES), c;
+		for (std::size_t i = 0; i < NR_VALUES; ++i) {
+			a[i].setbits(i);
+			b[i].setbits(i);
+		}
+		gemm(NR_VALUES, NR_VALUES, 1, a, b, c);
+		int nrOfFailedTests = 0;
+		for (std::size_t i = 0; i < NR_VALUES; ++i) {
+			for (std::size_t j = 0; j < NR_VALUES; ++j) {
+				nrOfFailedTests += Compare(c[i * NR_VALUES + j], Number(a[i] * b[j]), "product", i * NR_VALUES + j, reportTestCases);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// random single products for the wider formats
+	template<typename Number>
+	int VerifyRandomProducts(std::size_t n, bool reportTestCases) {
+		std::mt19937_64 rng(0xfeed);
+		std::vector<Number> a = RandomVector<Number>(n, rng), b = RandomVector<Number>(n, rng);
+		std::vector<Number> h(1), c;
+		int nrOfFailedTests = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			// one-tap conv1d: c[j] = a[i] * b[j]
+			h[0] = a[i];
+			conv1d(h, b, c);
+			for (std::size_t j = i; j < i + 8 && j < n; ++j) nrOfFailedTests += Compare(c[j], Number(a[i] * b[j]), "product", j, reportTestCases);
+			if (nrOfFailedTests > 24) break;
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Number>
+	int VerifyFir(std::size_t nrTaps, std::size_t n, bool reportTestCases) {
+		std::mt19937_64 rng(0x5eed + nrTaps);
+		std::vector<Number> h = RandomVector<Number>(nrTaps, rng), x = RandomVector<Number>(n, rng), y, y3;
+		fir(h, x, y);
+		fir(h, x, y3, 3);
+		int nrOfFailedTests = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			std::vector<Number> a, b;
+			for (std::size_t k = 0; k < nrTaps && k <= i; ++k) {
+				a.push_back(h[k]);
+				b.push_back(x[i - k]);
+			}
+			Number ref = ReferenceDot(a, b);
+			nrOfFailedTests += Compare(y[i], ref, "fir", i, reportTestCases);
+			nrOfFailedTests += Compare(y3[i], ref, "fir (3 threads)", i, reportTestCases);
+			if (nrOfFailedTests > 24) break;
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Number>
+	int VerifyConv1d(std::size_t nrTaps, std::size_t n, bool reportTestCases) {
+		std::mt19937_64 rng(0xc0de + nrTaps);
+		std::vector<Number> h = RandomVector<Number>(nrTaps, rng), x = RandomVector<Number>(n, rng), y;
+		conv1d(h, x, y, 2);
+		int nrOfFailedTests = 0;
+		if (y.size() != n - nrTaps + 1) return 1;
+		for (std::size_t i = 0; i < y.size(); ++i) {
+			std::vector<Number> a, b;
+			for (std::size_t k = 0; k < nrTaps; ++k) {
+				a.push_back(h[k]);
+				b.push_back(x[i + nrTaps - 1 - k]);
+			}
+			nrOfFailedTests += Compare(y[i], ReferenceDot(a, b), "conv1d", i, reportTestCases);
+			if (nrOfFailedTests > 24) break;
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Number>
+	int VerifyConv2d(std::size_t kh, std::size_t kw, std::size_t xh, std::size_t xw, bool reportTestCases) {
+		std::mt19937_64 rng(0xd00d + kh * kw);
+		std::vector<Number> h = RandomVector<Number>(kh * kw, rng), x = RandomVector<Number>(xh * xw, rng), y;
+		conv2d(kh, kw, h, xh, xw, x, y, 4);
+		const std::size_t oh = xh - kh + 1, ow = xw - kw + 1;
+		if (y.size() != oh * ow) return 1;
+		int nrOfFailedTests = 0;
+		for (std::size_t r = 0; r < oh; ++r) {
+			for (std::size_t c = 0; c < ow; ++c) {
+				std::vector<Number> a, b;
+				for (std::size_t i = 0; i < kh; ++i) {
+					for (std::size_t j = 0; j < kw; ++j) {
+						a.push_back(h[i * kw + j]);
+						b.push_back(x[(r + kh - 1 - i) * xw + (c + kw - 1 - j)]);
+					}
+				}
+				nrOfFailedTests += Compare(y[r * ow + c], ReferenceDot(a, b), "conv2d", r * ow + c, reportTestCases);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Number>
+	int VerifyGemm(std::size_t m, std::size_t n, std::size_t k, bool reportTestCases) {
+		std::mt19937_64 rng(0xabba + m + n + k);
+		std::vector<Number> A = RandomVector<Number>(m * k, rng), B = RandomVector<Number>(k * n, rng), C, C3;
+		gemm(m, n, k, A, B, C);
+		gemm(m, n, k, A, B, C3, 3);
+		int nrOfFailedTests = 0;
+		for (std::size_t i = 0; i < m; ++i) {
+			for (std::size_t j = 0; j < n; ++j) {
+				std::vector<Number> a(A.begin() + static_cast<std::ptrdiff_t>(i * k), A.begin() + static_cast<std::ptrdiff_t>((i + 1) * k)), b(k);
+				for (std::size_t p = 0; p < k; ++p) b[p] = B[p * n + j];
+				Number ref = ReferenceDot(a, b);
+				nrOfFailedTests += Compare(C[i * n + j], ref, "gemm", i * n + j, reportTestCases);
+				nrOfFailedTests += Compare(C3[i * n + j], ref, "gemm (3 threads)", i * n + j, reportTestCases);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// sums of many extreme products: all lanes of the accumulator carry, and the result saturates or wraps
+	template<typename Number>
+	int VerifyExtremeSums(std::size_t n, bool reportTestCases) {
+		std::vector<Number> x(n), h(n), y;
+		for (std::size_t i = 0; i < n; ++i) {
+			x[i].setbits(std::uint64_t(1) << (dsp_kernel_format<Number>::nbits - 1));   // maxneg
+			h[i] = x[i];
+		}
+		conv1d(h, x, y);
+		if (y.size() != 1) return 1;
+		return Compare(y[0], ReferenceDot(h, x), "extreme sum", 0, reportTestCases);
+	}
+
+	template<typename Number>
+	int VerifyKernels(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyFir<Number>(1, 100, reportTestCases);
+		nrOfFailedTests += VerifyFir<Number>(37, 2500, reportTestCases);
+		nrOfFailedTests += VerifyConv1d<Number>(5, 1100, reportTestCases);
+		nrOfFailedTests += VerifyConv1d<Number>(64, 64, reportTestCases);
+		nrOfFailedTests += VerifyConv2d<Number>(3, 5, 9, 1100, reportTestCases);
+		nrOfFailedTests += VerifyGemm<Number>(5, 7, 3, reportTestCases);
+		nrOfFailedTests += VerifyGemm<Number>(19, 270, 260, reportTestCases);
+		nrOfFailedTests += VerifyExtremeSums<Number>(1000, reportTestCases);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fixed-point FIR, convolution and GEMM kernels";
+	std::string test_tag    = "dsp kernels";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFir<fixpnt<16, 15, Saturate, std::uint16_t>>(32, 1000, reportTestCases), "fixpnt<16,15,Saturate>", "fir");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<fixpnt<8, 4, Modulo, std::uint8_t>>(reportTestCases), "fixpnt<8,4,Modulo>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<fixpnt<8, 4, Saturate, std::uint8_t>>(reportTestCases), "fixpnt<8,4,Saturate>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<fixpnt<8, 0, Saturate, std::uint8_t>>(reportTestCases), "fixpnt<8,0,Saturate>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<fixpnt<8, 8, Modulo, std::uint8_t>>(reportTestCases), "fixpnt<8,8,Modulo>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<fixpnt<8, 7, Saturate, std::uint8_t>>(reportTestCases), "fixpnt<8,7,Saturate>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifySingleProducts<integer<8, std::uint8_t>>(reportTestCases), "integer<8>", "single products");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<8, 4, Saturate, std::uint8_t>>(reportTestCases), "fixpnt<8,4,Saturate>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<16, 15, Saturate, std::uint16_t>>(reportTestCases), "fixpnt<16,15,Saturate>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<16, 8, Modulo, std::uint8_t>>(reportTestCases), "fixpnt<16,8,Modulo>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomProducts<fixpnt<24, 12, Saturate, std::uint8_t>>(2000, reportTestCases), "fixpnt<24,12,Saturate>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomProducts<fixpnt<32, 16, Modulo, std::uint32_t>>(2000, reportTestCases), "fixpnt<32,16,Modulo>", "single products");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomProducts<fixpnt<32, 32, Saturate, std::uint32_t>>(2000, reportTestCases), "fixpnt<32,32,Saturate>", "single products");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<32, 16, Saturate, std::uint32_t>>(reportTestCases), "fixpnt<32,16,Saturate>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<32, 31, Modulo, std::uint8_t>>(reportTestCases), "fixpnt<32,31,Modulo>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<24, 20, Saturate, std::uint16_t>>(reportTestCases), "fixpnt<24,20,Saturate>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<integer<16, std::uint16_t>>(reportTestCases), "integer<16>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<integer<32, std::uint32_t>>(reportTestCases), "integer<32>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<32, 32, Saturate, std::uint32_t>>(reportTestCases), "fixpnt<32,32,Saturate>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKernels<fixpnt<12, 0, Modulo, std::uint16_t>>(reportTestCases), "fixpnt<12,0,Modulo>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
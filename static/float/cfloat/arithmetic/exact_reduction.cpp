@@ -0,0 +1,254 @@
+// exact_reduction.cpp: test suite for the exact, reproducible sum/dot/norm2 of IEEE-754 cfloat arrays
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/cfloat/exact_reduction.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// operands spread over a wide exponent range with random signs: a hard case for a rounded sum
+	template<typename Scalar>
+	std::vector<Scalar> IllConditioned(std::size_t n, int exponentRange, unsigned seed) {
+		std::mt19937_64 rng(seed);
+		std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent(-exponentRange, exponentRange);
+		std::vector<Scalar> v(n);
+		for (auto& e : v) e = Scalar(std::ldexp(mantissa(rng), exponent(rng)));
+		return v;
+	}
+
+	// the generalized quire (fdp.hpp) is exact for every cfloat: it is the oracle
+	template<typename Scalar>
+	int VerifyAgainstQuire(bool reportTestCases, std::size_t n, int exponentRange) {
+		int nrOfFailedTestCases = 0;
+		for (unsigned seed = 1; seed <= 4; ++seed) {
+			std::vector<Scalar> x = IllConditioned<Scalar>(n, exponentRange, seed);
+			std::vector<Scalar> y = IllConditioned<Scalar>(n, exponentRange, seed + 100);
+			std::vector<Scalar> ones(n, Scalar(1.0f));
+
+			Scalar dot = exact_dot(x, y);
+			Scalar ref = fdp(x, y);
+			if (dot != ref) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: exact_dot " << to_binary(dot) << " != fdp " << to_binary(ref) << '\n';
+			}
+			Scalar sum = exact_sum(x);
+			ref = fdp(x, ones);
+			if (sum != ref) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: exact_sum " << to_binary(sum) << " != fdp " << to_binary(ref) << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the same bits for every thread count
+	template<typename Scalar>
+	int VerifyReproducibility(bool reportTestCases, std::size_t n) {
+		int nrOfFailedTestCases = 0;
+		std::vector<Scalar> x = IllConditioned<Scalar>(n, 40, 7);
+		std::vector<Scalar> y = IllConditioned<Scalar>(n, 40, 8);
+		Scalar sum = exact_sum(x, 1);
+		Scalar dot = exact_dot(x, y, 1);
+		Scalar nrm = exact_norm2(x, 1);
+		for (unsigned nrThreads : { 2u, 3u, 4u, 7u, 16u }) {
+			if (exact_sum(x, nrThreads) != sum || exact_dot(x, y, nrThreads) != dot || exact_norm2(x, nrThreads) != nrm) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: result differs with " << nrThreads << " threads\n";
+			}
+		}
+		// and for every order of the elements
+		std::vector<Scalar> xr(x.rbegin(), x.rend()), yr(y.rbegin(), y.rend());
+		if (exact_sum(xr, 3) != sum || exact_dot(xr, yr, 5) != dot) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: result depends on the order of the elements\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// cancellation, ties and the subnormal range, against hand-computed results
+	template<typename Scalar, typename Native>
+	int VerifyRounding(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		constexpr int p = std::numeric_limits<Native>::digits;
+		constexpr int emax = std::numeric_limits<Native>::max_exponent;
+		auto check = [&](const std::vector<Native>& v, Native expected, const char* label) {
+			std::vector<Scalar> x(v.begin(), v.end());
+			Scalar s = exact_sum(x);
+			if (Native(s) != expected || std::signbit(Native(s)) != std::signbit(expected)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << label << " : " << Native(s) << " != " << expected << '\n';
+			}
+		};
+		Native big = std::ldexp(Native(1), emax - 1);
+		Native ulp = std::ldexp(Native(1), 1 - p);
+		check({ big, Native(1), -big }, Native(1), "cancellation");
+		check({ Native(1), ulp / 2 }, Native(1), "tie to even, down");
+		check({ Native(1) + ulp, ulp / 2 }, Native(1) + 2 * ulp, "tie to even, up");
+		check({ Native(1), ulp / 2, ulp / 1024 }, Native(1) + ulp, "above the tie");
+		check({ -Native(1), -ulp / 2, -ulp / 1024 }, -(Native(1) + ulp), "above the tie, negative");
+		check({ big, big }, std::numeric_limits<Native>::infinity(), "overflow");
+		check({ std::numeric_limits<Native>::max(), ulp * std::ldexp(Native(1), emax - 2) }, std::numeric_limits<Native>::infinity(), "round to overflow");
+		check({ std::numeric_limits<Native>::denorm_min(), std::numeric_limits<Native>::denorm_min() }, 2 * std::numeric_limits<Native>::denorm_min(), "subnormal sum");
+		check({ Native(3), -Native(3) }, Native(0), "exact zero");
+
+		// products below the subnormal range
+		Native tiny = std::sqrt(std::numeric_limits<Native>::denorm_min());
+		std::vector<Scalar> x{ Scalar(tiny) }, y{ Scalar(tiny) };
+		Native d = Native(exact_dot(x, y));
+		Native expected = tiny * tiny;
+		if (d != expected) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: subnormal product " << d << " != " << expected << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Scalar>
+	int VerifySpecialValues(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		Scalar inf, ninf, nan;
+		inf.setinf(false);
+		ninf.setinf(true);
+		nan.setnan();
+		Scalar one(1.0f), zero(0.0f);
+		if (!exact_sum(std::vector<Scalar>{ one, inf, one }).isinf()) ++nrOfFailedTestCases;
+		if (!exact_sum(std::vector<Scalar>{ one, inf, ninf }).isnan()) ++nrOfFailedTestCases;
+		if (!exact_sum(std::vector<Scalar>{ one, nan }).isnan()) ++nrOfFailedTestCases;
+		if (!exact_dot(std::vector<Scalar>{ inf, one }, std::vector<Scalar>{ zero, one }).isnan()) ++nrOfFailedTestCases;
+		Scalar r = exact_dot(std::vector<Scalar>{ ninf, one }, std::vector<Scalar>{ one, one });
+		if (!r.isinf() || !r.sign()) ++nrOfFailedTestCases;
+		if (!exact_sum(std::vector<Scalar>{}).iszero()) ++nrOfFailedTestCases;
+		if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: special values\n";
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Scalar>
+	int VerifyNorm2(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		std::vector<Scalar> x{ Scalar(3.0f), Scalar(4.0f), Scalar(12.0f) };
+		if (double(exact_norm2(x)) != 13.0) ++nrOfFailedTestCases;
+		using Native = std::conditional_t<Scalar::nbits == 32, float, double>;
+		// squares beyond the range of the format: the register holds them, and the norm is finite
+		// whenever it fits the format, near the top and near the bottom of the range
+		constexpr int maxExponent = std::numeric_limits<Native>::max_exponent;
+		constexpr int minExponent = std::numeric_limits<Native>::min_exponent - std::numeric_limits<Native>::digits;
+		for (int k : { maxExponent / 2 + 1, maxExponent - 4, minExponent, minExponent / 2 }) {
+			std::vector<Scalar> pythagoras{ Scalar(std::ldexp(Native(3), k)), Scalar(std::ldexp(Native(4), k)) };
+			if (double(exact_norm2(pythagoras)) != std::ldexp(5.0, k)) ++nrOfFailedTestCases;
+		}
+		std::vector<Scalar> top(4, Scalar(std::ldexp(Native(1), maxExponent - 2)));
+		if (double(exact_norm2(top)) != std::ldexp(1.0, maxExponent - 1)) ++nrOfFailedTestCases;
+		std::vector<Scalar> bottom(4, Scalar(std::numeric_limits<Native>::denorm_min()));
+		if (double(exact_norm2(bottom)) != 2.0 * double(std::numeric_limits<Native>::denorm_min())) ++nrOfFailedTestCases;
+		Native big = (Scalar::nbits == 32) ? Native(1e30f) : Native(1e200);
+		Native small = (Scalar::nbits == 32) ? Native(1e-30f) : Native(1e-200);
+		for (Native v : { big, small }) {
+			Native ref = std::hypot(v, v);
+			double r = double(exact_norm2(std::vector<Scalar>{ Scalar(v), Scalar(v) }));
+			if (r < double(std::nextafter(ref, Native(0))) || r > double(std::nextafter(ref, std::numeric_limits<Native>::infinity()))) ++nrOfFailedTestCases;
+		}
+		// the norm itself beyond the range overflows
+		std::vector<Scalar> large(4, Scalar(std::ldexp(Native(1), maxExponent - 1)));
+		if (!exact_norm2(large).isinf()) ++nrOfFailedTestCases;
+		if (!exact_norm2(std::vector<Scalar>{ Scalar(std::numeric_limits<Native>::infinity()), Scalar(1.0f) }).isinf()) ++nrOfFailedTestCases;
+		if (!exact_norm2(std::vector<Scalar>{}).iszero()) ++nrOfFailedTestCases;
+		// squares below the smallest subnormal are not lost: 2^k of them add up to exactly denorm_min
+		constexpr int denormExponent = std::numeric_limits<Native>::min_exponent - std::numeric_limits<Native>::digits;
+		constexpr int e = (denormExponent - 5) / 2;
+		std::vector<Scalar> tiny(std::size_t(1) << (denormExponent - 2 * e), Scalar(std::ldexp(Native(1), e)));
+		if (double(exact_dot(tiny, tiny)) != double(std::numeric_limits<Native>::denorm_min())) ++nrOfFailedTestCases;
+		if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: norm2\n";
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat exact reduction";
+	std::string test_tag    = "exact_reduction";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using single = cfloat<32, 8, uint32_t, true, false, false>;
+	using dbl    = cfloat<64, 11, uint64_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRounding<single, float>(reportTestCases), "cfloat<32,8>", "rounding");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRounding<single, float>(reportTestCases), "cfloat<32,8>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyRounding<dbl, double>(reportTestCases), "cfloat<64,11>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<single>(reportTestCases), "cfloat<32,8>", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<dbl>(reportTestCases), "cfloat<64,11>", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifyNorm2<single>(reportTestCases), "cfloat<32,8>", "norm2");
+	nrOfFailedTestCases += ReportTestResult(VerifyNorm2<dbl>(reportTestCases), "cfloat<64,11>", "norm2");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstQuire<single>(reportTestCases, 1000, 30), "cfloat<32,8>", "sum/dot vs quire");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstQuire<dbl>(reportTestCases, 200, 200), "cfloat<64,11>", "sum/dot vs quire");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<single>(reportTestCases, 20000), "cfloat<32,8>", "thread count");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<dbl>(reportTestCases, 20000), "cfloat<64,11>", "thread count");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<single>(reportTestCases, 1000000), "cfloat<32,8>", "thread count");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<dbl>(reportTestCases, 1000000), "cfloat<64,11>", "thread count");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,275 @@
+// fast_arithmetic.cpp: the native and integer fast paths of cfloat arithmetic against the blocktriple reference
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	enum class FastOp { add, mul, div };
+
+	// the generic operator without its special-value handling: blocktriple arithmetic followed by convert()
+	template<typename Cfloat>
+	Cfloat GenericReference(FastOp op, const Cfloat& a, const Cfloat& b) {
+		using bt = typename Cfloat::BlockType;
+		constexpr unsigned fbits = Cfloat::fbits;
+		Cfloat c{};
+		if (op == FastOp::add) {
+			blocktriple<fbits, BlockTripleOperator::ADD, bt> ta, tb, result;
+			a.normalizeAddition(ta);
+			b.normalizeAddition(tb);
+			result.add(ta, tb);
+			convert(result, c);
+		}
+		else if (op == FastOp::mul) {
+			blocktriple<fbits, BlockTripleOperator::MUL, bt> ta, tb, result;
+			a.normalizeMultiplication(ta);
+			b.normalizeMultiplication(tb);
+			result.mul(ta, tb);
+			convert(result, c);
+		}
+		else {
+			blocktriple<fbits, BlockTripleOperator::DIV, bt> ta, tb, result;
+			a.normalizeDivision(ta);
+			b.normalizeDivision(tb);
+			result.div(ta, tb);
+			convert(result, c);
+		}
+		return c;
+	}
+
+	// run one fast operation and compare it to the reference when the fast path takes the operands
+	template<typename Cfloat>
+	int VerifyFastOperation(bool reportTestCases, FastOp op, const Cfloat& a, const Cfloat& b, size_t& taken) {
+		using Fast = cfloat_fast_arithmetic<Cfloat>;
+		Cfloat c(a);
+		bool accepted = (op == FastOp::add ? Fast::add(c, b) : (op == FastOp::mul ? Fast::mul(c, b) : Fast::div(c, b)));
+		if (!accepted) return 0;
+		++taken;
+		Cfloat ref = GenericReference(op, a, b);
+		if (Fast::bits(c) != Fast::bits(ref)) {
+			if (reportTestCases) {
+				const char* opName = (op == FastOp::add ? " + " : (op == FastOp::mul ? " * " : " / "));
+				std::cerr << "FAIL " << type_tag(a) << ' ' << to_binary(a) << opName << to_binary(b)
+				          << " = " << to_binary(c) << " reference " << to_binary(ref) << '\n';
+			}
+			return 1;
+		}
+		return 0;
+	}
+
+	// all pairs of encodings
+	template<typename Cfloat>
+	int VerifyExhaustiveFastPath(bool reportTestCases, FastOp op) {
+		constexpr size_t NR_ENCODINGS = (size_t(1) << Cfloat::nbits);
+		int nrOfFailedTests = 0;
+		size_t taken = 0;
+		Cfloat a{}, b{};
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				nrOfFailedTests += VerifyFastOperation(reportTestCases, op, a, b, taken);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		// the fast path must cover the bulk of the encodings, or the test is not testing it
+		if (taken < NR_ENCODINGS * NR_ENCODINGS / 4) ++nrOfFailedTests;
+		return nrOfFailedTests;
+	}
+
+	// random pairs; half of them share their exponent region to exercise cancellation and ties
+	template<typename Cfloat>
+	int VerifyRandomFastPath(bool reportTestCases, FastOp op, size_t nrSamples) {
+		constexpr unsigned nbits = Cfloat::nbits;
+		constexpr uint64_t MASK = (nbits == 64 ? ~0ull : ((1ull << nbits) - 1ull));
+		std::mt19937_64 rng(0x5eed'cf10'a7ull + nbits);
+		int nrOfFailedTests = 0;
+		size_t taken = 0;
+		Cfloat a{}, b{};
+		for (size_t i = 0; i < nrSamples; ++i) {
+			uint64_t ra = rng() & MASK;
+			uint64_t rb = rng() & MASK;
+			if (i & 1) {
+				// copy the sign and exponent, and the leading fraction bits, of a into b
+				uint64_t high = MASK << (Cfloat::fbits / 2);
+				rb = (ra & high) | (rb & ~high & MASK);
+			}
+			if (i % 7 == 0) rb &= ~(MASK << (nbits / 2));  // small and subnormal operands
+			a.setbits(ra);
+			b.setbits(rb);
+			nrOfFailedTests += VerifyFastOperation(reportTestCases, op, a, b, taken);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		if (taken < nrSamples / 4) ++nrOfFailedTests;
+		return nrOfFailedTests;
+	}
+
+	template<typename Cfloat>
+	int VerifyFastPath(bool reportTestCases, const std::string& test_tag, size_t nrSamples = 0) {
+		int nrOfFailedTests = 0;
+		std::string tag = test_tag + ' ' + type_tag(Cfloat());
+		if constexpr (Cfloat::nbits <= 10) {
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Cfloat>(reportTestCases, FastOp::add), tag, "add");
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Cfloat>(reportTestCases, FastOp::mul), tag, "mul");
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Cfloat>(reportTestCases, FastOp::div), tag, "div");
+		}
+		else {
+			nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Cfloat>(reportTestCases, FastOp::add, nrSamples), tag, "add");
+			nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Cfloat>(reportTestCases, FastOp::mul, nrSamples), tag, "mul");
+			if constexpr (cfloat_fast_arithmetic<Cfloat>::native || cfloat_fast_arithmetic<Cfloat>::integerDivision) {
+				nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Cfloat>(reportTestCases, FastOp::div, nrSamples), tag, "div");
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// exhaustive over the four subnormal/max-exponent combinations, in saturating and non-saturating form
+	template<unsigned nbits, unsigned es, typename bt = std::uint8_t>
+	int VerifyFastPathConfigurations(bool reportTestCases, const std::string& test_tag) {
+		int nrOfFailedTests = 0;
+		if constexpr (es > 1) {
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, false, false, false>>(reportTestCases, test_tag);
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, true,  false, false>>(reportTestCases, test_tag);
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, false, true,  false>>(reportTestCases, test_tag);
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, false, false, true >>(reportTestCases, test_tag);
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, true,  false, true >>(reportTestCases, test_tag);
+			nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, false, true,  true >>(reportTestCases, test_tag);
+		}
+		nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, true, true, false>>(reportTestCases, test_tag);
+		nrOfFailedTests += VerifyFastPath<cfloat<nbits, es, bt, true, true, true >>(reportTestCases, test_tag);
+		return nrOfFailedTests;
+	}
+
+	// the operators must keep the special-value semantics of cfloat, which differ from IEEE-754
+	template<typename Cfloat>
+	int VerifySpecialValues(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		Cfloat one(1.0f), zero(0.0f), minpos(SpecificValue::minpos), maxpos(SpecificValue::maxpos);
+		Cfloat c = one - one;
+		if (!c.iszero() || c.sign()) ++nrOfFailedTests;                 // exact cancellation is +0
+		c = maxpos + maxpos;
+		if (!(Cfloat::isSaturating ? c == maxpos : c.isinf())) ++nrOfFailedTests;
+		c = minpos * minpos;
+		if (!c.iszero()) ++nrOfFailedTests;
+		c = -minpos * minpos;
+		if (!c.iszero() || !c.sign()) ++nrOfFailedTests;               // underflow keeps the sign
+		c = one / zero;
+		if (!c.isinf()) ++nrOfFailedTests;
+		c = zero + (-zero);
+		if (!c.iszero()) ++nrOfFailedTests;
+		if (reportTestCases && nrOfFailedTests) std::cerr << "FAIL special values of " << type_tag(one) << '\n';
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat arithmetic fast paths";
+	std::string test_tag    = "fast path";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// path selection
+	static_assert(cfloat_fast_arithmetic<single>::native || !CFLOAT_NATIVE_FAST_PATH, "cfloat<32,8> IEEE-754 configuration should run natively");
+	static_assert(cfloat_fast_arithmetic<duble>::native || !CFLOAT_NATIVE_FAST_PATH, "cfloat<64,11> IEEE-754 configuration should run natively");
+	static_assert(cfloat_fast_arithmetic<bfloat_t>::integer, "bfloat16 should take the integer path");
+	static_assert(cfloat_fast_arithmetic<cfloat<32, 8, uint32_t, false, false, false>>::integer, "cfloat<32,8> without subnormals should take the integer path");
+	static_assert(!cfloat_fast_arithmetic<cfloat<80, 15, uint32_t, true, false, false>>::enabled, "cfloat<80,15> exceeds the machine word");
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyFastPath<cfloat<8, 2, uint8_t, true, true, false>>(true, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<bfloat_t>(true, test_tag, 100000);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyFastPathConfigurations<4, 1>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPathConfigurations<6, 2>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPathConfigurations<8, 2>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPathConfigurations<8, 4>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<half>(reportTestCases), "half", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<single>(reportTestCases), "single", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<bfloat_t>(reportTestCases), "bfloat16", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<cfloat<16, 5, uint16_t, true, true, true>>(reportTestCases), "cfloat<16,5,ttt>", "special values");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyFastPathConfigurations<8, 1>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPathConfigurations<8, 3>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPathConfigurations<8, 5>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += VerifyFastPath<half>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<bfloat_t>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<16, 5, uint16_t, false, false, false>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<single>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<32, 8, uint32_t, false, false, false>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<32, 8, uint8_t, true, true, true>>(reportTestCases, test_tag, 100000);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += VerifyFastPathConfigurations<10, 3, uint16_t>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<duble>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<64, 11, uint32_t, false, false, false>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<48, 8, uint16_t, true, false, false>>(reportTestCases, test_tag, 100000);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += VerifyFastPath<cfloat<64, 8, uint64_t, true, true, false>>(reportTestCases, test_tag, 1000000);
+	nrOfFailedTestCases += VerifyFastPath<cfloat<24, 8, uint8_t, true, false, true>>(reportTestCases, test_tag, 1000000);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::cfloat_arithmetic_exception& err) {
+	std::cerr << "Uncaught cfloat arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+// log_domain.cpp: test suite runner for the native log-domain math functions of lns
+//
+// sqrt, rsqrt, and integer powers are exact operations on the fixed-point exponent, so their results
+// must be the correctly rounded ones, including the ties of odd exponents, which round to even. The
+// additive functions hypot, log1p, and expm1 take their Gauss correction from the add/sub policy of
+// the configuration, and must match the double reference within the tolerance of that policy.
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <universal/number/lns/lns.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// two configurations whose hypot, log1p, and expm1 take the Gauss correction of an approximate policy
+	template<>
+	struct lns_addsub_traits<lns<8, 3, std::uint8_t>> {
+		using type = LookupAddSub<lns<8, 3, std::uint8_t>>;
+	};
+	template<>
+	struct lns_addsub_traits<lns<10, 4, std::uint16_t>> {
+		using type = PolynomialAddSub<lns<10, 4, std::uint16_t>>;
+	};
+
+	// the fixed-point exponent of a positive value, recovered through double
+	template<typename TestType>
+	double FixedPointExponent(const TestType& a) {
+		return std::nearbyint(std::log2(double(a)) * TestType::scaling);
+	}
+
+	// the lns with fixed-point exponent e
+	template<typename TestType>
+	TestType FromFixedPointExponent(double e) {
+		return TestType(std::exp2(e / TestType::scaling));
+	}
+
+	// sqrt and rsqrt: half the exponent, with ties to even, for all positive encodings
+	template<typename TestType>
+	int VerifySqrtRsqrt(bool reportTestCases) {
+		constexpr unsigned NR_TEST_CASES = (1u << TestType::nbits);
+		int nrOfFailedTests = 0;
+		TestType a;
+		for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+			a.setbits(i);
+			if (a.isneg() || a.iszero() || a.isnan()) continue;
+			double e = FixedPointExponent(a);
+			TestType ref = FromFixedPointExponent<TestType>(std::nearbyint(e / 2.0));
+			TestType result = sqrt(a);
+			if (result != ref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "sqrt", a, result, ref);
+			}
+			ref = FromFixedPointExponent<TestType>(std::nearbyint(-e / 2.0));
+			result = rsqrt(a);
+			if (result != ref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "rsqrt", a, result, ref);
+			}
+		}
+		// the special cases
+		a.setzero();
+		if (!sqrt(a).iszero()) ++nrOfFailedTests;
+		if (!rsqrt(a).isnan()) ++nrOfFailedTests;
+		return nrOfFailedTests;
+	}
+
+	// pow(x, n): the exponent times n for all encodings, which the double reference reproduces exactly
+	template<typename TestType>
+	int VerifyIntegerPower(bool reportTestCases) {
+		constexpr unsigned NR_TEST_CASES = (1u << TestType::nbits);
+		int nrOfFailedTests = 0;
+		TestType a;
+		for (int n : { -3, -2, -1, 0, 1, 2, 3, 5 }) {
+			for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+				a.setbits(i);
+				if (a.isnan()) continue;
+				TestType result = pow(a, n);
+				TestType ref = std::pow(double(a), double(n));
+				if (result != ref) {
+					++nrOfFailedTests;
+					if (reportTestCases) ReportTwoInputFunctionError("FAIL", "pow", a, TestType(n), result, ref);
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// hypot against the double reference, within the tolerance of the add/sub policy
+	template<typename TestType>
+	int VerifyGaussHypot(bool reportTestCases) {
+		constexpr unsigned NR_TEST_CASES = (1u << TestType::nbits);
+		int nrOfFailedTests = 0;
+		TestType a, b;
+		for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+			a.setbits(i);
+			for (unsigned j = 0; j < NR_TEST_CASES; ++j) {
+				b.setbits(j);
+				TestType result = hypot(a, b);
+				TestType ref = std::hypot(double(a), double(b));
+				if (!lns_eq_within_alg_tolerance(result, ref)) {
+					++nrOfFailedTests;
+					if (reportTestCases) ReportTwoInputFunctionError("FAIL", "hypot", a, b, result, ref);
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// log1p and expm1 against the double reference, within the tolerance of the add/sub policy
+	template<typename TestType>
+	int VerifyGaussLog1pExpm1(bool reportTestCases) {
+		constexpr unsigned NR_TEST_CASES = (1u << TestType::nbits);
+		int nrOfFailedTests = 0;
+		TestType a;
+		for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+			a.setbits(i);
+			TestType result = log1p(a);
+			TestType ref = std::log1p(double(a));
+			if (!lns_eq_within_alg_tolerance(result, ref)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "log1p", a, result, ref);
+			}
+			result = expm1(a);
+			ref = std::expm1(double(a));
+			if (!lns_eq_within_alg_tolerance(result, ref)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "expm1", a, result, ref);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// exp and exp2 of a large negative argument saturate onto minpos, as the double reference path does,
+	// while exp10 rounds to zero like the conversion of its double reference
+	template<typename TestType>
+	int VerifyExpUnderflow(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		TestType minpos(SpecificValue::minpos), zero(0);
+		for (TestType a : { TestType(-1.0e6), TestType(SpecificValue::maxneg) }) {
+			TestType result = exp(a);
+			if (result != minpos) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "exp", a, result, minpos);
+			}
+			result = exp2(a);
+			if (result != minpos) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "exp2", a, result, minpos);
+			}
+			result = exp10(a);
+			if (result != zero) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", "exp10", a, result, zero);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lns native log-domain math";
+	std::string test_tag    = "log domain";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Lns = lns<8, 2, std::uint8_t>;
+	Lns a(2.0);
+	std::cout << "sqrt(" << a << ") = " << sqrt(a) << " : " << to_binary(sqrt(a)) << '\n';
+	std::cout << "pow(" << a << ", 3) = " << pow(a, 3) << " : " << to_binary(pow(a, 3)) << '\n';
+	std::cout << "hypot(" << a << ", " << a << ") = " << hypot(a, a) << " : " << to_binary(hypot(a, a)) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtRsqrt< lns<8, 2, std::uint8_t> >(reportTestCases), "lns<8,2>", "sqrt/rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtRsqrt< lns<8, 0, std::uint8_t> >(reportTestCases), "lns<8,0>", "sqrt/rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerPower< lns<8, 2, std::uint8_t> >(reportTestCases), "lns<8,2>", "pow(x, n)");
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussHypot< lns<6, 2, std::uint8_t> >(reportTestCases), "lns<6,2>", "hypot");
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussHypot< lns<8, 3, std::uint8_t> >(reportTestCases), "lns<8,3>", "hypot lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussLog1pExpm1< lns<8, 2, std::uint8_t> >(reportTestCases), "lns<8,2>", "log1p/expm1");
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussLog1pExpm1< lns<8, 3, std::uint8_t> >(reportTestCases), "lns<8,3>", "log1p/expm1 lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyExpUnderflow< lns<8, 2, std::uint8_t> >(reportTestCases), "lns<8,2>", "exp underflow");
+	nrOfFailedTestCases += ReportTestResult(VerifyExpUnderflow< lns<16, 8, std::uint16_t> >(reportTestCases), "lns<16,8>", "exp underflow");
+	nrOfFailedTestCases += ReportTestResult(VerifyExpUnderflow< lns<32, 16, std::uint32_t> >(reportTestCases), "lns<32,16>", "exp underflow");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtRsqrt< lns<12, 4, std::uint16_t> >(reportTestCases), "lns<12,4>", "sqrt/rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerPower< lns<10, 3, std::uint16_t> >(reportTestCases), "lns<10,3>", "pow(x, n)");
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussLog1pExpm1< lns<10, 4, std::uint16_t> >(reportTestCases), "lns<10,4>", "log1p/expm1 polynomial");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyGaussHypot< lns<10, 4, std::uint16_t> >(reportTestCases), "lns<10,4>", "hypot polynomial");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtRsqrt< lns<16, 8, std::uint16_t> >(reportTestCases), "lns<16,8>", "sqrt/rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerPower< lns<14, 6, std::uint16_t> >(reportTestCases), "lns<14,6>", "pow(x, n)");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+// span.cpp: test suite for the batched lns math functions of lns_span.hpp
+//
+// The span functions must reproduce the scalar math functions encoding for encoding, including the
+// zero, NaN, and negative arguments, outputs that alias the input, and lengths that are not a
+// multiple of the block size.
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/lns/lns_span.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// random encodings: one in sixteen is zero, one in sixteen NaN, and the others are positive unless signed
+	template<typename Lns>
+	std::vector<Lns> RandomLns(std::mt19937_64& rng, size_t n, bool withSign) {
+		std::vector<Lns> v(n);
+		for (auto& x : v) {
+			switch (rng() & 15) {
+			case 0: x.setzero(); break;
+			case 1: if (withSign) { x.setnan(); break; } [[fallthrough]];
+			default:
+				x.setbits(rng());
+				if (x.isnan() || x.iszero()) x.setzero();
+				else if (!withSign) x.setsign(false);
+				break;
+			}
+		}
+		return v;
+	}
+
+	template<typename Lns>
+	int Compare(bool reportTestCases, const char* op, const std::vector<Lns>& x, const std::vector<Lns>& result, const std::vector<Lns>& reference) {
+		int nrOfFailedTests = 0;
+		for (size_t i = 0; i < x.size(); ++i) {
+			if (result[i] != reference[i] && !(result[i].isnan() && reference[i].isnan())) {
+				++nrOfFailedTests;
+				if (reportTestCases && nrOfFailedTests < 10) std::cerr << "FAIL: " << op << '(' << x[i] << ") = " << result[i] << " reference " << reference[i] << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// all span functions against the scalar functions, including in-place evaluation
+	template<typename Lns>
+	int VerifySpanFunctions(bool reportTestCases, size_t n, unsigned seed) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		auto p = RandomLns<Lns>(rng, n, false);  // sqrt and rsqrt report negative arguments
+		auto x = RandomLns<Lns>(rng, n, true);
+		auto y = RandomLns<Lns>(rng, n, true);
+		std::vector<Lns> r, ref(n);
+		auto reference = [&](const std::vector<Lns>& in, auto f) {
+			for (size_t i = 0; i < n; ++i) ref[i] = f(in[i]);
+		};
+
+		lns_sqrt(p, r);
+		reference(p, [](const Lns& v) { return sqrt(v); });
+		nrOfFailedTests += Compare(reportTestCases, "sqrt", p, r, ref);
+		lns_rsqrt(p, r);
+		reference(p, [](const Lns& v) { return rsqrt(v); });
+		nrOfFailedTests += Compare(reportTestCases, "rsqrt", p, r, ref);
+		for (int e : { -3, 2, 7 }) {
+			lns_pow(x, e, r);
+			reference(x, [e](const Lns& v) { return pow(v, e); });
+			nrOfFailedTests += Compare(reportTestCases, "pow", x, r, ref);
+		}
+		lns_exp2(x, r);
+		reference(x, [](const Lns& v) { return exp2(v); });
+		nrOfFailedTests += Compare(reportTestCases, "exp2", x, r, ref);
+		lns_exp(x, r);
+		reference(x, [](const Lns& v) { return exp(v); });
+		nrOfFailedTests += Compare(reportTestCases, "exp", x, r, ref);
+		lns_log2(x, r);
+		reference(x, [](const Lns& v) { return log2(v); });
+		nrOfFailedTests += Compare(reportTestCases, "log2", x, r, ref);
+		lns_log(x, r);
+		reference(x, [](const Lns& v) { return log(v); });
+		nrOfFailedTests += Compare(reportTestCases, "log", x, r, ref);
+		lns_hypot(x, y, r);
+		for (size_t i = 0; i < n; ++i) ref[i] = hypot(x[i], y[i]);
+		nrOfFailedTests += Compare(reportTestCases, "hypot", x, r, ref);
+
+		// in place: r = sqrt(r) and r = exp(r)
+		r = p;
+		lns_sqrt(std::span<const Lns>(r), std::span<Lns>(r));
+		reference(p, [](const Lns& v) { return sqrt(v); });
+		nrOfFailedTests += Compare(reportTestCases, "sqrt", p, r, ref);
+		r = x;
+		lns_exp(std::span<const Lns>(r), std::span<Lns>(r));
+		reference(x, [](const Lns& v) { return exp(v); });
+		nrOfFailedTests += Compare(reportTestCases, "exp", x, r, ref);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lns span math functions";
+	std::string test_tag    = "span";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	std::mt19937_64 rng(1);
+	auto x = RandomLns<lns<16, 8, std::uint16_t>>(rng, 4, false);
+	std::vector<lns<16, 8, std::uint16_t>> y;
+	lns_sqrt(x, y);
+	for (size_t i = 0; i < x.size(); ++i) std::cout << "sqrt(" << x[i] << ") = " << y[i] << " : " << sqrt(x[i]) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<8, 2, std::uint8_t>>(reportTestCases, 1000, 1), "lns<8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<16, 8, std::uint16_t>>(reportTestCases, 1000, 2), "lns<16,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<32, 16, std::uint32_t>>(reportTestCases, 1000, 3), "lns<32,16>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<16, 8, std::uint8_t>>(reportTestCases, 1000, 4), "lns<16,8,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<24, 12, std::uint32_t>>(reportTestCases, 1000, 5), "lns<24,12>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<16, 8, std::uint16_t>>(reportTestCases, 20000, 6), "lns<16,8>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifySpanFunctions<lns<32, 16, std::uint32_t>>(reportTestCases, 100000, 7), "lns<32,16>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::exception& err) {
+	std::cerr << "Caught unexpected exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
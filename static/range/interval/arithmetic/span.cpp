@@ -0,0 +1,307 @@
+// span.cpp: test suite for the batched interval kernels with hardware directed rounding
+//
+// The element-wise kernels must reproduce the scalar operators endpoint for endpoint, the
+// reductions must enclose the exact result, and the caller's rounding mode must survive.
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cfenv>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <universal/number/interval/interval.hpp>
+#include <universal/number/interval/interval_span.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/erational/ebinratio.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// random value sign * m * 2^e with a uniform binade in [minExp, maxExp]
+	template<typename Scalar>
+	Scalar RandomScalar(std::mt19937_64& rng, int minExp, int maxExp) {
+		std::uniform_real_distribution<double> mantissa(1.0, 2.0);
+		std::uniform_int_distribution<int> exponent(minExp, maxExp);
+		double v = std::ldexp(mantissa(rng), exponent(rng));
+		if (rng() & 1) v = -v;
+		return Scalar(v);
+	}
+
+	// random intervals: a quarter are points, a quarter straddle zero
+	template<typename Scalar>
+	std::vector<interval<Scalar>> RandomIntervals(std::mt19937_64& rng, size_t n, int minExp, int maxExp) {
+		std::vector<interval<Scalar>> v(n);
+		for (auto& x : v) {
+			Scalar a = RandomScalar<Scalar>(rng, minExp, maxExp);
+			Scalar b = RandomScalar<Scalar>(rng, minExp, maxExp);
+			switch (rng() & 3) {
+			case 0: b = a; break;
+			case 1: if ((a < Scalar(0)) == (b < Scalar(0))) b = -b; break;
+			default: break;
+			}
+			x.set(a, b);
+		}
+		return v;
+	}
+
+	template<typename Scalar>
+	bool SameEndpoints(const interval<Scalar>& a, const interval<Scalar>& b) {
+		return a.lo() == b.lo() && a.hi() == b.hi();
+	}
+
+	// add, sub and mul over spans against the scalar operators, including aliased outputs
+	template<typename Scalar>
+	int VerifyElementwise(bool reportTestCases, size_t n, int minExp, int maxExp, unsigned seed) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		auto a = RandomIntervals<Scalar>(rng, n, minExp, maxExp);
+		auto b = RandomIntervals<Scalar>(rng, n, minExp, maxExp);
+		std::vector<interval<Scalar>> c;
+		auto check = [&](const char* op, const std::vector<interval<Scalar>>& result, auto reference) {
+			for (size_t i = 0; i < n; ++i) {
+				interval<Scalar> ref = reference(a[i], b[i]);
+				if (!SameEndpoints(result[i], ref)) {
+					++nrOfFailedTests;
+					if (reportTestCases && nrOfFailedTests < 10) std::cerr << "FAIL: " << a[i] << ' ' << op << ' ' << b[i] << " = " << result[i] << " reference " << ref << '\n';
+				}
+			}
+		};
+		interval_add(a, b, c);
+		check("+", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x + y; });
+		interval_sub(a, b, c);
+		check("-", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x - y; });
+		interval_mul(a, b, c);
+		check("*", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x * y; });
+
+		// in place: c = c - b and c = a * c
+		c = a;
+		interval_sub<Scalar>(c, b, c);
+		check("-", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x - y; });
+		c = b;
+		interval_sub<Scalar>(a, c, c);
+		check("-", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x - y; });
+		c = b;
+		interval_mul<Scalar>(a, c, c);
+		check("*", c, [](const interval<Scalar>& x, const interval<Scalar>& y) { return x * y; });
+		return nrOfFailedTests;
+	}
+
+	using Exact = ebinratio<RationalReduction::Lazy>;
+
+	template<typename Scalar>
+	bool Encloses(const interval<Scalar>& r, const Exact& v) {
+		return Exact(double(r.lo())) <= v && v <= Exact(double(r.hi()));
+	}
+
+	// interval_dot and interval_matvec enclose the exact sum of the corner products
+	template<typename Scalar>
+	int VerifyDot(bool reportTestCases, size_t n, unsigned seed) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		// point intervals have an exact dot product to compare against
+		std::vector<interval<Scalar>> a(n), b(n);
+		Exact exact(0);
+		for (size_t i = 0; i < n; ++i) {
+			a[i] = interval<Scalar>(RandomScalar<Scalar>(rng, -20, 20));
+			b[i] = interval<Scalar>(RandomScalar<Scalar>(rng, -20, 20));
+			exact += Exact(double(a[i].lo())) * Exact(double(b[i].lo()));
+		}
+		interval<Scalar> d = interval_dot(a, b);
+		interval<Scalar> loop(Scalar(0));
+		for (size_t i = 0; i < n; ++i) loop += a[i] * b[i];
+		if (!Encloses(d, exact)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: dot " << d << " does not enclose " << double(exact) << '\n';
+		}
+		// the split accumulation is no looser than a few times the element-wise loop
+		if (d.width() > Scalar(4) * loop.width() + Scalar(4) * std::numeric_limits<Scalar>::denorm_min()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: dot " << d << " much wider than " << loop << '\n';
+		}
+		// wide intervals: every product of members lies between the corner bounds
+		auto x = RandomIntervals<Scalar>(rng, n, -20, 20);
+		auto y = RandomIntervals<Scalar>(rng, n, -20, 20);
+		d = interval_dot(x, y);
+		Exact lo(0), hi(0);
+		for (size_t i = 0; i < n; ++i) {
+			Exact c[4] = { Exact(double(x[i].lo())) * Exact(double(y[i].lo())), Exact(double(x[i].lo())) * Exact(double(y[i].hi())),
+			               Exact(double(x[i].hi())) * Exact(double(y[i].lo())), Exact(double(x[i].hi())) * Exact(double(y[i].hi())) };
+			Exact cmin = c[0], cmax = c[0];
+			for (int k = 1; k < 4; ++k) {
+				if (c[k] < cmin) cmin = c[k];
+				if (cmax < c[k]) cmax = c[k];
+			}
+			lo += cmin;
+			hi += cmax;
+		}
+		if (!Encloses(d, lo) || !Encloses(d, hi)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: dot " << d << " does not enclose [" << double(lo) << ", " << double(hi) << "]\n";
+		}
+		// matvec rows are dot products
+		size_t m = 3;
+		std::vector<interval<Scalar>> A(m * n), v;
+		for (size_t i = 0; i < m; ++i) std::copy(x.begin(), x.end(), A.begin() + static_cast<std::ptrdiff_t>(i * n));
+		interval_matvec(m, n, A, y, v);
+		for (size_t i = 0; i < m; ++i) {
+			if (!SameEndpoints(v[i], d)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: matvec row " << i << ' ' << v[i] << " != " << d << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the residual b - A x of a perturbed solution of a random system is enclosed
+	template<typename Scalar>
+	int VerifyResidual(bool reportTestCases, size_t n, unsigned seed) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		std::vector<Scalar> A(n * n), x(n), b(n, Scalar(0));
+		for (auto& e : A) e = RandomScalar<Scalar>(rng, -4, 4);
+		for (auto& e : x) e = RandomScalar<Scalar>(rng, -4, 4);
+		// b = A x rounded, so the residual is the small rounding error
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t j = 0; j < n; ++j) b[i] += A[i * n + j] * x[j];
+		}
+		std::vector<interval<Scalar>> r;
+		interval_residual(n, n, A, x, b, r);
+		for (size_t i = 0; i < n; ++i) {
+			Exact exact(double(b[i]));
+			for (size_t j = 0; j < n; ++j) exact -= Exact(double(A[i * n + j])) * Exact(double(x[j]));
+			if (!Encloses(r[i], exact)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: residual " << r[i] << " does not enclose " << double(exact) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// Universal Scalars take the element-wise path, which must be the scalar operators exactly
+	template<typename Scalar>
+	int VerifyFallback(bool reportTestCases, size_t n, unsigned seed) {
+		static_assert(!interval_directed_rounding_v<Scalar>, "fallback test needs a Scalar without hardware rounding");
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		auto a = RandomIntervals<Scalar>(rng, n, -6, 6);
+		auto b = RandomIntervals<Scalar>(rng, n, -6, 6);
+		std::vector<interval<Scalar>> c;
+		interval_mul(a, b, c);
+		interval<Scalar> loop(Scalar(0));
+		for (size_t i = 0; i < n; ++i) {
+			if (!SameEndpoints(c[i], a[i] * b[i])) ++nrOfFailedTests;
+			loop += a[i] * b[i];
+		}
+		if (!SameEndpoints(interval_dot(a, b), loop)) ++nrOfFailedTests;
+		if (reportTestCases && nrOfFailedTests) std::cerr << "FAIL: fallback path differs from the scalar operators\n";
+		return nrOfFailedTests;
+	}
+
+	// every kernel leaves the caller's rounding mode in place
+	inline int VerifyRoundingModeRestored(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(7);
+		auto a = RandomIntervals<double>(rng, 1000, -8, 8);
+		std::vector<interval<double>> c;
+		for (int mode : { FE_TONEAREST, FE_TOWARDZERO }) {
+			std::fesetround(mode);
+			interval_add(a, a, c);
+			interval_mul(a, a, c);
+			(void)interval_dot(a, a);
+			if (std::fegetround() != mode) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: rounding mode " << mode << " not restored\n";
+			}
+		}
+		std::fesetround(FE_TONEAREST);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "interval span kernels ";
+	std::string test_tag    = "span";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	std::mt19937_64 rng(1);
+	auto a = RandomIntervals<double>(rng, 4, -2, 2);
+	std::vector<interval<double>> c;
+	interval_mul(a, a, c);
+	for (size_t i = 0; i < a.size(); ++i) std::cout << a[i] << "^2 = " << c[i] << " : " << a[i] * a[i] << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<double>(reportTestCases, 5000, -30, 30, 1), "interval<double>", "add/sub/mul");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<float>(reportTestCases, 5000, -30, 30, 2), "interval<float>", "add/sub/mul");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<double>(reportTestCases, 1000, 3), "interval<double>", "dot/matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<float>(reportTestCases, 1000, 4), "interval<float>", "dot/matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyResidual<double>(reportTestCases, 40, 5), "interval<double>", "residual");
+	nrOfFailedTestCases += ReportTestResult(VerifyFallback<cfloat<16, 5, std::uint16_t, true>>(reportTestCases, 500, 6), "interval<cfloat<16,5>>", "fallback");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingModeRestored(reportTestCases), "interval<double>", "rounding mode");
+#endif
+
+#if REGRESSION_LEVEL_2
+	// overflow, gradual underflow and subnormal products
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<double>(reportTestCases, 20000, -1074, 1023, 7), "interval<double>", "full range");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<float>(reportTestCases, 20000, -149, 127, 8), "interval<float>", "full range");
+	nrOfFailedTestCases += ReportTestResult(VerifyResidual<float>(reportTestCases, 40, 9), "interval<float>", "residual");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<double>(reportTestCases, 10000, 10), "interval<double>", "dot/matvec");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyResidual<double>(reportTestCases, 200, 11), "interval<double>", "residual");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::exception& err) {
+	std::cerr << "Caught unexpected exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,220 @@
+//  perf.cpp : performance benchmarking of element-wise interval operators against the span kernels
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include <universal/number/interval/interval.hpp>
+#include <universal/number/interval/interval_span.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::internal {
+
+	// a dense n x n system A x = b in row-major order, shared by the workloads of a Scalar
+	template<typename Scalar>
+	struct LinearSystem {
+		size_t n;
+		std::vector<Scalar> A, x, b;
+		std::vector<interval<Scalar>> IA, Ix;
+
+		static const LinearSystem& instance(size_t n) {
+			static LinearSystem system(n);
+			return system;
+		}
+
+		explicit LinearSystem(size_t _n) : n{ _n }, A(n * n), x(n), b(n), IA(n * n), Ix(n) {
+			std::mt19937_64 rng(n);
+			std::uniform_real_distribution<double> dist(-1.0, 1.0);
+			for (auto& e : A) e = Scalar(dist(rng));
+			for (auto& e : x) e = Scalar(dist(rng));
+			for (auto& e : b) e = Scalar(dist(rng));
+			for (size_t i = 0; i < n * n; ++i) IA[i] = interval<Scalar>(A[i], A[i] + Scalar(1.0e-6));
+			for (size_t i = 0; i < n; ++i) Ix[i] = interval<Scalar>(x[i]);
+		}
+	};
+
+	template<typename Scalar>
+	size_t Dimension(size_t NR_OPS) { return static_cast<size_t>(std::sqrt(double(NR_OPS))); }
+
+	// r = b - A x in the Scalar itself: the unvalidated baseline
+	template<typename Scalar>
+	void PointResidualWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<Scalar> r(s.n);
+		for (size_t i = 0; i < s.n; ++i) {
+			Scalar ax(0);
+			for (size_t j = 0; j < s.n; ++j) ax += s.A[i * s.n + j] * s.x[j];
+			r[i] = s.b[i] - ax;
+		}
+		if (r[0] == Scalar(1.0e30)) std::cout << "amazing\n";
+	}
+
+	// validated residual with the interval operators, element by element
+	template<typename Scalar>
+	void OperatorResidualWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> r(s.n);
+		for (size_t i = 0; i < s.n; ++i) {
+			interval<Scalar> ax(Scalar(0));
+			for (size_t j = 0; j < s.n; ++j) ax += interval<Scalar>(s.A[i * s.n + j]) * interval<Scalar>(s.x[j]);
+			r[i] = interval<Scalar>(s.b[i]) - ax;
+		}
+		if (r[0].isnan()) std::cout << "amazing\n";
+	}
+
+	// validated residual with the directed-rounding span kernel
+	template<typename Scalar>
+	void SpanResidualWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> r;
+		interval_residual(s.n, s.n, s.A, s.x, s.b, r);
+		if (r[0].isnan()) std::cout << "amazing\n";
+	}
+
+	// interval matrix-vector product with the operators
+	template<typename Scalar>
+	void OperatorMatvecWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> y(s.n);
+		for (size_t i = 0; i < s.n; ++i) {
+			interval<Scalar> acc(Scalar(0));
+			for (size_t j = 0; j < s.n; ++j) acc += s.IA[i * s.n + j] * s.Ix[j];
+			y[i] = acc;
+		}
+		if (y[0].isnan()) std::cout << "amazing\n";
+	}
+
+	// interval matrix-vector product with the span kernel
+	template<typename Scalar>
+	void SpanMatvecWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> y;
+		interval_matvec(s.n, s.n, s.IA, s.Ix, y);
+		if (y[0].isnan()) std::cout << "amazing\n";
+	}
+
+	// element-wise products of interval arrays with the operators
+	template<typename Scalar>
+	void OperatorMultiplyWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> c(s.IA.size());
+		for (size_t i = 0; i < c.size(); ++i) c[i] = s.IA[i] * s.IA[c.size() - 1 - i];
+		if (c[0].isnan()) std::cout << "amazing\n";
+	}
+
+	// element-wise products of interval arrays with the span kernel
+	template<typename Scalar>
+	void SpanMultiplyWorkload(size_t NR_OPS) {
+		const auto& s = LinearSystem<Scalar>::instance(Dimension<Scalar>(NR_OPS));
+		std::vector<interval<Scalar>> reversed(s.IA.rbegin(), s.IA.rend()), c;
+		interval_mul(s.IA, reversed, c);
+		if (c[0].isnan()) std::cout << "amazing\n";
+	}
+
+	/*
+	October, 2026, x86-64 container, gcc -O2, 1024 x 1024 system
+	double           residual   point            1048576 per         0.00165sec -> 635 Mops/sec
+	interval<double> residual   operators        1048576 per        0.127561sec ->   8 Mops/sec
+	interval<double> residual   span kernel      1048576 per      0.00363822sec -> 288 Mops/sec
+	interval<double> matvec     operators        1048576 per        0.147512sec ->   7 Mops/sec
+	interval<double> matvec     span kernel      1048576 per       0.0048149sec -> 217 Mops/sec
+	interval<double> multiply   operators        1048576 per        0.128616sec ->   8 Mops/sec
+	interval<double> multiply   span kernel      1048576 per       0.0295257sec ->  35 Mops/sec
+	float            residual   point            1048576 per      0.00101767sec ->   1 Gops/sec
+	interval<float>  residual   operators        1048576 per       0.0879722sec ->  11 Mops/sec
+	interval<float>  residual   span kernel      1048576 per     0.000947716sec ->   1 Gops/sec
+	the span multiply includes building the reversed operand array
+	*/
+	void TestIntervalSpanPerformance() {
+		using namespace sw::universal;
+		std::cout << "\ninterval operators versus span kernels, one multiply-add per op\n";
+
+		size_t NR_OPS = 1024ull * 1024ull;
+		LinearSystem<double>::instance(Dimension<double>(NR_OPS));
+		LinearSystem<float>::instance(Dimension<float>(NR_OPS));
+		PerformanceRunner("double           residual   point        ", PointResidualWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> residual   operators    ", OperatorResidualWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> residual   span kernel  ", SpanResidualWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> matvec     operators    ", OperatorMatvecWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> matvec     span kernel  ", SpanMatvecWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> multiply   operators    ", OperatorMultiplyWorkload<double>, NR_OPS);
+		PerformanceRunner("interval<double> multiply   span kernel  ", SpanMultiplyWorkload<double>, NR_OPS);
+		PerformanceRunner("float            residual   point        ", PointResidualWorkload<float>, NR_OPS);
+		PerformanceRunner("interval<float>  residual   operators    ", OperatorResidualWorkload<float>, NR_OPS);
+		PerformanceRunner("interval<float>  residual   span kernel  ", SpanResidualWorkload<float>, NR_OPS);
+	}
+
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "interval span kernel performance benchmarking";
+	std::string test_tag    = "performance";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	internal::TestIntervalSpanPerformance();
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	internal::TestIntervalSpanPerformance();
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
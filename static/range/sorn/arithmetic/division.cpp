@@ -5,60 +5,82 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <sstream>
 #include <universal/number/sorn/sorn.hpp>
-#include <universal/verification/test_suite.hpp>    // there is a generic VerifyDivision here
+#include <universal/verification/test_suite.hpp>
 
 namespace sw { namespace universal {
 
-	//template<typename SornType,
-	//	std::enable_if_t<is_sorn<SornType>, SornType> = 0
-	//>
+	// the set of lattice intervals alo..ahi
 	template<typename SornType>
-	int VerifyDivision_(bool reportTestCases) {
-		constexpr size_t nbits = SornType::nbits;
-		// using value_type = typename SornType::value_type;
-
+	SornType SornRun(size_t alo, size_t ahi) {
+		typename SornType::bits_type bits;
+		for (size_t i = alo; i <= ahi; ++i) bits.set(i);
 		SornType s;
-		std::cerr << "SORN type : " << type_tag(s) << " : nbits = " << nbits << '\n';
-
-		constexpr size_t NR_ENCODINGS = 16; // (1ull << nbits);
+		return s.setBits(bits);
+	}
 
+	// division of every pair of contiguous sets through the union tables must cover the same lattice
+	// intervals as interval division on the hulls of the operands
+	template<typename SornType>
+	int VerifySornDivision(bool reportTestCases) {
+		constexpr size_t N = SornType::sornBits;
 		int nrOfFailedTestCases = 0;
-
-		SornType a, b, c, cref;
-		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
-			a.setbits(i);
-			double da = double(a);
-			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
-				b.setbits(j);
-				double db = double(b);
-
-				double ref = da + db;
-				c = a + b;
-				cref = ref;
-				//std::cout << "ref  : " << to_binary(ref) << " : " << ref << '\n';
-				//std::cout << "cref : " << std::setw(68) << to_binary(cref) << " : " << cref << '\n';
-				if (c != cref) {
-					if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
-					++nrOfFailedTestCases;
-					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
-					//std::cout << "ref  : " << to_binary(ref) << " : " << ref << '\n';
-					//std::cout << "cref : " << std::setw(68) << to_binary(cref) << " : " << cref << '\n';
-				}
-				else {
-					if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "+", a, b, c, ref);
+		for (size_t alo = 0; alo < N; ++alo) {
+			for (size_t ahi = alo; ahi < N; ++ahi) {
+				SornType a = SornRun<SornType>(alo, ahi);
+				for (size_t blo = 0; blo < N; ++blo) {
+					for (size_t bhi = blo; bhi < N; ++bhi) {
+						SornType b = SornRun<SornType>(blo, bhi);
+						SornType c = a / b;
+						SornType cref;
+						cref.setBits(SornType::cover(sornDiv(a.interval(), b.interval())));
+						if (c != cref) {
+							++nrOfFailedTestCases;
+							if (reportTestCases) std::cerr << "FAIL: " << a << " / " << b << " = " << c << " reference " << cref << '\n';
+						}
+						if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+					}
 				}
-				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
 			}
 		}
 		return nrOfFailedTestCases;
 	}
 
+	// worked examples on the linear lattice sorn<0, 4, 8>
+	int VerifySornDivisionCases(bool reportTestCases) {
+		using SornType = sorn<0, 4, 8>;
+		struct { float a, b; const char* expected; } cases[] = {
+			{ 1, 2, "(0,1]" },
+			{ 1, 0, "[-inf,inf]" },
+			{ 0, 3, "0" },
+		};
+		int nrOfFailedTestCases = 0;
+		for (auto& t : cases) {
+			SornType a(t.a), b(t.b);
+			std::stringstream s;
+			s << (a / b);
+			if (s.str() != t.expected) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " / " << b << " = " << s.str() << " expected " << t.expected << '\n';
+			}
+		}
+		// a native operand takes part with its exact value
+		SornType a(3);
+		std::stringstream s;
+		s << (a / 2);
+		if (s.str() != "(1,1.5]") {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << a << " / 2 = " << s.str() << " expected (1,1.5]\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
 } }  // namespace sw::universal
 
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -84,25 +106,27 @@ try {
 
 	ReportTestSuiteHeader(test_suite, reportTestCases);
 
-#if MANUAL_TESTING
-	
-//	using FloatSorn = sorn<0, 4, 8 >; // set up SORN datatype (linear);
+	using LinearSorn = sorn<0, 4, 8>;                      // linear lattice with negatives, infinity and zero
+	using LogSorn    = sorn<-2, 2, 1, false>;              // logarithmic lattice
+	using PosSorn    = sorn<0, 4, 8, true, true, false, false, true>; // non-negative, saturating lattice
 
-//	TestCase< FloatSorn, float>(TestCaseOperator::ADD, 0.5f, -0.5f);
+#if MANUAL_TESTING
 
-//	nrOfFailedTestCases += ReportTestResult(VerifyDivision_<FloatSorn>(reportTestCases), "sorn<float>", test_tag);
+	LinearSorn a(1.0f), b(3.0f);
+	std::cout << a << " / " << b << " = " << (a / b) << '\n';
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS;
 #else
-	using FloatSorn = sorn<0, 4, 8 >; // set up SORN datatype (linear);
 
 #if REGRESSION_LEVEL_1
-	nrOfFailedTestCases += ReportTestResult(VerifyDivision<FloatSorn>(reportTestCases), "sorn<float>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySornDivisionCases(reportTestCases), "sorn<0,4,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySornDivision<LinearSorn>(reportTestCases), "sorn<0,4,8>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
-	
+	nrOfFailedTestCases += ReportTestResult(VerifySornDivision<LogSorn>(reportTestCases), "sorn<-2,2,1,log>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySornDivision<PosSorn>(reportTestCases), "sorn<0,4,8,pos>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
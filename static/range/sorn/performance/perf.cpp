@@ -0,0 +1,164 @@
+//  perf.cpp : baseline performance benchmarking for sorn construction and arithmetic operators
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <universal/number/sorn/sorn.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::internal {
+
+	// construct an array of SORN values
+	template<typename Scalar>
+	void ConstructionWorkload(size_t NR_OPS) {
+		std::vector<Scalar> v(NR_OPS);
+		for (size_t i = 0; i < NR_OPS; ++i) v[i] = static_cast<float>(i & 0x7) * 0.5f;
+		if (v[NR_OPS - 1].isnan()) std::cout << "amazing\n";
+	}
+
+	// Generic set of adds for a given number system type
+	template<typename Scalar>
+	void AdditionWorkload(size_t NR_OPS) {
+		Scalar a(0.25f), b(0.75f), c;
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c = a + b;
+			a = (i & 1) ? c : b;
+		}
+		if (c.isnan()) std::cout << "amazing\n";
+	}
+
+	// Generic set of multiplies for a given number system type
+	template<typename Scalar>
+	void MultiplicationWorkload(size_t NR_OPS) {
+		Scalar a(0.75f), b(1.25f), c;
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c = a * b;
+			a = (i & 1) ? c : b;
+		}
+		if (c.isnan()) std::cout << "amazing\n";
+	}
+
+	// Generic set of divides for a given number system type
+	template<typename Scalar>
+	void DivisionWorkload(size_t NR_OPS) {
+		Scalar a(0.75f), b(1.25f), c;
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			c = a / b;
+			a = (i & 1) ? c : b;
+		}
+		if (c.isnan()) std::cout << "amazing\n";
+	}
+
+	/*
+	October, 2026, x86-64 container, gcc -O2
+	each value used to carry its own std::vector lattice, 40 bytes plus a heap copy of 19 intervals:
+	sorn<0,4,8>      construction     262144 per        0.195924sec ->   1 Mops/sec
+	sorn<0,4,8>      add              262144 per       0.0321725sec ->   8 Mops/sec
+	sorn<0,4,8>      multiply         262144 per         0.03853sec ->   6 Mops/sec
+	with the shared lattice and the union tables a sorn<0,4,8> is 8 bytes:
+	sorn<0,4,8>      construction    1048576 per       0.0149837sec ->  69 Mops/sec
+	sorn<0,4,8>      add             1048576 per      0.00730488sec -> 143 Mops/sec
+	sorn<0,4,8>      multiply        1048576 per      0.00750536sec -> 139 Mops/sec
+	sorn<0,4,8>      divide          1048576 per      0.00715974sec -> 146 Mops/sec
+	sorn<0,16,64>    construction    1048576 per       0.0316987sec ->  33 Mops/sec
+	sorn<0,16,64>    add              262144 per       0.0485533sec ->   5 Mops/sec
+	sorn<0,16,64>    multiply         262144 per         0.02962sec ->   8 Mops/sec
+	sorn<-8,8,1,log> multiply        1048576 per       0.0079648sec -> 131 Mops/sec
+	*/
+	void TestArithmeticOperatorPerformance() {
+		using namespace sw::universal;
+		std::cout << "\nSORN construction and arithmetic operator performance\n";
+
+		size_t NR_OPS = 1024ull * 1024ull;
+		PerformanceRunner("sorn<0,4,8>      construction", ConstructionWorkload< sorn<0, 4, 8> >, NR_OPS);
+		PerformanceRunner("sorn<0,4,8>      add         ", AdditionWorkload< sorn<0, 4, 8> >, NR_OPS);
+		PerformanceRunner("sorn<0,4,8>      multiply    ", MultiplicationWorkload< sorn<0, 4, 8> >, NR_OPS);
+		PerformanceRunner("sorn<0,4,8>      divide      ", DivisionWorkload< sorn<0, 4, 8> >, NR_OPS);
+
+		PerformanceRunner("sorn<0,16,64>    construction", ConstructionWorkload< sorn<0, 16, 64> >, NR_OPS);
+		PerformanceRunner("sorn<0,16,64>    add         ", AdditionWorkload< sorn<0, 16, 64> >, NR_OPS / 4);
+		PerformanceRunner("sorn<0,16,64>    multiply    ", MultiplicationWorkload< sorn<0, 16, 64> >, NR_OPS / 4);
+		PerformanceRunner("sorn<-8,8,1,log> multiply    ", MultiplicationWorkload< sorn<-8, 8, 1, false> >, NR_OPS);
+	}
+
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "sorn operator performance benchmarking";
+	std::string test_tag    = "performance";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	internal::TestArithmeticOperatorPerformance();
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	internal::TestArithmeticOperatorPerformance();
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,496 @@
+// fast_arithmetic.cpp: the machine-word path of posit arithmetic against an exact reference
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <utility>
+#include <vector>
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	enum class FastOp { add, mul, div, fma };
+
+	// An exact reference that shares no code with the operators: a posit is decoded from its bits
+	// into (-1)^negative * significand * 2^exponent, the operations are carried out on arbitrary
+	// precision integers, and the exact result is rounded to the posit bit string, to nearest even,
+	// saturating at minpos and maxpos.
+	struct exact_value {
+		bool negative{ false };
+		std::vector<uint32_t> significand;  // little-endian digits, empty for zero
+		int exponent{ 0 };
+	};
+
+	inline void trim(std::vector<uint32_t>& m) {
+		while (!m.empty() && m.back() == 0) m.pop_back();
+	}
+	inline unsigned bit_length(const std::vector<uint32_t>& m) {
+		return m.empty() ? 0u : 32u * static_cast<unsigned>(m.size() - 1) + static_cast<unsigned>(std::bit_width(m.back()));
+	}
+	inline bool test_bit(const std::vector<uint32_t>& m, unsigned i) {
+		return (i / 32 < m.size()) && ((m[i / 32] >> (i % 32)) & 1u);
+	}
+	inline std::vector<uint32_t> shift_left(const std::vector<uint32_t>& m, unsigned shift) {
+		std::vector<uint32_t> r(m.size() + shift / 32 + 1, 0u);
+		for (size_t i = 0; i < m.size(); ++i) {
+			uint64_t w = uint64_t(m[i]) << (shift % 32);
+			r[i + shift / 32] |= static_cast<uint32_t>(w);
+			r[i + shift / 32 + 1] |= static_cast<uint32_t>(w >> 32);
+		}
+		trim(r);
+		return r;
+	}
+	inline int compare(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+		if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+		for (size_t i = a.size(); i-- > 0;) if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+		return 0;
+	}
+	inline std::vector<uint32_t> add_magnitudes(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+		std::vector<uint32_t> r(std::max(a.size(), b.size()) + 1, 0u);
+		uint64_t carry = 0;
+		for (size_t i = 0; i < r.size(); ++i) {
+			uint64_t sum = carry + (i < a.size() ? a[i] : 0u) + (i < b.size() ? b[i] : 0u);
+			r[i] = static_cast<uint32_t>(sum);
+			carry = sum >> 32;
+		}
+		trim(r);
+		return r;
+	}
+	// a - b for a >= b
+	inline std::vector<uint32_t> sub_magnitudes(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+		std::vector<uint32_t> r(a.size(), 0u);
+		int64_t borrow = 0;
+		for (size_t i = 0; i < a.size(); ++i) {
+			int64_t diff = int64_t(a[i]) - (i < b.size() ? int64_t(b[i]) : 0) - borrow;
+			borrow = diff < 0 ? 1 : 0;
+			r[i] = static_cast<uint32_t>(diff + (borrow << 32));
+		}
+		trim(r);
+		return r;
+	}
+	inline std::vector<uint32_t> mul_magnitudes(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+		std::vector<uint32_t> r(a.size() + b.size() + 1, 0u);
+		for (size_t i = 0; i < a.size(); ++i) {
+			uint64_t carry = 0;
+			for (size_t j = 0; j < b.size(); ++j) {
+				uint64_t t = uint64_t(a[i]) * b[j] + r[i + j] + carry;
+				r[i + j] = static_cast<uint32_t>(t);
+				carry = t >> 32;
+			}
+			r[i + b.size()] = static_cast<uint32_t>(carry);
+		}
+		trim(r);
+		return r;
+	}
+
+	template<typename Posit>
+	exact_value decode_exact(const Posit& p) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		constexpr unsigned nbits = Posit::nbits;
+		constexpr unsigned es = Posit::es;
+		exact_value v;
+		uint64_t raw = Fast::bits(p);
+		if (raw == 0) return v;
+		v.negative = (raw >> (nbits - 1)) & 1u;
+		if (v.negative) raw = Fast::negate(raw);
+		// the bits after the sign, most significant first
+		int i = static_cast<int>(nbits) - 2;
+		auto bit = [&](int k) { return k >= 0 && ((raw >> k) & 1u); };
+		bool first = bit(i);
+		int run = 0;
+		while (i >= 0 && bit(i) == first) { ++run; --i; }
+		--i;  // the regime terminator
+		int k = first ? run - 1 : -run;
+		int e = 0;
+		for (unsigned j = 0; j < es; ++j, --i) e = 2 * e + (bit(i) ? 1 : 0);
+		int fbits = std::max(i + 1, 0);
+		uint64_t fraction = fbits > 0 ? (raw & ((uint64_t(1) << fbits) - 1u)) : 0u;
+		uint64_t significand = (uint64_t(1) << fbits) | fraction;
+		v.significand = { static_cast<uint32_t>(significand), static_cast<uint32_t>(significand >> 32) };
+		trim(v.significand);
+		v.exponent = k * (1 << es) + e - fbits;
+		return v;
+	}
+
+	inline exact_value exact_mul(const exact_value& a, const exact_value& b) {
+		exact_value r;
+		if (a.significand.empty() || b.significand.empty()) return r;
+		r.negative = a.negative != b.negative;
+		r.significand = mul_magnitudes(a.significand, b.significand);
+		r.exponent = a.exponent + b.exponent;
+		return r;
+	}
+	inline exact_value exact_add(exact_value a, exact_value b) {
+		if (a.significand.empty()) return b;
+		if (b.significand.empty()) return a;
+		// align to the smaller exponent
+		if (a.exponent < b.exponent) std::swap(a, b);
+		a.significand = shift_left(a.significand, static_cast<unsigned>(a.exponent - b.exponent));
+		a.exponent = b.exponent;
+		exact_value r;
+		r.exponent = b.exponent;
+		if (a.negative == b.negative) {
+			r.negative = a.negative;
+			r.significand = add_magnitudes(a.significand, b.significand);
+		}
+		else {
+			int c = compare(a.significand, b.significand);
+			if (c == 0) return exact_value{};
+			r.negative = c > 0 ? a.negative : b.negative;
+			r.significand = c > 0 ? sub_magnitudes(a.significand, b.significand) : sub_magnitudes(b.significand, a.significand);
+		}
+		return r;
+	}
+	// the quotient to 128 fraction bits past the posit precision, rounded to odd: the lowest bit is set
+	// when the remainder is nonzero, which preserves the rounding decision of the shorter bit string
+	inline exact_value exact_div(const exact_value& a, const exact_value& b) {
+		exact_value r;
+		if (a.significand.empty()) return r;
+		constexpr unsigned extra = 128;
+		std::vector<uint32_t> n = shift_left(a.significand, extra);
+		std::vector<uint32_t> q(n.size(), 0u), rem;
+		for (unsigned i = bit_length(n); i-- > 0;) {
+			rem = shift_left(rem, 1);
+			if (test_bit(n, i)) {
+				if (rem.empty()) rem.push_back(0u);
+				rem[0] |= 1u;
+			}
+			if (compare(rem, b.significand) >= 0) {
+				rem = sub_magnitudes(rem, b.significand);
+				q[i / 32] |= 1u << (i % 32);
+			}
+		}
+		trim(q);
+		r.negative = a.negative != b.negative;
+		r.significand = shift_left(q, 1);
+		if (!rem.empty()) r.significand[0] |= 1u;
+		r.exponent = a.exponent - b.exponent - static_cast<int>(extra) - 1;
+		return r;
+	}
+
+	// round the exact value to the posit bit string
+	template<typename Posit>
+	Posit round_exact(const exact_value& v) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		constexpr unsigned nbits = Posit::nbits;
+		constexpr unsigned es = Posit::es;
+		Posit r{};
+		if (v.significand.empty()) { r.setzero(); return r; }
+		unsigned length = bit_length(v.significand);
+		int scale = v.exponent + static_cast<int>(length) - 1;
+		int k = (scale >= 0) ? scale / (1 << es) : -((-scale + (1 << es) - 1) / (1 << es));
+		int e = scale - k * (1 << es);
+
+		// the nbits - 1 bits after the sign, the guard bit, and the sticky bit of the rest
+		uint64_t kept = 0;
+		unsigned count = 0;
+		bool guard = false, sticky = false;
+		auto emit = [&](bool b) {
+			if (count < nbits - 1) kept = (kept << 1) | (b ? 1u : 0u);
+			else if (count == nbits - 1) guard = b;
+			else sticky = sticky || b;
+			++count;
+		};
+		int run = (k >= 0) ? k + 1 : -k;
+		for (int j = 0; j < run && count <= nbits; ++j) emit(k >= 0);
+		emit(k < 0);
+		for (int j = static_cast<int>(es) - 1; j >= 0; --j) emit((e >> j) & 1);
+		for (unsigned j = length - 1; j-- > 0;) {
+			if (count > nbits) {
+				// only the sticky bit is left: any set bit below
+				for (unsigned t = 0; t <= j && !sticky; ++t) sticky = test_bit(v.significand, t);
+				break;
+			}
+			emit(test_bit(v.significand, j));
+		}
+		if (count <= nbits - 1) kept <<= (nbits - 1 - count);  // short strings are padded with zeros
+
+		if (guard && (sticky || (kept & 1u))) ++kept;
+		constexpr uint64_t maxpos = (uint64_t(1) << (nbits - 1)) - 1u;
+		if (kept > maxpos) kept = maxpos;
+		if (kept == 0) kept = 1;   // posits do not round to zero
+		r.setbits(v.negative ? Fast::negate(kept) : kept);
+		return r;
+	}
+
+	template<typename Posit>
+	Posit ReferenceAdd(const Posit& a, const Posit& b) {
+		return round_exact<Posit>(exact_add(decode_exact(a), decode_exact(b)));
+	}
+	template<typename Posit>
+	Posit ReferenceMul(const Posit& a, const Posit& b) {
+		return round_exact<Posit>(exact_mul(decode_exact(a), decode_exact(b)));
+	}
+	template<typename Posit>
+	Posit ReferenceDiv(const Posit& a, const Posit& b) {
+		return round_exact<Posit>(exact_div(decode_exact(a), decode_exact(b)));
+	}
+	template<typename Posit>
+	Posit ReferenceFma(const Posit& a, const Posit& b, const Posit& c) {
+		return round_exact<Posit>(exact_add(exact_mul(decode_exact(a), decode_exact(b)), decode_exact(c)));
+	}
+
+	// run one fast operation and compare it to the reference when the fast path takes the operands
+	template<typename Posit>
+	int VerifyFastOperation(bool reportTestCases, FastOp op, const Posit& a, const Posit& b, const Posit& c, size_t& taken) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		Posit r(a);
+		bool accepted{ false };
+		switch (op) {
+		case FastOp::add: accepted = Fast::add(r, b); break;
+		case FastOp::mul: accepted = Fast::mul(r, b); break;
+		case FastOp::div: accepted = Fast::div(r, b); break;
+		case FastOp::fma: accepted = Fast::fma(r, a, b, c); break;
+		}
+		if (!accepted) return 0;
+		++taken;
+		Posit ref{};
+		switch (op) {
+		case FastOp::add: ref = ReferenceAdd(a, b); break;
+		case FastOp::mul: ref = ReferenceMul(a, b); break;
+		case FastOp::div: ref = ReferenceDiv(a, b); break;
+		case FastOp::fma: ref = ReferenceFma(a, b, c); break;
+		}
+		if (r != ref) {
+			if (reportTestCases) {
+				const char* opName = (op == FastOp::add ? " + " : (op == FastOp::div ? " / " : " * "));
+				std::cerr << "FAIL " << type_tag(a) << ' ' << to_binary(a) << opName << to_binary(b);
+				if (op == FastOp::fma) std::cerr << " + " << to_binary(c);
+				std::cerr << " = " << to_binary(r) << " reference " << to_binary(ref) << '\n';
+			}
+			return 1;
+		}
+		return 0;
+	}
+
+	// all pairs of encodings, or all triples for fma
+	template<typename Posit>
+	int VerifyExhaustiveFastPath(bool reportTestCases, FastOp op) {
+		constexpr size_t NR_ENCODINGS = (size_t(1) << Posit::nbits);
+		int nrOfFailedTests = 0;
+		size_t taken = 0, total = 0;
+		Posit a{}, b{}, c{};
+		const size_t NR_ADDENDS = (op == FastOp::fma ? NR_ENCODINGS : 1);
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				for (size_t k = 0; k < NR_ADDENDS; ++k) {
+					c.setbits(k);
+					++total;
+					nrOfFailedTests += VerifyFastOperation(reportTestCases, op, a, b, c, taken);
+					if (nrOfFailedTests > 24) return nrOfFailedTests;
+				}
+			}
+		}
+		// the fast path must cover the bulk of the encodings, or the test is not testing it
+		if (taken < total / 2) ++nrOfFailedTests;
+		return nrOfFailedTests;
+	}
+
+	// random operands; half of them share their regime and exponent to exercise cancellation and ties,
+	// and half of the fma addends cancel the leading bits of the product
+	template<typename Posit>
+	int VerifyRandomFastPath(bool reportTestCases, FastOp op, size_t nrSamples) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		constexpr unsigned nbits = Posit::nbits;
+		constexpr uint64_t MASK = Fast::MASK;
+		std::mt19937_64 rng(0x5eed'7051'7ull + nbits);
+		int nrOfFailedTests = 0;
+		size_t taken = 0;
+		Posit a{}, b{}, c{};
+		for (size_t i = 0; i < nrSamples; ++i) {
+			uint64_t ra = rng() & MASK;
+			uint64_t rb = rng() & MASK;
+			uint64_t rc = rng() & MASK;
+			if (i & 1) {
+				// copy the sign, the regime, and the leading bits of a into b
+				uint64_t high = MASK << (nbits / 2);
+				rb = (ra & high) | (rb & ~high & MASK);
+			}
+			if (op == FastOp::fma && (i & 2)) {
+				uint64_t product;
+				if (Fast::mulBits(ra, rb, product)) {
+					uint64_t high = MASK << (nbits / 4);
+					rc = (Fast::negate(product) & high) | (rc & ~high & MASK);
+				}
+			}
+			if (i % 7 == 0) rb ^= MASK >> 1;  // long regimes
+			a.setbits(ra);
+			b.setbits(rb);
+			c.setbits(rc);
+			nrOfFailedTests += VerifyFastOperation(reportTestCases, op, a, b, c, taken);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		if (taken < nrSamples / 2) ++nrOfFailedTests;
+		return nrOfFailedTests;
+	}
+
+	template<typename Posit>
+	int VerifyFastPath(bool reportTestCases, const std::string& test_tag, size_t nrSamples = 0) {
+		using Fast = posit_fast_arithmetic<Posit>;
+		int nrOfFailedTests = 0;
+		std::string tag = test_tag + ' ' + type_tag(Posit());
+		if constexpr (Posit::nbits <= 10) {
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Posit>(reportTestCases, FastOp::add), tag, "add");
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Posit>(reportTestCases, FastOp::mul), tag, "mul");
+			nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Posit>(reportTestCases, FastOp::div), tag, "div");
+			if constexpr (Fast::fusedMultiplyAdd && Posit::nbits <= 7) {
+				nrOfFailedTests += ReportTestResult(VerifyExhaustiveFastPath<Posit>(reportTestCases, FastOp::fma), tag, "fma");
+			}
+		}
+		else {
+			if constexpr (Fast::addition) {
+				nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Posit>(reportTestCases, FastOp::add, nrSamples), tag, "add");
+			}
+			nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Posit>(reportTestCases, FastOp::mul, nrSamples), tag, "mul");
+			if constexpr (Fast::division) {
+				nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Posit>(reportTestCases, FastOp::div, nrSamples), tag, "div");
+			}
+		}
+		if constexpr (Fast::fusedMultiplyAdd && Posit::nbits > 7) {
+			nrOfFailedTests += ReportTestResult(VerifyRandomFastPath<Posit>(reportTestCases, FastOp::fma, (nrSamples ? nrSamples : 100000)), tag, "fma");
+		}
+		return nrOfFailedTests;
+	}
+
+	// zero and NaR take the generic operators, and results saturate at minpos and maxpos
+	template<typename Posit>
+	int VerifySpecialValues(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		Posit one(1), zero(0), nar(SpecificValue::nar), minpos(SpecificValue::minpos), maxpos(SpecificValue::maxpos);
+		Posit c = one - one;
+		if (!c.iszero()) ++nrOfFailedTests;
+		c = nar + one;
+		if (!c.isnar()) ++nrOfFailedTests;
+		c = zero + one;
+		if (c != one) ++nrOfFailedTests;
+		c = maxpos * maxpos;
+		if (c != maxpos) ++nrOfFailedTests;
+		c = minpos * -minpos;
+		if (c != -minpos) ++nrOfFailedTests;
+		c = one / zero;
+		if (!c.isnar()) ++nrOfFailedTests;
+		c = maxpos + maxpos;
+		if (c != maxpos) ++nrOfFailedTests;
+		c = fma(maxpos, minpos, -(maxpos * minpos));
+		if (!c.iszero()) ++nrOfFailedTests;
+		c = fma(one, one, nar);
+		if (!c.isnar()) ++nrOfFailedTests;
+		if (reportTestCases && nrOfFailedTests) std::cerr << "FAIL special values of " << type_tag(one) << '\n';
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit arithmetic fast paths";
+	std::string test_tag    = "fast path";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// path selection
+	static_assert(posit_fast_arithmetic<posit<32, 2>>::addition && posit_fast_arithmetic<posit<32, 2>>::division, "posit<32,2> should take the machine-word path");
+	static_assert(posit_fast_arithmetic<posit<64, 3>>::addition, "posit<64,3> addition should take the machine-word path");
+	static_assert(!posit_fast_arithmetic<posit<64, 3>>::division, "posit<64,3> division needs more than a 64-bit dividend");
+	static_assert(!posit_fast_arithmetic<posit<64, 1>>::addition && posit_fast_arithmetic<posit<64, 1>>::multiplication, "posit<64,1> addition has no room for guard bits");
+	static_assert(!posit_fast_arithmetic<posit<80, 3>>::integer, "posit<80,3> exceeds the machine word");
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyFastPath<posit<8, 2>>(true, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<32, 2>>(true, test_tag, 100000);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyFastPath<posit<4, 0>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<5, 1>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<6, 2>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<7, 1>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<8, 0>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<8, 2>>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<posit<8, 2>>(reportTestCases), "posit<8,2>", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<posit<32, 2>>(reportTestCases), "posit<32,2>", "special values");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialValues<posit<64, 3>>(reportTestCases), "posit<64,3>", "special values");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyFastPath<posit<8, 1>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<8, 3>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<10, 1, uint16_t>>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += VerifyFastPath<posit<16, 1>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<32, 2>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<64, 3>>(reportTestCases, test_tag, 100000);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += VerifyFastPath<posit<10, 3, uint16_t>>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyFastPath<posit<24, 1>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<32, 2, uint32_t>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<48, 2, uint16_t>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<64, 1, uint64_t>>(reportTestCases, test_tag, 100000);
+	nrOfFailedTestCases += VerifyFastPath<posit<64, 2>>(reportTestCases, test_tag, 100000);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += VerifyFastPath<posit<32, 2>>(reportTestCases, test_tag, 1000000);
+	nrOfFailedTestCases += VerifyFastPath<posit<64, 3>>(reportTestCases, test_tag, 1000000);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
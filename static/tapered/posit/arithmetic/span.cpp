@@ -0,0 +1,168 @@
+// span.cpp: test suite for the batched posit kernels of posit_span.hpp
+//
+// The kernels must reproduce the scalar operators encoding for encoding, including the zero and NaR
+// operands that take the scalar path, outputs that alias an input, and lengths that are not a
+// multiple of the block size.
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/posit/posit_span.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// random encodings: one in sixteen is zero or NaR, and half share the leading bits of their neighbour
+	template<typename Posit>
+	std::vector<Posit> RandomPosits(std::mt19937_64& rng, size_t n) {
+		constexpr unsigned nbits = Posit::nbits;
+		constexpr uint64_t MASK = posit_fast_arithmetic<Posit>::MASK;
+		std::vector<Posit> v(n);
+		uint64_t previous = 0;
+		for (auto& x : v) {
+			uint64_t raw = rng() & MASK;
+			if (rng() & 1) {
+				uint64_t high = MASK << (nbits / 2);
+				raw = (previous & high) | (raw & ~high & MASK);
+			}
+			switch (rng() & 15) {
+			case 0: x.setzero(); break;
+			case 1: x.setnar(); break;
+			default: x.setbits(raw); break;
+			}
+			previous = raw;
+		}
+		return v;
+	}
+
+	// add, sub, mul and fma over spans against the scalar operators, including aliased outputs
+	template<typename Posit>
+	int VerifyElementwise(bool reportTestCases, size_t n, unsigned seed) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(seed);
+		auto a = RandomPosits<Posit>(rng, n);
+		auto b = RandomPosits<Posit>(rng, n);
+		auto c = RandomPosits<Posit>(rng, n);
+		std::vector<Posit> d;
+		auto check = [&](const char* op, const std::vector<Posit>& result, auto reference) {
+			for (size_t i = 0; i < n; ++i) {
+				Posit ref = reference(a[i], b[i], c[i]);
+				if (result[i] != ref) {
+					++nrOfFailedTests;
+					if (reportTestCases && nrOfFailedTests < 10) std::cerr << "FAIL: " << op << ' ' << a[i] << ' ' << b[i] << ' ' << c[i] << " = " << result[i] << " reference " << ref << '\n';
+				}
+			}
+		};
+		auto add = [](const Posit& x, const Posit& y, const Posit&) { return x + y; };
+		auto sub = [](const Posit& x, const Posit& y, const Posit&) { return x - y; };
+		auto mul = [](const Posit& x, const Posit& y, const Posit&) { return x * y; };
+		auto fused = [](const Posit& x, const Posit& y, const Posit& z) { return fma(x, y, z); };
+		posit_add(a, b, d);
+		check("add", d, add);
+		posit_sub(a, b, d);
+		check("sub", d, sub);
+		posit_mul(a, b, d);
+		check("mul", d, mul);
+		posit_fma(a, b, c, d);
+		check("fma", d, fused);
+
+		// in place: d = d - b, d = a * d, and d = fma(a, b, d)
+		d = a;
+		posit_sub<Posit::nbits, Posit::es, typename Posit::BlockType>(d, b, d);
+		check("sub", d, sub);
+		d = b;
+		posit_mul<Posit::nbits, Posit::es, typename Posit::BlockType>(a, d, d);
+		check("mul", d, mul);
+		d = c;
+		posit_fma(std::span<const Posit>(a), std::span<const Posit>(b), std::span<const Posit>(d), std::span<Posit>(d));
+		check("fma", d, fused);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit span kernels";
+	std::string test_tag    = "span";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	std::mt19937_64 rng(1);
+	auto a = RandomPosits<posit<32, 2>>(rng, 4);
+	std::vector<posit<32, 2>> c;
+	posit_mul(a, a, c);
+	for (size_t i = 0; i < a.size(); ++i) std::cout << a[i] << "^2 = " << c[i] << " : " << a[i] * a[i] << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<8, 2>>(reportTestCases, 1000, 1), "posit<8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<16, 1>>(reportTestCases, 1000, 2), "posit<16,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<32, 2>>(reportTestCases, 1000, 3), "posit<32,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<64, 3>>(reportTestCases, 1000, 4), "posit<64,3>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	// posit<64,1> has only the multiplication kernel, posit<80,3> none
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<64, 1, std::uint64_t>>(reportTestCases, 1000, 5), "posit<64,1,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<80, 3>>(reportTestCases, 300, 6), "posit<80,3>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<32, 2, std::uint32_t>>(reportTestCases, 20000, 7), "posit<32,2,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<64, 3>>(reportTestCases, 100000, 8), "posit<64,3>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::exception& err) {
+	std::cerr << "Caught unexpected exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
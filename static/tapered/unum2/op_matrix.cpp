@@ -0,0 +1,219 @@
+// op_matrix.cpp: tests of the packed unum2 operation table, its bulk generation and its cache file
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+// Use operation matrix/table
+#define UNUM2_USE_OP_MATRIX 1
+#include <universal/number/unum2/unum2.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	using fibonacci_6bit = lattice<1, 2, 3, 5, 8, 13, 21, 34>;
+
+	// compare every entry of two complete tables
+	template<typename Lattice>
+	int CompareTables(bool reportTestCases, const op_matrix<Lattice>& lhs, const op_matrix<Lattice>& rhs) {
+		int nrOfFailedTests = 0;
+		uint64_t N = Lattice::instance()._N;
+		for (int t = 0; t < OP_MATRIX_TOTAL_SUPPORTED_OPS; ++t) {
+			op_matrix_type type = static_cast<op_matrix_type>(t);
+			for (uint64_t i = 0; i < N; ++i) {
+				for (uint64_t j = 0; j < N; ++j) {
+					if (!lhs.has(i, j, type) || !rhs.has(i, j, type) || lhs.get(i, j, type) != rhs.get(i, j, type)) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: entry (" << i << ", " << j << ") of op " << t << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the lazily filled singleton table, built through point arithmetic, must equal the bulk generated
+	// tables for any number of workers
+	template<typename Lattice>
+	int VerifyBulkGeneration(bool reportTestCases) {
+		using u2 = unum2<Lattice>;
+		int nrOfFailedTests = 0;
+		uint64_t N = Lattice::instance()._N;
+		for (uint64_t i = 0; i < N; ++i) {
+			for (uint64_t j = 0; j < N; ++j) {
+				u2 a(i), b(j);
+				(void)(a + b);
+				(void)(a * b);
+			}
+		}
+		op_matrix<Lattice>& lazy = Lattice::op_matrix_instance();
+		op_matrix<Lattice> serial(N), parallel(N);
+		serial.generate(1);
+		parallel.generate(4);
+		nrOfFailedTests += CompareTables(reportTestCases, lazy, serial);
+		nrOfFailedTests += CompareTables(reportTestCases, serial, parallel);
+		return nrOfFailedTests;
+	}
+
+	// a op b over intervals is the union of the point results over all pairs of points
+	template<typename Lattice>
+	int VerifyIntervalUnion(bool reportTestCases) {
+		using u2 = unum2<Lattice>;
+		int nrOfFailedTests = 0;
+		uint64_t N = Lattice::instance()._N;
+		// contiguous runs of lattice points, some of them wrapping through infinity
+		for (uint64_t first = 0; first < N; first += 3) {
+			for (uint64_t length = 1; length < N; length += 5) {
+				u2 a = u2::empty(), b = u2::empty();
+				for (uint64_t k = 0; k < length; ++k) a = a | u2((first + k) % N);
+				for (uint64_t k = 0; k < length / 2 + 1; ++k) b = b | u2((first * 7 + 5 * k) % N);
+				u2 sum = u2::empty(), product = u2::empty();
+				for (uint64_t p = 0; p < length; ++p) {
+					for (uint64_t q = 0; q < length / 2 + 1; ++q) {
+						u2 x((first + p) % N), y((first * 7 + 5 * q) % N);
+						sum = sum | (x + y);
+						product = product | (x * y);
+					}
+				}
+				if (a + b != sum || a * b != product) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: " << a << " op " << b << " : " << (a + b) << " vs " << sum << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// save, map back, and reject files that belong to another lattice or are damaged
+	template<typename Lattice, typename OtherLattice>
+	int VerifyCacheFile(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		uint64_t N = Lattice::instance()._N;
+		std::filesystem::path path = std::filesystem::temp_directory_path() / op_matrix<Lattice>::cache_file_name();
+
+		op_matrix<Lattice> generated(N);
+		if (!generated.save(path.string())) {
+			if (reportTestCases) std::cerr << "FAIL: unable to write " << path << '\n';
+			return 1;
+		}
+		op_matrix<Lattice> loaded(N);
+		if (!loaded.load(path.string())) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: unable to load " << path << '\n';
+		}
+		else {
+			nrOfFailedTests += CompareTables(reportTestCases, generated, loaded);
+			if (!loaded.mapped()) ++nrOfFailedTests;
+		}
+
+		op_matrix<OtherLattice> other(OtherLattice::instance()._N);
+		if (other.load(path.string())) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: cache file of another lattice accepted\n";
+		}
+
+		// flip the fingerprint
+		{
+			std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+			f.seekp(24);
+			f.put('\x5a');
+		}
+		op_matrix<Lattice> corrupted(N);
+		if (corrupted.load(path.string())) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: damaged cache file accepted\n";
+		}
+
+		// attach regenerates the damaged file and maps it
+		op_matrix<Lattice> attached(N);
+		if (!attached.attach(path.string()) || !attached.mapped()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: attach did not regenerate " << path << '\n';
+		}
+		else {
+			nrOfFailedTests += CompareTables(reportTestCases, generated, attached);
+		}
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "unum2 operation matrix ";
+	std::string test_tag    = "op_matrix";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	op_matrix<linear_8bit> table(linear_8bit::instance()._N);
+	table.generate();
+	std::cout << "linear_8bit table: " << table.footprint() << " bytes\n";
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkGeneration<linear_5bit>(reportTestCases), "linear_5bit", "bulk generation");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntervalUnion<linear_5bit>(reportTestCases), "linear_5bit", "interval union");
+	nrOfFailedTestCases += ReportTestResult(VerifyCacheFile<linear_5bit, fibonacci_6bit>(reportTestCases), "linear_5bit", "cache file");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkGeneration<fibonacci_6bit>(reportTestCases), "fibonacci_6bit", "bulk generation");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntervalUnion<fibonacci_6bit>(reportTestCases), "fibonacci_6bit", "interval union");
+	nrOfFailedTestCases += ReportTestResult(VerifyCacheFile<fibonacci_6bit, linear_5bit>(reportTestCases), "fibonacci_6bit", "cache file");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyCacheFile<linear_8bit, linear_5bit>(reportTestCases), "linear_8bit", "cache file");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
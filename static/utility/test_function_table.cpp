@@ -0,0 +1,324 @@
+// test_function_table.cpp: exhaustive function tables of narrow types, their rounding, cache and bulk evaluation
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/math/function_table.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	using cf8  = cfloat<8, 4, std::uint8_t, true, false, false>;
+	using cf12 = cfloat<12, 5, std::uint16_t, true, false, false>;
+	using cf16 = cfloat<16, 5, std::uint16_t, true, false, false>;
+
+	static_assert(function_table_available_v<posit<8, 0>>);
+	static_assert(function_table_available_v<posit<16, 1>>);
+	static_assert(function_table_available_v<cf8>);
+	static_assert(function_table_available_v<cf16>);
+	static_assert(function_table_available_v<lns<16, 8, std::uint16_t>>);
+	static_assert(function_table_available_v<takum<16>>);
+	static_assert(!function_table_available_v<posit<32, 2>>);
+	static_assert(function_table<posit<8, 0>, tabulated::exp>::inlineStorage);
+	static_assert(!function_table<posit<16, 1>, tabulated::exp>::inlineStorage);
+
+	// a function tag that evaluates like sigmoid under another name, so that it gets its own table
+	struct sigmoid_cached {
+		static constexpr const char* name = "sigmoid_cached";
+		static long double eval(long double x) { return tabulated::sigmoid::eval(x); }
+	};
+	struct sigmoid_cached_twin : sigmoid_cached {};
+
+	template<typename Number>
+	bool SameEntry(const Number& lhs, const Number& rhs) {
+		if (isnan(lhs) && isnan(rhs)) return true;
+		return detail::encoding_of(lhs) == detail::encoding_of(rhs);
+	}
+
+	// every finite entry of an IEEE-style cfloat is the value of the type nearest to the long double
+	// reference, ties to the even encoding
+	template<typename Real, typename Fn>
+	int VerifyCorrectlyRounded(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		struct Sample { long double value; std::uint64_t bits; };
+		std::vector<Sample> values;
+		Real v{};
+		for (std::uint64_t i = 0; i < (std::uint64_t(1) << Real::nbits); ++i) {
+			v.setbits(i);
+			if (!isnan(v) && !isinf(v) && !(v.iszero() && v.sign())) values.push_back({ static_cast<long double>(double(v)), i });
+		}
+		std::sort(values.begin(), values.end(), [](const Sample& a, const Sample& b) { return a.value < b.value; });
+		const long double maxpos = values.back().value;
+
+		const auto& table = function_table<Real, Fn>::instance();
+		Real x{};
+		for (std::uint64_t i = 0; i < table.size(); ++i) {
+			x.setbits(i);
+			if (isnan(x) || isinf(x)) continue;
+			long double y = Fn::eval(static_cast<long double>(double(x)));
+			if (std::isnan(y) || std::fabs(y) > maxpos) continue;  // NaN and overflow follow the type's rules
+			auto hi = std::lower_bound(values.begin(), values.end(), y, [](const Sample& s, long double t) { return s.value < t; });
+			auto lo = (hi == values.begin() || (hi != values.end() && hi->value == y)) ? hi : hi - 1;
+			if (hi == values.end()) hi = lo;
+			long double dlo = y - lo->value, dhi = hi->value - y;
+			const Sample& nearest = (dlo < dhi) ? *lo : (dhi < dlo) ? *hi : ((lo->bits & 1u) == 0 ? *lo : *hi);
+			long double entry = static_cast<long double>(double(table[i]));
+			if (entry != nearest.value) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << Fn::name << '(' << x << ") = " << table[i] << " but nearest is " << double(nearest.value) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// lns rounds in the log domain, so its boundaries are geometric: every positive entry in range is
+	// the value whose exponent is nearest to the log2 of the long double reference
+	template<typename Lns, typename Fn>
+	int VerifyLogRounded(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		const long double scale = std::ldexp(1.0L, static_cast<int>(Lns::rbits));
+		const long double maxpos = static_cast<long double>(Lns(SpecificValue::maxpos));
+		const long double minpos = static_cast<long double>(Lns(SpecificValue::minpos));
+		const auto& table = function_table<Lns, Fn>::instance();
+		Lns x{};
+		for (std::uint64_t i = 0; i < table.size(); ++i) {
+			x.setbits(i);
+			if (isnan(x)) continue;
+			long double y = Fn::eval(static_cast<long double>(x));
+			if (!(y >= minpos && y <= maxpos)) continue;  // NaN, sign, and saturation follow the type's rules
+			long double nearest = std::exp2(std::nearbyint(std::log2(y) * scale) / scale);
+			long double entry = static_cast<long double>(table[i]);
+			if (std::fabs(entry - nearest) > nearest * std::ldexp(1.0L, -48)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << Fn::name << '(' << x << ") = " << table[i] << " but nearest is " << double(nearest) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// entries agree with the scalar path T(Fn(double(x))) except where the double result is the midpoint
+	// of two neighbouring values and the long double reference lies off it: there the entry is the
+	// neighbour on the side of the reference. gelu(x) ~ x/2 for tiny x produces such midpoints.
+	// A type that rounds a long double itself also resolves the boundaries that fall between the
+	// double result and the reference, and references beyond the range of double: there the entry
+	// is T's own rounding of the reference.
+	template<typename Number, typename Fn>
+	int VerifyAgainstScalar(bool reportTestCases, bool expectMidpoints) {
+		int nrOfFailedTests = 0;
+		const auto& table = function_table<Number, Fn>::instance();
+		std::size_t midpoints = 0;
+		Number x{};
+		for (std::uint64_t i = 0; i < table.size(); ++i) {
+			x.setbits(i);
+			long double y = Fn::eval(static_cast<long double>(double(x)));
+			double yd = static_cast<double>(y);
+			Number scalar = (yd == 0.0 && y != 0.0L) ? Number(std::numeric_limits<double>::denorm_min()) : Number(yd);
+			if (SameEntry(scalar, table[i])) continue;
+			long double lo = std::min(double(scalar), double(table[i])), hi = std::max(double(scalar), double(table[i]));
+			bool towardReference = (y > static_cast<long double>(yd)) == (double(table[i]) > double(scalar));
+			bool resolved = (lo + hi) / 2.0L == static_cast<long double>(yd) && towardReference;
+			if (!resolved && detail::converts_long_double<Number>()) {
+				resolved = SameEntry(table[i], Number(y)) && (!std::isfinite(yd) || towardReference);
+			}
+			if (resolved) {
+				++midpoints;
+			}
+			else {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << Fn::name << '(' << x << ") = " << table[i] << " but the scalar path gives " << scalar << '\n';
+			}
+		}
+		if (expectMidpoints && midpoints == 0) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << Fn::name << " resolved no midpoints\n";
+		}
+		return nrOfFailedTests;
+	}
+
+	// the three apply overloads and operator() return the table entries
+	template<typename Number, typename Fn>
+	int VerifyApply(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		const auto& table = function_table<Number, Fn>::instance();
+		std::vector<Number> x(table.size() + 3);
+		for (std::size_t i = 0; i < x.size(); ++i) x[i].setbits(i * 40503u);
+		std::vector<Number> y, z(x.size()), w(x);
+		apply<Fn>(x, y);
+		apply<Fn>(std::span<const Number>(x), std::span<Number>(z));
+		apply<Fn>(std::span<Number>(w));
+		for (std::size_t i = 0; i < x.size(); ++i) {
+			const Number& expected = table[detail::encoding_of(x[i])];
+			if (!SameEntry(y[i], expected) || !SameEntry(z[i], expected) || !SameEntry(w[i], expected) || !SameEntry(table(x[i]), expected)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: apply<" << Fn::name << ">(" << x[i] << ") = " << y[i] << " expected " << expected << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the first table of a pair writes the cache file, a second tag with the same name reads it back
+	int VerifyCache(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		using Number = posit<16, 1>;
+		std::filesystem::path dir = std::filesystem::temp_directory_path() / "universal_function_tables";
+		std::filesystem::create_directories(dir);
+		std::filesystem::remove(dir / function_table<Number, sigmoid_cached>::cache_file_name());
+#if defined(_MSC_VER)
+		_putenv_s("UNIVERSAL_FUNCTION_TABLE_CACHE", dir.string().c_str());
+#else
+		setenv("UNIVERSAL_FUNCTION_TABLE_CACHE", dir.string().c_str(), 1);
+#endif
+		const auto& generated = function_table<Number, sigmoid_cached>::instance();
+		const auto& loaded    = function_table<Number, sigmoid_cached_twin>::instance();
+		if (generated.cached() || !loaded.cached()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: cache in " << dir << " not written and read back\n";
+		}
+		const auto& reference = function_table<Number, tabulated::sigmoid>::instance();
+		for (std::size_t i = 0; i < generated.size(); ++i) {
+			if (!SameEntry(generated[i], loaded[i]) || !SameEntry(generated[i], reference[i])) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: cached entry " << i << " : " << loaded[i] << " vs " << generated[i] << '\n';
+				break;
+			}
+		}
+#if defined(_MSC_VER)
+		_putenv_s("UNIVERSAL_FUNCTION_TABLE_CACHE", "");
+#else
+		unsetenv("UNIVERSAL_FUNCTION_TABLE_CACHE");
+#endif
+		return nrOfFailedTests;
+	}
+
+	// the emitted source holds one encoding per argument, in order
+	template<typename Number, typename Fn>
+	int VerifyEmit(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::ostringstream os;
+		emit_function_table<Number, Fn>(os, "table");
+		std::string source = os.str();
+		const auto& table = function_table<Number, Fn>::instance();
+		std::size_t open = source.find('{'), close = source.find('}');
+		if (open == std::string::npos || close == std::string::npos) return 1;
+		std::istringstream body(source.substr(open + 1, close - open - 1));
+		std::string token;
+		std::size_t i = 0;
+		while (body >> token) {
+			if (token.back() == ',') token.pop_back();
+			if (i >= table.size() || std::stoull(token, nullptr, 16) != detail::encoding_of(table[i])) {
+				++nrOfFailedTests;
+				break;
+			}
+			++i;
+		}
+		if (i != table.size()) ++nrOfFailedTests;
+		if (nrOfFailedTests > 0 && reportTestCases) std::cerr << "FAIL: emitted table of " << Fn::name << " has " << i << " matching entries\n";
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "exhaustive function tables";
+	std::string test_tag    = "function_table";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::exp>(true), "cfloat<16,5>", "exp");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf8, tabulated::sin>(reportTestCases), "cfloat<8,4>", "sin");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf8, tabulated::exp>(reportTestCases), "cfloat<8,4>", "exp");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf12, tabulated::tanh>(reportTestCases), "cfloat<12,5>", "tanh");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::log>(reportTestCases), "cfloat<16,5>", "log");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::sigmoid>(reportTestCases), "cfloat<16,5>", "sigmoid");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLogRounded<lns<12, 6, std::uint16_t>, tabulated::exp>(reportTestCases), "lns<12,6>", "exp");
+	nrOfFailedTestCases += ReportTestResult(VerifyLogRounded<lns<16, 8, std::uint16_t>, tabulated::sigmoid>(reportTestCases), "lns<16,8>", "sigmoid");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstScalar<posit<8, 0>, tabulated::tanh>(reportTestCases, false), "posit<8,0>", "tanh");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstScalar<posit<16, 1>, tabulated::exp>(reportTestCases, false), "posit<16,1>", "exp");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstScalar<lns<16, 8, std::uint16_t>, tabulated::sin>(reportTestCases, false), "lns<16,8>", "sin");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstScalar<takum<16>, tabulated::gelu>(reportTestCases, true), "takum<16>", "gelu");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyApply<posit<8, 0>, tabulated::sigmoid>(reportTestCases), "posit<8,0>", "apply");
+	nrOfFailedTestCases += ReportTestResult(VerifyApply<cf16, tabulated::silu>(reportTestCases), "cfloat<16,5>", "apply");
+	nrOfFailedTestCases += ReportTestResult(VerifyCache(reportTestCases), "posit<16,1>", "cache file");
+	nrOfFailedTestCases += ReportTestResult(VerifyEmit<posit<8, 0>, tabulated::tanh>(reportTestCases), "posit<8,0>", "emit");
+	nrOfFailedTestCases += ReportTestResult(VerifyEmit<cf12, tabulated::exp2>(reportTestCases), "cfloat<12,5>", "emit");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::sin>(reportTestCases), "cfloat<16,5>", "sin");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::exp>(reportTestCases), "cfloat<16,5>", "exp");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::tanh>(reportTestCases), "cfloat<16,5>", "tanh");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectlyRounded<cf16, tabulated::erf>(reportTestCases), "cfloat<16,5>", "erf");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::number_array_error& err) {
+	std::cerr << "Uncaught number_array exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
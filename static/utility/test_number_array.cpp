@@ -0,0 +1,327 @@
+// test_number_array.cpp: round trips through the binary number_array container and its mapped reader
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/microfloat/microfloat.hpp>
+#include <universal/utility/number_array.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	inline std::string NumberArrayPath(const std::string& name) {
+		return (std::filesystem::temp_directory_path() / ("universal_" + name + ".unv")).string();
+	}
+
+	// a spread of encodings, all of them for types up to 12 bits
+	template<typename Number>
+	std::vector<Number> SampleEncodings(std::size_t n) {
+		constexpr unsigned nbits = Number::nbits;
+		constexpr std::uint64_t mask = (nbits >= 64) ? ~0ull : ((1ull << nbits) - 1ull);
+		std::vector<Number> v(n);
+		std::uint64_t state = 0x2545'F491'4F6C'DD1Dull;
+		for (std::size_t i = 0; i < n; ++i) {
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			v[i].setbits(nbits <= 12 ? (i & mask) : ((state >> 7) & mask));
+		}
+		return v;
+	}
+
+	template<typename Number>
+	bool SameEncodings(const std::vector<Number>& lhs, std::span<const Number> rhs) {
+		if (lhs.size() != rhs.size()) return false;
+		for (std::size_t i = 0; i < lhs.size(); ++i) {
+			if (detail::encoding_of(lhs[i]) != detail::encoding_of(rhs[i])) return false;
+		}
+		return true;
+	}
+
+	// write a few chunks, read them back decoded and, where the representation allows it, in place
+	template<typename Number>
+	int VerifyRoundTrip(bool reportTestCases, const std::string& name, bool expectZeroCopy) {
+		int nrOfFailedTests = 0;
+		std::string path = NumberArrayPath(name);
+		std::vector<std::vector<Number>> chunks = { SampleEncodings<Number>(4096), SampleEncodings<Number>(7), {}, SampleEncodings<Number>(1001) };
+		{
+			number_array_writer<Number> out(path);
+			for (const auto& c : chunks) out.append(c);
+		}
+		number_array_reader in(path);
+		if (!in.holds<Number>() || in.chunks() != chunks.size() || in.size() != 4096 + 7 + 1001 || in.tag() != type_tag(Number{})) {
+			if (reportTestCases) std::cerr << "FAIL: " << name << " header or chunk index\n";
+			std::filesystem::remove(path);
+			return 1;
+		}
+		if (in.zero_copy<Number>() != expectZeroCopy) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << name << " zero copy " << in.zero_copy<Number>() << '\n';
+		}
+		std::vector<Number> all;
+		for (std::size_t c = 0; c < chunks.size(); ++c) {
+			std::vector<Number> decoded = in.read<Number>(c);
+			if (!SameEncodings(chunks[c], std::span<const Number>(decoded))) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << name << " chunk " << c << " decoded\n";
+			}
+			if (expectZeroCopy && !SameEncodings(chunks[c], in.view<Number>(c))) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << name << " chunk " << c << " viewed in place\n";
+			}
+			all.insert(all.end(), chunks[c].begin(), chunks[c].end());
+		}
+		std::vector<Number> concatenated = in.read<Number>();
+		if (!SameEncodings(all, std::span<const Number>(concatenated))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << name << " all chunks\n";
+		}
+		// elements narrower than a byte are bit-packed
+		constexpr std::size_t expectedBytes = (Number::nbits < 8) ? (4096 * Number::nbits + 7) / 8 : 4096 * ((Number::nbits + 7) / 8);
+		if (in.raw(0).size() != expectedBytes || in.packed() != (Number::nbits < 8)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << name << " payload of " << in.raw(0).size() << " bytes\n";
+		}
+		in.close();
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+	// e2m1 packs two elements per byte, LSB first
+	int VerifyPackedLayout(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::string path = NumberArrayPath("e2m1_layout");
+		std::vector<e2m1> v(3);
+		v[0].setbits(0x3u);
+		v[1].setbits(0xAu);
+		v[2].setbits(0x7u);
+		{
+			number_array_writer<e2m1> out(path);
+			out.append(v);
+		}
+		number_array_reader in(path);
+		auto raw = in.raw(0);
+		if (raw.size() != 2 || raw[0] != 0xA3 || raw[1] != 0x07) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: e2m1 packed layout\n";
+		}
+		try {
+			(void)in.view<e2m1>(0);
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: packed chunk viewed in place\n";
+		}
+		catch (const number_array_error&) {
+			// correctly rejected
+		}
+		in.close();
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+	// a consumer picks up the chunks a producer appends, and a torn trailing chunk is ignored and
+	// dropped on the next append
+	int VerifyStreamingAppend(bool reportTestCases) {
+		using Number = posit<16, 1>;
+		int nrOfFailedTests = 0;
+		std::string path = NumberArrayPath("stream");
+		std::vector<Number> first = SampleEncodings<Number>(100), second = SampleEncodings<Number>(50);
+		number_array_writer<Number> producer(path);
+		producer.append(first);
+
+		number_array_reader consumer(path);
+		if (consumer.chunks() != 1) ++nrOfFailedTests;
+		producer.append(second);
+		producer.close();
+		if (!consumer.refresh() || consumer.chunks() != 2 || !SameEncodings(second, consumer.view<Number>(1))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: refresh did not pick up the appended chunk\n";
+		}
+		consumer.close();
+
+		// a chunk header with only half of its payload
+		{
+			std::ofstream torn(path, std::ios::binary | std::ios::app);
+			unsigned char h[16] = { 'U', 'N', 'V', 'C', 'H', 'U', 'N', 'K', 200, 0, 0, 0, 0, 0, 0, 0 };
+			torn.write(reinterpret_cast<const char*>(h), 16);
+			std::vector<char> half(200, 0);
+			torn.write(half.data(), 200);
+		}
+		if (!consumer.open(path) || consumer.chunks() != 2 || consumer.size() != 150) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: torn chunk indexed\n";
+		}
+		consumer.close();
+		{
+			number_array_writer<Number> resumed(path, true);
+			resumed.append(first);
+			if (resumed.chunks() != 3 || resumed.size() != 250) ++nrOfFailedTests;
+		}
+		if (!consumer.open(path) || consumer.chunks() != 3) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: append after a torn chunk\n";
+		}
+		else {
+			std::vector<Number> all = first;
+			all.insert(all.end(), second.begin(), second.end());
+			all.insert(all.end(), first.begin(), first.end());
+			std::vector<Number> read = consumer.read<Number>();
+			if (!SameEncodings(all, std::span<const Number>(read))) ++nrOfFailedTests;
+		}
+		consumer.close();
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+	// reading as, or appending, another type is an error
+	int VerifyTypeMismatch(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::string path = NumberArrayPath("mismatch");
+		{
+			number_array_writer<posit<32, 2>> out(path);
+			out.append(SampleEncodings<posit<32, 2>>(10));
+		}
+		number_array_reader in(path);
+		if (in.holds<posit<32, 1>>() || in.holds<cfloat<32, 8, uint32_t, true, false, false>>() || in.holds<float>()) ++nrOfFailedTests;
+		try {
+			(void)in.read<posit<32, 1>>();
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: posit<32,2> read as posit<32,1>\n";
+		}
+		catch (const number_array_error&) {
+			// correctly rejected
+		}
+		in.close();
+		try {
+			number_array_writer<lns<32, 8>> out(path, true);
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: lns appended to a posit file\n";
+		}
+		catch (const number_array_error&) {
+			// correctly rejected
+		}
+		{
+			std::ofstream garbage(path, std::ios::binary | std::ios::trunc);
+			garbage << "posit<32,2> 1.5 2.5\n";
+		}
+		number_array_reader text;
+		if (text.open(path)) ++nrOfFailedTests;
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+	// native arrays round trip bit for bit, NaN payloads included
+	int VerifyNative(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::string path = NumberArrayPath("native");
+		std::vector<double> v = { 0.0, -0.0, 1.0, -1.5e300, 4.9e-324, std::numeric_limits<double>::infinity(), sw::bit_cast<double>(0x7FF8'0000'DEAD'BEEFull) };
+		{
+			number_array_writer<double> out(path);
+			out.append(v);
+		}
+		number_array_reader in(path);
+		auto view = in.view<double>(0);
+		for (std::size_t i = 0; i < v.size(); ++i) {
+			if (sw::bit_cast<std::uint64_t>(view[i]) != sw::bit_cast<std::uint64_t>(v[i])) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: double " << i << '\n';
+			}
+		}
+		if (in.tag() != "double" || in.holds<std::int64_t>()) ++nrOfFailedTests;
+		in.close();
+		std::filesystem::remove(path);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "binary number_array container ";
+	std::string test_tag    = "number_array";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<posit<32, 2>>(true, "posit32", true), "posit<32,2>", "round trip");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<posit<32, 2>>(reportTestCases, "posit32", true), "posit<32,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<posit<16, 1>>(reportTestCases, "posit16", true), "posit<16,1>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<cfloat<32, 8, uint32_t, true, false, false>>(reportTestCases, "fp32", true), "cfloat<32,8>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<lns<16, 8, uint16_t>>(reportTestCases, "lns16", true), "lns<16,8>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<e2m1>(reportTestCases, "e2m1", false), "e2m1", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyPackedLayout(reportTestCases), "e2m1", "packed layout");
+	nrOfFailedTestCases += ReportTestResult(VerifyStreamingAppend(reportTestCases), "posit<16,1>", "streaming append");
+	nrOfFailedTestCases += ReportTestResult(VerifyTypeMismatch(reportTestCases), "posit<32,2>", "type mismatch");
+	nrOfFailedTestCases += ReportTestResult(VerifyNative(reportTestCases), "double", "native");
+#endif
+
+#if REGRESSION_LEVEL_2
+	// odd widths: padded bytes, and storage words wider than the encoding
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<posit<20, 2>>(reportTestCases, "posit20", true), "posit<20,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<cfloat<24, 5, uint32_t, true, false, false>>(reportTestCases, "cfloat24", false), "cfloat<24,5>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<fixpnt<12, 4>>(reportTestCases, "fixpnt12", true), "fixpnt<12,4>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<e3m2>(reportTestCases, "e3m2", false), "e3m2", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<posit<64, 3>>(reportTestCases, "posit64", true), "posit<64,3>", "round trip");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::number_array_error& err) {
+	std::cerr << "Uncaught number_array exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,51 @@
+// benchcmp.cpp: cli to compare two benchmark result files and flag regressions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <universal/benchmark/benchmark_harness.hpp>
+
+// compare the median rates of two runs, written by benchmarks run with UNIVERSAL_BENCHMARK_OUTPUT set
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	if (argc < 3 || argc > 4) {
+		std::cerr << "benchcmp : compare two benchmark result files\n";
+		std::cerr << "Flags measurements whose 95% confidence intervals separate and whose medians differ by more than the threshold.\n";
+		std::cerr << "Usage: benchcmp baseline.{csv,json,jsonl} current.{csv,json,jsonl} [threshold_in_percent, default 5]\n";
+		std::cerr << "Example: UNIVERSAL_BENCHMARK_OUTPUT=before.csv ./benchmark_compare_performance\n";
+		std::cerr << "         UNIVERSAL_BENCHMARK_OUTPUT=after.csv  ./benchmark_compare_performance\n";
+		std::cerr << "         benchcmp before.csv after.csv 3\n";
+		return EXIT_SUCCESS;  // signal successful completion for ctest
+	}
+	double threshold = (argc == 4) ? std::atof(argv[3]) / 100.0 : 0.05;
+
+	auto baseline = ReadBenchmarkResults(argv[1]);
+	auto current  = ReadBenchmarkResults(argv[2]);
+	if (baseline.empty()) { std::cerr << "benchcmp: no results in " << argv[1] << '\n'; return EXIT_FAILURE; }
+	if (current.empty())  { std::cerr << "benchcmp: no results in " << argv[2] << '\n'; return EXIT_FAILURE; }
+
+	int nrRegressions = 0;
+	std::cout << std::left << std::setw(64) << "benchmark" << std::right << std::setw(14) << "baseline" << std::setw(14) << "current" << std::setw(9) << "ratio" << "  verdict\n";
+	for (const auto& d : CompareBenchmarkResults(baseline, current, threshold)) {
+		std::cout << std::left << std::setw(64) << d.key << std::right << std::setw(14) << std::setprecision(4) << d.baseline << std::setw(14) << d.current
+		          << std::setw(9) << std::fixed << std::setprecision(3) << d.ratio() << std::defaultfloat << "  " << to_string(d.outcome) << '\n';
+		if (d.outcome == benchmark_delta::verdict::regression) ++nrRegressions;
+	}
+	if (nrRegressions > 0) std::cout << nrRegressions << " regression" << (nrRegressions > 1 ? "s\n" : "\n");
+	return (nrRegressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (const char* const msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
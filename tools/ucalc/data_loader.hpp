@@ -6,15 +6,27 @@
 // - Comma-separated values (single or multiple lines)
 // - Mixed whitespace/comma delimiters
 //
+// load_csv maps the file and, for files of a megabyte or more, splits it at line boundaries and
+// parses the pieces on separate threads with std::from_chars. Tokens std::from_chars rejects
+// ("+1", hex floats) fall back to std::stod, so the accepted syntax is unchanged, except that
+// subnormal values, which std::stod reports as out of range, now load.
+//
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project.
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <universal/utility/mapped_file.hpp>
 
 namespace sw { namespace ucalc {
 
@@ -44,41 +56,113 @@ inline std::vector<std::string> tokenize_line(const std::string& line) {
 	return tokens;
 }
 
+namespace detail {
+
+// values, line count, and first malformed token of one line-aligned piece of a file
+struct csv_chunk {
+	std::vector<double> data;
+	int lines = 0;
+	int error_line = 0;   // 1-based within the chunk, 0 when the chunk parsed cleanly
+	std::string error_token;
+	std::exception_ptr failure;
+};
+
+inline bool is_csv_separator(char c) {
+	return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline void parse_csv_chunk(const char* first, const char* last, csv_chunk& chunk) try {
+	const char* p = first;
+	while (p < last) {
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(last - p)));
+		if (eol == nullptr) eol = last;
+		++chunk.lines;
+		// Skip comments and blank lines
+		const char* q = p;
+		while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+		if (q < eol && *q != '#') {
+			while (q < eol) {
+				while (q < eol && is_csv_separator(*q)) ++q;
+				if (q == eol) break;
+				const char* end = q;
+				while (end < eol && !is_csv_separator(*end)) ++end;
+				double v = 0.0;
+				auto [ptr, ec] = std::from_chars(q, end, v);
+				if (ec != std::errc{} || ptr != end) {
+					try {
+						v = parse_double_strict(std::string(q, end));
+					} catch (const std::exception&) {
+						chunk.error_line = chunk.lines;
+						chunk.error_token.assign(q, end);
+						return;
+					}
+				}
+				chunk.data.push_back(v);
+				q = end;
+			}
+		}
+		p = eol + 1;
+	}
+}
+catch (...) {
+	chunk.failure = std::current_exception();
+}
+
+} // namespace detail
+
 // Load floating-point values from a CSV/text file.
 // Handles: one-per-line, comma-separated, mixed whitespace.
 // Skips blank lines and lines starting with '#' (comments).
 // Throws file_not_found on open failure, runtime_error on parse failure.
 inline std::vector<double> load_csv(const std::string& path) {
-	std::ifstream fin(path);
-	if (!fin.is_open()) {
+	sw::universal::mapped_file file;
+	if (!file.open(path)) {
 		throw file_not_found("cannot open file: " + path);
 	}
-	std::vector<double> data;
-	std::string line;
-	int line_num = 0;
-	while (std::getline(fin, line)) {
-		++line_num;
-		// Skip comments and blank lines
-		size_t first = line.find_first_not_of(" \t\r\n");
-		if (first == std::string::npos) continue;
-		if (line[first] == '#') continue;
+	const char* base = reinterpret_cast<const char*>(file.data());
+	const char* last = base + file.size();
 
-		// Replace commas with spaces for uniform tokenizing
-		for (auto& c : line) {
-			if (c == ',') c = ' ';
+	// one piece per megabyte, at most one per hardware thread
+	constexpr size_t piece = size_t(1) << 20;
+	size_t nrThreads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), file.size() / piece));
+	std::vector<const char*> bounds{ base };
+	for (size_t i = 1; i < nrThreads; ++i) {
+		const char* cut = std::max(bounds.back(), base + file.size() / nrThreads * i);
+		const char* eol = static_cast<const char*>(std::memchr(cut, '\n', static_cast<size_t>(last - cut)));
+		if (eol == nullptr) break;
+		bounds.push_back(eol + 1);
+	}
+	bounds.push_back(last);
+
+	std::vector<detail::csv_chunk> chunks(bounds.size() - 1);
+	if (chunks.size() == 1) {
+		detail::parse_csv_chunk(base, last, chunks[0]);
+	}
+	else {
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < chunks.size(); ++i) {
+			workers.emplace_back(detail::parse_csv_chunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
 		}
-		for (const auto& tok : tokenize_line(line)) {
-			try {
-				data.push_back(parse_double_strict(tok));
-			} catch (const std::exception&) {
-				throw std::runtime_error("malformed value '" + tok
-				    + "' at line " + std::to_string(line_num) + " in " + path);
-			}
+		for (auto& w : workers) w.join();
+	}
+
+	std::vector<double> data;
+	size_t total = 0;
+	int line_num = 0;
+	for (const auto& chunk : chunks) {
+		if (chunk.failure) std::rethrow_exception(chunk.failure);
+		if (chunk.error_line > 0) {
+			throw std::runtime_error("malformed value '" + chunk.error_token
+			    + "' at line " + std::to_string(line_num + chunk.error_line) + " in " + path);
 		}
+		line_num += chunk.lines;
+		total += chunk.data.size();
 	}
-	if (data.empty()) {
+	if (total == 0) {
 		throw std::runtime_error("no numeric data found in file: " + path);
 	}
+	data.reserve(total);
+	for (const auto& chunk : chunks) data.insert(data.end(), chunk.data.begin(), chunk.data.end());
 	return data;
 }
 
@@ -0,0 +1,168 @@
+// dispatch.cpp: testbench for runtime ISA detection and multiversioned kernel dispatch
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <universal/hw/dispatch.hpp>
+#include <universal/number/td_cascade/td_cascade.hpp>
+#include <universal/internal/floatcascade/cascade_vector.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// a multiversioned kernel: one body, compiled per level, tagged so the test can see which ran
+	UNIVERSAL_KERNEL_INLINE void scale_body(const double* x, double* y, std::size_t n, double tag) {
+		for (std::size_t i = 0; i < n; ++i) y[i] = 2.0 * x[i];
+		if (n > 0) y[n - 1] = tag;
+	}
+	void scale_scalar(const double* x, double* y, std::size_t n) { scale_body(x, y, n, 0.0); }
+	UNIVERSAL_TARGET_AVX2 void scale_avx2(const double* x, double* y, std::size_t n) { scale_body(x, y, n, 2.0); }
+
+	const kernel_table<void(const double*, double*, std::size_t)>& scale_kernels() {
+		static const kernel_table<void(const double*, double*, std::size_t)> table = [] {
+			kernel_table<void(const double*, double*, std::size_t)> t(scale_scalar);
+			t.register_kernel(isa::avx2, scale_avx2);
+			return t;
+		}();
+		return table;
+	}
+
+	// the summary level must be consistent with the individual feature bits
+	int VerifyFeatureConsistency(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		const cpu_features& f = host_cpu_features();
+		isa level = f.level();
+		if (level >= isa::avx2 && !(f.avx && f.avx2 && f.fma)) ++nrOfFailedTestCases;
+		if (level >= isa::avx512 && !(f.avx512f && f.avx512bw && f.avx512dq && f.avx512vl)) ++nrOfFailedTestCases;
+		if (level >= isa::avx512_bf16 && !f.avx512_bf16) ++nrOfFailedTestCases;
+		if (level >= isa::avx512_fp16 && !f.avx512_fp16) ++nrOfFailedTestCases;
+		if (detected_isa() != level) ++nrOfFailedTestCases;
+		if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: isa level " << level << " inconsistent with " << f << '\n';
+		return nrOfFailedTestCases;
+	}
+
+	int VerifyIsaNames(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		for (int i = 0; i < nrOfIsaLevels; ++i) {
+			isa level = static_cast<isa>(i), parsed{ isa::scalar };
+			if (!parse(to_string(level), parsed) || parsed != level) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << level << " does not round-trip\n";
+			}
+		}
+		isa parsed{ isa::scalar };
+		if (!parse("avx512_bf16", parsed) || parsed != isa::avx512_bf16) ++nrOfFailedTestCases;
+		if (parse("neon", parsed)) ++nrOfFailedTestCases;
+		return nrOfFailedTestCases;
+	}
+
+	// resolution picks the highest registered level at or below the request
+	int VerifyResolution(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		const auto& table = scale_kernels();
+		isa withAvx2 = UNIVERSAL_HAS_TARGET_ATTRIBUTES ? isa::avx2 : isa::scalar;
+		if (table.selected(isa::scalar) != isa::scalar) ++nrOfFailedTestCases;
+		if (table.selected(isa::sse4_2) != isa::scalar) ++nrOfFailedTestCases;
+		if (table.selected(isa::avx2) != withAvx2) ++nrOfFailedTestCases;
+		if (table.selected(isa::avx512_fp16) != withAvx2) ++nrOfFailedTestCases;
+		if (table.resolve(isa::sse4_2) != &scale_scalar) ++nrOfFailedTestCases;
+		if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: kernel table resolution\n";
+		return nrOfFailedTestCases;
+	}
+
+	// the override lowers the active level, never raises it, and the kernel that runs follows it
+	int VerifyOverride(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		clear_isa_override();
+		if (active_isa() != detected_isa()) ++nrOfFailedTestCases;
+
+		std::vector<double> x(16, 1.0), y(16);
+		set_isa_override(isa::scalar);
+		if (active_isa() != isa::scalar) ++nrOfFailedTestCases;
+		scale_kernels().resolve()(x.data(), y.data(), x.size());
+		if (y[0] != 2.0 || y[15] != 0.0) ++nrOfFailedTestCases;
+
+		set_isa_override(isa::avx512_fp16);
+		if (active_isa() != detected_isa()) ++nrOfFailedTestCases;
+
+		if (UNIVERSAL_HAS_TARGET_ATTRIBUTES && detected_isa() >= isa::avx2) {
+			set_isa_override(isa::avx2);
+			scale_kernels().resolve()(x.data(), y.data(), x.size());
+			if (y[0] != 2.0 || y[15] != 2.0) ++nrOfFailedTestCases;
+		}
+		clear_isa_override();
+		if (nrOfFailedTestCases && reportTestCases) std::cerr << "FAIL: isa override\n";
+		return nrOfFailedTestCases;
+	}
+
+	// every variant of a registered bulk kernel must compute the same bits
+	int VerifyCascadeVectorVariants(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		constexpr std::size_t n = 100;
+		std::vector<td_cascade> a(n), b(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			a[i] = td_cascade(1.0) / td_cascade(double(i + 3));
+			b[i] = td_cascade(double(i) - 50.0) / td_cascade(7.0);
+		}
+		cascade_vector<3> x(a), y(b), reference(n), z(n);
+		set_isa_override(isa::scalar);
+		add(x, y, reference);
+		for (isa level : { isa::avx2, isa::avx512 }) {
+			if (level > detected_isa()) break;
+			set_isa_override(level);
+			add(x, y, z);
+			for (std::size_t i = 0; i < n; ++i) {
+				if (z[i] != reference[i]) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) std::cerr << "FAIL: " << level << " variant of cascade_vector add differs at " << i << '\n';
+					break;
+				}
+			}
+		}
+		clear_isa_override();
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "runtime ISA dispatch";
+	std::string test_tag    = "dispatch";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	std::cout << "host features  : " << host_cpu_features() << '\n';
+	std::cout << "detected level : " << detected_isa() << '\n';
+	std::cout << "active level   : " << active_isa() << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFeatureConsistency(reportTestCases), "cpu_features", "consistency");
+	nrOfFailedTestCases += ReportTestResult(VerifyIsaNames(reportTestCases), "isa", "names");
+	nrOfFailedTestCases += ReportTestResult(VerifyResolution(reportTestCases), "kernel_table", "resolution");
+	nrOfFailedTestCases += ReportTestResult(VerifyOverride(reportTestCases), "kernel_table", "override");
+	nrOfFailedTestCases += ReportTestResult(VerifyCascadeVectorVariants(reportTestCases), "cascade_vector<3>", "variants");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}